@@ -19,6 +19,7 @@
 #define PARQUET_API_READER_H
 
 // Column reader API
+#include "parquet/bloom_filter.h"
 #include "parquet/column_reader.h"
 #include "parquet/column_scanner.h"
 #include "parquet/exception.h"
@@ -27,6 +28,8 @@
 
 // Metadata reader API
 #include "parquet/file/metadata.h"
+#include "parquet/file/page_index.h"
+#include "parquet/file/predicate.h"
 
 // Schemas
 #include "parquet/api/schema.h"
@@ -0,0 +1,369 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "benchmark/benchmark.h"
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "parquet/arrow/reader.h"
+#include "parquet/arrow/writer.h"
+#include "parquet/column_reader.h"
+#include "parquet/column_writer.h"
+#include "parquet/file/reader.h"
+#include "parquet/file/writer.h"
+#include "parquet/util/memory.h"
+
+#include "arrow/api.h"
+
+namespace parquet {
+
+using arrow::FileReader;
+using arrow::WriteTable;
+using schema::GroupNode;
+using schema::NodePtr;
+using schema::PrimitiveNode;
+
+namespace benchmark {
+
+// Leaf levels per column, split between the rows according to their mean
+// list length
+constexpr int64_t kNestedLevels = 1 << 20;
+
+// Levels read per call to ReadBatch
+constexpr int64_t kNestedBatchSize = 1024;
+
+constexpr int kNumStrings = 1000;
+
+struct NestedShape {
+  enum type {
+    // list<int64>
+    LIST_INT64,
+    // list<list<string>>
+    LIST_LIST_STRING,
+    // struct<a: list<int64>, b: list<int64>>
+    STRUCT_OF_LISTS
+  };
+};
+
+// An optional list of optional elements, in the three-level layout
+static NodePtr MakeList(const std::string& name, const NodePtr& element) {
+  NodePtr list = GroupNode::Make("list", Repetition::REPEATED, {element});
+  return GroupNode::Make(name, Repetition::OPTIONAL, {list}, LogicalType::LIST);
+}
+
+static NodePtr MakeNestedSchema(NestedShape::type shape) {
+  NodePtr int64_element =
+      PrimitiveNode::Make("element", Repetition::OPTIONAL, Type::INT64);
+  NodePtr column;
+  switch (shape) {
+    case NestedShape::LIST_INT64:
+      column = MakeList("column", int64_element);
+      break;
+    case NestedShape::LIST_LIST_STRING:
+      column = MakeList("column",
+                        MakeList("element", PrimitiveNode::Make(
+                                                "element", Repetition::OPTIONAL,
+                                                Type::BYTE_ARRAY, LogicalType::UTF8)));
+      break;
+    case NestedShape::STRUCT_OF_LISTS:
+      column = GroupNode::Make(
+          "column", Repetition::OPTIONAL,
+          {MakeList("a", int64_element), MakeList("b", int64_element)});
+      break;
+  }
+  return GroupNode::Make("schema", Repetition::REQUIRED, {column});
+}
+
+// The levels of a leaf column
+struct NestedLeaf {
+  std::vector<int16_t> def_levels;
+  std::vector<int16_t> rep_levels;
+  // Number of non-null leaf values
+  int64_t num_values = 0;
+
+  void Append(int16_t def_level, int16_t rep_level) {
+    def_levels.push_back(def_level);
+    rep_levels.push_back(rep_level);
+  }
+};
+
+// Generates the levels of optional lists of optional elements, whose lengths
+// are uniformly distributed around mean_length
+class NestedLevelGenerator {
+ public:
+  NestedLevelGenerator(int mean_length, int null_percent, uint32_t seed)
+      : rng_(seed), length_dist_(0, 2 * mean_length), null_percent_(null_percent) {}
+
+  // A row of depth nested lists whose definition levels start at base
+  void AppendRow(int depth, int16_t base, NestedLeaf* leaf) {
+    AppendList(depth, base, 0, 1, leaf);
+  }
+
+  bool NextIsNull() { return null_dist_(rng_) < null_percent_; }
+
+ private:
+  void AppendList(int depth, int16_t base, int16_t rep_level, int16_t list_rep_level,
+                  NestedLeaf* leaf) {
+    if (NextIsNull()) {
+      leaf->Append(base, rep_level);
+      return;
+    }
+    if (depth == 0) {
+      leaf->Append(static_cast<int16_t>(base + 1), rep_level);
+      ++leaf->num_values;
+      return;
+    }
+    int length = length_dist_(rng_);
+    if (length == 0) {
+      leaf->Append(static_cast<int16_t>(base + 1), rep_level);
+      return;
+    }
+    // The elements are below the repeated group of the list
+    for (int i = 0; i < length; ++i) {
+      AppendList(depth - 1, static_cast<int16_t>(base + 2),
+                 i == 0 ? rep_level : list_rep_level,
+                 static_cast<int16_t>(list_rep_level + 1), leaf);
+    }
+  }
+
+  std::mt19937 rng_;
+  std::uniform_int_distribution<int> length_dist_;
+  std::uniform_int_distribution<int> null_dist_{0, 99};
+  int null_percent_;
+};
+
+// The arguments are the shape, the mean list length and the percentage of
+// null lists and elements
+struct NestedCase {
+  explicit NestedCase(const ::benchmark::State& state)
+      : shape(static_cast<NestedShape::type>(state.range(0))),
+        schema(MakeNestedSchema(shape)),
+        raw_bytes(0),
+        num_levels(0) {
+    int mean_length = static_cast<int>(state.range(1));
+    int null_percent = static_cast<int>(state.range(2));
+    int depth = shape == NestedShape::LIST_LIST_STRING ? 2 : 1;
+    int64_t row_levels = 1;
+    for (int i = 0; i < depth; ++i) {
+      row_levels *= std::max(mean_length, 1);
+    }
+    num_rows = kNestedLevels / row_levels;
+
+    if (shape == NestedShape::STRUCT_OF_LISTS) {
+      // The struct is null in the same rows of both leaves
+      NestedLevelGenerator struct_generator(mean_length, null_percent, 0);
+      leaves.resize(2);
+      std::vector<NestedLevelGenerator> generators = {
+          NestedLevelGenerator(mean_length, null_percent, 1),
+          NestedLevelGenerator(mean_length, null_percent, 2)};
+      for (int64_t row = 0; row < num_rows; ++row) {
+        bool is_null = struct_generator.NextIsNull();
+        for (int i = 0; i < 2; ++i) {
+          if (is_null) {
+            leaves[i].Append(0, 0);
+          } else {
+            generators[i].AppendRow(depth, 1, &leaves[i]);
+          }
+        }
+      }
+    } else {
+      NestedLevelGenerator generator(mean_length, null_percent, 0);
+      leaves.resize(1);
+      for (int64_t row = 0; row < num_rows; ++row) {
+        generator.AppendRow(depth, 0, &leaves[0]);
+      }
+    }
+
+    int64_t max_values = 0;
+    for (const NestedLeaf& leaf : leaves) {
+      max_values = std::max(max_values, leaf.num_values);
+      num_levels += leaf.def_levels.size();
+      raw_bytes += 2 * leaf.def_levels.size() * sizeof(int16_t);
+    }
+    if (shape == NestedShape::LIST_LIST_STRING) {
+      for (int i = 0; i < kNumStrings; ++i) {
+        strings.push_back("value-" + std::to_string(i * 7919));
+      }
+      for (int64_t i = 0; i < max_values; ++i) {
+        const std::string& value = strings[i % kNumStrings];
+        string_values.push_back(
+            ByteArray(static_cast<uint32_t>(value.size()),
+                      reinterpret_cast<const uint8_t*>(value.data())));
+        raw_bytes += value.size() + sizeof(uint32_t);
+      }
+    } else {
+      for (int64_t i = 0; i < max_values; ++i) {
+        int64_values.push_back(i);
+      }
+      for (const NestedLeaf& leaf : leaves) {
+        raw_bytes += leaf.num_values * sizeof(int64_t);
+      }
+    }
+  }
+
+  // Write the columns with the low-level column writers
+  std::shared_ptr<Buffer> WriteFile() const {
+    auto sink = std::make_shared<InMemoryOutputStream>();
+    auto file_writer =
+        ParquetFileWriter::Open(sink, std::static_pointer_cast<GroupNode>(schema));
+    RowGroupWriter* row_group_writer = file_writer->AppendRowGroup(num_rows);
+    for (const NestedLeaf& leaf : leaves) {
+      ColumnWriter* column_writer = row_group_writer->NextColumn();
+      int64_t num_levels = static_cast<int64_t>(leaf.def_levels.size());
+      if (column_writer->type() == Type::BYTE_ARRAY) {
+        static_cast<ByteArrayWriter*>(column_writer)
+            ->WriteBatch(num_levels, leaf.def_levels.data(), leaf.rep_levels.data(),
+                         string_values.data());
+      } else {
+        static_cast<Int64Writer*>(column_writer)
+            ->WriteBatch(num_levels, leaf.def_levels.data(), leaf.rep_levels.data(),
+                         int64_values.data());
+      }
+    }
+    row_group_writer->Close();
+    file_writer->Close();
+    return sink->GetBuffer();
+  }
+
+  NestedShape::type shape;
+  NodePtr schema;
+  int64_t num_rows;
+  std::vector<NestedLeaf> leaves;
+  std::vector<std::string> strings;
+  std::vector<ByteArray> string_values;
+  std::vector<int64_t> int64_values;
+  // Size of the levels and of the non-null values
+  int64_t raw_bytes;
+  int64_t num_levels;
+};
+
+static void SetNestedProcessed(::benchmark::State& state, const NestedCase& test_case) {
+  state.SetBytesProcessed(state.iterations() * test_case.raw_bytes);
+  state.SetItemsProcessed(state.iterations() * test_case.num_levels);
+}
+
+template <typename Reader>
+static void ReadAllLevels(Reader* reader, std::vector<int16_t>* def_levels,
+                          std::vector<int16_t>* rep_levels,
+                          std::vector<typename Reader::T>* values) {
+  int64_t values_read = 0;
+  while (reader->HasNext()) {
+    reader->ReadBatch(kNestedBatchSize, def_levels->data(), rep_levels->data(),
+                      values->data(), &values_read);
+  }
+}
+
+static void BM_WriteNestedColumns(::benchmark::State& state) {
+  NestedCase test_case(state);
+
+  while (state.KeepRunning()) {
+    test_case.WriteFile();
+  }
+  SetNestedProcessed(state, test_case);
+}
+
+static void BM_ReadNestedColumns(::benchmark::State& state) {
+  NestedCase test_case(state);
+  std::shared_ptr<Buffer> buffer = test_case.WriteFile();
+  std::vector<int16_t> def_levels(kNestedBatchSize);
+  std::vector<int16_t> rep_levels(kNestedBatchSize);
+  std::vector<int64_t> int64_values(kNestedBatchSize);
+  std::vector<ByteArray> string_values(kNestedBatchSize);
+
+  while (state.KeepRunning()) {
+    auto reader =
+        ParquetFileReader::Open(std::make_shared<::arrow::io::BufferReader>(buffer));
+    std::shared_ptr<RowGroupReader> row_group_reader = reader->RowGroup(0);
+    for (int i = 0; i < reader->metadata()->num_columns(); ++i) {
+      std::shared_ptr<ColumnReader> column_reader = row_group_reader->Column(i);
+      if (column_reader->type() == Type::BYTE_ARRAY) {
+        ReadAllLevels(static_cast<ByteArrayReader*>(column_reader.get()), &def_levels,
+                      &rep_levels, &string_values);
+      } else {
+        ReadAllLevels(static_cast<Int64Reader*>(column_reader.get()), &def_levels,
+                      &rep_levels, &int64_values);
+      }
+    }
+  }
+  SetNestedProcessed(state, test_case);
+}
+
+static std::unique_ptr<FileReader> OpenArrowReader(
+    const std::shared_ptr<Buffer>& buffer) {
+  return std::unique_ptr<FileReader>(new FileReader(
+      ::arrow::default_memory_pool(),
+      ParquetFileReader::Open(std::make_shared<::arrow::io::BufferReader>(buffer))));
+}
+
+static void BM_WriteNestedTable(::benchmark::State& state) {
+  NestedCase test_case(state);
+  if (test_case.shape == NestedShape::STRUCT_OF_LISTS) {
+    state.SkipWithError("Struct columns are not written by the Arrow adapter");
+    return;
+  }
+  std::shared_ptr<::arrow::Table> table;
+  auto status = OpenArrowReader(test_case.WriteFile())->ReadTable(&table);
+  if (!status.ok()) {
+    state.SkipWithError(status.ToString().c_str());
+    return;
+  }
+
+  while (state.KeepRunning()) {
+    auto output = std::make_shared<InMemoryOutputStream>();
+    PARQUET_THROW_NOT_OK(WriteTable(*table, ::arrow::default_memory_pool(), output,
+                                    test_case.num_rows));
+  }
+  SetNestedProcessed(state, test_case);
+}
+
+static void BM_ReadNestedTable(::benchmark::State& state) {
+  NestedCase test_case(state);
+  std::shared_ptr<Buffer> buffer = test_case.WriteFile();
+
+  while (state.KeepRunning()) {
+    std::shared_ptr<::arrow::Table> table;
+    auto status = OpenArrowReader(buffer)->ReadTable(&table);
+    if (!status.ok()) {
+      state.SkipWithError(status.ToString().c_str());
+      break;
+    }
+  }
+  SetNestedProcessed(state, test_case);
+}
+
+static void NestedArguments(::benchmark::internal::Benchmark* b) {
+  for (int shape : {NestedShape::LIST_INT64, NestedShape::LIST_LIST_STRING,
+                    NestedShape::STRUCT_OF_LISTS}) {
+    for (int mean_length : {1, 10, 100}) {
+      for (int null_percent : {0, 10, 50}) {
+        b->Args({shape, mean_length, null_percent});
+      }
+    }
+  }
+}
+
+BENCHMARK(BM_WriteNestedColumns)->Apply(NestedArguments);
+BENCHMARK(BM_ReadNestedColumns)->Apply(NestedArguments);
+BENCHMARK(BM_WriteNestedTable)->Apply(NestedArguments);
+BENCHMARK(BM_ReadNestedTable)->Apply(NestedArguments);
+
+}  // namespace benchmark
+
+}  // namespace parquet
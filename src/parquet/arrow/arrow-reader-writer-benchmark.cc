@@ -17,6 +17,14 @@
 
 #include "benchmark/benchmark.h"
 
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
 #include "parquet/arrow/reader.h"
 #include "parquet/arrow/writer.h"
 #include "parquet/column_reader.h"
@@ -160,6 +168,346 @@ BENCHMARK_TEMPLATE2(BM_ReadColumn, true, Int64Type);
 BENCHMARK_TEMPLATE2(BM_ReadColumn, false, DoubleType);
 BENCHMARK_TEMPLATE2(BM_ReadColumn, true, DoubleType);
 
+// ----------------------------------------------------------------------
+// Tables of generated columns shaped like production data
+
+struct DataShape {
+  enum type {
+    RANDOM_INT64,
+    SORTED_INT64,
+    // Strings drawn from kLowCardinality distinct values
+    LOW_CARDINALITY_STRING,
+    // Strings which are mostly distinct
+    HIGH_CARDINALITY_STRING
+  };
+};
+
+static const char* DataShapeName(DataShape::type shape) {
+  switch (shape) {
+    case DataShape::RANDOM_INT64:
+      return "random int64";
+    case DataShape::SORTED_INT64:
+      return "sorted int64";
+    case DataShape::LOW_CARDINALITY_STRING:
+      return "low cardinality strings";
+    case DataShape::HIGH_CARDINALITY_STRING:
+      return "high cardinality strings";
+  }
+  return "";
+}
+
+constexpr int64_t kLowCardinality = 100;
+
+// Values per table, split evenly between its columns
+constexpr int64_t kShapedTableValues = 1 << 20;
+
+// A column of the shape with about null_percent% of nulls. The size of its
+// values, and offsets for strings, is added to raw_bytes.
+static std::shared_ptr<::arrow::Array> MakeShapedArray(DataShape::type shape,
+                                                       int64_t length, int null_percent,
+                                                       uint32_t seed,
+                                                       int64_t* raw_bytes) {
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<int> null_dist(0, 99);
+  std::shared_ptr<::arrow::Array> array;
+  if (shape == DataShape::RANDOM_INT64 || shape == DataShape::SORTED_INT64) {
+    std::uniform_int_distribution<int64_t> value_dist;
+    std::vector<int64_t> values(length);
+    for (int64_t i = 0; i < length; ++i) {
+      values[i] = value_dist(rng);
+    }
+    if (shape == DataShape::SORTED_INT64) {
+      std::sort(values.begin(), values.end());
+    }
+    ::arrow::Int64Builder builder(::arrow::int64(), ::arrow::default_memory_pool());
+    for (int64_t i = 0; i < length; ++i) {
+      if (null_dist(rng) < null_percent) {
+        ABORT_NOT_OK(builder.AppendNull());
+      } else {
+        ABORT_NOT_OK(builder.Append(values[i]));
+      }
+    }
+    *raw_bytes += length * sizeof(int64_t);
+    ABORT_NOT_OK(builder.Finish(&array));
+  } else {
+    int64_t cardinality =
+        shape == DataShape::LOW_CARDINALITY_STRING ? kLowCardinality : length;
+    std::uniform_int_distribution<int64_t> value_dist(0, cardinality - 1);
+    ::arrow::StringBuilder builder;
+    for (int64_t i = 0; i < length; ++i) {
+      if (null_dist(rng) < null_percent) {
+        ABORT_NOT_OK(builder.AppendNull());
+        *raw_bytes += sizeof(int32_t);
+      } else {
+        std::string value = "customer-" + std::to_string(value_dist(rng) * 7919);
+        ABORT_NOT_OK(builder.Append(value));
+        *raw_bytes += value.size() + sizeof(int32_t);
+      }
+    }
+    ABORT_NOT_OK(builder.Finish(&array));
+  }
+  return array;
+}
+
+static std::shared_ptr<::arrow::Table> MakeShapedTable(DataShape::type shape,
+                                                       int num_columns, int64_t num_rows,
+                                                       int null_percent,
+                                                       int64_t* raw_bytes) {
+  std::vector<std::shared_ptr<::arrow::Field>> fields;
+  std::vector<std::shared_ptr<::arrow::Column>> columns;
+  for (int i = 0; i < num_columns; ++i) {
+    std::shared_ptr<::arrow::Array> array =
+        MakeShapedArray(shape, num_rows, null_percent, i, raw_bytes);
+    auto field =
+        std::make_shared<::arrow::Field>("column" + std::to_string(i), array->type());
+    fields.push_back(field);
+    columns.push_back(std::make_shared<::arrow::Column>(field, array));
+  }
+  return std::make_shared<::arrow::Table>(std::make_shared<::arrow::Schema>(fields),
+                                          columns);
+}
+
+// The arguments are the shape, the percentage of nulls, the codec and the
+// number of columns
+struct ShapedTableCase {
+  explicit ShapedTableCase(const ::benchmark::State& state)
+      : shape(static_cast<DataShape::type>(state.range(0))),
+        null_percent(static_cast<int>(state.range(1))),
+        codec(static_cast<Compression::type>(state.range(2))),
+        num_columns(static_cast<int>(state.range(3))),
+        num_rows(kShapedTableValues / num_columns),
+        raw_bytes(0) {
+    table = MakeShapedTable(shape, num_columns, num_rows, null_percent, &raw_bytes);
+    properties = WriterProperties::Builder().compression(codec)->build();
+  }
+
+  std::string label() const {
+    std::stringstream ss;
+    ss << DataShapeName(shape) << ", " << null_percent << "% nulls, "
+       << CompressionToString(codec) << ", " << num_columns << " columns";
+    return ss.str();
+  }
+
+  DataShape::type shape;
+  int null_percent;
+  Compression::type codec;
+  int num_columns;
+  int64_t num_rows;
+  int64_t raw_bytes;
+  std::shared_ptr<::arrow::Table> table;
+  std::shared_ptr<WriterProperties> properties;
+};
+
+static void SetShapedTableProcessed(::benchmark::State& state,
+                                    const ShapedTableCase& test_case) {
+  state.SetBytesProcessed(state.iterations() * test_case.raw_bytes);
+  state.SetItemsProcessed(state.iterations() * test_case.num_rows);
+  state.SetLabel(test_case.label());
+}
+
+static void BM_WriteShapedTable(::benchmark::State& state) {
+  if (!CodecAvailable(static_cast<Compression::type>(state.range(2)))) {
+    state.SkipWithError("Codec not available");
+    return;
+  }
+  ShapedTableCase test_case(state);
+
+  while (state.KeepRunning()) {
+    auto output = std::make_shared<InMemoryOutputStream>();
+    ABORT_NOT_OK(WriteTable(*test_case.table, ::arrow::default_memory_pool(), output,
+                            test_case.num_rows, test_case.properties));
+  }
+  SetShapedTableProcessed(state, test_case);
+}
+
+static void BM_ReadShapedTable(::benchmark::State& state) {
+  if (!CodecAvailable(static_cast<Compression::type>(state.range(2)))) {
+    state.SkipWithError("Codec not available");
+    return;
+  }
+  ShapedTableCase test_case(state);
+  auto output = std::make_shared<InMemoryOutputStream>();
+  ABORT_NOT_OK(WriteTable(*test_case.table, ::arrow::default_memory_pool(), output,
+                          test_case.num_rows, test_case.properties));
+  std::shared_ptr<Buffer> buffer = output->GetBuffer();
+
+  while (state.KeepRunning()) {
+    auto reader =
+        ParquetFileReader::Open(std::make_shared<::arrow::io::BufferReader>(buffer));
+    FileReader filereader(::arrow::default_memory_pool(), std::move(reader));
+    std::shared_ptr<::arrow::Table> table;
+    ABORT_NOT_OK(filereader.ReadTable(&table));
+  }
+  SetShapedTableProcessed(state, test_case);
+}
+
+// Every shape with each percentage of nulls, then with each codec, then as a
+// wide table
+static void ShapedTableArguments(::benchmark::internal::Benchmark* b) {
+  const std::vector<int> shapes = {
+      DataShape::RANDOM_INT64, DataShape::SORTED_INT64, DataShape::LOW_CARDINALITY_STRING,
+      DataShape::HIGH_CARDINALITY_STRING};
+  for (int shape : shapes) {
+    for (int null_percent : {0, 10, 50}) {
+      b->Args({shape, null_percent, Compression::SNAPPY, 1});
+    }
+    for (int codec : {Compression::UNCOMPRESSED, Compression::GZIP, Compression::BROTLI,
+                      Compression::LZ4, Compression::ZSTD}) {
+      b->Args({shape, 10, codec, 1});
+    }
+    b->Args({shape, 10, Compression::SNAPPY, 1000});
+  }
+}
+
+BENCHMARK(BM_WriteShapedTable)
+    ->Apply(ShapedTableArguments)
+    ->Unit(::benchmark::kMillisecond);
+BENCHMARK(BM_ReadShapedTable)
+    ->Apply(ShapedTableArguments)
+    ->Unit(::benchmark::kMillisecond);
+
+// ----------------------------------------------------------------------
+// Scaling of parallel reads with the number of threads
+
+struct ScalingShape {
+  enum type {
+    // Read in parallel across columns
+    MANY_COLUMNS,
+    // Few columns, read in parallel across row groups
+    MANY_ROW_GROUPS,
+    // Read in parallel across groups of pages
+    ONE_HUGE_COLUMN
+  };
+};
+
+static const char* ScalingShapeName(ScalingShape::type shape) {
+  switch (shape) {
+    case ScalingShape::MANY_COLUMNS:
+      return "1000 columns, 1 row group";
+    case ScalingShape::MANY_ROW_GROUPS:
+      return "4 columns, 256 row groups";
+    case ScalingShape::ONE_HUGE_COLUMN:
+      return "1 column, 1 row group";
+  }
+  return "";
+}
+
+// Values per file, split evenly between its columns
+constexpr int64_t kScalingValues = 1 << 22;
+
+// The arguments are the shape and the number of threads
+struct ScalingCase {
+  explicit ScalingCase(const ::benchmark::State& state)
+      : shape(static_cast<ScalingShape::type>(state.range(0))),
+        num_threads(static_cast<int>(state.range(1))),
+        raw_bytes(0) {
+    int num_columns = 1;
+    int num_row_groups = 1;
+    if (shape == ScalingShape::MANY_COLUMNS) {
+      num_columns = 1000;
+    } else if (shape == ScalingShape::MANY_ROW_GROUPS) {
+      num_columns = 4;
+      num_row_groups = 256;
+    }
+    num_rows = kScalingValues / num_columns;
+    std::shared_ptr<::arrow::Table> table = MakeShapedTable(
+        DataShape::RANDOM_INT64, num_columns, num_rows, 10, &raw_bytes);
+    auto output = std::make_shared<InMemoryOutputStream>();
+    std::shared_ptr<WriterProperties> properties =
+        WriterProperties::Builder().compression(Compression::SNAPPY)->build();
+    ABORT_NOT_OK(WriteTable(*table, ::arrow::default_memory_pool(), output,
+                            num_rows / num_row_groups, properties));
+    buffer = output->GetBuffer();
+  }
+
+  // Read the whole file, as one row group through parallel page decoding for
+  // the huge column
+  void Read(int threads) const {
+    auto reader =
+        ParquetFileReader::Open(std::make_shared<::arrow::io::BufferReader>(buffer));
+    FileReader filereader(::arrow::default_memory_pool(), std::move(reader));
+    filereader.set_num_threads(threads);
+    std::shared_ptr<::arrow::Table> table;
+    if (shape == ScalingShape::ONE_HUGE_COLUMN) {
+      filereader.set_parallel_page_decoding(true);
+      ABORT_NOT_OK(filereader.ReadRowGroup(0, &table));
+    } else {
+      ABORT_NOT_OK(filereader.ReadTable(&table));
+    }
+  }
+
+  // Seconds of the fastest of a few single-threaded reads, measured once per
+  // shape
+  double SingleThreadedTime() const {
+    static std::map<int, double> times;
+    auto it = times.find(shape);
+    if (it != times.end()) {
+      return it->second;
+    }
+    double best = 0;
+    for (int i = 0; i < 3; ++i) {
+      auto start = std::chrono::steady_clock::now();
+      Read(1);
+      std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+      if (i == 0 || elapsed.count() < best) {
+        best = elapsed.count();
+      }
+    }
+    times[shape] = best;
+    return best;
+  }
+
+  ScalingShape::type shape;
+  int num_threads;
+  int64_t num_rows;
+  int64_t raw_bytes;
+  std::shared_ptr<Buffer> buffer;
+};
+
+// Reports the speedup over a single-threaded read, and the efficiency, which
+// is the speedup divided by the number of threads
+static void BM_ReadTableScaling(::benchmark::State& state) {
+  if (!CodecAvailable(Compression::SNAPPY)) {
+    state.SkipWithError("Codec not available");
+    return;
+  }
+  ScalingCase test_case(state);
+  double single_threaded_time = test_case.SingleThreadedTime();
+
+  std::chrono::duration<double> elapsed(0);
+  while (state.KeepRunning()) {
+    auto start = std::chrono::steady_clock::now();
+    test_case.Read(test_case.num_threads);
+    elapsed += std::chrono::steady_clock::now() - start;
+  }
+
+  double speedup = single_threaded_time * state.iterations() / elapsed.count();
+  std::stringstream ss;
+  ss.precision(3);
+  ss << ScalingShapeName(test_case.shape) << ", " << test_case.num_threads
+     << " threads, speedup " << speedup << "x, efficiency "
+     << 100 * speedup / test_case.num_threads << "%";
+  state.SetLabel(ss.str());
+  state.SetBytesProcessed(state.iterations() * test_case.raw_bytes);
+  state.SetItemsProcessed(state.iterations() * test_case.num_rows);
+}
+
+static void ScalingArguments(::benchmark::internal::Benchmark* b) {
+  for (int shape : {ScalingShape::MANY_COLUMNS, ScalingShape::MANY_ROW_GROUPS,
+                    ScalingShape::ONE_HUGE_COLUMN}) {
+    for (int num_threads : {1, 2, 4, 8, 16, 32, 64}) {
+      b->Args({shape, num_threads});
+    }
+  }
+}
+
+// Wall-clock time, as the reads are busy on other threads than the
+// benchmark's
+BENCHMARK(BM_ReadTableScaling)
+    ->Apply(ScalingArguments)
+    ->UseRealTime()
+    ->Unit(::benchmark::kMillisecond);
+
 }  // namespace benchmark
 
 }  // namespace parquet
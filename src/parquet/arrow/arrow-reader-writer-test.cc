@@ -23,15 +23,19 @@
 
 #include "gtest/gtest.h"
 
+#include <atomic>
 #include <sstream>
+#include <string>
 
 #include "parquet/api/reader.h"
 #include "parquet/api/writer.h"
 
+#include "parquet/arrow/dataset.h"
 #include "parquet/arrow/reader.h"
 #include "parquet/arrow/schema.h"
 #include "parquet/arrow/test-util.h"
 #include "parquet/arrow/writer.h"
+#include "parquet/util/thread-pool.h"
 
 #include "parquet/file/writer.h"
 
@@ -297,9 +301,13 @@ void WriteTableToBuffer(const std::shared_ptr<Table>& table, int num_threads,
                         std::shared_ptr<Buffer>* out) {
   auto sink = std::make_shared<InMemoryOutputStream>();
 
-  ASSERT_OK_NO_THROW(WriteTable(*table, ::arrow::default_memory_pool(), sink,
-                                row_group_size, default_writer_properties(),
-                                arrow_properties));
+  std::unique_ptr<FileWriter> writer;
+  ASSERT_OK_NO_THROW(FileWriter::Open(*table->schema(), ::arrow::default_memory_pool(),
+                                      sink, default_writer_properties(),
+                                      arrow_properties, &writer));
+  writer->set_num_threads(num_threads);
+  ASSERT_OK_NO_THROW(writer->WriteTable(*table, row_group_size));
+  ASSERT_OK_NO_THROW(writer->Close());
   *out = sink->GetBuffer();
 }
 
@@ -812,6 +820,161 @@ TEST_F(TestStringParquetIO, EmptyStringColumnRequiredWrite) {
   ASSERT_TRUE(values->Equals(chunked_array->chunk(0)));
 }
 
+TEST(TestArrowReadWrite, ReadStringsAcrossPagesAndRowGroups) {
+  const int num_rows = 5000;
+
+  ::arrow::StringBuilder builder;
+  for (int i = 0; i < num_rows; i++) {
+    if (i % 11 == 0) {
+      ASSERT_OK(builder.AppendNull());
+    } else if (i % 13 == 0) {
+      ASSERT_OK(builder.Append(""));
+    } else {
+      ASSERT_OK(builder.Append(std::string(i % 50, 'a' + i % 26)));
+    }
+  }
+  std::shared_ptr<Array> values;
+  ASSERT_OK(builder.Finish(&values));
+  std::shared_ptr<Table> table = MakeSimpleTable(values, true);
+
+  auto sink = std::make_shared<InMemoryOutputStream>();
+  auto properties =
+      WriterProperties::Builder().disable_dictionary()->data_pagesize(4096)->build();
+  ASSERT_OK_NO_THROW(
+      WriteTable(*table, ::arrow::default_memory_pool(), sink, 2000, properties));
+
+  std::unique_ptr<FileReader> reader;
+  ASSERT_OK_NO_THROW(OpenFile(std::make_shared<BufferReader>(sink->GetBuffer()),
+                              ::arrow::default_memory_pool(),
+                              ::parquet::default_reader_properties(), nullptr, &reader));
+  std::shared_ptr<Array> result;
+  ASSERT_OK_NO_THROW(reader->ReadColumn(0, &result));
+  ASSERT_TRUE(values->Equals(result));
+}
+
+// Check that the DictionaryArray holds the same strings as the expected array
+static void AssertDictionaryEquals(const ::arrow::StringArray& expected,
+                                   const Array& actual) {
+  ASSERT_EQ(::arrow::Type::DICTIONARY, actual.type_id());
+  const auto& dict_array = static_cast<const ::arrow::DictionaryArray&>(actual);
+  const auto& dictionary =
+      static_cast<const ::arrow::StringArray&>(*dict_array.dictionary());
+  const auto& indices = static_cast<const ::arrow::Int32Array&>(*dict_array.indices());
+  ASSERT_EQ(expected.length(), indices.length());
+  ASSERT_EQ(expected.null_count(), indices.null_count());
+  for (int64_t i = 0; i < expected.length(); i++) {
+    ASSERT_EQ(expected.IsNull(i), indices.IsNull(i));
+    if (!expected.IsNull(i)) {
+      ASSERT_EQ(expected.GetString(i), dictionary.GetString(indices.Value(i)));
+    }
+  }
+}
+
+TEST(TestArrowReadWrite, ReadDictionary) {
+  const int num_rows = 1000;
+
+  ::arrow::StringBuilder builder;
+  for (int i = 0; i < num_rows; i++) {
+    if (i % 7 == 0) {
+      ASSERT_OK(builder.AppendNull());
+    } else {
+      ASSERT_OK(builder.Append("value-" + std::to_string(i % 10)));
+    }
+  }
+  std::shared_ptr<Array> values;
+  ASSERT_OK(builder.Finish(&values));
+  std::shared_ptr<Table> table = MakeSimpleTable(values, true);
+
+  // Three row groups, whose dictionaries are merged
+  std::shared_ptr<Buffer> buffer;
+  WriteTableToBuffer(table, 1, 400, default_arrow_writer_properties(), &buffer);
+
+  std::unique_ptr<FileReader> reader;
+  ASSERT_OK_NO_THROW(OpenFile(std::make_shared<BufferReader>(buffer),
+                              ::arrow::default_memory_pool(),
+                              ::parquet::default_reader_properties(), nullptr, &reader));
+  reader->set_read_dictionary(0, true);
+
+  std::shared_ptr<Table> result;
+  ASSERT_OK_NO_THROW(reader->ReadTable(&result));
+  ASSERT_EQ(::arrow::Type::DICTIONARY, result->schema()->field(0)->type()->id());
+  auto chunked = result->column(0)->data();
+  ASSERT_EQ(1, chunked->num_chunks());
+  AssertDictionaryEquals(static_cast<const ::arrow::StringArray&>(*values),
+                         *chunked->chunk(0));
+  const auto& dict_array =
+      static_cast<const ::arrow::DictionaryArray&>(*chunked->chunk(0));
+  ASSERT_EQ(10, dict_array.dictionary()->length());
+
+  ASSERT_OK_NO_THROW(reader->ReadRowGroup(1, &result));
+  AssertDictionaryEquals(
+      static_cast<const ::arrow::StringArray&>(*values->Slice(400, 400)),
+      *result->column(0)->data()->chunk(0));
+}
+
+TEST(TestArrowReadWrite, ReadDictionaryAcrossRowGroups) {
+  const int num_row_groups = 4;
+  const int row_group_size = 250;
+
+  // Each row group has its own dictionary, in a different order
+  ::arrow::StringBuilder builder;
+  for (int r = 0; r < num_row_groups; r++) {
+    for (int i = 0; i < row_group_size; i++) {
+      ASSERT_OK(builder.Append("rg-" + std::to_string(r) + "-" +
+                               std::to_string((i + r) % (5 + r))));
+    }
+  }
+  std::shared_ptr<Array> values;
+  ASSERT_OK(builder.Finish(&values));
+  std::shared_ptr<Table> table = MakeSimpleTable(values, false);
+
+  std::shared_ptr<Buffer> buffer;
+  WriteTableToBuffer(table, 1, row_group_size, default_arrow_writer_properties(),
+                     &buffer);
+
+  std::unique_ptr<FileReader> reader;
+  ASSERT_OK_NO_THROW(OpenFile(std::make_shared<BufferReader>(buffer),
+                              ::arrow::default_memory_pool(),
+                              ::parquet::default_reader_properties(), nullptr, &reader));
+  ASSERT_EQ(num_row_groups, reader->num_row_groups());
+  reader->set_read_dictionary(0, true);
+
+  // All the row groups are read into a single batch
+  std::shared_ptr<Array> result;
+  ASSERT_OK_NO_THROW(reader->ReadColumn(0, &result));
+  AssertDictionaryEquals(static_cast<const ::arrow::StringArray&>(*values), *result);
+  const auto& dict_array = static_cast<const ::arrow::DictionaryArray&>(*result);
+  ASSERT_EQ(5 + 6 + 7 + 8, dict_array.dictionary()->length());
+}
+
+TEST(TestArrowReadWrite, ReadDictionaryAfterPlainFallback) {
+  const int num_rows = 1000;
+
+  ::arrow::StringBuilder builder;
+  for (int i = 0; i < num_rows; i++) {
+    ASSERT_OK(builder.Append("value-" + std::to_string(i)));
+  }
+  std::shared_ptr<Array> values;
+  ASSERT_OK(builder.Finish(&values));
+  std::shared_ptr<Table> table = MakeSimpleTable(values, false);
+
+  // The dictionary overflows and the writer falls back to PLAIN
+  auto sink = std::make_shared<InMemoryOutputStream>();
+  auto properties = WriterProperties::Builder().dictionary_pagesize_limit(256)->build();
+  ASSERT_OK_NO_THROW(
+      WriteTable(*table, ::arrow::default_memory_pool(), sink, num_rows, properties));
+
+  std::unique_ptr<FileReader> reader;
+  ASSERT_OK_NO_THROW(OpenFile(std::make_shared<BufferReader>(sink->GetBuffer()),
+                              ::arrow::default_memory_pool(),
+                              ::parquet::default_reader_properties(), nullptr, &reader));
+  reader->set_read_dictionary(0, true);
+
+  std::shared_ptr<Array> result;
+  ASSERT_OK_NO_THROW(reader->ReadColumn(0, &result));
+  AssertDictionaryEquals(static_cast<const ::arrow::StringArray&>(*values), *result);
+}
+
 using TestNullParquetIO = TestParquetIO<::arrow::NullType>;
 
 TEST_F(TestNullParquetIO, NullColumn) {
@@ -995,6 +1158,135 @@ TEST(TestArrowReadWrite, DateTimeTypes) {
   ASSERT_TRUE(table->Equals(*result));
 }
 
+TEST(TestArrowReadWrite, DictionaryArrayWrite) {
+  const int num_rows = 1000;
+  const int64_t row_group_size = 300;
+  std::vector<std::string> entries = {"foo", "", "bar", "baz"};
+
+  ::arrow::StringBuilder dictionary_builder;
+  for (const std::string& entry : entries) {
+    ASSERT_OK(dictionary_builder.Append(entry));
+  }
+  std::shared_ptr<Array> dictionary;
+  ASSERT_OK(dictionary_builder.Finish(&dictionary));
+
+  ::arrow::Int8Builder indices_builder(::arrow::default_memory_pool());
+  ::arrow::StringBuilder dense_builder;
+  for (int i = 0; i < num_rows; i++) {
+    if (i % 7 == 0) {
+      ASSERT_OK(indices_builder.AppendNull());
+      ASSERT_OK(dense_builder.AppendNull());
+    } else {
+      int8_t index = static_cast<int8_t>((i * 3) % entries.size());
+      ASSERT_OK(indices_builder.Append(index));
+      ASSERT_OK(dense_builder.Append(entries[index]));
+    }
+  }
+  std::shared_ptr<Array> indices;
+  ASSERT_OK(indices_builder.Finish(&indices));
+  std::shared_ptr<Array> dense;
+  ASSERT_OK(dense_builder.Finish(&dense));
+
+  auto dictionary_type = ::arrow::dictionary(::arrow::int8(), dictionary);
+  auto values = std::make_shared<::arrow::DictionaryArray>(dictionary_type, indices);
+  std::shared_ptr<Table> table = MakeSimpleTable(values, true);
+
+  auto sink = std::make_shared<InMemoryOutputStream>();
+  ASSERT_OK_NO_THROW(WriteTable(*table, ::arrow::default_memory_pool(), sink,
+                                row_group_size, default_writer_properties()));
+
+  std::unique_ptr<FileReader> reader;
+  ASSERT_OK_NO_THROW(OpenFile(std::make_shared<BufferReader>(sink->GetBuffer()),
+                              ::arrow::default_memory_pool(),
+                              ::parquet::default_reader_properties(), nullptr, &reader));
+  auto metadata = reader->parquet_reader()->metadata();
+  ASSERT_EQ(4, metadata->num_row_groups());
+  for (int i = 0; i < metadata->num_row_groups(); i++) {
+    ASSERT_TRUE(metadata->RowGroup(i)->ColumnChunk(0)->has_dictionary_page());
+  }
+
+  // Read back as the dense values
+  std::shared_ptr<Table> result;
+  ASSERT_OK_NO_THROW(reader->ReadTable(&result));
+  std::shared_ptr<ChunkedArray> chunked_array = result->column(0)->data();
+  ASSERT_EQ(1, chunked_array->num_chunks());
+  ASSERT_TRUE(dense->Equals(chunked_array->chunk(0)));
+}
+
+TEST(TestArrowReadWrite, DictionaryArrayDistinctCount) {
+  const int num_rows = 1000;
+  const int64_t row_group_size = 400;
+  // Only the first three entries are referenced by the indices
+  std::vector<std::string> entries = {"foo", "bar", "baz", "unused", "also unused"};
+
+  ::arrow::StringBuilder dictionary_builder;
+  for (const std::string& entry : entries) {
+    ASSERT_OK(dictionary_builder.Append(entry));
+  }
+  std::shared_ptr<Array> dictionary;
+  ASSERT_OK(dictionary_builder.Finish(&dictionary));
+
+  ::arrow::Int8Builder indices_builder(::arrow::default_memory_pool());
+  for (int i = 0; i < num_rows; i++) {
+    ASSERT_OK(indices_builder.Append(static_cast<int8_t>(i % 3)));
+  }
+  std::shared_ptr<Array> indices;
+  ASSERT_OK(indices_builder.Finish(&indices));
+
+  auto dictionary_type = ::arrow::dictionary(::arrow::int8(), dictionary);
+  auto values = std::make_shared<::arrow::DictionaryArray>(dictionary_type, indices);
+  std::shared_ptr<Table> table = MakeSimpleTable(values, false);
+
+  auto properties = WriterProperties::Builder().enable_distinct_count()->build();
+  auto sink = std::make_shared<InMemoryOutputStream>();
+  ASSERT_OK_NO_THROW(WriteTable(*table, ::arrow::default_memory_pool(), sink,
+                                row_group_size, properties));
+
+  std::unique_ptr<FileReader> reader;
+  ASSERT_OK_NO_THROW(OpenFile(std::make_shared<BufferReader>(sink->GetBuffer()),
+                              ::arrow::default_memory_pool(),
+                              ::parquet::default_reader_properties(), nullptr, &reader));
+  auto metadata = reader->parquet_reader()->metadata();
+  ASSERT_EQ(3, metadata->num_row_groups());
+  for (int i = 0; i < metadata->num_row_groups(); i++) {
+    auto column_chunk = metadata->RowGroup(i)->ColumnChunk(0);
+    ASSERT_TRUE(column_chunk->has_dictionary_page());
+    ASSERT_EQ(3, column_chunk->statistics()->distinct_count());
+
+    // The unused entries are left out of the chunk's dictionary
+    std::unique_ptr<PageReader> pages =
+        reader->parquet_reader()->RowGroup(i)->GetColumnPageReader(0);
+    std::shared_ptr<Page> page = pages->NextPage();
+    ASSERT_EQ(PageType::DICTIONARY_PAGE, page->type());
+    ASSERT_EQ(3, static_cast<const DictionaryPage&>(*page).num_values());
+  }
+}
+
+TEST(TestArrowReadWrite, DictionaryArrayIndexOutOfRange) {
+  ::arrow::StringBuilder dictionary_builder;
+  ASSERT_OK(dictionary_builder.Append("foo"));
+  ASSERT_OK(dictionary_builder.Append("bar"));
+  std::shared_ptr<Array> dictionary;
+  ASSERT_OK(dictionary_builder.Finish(&dictionary));
+  auto dictionary_type = ::arrow::dictionary(::arrow::int64(), dictionary);
+
+  // 2^32 must not wrap around to a valid index when narrowed to 32 bits
+  for (int64_t bad_index : {int64_t(-1), int64_t(2), int64_t(1) << 32}) {
+    ::arrow::Int64Builder indices_builder(::arrow::default_memory_pool());
+    ASSERT_OK(indices_builder.Append(0));
+    ASSERT_OK(indices_builder.Append(bad_index));
+    ASSERT_OK(indices_builder.Append(1));
+    std::shared_ptr<Array> indices;
+    ASSERT_OK(indices_builder.Finish(&indices));
+
+    auto values = std::make_shared<::arrow::DictionaryArray>(dictionary_type, indices);
+    std::shared_ptr<Table> table = MakeSimpleTable(values, false);
+    auto sink = std::make_shared<InMemoryOutputStream>();
+    ASSERT_RAISES(Invalid, WriteTable(*table, ::arrow::default_memory_pool(), sink, 10,
+                                      default_writer_properties()));
+  }
+}
+
 TEST(TestArrowReadWrite, CoerceTimestamps) {
   using ::arrow::ArrayFromVector;
   using ::arrow::field;
@@ -1215,6 +1507,251 @@ TEST(TestArrowReadWrite, MultithreadedRead) {
   ASSERT_TRUE(table->Equals(*result));
 }
 
+TEST(TestArrowReadWrite, MultithreadedReadAcrossRowGroups) {
+  const int num_columns = 2;
+  const int num_rows = 1000;
+  const int num_threads = 8;
+  const int64_t row_group_size = 100;
+
+  std::shared_ptr<Table> table;
+  MakeDoubleTable(num_columns, num_rows, 1, &table);
+
+  std::shared_ptr<Table> result;
+  DoSimpleRoundtrip(table, num_threads, row_group_size, {}, &result);
+
+  ASSERT_TRUE(table->Equals(*result));
+  // Each row group was read by its own task
+  for (int i = 0; i < num_columns; i++) {
+    ASSERT_EQ(num_rows / row_group_size, result->column(i)->data()->num_chunks());
+  }
+}
+
+TEST(TestArrowReadWrite, MultithreadedReadOnThreadPool) {
+  const int num_columns = 20;
+  const int num_rows = 1000;
+
+  std::shared_ptr<Table> table;
+  MakeDoubleTable(num_columns, num_rows, 1, &table);
+
+  std::shared_ptr<Buffer> buffer;
+  WriteTableToBuffer(table, 1, num_rows, default_arrow_writer_properties(), &buffer);
+
+  std::unique_ptr<FileReader> reader;
+  ASSERT_OK_NO_THROW(OpenFile(std::make_shared<BufferReader>(buffer),
+                              ::arrow::default_memory_pool(),
+                              ::parquet::default_reader_properties(), nullptr, &reader));
+
+  // More reading threads than workers: the calling thread takes its share
+  reader->set_thread_pool(std::make_shared<::parquet::ThreadPool>(2));
+  reader->set_num_threads(8);
+
+  // The workers are reused across reads
+  for (int i = 0; i < 3; ++i) {
+    std::shared_ptr<Table> result;
+    ASSERT_OK_NO_THROW(reader->ReadTable(&result));
+    ASSERT_TRUE(table->Equals(*result));
+  }
+}
+
+TEST(TestArrowReadWrite, MultithreadedWrite) {
+  const int num_columns = 20;
+  const int num_rows = 1000;
+  const int64_t row_group_size = 300;
+
+  std::shared_ptr<Table> table;
+  MakeDoubleTable(num_columns, num_rows, 1, &table);
+
+  std::shared_ptr<Buffer> sequential;
+  WriteTableToBuffer(table, 1, row_group_size, default_arrow_writer_properties(),
+                     &sequential);
+
+  // The column chunks are encoded in parallel but laid out in schema order
+  std::shared_ptr<Buffer> parallel;
+  WriteTableToBuffer(table, 4, row_group_size, default_arrow_writer_properties(),
+                     &parallel);
+  ASSERT_TRUE(sequential->Equals(*parallel));
+
+  // More writing threads than workers, and than columns
+  auto sink = std::make_shared<InMemoryOutputStream>();
+  std::shared_ptr<WriterProperties> properties =
+      WriterProperties::Builder().compression(Compression::SNAPPY)->build();
+  std::unique_ptr<FileWriter> writer;
+  ASSERT_OK_NO_THROW(FileWriter::Open(*table->schema(), ::arrow::default_memory_pool(),
+                                      sink, properties, &writer));
+  writer->set_thread_pool(std::make_shared<::parquet::ThreadPool>(2));
+  writer->set_num_threads(32);
+  ASSERT_OK_NO_THROW(writer->WriteTable(*table, row_group_size));
+  ASSERT_OK_NO_THROW(writer->Close());
+
+  std::unique_ptr<FileReader> reader;
+  ASSERT_OK_NO_THROW(OpenFile(std::make_shared<BufferReader>(sink->GetBuffer()),
+                              ::arrow::default_memory_pool(),
+                              ::parquet::default_reader_properties(), nullptr, &reader));
+  ASSERT_EQ(4, reader->num_row_groups());
+  std::shared_ptr<Table> result;
+  ASSERT_OK_NO_THROW(reader->ReadTable(&result));
+  ASSERT_TRUE(table->Equals(*result));
+}
+
+TEST(TestArrowReadWrite, RowGroupsLimitedByBytes) {
+  const int num_columns = 4;
+  const int num_rows = 20000;
+  const int64_t max_row_group_bytes = 64 * 1024;
+
+  std::shared_ptr<Table> table;
+  MakeDoubleTable(num_columns, num_rows, 1, &table);
+
+  auto sink = std::make_shared<InMemoryOutputStream>();
+  std::shared_ptr<WriterProperties> properties =
+      WriterProperties::Builder().max_row_group_bytes(max_row_group_bytes)->build();
+  std::unique_ptr<FileWriter> writer;
+  ASSERT_OK_NO_THROW(FileWriter::Open(*table->schema(), ::arrow::default_memory_pool(),
+                                      sink, properties, &writer));
+  ASSERT_OK_NO_THROW(writer->WriteTable(*table, num_rows));
+  ASSERT_OK_NO_THROW(writer->Close());
+
+  std::unique_ptr<FileReader> reader;
+  ASSERT_OK_NO_THROW(OpenFile(std::make_shared<BufferReader>(sink->GetBuffer()),
+                              ::arrow::default_memory_pool(),
+                              ::parquet::default_reader_properties(), nullptr, &reader));
+  auto metadata = reader->parquet_reader()->metadata();
+  ASSERT_LT(2, metadata->num_row_groups());
+  // The first row group is sized from the Arrow data, the following ones from
+  // the encoded size of the rows written before them
+  for (int i = 1; i < metadata->num_row_groups() - 1; i++) {
+    int64_t row_group_bytes = metadata->RowGroup(i)->total_byte_size();
+    ASSERT_LT(max_row_group_bytes / 2, row_group_bytes);
+    ASSERT_GT(max_row_group_bytes * 3 / 2, row_group_bytes);
+  }
+
+  std::shared_ptr<Table> result;
+  ASSERT_OK_NO_THROW(reader->ReadTable(&result));
+  ASSERT_TRUE(table->Equals(*result));
+}
+
+TEST(TestArrowReadWrite, WriteRecordBatchesIntoRowGroups) {
+  const int num_columns = 3;
+  const int num_rows = 1000;
+  const int64_t batch_size = 70;
+  const int64_t max_row_group_length = 300;
+
+  std::shared_ptr<Table> table;
+  MakeDoubleTable(num_columns, num_rows, 1, &table);
+
+  auto sink = std::make_shared<InMemoryOutputStream>();
+  std::shared_ptr<WriterProperties> properties =
+      WriterProperties::Builder().max_row_group_length(max_row_group_length)->build();
+  std::unique_ptr<FileWriter> writer;
+  ASSERT_OK_NO_THROW(FileWriter::Open(*table->schema(), ::arrow::default_memory_pool(),
+                                      sink, properties, &writer));
+  for (int64_t offset = 0; offset < num_rows; offset += batch_size) {
+    int64_t size = std::min<int64_t>(batch_size, num_rows - offset);
+    std::vector<std::shared_ptr<Array>> columns;
+    for (int i = 0; i < num_columns; i++) {
+      columns.push_back(table->column(i)->data()->chunk(0)->Slice(offset, size));
+    }
+    ::arrow::RecordBatch batch(table->schema(), size, columns);
+    ASSERT_OK_NO_THROW(writer->WriteRecordBatch(batch));
+  }
+  ASSERT_OK_NO_THROW(writer->Close());
+
+  std::unique_ptr<FileReader> reader;
+  ASSERT_OK_NO_THROW(OpenFile(std::make_shared<BufferReader>(sink->GetBuffer()),
+                              ::arrow::default_memory_pool(),
+                              ::parquet::default_reader_properties(), nullptr, &reader));
+  // The batches are accumulated into full row groups, the last one holding
+  // the remaining rows
+  auto metadata = reader->parquet_reader()->metadata();
+  ASSERT_EQ(4, metadata->num_row_groups());
+  ASSERT_EQ(num_rows, metadata->num_rows());
+  for (int i = 0; i < 3; i++) {
+    ASSERT_EQ(max_row_group_length, metadata->RowGroup(i)->num_rows());
+  }
+  ASSERT_EQ(100, metadata->RowGroup(3)->num_rows());
+
+  std::shared_ptr<Table> result;
+  ASSERT_OK_NO_THROW(reader->ReadTable(&result));
+  ASSERT_TRUE(table->Equals(*result));
+}
+
+TEST(TestArrowReadWrite, MemoryBudgetCutsOnlyLongEnoughRowGroups) {
+  const int num_columns = 3;
+  const int num_rows = 1000;
+  const int64_t batch_size = 70;
+
+  std::shared_ptr<Table> table;
+  MakeDoubleTable(num_columns, num_rows, 1, &table);
+
+  // Another writer keeps the budget exceeded throughout
+  auto budget = std::make_shared<WriterMemoryBudget>(1024);
+  int other_writer;
+  budget->Update(&other_writer, 1 << 20);
+  auto sink = std::make_shared<InMemoryOutputStream>();
+  std::shared_ptr<WriterProperties> properties = WriterProperties::Builder()
+                                                     .memory_budget(budget)
+                                                     ->min_row_group_length(200)
+                                                     ->build();
+  std::unique_ptr<FileWriter> writer;
+  ASSERT_OK_NO_THROW(FileWriter::Open(*table->schema(), ::arrow::default_memory_pool(),
+                                      sink, properties, &writer));
+  for (int64_t offset = 0; offset < num_rows; offset += batch_size) {
+    int64_t size = std::min<int64_t>(batch_size, num_rows - offset);
+    std::vector<std::shared_ptr<Array>> columns;
+    for (int i = 0; i < num_columns; i++) {
+      columns.push_back(table->column(i)->data()->chunk(0)->Slice(offset, size));
+    }
+    ::arrow::RecordBatch batch(table->schema(), size, columns);
+    ASSERT_OK_NO_THROW(writer->WriteRecordBatch(batch));
+  }
+  ASSERT_OK_NO_THROW(writer->Close());
+  budget->Update(&other_writer, 0);
+
+  std::unique_ptr<FileReader> reader;
+  ASSERT_OK_NO_THROW(OpenFile(std::make_shared<BufferReader>(sink->GetBuffer()),
+                              ::arrow::default_memory_pool(),
+                              ::parquet::default_reader_properties(), nullptr, &reader));
+  // Each row group is closed after the batch that makes it reach 200 rows
+  auto metadata = reader->parquet_reader()->metadata();
+  ASSERT_EQ(5, metadata->num_row_groups());
+  for (int i = 0; i < 4; i++) {
+    ASSERT_EQ(210, metadata->RowGroup(i)->num_rows());
+  }
+  ASSERT_EQ(160, metadata->RowGroup(4)->num_rows());
+
+  std::shared_ptr<Table> result;
+  ASSERT_OK_NO_THROW(reader->ReadTable(&result));
+  ASSERT_TRUE(table->Equals(*result));
+}
+
+TEST(TestArrowReadWrite, ZeroCopyRequiredColumnRead) {
+  const int num_rows = 1000;
+
+  std::shared_ptr<Array> values;
+  ASSERT_OK(NonNullArray<::arrow::DoubleType>(num_rows, &values));
+  std::shared_ptr<Table> table = MakeSimpleTable(values, false);
+
+  // PLAIN-encoded, uncompressed and fitting in a single data page
+  auto sink = std::make_shared<InMemoryOutputStream>();
+  auto properties = WriterProperties::Builder().disable_dictionary()->build();
+  ASSERT_OK_NO_THROW(
+      WriteTable(*table, ::arrow::default_memory_pool(), sink, num_rows, properties));
+  std::shared_ptr<Buffer> buffer = sink->GetBuffer();
+
+  std::unique_ptr<FileReader> reader;
+  ASSERT_OK_NO_THROW(OpenFile(std::make_shared<BufferReader>(buffer),
+                              ::arrow::default_memory_pool(),
+                              ::parquet::default_reader_properties(), nullptr, &reader));
+
+  std::shared_ptr<Array> result;
+  ASSERT_OK_NO_THROW(reader->ReadColumn(0, &result));
+  ASSERT_TRUE(values->Equals(result));
+
+  // The array references the file contents
+  auto data = static_cast<const PrimitiveArray&>(*result).values();
+  ASSERT_LE(buffer->data(), data->data());
+  ASSERT_GE(buffer->data() + buffer->size(), data->data() + data->size());
+}
+
 TEST(TestArrowReadWrite, ReadSingleRowGroup) {
   const int num_columns = 20;
   const int num_rows = 1000;
@@ -1243,6 +1780,351 @@ TEST(TestArrowReadWrite, ReadSingleRowGroup) {
   ASSERT_TRUE(table->Equals(*concatenated));
 }
 
+TEST(TestArrowReadWrite, ReadRowGroupsMatchingPredicate) {
+  const int num_rows = 1000;
+  const int row_group_size = 250;
+
+  std::vector<int64_t> sorted(num_rows);
+  for (int i = 0; i < num_rows; i++) {
+    sorted[i] = i;
+  }
+  std::shared_ptr<Array> values;
+  ::arrow::ArrayFromVector<::arrow::Int64Type, int64_t>(sorted, &values);
+  std::shared_ptr<Table> table = MakeSimpleTable(values, false);
+
+  std::shared_ptr<Buffer> buffer;
+  WriteTableToBuffer(table, 1, row_group_size, default_arrow_writer_properties(),
+                     &buffer);
+
+  std::unique_ptr<FileReader> reader;
+  ASSERT_OK_NO_THROW(OpenFile(std::make_shared<BufferReader>(buffer),
+                              ::arrow::default_memory_pool(),
+                              ::parquet::default_reader_properties(), nullptr, &reader));
+  ASSERT_EQ(4, reader->num_row_groups());
+
+  RowGroupPredicate predicate;
+  predicate.Add<Int64Type>(0, CompareOperator::GE, 300)
+      .Add<Int64Type>(0, CompareOperator::LT, 520);
+  ASSERT_EQ(std::vector<int>({1, 2}),
+            predicate.SelectRowGroups(*reader->parquet_reader()->metadata()));
+
+  std::shared_ptr<Table> result;
+  ASSERT_OK_NO_THROW(reader->ReadTable({0}, predicate, &result));
+  ASSERT_EQ(2 * row_group_size, result->num_rows());
+  auto chunked = result->column(0)->data();
+  ASSERT_EQ(1, chunked->num_chunks());
+  ASSERT_TRUE(values->Slice(row_group_size, 2 * row_group_size)->Equals(chunked->chunk(0)));
+
+  ASSERT_OK_NO_THROW(reader->ReadRowGroup(0, {0}, predicate, &result));
+  ASSERT_EQ(nullptr, result);
+  ASSERT_OK_NO_THROW(reader->ReadRowGroup(2, {0}, predicate, &result));
+  ASSERT_EQ(row_group_size, result->num_rows());
+
+  // No row group matches
+  RowGroupPredicate none;
+  none.Add<Int64Type>(0, CompareOperator::EQ, num_rows);
+  ASSERT_OK_NO_THROW(reader->ReadTable({0}, none, &result));
+  ASSERT_EQ(0, result->num_rows());
+
+  // The literal must have the physical type of the column
+  RowGroupPredicate mismatch;
+  mismatch.Add<Int32Type>(0, CompareOperator::EQ, 1);
+  ASSERT_RAISES(IOError, reader->ReadTable({0}, mismatch, &result));
+}
+
+TEST(TestDatasetReader, ReadAcrossFiles) {
+  const int num_files = 3;
+  const int num_rows = 1000;
+  const int row_group_size = 250;
+
+  std::vector<std::shared_ptr<Array>> values(num_files);
+  std::vector<std::shared_ptr<Buffer>> buffers(num_files);
+  std::vector<DatasetFile> files;
+  for (int f = 0; f < num_files; f++) {
+    std::vector<int64_t> sorted(num_rows);
+    for (int i = 0; i < num_rows; i++) {
+      sorted[i] = f * num_rows + i;
+    }
+    ::arrow::ArrayFromVector<::arrow::Int64Type, int64_t>(sorted, &values[f]);
+    WriteTableToBuffer(MakeSimpleTable(values[f], false), 1, row_group_size,
+                       default_arrow_writer_properties(), &buffers[f]);
+    files.push_back({"part-" + std::to_string(f), nullptr});
+  }
+
+  std::atomic<int> num_opened(0);
+  auto opener = [&buffers, &num_opened](
+                    const std::string& path,
+                    std::shared_ptr<::arrow::io::ReadableFileInterface>* out) {
+    for (size_t f = 0; f < buffers.size(); f++) {
+      if (path == "part-" + std::to_string(f)) {
+        ++num_opened;
+        *out = std::make_shared<BufferReader>(buffers[f]);
+        return Status::OK();
+      }
+    }
+    return Status::IOError("No such file: " + path);
+  };
+
+  std::unique_ptr<DatasetReader> dataset;
+  ASSERT_OK_NO_THROW(DatasetReader::Make(files, opener, ::arrow::default_memory_pool(),
+                                         ::parquet::default_reader_properties(),
+                                         &dataset));
+  ASSERT_EQ(num_files, dataset->num_files());
+  ASSERT_EQ(num_files * num_rows, dataset->num_rows());
+  dataset->set_num_threads(4);
+
+  // One chunk per row group, in file order
+  std::shared_ptr<Table> result;
+  ASSERT_OK_NO_THROW(dataset->ReadTable({0}, &result));
+  ASSERT_EQ(num_files * num_rows, result->num_rows());
+  auto chunked = result->column(0)->data();
+  ASSERT_EQ(12, chunked->num_chunks());
+  for (int k = 0; k < chunked->num_chunks(); k++) {
+    ASSERT_TRUE(values[k / 4]->Slice((k % 4) * row_group_size, row_group_size)->Equals(
+        chunked->chunk(k)));
+  }
+
+  // The row groups holding [900, 1300)
+  RowGroupPredicate predicate;
+  predicate.Add<Int64Type>(0, CompareOperator::GE, 900)
+      .Add<Int64Type>(0, CompareOperator::LT, 1300);
+  ASSERT_OK_NO_THROW(dataset->ReadTable({0}, predicate, &result));
+  ASSERT_EQ(3 * row_group_size, result->num_rows());
+
+  std::shared_ptr<::arrow::RecordBatchReader> batch_reader;
+  ASSERT_OK_NO_THROW(dataset->GetRecordBatchReader({0}, predicate, &batch_reader));
+  std::vector<std::shared_ptr<Array>> expected = {values[0]->Slice(750, row_group_size),
+                                                  values[1]->Slice(0, row_group_size),
+                                                  values[1]->Slice(250, row_group_size)};
+  std::shared_ptr<::arrow::RecordBatch> batch;
+  for (const auto& array : expected) {
+    ASSERT_OK(batch_reader->ReadNext(&batch));
+    ASSERT_NE(nullptr, batch);
+    ASSERT_TRUE(array->Equals(batch->column(0)));
+  }
+  ASSERT_OK(batch_reader->ReadNext(&batch));
+  ASSERT_EQ(nullptr, batch);
+
+  // The files are closed after their last selected row group, and reopened
+  // by the next read
+  num_opened = 0;
+  ASSERT_OK_NO_THROW(dataset->ReadTable({0}, predicate, &result));
+  ASSERT_EQ(2, num_opened);
+  batch_reader.reset();
+  num_opened = 0;
+  ASSERT_OK_NO_THROW(dataset->GetRecordBatchReader({0}, predicate, &batch_reader));
+  ASSERT_OK(batch_reader->ReadNext(&batch));
+  batch_reader.reset();
+  ASSERT_OK_NO_THROW(dataset->ReadTable({0}, predicate, &result));
+  ASSERT_EQ(4, num_opened);
+
+  // Files opened with their metadata are only opened when read
+  for (int f = 0; f < num_files; f++) {
+    files[f].metadata = dataset->metadata(f);
+  }
+  num_opened = 0;
+  ASSERT_OK_NO_THROW(DatasetReader::Make(files, opener, ::arrow::default_memory_pool(),
+                                         ::parquet::default_reader_properties(),
+                                         &dataset));
+  ASSERT_EQ(0, num_opened);
+  RowGroupPredicate second_file;
+  second_file.Add<Int64Type>(0, CompareOperator::EQ, 1500);
+  ASSERT_OK_NO_THROW(dataset->ReadTable({0}, second_file, &result));
+  ASSERT_EQ(row_group_size, result->num_rows());
+  ASSERT_EQ(1, num_opened);
+
+  files.push_back({"missing", nullptr});
+  ASSERT_RAISES(IOError,
+                DatasetReader::Make(files, opener, ::arrow::default_memory_pool(),
+                                    ::parquet::default_reader_properties(), &dataset));
+}
+
+TEST(TestArrowReadWrite, ReadRowRanges) {
+  const int num_rows = 10000;
+
+  std::shared_ptr<Array> values;
+  ASSERT_OK(NullableArray<::arrow::Int64Type>(num_rows, num_rows / 10, 0, &values));
+  std::shared_ptr<Table> table = MakeSimpleTable(values, true);
+
+  // Small pages so that whole pages are skipped between the ranges
+  auto sink = std::make_shared<InMemoryOutputStream>();
+  auto properties = WriterProperties::Builder().data_pagesize(1024)->build();
+  ASSERT_OK_NO_THROW(
+      WriteTable(*table, ::arrow::default_memory_pool(), sink, num_rows, properties));
+  std::shared_ptr<Buffer> buffer = sink->GetBuffer();
+
+  std::unique_ptr<FileReader> reader;
+  ASSERT_OK_NO_THROW(OpenFile(std::make_shared<BufferReader>(buffer),
+                              ::arrow::default_memory_pool(),
+                              ::parquet::default_reader_properties(), nullptr, &reader));
+
+  std::vector<RowRange> ranges = {{5, 10}, {15, 1}, {2000, 30}, {9990, 10}};
+  std::shared_ptr<Table> result;
+  ASSERT_OK_NO_THROW(reader->ReadRowGroup(0, {0}, ranges, &result));
+  ASSERT_EQ(51, result->num_rows());
+
+  // The selected rows are read into a single chunk
+  auto chunked = result->column(0)->data();
+  ASSERT_EQ(1, chunked->num_chunks());
+  std::shared_ptr<Array> chunk = chunked->chunk(0);
+  ASSERT_TRUE(values->Slice(5, 11)->Equals(chunk->Slice(0, 11)));
+  ASSERT_TRUE(values->Slice(2000, 30)->Equals(chunk->Slice(11, 30)));
+  ASSERT_TRUE(values->Slice(9990, 10)->Equals(chunk->Slice(41, 10)));
+
+  ASSERT_OK_NO_THROW(reader->ReadRowGroup(0, {0}, std::vector<RowRange>(), &result));
+  ASSERT_EQ(0, result->num_rows());
+
+  std::vector<RowRange> unsorted = {{20, 5}, {10, 5}};
+  ASSERT_RAISES(Invalid, reader->ReadRowGroup(0, {0}, unsorted, &result));
+  std::vector<RowRange> out_of_bounds = {{num_rows - 1, 2}};
+  ASSERT_RAISES(Invalid, reader->ReadRowGroup(0, {0}, out_of_bounds, &result));
+}
+
+TEST(TestArrowReadWrite, ParallelPageDecoding) {
+  const int num_rows = 10000;
+
+  std::shared_ptr<Array> values;
+  ASSERT_OK(NullableArray<::arrow::Int64Type>(num_rows, num_rows / 10, 0, &values));
+  std::shared_ptr<Table> table = MakeSimpleTable(values, true);
+
+  // With and without a page index to locate the pages
+  for (bool page_index : {true, false}) {
+    auto sink = std::make_shared<InMemoryOutputStream>();
+    WriterProperties::Builder builder;
+    builder.data_pagesize(1024);
+    if (page_index) {
+      builder.enable_page_index();
+    }
+    ASSERT_OK_NO_THROW(WriteTable(*table, ::arrow::default_memory_pool(), sink,
+                                  num_rows, builder.build()));
+
+    std::unique_ptr<FileReader> reader;
+    ASSERT_OK_NO_THROW(OpenFile(std::make_shared<BufferReader>(sink->GetBuffer()),
+                                ::arrow::default_memory_pool(),
+                                ::parquet::default_reader_properties(), nullptr,
+                                &reader));
+    reader->set_num_threads(4);
+    reader->set_parallel_page_decoding(true);
+
+    std::shared_ptr<Table> result;
+    ASSERT_OK_NO_THROW(reader->ReadRowGroup(0, {0}, &result));
+    ASSERT_EQ(4, result->column(0)->data()->num_chunks());
+    ASSERT_TRUE(table->Equals(*result));
+  }
+}
+
+TEST(TestArrowReadWrite, FilterRowGroup) {
+  const int num_rows = 10000;
+
+  std::vector<int64_t> keys(num_rows);
+  for (int i = 0; i < num_rows; i++) {
+    keys[i] = i % 1000;
+  }
+  std::shared_ptr<Array> key_values;
+  ::arrow::ArrayFromVector<::arrow::Int64Type, int64_t>(keys, &key_values);
+  std::shared_ptr<Array> values;
+  ASSERT_OK(NullableArray<::arrow::DoubleType>(num_rows, num_rows / 10, 0, &values));
+  std::vector<std::shared_ptr<::arrow::Column>> columns = {
+      MakeColumn("key", key_values, false), MakeColumn("value", values, true)};
+  auto schema = std::make_shared<::arrow::Schema>(
+      std::vector<std::shared_ptr<::arrow::Field>>({columns[0]->field(),
+                                                     columns[1]->field()}));
+  auto table = std::make_shared<Table>(schema, columns);
+
+  std::shared_ptr<Buffer> buffer;
+  WriteTableToBuffer(table, 1, num_rows, default_arrow_writer_properties(), &buffer);
+
+  std::unique_ptr<FileReader> reader;
+  ASSERT_OK_NO_THROW(OpenFile(std::make_shared<BufferReader>(buffer),
+                              ::arrow::default_memory_pool(),
+                              ::parquet::default_reader_properties(), nullptr, &reader));
+
+  // Keeps the keys 998, 999 and 0, which span the batch boundaries
+  RowFilter filter = [](const Table& batch,
+                        std::shared_ptr<::arrow::BooleanArray>* out) {
+    auto keys = std::static_pointer_cast<::arrow::Int64Array>(
+        batch.column(0)->data()->chunk(0));
+    ::arrow::BooleanBuilder builder;
+    for (int64_t i = 0; i < keys->length(); i++) {
+      RETURN_NOT_OK(builder.Append(keys->Value(i) >= 998 || keys->Value(i) == 0));
+    }
+    return builder.Finish(out);
+  };
+
+  std::vector<RowRange> ranges;
+  ASSERT_OK_NO_THROW(reader->SelectRows(0, {0}, filter, 1000, &ranges));
+  ASSERT_EQ(11U, ranges.size());
+  ASSERT_EQ(0, ranges[0].offset);
+  ASSERT_EQ(1, ranges[0].length);
+  ASSERT_EQ(998, ranges[1].offset);
+  ASSERT_EQ(3, ranges[1].length);
+
+  std::shared_ptr<Table> result;
+  ASSERT_OK_NO_THROW(reader->FilterRowGroup(0, {1}, {0}, filter, 1000, &result));
+  ASSERT_EQ(1 + 3 * 9 + 2, result->num_rows());
+  auto chunked = result->column(0)->data();
+  ASSERT_EQ(1, chunked->num_chunks());
+  std::shared_ptr<Array> chunk = chunked->chunk(0);
+  ASSERT_TRUE(values->Slice(998, 3)->Equals(chunk->Slice(1, 3)));
+  ASSERT_TRUE(values->Slice(num_rows - 2, 2)->Equals(chunk->Slice(28, 2)));
+
+  RowFilter bad_filter = [](const Table& batch,
+                            std::shared_ptr<::arrow::BooleanArray>* out) {
+    ::arrow::BooleanBuilder builder;
+    return builder.Finish(out);
+  };
+  ASSERT_RAISES(Invalid, reader->SelectRows(0, {0}, bad_filter, 1000, &ranges));
+}
+
+TEST(TestArrowReadWrite, GetRecordBatchReader) {
+  const int num_columns = 4;
+  const int num_rows = 1000;
+  const int64_t batch_size = 300;
+
+  std::shared_ptr<Table> table;
+  MakeDoubleTable(num_columns, num_rows, 1, &table);
+
+  std::shared_ptr<Buffer> buffer;
+  WriteTableToBuffer(table, 1, num_rows / 2, default_arrow_writer_properties(), &buffer);
+
+  std::unique_ptr<FileReader> reader;
+  ASSERT_OK_NO_THROW(OpenFile(std::make_shared<BufferReader>(buffer),
+                              ::arrow::default_memory_pool(),
+                              ::parquet::default_reader_properties(), nullptr, &reader));
+  ASSERT_EQ(2, reader->num_row_groups());
+
+  // Batches span the row group boundary
+  std::shared_ptr<::arrow::RecordBatchReader> batch_reader;
+  ASSERT_OK_NO_THROW(reader->GetRecordBatchReader({0, 1}, {1, 3}, batch_size,
+                                                  &batch_reader));
+  ASSERT_EQ(2, batch_reader->schema()->num_fields());
+  int64_t offset = 0;
+  std::shared_ptr<::arrow::RecordBatch> batch;
+  while (true) {
+    ASSERT_OK(batch_reader->ReadNext(&batch));
+    if (batch == nullptr) {
+      break;
+    }
+    int64_t expected_rows = std::min<int64_t>(batch_size, num_rows - offset);
+    ASSERT_EQ(expected_rows, batch->num_rows());
+    for (int i = 0; i < 2; ++i) {
+      auto expected = table->column(2 * i + 1)->data()->chunk(0);
+      ASSERT_TRUE(expected->Slice(offset, expected_rows)->Equals(batch->column(i)));
+    }
+    offset += expected_rows;
+  }
+  ASSERT_EQ(num_rows, offset);
+
+  // Only the second row group
+  ASSERT_OK_NO_THROW(reader->GetRecordBatchReader({1}, {0}, num_rows, &batch_reader));
+  ASSERT_OK(batch_reader->ReadNext(&batch));
+  ASSERT_EQ(num_rows / 2, batch->num_rows());
+  ASSERT_TRUE(table->column(0)->data()->chunk(0)->Slice(num_rows / 2)->Equals(
+      batch->column(0)));
+  ASSERT_OK(batch_reader->ReadNext(&batch));
+  ASSERT_EQ(nullptr, batch);
+}
+
 TEST(TestArrowReadWrite, ScanContents) {
   const int num_columns = 20;
   const int num_rows = 1000;
@@ -1266,6 +2148,153 @@ TEST(TestArrowReadWrite, ScanContents) {
   ASSERT_EQ(num_rows, num_rows_returned);
 }
 
+TEST(TestArrowReadWrite, ReadNullCount) {
+  const int num_rows = 1000;
+
+  std::shared_ptr<Table> table;
+  MakeDoubleTable(1, num_rows, 1, &table);
+  int64_t expected = table->column(0)->data()->chunk(0)->null_count();
+
+  // From the statistics, then from the levels of data pages of both versions
+  std::vector<std::shared_ptr<WriterProperties>> properties = {
+      default_writer_properties(),
+      WriterProperties::Builder().disable_statistics()->build(),
+      WriterProperties::Builder()
+          .disable_statistics()
+          ->data_page_version(ParquetDataPageVersion::V2)
+          ->compression(Compression::SNAPPY)
+          ->build()};
+  for (const auto& props : properties) {
+    auto sink = std::make_shared<InMemoryOutputStream>();
+    ASSERT_OK_NO_THROW(WriteTable(*table, ::arrow::default_memory_pool(), sink,
+                                  num_rows / 4, props));
+
+    std::unique_ptr<FileReader> reader;
+    ASSERT_OK_NO_THROW(OpenFile(std::make_shared<BufferReader>(sink->GetBuffer()),
+                                ::arrow::default_memory_pool(),
+                                ::parquet::default_reader_properties(), nullptr,
+                                &reader));
+    int64_t null_count = 0;
+    ASSERT_OK_NO_THROW(reader->ReadNullCount(0, &null_count));
+    ASSERT_EQ(expected, null_count);
+  }
+}
+
+// A DecimalArray of values whose high halves grow with the precision, every
+// third value being null if nullable
+static std::shared_ptr<Array> MakeDecimalArray(int precision, int64_t length,
+                                               bool nullable) {
+  auto type = std::make_shared<::arrow::DecimalType>(precision, 2);
+  auto data = std::make_shared<PoolBuffer>(::arrow::default_memory_pool());
+  EXPECT_OK(data->Resize(length * 16));
+  auto valid_bits = std::make_shared<PoolBuffer>(::arrow::default_memory_pool());
+  EXPECT_OK(valid_bits->Resize(::arrow::BitUtil::CeilByte(length) / 8));
+  memset(valid_bits->mutable_data(), 0, valid_bits->size());
+
+  int64_t null_count = 0;
+  auto halves = reinterpret_cast<int64_t*>(data->mutable_data());
+  for (int64_t i = 0; i < length; i++) {
+    const int64_t value = (i % 2 ? -1 : 1) * (i * 7919 % 100000);
+    if (precision > 18) {
+      halves[2 * i] = value * INT64_C(1000003);
+      halves[2 * i + 1] = (i - length / 2) * 12345;
+    } else {
+      halves[2 * i] = precision > 9 ? value * INT64_C(1000003) : value;
+      halves[2 * i + 1] = halves[2 * i] < 0 ? -1 : 0;
+    }
+    if (nullable && i % 3 == 0) {
+      null_count++;
+    } else {
+      ::arrow::BitUtil::SetBit(valid_bits->mutable_data(), i);
+    }
+  }
+  if (!nullable) {
+    return std::make_shared<::arrow::DecimalArray>(type, length, data);
+  }
+  return std::make_shared<::arrow::DecimalArray>(type, length, data, valid_bits,
+                                                 null_count);
+}
+
+TEST(TestArrowReadWrite, DecimalRoundTrip) {
+  const int64_t num_rows = 1000;
+
+  // Written as INT32, INT64 and FIXED_LEN_BYTE_ARRAY of 13 bytes
+  std::vector<std::pair<int, ParquetType::type>> cases = {
+      {5, ParquetType::INT32},
+      {15, ParquetType::INT64},
+      {30, ParquetType::FIXED_LEN_BYTE_ARRAY}};
+  for (const auto& test_case : cases) {
+    for (bool nullable : {false, true}) {
+      std::shared_ptr<Array> values =
+          MakeDecimalArray(test_case.first, num_rows, nullable);
+      std::shared_ptr<Table> table = MakeSimpleTable(values, nullable);
+      auto sink = std::make_shared<InMemoryOutputStream>();
+      ASSERT_OK_NO_THROW(WriteTable(*table, ::arrow::default_memory_pool(), sink,
+                                    num_rows / 4, default_writer_properties()));
+
+      std::unique_ptr<FileReader> reader;
+      ASSERT_OK_NO_THROW(OpenFile(std::make_shared<BufferReader>(sink->GetBuffer()),
+                                  ::arrow::default_memory_pool(),
+                                  ::parquet::default_reader_properties(), nullptr,
+                                  &reader));
+      const ColumnDescriptor* descr =
+          reader->parquet_reader()->metadata()->schema()->Column(0);
+      ASSERT_EQ(test_case.second, descr->physical_type());
+      ASSERT_EQ(test_case.first, descr->type_precision());
+
+      std::shared_ptr<Table> result;
+      ASSERT_OK_NO_THROW(reader->ReadTable(&result));
+      std::shared_ptr<ChunkedArray> chunked_array = result->column(0)->data();
+      ASSERT_EQ(1, chunked_array->num_chunks());
+      ASSERT_TRUE(values->Equals(chunked_array->chunk(0)));
+    }
+  }
+}
+
+TEST(TestArrowReadWrite, ReadByteArrayDecimals) {
+  // -128, 0x7FFF, -2^64 and null as minimal big-endian values
+  std::vector<std::vector<uint8_t>> bytes = {
+      {0x80}, {0x7F, 0xFF}, {0xFF, 0, 0, 0, 0, 0, 0, 0, 0}};
+  std::vector<ByteArray> values;
+  for (const auto& value : bytes) {
+    values.push_back(ByteArray(static_cast<uint32_t>(value.size()), value.data()));
+  }
+  std::vector<int16_t> def_levels = {1, 1, 1, 0};
+
+  auto schema = std::static_pointer_cast<GroupNode>(GroupNode::Make(
+      "schema", Repetition::REQUIRED,
+      {PrimitiveNode::Make("decimal", Repetition::OPTIONAL, ParquetType::BYTE_ARRAY,
+                           LogicalType::DECIMAL, -1, 20, 0)}));
+  auto sink = std::make_shared<InMemoryOutputStream>();
+  auto writer = ParquetFileWriter::Open(sink, schema);
+  RowGroupWriter* rg_writer = writer->AppendRowGroup(4);
+  auto typed_writer =
+      static_cast<TypedColumnWriter<ByteArrayType>*>(rg_writer->NextColumn());
+  typed_writer->WriteBatch(4, def_levels.data(), nullptr, values.data());
+  typed_writer->Close();
+  rg_writer->Close();
+  writer->Close();
+
+  std::unique_ptr<FileReader> reader;
+  ASSERT_OK_NO_THROW(OpenFile(std::make_shared<BufferReader>(sink->GetBuffer()),
+                              ::arrow::default_memory_pool(),
+                              ::parquet::default_reader_properties(), nullptr,
+                              &reader));
+  std::shared_ptr<Array> result;
+  ASSERT_OK_NO_THROW(reader->ReadColumn(0, &result));
+  ASSERT_EQ(4, result->length());
+  ASSERT_EQ(1, result->null_count());
+  ASSERT_TRUE(result->IsNull(3));
+
+  auto decimals = static_cast<const ::arrow::DecimalArray*>(result.get());
+  std::vector<std::vector<int64_t>> expected = {{-128, -1}, {0x7FFF, 0}, {0, -1}};
+  for (int i = 0; i < 3; i++) {
+    std::vector<int64_t> halves(2);
+    memcpy(halves.data(), decimals->GetValue(i), 16);
+    ASSERT_EQ(expected[i], halves) << i;
+  }
+}
+
 TEST(TestArrowReadWrite, ReadColumnSubset) {
   const int num_columns = 20;
   const int num_rows = 1000;
@@ -1648,6 +2677,26 @@ TEST_P(TestNestedSchemaRead, DeepNestedSchemaRead) {
   }
 }
 
+TEST_P(TestNestedSchemaRead, WideStructParallelRead) {
+  const int depth = 2;
+  const int num_children = 15;
+  int num_rows = SMALL_SIZE * depth;
+  CreateMultiLevelNestedParquet(1, depth, num_children, num_rows, GetParam());
+  std::shared_ptr<Table> expected;
+  ASSERT_OK_NO_THROW(reader_->ReadTable(&expected));
+
+  // The children of the struct are read on several threads
+  reader_->set_num_threads(8);
+  std::shared_ptr<Table> table;
+  ASSERT_OK_NO_THROW(reader_->ReadTable(&table));
+  ASSERT_EQ(table->num_rows(), num_rows);
+  auto tree = table->column(0)->data()->chunk(0);
+  ASSERT_TRUE(tree->Equals(expected->column(0)->data()->chunk(0)));
+
+  DeepParquetTestVisitor visitor(GetParam(), values_array_);
+  ASSERT_OK_NO_THROW(visitor.Validate(tree));
+}
+
 INSTANTIATE_TEST_CASE_P(Repetition_type, TestNestedSchemaRead,
                         ::testing::Values(Repetition::REQUIRED, Repetition::OPTIONAL));
 
@@ -1660,6 +2709,20 @@ TEST(TestImpalaConversion, NanosecondToImpala) {
   ASSERT_EQ(expected, calculated);
 }
 
+TEST(TestImpalaConversion, NanosecondsToImpalaBatch) {
+  std::vector<int64_t> nanoseconds = {INT64_C(0), INT64_C(1497976376123456789),
+                                      INT64_C(86399999999999), INT64_C(86400000000000)};
+  std::vector<Int96> calculated(nanoseconds.size());
+  internal::NanosecondsToImpalaTimestamps(nanoseconds.data(),
+                                          static_cast<int64_t>(nanoseconds.size()),
+                                          calculated.data());
+  for (size_t i = 0; i < nanoseconds.size(); ++i) {
+    Int96 expected;
+    internal::NanosecondsToImpalaTimestamp(nanoseconds[i], &expected);
+    ASSERT_EQ(expected, calculated[i]) << i;
+  }
+}
+
 TEST(TestArrowReaderAdHoc, Int96BadMemoryAccess) {
   // PARQUET-995
   const char* data_dir = std::getenv("PARQUET_TEST_DATA");
@@ -739,7 +739,29 @@ TEST_F(TestConvertArrowSchema, ParquetFlatDecimals) {
   std::vector<NodePtr> parquet_fields;
   std::vector<std::shared_ptr<Field>> arrow_fields;
 
-  // TODO: Test Decimal Arrow -> Parquet conversion
+  // The physical type is the narrowest one holding the precision
+  parquet_fields.push_back(PrimitiveNode::Make("decimal_8_4", Repetition::OPTIONAL,
+                                               ParquetType::INT32, LogicalType::DECIMAL,
+                                               -1, 8, 4));
+  arrow_fields.push_back(std::make_shared<Field>("decimal_8_4", DECIMAL_8_4));
+
+  parquet_fields.push_back(PrimitiveNode::Make("decimal_18_2", Repetition::REQUIRED,
+                                               ParquetType::INT64, LogicalType::DECIMAL,
+                                               -1, 18, 2));
+  arrow_fields.push_back(std::make_shared<Field>(
+      "decimal_18_2", std::make_shared<::arrow::DecimalType>(18, 2), false));
+
+  parquet_fields.push_back(PrimitiveNode::Make("decimal_19_0", Repetition::OPTIONAL,
+                                               ParquetType::FIXED_LEN_BYTE_ARRAY,
+                                               LogicalType::DECIMAL, 9, 19, 0));
+  arrow_fields.push_back(std::make_shared<Field>(
+      "decimal_19_0", std::make_shared<::arrow::DecimalType>(19, 0)));
+
+  parquet_fields.push_back(PrimitiveNode::Make("decimal_38_10", Repetition::OPTIONAL,
+                                               ParquetType::FIXED_LEN_BYTE_ARRAY,
+                                               LogicalType::DECIMAL, 16, 38, 10));
+  arrow_fields.push_back(std::make_shared<Field>(
+      "decimal_38_10", std::make_shared<::arrow::DecimalType>(38, 10)));
 
   ASSERT_OK(ConvertSchema(arrow_fields));
 
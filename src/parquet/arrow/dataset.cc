@@ -0,0 +1,538 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "parquet/arrow/dataset.h"
+
+#include <algorithm>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "arrow/api.h"
+#include "arrow/io/file.h"
+
+#include "parquet/arrow/reader.h"
+#include "parquet/arrow/schema.h"
+#include "parquet/util/schema-util.h"
+#include "parquet/util/thread-pool.h"
+
+using arrow::Array;
+using arrow::Column;
+using arrow::MemoryPool;
+using arrow::Status;
+using arrow::Table;
+
+namespace parquet {
+namespace arrow {
+
+// A row group of one of the data files
+struct DatasetRowGroup {
+  int file;
+  int row_group;
+};
+
+class DatasetReader::Impl {
+ public:
+  Impl(const DatasetFileOpener& opener, MemoryPool* pool, const ReaderProperties& props)
+      : opener_(opener),
+        pool_(pool),
+        properties_(props),
+        num_threads_(1),
+        thread_pool_(ThreadPool::Default()) {}
+
+  Status Init(const std::vector<DatasetFile>& files);
+
+  int num_files() const { return static_cast<int>(files_.size()); }
+
+  std::shared_ptr<FileMetaData> metadata(int i) const { return files_[i]->metadata; }
+
+  const SchemaDescriptor* schema() const { return files_[0]->metadata->schema(); }
+
+  int64_t num_rows() const;
+
+  // The arrow schema of the top-level fields holding the indicated columns,
+  // and the indicated columns of each of these fields
+  Status GetSchema(const std::vector<int>& indices,
+                   std::shared_ptr<::arrow::Schema>* out,
+                   std::vector<std::vector<int>>* field_columns);
+
+  std::vector<DatasetRowGroup> SelectRowGroups(const RowGroupPredicate& predicate);
+
+  // Retain the readers of the files of the row groups for reads_per_row_group
+  // reads of each row group
+  void RetainReaders(const std::vector<DatasetRowGroup>& row_groups,
+                     int reads_per_row_group);
+
+  // Drop one retained read of the i-th file, closing its reader after the last
+  void ReleaseReader(int i);
+
+  // Read the columns of a single field of the row group, then release the
+  // read retained for it
+  Status ReadChunk(const DatasetRowGroup& row_group, const std::vector<int>& columns,
+                   std::shared_ptr<Array>* out);
+
+  Status ReadTable(const std::vector<int>& indices, const RowGroupPredicate& predicate,
+                   std::shared_ptr<Table>* out);
+
+  Status GetRecordBatchReader(const std::vector<int>& indices,
+                              const RowGroupPredicate& predicate,
+                              std::shared_ptr<::arrow::RecordBatchReader>* out);
+
+  void set_num_threads(int num_threads) { num_threads_ = num_threads; }
+
+  void set_thread_pool(const std::shared_ptr<ThreadPool>& thread_pool) {
+    thread_pool_ = thread_pool;
+  }
+
+ private:
+  struct File {
+    std::string path;
+    std::shared_ptr<FileMetaData> metadata;
+    // Opened on first use and closed once no retained read is left, under
+    // the mutex
+    std::unique_ptr<FileReader> reader;
+    int pending_reads = 0;
+    std::mutex mutex;
+  };
+
+  Status OpenReader(File* file);
+
+  // Returns the reader of the i-th file, opening it if needed
+  Status GetFileReader(int i, FileReader** out);
+
+  DatasetFileOpener opener_;
+  MemoryPool* pool_;
+  ReaderProperties properties_;
+  int num_threads_;
+  std::shared_ptr<ThreadPool> thread_pool_;
+
+  std::vector<std::unique_ptr<File>> files_;
+};
+
+// Reads the selected row groups in order, keeping up to num_threads of them
+// in flight on the thread pool
+class PARQUET_NO_EXPORT DatasetRecordBatchReader : public ::arrow::RecordBatchReader {
+ public:
+  DatasetRecordBatchReader(DatasetReader::Impl* impl,
+                           const std::shared_ptr<::arrow::Schema>& schema,
+                           std::vector<std::vector<int>> field_columns,
+                           std::vector<DatasetRowGroup> row_groups,
+                           const std::shared_ptr<ThreadPool>& thread_pool,
+                           int num_threads)
+      : impl_(impl),
+        schema_(schema),
+        field_columns_(std::move(field_columns)),
+        row_groups_(std::move(row_groups)),
+        next_row_group_(0),
+        thread_pool_(thread_pool),
+        num_threads_(std::max(num_threads, 1)) {}
+
+  // The pending reads reference this reader. The row groups not submitted
+  // yet still retain their files
+  ~DatasetRecordBatchReader() {
+    for (const auto& read : pending_) {
+      read->status.wait();
+    }
+    for (; next_row_group_ < row_groups_.size(); ++next_row_group_) {
+      for (size_t i = 0; i < field_columns_.size(); ++i) {
+        impl_->ReleaseReader(row_groups_[next_row_group_].file);
+      }
+    }
+  }
+
+  std::shared_ptr<::arrow::Schema> schema() const override { return schema_; }
+
+  Status ReadNext(std::shared_ptr<::arrow::RecordBatch>* out) override {
+    while (static_cast<int>(pending_.size()) < num_threads_ &&
+           next_row_group_ < row_groups_.size()) {
+      Submit(row_groups_[next_row_group_++]);
+    }
+    if (pending_.empty()) {
+      *out = nullptr;
+      return Status::OK();
+    }
+    std::shared_ptr<PendingRead> read = pending_.front();
+    pending_.pop_front();
+    RETURN_NOT_OK(read->status.get());
+
+    int64_t num_rows = impl_->metadata(read->row_group.file)
+                           ->RowGroup(read->row_group.row_group)
+                           ->num_rows();
+    *out = std::make_shared<::arrow::RecordBatch>(schema_, num_rows, read->columns);
+    return Status::OK();
+  }
+
+ private:
+  struct PendingRead {
+    DatasetRowGroup row_group;
+    std::vector<std::shared_ptr<Array>> columns;
+    std::future<Status> status;
+  };
+
+  void Submit(const DatasetRowGroup& row_group) {
+    auto read = std::make_shared<PendingRead>();
+    read->row_group = row_group;
+    read->columns.resize(field_columns_.size());
+
+    // Every field releases its read of the file, even after an error
+    auto task = std::make_shared<std::packaged_task<Status()>>([this, read]() {
+      Status status;
+      for (size_t i = 0; i < field_columns_.size(); ++i) {
+        if (status.ok()) {
+          status =
+              impl_->ReadChunk(read->row_group, field_columns_[i], &read->columns[i]);
+        } else {
+          impl_->ReleaseReader(read->row_group.file);
+        }
+      }
+      return status;
+    });
+    read->status = task->get_future();
+    thread_pool_->Submit([task]() { (*task)(); });
+    pending_.push_back(read);
+  }
+
+  DatasetReader::Impl* impl_;
+  std::shared_ptr<::arrow::Schema> schema_;
+  std::vector<std::vector<int>> field_columns_;
+  std::vector<DatasetRowGroup> row_groups_;
+  size_t next_row_group_;
+  std::shared_ptr<ThreadPool> thread_pool_;
+  int num_threads_;
+  std::deque<std::shared_ptr<PendingRead>> pending_;
+};
+
+Status DatasetReader::Impl::Init(const std::vector<DatasetFile>& files) {
+  if (files.empty()) {
+    return Status::Invalid("A dataset needs at least one file");
+  }
+  for (const DatasetFile& file : files) {
+    std::unique_ptr<File> entry(new File());
+    entry->path = file.path;
+    entry->metadata = file.metadata;
+    files_.push_back(std::move(entry));
+  }
+
+  // Read the missing footers in parallel, closing the files until one of
+  // their row groups is read
+  std::vector<File*> unread;
+  for (const auto& file : files_) {
+    if (file->metadata == nullptr) {
+      unread.push_back(file.get());
+    }
+  }
+  if (!unread.empty()) {
+    int num_tasks = static_cast<int>(unread.size());
+    auto OpenFunc = [&unread, this](int i) {
+      RETURN_NOT_OK(OpenReader(unread[i]));
+      unread[i]->metadata = unread[i]->reader->parquet_reader()->metadata();
+      unread[i]->reader.reset();
+      return Status::OK();
+    };
+    int nthreads = std::max(std::min(thread_pool_->num_threads(), num_tasks), 1);
+    RETURN_NOT_OK(ParallelFor(thread_pool_.get(), nthreads, num_tasks, OpenFunc));
+  }
+
+  for (const auto& file : files_) {
+    if (!file->metadata->schema()->Equals(*schema())) {
+      return Status::Invalid("The schema of " + file->path +
+                             " differs from the schema of the dataset");
+    }
+  }
+  return Status::OK();
+}
+
+Status DatasetReader::Impl::OpenReader(File* file) {
+  std::shared_ptr<::arrow::io::ReadableFileInterface> source;
+  RETURN_NOT_OK(opener_(file->path, &source));
+  return OpenFile(source, pool_, properties_, file->metadata, &file->reader);
+}
+
+Status DatasetReader::Impl::GetFileReader(int i, FileReader** out) {
+  File* file = files_[i].get();
+  std::lock_guard<std::mutex> lock(file->mutex);
+  if (file->reader == nullptr) {
+    RETURN_NOT_OK(OpenReader(file));
+  }
+  *out = file->reader.get();
+  return Status::OK();
+}
+
+void DatasetReader::Impl::RetainReaders(const std::vector<DatasetRowGroup>& row_groups,
+                                        int reads_per_row_group) {
+  for (const DatasetRowGroup& row_group : row_groups) {
+    File* file = files_[row_group.file].get();
+    std::lock_guard<std::mutex> lock(file->mutex);
+    file->pending_reads += reads_per_row_group;
+  }
+}
+
+void DatasetReader::Impl::ReleaseReader(int i) {
+  File* file = files_[i].get();
+  std::lock_guard<std::mutex> lock(file->mutex);
+  if (--file->pending_reads == 0) {
+    file->reader.reset();
+  }
+}
+
+int64_t DatasetReader::Impl::num_rows() const {
+  int64_t num_rows = 0;
+  for (const auto& file : files_) {
+    num_rows += file->metadata->num_rows();
+  }
+  return num_rows;
+}
+
+Status DatasetReader::Impl::GetSchema(const std::vector<int>& indices,
+                                      std::shared_ptr<::arrow::Schema>* out,
+                                      std::vector<std::vector<int>>* field_columns) {
+  const SchemaDescriptor* descr = schema();
+  for (int index : indices) {
+    if (index < 0 || index >= descr->num_columns()) {
+      return Status::Invalid("Invalid column index");
+    }
+  }
+  std::vector<int> field_indices;
+  if (!ColumnIndicesToFieldIndices(*descr, indices, &field_indices)) {
+    return Status::Invalid("Invalid column index");
+  }
+  field_columns->assign(field_indices.size(), std::vector<int>());
+  for (size_t i = 0; i < field_indices.size(); ++i) {
+    const schema::Node* field = descr->group_node()->field(field_indices[i]).get();
+    for (int index : indices) {
+      if (descr->GetColumnRoot(index).get() == field) {
+        (*field_columns)[i].push_back(index);
+      }
+    }
+  }
+  return FromParquetSchema(descr, indices, files_[0]->metadata->key_value_metadata(),
+                           out);
+}
+
+std::vector<DatasetRowGroup> DatasetReader::Impl::SelectRowGroups(
+    const RowGroupPredicate& predicate) {
+  std::vector<DatasetRowGroup> row_groups;
+  for (int i = 0; i < num_files(); ++i) {
+    for (int row_group : predicate.SelectRowGroups(*files_[i]->metadata)) {
+      row_groups.push_back({i, row_group});
+    }
+  }
+  return row_groups;
+}
+
+Status DatasetReader::Impl::ReadChunk(const DatasetRowGroup& row_group,
+                                      const std::vector<int>& columns,
+                                      std::shared_ptr<Array>* out) {
+  Status status;
+  try {
+    FileReader* reader;
+    std::shared_ptr<Table> table;
+    status = GetFileReader(row_group.file, &reader);
+    if (status.ok()) {
+      status = reader->ReadRowGroup(row_group.row_group, columns, &table);
+    }
+    if (status.ok()) {
+      // All the columns belong to the same field, read as a single chunk
+      *out = table->column(0)->data()->chunk(0);
+    }
+  } catch (const ::parquet::ParquetException& e) {
+    status = Status::IOError(e.what());
+  }
+  ReleaseReader(row_group.file);
+  return status;
+}
+
+Status DatasetReader::Impl::ReadTable(const std::vector<int>& indices,
+                                      const RowGroupPredicate& predicate,
+                                      std::shared_ptr<Table>* out) {
+  std::shared_ptr<::arrow::Schema> schema;
+  std::vector<std::vector<int>> field_columns;
+  RETURN_NOT_OK(GetSchema(indices, &schema, &field_columns));
+
+  std::vector<DatasetRowGroup> row_groups = SelectRowGroups(predicate);
+  int num_fields = static_cast<int>(field_columns.size());
+  int num_row_groups = static_cast<int>(row_groups.size());
+  std::vector<std::shared_ptr<Column>> columns(num_fields);
+
+  if (num_row_groups == 0) {
+    // Nothing to read, return empty columns
+    for (int i = 0; i < num_fields; i++) {
+      std::unique_ptr<::arrow::ArrayBuilder> builder;
+      std::shared_ptr<Array> array;
+      RETURN_NOT_OK(::arrow::MakeBuilder(pool_, schema->field(i)->type(), &builder));
+      RETURN_NOT_OK(builder->Finish(&array));
+      columns[i] = std::make_shared<Column>(schema->field(i), array);
+    }
+    *out = std::make_shared<Table>(schema, columns);
+    return Status::OK();
+  }
+
+  std::vector<std::vector<std::shared_ptr<Array>>> chunks(
+      num_fields, std::vector<std::shared_ptr<Array>>(num_row_groups));
+
+  // The tasks of a row group are consecutive, so that the row groups are read
+  // mostly in file order and each file is closed after its last row group
+  int num_tasks = num_fields * num_row_groups;
+  std::vector<char> started(num_tasks, 0);
+  auto ReadChunkFunc = [&field_columns, &row_groups, &chunks, &started, num_fields,
+                        this](int task) {
+    int i = task % num_fields;
+    int j = task / num_fields;
+    started[task] = 1;
+    return ReadChunk(row_groups[j], field_columns[i], &chunks[i][j]);
+  };
+
+  RetainReaders(row_groups, num_fields);
+  int nthreads = std::max(std::min(num_threads_, num_tasks), 1);
+  Status status = ParallelFor(thread_pool_.get(), nthreads, num_tasks, ReadChunkFunc);
+  // The tasks skipped after an error still retain their files
+  for (int task = 0; task < num_tasks; ++task) {
+    if (!started[task]) {
+      ReleaseReader(row_groups[task / num_fields].file);
+    }
+  }
+  RETURN_NOT_OK(status);
+
+  for (int i = 0; i < num_fields; i++) {
+    columns[i] = std::make_shared<Column>(schema->field(i), chunks[i]);
+  }
+  *out = std::make_shared<Table>(schema, columns);
+  return Status::OK();
+}
+
+Status DatasetReader::Impl::GetRecordBatchReader(
+    const std::vector<int>& indices, const RowGroupPredicate& predicate,
+    std::shared_ptr<::arrow::RecordBatchReader>* out) {
+  std::shared_ptr<::arrow::Schema> schema;
+  std::vector<std::vector<int>> field_columns;
+  RETURN_NOT_OK(GetSchema(indices, &schema, &field_columns));
+  std::vector<DatasetRowGroup> row_groups = SelectRowGroups(predicate);
+  RetainReaders(row_groups, static_cast<int>(field_columns.size()));
+  out->reset(new DatasetRecordBatchReader(this, schema, std::move(field_columns),
+                                          std::move(row_groups), thread_pool_,
+                                          num_threads_));
+  return Status::OK();
+}
+
+static Status OpenLocalFile(const std::string& path,
+                            std::shared_ptr<::arrow::io::ReadableFileInterface>* out) {
+  std::shared_ptr<::arrow::io::ReadableFile> handle;
+  RETURN_NOT_OK(::arrow::io::ReadableFile::Open(path, &handle));
+  *out = handle;
+  return Status::OK();
+}
+
+DatasetReader::DatasetReader(std::unique_ptr<Impl> impl) : impl_(std::move(impl)) {}
+
+DatasetReader::~DatasetReader() {}
+
+Status DatasetReader::Make(const std::vector<DatasetFile>& files,
+                           const DatasetFileOpener& opener, MemoryPool* pool,
+                           const ReaderProperties& props,
+                           std::unique_ptr<DatasetReader>* out) {
+  std::unique_ptr<Impl> impl(new Impl(opener, pool, props));
+  try {
+    RETURN_NOT_OK(impl->Init(files));
+  } catch (const ::parquet::ParquetException& e) {
+    return Status::IOError(e.what());
+  }
+  out->reset(new DatasetReader(std::move(impl)));
+  return Status::OK();
+}
+
+Status DatasetReader::Open(const std::vector<std::string>& paths, MemoryPool* pool,
+                           const ReaderProperties& props,
+                           std::unique_ptr<DatasetReader>* out) {
+  std::vector<DatasetFile> files;
+  for (const std::string& path : paths) {
+    files.push_back({path, nullptr});
+  }
+  return Make(files, OpenLocalFile, pool, props, out);
+}
+
+Status DatasetReader::OpenSummary(const std::string& summary_path, MemoryPool* pool,
+                                  const ReaderProperties& props,
+                                  std::unique_ptr<DatasetReader>* out) {
+  std::vector<DatasetFile> files;
+  try {
+    std::unique_ptr<ParquetFileReader> summary =
+        ParquetFileReader::OpenFile(summary_path, false, props);
+    size_t slash = summary_path.rfind('/');
+    std::string directory =
+        slash == std::string::npos ? "" : summary_path.substr(0, slash + 1);
+    for (const SummaryDataFile& data_file : SplitSummaryMetaData(*summary->metadata())) {
+      if (data_file.file_path.empty()) {
+        return Status::Invalid("The summary holds row groups without a data file");
+      }
+      std::string path = data_file.file_path[0] == '/'
+                             ? data_file.file_path
+                             : directory + data_file.file_path;
+      files.push_back({path, data_file.metadata});
+    }
+  } catch (const ::parquet::ParquetException& e) {
+    return Status::IOError(e.what());
+  }
+  return Make(files, OpenLocalFile, pool, props, out);
+}
+
+int DatasetReader::num_files() const { return impl_->num_files(); }
+
+std::shared_ptr<FileMetaData> DatasetReader::metadata(int i) const {
+  return impl_->metadata(i);
+}
+
+const SchemaDescriptor* DatasetReader::schema() const { return impl_->schema(); }
+
+int64_t DatasetReader::num_rows() const { return impl_->num_rows(); }
+
+Status DatasetReader::ReadTable(const std::vector<int>& column_indices,
+                                const RowGroupPredicate& predicate,
+                                std::shared_ptr<Table>* out) {
+  try {
+    return impl_->ReadTable(column_indices, predicate, out);
+  } catch (const ::parquet::ParquetException& e) {
+    return Status::IOError(e.what());
+  }
+}
+
+Status DatasetReader::ReadTable(const std::vector<int>& column_indices,
+                                std::shared_ptr<Table>* out) {
+  return ReadTable(column_indices, RowGroupPredicate(), out);
+}
+
+Status DatasetReader::GetRecordBatchReader(
+    const std::vector<int>& column_indices, const RowGroupPredicate& predicate,
+    std::shared_ptr<::arrow::RecordBatchReader>* out) {
+  try {
+    return impl_->GetRecordBatchReader(column_indices, predicate, out);
+  } catch (const ::parquet::ParquetException& e) {
+    return Status::IOError(e.what());
+  }
+}
+
+void DatasetReader::set_num_threads(int num_threads) {
+  impl_->set_num_threads(num_threads);
+}
+
+void DatasetReader::set_thread_pool(const std::shared_ptr<ThreadPool>& thread_pool) {
+  impl_->set_thread_pool(thread_pool);
+}
+
+}  // namespace arrow
+}  // namespace parquet
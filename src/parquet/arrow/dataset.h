@@ -0,0 +1,136 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef PARQUET_ARROW_DATASET_H
+#define PARQUET_ARROW_DATASET_H
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "parquet/api/reader.h"
+#include "parquet/api/schema.h"
+
+#include "arrow/io/interfaces.h"
+
+namespace arrow {
+
+class MemoryPool;
+class RecordBatchReader;
+class Schema;
+class Status;
+class Table;
+
+}  // namespace arrow
+
+namespace parquet {
+
+class ThreadPool;
+
+namespace arrow {
+
+// A data file of a dataset. If no metadata is given, it is read from the
+// footer of the file when the dataset is opened.
+struct PARQUET_EXPORT DatasetFile {
+  std::string path;
+  std::shared_ptr<FileMetaData> metadata;
+};
+
+// Opens the data file at the given path
+using DatasetFileOpener = std::function<::arrow::Status(
+    const std::string& path, std::shared_ptr<::arrow::io::ReadableFileInterface>* out)>;
+
+// Reads a set of Parquet files sharing the same schema as a single table.
+//
+// The reads are split into one task per (file, row group, column) and run on
+// a shared thread pool. The number of threads bounds the number of tasks, and
+// therefore of column chunk reads, in flight at any time. Only the metadata
+// of the data files is kept: a file is opened once one of its selected row
+// groups is read, and closed again after the last of them.
+class PARQUET_EXPORT DatasetReader {
+ public:
+  // Open the local files at the given paths. Their footers are read in
+  // parallel on ThreadPool::Default(), and the files closed until read.
+  static ::arrow::Status Open(const std::vector<std::string>& paths,
+                              ::arrow::MemoryPool* pool, const ReaderProperties& props,
+                              std::unique_ptr<DatasetReader>* out);
+
+  // Open the dataset described by a _metadata summary file (see
+  // WriteMetaDataFile). The data files are located relative to the directory
+  // of the summary, and are read without reading their own footers.
+  static ::arrow::Status OpenSummary(const std::string& summary_path,
+                                     ::arrow::MemoryPool* pool,
+                                     const ReaderProperties& props,
+                                     std::unique_ptr<DatasetReader>* out);
+
+  // Open the files with opener instead of as local files, e.g. for in-memory
+  // or remote files
+  static ::arrow::Status Make(const std::vector<DatasetFile>& files,
+                              const DatasetFileOpener& opener,
+                              ::arrow::MemoryPool* pool, const ReaderProperties& props,
+                              std::unique_ptr<DatasetReader>* out);
+
+  int num_files() const;
+
+  // The metadata of the i-th data file
+  std::shared_ptr<FileMetaData> metadata(int i) const;
+
+  // The schema shared by all the data files
+  const SchemaDescriptor* schema() const;
+
+  int64_t num_rows() const;
+
+  // Read the indicated leaf columns of the row groups which may match the
+  // predicate (see FileReader::ReadTable), from all files. Each column of the
+  // result has one chunk per row group read, in file order.
+  ::arrow::Status ReadTable(const std::vector<int>& column_indices,
+                            const RowGroupPredicate& predicate,
+                            std::shared_ptr<::arrow::Table>* out);
+
+  ::arrow::Status ReadTable(const std::vector<int>& column_indices,
+                            std::shared_ptr<::arrow::Table>* out);
+
+  // Return a reader yielding one record batch per row group which may match
+  // the predicate, in file order. Up to num_threads row groups are read ahead
+  // in parallel. The returned reader must not outlive this DatasetReader.
+  ::arrow::Status GetRecordBatchReader(
+      const std::vector<int>& column_indices, const RowGroupPredicate& predicate,
+      std::shared_ptr<::arrow::RecordBatchReader>* out);
+
+  /// Set the number of threads, and therefore of tasks in flight, to use for
+  /// the reads. By default only 1 thread is used.
+  void set_num_threads(int num_threads);
+
+  /// Set the pool on which the threads of the reads are scheduled. By default
+  /// the process-wide ThreadPool::Default() is used
+  void set_thread_pool(const std::shared_ptr<ThreadPool>& thread_pool);
+
+  ~DatasetReader();
+
+  class PARQUET_NO_EXPORT Impl;
+
+ private:
+  explicit DatasetReader(std::unique_ptr<Impl> impl);
+
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace arrow
+}  // namespace parquet
+
+#endif  // PARQUET_ARROW_DATASET_H
@@ -20,10 +20,16 @@
 #include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <limits>
 #include <mutex>
+#include <numeric>
 #include <queue>
 #include <string>
 #include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "arrow/api.h"
@@ -31,7 +37,10 @@
 #include "arrow/util/logging.h"
 
 #include "parquet/arrow/schema.h"
+#include "parquet/util/decimal-util.h"
+#include "parquet/util/int-util.h"
 #include "parquet/util/schema-util.h"
+#include "parquet/util/thread-pool.h"
 
 using arrow::Array;
 using arrow::BooleanArray;
@@ -56,56 +65,42 @@ namespace arrow {
 constexpr int64_t kJulianToUnixEpochDays = 2440588LL;
 constexpr int64_t kNanosecondsInADay = 86400LL * 1000LL * 1000LL * 1000LL;
 
-static inline int64_t impala_timestamp_to_nanoseconds(const Int96& impala_timestamp) {
-  int64_t days_since_epoch = impala_timestamp.value[2] - kJulianToUnixEpochDays;
-  int64_t nanoseconds = *(reinterpret_cast<const int64_t*>(&(impala_timestamp.value)));
-  return days_since_epoch * kNanosecondsInADay + nanoseconds;
-}
+constexpr int64_t kMillisecondsInADay = 86400LL * 1000LL;
 
-template <typename ArrowType>
-using ArrayType = typename ::arrow::TypeTraits<ArrowType>::ArrayType;
+// The conversions below are loops over whole batches, without calls or
+// pointer aliasing in their bodies, that the compiler can unroll and
+// vectorize. Null slots hold arbitrary values and are converted as well, so
+// the arithmetic is unsigned to stay well-defined on overflow.
 
-// ----------------------------------------------------------------------
-// Helper for parallel for-loop
-
-template <class FUNCTION>
-Status ParallelFor(int nthreads, int num_tasks, FUNCTION&& func) {
-  std::vector<std::thread> thread_pool;
-  thread_pool.reserve(nthreads);
-  std::atomic<int> task_counter(0);
-
-  std::mutex error_mtx;
-  bool error_occurred = false;
-  Status error;
-
-  for (int thread_id = 0; thread_id < nthreads; ++thread_id) {
-    thread_pool.emplace_back(
-        [&num_tasks, &task_counter, &error, &error_occurred, &error_mtx, &func]() {
-          int task_id;
-          while (!error_occurred) {
-            task_id = task_counter.fetch_add(1);
-            if (task_id >= num_tasks) {
-              break;
-            }
-            Status s = func(task_id);
-            if (!s.ok()) {
-              std::lock_guard<std::mutex> lock(error_mtx);
-              error_occurred = true;
-              error = s;
-              break;
-            }
-          }
-        });
-  }
-  for (auto&& thread : thread_pool) {
-    thread.join();
-  }
-  if (error_occurred) {
-    return error;
+static inline int64_t ImpalaTimestampToNanoseconds(const Int96& impala_timestamp) {
+  uint64_t last_day_nanos;
+  memcpy(&last_day_nanos, impala_timestamp.value, sizeof(uint64_t));
+  uint64_t days_since_epoch =
+      static_cast<uint64_t>(impala_timestamp.value[2]) - kJulianToUnixEpochDays;
+  return static_cast<int64_t>(
+      days_since_epoch * static_cast<uint64_t>(kNanosecondsInADay) + last_day_nanos);
+}
+
+static inline void ImpalaTimestampsToNanoseconds(const Int96* impala_timestamps,
+                                                 int64_t length, int64_t* nanoseconds) {
+  for (int64_t i = 0; i < length; ++i) {
+    nanoseconds[i] = ImpalaTimestampToNanoseconds(impala_timestamps[i]);
   }
-  return Status::OK();
 }
 
+static inline int64_t DayToMilliseconds(int32_t days) {
+  return static_cast<int64_t>(days) * kMillisecondsInADay;
+}
+
+static inline void DaysToMilliseconds(const int32_t* days, int64_t length,
+                                      int64_t* milliseconds) {
+  MultiplyWidenInts(days, length, static_cast<uint32_t>(kMillisecondsInADay),
+                    milliseconds);
+}
+
+template <typename ArrowType>
+using ArrayType = typename ::arrow::TypeTraits<ArrowType>::ArrayType;
+
 // ----------------------------------------------------------------------
 // Iteration utilities
 
@@ -156,6 +151,24 @@ class AllRowGroupsIterator : public FileColumnIterator {
   int next_row_group_;
 };
 
+class RowGroupsIterator : public FileColumnIterator {
+ public:
+  explicit RowGroupsIterator(int column_index, const std::vector<int>& row_groups,
+                             ParquetFileReader* reader)
+      : FileColumnIterator(column_index, reader), row_groups_(row_groups), next_(0) {}
+
+  std::shared_ptr<::parquet::ColumnReader> Next() override {
+    if (next_ == row_groups_.size()) {
+      return nullptr;
+    }
+    return reader_->RowGroup(row_groups_[next_++])->Column(column_index_);
+  };
+
+ private:
+  std::vector<int> row_groups_;
+  size_t next_;
+};
+
 class SingleRowGroupIterator : public FileColumnIterator {
  public:
   explicit SingleRowGroupIterator(int column_index, int row_group_number,
@@ -179,31 +192,107 @@ class SingleRowGroupIterator : public FileColumnIterator {
   bool done_;
 };
 
+// Reads the pages of a single row group from the given page of its offset
+// index up to an end page (-1 for the end of the column chunk)
+class PageRangeIterator : public FileColumnIterator {
+ public:
+  explicit PageRangeIterator(int column_index, int row_group_number,
+                             const OffsetIndex* offset_index, int page, int end_page,
+                             ParquetFileReader* reader)
+      : FileColumnIterator(column_index, reader),
+        row_group_number_(row_group_number),
+        offset_index_(offset_index),
+        page_(page),
+        end_page_(end_page),
+        done_(false) {}
+
+  std::shared_ptr<::parquet::ColumnReader> Next() override {
+    if (done_) {
+      return nullptr;
+    }
+    done_ = true;
+    return reader_->RowGroup(row_group_number_)
+        ->ColumnFromPage(column_index_, *offset_index_, page_, end_page_);
+  };
+
+ private:
+  int row_group_number_;
+  const OffsetIndex* offset_index_;
+  int page_;
+  int end_page_;
+  bool done_;
+};
+
+// The dictionary of a DictionaryArray is part of its type, so the fields of
+// the columns read as dictionaries only know their type once read
+static std::shared_ptr<Field> FieldOfArray(const std::shared_ptr<Field>& field,
+                                           const std::shared_ptr<Array>& array) {
+  if (array == nullptr || array->type()->Equals(*field->type())) {
+    return field;
+  }
+  return std::make_shared<Field>(field->name(), array->type(), field->nullable());
+}
+
+static std::shared_ptr<Table> TableOfColumns(
+    const std::shared_ptr<::arrow::Schema>& schema,
+    const std::vector<std::shared_ptr<Column>>& columns) {
+  std::vector<std::shared_ptr<Field>> fields;
+  for (const auto& column : columns) {
+    fields.push_back(column->field());
+  }
+  return std::make_shared<Table>(
+      std::make_shared<::arrow::Schema>(fields, schema->metadata()), columns);
+}
+
 // ----------------------------------------------------------------------
 // File reader implementation
 
 class FileReader::Impl {
  public:
   Impl(MemoryPool* pool, std::unique_ptr<ParquetFileReader> reader)
-      : pool_(pool), reader_(std::move(reader)), num_threads_(1) {}
+      : pool_(pool),
+        reader_(std::move(reader)),
+        num_threads_(1),
+        thread_pool_(ThreadPool::Default()),
+        parallel_page_decoding_(false) {}
 
   virtual ~Impl() {}
 
-  Status GetColumn(int i, std::unique_ptr<ColumnReader>* out);
+  // The row_groups arguments restrict reads to the given row groups, all row
+  // groups are read if it is nullptr
+  Status GetColumn(int i, std::unique_ptr<ColumnReader>* out,
+                   const std::vector<int>* row_groups = nullptr);
   Status ReadSchemaField(int i, std::shared_ptr<Array>* out);
   Status ReadSchemaField(int i, const std::vector<int>& indices,
-                         std::shared_ptr<Array>* out);
+                         std::shared_ptr<Array>* out,
+                         const std::vector<int>* row_groups = nullptr);
   Status GetReaderForNode(int index, const NodePtr& node, const std::vector<int>& indices,
-                          int16_t def_level, std::unique_ptr<ColumnReader::Impl>* out);
+                          int16_t def_level, std::unique_ptr<ColumnReader::Impl>* out,
+                          const std::vector<int>* row_groups = nullptr);
   Status ReadColumn(int i, std::shared_ptr<Array>* out);
+  Status ReadNullCount(int i, int64_t* null_count);
   Status GetSchema(std::shared_ptr<::arrow::Schema>* out);
   Status GetSchema(const std::vector<int>& indices,
                    std::shared_ptr<::arrow::Schema>* out);
   Status ReadRowGroup(int row_group_index, const std::vector<int>& indices,
                       std::shared_ptr<::arrow::Table>* out);
-  Status ReadTable(const std::vector<int>& indices, std::shared_ptr<Table>* table);
+  Status ReadTable(const std::vector<int>& indices, std::shared_ptr<Table>* table,
+                   const std::vector<int>* row_groups = nullptr);
   Status ReadTable(std::shared_ptr<Table>* table);
   Status ReadRowGroup(int i, std::shared_ptr<Table>* table);
+  Status ReadTable(const std::vector<int>& indices, const RowGroupPredicate& predicate,
+                   std::shared_ptr<Table>* table);
+  Status ReadRowGroup(int i, const std::vector<int>& indices,
+                      const RowGroupPredicate& predicate, std::shared_ptr<Table>* table);
+  Status ReadRowGroup(int i, const std::vector<int>& indices,
+                      const std::vector<RowRange>& row_ranges,
+                      std::shared_ptr<Table>* table);
+  Status SelectRows(int i, const std::vector<int>& filter_indices,
+                    const RowFilter& filter, int64_t batch_size,
+                    std::vector<RowRange>* out);
+  Status GetRecordBatchReader(const std::vector<int>& row_groups,
+                              const std::vector<int>& indices, int64_t batch_size,
+                              std::shared_ptr<::arrow::RecordBatchReader>* out);
 
   bool CheckForFlatColumn(const ColumnDescriptor* descr);
   bool CheckForFlatListColumn(const ColumnDescriptor* descr);
@@ -214,13 +303,38 @@ class FileReader::Impl {
 
   void set_num_threads(int num_threads) { num_threads_ = num_threads; }
 
+  void set_thread_pool(const std::shared_ptr<ThreadPool>& thread_pool) {
+    thread_pool_ = thread_pool;
+  }
+
+  void set_parallel_page_decoding(bool enabled) { parallel_page_decoding_ = enabled; }
+
+  void set_read_dictionary(int column_index, bool read_dictionary) {
+    if (read_dictionary) {
+      read_dictionary_.insert(column_index);
+    } else {
+      read_dictionary_.erase(column_index);
+    }
+  }
+
   ParquetFileReader* reader() { return reader_.get(); }
 
  private:
   MemoryPool* pool_;
   std::unique_ptr<ParquetFileReader> reader_;
 
+  // Read the column chunks of a row group as groups of pages decoded in
+  // parallel
+  Status ReadRowGroupPages(int row_group_index, const std::vector<int>& indices,
+                           const std::shared_ptr<::arrow::Schema>& schema,
+                           std::shared_ptr<::arrow::Table>* out);
+
   int num_threads_;
+  std::shared_ptr<ThreadPool> thread_pool_;
+  bool parallel_page_decoding_;
+
+  // Leaf columns to read as DictionaryArrays
+  std::unordered_set<int> read_dictionary_;
 };
 
 typedef const int16_t* ValueLevelsPtr;
@@ -234,6 +348,19 @@ class ColumnReader::Impl {
   virtual const std::shared_ptr<Field> field() = 0;
 };
 
+// How a repeated column nests in lists, derived once per column from its
+// Arrow field
+struct ListLevelInfo {
+  // The nullability of each list level, outermost first, then of the values
+  std::vector<bool> nullable;
+  // The definition level at which each list level is empty rather than null
+  std::vector<int16_t> empty_def_level;
+  // The minimal definition level of a slot of the values array
+  int16_t values_def_level;
+
+  int list_depth() const { return static_cast<int>(empty_def_level.size()); }
+};
+
 // Reader implementation for primitive arrays
 class PARQUET_NO_EXPORT PrimitiveImpl : public ColumnReader::Impl {
  public:
@@ -243,7 +370,11 @@ class PARQUET_NO_EXPORT PrimitiveImpl : public ColumnReader::Impl {
         descr_(input_->descr()),
         values_buffer_(pool),
         def_levels_buffer_(pool),
-        rep_levels_buffer_(pool) {
+        rep_levels_buffer_(pool),
+        read_dictionary_(false),
+        row_group_ordinal_(-1),
+        current_range_(0),
+        position_(0) {
     DCHECK(NodeToField(input_->descr()->schema_node(), &field_).ok());
     NextRowGroup();
   }
@@ -252,15 +383,40 @@ class PARQUET_NO_EXPORT PrimitiveImpl : public ColumnReader::Impl {
 
   Status NextBatch(int batch_size, std::shared_ptr<Array>* out) override;
 
+  // Skip the next num_rows rows, across row groups. Only valid for flat
+  // columns, where rows and levels are the same.
+  Status SkipRows(int64_t num_rows);
+
+  // Read top-level BYTE_ARRAY columns as DictionaryArrays of int32 indices
+  void set_read_dictionary(bool read_dictionary) { read_dictionary_ = read_dictionary; }
+
+  // Restrict the following batches to the rows of the sorted, disjoint
+  // ranges, counted from the current position: a batch of n rows then holds
+  // the next n selected rows, the others are skipped. Only valid for flat
+  // columns.
+  void set_row_ranges(const std::vector<RowRange>& row_ranges) {
+    row_ranges_ = row_ranges;
+    current_range_ = 0;
+    position_ = 0;
+  }
+
   template <typename ArrowType, typename ParquetType>
   Status TypedReadBatch(int batch_size, std::shared_ptr<Array>* out);
 
   template <typename ArrowType>
   Status ReadByteArrayBatch(int batch_size, std::shared_ptr<Array>* out);
 
+  template <typename ArrowType>
+  Status ReadDictionaryBatch(int batch_size, std::shared_ptr<Array>* out);
+
   template <typename ArrowType>
   Status ReadFLBABatch(int batch_size, int byte_width, std::shared_ptr<Array>* out);
 
+  // Read INT32, INT64, FIXED_LEN_BYTE_ARRAY or BYTE_ARRAY decimals into a
+  // DecimalArray
+  template <typename ParquetType>
+  Status ReadDecimalBatch(int batch_size, std::shared_ptr<Array>* out);
+
   template <typename ArrowType>
   Status InitDataBuffer(int batch_size);
   Status InitValidBits(int batch_size);
@@ -273,6 +429,7 @@ class PARQUET_NO_EXPORT PrimitiveImpl : public ColumnReader::Impl {
                               int64_t values_to_read, int64_t* levels_read);
   Status WrapIntoListArray(const int16_t* def_levels, const int16_t* rep_levels,
                            int64_t total_values_read, std::shared_ptr<Array>* array);
+  Status InitListLevelInfo();
 
   Status GetDefLevels(ValueLevelsPtr* data, size_t* length) override;
   Status GetRepLevels(ValueLevelsPtr* data, size_t* length) override;
@@ -282,6 +439,14 @@ class PARQUET_NO_EXPORT PrimitiveImpl : public ColumnReader::Impl {
  private:
   void NextRowGroup();
 
+  // Skip the rows up to the next selected one, and set num_rows to the number
+  // of rows, at most max_rows, that follow it before the next skipped one.
+  // Without row ranges, num_rows is max_rows. 0 once past the last range.
+  Status NextSelectedRows(int64_t max_rows, int64_t* num_rows);
+
+  // Account for the rows of a batch read after NextSelectedRows
+  void ConsumeRows(int64_t num_rows) { position_ += num_rows; }
+
   template <typename InType, typename OutType>
   struct can_copy_ptr {
     static constexpr bool value =
@@ -296,6 +461,8 @@ class PARQUET_NO_EXPORT PrimitiveImpl : public ColumnReader::Impl {
 
   std::shared_ptr<::parquet::ColumnReader> column_reader_;
   std::shared_ptr<Field> field_;
+  // Set by WrapIntoListArray on the first batch of a repeated column
+  std::unique_ptr<ListLevelInfo> list_level_info_;
 
   PoolBuffer values_buffer_;
   PoolBuffer def_levels_buffer_;
@@ -306,16 +473,29 @@ class PARQUET_NO_EXPORT PrimitiveImpl : public ColumnReader::Impl {
   uint8_t* valid_bits_ptr_;
   int64_t valid_bits_idx_;
   int64_t null_count_;
+
+  bool read_dictionary_;
+  // Incremented by NextRowGroup
+  int64_t row_group_ordinal_;
+
+  std::vector<RowRange> row_ranges_;
+  size_t current_range_;
+  // Rows read or skipped since set_row_ranges
+  int64_t position_;
 };
 
 // Reader implementation for struct array
+// The children are read in parallel on up to num_threads threads of the pool
 class PARQUET_NO_EXPORT StructImpl : public ColumnReader::Impl {
  public:
   explicit StructImpl(const std::vector<std::shared_ptr<Impl>>& children,
-                      int16_t struct_def_level, MemoryPool* pool, const NodePtr& node)
+                      int16_t struct_def_level, MemoryPool* pool, const NodePtr& node,
+                      ThreadPool* thread_pool = nullptr, int num_threads = 1)
       : children_(children),
         struct_def_level_(struct_def_level),
         pool_(pool),
+        thread_pool_(thread_pool),
+        num_threads_(num_threads),
         def_levels_buffer_(pool) {
     InitField(node, children);
   }
@@ -331,6 +511,8 @@ class PARQUET_NO_EXPORT StructImpl : public ColumnReader::Impl {
   std::vector<std::shared_ptr<Impl>> children_;
   int16_t struct_def_level_;
   MemoryPool* pool_;
+  ThreadPool* thread_pool_;
+  int num_threads_;
   std::shared_ptr<Field> field_;
   PoolBuffer def_levels_buffer_;
 
@@ -339,15 +521,66 @@ class PARQUET_NO_EXPORT StructImpl : public ColumnReader::Impl {
   void InitField(const NodePtr& node, const std::vector<std::shared_ptr<Impl>>& children);
 };
 
+// Reads the columns of a sequence of row groups in lockstep, one batch at a
+// time
+class PARQUET_NO_EXPORT RowGroupRecordBatchReader : public ::arrow::RecordBatchReader {
+ public:
+  RowGroupRecordBatchReader(const std::shared_ptr<::arrow::Schema>& schema,
+                            std::vector<std::unique_ptr<PrimitiveImpl>> column_readers,
+                            int64_t num_rows, int64_t batch_size)
+      : schema_(schema),
+        column_readers_(std::move(column_readers)),
+        rows_remaining_(num_rows),
+        batch_size_(batch_size) {}
+
+  std::shared_ptr<::arrow::Schema> schema() const override { return schema_; }
+
+  Status ReadNext(std::shared_ptr<::arrow::RecordBatch>* out) override {
+    if (rows_remaining_ == 0) {
+      *out = nullptr;
+      return Status::OK();
+    }
+    int64_t num_rows = std::min(batch_size_, rows_remaining_);
+    std::vector<std::shared_ptr<Array>> columns(column_readers_.size());
+    try {
+      for (size_t i = 0; i < column_readers_.size(); ++i) {
+        RETURN_NOT_OK(column_readers_[i]->NextBatch(static_cast<int>(num_rows),
+                                                    &columns[i]));
+        if (columns[i] == nullptr || columns[i]->length() != num_rows) {
+          return Status::IOError("Column chunks hold fewer rows than their row group");
+        }
+      }
+    } catch (const ::parquet::ParquetException& e) {
+      return Status::IOError(e.what());
+    }
+    rows_remaining_ -= num_rows;
+    *out = std::make_shared<::arrow::RecordBatch>(schema_, num_rows, columns);
+    return Status::OK();
+  }
+
+ private:
+  std::shared_ptr<::arrow::Schema> schema_;
+  std::vector<std::unique_ptr<PrimitiveImpl>> column_readers_;
+  int64_t rows_remaining_;
+  int64_t batch_size_;
+};
+
 FileReader::FileReader(MemoryPool* pool, std::unique_ptr<ParquetFileReader> reader)
     : impl_(new FileReader::Impl(pool, std::move(reader))) {}
 
 FileReader::~FileReader() {}
 
-Status FileReader::Impl::GetColumn(int i, std::unique_ptr<ColumnReader>* out) {
-  std::unique_ptr<FileColumnIterator> input(new AllRowGroupsIterator(i, reader_.get()));
+Status FileReader::Impl::GetColumn(int i, std::unique_ptr<ColumnReader>* out,
+                                   const std::vector<int>* row_groups) {
+  std::unique_ptr<FileColumnIterator> input;
+  if (row_groups != nullptr) {
+    input.reset(new RowGroupsIterator(i, *row_groups, reader_.get()));
+  } else {
+    input.reset(new AllRowGroupsIterator(i, reader_.get()));
+  }
 
-  std::unique_ptr<ColumnReader::Impl> impl(new PrimitiveImpl(pool_, std::move(input)));
+  std::unique_ptr<PrimitiveImpl> impl(new PrimitiveImpl(pool_, std::move(input)));
+  impl->set_read_dictionary(read_dictionary_.count(i) > 0);
   *out = std::unique_ptr<ColumnReader>(new ColumnReader(std::move(impl)));
   return Status::OK();
 }
@@ -355,7 +588,8 @@ Status FileReader::Impl::GetColumn(int i, std::unique_ptr<ColumnReader>* out) {
 Status FileReader::Impl::GetReaderForNode(int index, const NodePtr& node,
                                           const std::vector<int>& indices,
                                           int16_t def_level,
-                                          std::unique_ptr<ColumnReader::Impl>* out) {
+                                          std::unique_ptr<ColumnReader::Impl>* out,
+                                          const std::vector<int>* row_groups) {
   *out = nullptr;
 
   if (IsSimpleStruct(node)) {
@@ -367,7 +601,7 @@ Status FileReader::Impl::GetReaderForNode(int index, const NodePtr& node,
       // are supported. This currently just signals the lower level reader resolution
       // to abort
       RETURN_NOT_OK(GetReaderForNode(index, group->field(i), indices, def_level + 1,
-                                     &child_reader));
+                                     &child_reader, row_groups));
       if (child_reader != nullptr) {
         children.push_back(std::move(child_reader));
       }
@@ -375,7 +609,8 @@ Status FileReader::Impl::GetReaderForNode(int index, const NodePtr& node,
 
     if (children.size() > 0) {
       *out = std::unique_ptr<ColumnReader::Impl>(
-          new StructImpl(children, def_level, pool_, node));
+          new StructImpl(children, def_level, pool_, node, thread_pool_.get(),
+                         num_threads_));
     }
   } else {
     // This should be a flat field case - translate the field index to
@@ -395,7 +630,7 @@ Status FileReader::Impl::GetReaderForNode(int index, const NodePtr& node,
     // Otherwise *out keeps the nullptr value.
     if (std::find(indices.begin(), indices.end(), column_index) != indices.end()) {
       std::unique_ptr<ColumnReader> reader;
-      RETURN_NOT_OK(GetColumn(column_index, &reader));
+      RETURN_NOT_OK(GetColumn(column_index, &reader, row_groups));
       *out = std::move(reader->impl_);
     }
   }
@@ -414,13 +649,14 @@ Status FileReader::Impl::ReadSchemaField(int i, std::shared_ptr<Array>* out) {
 }
 
 Status FileReader::Impl::ReadSchemaField(int i, const std::vector<int>& indices,
-                                         std::shared_ptr<Array>* out) {
+                                         std::shared_ptr<Array>* out,
+                                         const std::vector<int>* row_groups) {
   auto parquet_schema = reader_->metadata()->schema();
 
   auto node = parquet_schema->group_node()->field(i);
   std::unique_ptr<ColumnReader::Impl> reader_impl;
 
-  RETURN_NOT_OK(GetReaderForNode(i, node, indices, 1, &reader_impl));
+  RETURN_NOT_OK(GetReaderForNode(i, node, indices, 1, &reader_impl, row_groups));
   if (reader_impl == nullptr) {
     *out = nullptr;
     return Status::OK();
@@ -429,8 +665,14 @@ Status FileReader::Impl::ReadSchemaField(int i, const std::vector<int>& indices,
   std::unique_ptr<ColumnReader> reader(new ColumnReader(std::move(reader_impl)));
 
   int64_t batch_size = 0;
-  for (int j = 0; j < reader_->metadata()->num_row_groups(); j++) {
-    batch_size += reader_->metadata()->RowGroup(j)->ColumnChunk(i)->num_values();
+  if (row_groups != nullptr) {
+    for (int j : *row_groups) {
+      batch_size += reader_->metadata()->RowGroup(j)->ColumnChunk(i)->num_values();
+    }
+  } else {
+    for (int j = 0; j < reader_->metadata()->num_row_groups(); j++) {
+      batch_size += reader_->metadata()->RowGroup(j)->ColumnChunk(i)->num_values();
+    }
   }
 
   return reader->NextBatch(static_cast<int>(batch_size), out);
@@ -448,6 +690,29 @@ Status FileReader::Impl::ReadColumn(int i, std::shared_ptr<Array>* out) {
   return flat_column_reader->NextBatch(static_cast<int>(batch_size), out);
 }
 
+Status FileReader::Impl::ReadNullCount(int i, int64_t* null_count) {
+  constexpr int64_t kLevelsBatchSize = 4096;
+  *null_count = 0;
+  for (int j = 0; j < reader_->metadata()->num_row_groups(); j++) {
+    auto column_metadata = reader_->metadata()->RowGroup(j)->ColumnChunk(i);
+    if (column_metadata->has_null_count()) {
+      *null_count += column_metadata->null_count();
+      continue;
+    }
+    std::shared_ptr<::parquet::ColumnReader> column_reader =
+        reader_->RowGroup(j)->Column(i);
+    column_reader->set_levels_only(true);
+    int64_t levels_read = 0;
+    do {
+      int64_t values_read = 0;
+      levels_read =
+          column_reader->ReadLevelsOnly(kLevelsBatchSize, nullptr, nullptr, &values_read);
+      *null_count += levels_read - values_read;
+    } while (levels_read > 0);
+  }
+  return Status::OK();
+}
+
 Status FileReader::Impl::GetSchema(const std::vector<int>& indices,
                                    std::shared_ptr<::arrow::Schema>* out) {
   auto descr = reader_->metadata()->schema();
@@ -461,6 +726,10 @@ Status FileReader::Impl::ReadRowGroup(int row_group_index,
   std::shared_ptr<::arrow::Schema> schema;
   RETURN_NOT_OK(GetSchema(indices, &schema));
 
+  if (parallel_page_decoding_ && num_threads_ > 1) {
+    return ReadRowGroupPages(row_group_index, indices, schema, out);
+  }
+
   auto rg_metadata = reader_->metadata()->RowGroup(row_group_index);
 
   int num_columns = static_cast<int>(indices.size());
@@ -477,12 +746,13 @@ Status FileReader::Impl::ReadRowGroup(int row_group_index,
     std::unique_ptr<FileColumnIterator> input(
         new SingleRowGroupIterator(column_index, row_group_index, reader_.get()));
 
-    std::unique_ptr<ColumnReader::Impl> impl(new PrimitiveImpl(pool_, std::move(input)));
+    std::unique_ptr<PrimitiveImpl> impl(new PrimitiveImpl(pool_, std::move(input)));
+    impl->set_read_dictionary(read_dictionary_.count(column_index) > 0);
     ColumnReader flat_column_reader(std::move(impl));
 
     std::shared_ptr<Array> array;
     RETURN_NOT_OK(flat_column_reader.NextBatch(static_cast<int>(batch_size), &array));
-    columns[i] = std::make_shared<Column>(schema->field(i), array);
+    columns[i] = std::make_shared<Column>(FieldOfArray(schema->field(i), array), array);
     return Status::OK();
   };
 
@@ -491,15 +761,103 @@ Status FileReader::Impl::ReadRowGroup(int row_group_index,
       RETURN_NOT_OK(ReadColumnFunc(i));
     }
   } else {
-    RETURN_NOT_OK(ParallelFor(nthreads, num_columns, ReadColumnFunc));
+    RETURN_NOT_OK(ParallelFor(thread_pool_.get(), nthreads, num_columns,
+                              ReadColumnFunc));
   }
 
+  *out = TableOfColumns(schema, columns);
+  return Status::OK();
+}
+
+Status FileReader::Impl::ReadRowGroupPages(int row_group_index,
+                                           const std::vector<int>& indices,
+                                           const std::shared_ptr<::arrow::Schema>& schema,
+                                           std::shared_ptr<::arrow::Table>* out) {
+  std::shared_ptr<RowGroupReader> row_group = reader_->RowGroup(row_group_index);
+  int num_columns = static_cast<int>(indices.size());
+
+  // The consecutive pages of a column chunk read by one task. The pages of
+  // the whole chunk are read if first_page is -1.
+  struct PageGroup {
+    int column;
+    int chunk;
+    int first_page;
+    int end_page;
+    int64_t num_rows;
+  };
+  std::vector<PageGroup> groups;
+  std::vector<std::unique_ptr<OffsetIndex>> offset_indexes(num_columns);
+  std::vector<std::vector<std::shared_ptr<Array>>> chunks(num_columns);
+
+  for (int i = 0; i < num_columns; i++) {
+    int column_index = indices[i];
+    int64_t num_rows = row_group->metadata()->ColumnChunk(column_index)->num_values();
+
+    // Locate the pages from the page index, or else from their headers
+    std::unique_ptr<OffsetIndex> offset_index;
+    if (reader_->metadata()->schema()->Column(column_index)->max_repetition_level() ==
+        0) {
+      offset_index = row_group->GetOffsetIndex(column_index);
+      if (offset_index == nullptr) {
+        offset_index = row_group->ScanOffsetIndex(column_index);
+      }
+    }
+    int num_pages = offset_index == nullptr ? 0 : offset_index->num_pages();
+
+    if (num_pages < 2) {
+      groups.push_back({i, 0, -1, -1, num_rows});
+      chunks[i].resize(1);
+      continue;
+    }
+    int num_groups = std::min(num_threads_, num_pages);
+    for (int j = 0; j < num_groups; j++) {
+      int first_page = num_pages * j / num_groups;
+      int end_page = num_pages * (j + 1) / num_groups;
+      int64_t first_row = offset_index->page_location(first_page).first_row_index;
+      int64_t end_row = end_page == num_pages
+                            ? num_rows
+                            : offset_index->page_location(end_page).first_row_index;
+      groups.push_back({i, j, first_page, end_page, end_row - first_row});
+    }
+    chunks[i].resize(num_groups);
+    offset_indexes[i] = std::move(offset_index);
+  }
+
+  auto ReadPagesFunc = [&indices, &groups, &offset_indexes, &chunks, row_group_index,
+                        this](int i) {
+    const PageGroup& group = groups[i];
+    int column_index = indices[group.column];
+    std::unique_ptr<FileColumnIterator> input;
+    if (group.first_page < 0) {
+      input.reset(
+          new SingleRowGroupIterator(column_index, row_group_index, reader_.get()));
+    } else {
+      input.reset(new PageRangeIterator(column_index, row_group_index,
+                                        offset_indexes[group.column].get(),
+                                        group.first_page, group.end_page,
+                                        reader_.get()));
+    }
+    std::unique_ptr<ColumnReader::Impl> impl(new PrimitiveImpl(pool_, std::move(input)));
+    ColumnReader flat_column_reader(std::move(impl));
+    return flat_column_reader.NextBatch(static_cast<int>(group.num_rows),
+                                        &chunks[group.column][group.chunk]);
+  };
+
+  int num_groups = static_cast<int>(groups.size());
+  int nthreads = std::min<int>(num_threads_, num_groups);
+  RETURN_NOT_OK(ParallelFor(thread_pool_.get(), nthreads, num_groups, ReadPagesFunc));
+
+  std::vector<std::shared_ptr<Column>> columns(num_columns);
+  for (int i = 0; i < num_columns; i++) {
+    columns[i] = std::make_shared<Column>(schema->field(i), chunks[i]);
+  }
   *out = std::make_shared<Table>(schema, columns);
   return Status::OK();
 }
 
 Status FileReader::Impl::ReadTable(const std::vector<int>& indices,
-                                   std::shared_ptr<Table>* table) {
+                                   std::shared_ptr<Table>* table,
+                                   const std::vector<int>* row_groups) {
   std::shared_ptr<::arrow::Schema> schema;
   RETURN_NOT_OK(GetSchema(indices, &schema));
 
@@ -512,24 +870,75 @@ Status FileReader::Impl::ReadTable(const std::vector<int>& indices,
   }
 
   std::vector<std::shared_ptr<Column>> columns(field_indices.size());
-  auto ReadColumnFunc = [&indices, &field_indices, &schema, &columns, this](int i) {
+
+  if (row_groups != nullptr && row_groups->empty()) {
+    // Nothing to read, return empty columns
+    for (size_t i = 0; i < field_indices.size(); i++) {
+      std::unique_ptr<::arrow::ArrayBuilder> builder;
+      std::shared_ptr<Array> array;
+      RETURN_NOT_OK(::arrow::MakeBuilder(pool_, schema->field(i)->type(), &builder));
+      RETURN_NOT_OK(builder->Finish(&array));
+      columns[i] = std::make_shared<Column>(schema->field(i), array);
+    }
+    *table = std::make_shared<Table>(schema, columns);
+    return Status::OK();
+  }
+
+  auto ReadColumnFunc = [&indices, &field_indices, &schema, &columns, row_groups,
+                         this](int i) {
     std::shared_ptr<Array> array;
-    RETURN_NOT_OK(ReadSchemaField(field_indices[i], indices, &array));
-    columns[i] = std::make_shared<Column>(schema->field(i), array);
+    RETURN_NOT_OK(ReadSchemaField(field_indices[i], indices, &array, row_groups));
+    columns[i] = std::make_shared<Column>(FieldOfArray(schema->field(i), array), array);
     return Status::OK();
   };
 
   int num_fields = static_cast<int>(field_indices.size());
+  std::vector<int> all_row_groups;
+  if (row_groups == nullptr) {
+    all_row_groups.resize(reader_->metadata()->num_row_groups());
+    std::iota(all_row_groups.begin(), all_row_groups.end(), 0);
+    row_groups = &all_row_groups;
+  }
+  int num_row_groups = static_cast<int>(row_groups->size());
+
+  // The chunks of a column read as a DictionaryArray would not share their
+  // dictionary, and therefore their type
+  if (num_threads_ > num_fields && num_row_groups > 1 && read_dictionary_.empty()) {
+    // Too few fields to keep the threads busy: read every (row group, field)
+    // pair as its own task. Each column then has one chunk per row group.
+    std::vector<std::vector<std::shared_ptr<Array>>> chunks(
+        num_fields, std::vector<std::shared_ptr<Array>>(num_row_groups));
+
+    auto ReadChunkFunc = [&indices, &field_indices, &chunks, row_groups, num_fields,
+                          this](int task) {
+      int i = task % num_fields;
+      int j = task / num_fields;
+      std::vector<int> row_group = {(*row_groups)[j]};
+      return ReadSchemaField(field_indices[i], indices, &chunks[i][j], &row_group);
+    };
+
+    int num_tasks = num_fields * num_row_groups;
+    int nthreads = std::min<int>(num_threads_, num_tasks);
+    RETURN_NOT_OK(ParallelFor(thread_pool_.get(), nthreads, num_tasks, ReadChunkFunc));
+
+    for (int i = 0; i < num_fields; i++) {
+      columns[i] = std::make_shared<Column>(schema->field(i), chunks[i]);
+    }
+    *table = std::make_shared<Table>(schema, columns);
+    return Status::OK();
+  }
+
   int nthreads = std::min<int>(num_threads_, num_fields);
   if (nthreads == 1) {
     for (int i = 0; i < num_fields; i++) {
       RETURN_NOT_OK(ReadColumnFunc(i));
     }
   } else {
-    RETURN_NOT_OK(ParallelFor(nthreads, num_fields, ReadColumnFunc));
+    RETURN_NOT_OK(ParallelFor(thread_pool_.get(), nthreads, num_fields,
+                              ReadColumnFunc));
   }
 
-  *table = std::make_shared<Table>(schema, columns);
+  *table = TableOfColumns(schema, columns);
   return Status::OK();
 }
 
@@ -551,6 +960,182 @@ Status FileReader::Impl::ReadRowGroup(int i, std::shared_ptr<Table>* table) {
   return ReadRowGroup(i, indices, table);
 }
 
+Status FileReader::Impl::ReadTable(const std::vector<int>& indices,
+                                   const RowGroupPredicate& predicate,
+                                   std::shared_ptr<Table>* table) {
+  std::vector<int> row_groups = predicate.SelectRowGroups(*reader_->metadata());
+  return ReadTable(indices, table, &row_groups);
+}
+
+Status FileReader::Impl::ReadRowGroup(int i, const std::vector<int>& indices,
+                                      const RowGroupPredicate& predicate,
+                                      std::shared_ptr<Table>* table) {
+  if (!predicate.MayMatch(*reader_->metadata()->RowGroup(i))) {
+    *table = nullptr;
+    return Status::OK();
+  }
+  return ReadRowGroup(i, indices, table);
+}
+
+Status FileReader::Impl::ReadRowGroup(int row_group_index,
+                                      const std::vector<int>& indices,
+                                      const std::vector<RowRange>& row_ranges,
+                                      std::shared_ptr<Table>* out) {
+  std::shared_ptr<::arrow::Schema> schema;
+  RETURN_NOT_OK(GetSchema(indices, &schema));
+
+  // Validate the ranges, merging the adjacent ones
+  int64_t num_rows = reader_->metadata()->RowGroup(row_group_index)->num_rows();
+  std::vector<RowRange> ranges;
+  int64_t end = 0;
+  int64_t num_selected = 0;
+  for (const RowRange& range : row_ranges) {
+    if (range.offset < end || range.length < 0 ||
+        range.offset + range.length > num_rows) {
+      return Status::Invalid(
+          "Row ranges must be sorted, disjoint and within the row group");
+    }
+    if (range.length == 0) {
+      continue;
+    }
+    if (!ranges.empty() && range.offset == end) {
+      ranges.back().length += range.length;
+    } else {
+      ranges.push_back(range);
+    }
+    end = range.offset + range.length;
+    num_selected += range.length;
+  }
+  if (num_selected > std::numeric_limits<int32_t>::max()) {
+    return Status::Invalid("Too many selected rows for a single batch");
+  }
+
+  int num_columns = static_cast<int>(indices.size());
+  int nthreads = std::min<int>(num_threads_, num_columns);
+  std::vector<std::shared_ptr<Column>> columns(num_columns);
+
+  auto ReadColumnFunc = [&indices, &row_group_index, &schema, &columns, &ranges,
+                         num_selected, this](int i) {
+    int column_index = indices[i];
+    if (reader_->metadata()->schema()->Column(column_index)->max_repetition_level() > 0) {
+      return Status::NotImplemented("Reading row ranges of repeated columns");
+    }
+
+    std::unique_ptr<FileColumnIterator> input(
+        new SingleRowGroupIterator(column_index, row_group_index, reader_.get()));
+    PrimitiveImpl impl(pool_, std::move(input));
+
+    // The selected rows of all the ranges are decoded in a single batch
+    ::arrow::ArrayVector chunks;
+    if (num_selected > 0) {
+      impl.set_row_ranges(ranges);
+      std::shared_ptr<Array> chunk;
+      RETURN_NOT_OK(impl.NextBatch(static_cast<int>(num_selected), &chunk));
+      chunks.push_back(chunk);
+    }
+    columns[i] = std::make_shared<Column>(schema->field(i), chunks);
+    return Status::OK();
+  };
+
+  if (nthreads == 1) {
+    for (int i = 0; i < num_columns; i++) {
+      RETURN_NOT_OK(ReadColumnFunc(i));
+    }
+  } else {
+    RETURN_NOT_OK(ParallelFor(thread_pool_.get(), nthreads, num_columns,
+                              ReadColumnFunc));
+  }
+
+  *out = std::make_shared<Table>(schema, columns);
+  return Status::OK();
+}
+
+Status FileReader::Impl::SelectRows(int row_group_index,
+                                    const std::vector<int>& filter_indices,
+                                    const RowFilter& filter, int64_t batch_size,
+                                    std::vector<RowRange>* out) {
+  if (filter_indices.empty()) {
+    return Status::Invalid("No filter column");
+  }
+  if (batch_size <= 0) {
+    return Status::Invalid("The batch size must be positive");
+  }
+  std::shared_ptr<::arrow::Schema> schema;
+  RETURN_NOT_OK(GetSchema(filter_indices, &schema));
+
+  std::vector<std::unique_ptr<PrimitiveImpl>> readers;
+  for (int column_index : filter_indices) {
+    if (reader_->metadata()->schema()->Column(column_index)->max_repetition_level() > 0) {
+      return Status::NotImplemented("Filtering on repeated columns");
+    }
+    std::unique_ptr<FileColumnIterator> input(
+        new SingleRowGroupIterator(column_index, row_group_index, reader_.get()));
+    readers.emplace_back(new PrimitiveImpl(pool_, std::move(input)));
+  }
+
+  out->clear();
+  int64_t num_rows = reader_->metadata()->RowGroup(row_group_index)->num_rows();
+  for (int64_t batch_start = 0; batch_start < num_rows; batch_start += batch_size) {
+    int64_t length = std::min(batch_size, num_rows - batch_start);
+    std::vector<std::shared_ptr<Column>> columns(readers.size());
+    for (size_t j = 0; j < readers.size(); ++j) {
+      std::shared_ptr<Array> array;
+      RETURN_NOT_OK(readers[j]->NextBatch(static_cast<int>(length), &array));
+      columns[j] = std::make_shared<Column>(schema->field(static_cast<int>(j)), array);
+    }
+
+    std::shared_ptr<::arrow::BooleanArray> selection;
+    RETURN_NOT_OK(filter(Table(schema, columns), &selection));
+    if (selection == nullptr || selection->length() != length) {
+      return Status::Invalid("The row filter must return a value for every row");
+    }
+    for (int64_t row = 0; row < length; ++row) {
+      if (selection->IsNull(row) || !selection->Value(row)) {
+        continue;
+      }
+      int64_t offset = batch_start + row;
+      if (!out->empty() && out->back().offset + out->back().length == offset) {
+        ++out->back().length;
+      } else {
+        out->push_back({offset, 1});
+      }
+    }
+  }
+  return Status::OK();
+}
+
+Status FileReader::Impl::GetRecordBatchReader(
+    const std::vector<int>& row_groups, const std::vector<int>& indices,
+    int64_t batch_size, std::shared_ptr<::arrow::RecordBatchReader>* out) {
+  if (batch_size <= 0) {
+    return Status::Invalid("The batch size must be positive");
+  }
+  std::shared_ptr<::arrow::Schema> schema;
+  RETURN_NOT_OK(GetSchema(indices, &schema));
+
+  int64_t num_rows = 0;
+  for (int row_group : row_groups) {
+    if (row_group < 0 || row_group >= num_row_groups()) {
+      return Status::Invalid("Invalid row group index");
+    }
+    num_rows += reader_->metadata()->RowGroup(row_group)->num_rows();
+  }
+
+  std::vector<std::unique_ptr<PrimitiveImpl>> column_readers;
+  for (int column_index : indices) {
+    if (reader_->metadata()->schema()->Column(column_index)->max_repetition_level() > 0) {
+      return Status::NotImplemented("Record batches of repeated columns");
+    }
+    std::unique_ptr<FileColumnIterator> input(
+        new RowGroupsIterator(column_index, row_groups, reader_.get()));
+    column_readers.emplace_back(new PrimitiveImpl(pool_, std::move(input)));
+  }
+
+  out->reset(new RowGroupRecordBatchReader(schema, std::move(column_readers), num_rows,
+                                           batch_size));
+  return Status::OK();
+}
+
 // Static ctor
 Status OpenFile(const std::shared_ptr<::arrow::io::ReadableFileInterface>& file,
                 MemoryPool* allocator, const ReaderProperties& props,
@@ -582,6 +1167,14 @@ Status FileReader::ReadColumn(int i, std::shared_ptr<Array>* out) {
   }
 }
 
+Status FileReader::ReadNullCount(int i, int64_t* null_count) {
+  try {
+    return impl_->ReadNullCount(i, null_count);
+  } catch (const ::parquet::ParquetException& e) {
+    return ::arrow::Status::IOError(e.what());
+  }
+}
+
 Status FileReader::ReadSchemaField(int i, std::shared_ptr<Array>* out) {
   try {
     return impl_->ReadSchemaField(i, out);
@@ -624,10 +1217,85 @@ Status FileReader::ReadRowGroup(int i, const std::vector<int>& indices,
   }
 }
 
+Status FileReader::ReadTable(const std::vector<int>& indices,
+                             const RowGroupPredicate& predicate,
+                             std::shared_ptr<Table>* out) {
+  try {
+    return impl_->ReadTable(indices, predicate, out);
+  } catch (const ::parquet::ParquetException& e) {
+    return ::arrow::Status::IOError(e.what());
+  }
+}
+
+Status FileReader::ReadRowGroup(int i, const std::vector<int>& indices,
+                                const RowGroupPredicate& predicate,
+                                std::shared_ptr<Table>* out) {
+  try {
+    return impl_->ReadRowGroup(i, indices, predicate, out);
+  } catch (const ::parquet::ParquetException& e) {
+    return ::arrow::Status::IOError(e.what());
+  }
+}
+
+Status FileReader::ReadRowGroup(int i, const std::vector<int>& indices,
+                                const std::vector<RowRange>& row_ranges,
+                                std::shared_ptr<Table>* out) {
+  try {
+    return impl_->ReadRowGroup(i, indices, row_ranges, out);
+  } catch (const ::parquet::ParquetException& e) {
+    return ::arrow::Status::IOError(e.what());
+  }
+}
+
+Status FileReader::SelectRows(int i, const std::vector<int>& filter_indices,
+                              const RowFilter& filter, int64_t batch_size,
+                              std::vector<RowRange>* out) {
+  try {
+    return impl_->SelectRows(i, filter_indices, filter, batch_size, out);
+  } catch (const ::parquet::ParquetException& e) {
+    return ::arrow::Status::IOError(e.what());
+  }
+}
+
+Status FileReader::GetRecordBatchReader(
+    const std::vector<int>& row_groups, const std::vector<int>& indices,
+    int64_t batch_size, std::shared_ptr<::arrow::RecordBatchReader>* out) {
+  try {
+    return impl_->GetRecordBatchReader(row_groups, indices, batch_size, out);
+  } catch (const ::parquet::ParquetException& e) {
+    return ::arrow::Status::IOError(e.what());
+  }
+}
+
+Status FileReader::FilterRowGroup(int i, const std::vector<int>& indices,
+                                  const std::vector<int>& filter_indices,
+                                  const RowFilter& filter, int64_t batch_size,
+                                  std::shared_ptr<Table>* out) {
+  try {
+    std::vector<RowRange> row_ranges;
+    RETURN_NOT_OK(impl_->SelectRows(i, filter_indices, filter, batch_size, &row_ranges));
+    return impl_->ReadRowGroup(i, indices, row_ranges, out);
+  } catch (const ::parquet::ParquetException& e) {
+    return ::arrow::Status::IOError(e.what());
+  }
+}
+
 int FileReader::num_row_groups() const { return impl_->num_row_groups(); }
 
 void FileReader::set_num_threads(int num_threads) { impl_->set_num_threads(num_threads); }
 
+void FileReader::set_thread_pool(const std::shared_ptr<ThreadPool>& thread_pool) {
+  impl_->set_thread_pool(thread_pool);
+}
+
+void FileReader::set_parallel_page_decoding(bool enabled) {
+  impl_->set_parallel_page_decoding(enabled);
+}
+
+void FileReader::set_read_dictionary(int column_index, bool read_dictionary) {
+  impl_->set_read_dictionary(column_index, read_dictionary);
+}
+
 Status FileReader::ScanContents(std::vector<int> columns, const int32_t column_batch_size,
                                 int64_t* num_rows) {
   try {
@@ -642,21 +1310,62 @@ const ParquetFileReader* FileReader::parquet_reader() const {
   return impl_->parquet_reader();
 }
 
+// Read up to batch_size values of a required column, on the REQUIRED path of
+// the reader
+template <typename ParquetType>
+static int64_t ReadRequiredBatch(TypedColumnReader<ParquetType>* reader,
+                                 int64_t batch_size,
+                                 typename ParquetType::c_type* values,
+                                 int64_t* values_read) {
+  int64_t levels_read;
+  int64_t null_count;
+  reader->template ReadBatchSpacedAs<ColumnShape::REQUIRED>(
+      batch_size, nullptr, nullptr, values, nullptr, 0, &levels_read, values_read,
+      &null_count);
+  return levels_read;
+}
+
+// ReadBatchSpaced of a column with definition levels, dispatched once per
+// batch to the path specialized for the shape of the column
+template <typename ParquetType>
+static void ReadOptionalBatch(TypedColumnReader<ParquetType>* reader,
+                              int64_t batch_size, int16_t* def_levels,
+                              int16_t* rep_levels, typename ParquetType::c_type* values,
+                              uint8_t* valid_bits, int64_t valid_bits_offset,
+                              int64_t* levels_read, int64_t* values_read,
+                              int64_t* null_count) {
+  if (reader->shape() == ColumnShape::FLAT_OPTIONAL) {
+    reader->template ReadBatchSpacedAs<ColumnShape::FLAT_OPTIONAL>(
+        batch_size, def_levels, rep_levels, values, valid_bits, valid_bits_offset,
+        levels_read, values_read, null_count);
+  } else {
+    reader->ReadBatchSpaced(batch_size, def_levels, rep_levels, values, valid_bits,
+                            valid_bits_offset, levels_read, values_read, null_count);
+  }
+}
+
 template <typename ArrowType, typename ParquetType>
 Status PrimitiveImpl::ReadNonNullableBatch(TypedColumnReader<ParquetType>* reader,
                                            int64_t values_to_read, int64_t* levels_read) {
   using ArrowCType = typename ArrowType::c_type;
   using ParquetCType = typename ParquetType::c_type;
 
-  RETURN_NOT_OK(values_buffer_.Resize(values_to_read * sizeof(ParquetCType), false));
-  auto values = reinterpret_cast<ParquetCType*>(values_buffer_.mutable_data());
   int64_t values_read;
-  PARQUET_CATCH_NOT_OK(*levels_read =
-                           reader->ReadBatch(static_cast<int>(values_to_read), nullptr,
-                                             nullptr, values, &values_read));
+  if (can_copy_ptr<ParquetCType, ArrowCType>::value) {
+    auto out_ptr = reinterpret_cast<ParquetCType*>(data_buffer_ptr_) + valid_bits_idx_;
+    PARQUET_CATCH_NOT_OK(*levels_read = ReadRequiredBatch(reader, values_to_read, out_ptr,
+                                                         &values_read));
+    valid_bits_idx_ += values_read;
+    return Status::OK();
+  }
 
-  ArrowCType* out_ptr = reinterpret_cast<ArrowCType*>(data_buffer_ptr_);
-  std::copy(values, values + values_read, out_ptr + valid_bits_idx_);
+  // Converted while decoding, without an intermediate buffer
+  ArrowCType* out_ptr = reinterpret_cast<ArrowCType*>(data_buffer_ptr_) + valid_bits_idx_;
+  PARQUET_CATCH_NOT_OK(
+      values_read = reader->ReadBatchConverted(
+          values_to_read, out_ptr,
+          [](const ParquetCType& value) { return static_cast<ArrowCType>(value); }));
+  *levels_read = values_read;
   valid_bits_idx_ += values_read;
 
   return Status::OK();
@@ -669,9 +1378,9 @@ Status PrimitiveImpl::ReadNonNullableBatch(TypedColumnReader<ParquetType>* reade
       int64_t * levels_read) {                                                   \
     int64_t values_read;                                                         \
     CType* out_ptr = reinterpret_cast<CType*>(data_buffer_ptr_);                 \
-    PARQUET_CATCH_NOT_OK(*levels_read = reader->ReadBatch(                       \
-                             static_cast<int>(values_to_read), nullptr, nullptr, \
-                             out_ptr + valid_bits_idx_, &values_read));          \
+    PARQUET_CATCH_NOT_OK(*levels_read = ReadRequiredBatch(                       \
+                             reader, values_to_read, out_ptr + valid_bits_idx_,  \
+                             &values_read));                                     \
                                                                                  \
     valid_bits_idx_ += values_read;                                              \
                                                                                  \
@@ -690,17 +1399,11 @@ NONNULLABLE_BATCH_FAST_PATH(::arrow::Time64Type, Int64Type, int64_t)
 template <>
 Status PrimitiveImpl::ReadNonNullableBatch<::arrow::TimestampType, Int96Type>(
     TypedColumnReader<Int96Type>* reader, int64_t values_to_read, int64_t* levels_read) {
-  RETURN_NOT_OK(values_buffer_.Resize(values_to_read * sizeof(Int96), false));
-  auto values = reinterpret_cast<Int96*>(values_buffer_.mutable_data());
-  int64_t values_read;
-  PARQUET_CATCH_NOT_OK(*levels_read =
-                           reader->ReadBatch(static_cast<int>(values_to_read), nullptr,
-                                             nullptr, values, &values_read));
-
   int64_t* out_ptr = reinterpret_cast<int64_t*>(data_buffer_ptr_) + valid_bits_idx_;
-  for (int64_t i = 0; i < values_read; i++) {
-    *out_ptr++ = impala_timestamp_to_nanoseconds(values[i]);
-  }
+  int64_t values_read;
+  PARQUET_CATCH_NOT_OK(values_read = reader->ReadBatchConverted(
+                           values_to_read, out_ptr, ImpalaTimestampToNanoseconds));
+  *levels_read = values_read;
   valid_bits_idx_ += values_read;
 
   return Status::OK();
@@ -709,17 +1412,11 @@ Status PrimitiveImpl::ReadNonNullableBatch<::arrow::TimestampType, Int96Type>(
 template <>
 Status PrimitiveImpl::ReadNonNullableBatch<::arrow::Date64Type, Int32Type>(
     TypedColumnReader<Int32Type>* reader, int64_t values_to_read, int64_t* levels_read) {
-  RETURN_NOT_OK(values_buffer_.Resize(values_to_read * sizeof(int32_t), false));
-  auto values = reinterpret_cast<int32_t*>(values_buffer_.mutable_data());
-  int64_t values_read;
-  PARQUET_CATCH_NOT_OK(*levels_read =
-                           reader->ReadBatch(static_cast<int>(values_to_read), nullptr,
-                                             nullptr, values, &values_read));
-
   int64_t* out_ptr = reinterpret_cast<int64_t*>(data_buffer_ptr_) + valid_bits_idx_;
-  for (int64_t i = 0; i < values_read; i++) {
-    *out_ptr++ = static_cast<int64_t>(values[i]) * 86400000;
-  }
+  int64_t values_read;
+  PARQUET_CATCH_NOT_OK(values_read = reader->ReadBatchConverted(values_to_read, out_ptr,
+                                                                DayToMilliseconds));
+  *levels_read = values_read;
   valid_bits_idx_ += values_read;
 
   return Status::OK();
@@ -729,19 +1426,12 @@ template <>
 Status PrimitiveImpl::ReadNonNullableBatch<::arrow::BooleanType, BooleanType>(
     TypedColumnReader<BooleanType>* reader, int64_t values_to_read,
     int64_t* levels_read) {
-  RETURN_NOT_OK(values_buffer_.Resize(values_to_read * sizeof(bool), false));
-  auto values = reinterpret_cast<bool*>(values_buffer_.mutable_data());
-  int64_t values_read;
-  PARQUET_CATCH_NOT_OK(*levels_read =
-                           reader->ReadBatch(static_cast<int>(values_to_read), nullptr,
-                                             nullptr, values, &values_read));
-
-  for (int64_t i = 0; i < values_read; i++) {
-    if (values[i]) {
-      ::arrow::BitUtil::SetBit(data_buffer_ptr_, valid_bits_idx_);
-    }
-    valid_bits_idx_++;
-  }
+  // The values are copied bit for bit into the Arrow bitmap
+  int64_t null_count;
+  PARQUET_CATCH_NOT_OK(*levels_read = reader->ReadBatchBitmap(
+                           values_to_read, data_buffer_ptr_, valid_bits_idx_, nullptr, 0,
+                           &null_count));
+  valid_bits_idx_ += *levels_read;
 
   return Status::OK();
 }
@@ -754,22 +1444,29 @@ Status PrimitiveImpl::ReadNullableBatch(TypedColumnReader<ParquetType>* reader,
   using ArrowCType = typename ArrowType::c_type;
   using ParquetCType = typename ParquetType::c_type;
 
-  RETURN_NOT_OK(values_buffer_.Resize(values_to_read * sizeof(ParquetCType), false));
-  auto values = reinterpret_cast<ParquetCType*>(values_buffer_.mutable_data());
   int64_t null_count;
-  PARQUET_CATCH_NOT_OK(reader->ReadBatchSpaced(
-      static_cast<int>(values_to_read), def_levels, rep_levels, values, valid_bits_ptr_,
-      valid_bits_idx_, levels_read, values_read, &null_count));
+  if (can_copy_ptr<ParquetCType, ArrowCType>::value) {
+    // The values are decoded at their final position and the validity bitmap
+    // is filled in the same pass
+    auto out_ptr = reinterpret_cast<ParquetCType*>(data_buffer_ptr_) + valid_bits_idx_;
+    PARQUET_CATCH_NOT_OK(ReadOptionalBatch(
+        reader, values_to_read, def_levels, rep_levels, out_ptr,
+        valid_bits_ptr_, valid_bits_idx_, levels_read, values_read, &null_count));
+    null_count_ += null_count;
+    valid_bits_idx_ += *values_read;
+    return Status::OK();
+  }
 
-  auto data_ptr = reinterpret_cast<ArrowCType*>(data_buffer_ptr_);
-  INIT_BITSET(valid_bits_ptr_, static_cast<int>(valid_bits_idx_));
+  RETURN_NOT_OK(ResizePadded(&values_buffer_, values_to_read * sizeof(ParquetCType)));
+  auto values = reinterpret_cast<ParquetCType*>(values_buffer_.mutable_data());
+  PARQUET_CATCH_NOT_OK(ReadOptionalBatch(
+      reader, values_to_read, def_levels, rep_levels, values, valid_bits_ptr_,
+      valid_bits_idx_, levels_read, values_read, &null_count));
 
-  for (int64_t i = 0; i < *values_read; i++) {
-    if (bitset_valid_bits_ptr_ & (1 << bit_offset_valid_bits_ptr_)) {
-      data_ptr[valid_bits_idx_ + i] = values[i];
-    }
-    READ_NEXT_BITSET(valid_bits_ptr_);
-  }
+  // The slots of the nulls are converted as well, which is cheaper than
+  // testing the validity bitmap for each value. Their contents do not matter.
+  auto data_ptr = reinterpret_cast<ArrowCType*>(data_buffer_ptr_) + valid_bits_idx_;
+  ConvertInts(values, *values_read, data_ptr);
   null_count_ += null_count;
   valid_bits_idx_ += *values_read;
 
@@ -784,8 +1481,8 @@ Status PrimitiveImpl::ReadNullableBatch(TypedColumnReader<ParquetType>* reader,
       int64_t * values_read) {                                                     \
     auto data_ptr = reinterpret_cast<CType*>(data_buffer_ptr_);                    \
     int64_t null_count;                                                            \
-    PARQUET_CATCH_NOT_OK(reader->ReadBatchSpaced(                                  \
-        static_cast<int>(values_to_read), def_levels, rep_levels,                  \
+    PARQUET_CATCH_NOT_OK(ReadOptionalBatch(                                        \
+        reader, values_to_read, def_levels, rep_levels,                            \
         data_ptr + valid_bits_idx_, valid_bits_ptr_, valid_bits_idx_, levels_read, \
         values_read, &null_count));                                                \
                                                                                    \
@@ -808,21 +1505,16 @@ template <>
 Status PrimitiveImpl::ReadNullableBatch<::arrow::TimestampType, Int96Type>(
     TypedColumnReader<Int96Type>* reader, int16_t* def_levels, int16_t* rep_levels,
     int64_t values_to_read, int64_t* levels_read, int64_t* values_read) {
-  RETURN_NOT_OK(values_buffer_.Resize(values_to_read * sizeof(Int96), false));
+  RETURN_NOT_OK(ResizePadded(&values_buffer_, values_to_read * sizeof(Int96)));
   auto values = reinterpret_cast<Int96*>(values_buffer_.mutable_data());
   int64_t null_count;
-  PARQUET_CATCH_NOT_OK(reader->ReadBatchSpaced(
-      static_cast<int>(values_to_read), def_levels, rep_levels, values, valid_bits_ptr_,
+  PARQUET_CATCH_NOT_OK(ReadOptionalBatch(
+      reader, values_to_read, def_levels, rep_levels, values, valid_bits_ptr_,
       valid_bits_idx_, levels_read, values_read, &null_count));
 
-  auto data_ptr = reinterpret_cast<int64_t*>(data_buffer_ptr_);
-  INIT_BITSET(valid_bits_ptr_, static_cast<int>(valid_bits_idx_));
-  for (int64_t i = 0; i < *values_read; i++) {
-    if (bitset_valid_bits_ptr_ & (1 << bit_offset_valid_bits_ptr_)) {
-      data_ptr[valid_bits_idx_ + i] = impala_timestamp_to_nanoseconds(values[i]);
-    }
-    READ_NEXT_BITSET(valid_bits_ptr_);
-  }
+  // Convert the null slots too instead of testing each validity bit
+  auto data_ptr = reinterpret_cast<int64_t*>(data_buffer_ptr_) + valid_bits_idx_;
+  ImpalaTimestampsToNanoseconds(values, *values_read, data_ptr);
   null_count_ += null_count;
   valid_bits_idx_ += *values_read;
 
@@ -833,21 +1525,16 @@ template <>
 Status PrimitiveImpl::ReadNullableBatch<::arrow::Date64Type, Int32Type>(
     TypedColumnReader<Int32Type>* reader, int16_t* def_levels, int16_t* rep_levels,
     int64_t values_to_read, int64_t* levels_read, int64_t* values_read) {
-  RETURN_NOT_OK(values_buffer_.Resize(values_to_read * sizeof(int32_t), false));
+  RETURN_NOT_OK(ResizePadded(&values_buffer_, values_to_read * sizeof(int32_t)));
   auto values = reinterpret_cast<int32_t*>(values_buffer_.mutable_data());
   int64_t null_count;
-  PARQUET_CATCH_NOT_OK(reader->ReadBatchSpaced(
-      static_cast<int>(values_to_read), def_levels, rep_levels, values, valid_bits_ptr_,
+  PARQUET_CATCH_NOT_OK(ReadOptionalBatch(
+      reader, values_to_read, def_levels, rep_levels, values, valid_bits_ptr_,
       valid_bits_idx_, levels_read, values_read, &null_count));
 
-  auto data_ptr = reinterpret_cast<int64_t*>(data_buffer_ptr_);
-  INIT_BITSET(valid_bits_ptr_, static_cast<int>(valid_bits_idx_));
-  for (int64_t i = 0; i < *values_read; i++) {
-    if (bitset_valid_bits_ptr_ & (1 << bit_offset_valid_bits_ptr_)) {
-      data_ptr[valid_bits_idx_ + i] = static_cast<int64_t>(values[i]) * 86400000;
-    }
-    READ_NEXT_BITSET(valid_bits_ptr_);
-  }
+  // Convert the null slots too instead of testing each validity bit
+  auto data_ptr = reinterpret_cast<int64_t*>(data_buffer_ptr_) + valid_bits_idx_;
+  DaysToMilliseconds(values, *values_read, data_ptr);
   null_count_ += null_count;
   valid_bits_idx_ += *values_read;
 
@@ -858,11 +1545,25 @@ template <>
 Status PrimitiveImpl::ReadNullableBatch<::arrow::BooleanType, BooleanType>(
     TypedColumnReader<BooleanType>* reader, int16_t* def_levels, int16_t* rep_levels,
     int64_t values_to_read, int64_t* levels_read, int64_t* values_read) {
-  RETURN_NOT_OK(values_buffer_.Resize(values_to_read * sizeof(bool), false));
-  auto values = reinterpret_cast<bool*>(values_buffer_.mutable_data());
   int64_t null_count;
-  PARQUET_CATCH_NOT_OK(reader->ReadBatchSpaced(
-      static_cast<int>(values_to_read), def_levels, rep_levels, values, valid_bits_ptr_,
+  if (descr_->max_definition_level() == 1 && descr_->max_repetition_level() == 0 &&
+      descr_->schema_node()->parent() == input_->schema()->group_node()) {
+    // Top-level flat column: the definition levels and the values are decoded
+    // straight into the two bitmaps. Neither WrapIntoListArray nor a parent
+    // StructImpl needs the levels.
+    PARQUET_CATCH_NOT_OK(*values_read = reader->ReadBatchBitmap(
+                             values_to_read, data_buffer_ptr_, valid_bits_idx_,
+                             valid_bits_ptr_, valid_bits_idx_, &null_count));
+    *levels_read = *values_read;
+    valid_bits_idx_ += *values_read;
+    null_count_ += null_count;
+    return Status::OK();
+  }
+
+  RETURN_NOT_OK(ResizePadded(&values_buffer_, values_to_read * sizeof(bool)));
+  auto values = reinterpret_cast<bool*>(values_buffer_.mutable_data());
+  PARQUET_CATCH_NOT_OK(ReadOptionalBatch(
+      reader, values_to_read, def_levels, rep_levels, values, valid_bits_ptr_,
       valid_bits_idx_, levels_read, values_read, &null_count));
 
   INIT_BITSET(valid_bits_ptr_, static_cast<int>(valid_bits_idx_));
@@ -884,7 +1585,7 @@ template <typename ArrowType>
 Status PrimitiveImpl::InitDataBuffer(int batch_size) {
   using ArrowCType = typename ArrowType::c_type;
   data_buffer_ = std::make_shared<PoolBuffer>(pool_);
-  RETURN_NOT_OK(data_buffer_->Resize(batch_size * sizeof(ArrowCType), false));
+  RETURN_NOT_OK(ResizePadded(data_buffer_.get(), batch_size * sizeof(ArrowCType)));
   data_buffer_ptr_ = data_buffer_->mutable_data();
 
   return Status::OK();
@@ -893,7 +1594,8 @@ Status PrimitiveImpl::InitDataBuffer(int batch_size) {
 template <>
 Status PrimitiveImpl::InitDataBuffer<::arrow::BooleanType>(int batch_size) {
   data_buffer_ = std::make_shared<PoolBuffer>(pool_);
-  RETURN_NOT_OK(data_buffer_->Resize(::arrow::BitUtil::CeilByte(batch_size) / 8, false));
+  RETURN_NOT_OK(
+      ResizePadded(data_buffer_.get(), ::arrow::BitUtil::CeilByte(batch_size) / 8));
   data_buffer_ptr_ = data_buffer_->mutable_data();
   memset(data_buffer_ptr_, 0, data_buffer_->size());
 
@@ -906,7 +1608,7 @@ Status PrimitiveImpl::InitValidBits(int batch_size) {
     int valid_bits_size =
         static_cast<int>(::arrow::BitUtil::CeilByte(batch_size + 1)) / 8;
     valid_bits_buffer_ = std::make_shared<PoolBuffer>(pool_);
-    RETURN_NOT_OK(valid_bits_buffer_->Resize(valid_bits_size, false));
+    RETURN_NOT_OK(ResizePadded(valid_bits_buffer_.get(), valid_bits_size));
     valid_bits_ptr_ = valid_bits_buffer_->mutable_data();
     memset(valid_bits_ptr_, 0, valid_bits_size);
     null_count_ = 0;
@@ -914,154 +1616,202 @@ Status PrimitiveImpl::InitValidBits(int batch_size) {
   return Status::OK();
 }
 
-Status PrimitiveImpl::WrapIntoListArray(const int16_t* def_levels,
-                                        const int16_t* rep_levels,
-                                        int64_t total_levels_read,
-                                        std::shared_ptr<Array>* array) {
+Status PrimitiveImpl::InitListLevelInfo() {
   std::shared_ptr<::arrow::Schema> arrow_schema;
   RETURN_NOT_OK(FromParquetSchema(input_->schema(), {input_->column_index()},
                                   input_->metadata()->key_value_metadata(),
                                   &arrow_schema));
   std::shared_ptr<Field> current_field = arrow_schema->field(0);
 
-  if (descr_->max_repetition_level() > 0) {
-    // Walk downwards to extract nullability
-    std::vector<bool> nullable;
-    std::vector<std::shared_ptr<::arrow::Int32Builder>> offset_builders;
-    std::vector<std::shared_ptr<::arrow::BooleanBuilder>> valid_bits_builders;
-    nullable.push_back(current_field->nullable());
-    while (current_field->type()->num_children() > 0) {
-      if (current_field->type()->num_children() > 1) {
-        return Status::NotImplemented(
-            "Fields with more than one child are not supported.");
-      } else {
-        if (current_field->type()->id() != ::arrow::Type::LIST) {
-          return Status::NotImplemented(
-              "Currently only nesting with Lists is supported.");
-        }
-        current_field = current_field->type()->child(0);
-      }
-      offset_builders.emplace_back(
-          std::make_shared<::arrow::Int32Builder>(::arrow::int32(), pool_));
-      valid_bits_builders.emplace_back(
-          std::make_shared<::arrow::BooleanBuilder>(::arrow::boolean(), pool_));
-      nullable.push_back(current_field->nullable());
-    }
-
-    int64_t list_depth = offset_builders.size();
-    // This describes the minimal definition that describes a level that
-    // reflects a value in the primitive values array.
-    int16_t values_def_level = descr_->max_definition_level();
-    if (nullable[nullable.size() - 1]) {
-      values_def_level--;
-    }
-
-    // The definition levels that are needed so that a list is declared
-    // as empty and not null.
-    std::vector<int16_t> empty_def_level(list_depth);
-    int def_level = 0;
-    for (int i = 0; i < list_depth; i++) {
-      if (nullable[i]) {
-        def_level++;
+  std::unique_ptr<ListLevelInfo> info(new ListLevelInfo());
+  // Walk downwards to extract nullability
+  info->nullable.push_back(current_field->nullable());
+  while (current_field->type()->num_children() > 0) {
+    if (current_field->type()->num_children() > 1) {
+      return Status::NotImplemented("Fields with more than one child are not supported.");
+    } else {
+      if (current_field->type()->id() != ::arrow::Type::LIST) {
+        return Status::NotImplemented("Currently only nesting with Lists is supported.");
       }
-      empty_def_level[i] = def_level;
+      current_field = current_field->type()->child(0);
+    }
+    info->nullable.push_back(current_field->nullable());
+  }
+  const int list_depth = static_cast<int>(info->nullable.size()) - 1;
+
+  // This describes the minimal definition that describes a level that
+  // reflects a value in the primitive values array.
+  info->values_def_level = descr_->max_definition_level();
+  if (info->nullable[list_depth]) {
+    info->values_def_level--;
+  }
+
+  // The definition levels that are needed so that a list is declared
+  // as empty and not null.
+  int16_t def_level = 0;
+  for (int i = 0; i < list_depth; i++) {
+    if (info->nullable[i]) {
       def_level++;
     }
+    info->empty_def_level.push_back(def_level);
+    def_level++;
+  }
+  list_level_info_ = std::move(info);
+  return Status::OK();
+}
 
-    int32_t values_offset = 0;
-    std::vector<int64_t> null_counts(list_depth, 0);
-    for (int64_t i = 0; i < total_levels_read; i++) {
-      int16_t rep_level = rep_levels[i];
-      if (rep_level < descr_->max_repetition_level()) {
-        for (int64_t j = rep_level; j < list_depth; j++) {
-          if (j == (list_depth - 1)) {
-            RETURN_NOT_OK(offset_builders[j]->Append(values_offset));
-          } else {
-            RETURN_NOT_OK(offset_builders[j]->Append(
-                static_cast<int32_t>(offset_builders[j + 1]->length())));
-          }
-
-          if (((empty_def_level[j] - 1) == def_levels[i]) && (nullable[j])) {
-            RETURN_NOT_OK(valid_bits_builders[j]->Append(false));
-            null_counts[j]++;
-            break;
-          } else {
-            RETURN_NOT_OK(valid_bits_builders[j]->Append(true));
-            if (empty_def_level[j] == def_levels[i]) {
-              break;
-            }
-          }
-        }
+// Rebuild the offsets and validity bitmaps of the nested lists of a column
+// from num_levels repetition and definition levels, without builders. For
+// each list level j, offsets[j] needs room for num_levels + 1 offsets and
+// valid_bits[j] for num_levels zeroed bits; lengths[j] and null_counts[j]
+// receive the number of lists and of null lists.
+static void LevelsToListOffsets(const ListLevelInfo& info, int16_t max_repetition_level,
+                                const int16_t* def_levels, const int16_t* rep_levels,
+                                int64_t num_levels, int32_t* const* offsets,
+                                uint8_t* const* valid_bits, int64_t* lengths,
+                                int64_t* null_counts) {
+  const int list_depth = info.list_depth();
+  const int last = list_depth - 1;
+  int32_t values_offset = 0;
+  for (int64_t i = 0; i < num_levels; i++) {
+    const int16_t def_level = def_levels[i];
+    const int16_t rep_level = rep_levels[i];
+    // A repetition level below the maximum starts a new list at that depth
+    // and at every deeper one, down to the first that is empty or null
+    for (int j = rep_level; rep_level < max_repetition_level && j < list_depth; j++) {
+      const int64_t k = lengths[j]++;
+      offsets[j][k] = j == last ? values_offset : static_cast<int32_t>(lengths[j + 1]);
+      if (info.nullable[j] && def_level == info.empty_def_level[j] - 1) {
+        null_counts[j]++;
+        break;
       }
-      if (def_levels[i] >= values_def_level) {
-        values_offset++;
-      }
-    }
-    // Add the final offset to all lists
-    for (int64_t j = 0; j < list_depth; j++) {
-      if (j == (list_depth - 1)) {
-        RETURN_NOT_OK(offset_builders[j]->Append(values_offset));
-      } else {
-        RETURN_NOT_OK(offset_builders[j]->Append(
-            static_cast<int32_t>(offset_builders[j + 1]->length())));
+      ::arrow::BitUtil::SetBit(valid_bits[j], k);
+      if (def_level == info.empty_def_level[j]) {
+        break;
       }
     }
+    values_offset += def_level >= info.values_def_level;
+  }
+  // Add the final offset to all lists
+  for (int j = 0; j < list_depth; j++) {
+    offsets[j][lengths[j]] =
+        j == last ? values_offset : static_cast<int32_t>(lengths[j + 1]);
+  }
+}
 
-    std::vector<std::shared_ptr<Buffer>> offsets;
-    std::vector<std::shared_ptr<Buffer>> valid_bits;
-    std::vector<int64_t> list_lengths;
-    for (int64_t j = 0; j < list_depth; j++) {
-      list_lengths.push_back(offset_builders[j]->length() - 1);
-      std::shared_ptr<Array> array;
-      RETURN_NOT_OK(offset_builders[j]->Finish(&array));
-      offsets.emplace_back(std::static_pointer_cast<Int32Array>(array)->values());
-      RETURN_NOT_OK(valid_bits_builders[j]->Finish(&array));
-      valid_bits.emplace_back(std::static_pointer_cast<BooleanArray>(array)->values());
-    }
-
-    std::shared_ptr<Array> output(*array);
-    for (int64_t j = list_depth - 1; j >= 0; j--) {
-      auto list_type = std::make_shared<::arrow::ListType>(
-          std::make_shared<Field>("item", output->type(), nullable[j + 1]));
-      output = std::make_shared<::arrow::ListArray>(
-          list_type, list_lengths[j], offsets[j], output, valid_bits[j], null_counts[j]);
-    }
-    *array = output;
+Status PrimitiveImpl::WrapIntoListArray(const int16_t* def_levels,
+                                        const int16_t* rep_levels,
+                                        int64_t total_levels_read,
+                                        std::shared_ptr<Array>* array) {
+  if (descr_->max_repetition_level() == 0) {
+    return Status::OK();
+  }
+  if (!list_level_info_) {
+    RETURN_NOT_OK(InitListLevelInfo());
+  }
+  const ListLevelInfo& info = *list_level_info_;
+  const int list_depth = info.list_depth();
+
+  std::vector<std::shared_ptr<PoolBuffer>> offsets(list_depth);
+  std::vector<std::shared_ptr<PoolBuffer>> valid_bits(list_depth);
+  std::vector<int32_t*> offsets_data(list_depth);
+  std::vector<uint8_t*> valid_bits_data(list_depth);
+  for (int j = 0; j < list_depth; j++) {
+    offsets[j] = std::make_shared<PoolBuffer>(pool_);
+    RETURN_NOT_OK(offsets[j]->Resize((total_levels_read + 1) * sizeof(int32_t), false));
+    offsets_data[j] = reinterpret_cast<int32_t*>(offsets[j]->mutable_data());
+    valid_bits[j] = std::make_shared<PoolBuffer>(pool_);
+    RETURN_NOT_OK(valid_bits[j]->Resize(
+        ::arrow::BitUtil::BytesForBits(total_levels_read), false));
+    valid_bits_data[j] = valid_bits[j]->mutable_data();
+    memset(valid_bits_data[j], 0, valid_bits[j]->size());
+  }
+  std::vector<int64_t> list_lengths(list_depth, 0);
+  std::vector<int64_t> null_counts(list_depth, 0);
+  LevelsToListOffsets(info, descr_->max_repetition_level(), def_levels, rep_levels,
+                      total_levels_read, offsets_data.data(), valid_bits_data.data(),
+                      list_lengths.data(), null_counts.data());
+
+  std::shared_ptr<Array> output(*array);
+  for (int j = list_depth - 1; j >= 0; j--) {
+    auto list_type = std::make_shared<::arrow::ListType>(
+        std::make_shared<Field>("item", output->type(), info.nullable[j + 1]));
+    output = std::make_shared<::arrow::ListArray>(
+        list_type, list_lengths[j], offsets[j], output, valid_bits[j], null_counts[j]);
   }
+  *array = output;
   return Status::OK();
 }
 
 template <typename ArrowType, typename ParquetType>
 Status PrimitiveImpl::TypedReadBatch(int batch_size, std::shared_ptr<Array>* out) {
   using ArrowCType = typename ArrowType::c_type;
+  using ParquetCType = typename ParquetType::c_type;
 
   int values_to_read = batch_size;
   int total_levels_read = 0;
-  RETURN_NOT_OK(InitDataBuffer<ArrowType>(batch_size));
   RETURN_NOT_OK(InitValidBits(batch_size));
+
+  if (can_copy_ptr<ParquetCType, ArrowCType>::value &&
+      descr_->max_definition_level() == 0 && descr_->max_repetition_level() == 0 &&
+      row_ranges_.empty() && column_reader_) {
+    // Reference the values in the current page directly if it holds the
+    // entire batch, e.g. for uncompressed pages of a memory-mapped file
+    auto reader = static_cast<TypedColumnReader<ParquetType>*>(column_reader_.get());
+    std::shared_ptr<Buffer> values;
+    int64_t values_read = 0;
+    bool zero_copy;
+    PARQUET_CATCH_NOT_OK(zero_copy =
+                             reader->ReadBatchZeroCopy(batch_size, &values, &values_read));
+    if (zero_copy) {
+      if (!column_reader_->HasNext()) {
+        NextRowGroup();
+      }
+      if (values_read == batch_size || !column_reader_) {
+        *out = std::make_shared<ArrayType<ArrowType>>(field_->type(), values_read,
+                                                      values);
+        return Status::OK();
+      }
+      // The batch spans several pages: fall back to copying
+      RETURN_NOT_OK(InitDataBuffer<ArrowType>(batch_size));
+      memcpy(data_buffer_ptr_, values->data(), values->size());
+      valid_bits_idx_ = values_read;
+      values_to_read -= static_cast<int>(values_read);
+    }
+  }
+  if (!data_buffer_) {
+    RETURN_NOT_OK(InitDataBuffer<ArrowType>(batch_size));
+  }
   if (descr_->max_definition_level() > 0) {
-    RETURN_NOT_OK(def_levels_buffer_.Resize(batch_size * sizeof(int16_t), false));
+    RETURN_NOT_OK(ResizePadded(&def_levels_buffer_, batch_size * sizeof(int16_t)));
   }
   if (descr_->max_repetition_level() > 0) {
-    RETURN_NOT_OK(rep_levels_buffer_.Resize(batch_size * sizeof(int16_t), false));
+    RETURN_NOT_OK(ResizePadded(&rep_levels_buffer_, batch_size * sizeof(int16_t)));
   }
   int16_t* def_levels = reinterpret_cast<int16_t*>(def_levels_buffer_.mutable_data());
   int16_t* rep_levels = reinterpret_cast<int16_t*>(rep_levels_buffer_.mutable_data());
 
   while ((values_to_read > 0) && column_reader_) {
+    int64_t rows_to_read;
+    RETURN_NOT_OK(NextSelectedRows(values_to_read, &rows_to_read));
+    if (rows_to_read == 0 || !column_reader_) {
+      break;
+    }
     auto reader = dynamic_cast<TypedColumnReader<ParquetType>*>(column_reader_.get());
     int64_t values_read;
     int64_t levels_read;
     if (descr_->max_definition_level() == 0) {
-      RETURN_NOT_OK((ReadNonNullableBatch<ArrowType, ParquetType>(reader, values_to_read,
+      RETURN_NOT_OK((ReadNonNullableBatch<ArrowType, ParquetType>(reader, rows_to_read,
                                                                   &values_read)));
+      ConsumeRows(values_read);
     } else {
       // As per the defintion and checks for flat (list) columns:
       // descr_->max_definition_level() > 0, <= 3
       RETURN_NOT_OK((ReadNullableBatch<ArrowType, ParquetType>(
           reader, def_levels + total_levels_read, rep_levels + total_levels_read,
-          values_to_read, &levels_read, &values_read)));
+          rows_to_read, &levels_read, &values_read)));
       total_levels_read += static_cast<int>(levels_read);
+      ConsumeRows(levels_read);
     }
     values_to_read -= static_cast<int>(values_read);
     if (!column_reader_->HasNext()) {
@@ -1099,29 +1849,36 @@ Status PrimitiveImpl::TypedReadBatch<::arrow::BooleanType, BooleanType>(
   RETURN_NOT_OK(InitDataBuffer<::arrow::BooleanType>(batch_size));
   RETURN_NOT_OK(InitValidBits(batch_size));
   if (descr_->max_definition_level() > 0) {
-    RETURN_NOT_OK(def_levels_buffer_.Resize(batch_size * sizeof(int16_t), false));
+    RETURN_NOT_OK(ResizePadded(&def_levels_buffer_, batch_size * sizeof(int16_t)));
   }
   if (descr_->max_repetition_level() > 0) {
-    RETURN_NOT_OK(rep_levels_buffer_.Resize(batch_size * sizeof(int16_t), false));
+    RETURN_NOT_OK(ResizePadded(&rep_levels_buffer_, batch_size * sizeof(int16_t)));
   }
   int16_t* def_levels = reinterpret_cast<int16_t*>(def_levels_buffer_.mutable_data());
   int16_t* rep_levels = reinterpret_cast<int16_t*>(rep_levels_buffer_.mutable_data());
 
   while ((values_to_read > 0) && column_reader_) {
+    int64_t rows_to_read;
+    RETURN_NOT_OK(NextSelectedRows(values_to_read, &rows_to_read));
+    if (rows_to_read == 0 || !column_reader_) {
+      break;
+    }
     auto reader = dynamic_cast<TypedColumnReader<BooleanType>*>(column_reader_.get());
     int64_t values_read;
     int64_t levels_read;
     int16_t* def_levels = reinterpret_cast<int16_t*>(def_levels_buffer_.mutable_data());
     if (descr_->max_definition_level() == 0) {
       RETURN_NOT_OK((ReadNonNullableBatch<::arrow::BooleanType, BooleanType>(
-          reader, values_to_read, &values_read)));
+          reader, rows_to_read, &values_read)));
+      ConsumeRows(values_read);
     } else {
       // As per the defintion and checks for flat columns:
       // descr_->max_definition_level() == 1
       RETURN_NOT_OK((ReadNullableBatch<::arrow::BooleanType, BooleanType>(
           reader, def_levels + total_levels_read, rep_levels + total_levels_read,
-          values_to_read, &levels_read, &values_read)));
+          rows_to_read, &levels_read, &values_read)));
       total_levels_read += static_cast<int>(levels_read);
+      ConsumeRows(levels_read);
     }
     values_to_read -= static_cast<int>(values_read);
     if (!column_reader_->HasNext()) {
@@ -1163,50 +1920,207 @@ Status PrimitiveImpl::TypedReadBatch<::arrow::BooleanType, BooleanType>(
   return WrapIntoListArray(def_levels, rep_levels, total_levels_read, out);
 }
 
+// Merges the dictionaries of several column chunks, and the values of the
+// pages that are not dictionary-encoded, into one Arrow dictionary
+template <typename ArrowType>
+class ByteArrayDictionaryMemo {
+ public:
+  explicit ByteArrayDictionaryMemo(MemoryPool* pool) : builder_(pool) {}
+
+  Status GetOrInsert(const ByteArray& value, int32_t* index) {
+    key_.assign(reinterpret_cast<const char*>(value.ptr), value.len);
+    auto it = indices_.find(key_);
+    if (it != indices_.end()) {
+      *index = it->second;
+      return Status::OK();
+    }
+    *index = static_cast<int32_t>(indices_.size());
+    indices_.emplace(key_, *index);
+    return builder_.Append(reinterpret_cast<const char*>(value.ptr), value.len);
+  }
+
+  Status Finish(std::shared_ptr<Array>* dictionary) {
+    return builder_.Finish(dictionary);
+  }
+
+ private:
+  typename ::arrow::TypeTraits<ArrowType>::BuilderType builder_;
+  std::unordered_map<std::string, int32_t> indices_;
+  // Reused to look up the values without allocating
+  std::string key_;
+};
+
+template <typename ArrowType>
+Status PrimitiveImpl::ReadDictionaryBatch(int batch_size, std::shared_ptr<Array>* out) {
+  if (descr_->max_definition_level() > 0) {
+    RETURN_NOT_OK(ResizePadded(&def_levels_buffer_, batch_size * sizeof(int16_t)));
+  }
+  int16_t* def_levels = reinterpret_cast<int16_t*>(def_levels_buffer_.mutable_data());
+  RETURN_NOT_OK(ResizePadded(&values_buffer_, batch_size * sizeof(ByteArray)));
+  auto values = reinterpret_cast<ByteArray*>(values_buffer_.mutable_data());
+  std::vector<int32_t> indices(batch_size);
+
+  ByteArrayDictionaryMemo<ArrowType> memo(pool_);
+  ::arrow::Int32Builder indices_builder(pool_);
+  // Positions in the merged dictionary of the dictionary of the current
+  // column chunk
+  std::vector<int32_t> dictionary_positions;
+  // The row group whose dictionary was merged last. The readers cannot be
+  // told apart by address, the next one may be allocated where the previous
+  // one was.
+  int64_t merged_row_group = -1;
+
+  int16_t max_def_level = descr_->max_definition_level();
+  bool nullable_elements = descr_->schema_node()->is_optional();
+  int values_to_read = batch_size;
+  while ((values_to_read > 0) && column_reader_) {
+    int64_t rows_to_read;
+    RETURN_NOT_OK(NextSelectedRows(values_to_read, &rows_to_read));
+    if (rows_to_read == 0 || !column_reader_) {
+      break;
+    }
+    auto reader = static_cast<TypedColumnReader<ByteArrayType>*>(column_reader_.get());
+    int64_t values_read;
+    int64_t levels_read;
+    PARQUET_CATCH_NOT_OK(levels_read = reader->ReadBatchIndices(
+                             rows_to_read, def_levels, nullptr, indices.data(),
+                             &values_read));
+    if (levels_read >= 0) {
+      if (merged_row_group != row_group_ordinal_) {
+        int dictionary_length;
+        const ByteArray* dictionary = reader->dictionary(&dictionary_length);
+        dictionary_positions.resize(dictionary_length);
+        for (int i = 0; i < dictionary_length; i++) {
+          RETURN_NOT_OK(memo.GetOrInsert(dictionary[i], &dictionary_positions[i]));
+        }
+        merged_row_group = row_group_ordinal_;
+      }
+      for (int64_t i = 0; i < values_read; i++) {
+        if (static_cast<size_t>(indices[i]) >= dictionary_positions.size()) {
+          return Status::IOError("Dictionary index out of range");
+        }
+        indices[i] = dictionary_positions[indices[i]];
+      }
+    } else {
+      // The writer fell back to another encoding for this page
+      PARQUET_CATCH_NOT_OK(levels_read = reader->ReadBatch(rows_to_read, def_levels,
+                                                           nullptr, values,
+                                                           &values_read));
+      for (int64_t i = 0; i < values_read; i++) {
+        RETURN_NOT_OK(memo.GetOrInsert(values[i], &indices[i]));
+      }
+    }
+    values_to_read -= static_cast<int>(levels_read);
+    ConsumeRows(levels_read);
+
+    if (max_def_level == 0) {
+      RETURN_NOT_OK(indices_builder.Append(indices.data(), values_read));
+    } else {
+      int values_idx = 0;
+      for (int64_t i = 0; i < levels_read; i++) {
+        if (def_levels[i] == max_def_level) {
+          RETURN_NOT_OK(indices_builder.Append(indices[values_idx++]));
+        } else if (nullable_elements && def_levels[i] == max_def_level - 1) {
+          RETURN_NOT_OK(indices_builder.AppendNull());
+        }
+      }
+    }
+    if (!column_reader_->HasNext()) {
+      NextRowGroup();
+    }
+  }
+
+  std::shared_ptr<Array> dictionary;
+  std::shared_ptr<Array> dictionary_indices;
+  RETURN_NOT_OK(memo.Finish(&dictionary));
+  RETURN_NOT_OK(indices_builder.Finish(&dictionary_indices));
+  auto type = std::make_shared<::arrow::DictionaryType>(::arrow::int32(), dictionary);
+  *out = std::make_shared<::arrow::DictionaryArray>(type, dictionary_indices);
+  return Status::OK();
+}
+
 template <typename ArrowType>
 Status PrimitiveImpl::ReadByteArrayBatch(int batch_size, std::shared_ptr<Array>* out) {
-  using BuilderType = typename ::arrow::TypeTraits<ArrowType>::BuilderType;
+  if (read_dictionary_ && descr_->max_repetition_level() == 0 &&
+      descr_->schema_node()->parent() == input_->schema()->group_node()) {
+    return ReadDictionaryBatch<ArrowType>(batch_size, out);
+  }
 
   int total_levels_read = 0;
   if (descr_->max_definition_level() > 0) {
-    RETURN_NOT_OK(def_levels_buffer_.Resize(batch_size * sizeof(int16_t), false));
+    RETURN_NOT_OK(ResizePadded(&def_levels_buffer_, batch_size * sizeof(int16_t)));
   }
   if (descr_->max_repetition_level() > 0) {
-    RETURN_NOT_OK(rep_levels_buffer_.Resize(batch_size * sizeof(int16_t), false));
+    RETURN_NOT_OK(ResizePadded(&rep_levels_buffer_, batch_size * sizeof(int16_t)));
   }
   int16_t* def_levels = reinterpret_cast<int16_t*>(def_levels_buffer_.mutable_data());
   int16_t* rep_levels = reinterpret_cast<int16_t*>(rep_levels_buffer_.mutable_data());
 
+  // The offsets and the bytes of the values are written straight into the
+  // buffers of the array, the latter being grown once per page by the total
+  // length of its values
+  RETURN_NOT_OK(InitValidBits(batch_size));
+  auto offsets_buffer = std::make_shared<PoolBuffer>(pool_);
+  RETURN_NOT_OK(offsets_buffer->Resize((batch_size + 1) * sizeof(int32_t), false));
+  auto offsets = reinterpret_cast<int32_t*>(offsets_buffer->mutable_data());
+  auto data_buffer = std::make_shared<PoolBuffer>(pool_);
+  offsets[0] = 0;
+  int64_t length = 0;
+  int64_t data_size = 0;
+
+  int16_t max_def_level = descr_->max_definition_level();
+  bool nullable_elements = descr_->schema_node()->is_optional();
   int values_to_read = batch_size;
-  BuilderType builder(pool_);
   while ((values_to_read > 0) && column_reader_) {
-    RETURN_NOT_OK(values_buffer_.Resize(values_to_read * sizeof(ByteArray), false));
-    auto reader = dynamic_cast<TypedColumnReader<ByteArrayType>*>(column_reader_.get());
+    int64_t rows_to_read;
+    RETURN_NOT_OK(NextSelectedRows(values_to_read, &rows_to_read));
+    if (rows_to_read == 0 || !column_reader_) {
+      break;
+    }
+    RETURN_NOT_OK(ResizePadded(&values_buffer_, rows_to_read * sizeof(ByteArray)));
+    auto reader = static_cast<TypedColumnReader<ByteArrayType>*>(column_reader_.get());
     int64_t values_read;
     int64_t levels_read;
     auto values = reinterpret_cast<ByteArray*>(values_buffer_.mutable_data());
     PARQUET_CATCH_NOT_OK(levels_read = reader->ReadBatch(
-                             values_to_read, def_levels + total_levels_read,
+                             rows_to_read, def_levels + total_levels_read,
                              rep_levels + total_levels_read, values, &values_read));
     values_to_read -= static_cast<int>(levels_read);
-    if (descr_->max_definition_level() == 0) {
-      for (int64_t i = 0; i < levels_read; i++) {
-        RETURN_NOT_OK(
-            builder.Append(reinterpret_cast<const char*>(values[i].ptr), values[i].len));
+    ConsumeRows(levels_read);
+
+    int64_t values_size = 0;
+    for (int64_t i = 0; i < values_read; i++) {
+      values_size += values[i].len;
+    }
+    if (data_size + values_size > std::numeric_limits<int32_t>::max()) {
+      return Status::Invalid("BinaryArray cannot hold more than 2^31 - 1 bytes");
+    }
+    if (data_size + values_size > data_buffer->capacity()) {
+      RETURN_NOT_OK(data_buffer->Reserve(
+          std::max(2 * data_buffer->capacity(), data_size + values_size)));
+    }
+    uint8_t* data = data_buffer->mutable_data();
+
+    if (max_def_level == 0) {
+      for (int64_t i = 0; i < values_read; i++) {
+        memcpy(data + data_size, values[i].ptr, values[i].len);
+        data_size += values[i].len;
+        offsets[++length] = static_cast<int32_t>(data_size);
       }
     } else {
-      // descr_->max_definition_level() > 0
       int values_idx = 0;
-      int nullable_elements = descr_->schema_node()->is_optional();
+      const int16_t* batch_def_levels = def_levels + total_levels_read;
       for (int64_t i = 0; i < levels_read; i++) {
-        if (nullable_elements &&
-            (def_levels[i + total_levels_read] == (descr_->max_definition_level() - 1))) {
-          RETURN_NOT_OK(builder.AppendNull());
-        } else if (def_levels[i + total_levels_read] == descr_->max_definition_level()) {
-          RETURN_NOT_OK(
-              builder.Append(reinterpret_cast<const char*>(values[values_idx].ptr),
-                             values[values_idx].len));
-          values_idx++;
+        if (batch_def_levels[i] == max_def_level) {
+          const ByteArray& value = values[values_idx++];
+          memcpy(data + data_size, value.ptr, value.len);
+          data_size += value.len;
+          ::arrow::BitUtil::SetBit(valid_bits_ptr_, length);
+          offsets[++length] = static_cast<int32_t>(data_size);
+        } else if (nullable_elements && batch_def_levels[i] == max_def_level - 1) {
+          null_count_++;
+          offsets[length + 1] = offsets[length];
+          length++;
         }
       }
       total_levels_read += static_cast<int>(levels_read);
@@ -1216,7 +2130,18 @@ Status PrimitiveImpl::ReadByteArrayBatch(int batch_size, std::shared_ptr<Array>*
     }
   }
 
-  RETURN_NOT_OK(builder.Finish(out));
+  RETURN_NOT_OK(data_buffer->Resize(data_size, false));
+  RETURN_NOT_OK(offsets_buffer->Resize((length + 1) * sizeof(int32_t), false));
+  if (max_def_level > 0) {
+    RETURN_NOT_OK(
+        valid_bits_buffer_->Resize(::arrow::BitUtil::CeilByte(length) / 8, false));
+    *out = std::make_shared<ArrayType<ArrowType>>(length, offsets_buffer, data_buffer,
+                                                  valid_bits_buffer_, null_count_);
+    // Relase the ownership as the Buffer is now part of a new Array
+    valid_bits_buffer_.reset();
+  } else {
+    *out = std::make_shared<ArrayType<ArrowType>>(length, offsets_buffer, data_buffer);
+  }
   // Check if we should transform this array into an list array.
   return WrapIntoListArray(def_levels, rep_levels, total_levels_read, out);
 }
@@ -1227,10 +2152,10 @@ Status PrimitiveImpl::ReadFLBABatch(int batch_size, int byte_width,
   using BuilderType = typename ::arrow::TypeTraits<ArrowType>::BuilderType;
   int total_levels_read = 0;
   if (descr_->max_definition_level() > 0) {
-    RETURN_NOT_OK(def_levels_buffer_.Resize(batch_size * sizeof(int16_t), false));
+    RETURN_NOT_OK(ResizePadded(&def_levels_buffer_, batch_size * sizeof(int16_t)));
   }
   if (descr_->max_repetition_level() > 0) {
-    RETURN_NOT_OK(rep_levels_buffer_.Resize(batch_size * sizeof(int16_t), false));
+    RETURN_NOT_OK(ResizePadded(&rep_levels_buffer_, batch_size * sizeof(int16_t)));
   }
   int16_t* def_levels = reinterpret_cast<int16_t*>(def_levels_buffer_.mutable_data());
   int16_t* rep_levels = reinterpret_cast<int16_t*>(rep_levels_buffer_.mutable_data());
@@ -1238,15 +2163,21 @@ Status PrimitiveImpl::ReadFLBABatch(int batch_size, int byte_width,
   int values_to_read = batch_size;
   BuilderType builder(::arrow::fixed_size_binary(byte_width), pool_);
   while ((values_to_read > 0) && column_reader_) {
-    RETURN_NOT_OK(values_buffer_.Resize(values_to_read * sizeof(FLBA), false));
+    int64_t rows_to_read;
+    RETURN_NOT_OK(NextSelectedRows(values_to_read, &rows_to_read));
+    if (rows_to_read == 0 || !column_reader_) {
+      break;
+    }
+    RETURN_NOT_OK(ResizePadded(&values_buffer_, rows_to_read * sizeof(FLBA)));
     auto reader = dynamic_cast<TypedColumnReader<FLBAType>*>(column_reader_.get());
     int64_t values_read;
     int64_t levels_read;
     auto values = reinterpret_cast<FLBA*>(values_buffer_.mutable_data());
     PARQUET_CATCH_NOT_OK(levels_read = reader->ReadBatch(
-                             values_to_read, def_levels + total_levels_read,
+                             rows_to_read, def_levels + total_levels_read,
                              rep_levels + total_levels_read, values, &values_read));
     values_to_read -= static_cast<int>(levels_read);
+    ConsumeRows(levels_read);
     if (descr_->max_definition_level() == 0) {
       for (int64_t i = 0; i < levels_read; i++) {
         RETURN_NOT_OK(builder.Append(values[i].ptr));
@@ -1275,6 +2206,116 @@ Status PrimitiveImpl::ReadFLBABatch(int batch_size, int byte_width,
   return WrapIntoListArray(def_levels, rep_levels, total_levels_read, out);
 }
 
+// Convert the spaced values of the physical type to decimals. The values of
+// the null slots are only read for INT32 and INT64, which converts them
+// without testing each validity bit.
+static Status ToDecimals(const int32_t* values, int64_t length, const ColumnDescriptor*,
+                         const uint8_t*, int64_t, uint8_t* out) {
+  IntsToDecimals(values, length, out);
+  return Status::OK();
+}
+
+static Status ToDecimals(const int64_t* values, int64_t length, const ColumnDescriptor*,
+                         const uint8_t*, int64_t, uint8_t* out) {
+  IntsToDecimals(values, length, out);
+  return Status::OK();
+}
+
+static Status ToDecimals(const FLBA* values, int64_t length,
+                         const ColumnDescriptor* descr, const uint8_t* valid_bits,
+                         int64_t valid_bits_offset, uint8_t* out) {
+  FLBAsToDecimals(values, length, descr->type_length(), valid_bits, valid_bits_offset,
+                  out);
+  return Status::OK();
+}
+
+static Status ToDecimals(const ByteArray* values, int64_t length,
+                         const ColumnDescriptor*, const uint8_t* valid_bits,
+                         int64_t valid_bits_offset, uint8_t* out) {
+  if (!ByteArraysToDecimals(values, length, valid_bits, valid_bits_offset, out)) {
+    return Status::Invalid("Decimals wider than 16 bytes are not supported");
+  }
+  return Status::OK();
+}
+
+template <typename ParquetType>
+Status PrimitiveImpl::ReadDecimalBatch(int batch_size, std::shared_ptr<Array>* out) {
+  using ParquetCType = typename ParquetType::c_type;
+
+  if (descr_->physical_type() == ::parquet::Type::FIXED_LEN_BYTE_ARRAY &&
+      descr_->type_length() > kDecimalByteWidth) {
+    return Status::NotImplemented("Decimals wider than 16 bytes are not supported");
+  }
+  int values_to_read = batch_size;
+  int total_levels_read = 0;
+  RETURN_NOT_OK(InitValidBits(batch_size));
+  data_buffer_ = std::make_shared<PoolBuffer>(pool_);
+  RETURN_NOT_OK(ResizePadded(data_buffer_.get(), batch_size * kDecimalByteWidth));
+  data_buffer_ptr_ = data_buffer_->mutable_data();
+  if (descr_->max_definition_level() > 0) {
+    RETURN_NOT_OK(ResizePadded(&def_levels_buffer_, batch_size * sizeof(int16_t)));
+  }
+  if (descr_->max_repetition_level() > 0) {
+    RETURN_NOT_OK(ResizePadded(&rep_levels_buffer_, batch_size * sizeof(int16_t)));
+  }
+  int16_t* def_levels = reinterpret_cast<int16_t*>(def_levels_buffer_.mutable_data());
+  int16_t* rep_levels = reinterpret_cast<int16_t*>(rep_levels_buffer_.mutable_data());
+
+  // The values are decoded spaced into values_buffer_, then converted in bulk
+  while ((values_to_read > 0) && column_reader_) {
+    int64_t rows_to_read;
+    RETURN_NOT_OK(NextSelectedRows(values_to_read, &rows_to_read));
+    if (rows_to_read == 0 || !column_reader_) {
+      break;
+    }
+    RETURN_NOT_OK(ResizePadded(&values_buffer_, rows_to_read * sizeof(ParquetCType)));
+    auto reader = static_cast<TypedColumnReader<ParquetType>*>(column_reader_.get());
+    auto values = reinterpret_cast<ParquetCType*>(values_buffer_.mutable_data());
+    int64_t values_read;
+    if (descr_->max_definition_level() == 0) {
+      PARQUET_CATCH_NOT_OK(
+          ReadRequiredBatch(reader, rows_to_read, values, &values_read));
+      RETURN_NOT_OK(ToDecimals(values, values_read, descr_, nullptr, 0,
+                               data_buffer_ptr_ + valid_bits_idx_ * kDecimalByteWidth));
+      ConsumeRows(values_read);
+    } else {
+      int64_t levels_read;
+      int64_t null_count;
+      PARQUET_CATCH_NOT_OK(ReadOptionalBatch(
+          reader, rows_to_read, def_levels + total_levels_read,
+          rep_levels + total_levels_read, values, valid_bits_ptr_, valid_bits_idx_,
+          &levels_read, &values_read, &null_count));
+      RETURN_NOT_OK(ToDecimals(values, values_read, descr_, valid_bits_ptr_,
+                               valid_bits_idx_,
+                               data_buffer_ptr_ + valid_bits_idx_ * kDecimalByteWidth));
+      null_count_ += null_count;
+      total_levels_read += static_cast<int>(levels_read);
+      ConsumeRows(levels_read);
+    }
+    valid_bits_idx_ += values_read;
+    values_to_read -= static_cast<int>(values_read);
+    if (!column_reader_->HasNext()) {
+      NextRowGroup();
+    }
+  }
+
+  RETURN_NOT_OK(data_buffer_->Resize(valid_bits_idx_ * kDecimalByteWidth));
+  if (descr_->max_definition_level() > 0) {
+    *out = std::make_shared<::arrow::DecimalArray>(
+        field_->type(), valid_bits_idx_, data_buffer_, valid_bits_buffer_, null_count_);
+    // Relase the ownership as the Buffer is now part of a new Array
+    valid_bits_buffer_.reset();
+  } else {
+    *out = std::make_shared<::arrow::DecimalArray>(field_->type(), valid_bits_idx_,
+                                                   data_buffer_);
+  }
+  // Relase the ownership as the Buffer is now part of a new Array
+  data_buffer_.reset();
+
+  // Check if we should transform this array into an list array.
+  return WrapIntoListArray(def_levels, rep_levels, total_levels_read, out);
+}
+
 template <>
 Status PrimitiveImpl::TypedReadBatch<::arrow::BinaryType, ByteArrayType>(
     int batch_size, std::shared_ptr<Array>* out) {
@@ -1325,6 +2366,23 @@ Status PrimitiveImpl::NextBatch(int batch_size, std::shared_ptr<Array>* out) {
       return ReadFLBABatch<::arrow::FixedSizeBinaryType>(batch_size, byte_width, out);
       break;
     }
+    case ::arrow::Type::DECIMAL:
+      switch (descr_->physical_type()) {
+        case ::parquet::Type::INT32:
+          return ReadDecimalBatch<Int32Type>(batch_size, out);
+        case ::parquet::Type::INT64:
+          return ReadDecimalBatch<Int64Type>(batch_size, out);
+        case ::parquet::Type::FIXED_LEN_BYTE_ARRAY:
+          return ReadDecimalBatch<FLBAType>(batch_size, out);
+        case ::parquet::Type::BYTE_ARRAY:
+          return ReadDecimalBatch<ByteArrayType>(batch_size, out);
+        default:
+          std::stringstream ss;
+          ss << "Cannot read decimals of type "
+             << TypeToString(descr_->physical_type());
+          return Status::NotImplemented(ss.str());
+      }
+      break;
     case ::arrow::Type::TIMESTAMP: {
       ::arrow::TimestampType* timestamp_type =
           static_cast<::arrow::TimestampType*>(field_->type().get());
@@ -1352,7 +2410,69 @@ Status PrimitiveImpl::NextBatch(int batch_size, std::shared_ptr<Array>* out) {
   }
 }
 
-void PrimitiveImpl::NextRowGroup() { column_reader_ = input_->Next(); }
+void PrimitiveImpl::NextRowGroup() {
+  column_reader_ = input_->Next();
+  ++row_group_ordinal_;
+}
+
+Status PrimitiveImpl::NextSelectedRows(int64_t max_rows, int64_t* num_rows) {
+  if (row_ranges_.empty()) {
+    *num_rows = max_rows;
+    return Status::OK();
+  }
+  while (current_range_ < row_ranges_.size() &&
+         position_ >= row_ranges_[current_range_].offset +
+                          row_ranges_[current_range_].length) {
+    ++current_range_;
+  }
+  if (current_range_ == row_ranges_.size()) {
+    *num_rows = 0;
+    return Status::OK();
+  }
+  const RowRange& range = row_ranges_[current_range_];
+  if (position_ < range.offset) {
+    RETURN_NOT_OK(SkipRows(range.offset - position_));
+    position_ = range.offset;
+  }
+  *num_rows = std::min(max_rows, range.offset + range.length - position_);
+  return Status::OK();
+}
+
+template <typename ParquetType>
+static int64_t SkipValues(::parquet::ColumnReader* reader, int64_t num_values) {
+  return static_cast<TypedColumnReader<ParquetType>*>(reader)->Skip(num_values);
+}
+
+#define SKIP_VALUES_CASE(ENUM, ParquetType)                                          \
+  case ::parquet::Type::ENUM:                                                        \
+    PARQUET_CATCH_NOT_OK(skipped =                                                   \
+                             SkipValues<ParquetType>(column_reader_.get(), num_rows)); \
+    break;
+
+Status PrimitiveImpl::SkipRows(int64_t num_rows) {
+  while (num_rows > 0 && column_reader_) {
+    int64_t skipped = 0;
+    switch (descr_->physical_type()) {
+      SKIP_VALUES_CASE(BOOLEAN, BooleanType)
+      SKIP_VALUES_CASE(INT32, Int32Type)
+      SKIP_VALUES_CASE(INT64, Int64Type)
+      SKIP_VALUES_CASE(INT96, Int96Type)
+      SKIP_VALUES_CASE(FLOAT, FloatType)
+      SKIP_VALUES_CASE(DOUBLE, DoubleType)
+      SKIP_VALUES_CASE(BYTE_ARRAY, ByteArrayType)
+      SKIP_VALUES_CASE(FIXED_LEN_BYTE_ARRAY, FLBAType)
+      default:
+        return Status::NotImplemented("Unknown physical type");
+    }
+    num_rows -= skipped;
+    if (!column_reader_->HasNext()) {
+      NextRowGroup();
+    }
+  }
+  return Status::OK();
+}
+
+#undef SKIP_VALUES_CASE
 
 Status PrimitiveImpl::GetDefLevels(ValueLevelsPtr* data, size_t* length) {
   *data = reinterpret_cast<ValueLevelsPtr>(def_levels_buffer_.data());
@@ -1410,34 +2530,31 @@ Status StructImpl::GetDefLevels(ValueLevelsPtr* data, size_t* length) {
     return Status::OK();
   }
 
-  // We have at least one child
+  // When a struct is defined, all of its children def levels are at least at
+  // nesting level, and def level equals nesting level.
+  // When a struct is not defined, all of its children def levels are equal,
+  // less than the nesting level, and the def level equals them.
+  // The levels of the first child are therefore enough.
   ValueLevelsPtr child_def_levels;
   size_t child_length;
   RETURN_NOT_OK(children_[0]->GetDefLevels(&child_def_levels, &child_length));
-  auto size = child_length * sizeof(int16_t);
-  RETURN_NOT_OK(def_levels_buffer_.Resize(size));
-  // Initialize with the minimal def level
-  std::memset(def_levels_buffer_.mutable_data(), -1, size);
+  RETURN_NOT_OK(ResizePadded(&def_levels_buffer_, child_length * sizeof(int16_t)));
   auto result_levels = reinterpret_cast<int16_t*>(def_levels_buffer_.mutable_data());
+  for (size_t i = 0; i < child_length; i++) {
+    result_levels[i] = std::min(child_def_levels[i], struct_def_level_);
+  }
 
-  // When a struct is defined, all of its children def levels are at least at
-  // nesting level, and def level equals nesting level.
-  // When a struct is not defined, all of its children def levels are less than
-  // the nesting level, and the def level equals max(children def levels)
-  // All other possibilities are malformed definition data.
-  for (auto& child : children_) {
+#ifndef NDEBUG
+  // All other possibilities are malformed definition data
+  for (size_t j = 1; j < children_.size(); j++) {
     size_t current_child_length;
-    RETURN_NOT_OK(child->GetDefLevels(&child_def_levels, &current_child_length));
+    RETURN_NOT_OK(children_[j]->GetDefLevels(&child_def_levels, &current_child_length));
     DCHECK_EQ(child_length, current_child_length);
     for (size_t i = 0; i < child_length; i++) {
-      // Check that value is either uninitialized, or current
-      // and previous children def levels agree on the struct level
-      DCHECK((result_levels[i] == -1) || ((result_levels[i] >= struct_def_level_) ==
-                                          (child_def_levels[i] >= struct_def_level_)));
-      result_levels[i] =
-          std::max(result_levels[i], std::min(child_def_levels[i], struct_def_level_));
+      DCHECK_EQ(result_levels[i], std::min(child_def_levels[i], struct_def_level_));
     }
   }
+#endif
   *data = reinterpret_cast<ValueLevelsPtr>(def_levels_buffer_.data());
   *length = child_length;
   return Status::OK();
@@ -1464,12 +2581,18 @@ Status StructImpl::NextBatch(int batch_size, std::shared_ptr<Array>* out) {
   int64_t null_count;
 
   // Gather children arrays and def levels
-  for (auto& child : children_) {
-    std::shared_ptr<Array> child_array;
-
-    RETURN_NOT_OK(child->NextBatch(batch_size, &child_array));
-
-    children_arrays.push_back(child_array);
+  int num_children = static_cast<int>(children_.size());
+  children_arrays.resize(num_children);
+  auto ReadChildFunc = [batch_size, &children_arrays, this](int i) {
+    return children_[i]->NextBatch(batch_size, &children_arrays[i]);
+  };
+  int nthreads = std::min(num_threads_, num_children);
+  if (thread_pool_ == nullptr || nthreads <= 1) {
+    for (int i = 0; i < num_children; i++) {
+      RETURN_NOT_OK(ReadChildFunc(i));
+    }
+  } else {
+    RETURN_NOT_OK(ParallelFor(thread_pool_, nthreads, num_children, ReadChildFunc));
   }
 
   RETURN_NOT_OK(DefLevelsToNullArray(&null_bitmap, &null_count));
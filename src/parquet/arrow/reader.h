@@ -18,6 +18,7 @@
 #ifndef PARQUET_ARROW_READER_H
 #define PARQUET_ARROW_READER_H
 
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -29,7 +30,9 @@
 namespace arrow {
 
 class Array;
+class BooleanArray;
 class MemoryPool;
+class RecordBatchReader;
 class RowBatch;
 class Status;
 class Table;
@@ -37,10 +40,19 @@ class Table;
 
 namespace parquet {
 
+class ThreadPool;
+
 namespace arrow {
 
 class ColumnReader;
 
+// Decides which rows of a batch of the filter columns to keep. The batch holds
+// the filter columns in the order they were requested; out must be set to an
+// array of the batch's length, where null entries count as false.
+typedef std::function<::arrow::Status(const ::arrow::Table& batch,
+                                      std::shared_ptr<::arrow::BooleanArray>* out)>
+    RowFilter;
+
 // Arrow read adapter class for deserializing Parquet files as Arrow row
 // batches.
 //
@@ -133,6 +145,13 @@ class PARQUET_EXPORT FileReader {
   ::arrow::Status ReadSchemaField(int i, const std::vector<int>& indices,
                                   std::shared_ptr<::arrow::Array>* out);
 
+  // Count the levels of the i-th leaf column that are not values, i.e. its
+  // nulls if it is flat, without building its array. The count of a column
+  // chunk is taken from its statistics when they hold it. Otherwise only the
+  // levels of the chunk are read; its values are not decoded, and the values
+  // of DATA_PAGE_V2 pages are not decompressed.
+  ::arrow::Status ReadNullCount(int i, int64_t* null_count);
+
   // Read a table of columns into a Table
   ::arrow::Status ReadTable(std::shared_ptr<::arrow::Table>* out);
 
@@ -146,6 +165,54 @@ class PARQUET_EXPORT FileReader {
 
   ::arrow::Status ReadRowGroup(int i, std::shared_ptr<::arrow::Table>* out);
 
+  // Read the indicated columns of only the row groups which, according to
+  // their column chunk statistics, may hold rows matching the predicate.
+  // Surviving rows are not filtered any further.
+  ::arrow::Status ReadTable(const std::vector<int>& column_indices,
+                            const RowGroupPredicate& predicate,
+                            std::shared_ptr<::arrow::Table>* out);
+
+  // Read the row group, unless the predicate rules it out using its column
+  // chunk statistics, in which case out is set to nullptr
+  ::arrow::Status ReadRowGroup(int i, const std::vector<int>& column_indices,
+                               const RowGroupPredicate& predicate,
+                               std::shared_ptr<::arrow::Table>* out);
+
+  // Read only the given rows of the indicated columns of the row group. The
+  // ranges must be sorted and disjoint; the selected rows of each column are
+  // read into a single chunk. The rows in between are skipped, dropping whole
+  // data pages without decompressing them where possible. Only flat columns
+  // are supported.
+  ::arrow::Status ReadRowGroup(int i, const std::vector<int>& column_indices,
+                               const std::vector<RowRange>& row_ranges,
+                               std::shared_ptr<::arrow::Table>* out);
+
+  // Evaluate the filter on batches of at most batch_size rows of the filter
+  // columns of the row group, and return the selected rows as sorted,
+  // disjoint ranges. Only flat columns are supported.
+  ::arrow::Status SelectRows(int i, const std::vector<int>& filter_column_indices,
+                             const RowFilter& filter, int64_t batch_size,
+                             std::vector<RowRange>* out);
+
+  // Two-phase read: select the rows of the row group with SelectRows, then
+  // read the indicated columns for the selected rows only (see ReadRowGroup
+  // with row ranges). Filter columns that are also projected are read again
+  // for the selected rows.
+  ::arrow::Status FilterRowGroup(int i, const std::vector<int>& column_indices,
+                                 const std::vector<int>& filter_column_indices,
+                                 const RowFilter& filter, int64_t batch_size,
+                                 std::shared_ptr<::arrow::Table>* out);
+
+  // Return a reader yielding record batches of batch_size rows (the last one
+  // may be shorter) of the indicated columns of the row groups, in order. The
+  // columns are decoded incrementally, so that only the pages being decoded
+  // are held in memory. Only flat columns are supported. The returned reader
+  // must not outlive this FileReader.
+  ::arrow::Status GetRecordBatchReader(const std::vector<int>& row_groups,
+                                       const std::vector<int>& column_indices,
+                                       int64_t batch_size,
+                                       std::shared_ptr<::arrow::RecordBatchReader>* out);
+
   /// \brief Scan file contents with one thread, return number of rows
   ::arrow::Status ScanContents(std::vector<int> columns, const int32_t column_batch_size,
                                int64_t* num_rows);
@@ -155,9 +222,34 @@ class PARQUET_EXPORT FileReader {
   const ParquetFileReader* parquet_reader() const;
 
   /// Set the number of threads to use during reads of multiple columns. By
-  /// default only 1 thread is used
+  /// default only 1 thread is used. When ReadTable has fewer columns to read
+  /// than threads, the row groups are read in parallel as well and each column
+  /// of the result has one chunk per row group.
   void set_num_threads(int num_threads);
 
+  /// Set the pool on which the threads of multi-column reads are scheduled. By
+  /// default the process-wide ThreadPool::Default() is used
+  void set_thread_pool(const std::shared_ptr<ThreadPool>& thread_pool);
+
+  /// If enabled and more than one thread is used, ReadRowGroup splits each
+  /// flat column chunk into groups of consecutive pages that are decompressed
+  /// and decoded in parallel. The pages are located with the page index of the
+  /// file if any, or else by scanning the page headers first. Each column of
+  /// the result then has one chunk per group of pages. Disabled by default
+  void set_parallel_page_decoding(bool enabled);
+
+  /// Read the given leaf column, a top-level BYTE_ARRAY column, as a
+  /// DictionaryArray of int32 indices instead of a BinaryArray or StringArray.
+  /// The dictionary pages are decoded once, and the dictionaries of several
+  /// row groups are merged into one. The values of the pages that are not
+  /// dictionary-encoded, for instance after the writer fell back to PLAIN, are
+  /// added to the dictionary.
+  ///
+  /// Applies to GetColumn, ReadColumn, ReadSchemaField, ReadTable and
+  /// ReadRowGroup. The reads returning several chunks per column, such as
+  /// row ranges and parallel page decoding, still read dense arrays.
+  void set_read_dictionary(int column_index, bool read_dictionary);
+
   virtual ~FileReader();
 
  private:
@@ -22,6 +22,7 @@
 #include <vector>
 
 #include "parquet/api/schema.h"
+#include "parquet/util/decimal-util.h"
 #include "parquet/util/schema-util.h"
 
 #include "arrow/api.h"
@@ -476,6 +477,8 @@ Status FieldToNode(const std::shared_ptr<Field>& field,
   Repetition::type repetition =
       field->nullable() ? Repetition::OPTIONAL : Repetition::REQUIRED;
   int length = -1;
+  int precision = -1;
+  int scale = -1;
 
   switch (field->type()->id()) {
     case ArrowType::NA:
@@ -538,6 +541,21 @@ Status FieldToNode(const std::shared_ptr<Field>& field,
           static_cast<::arrow::FixedSizeBinaryType*>(field->type().get());
       length = fixed_size_binary_type->byte_width();
     } break;
+    case ArrowType::DECIMAL: {
+      // The narrowest physical type holding the precision
+      auto decimal_type = static_cast<::arrow::DecimalType*>(field->type().get());
+      precision = decimal_type->precision();
+      scale = decimal_type->scale();
+      logical_type = LogicalType::DECIMAL;
+      if (precision <= kMaxInt32DecimalPrecision) {
+        type = ParquetType::INT32;
+      } else if (precision <= kMaxInt64DecimalPrecision) {
+        type = ParquetType::INT64;
+      } else {
+        type = ParquetType::FIXED_LEN_BYTE_ARRAY;
+        length = DecimalByteWidth(precision);
+      }
+    } break;
     case ArrowType::DATE32:
       type = ParquetType::INT32;
       logical_type = LogicalType::DATE;
@@ -573,11 +591,20 @@ Status FieldToNode(const std::shared_ptr<Field>& field,
       return ListToNode(list_type, field->name(), field->nullable(), properties,
                         arrow_properties, out);
     } break;
+    case ArrowType::DICTIONARY: {
+      // Stored as the values of the dictionary, which become the dictionary of
+      // the column chunk when it is dictionary encoded
+      auto dict_type = std::static_pointer_cast<::arrow::DictionaryType>(field->type());
+      auto value_field = std::make_shared<Field>(
+          field->name(), dict_type->dictionary()->type(), field->nullable());
+      return FieldToNode(value_field, properties, arrow_properties, out);
+    } break;
     default:
-      // TODO: LIST, DENSE_UNION, SPARE_UNION, JSON_SCALAR, DECIMAL, DECIMAL_TEXT, VARCHAR
+      // TODO: LIST, DENSE_UNION, SPARE_UNION, JSON_SCALAR, DECIMAL_TEXT, VARCHAR
       return Status::NotImplemented("unhandled type");
   }
-  *out = PrimitiveNode::Make(field->name(), repetition, type, logical_type, length);
+  *out = PrimitiveNode::Make(field->name(), repetition, type, logical_type, length,
+                             precision, scale);
   return Status::OK();
 }
 
@@ -21,25 +21,32 @@
 #include <string>
 #include <vector>
 
+#if defined(PARQUET_USE_SSE) && defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 #include "arrow/api.h"
 #include "arrow/util/bit-util.h"
 #include "arrow/visitor_inline.h"
 
 #include "parquet/arrow/schema.h"
+#include "parquet/util/decimal-util.h"
+#include "parquet/util/int-util.h"
 #include "parquet/util/logging.h"
+#include "parquet/util/thread-pool.h"
 
 using arrow::Array;
 using arrow::BinaryArray;
 using arrow::FixedSizeBinaryArray;
 using arrow::BooleanArray;
 using arrow::Int16Array;
-using arrow::Int16Builder;
 using arrow::Field;
 using arrow::MemoryPool;
 using arrow::NumericArray;
 using arrow::PoolBuffer;
 using arrow::PrimitiveArray;
 using arrow::ListArray;
+using arrow::RecordBatch;
 using arrow::Status;
 using arrow::Table;
 using arrow::TimeUnit;
@@ -53,6 +60,88 @@ namespace arrow {
 
 namespace BitUtil = ::arrow::BitUtil;
 
+constexpr int64_t kMillisecondsPerDay = INT64_C(86400000);
+
+// Convert Date64 milliseconds into days since the epoch
+static inline void MillisecondsToDays(const int64_t* milliseconds, int64_t length,
+                                      int32_t* days) {
+  for (int64_t i = 0; i < length; ++i) {
+    days[i] = static_cast<int32_t>(milliseconds[i] / kMillisecondsPerDay);
+  }
+}
+
+// Write set_level for each of the length bits of the bitmap starting at bit
+// offset that is set, and unset_level for the others
+static void BitmapToLevels(const uint8_t* bits, int64_t offset, int64_t length,
+                           int16_t set_level, int16_t unset_level, int16_t* levels) {
+  int64_t i = 0;
+  for (; i < length && (offset + i) % 8 != 0; ++i) {
+    levels[i] = BitUtil::GetBit(bits, offset + i) ? set_level : unset_level;
+  }
+  // Then expand a whole byte into 8 levels at a time
+  const uint8_t* bytes = bits + (offset + i) / 8;
+#if defined(PARQUET_USE_SSE) && defined(__SSE2__)
+  const __m128i bit_masks = _mm_setr_epi16(1, 2, 4, 8, 16, 32, 64, 128);
+  const __m128i set_levels = _mm_set1_epi16(set_level);
+  const __m128i unset_levels = _mm_set1_epi16(unset_level);
+  for (; i + 8 <= length; i += 8, ++bytes) {
+    const __m128i byte = _mm_set1_epi16(*bytes);
+    const __m128i is_set = _mm_cmpeq_epi16(_mm_and_si128(byte, bit_masks), bit_masks);
+    const __m128i result = _mm_or_si128(_mm_and_si128(is_set, set_levels),
+                                        _mm_andnot_si128(is_set, unset_levels));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(levels + i), result);
+  }
+#else
+  for (; i + 8 <= length; i += 8, ++bytes) {
+    const uint8_t byte = *bytes;
+    for (int j = 0; j < 8; ++j) {
+      levels[i + j] = ((byte >> j) & 1) ? set_level : unset_level;
+    }
+  }
+#endif
+  for (; i < length; ++i) {
+    levels[i] = BitUtil::GetBit(bits, offset + i) ? set_level : unset_level;
+  }
+}
+
+// A growable array of levels, appended to in bulk
+class LevelsBuffer {
+ public:
+  explicit LevelsBuffer(MemoryPool* pool)
+      : buffer_(std::make_shared<PoolBuffer>(pool)), length_(0), capacity_(0) {}
+
+  // Make room for length more levels and return where they go
+  Status Extend(int64_t length, int16_t** levels) {
+    if (length_ + length > capacity_) {
+      capacity_ = std::max(length_ + length, 2 * capacity_);
+      RETURN_NOT_OK(buffer_->Reserve(capacity_ * sizeof(int16_t)));
+    }
+    *levels = reinterpret_cast<int16_t*>(buffer_->mutable_data()) + length_;
+    length_ += length;
+    return Status::OK();
+  }
+
+  Status Append(int16_t level, int64_t count = 1) {
+    int16_t* levels;
+    RETURN_NOT_OK(Extend(count, &levels));
+    std::fill(levels, levels + count, level);
+    return Status::OK();
+  }
+
+  int64_t length() const { return length_; }
+
+  Status Finish(std::shared_ptr<Buffer>* out) {
+    RETURN_NOT_OK(buffer_->Resize(length_ * sizeof(int16_t)));
+    *out = buffer_;
+    return Status::OK();
+  }
+
+ private:
+  std::shared_ptr<PoolBuffer> buffer_;
+  int64_t length_;
+  int64_t capacity_;
+};
+
 std::shared_ptr<ArrowWriterProperties> default_arrow_writer_properties() {
   static std::shared_ptr<ArrowWriterProperties> default_writer_properties =
       ArrowWriterProperties::Builder().build();
@@ -61,10 +150,7 @@ std::shared_ptr<ArrowWriterProperties> default_arrow_writer_properties() {
 
 class LevelBuilder {
  public:
-  explicit LevelBuilder(MemoryPool* pool)
-      : def_levels_(::arrow::int16(), pool), rep_levels_(::arrow::int16(), pool) {
-    def_levels_buffer_ = std::make_shared<PoolBuffer>(pool);
-  }
+  explicit LevelBuilder(MemoryPool* pool) : def_levels_(pool), rep_levels_(pool) {}
 
   Status VisitInline(const Array& array);
 
@@ -99,7 +185,6 @@ class LevelBuilder {
 
   NOT_IMPLEMENTED_VISIT(Struct)
   NOT_IMPLEMENTED_VISIT(Union)
-  NOT_IMPLEMENTED_VISIT(Decimal)
   NOT_IMPLEMENTED_VISIT(Dictionary)
   NOT_IMPLEMENTED_VISIT(Interval)
 
@@ -136,26 +221,17 @@ class LevelBuilder {
       // We have a PrimitiveArray
       *rep_levels = nullptr;
       if (nullable_[0]) {
-        RETURN_NOT_OK(def_levels_buffer_->Resize(array.length() * sizeof(int16_t)));
-        auto def_levels_ptr =
-            reinterpret_cast<int16_t*>(def_levels_buffer_->mutable_data());
+        int16_t* def_levels_ptr;
+        RETURN_NOT_OK(def_levels_.Extend(array.length(), &def_levels_ptr));
         if (array.null_count() == 0) {
           std::fill(def_levels_ptr, def_levels_ptr + array.length(), 1);
         } else if (array.null_count() == array.length()) {
           std::fill(def_levels_ptr, def_levels_ptr + array.length(), 0);
         } else {
-          const uint8_t* valid_bits = array.null_bitmap_data();
-          INIT_BITSET(valid_bits, static_cast<int>(array.offset()));
-          for (int i = 0; i < array.length(); i++) {
-            if (bitset_valid_bits & (1 << bit_offset_valid_bits)) {
-              def_levels_ptr[i] = 1;
-            } else {
-              def_levels_ptr[i] = 0;
-            }
-            READ_NEXT_BITSET(valid_bits);
-          }
+          BitmapToLevels(array.null_bitmap_data(), array.offset(), array.length(), 1, 0,
+                         def_levels_ptr);
         }
-        *def_levels = def_levels_buffer_;
+        RETURN_NOT_OK(def_levels_.Finish(def_levels));
       } else {
         *def_levels = nullptr;
       }
@@ -164,14 +240,9 @@ class LevelBuilder {
       RETURN_NOT_OK(rep_levels_.Append(0));
       RETURN_NOT_OK(HandleListEntries(0, 0, 0, array.length()));
 
-      std::shared_ptr<Array> def_levels_array;
-      RETURN_NOT_OK(def_levels_.Finish(&def_levels_array));
-      *def_levels = static_cast<PrimitiveArray*>(def_levels_array.get())->values();
-
-      std::shared_ptr<Array> rep_levels_array;
-      RETURN_NOT_OK(rep_levels_.Finish(&rep_levels_array));
-      *rep_levels = static_cast<PrimitiveArray*>(rep_levels_array.get())->values();
-      *num_levels = rep_levels_array->length();
+      *num_levels = rep_levels_.length();
+      RETURN_NOT_OK(def_levels_.Finish(def_levels));
+      RETURN_NOT_OK(rep_levels_.Finish(rep_levels));
     }
 
     return Status::OK();
@@ -200,24 +271,24 @@ class LevelBuilder {
     if (recursion_level < static_cast<int64_t>(offsets_.size())) {
       return HandleListEntries(def_level + 1, rep_level + 1, inner_offset, inner_length);
     } else {
-      // We have reached the leaf: primitive list, handle remaining nullables
-      for (int64_t i = 0; i < inner_length; i++) {
-        if (i > 0) {
-          RETURN_NOT_OK(rep_levels_.Append(rep_level + 1));
-        }
-        if (nullable_[recursion_level] &&
-            ((null_counts_[recursion_level] == 0) ||
-             BitUtil::GetBit(valid_bitmaps_[recursion_level],
-                             inner_offset + i + array_offsets_[recursion_level]))) {
-          RETURN_NOT_OK(def_levels_.Append(def_level + 2));
-        } else {
-          // This can be produced in two case:
-          //  * elements are nullable and this one is null (i.e. max_def_level = def_level
-          //  + 2)
-          //  * elements are non-nullable (i.e. max_def_level = def_level + 1)
-          RETURN_NOT_OK(def_levels_.Append(def_level + 1));
-        }
+      // We have reached the leaf: primitive list, handle remaining nullables.
+      // All the entries but the first repeat the list.
+      RETURN_NOT_OK(rep_levels_.Append(rep_level + 1, inner_length - 1));
+      // def_level + 1 is produced in two cases:
+      //  * elements are nullable and this one is null (i.e. max_def_level =
+      //    def_level + 2)
+      //  * elements are non-nullable (i.e. max_def_level = def_level + 1)
+      if (!nullable_[recursion_level]) {
+        return def_levels_.Append(def_level + 1, inner_length);
+      } else if (null_counts_[recursion_level] == 0) {
+        return def_levels_.Append(def_level + 2, inner_length);
       }
+      int16_t* def_levels_ptr;
+      RETURN_NOT_OK(def_levels_.Extend(inner_length, &def_levels_ptr));
+      BitmapToLevels(valid_bitmaps_[recursion_level],
+                     inner_offset + array_offsets_[recursion_level], inner_length,
+                     static_cast<int16_t>(def_level + 2),
+                     static_cast<int16_t>(def_level + 1), def_levels_ptr);
       return Status::OK();
     }
   }
@@ -234,9 +305,8 @@ class LevelBuilder {
   }
 
  private:
-  Int16Builder def_levels_;
-  std::shared_ptr<PoolBuffer> def_levels_buffer_;
-  Int16Builder rep_levels_;
+  LevelsBuffer def_levels_;
+  LevelsBuffer rep_levels_;
 
   std::vector<int64_t> null_counts_;
   std::vector<const uint8_t*> valid_bitmaps_;
@@ -254,22 +324,47 @@ Status LevelBuilder::VisitInline(const Array& array) {
   return VisitArrayInline(array, this);
 }
 
-class FileWriter::Impl {
+// Converts Arrow arrays to the physical types of Parquet and writes them as
+// whole column chunks. Each instance owns its conversion buffer, so that the
+// chunks of a row group can be written concurrently by distinct instances.
+class ArrowColumnWriter {
  public:
-  Impl(MemoryPool* pool, std::unique_ptr<ParquetFileWriter> writer,
-       const std::shared_ptr<ArrowWriterProperties>& arrow_properties);
+  ArrowColumnWriter(MemoryPool* pool, const ParquetFileWriter* file_writer,
+                    const std::shared_ptr<ArrowWriterProperties>& arrow_properties)
+      : pool_(pool),
+        data_buffer_(pool),
+        file_writer_(file_writer),
+        arrow_properties_(arrow_properties) {}
 
-  Status NewRowGroup(int64_t chunk_size);
+  // Write data as the whole chunk of the leaf column column_index, and close
+  // the column writer
+  Status Write(int column_index, const Array& data, ColumnWriter* column_writer);
+
+  // Append data to the chunk of the leaf column column_index, leaving the
+  // column writer open for the next batch
+  Status Append(int column_index, const Array& data, ColumnWriter* column_writer);
 
   template <typename ParquetType, typename ArrowType>
   Status TypedWriteBatch(ColumnWriter* column_writer, const std::shared_ptr<Array>& data,
                          int64_t num_levels, const int16_t* def_levels,
                          const int16_t* rep_levels);
 
+  // Write the indices of a flat DictionaryArray directly, with its dictionary
+  // as the dictionary of the column chunk
+  Status WriteDictionaryArray(const ::arrow::DictionaryArray& data,
+                              const std::shared_ptr<Field>& field,
+                              ColumnWriter* column_writer);
+
   Status WriteTimestamps(ColumnWriter* column_writer, const std::shared_ptr<Array>& data,
                          int64_t num_levels, const int16_t* def_levels,
                          const int16_t* rep_levels);
 
+  // Write a DecimalArray to the INT32, INT64 or FIXED_LEN_BYTE_ARRAY column
+  // chosen by its precision
+  Status WriteDecimals(ColumnWriter* column_writer, const std::shared_ptr<Array>& data,
+                       int64_t num_levels, const int16_t* def_levels,
+                       const int16_t* rep_levels);
+
   Status WriteTimestampsCoerce(ColumnWriter* column_writer,
                                const std::shared_ptr<Array>& data, int64_t num_levels,
                                const int16_t* def_levels, const int16_t* rep_levels);
@@ -279,7 +374,8 @@ class FileWriter::Impl {
                                const ArrowType& type, int64_t num_values,
                                int64_t num_levels, const int16_t* def_levels,
                                const int16_t* rep_levels,
-                               const typename ArrowType::c_type* data_ptr);
+                               const typename ArrowType::c_type* data_ptr,
+                               const std::shared_ptr<Buffer>& values_buffer = nullptr);
 
   template <typename ParquetType, typename ArrowType>
   Status WriteNullableBatch(TypedColumnWriter<ParquetType>* column_writer,
@@ -288,7 +384,36 @@ class FileWriter::Impl {
                             const uint8_t* valid_bits, int64_t valid_bits_offset,
                             const typename ArrowType::c_type* data_ptr);
 
+ private:
+  MemoryPool* pool_;
+  // Buffer used for storing the data of an array converted to the physical type
+  // as expected by parquet-cpp.
+  PoolBuffer data_buffer_;
+  const ParquetFileWriter* file_writer_;
+  std::shared_ptr<ArrowWriterProperties> arrow_properties_;
+};
+
+class FileWriter::Impl {
+ public:
+  Impl(MemoryPool* pool, std::unique_ptr<ParquetFileWriter> writer,
+       const std::shared_ptr<ArrowWriterProperties>& arrow_properties);
+
+  Status NewRowGroup(int64_t chunk_size);
+
   Status WriteColumnChunk(const Array& data);
+
+  // Write the slice [offset, offset + size) of every column of the table as a
+  // buffered row group, whose column chunks are written in parallel
+  Status WriteRowGroupParallel(const Table& table, int64_t offset, int64_t size);
+
+  // Append the batch to the open row group, see FileWriter::WriteRecordBatch
+  Status WriteRecordBatch(const RecordBatch& batch);
+
+  // Number of rows of the next row group, so that it is about max_bytes large.
+  // The encoded size of a row is measured on the row groups written so far, or,
+  // for the first one, taken from the size of the Arrow data.
+  int64_t RowGroupLength(int64_t max_bytes, double arrow_bytes_per_row) const;
+
   Status Close();
 
   const WriterProperties& properties() const { return *writer_->properties(); }
@@ -299,38 +424,95 @@ class FileWriter::Impl {
   friend class FileWriter;
 
   MemoryPool* pool_;
-  // Buffer used for storing the data of an array converted to the physical type
-  // as expected by parquet-cpp.
-  PoolBuffer data_buffer_;
   std::unique_ptr<ParquetFileWriter> writer_;
+  ArrowColumnWriter column_writer_;
   RowGroupWriter* row_group_writer_;
   std::shared_ptr<ArrowWriterProperties> arrow_properties_;
+
+  int num_threads_;
+  std::shared_ptr<ThreadPool> thread_pool_;
+
+  // Rows and bytes of the row groups closed so far
+  int64_t closed_rows_;
+  int64_t closed_bytes_;
+
+  // Whether row_group_writer_ is a row group opened by WriteRecordBatch, and
+  // may still be appended to
+  bool appending_;
+
+  Status CloseRowGroup();
+
+  // Whether the row group appended to by WriteRecordBatch is large enough to be
+  // closed
+  bool AppendedRowGroupFull();
 };
 
 FileWriter::Impl::Impl(MemoryPool* pool, std::unique_ptr<ParquetFileWriter> writer,
                        const std::shared_ptr<ArrowWriterProperties>& arrow_properties)
     : pool_(pool),
-      data_buffer_(pool),
       writer_(std::move(writer)),
+      column_writer_(pool, writer_.get(), arrow_properties),
       row_group_writer_(nullptr),
-      arrow_properties_(arrow_properties) {}
-
-Status FileWriter::Impl::NewRowGroup(int64_t chunk_size) {
+      arrow_properties_(arrow_properties),
+      num_threads_(1),
+      thread_pool_(ThreadPool::Default()),
+      closed_rows_(0),
+      closed_bytes_(0),
+      appending_(false) {}
+
+Status FileWriter::Impl::CloseRowGroup() {
   if (row_group_writer_ != nullptr) {
-    PARQUET_CATCH_NOT_OK(row_group_writer_->Close());
+    RowGroupWriter* row_group_writer = row_group_writer_;
+    row_group_writer_ = nullptr;
+    appending_ = false;
+    PARQUET_CATCH_NOT_OK(row_group_writer->Close());
+    closed_rows_ += row_group_writer->num_rows();
+    closed_bytes_ += row_group_writer->total_bytes_written();
   }
+  return Status::OK();
+}
+
+bool FileWriter::Impl::AppendedRowGroupFull() {
+  const WriterProperties& props = properties();
+  if (row_group_writer_->num_rows() >= props.max_row_group_length()) {
+    return true;
+  }
+  if (props.max_row_group_bytes() > 0 &&
+      row_group_writer_->buffered_bytes() >= props.max_row_group_bytes()) {
+    return true;
+  }
+  // Past the minimum length, so that a tight budget does not cut a row group
+  // on every append
+  return props.memory_budget() != nullptr && props.memory_budget()->exceeded() &&
+         row_group_writer_->num_rows() >= props.min_row_group_length();
+}
+
+Status FileWriter::Impl::NewRowGroup(int64_t chunk_size) {
+  RETURN_NOT_OK(CloseRowGroup());
   PARQUET_CATCH_NOT_OK(row_group_writer_ = writer_->AppendRowGroup(chunk_size));
   return Status::OK();
 }
 
+int64_t FileWriter::Impl::RowGroupLength(int64_t max_bytes,
+                                         double arrow_bytes_per_row) const {
+  double bytes_per_row = arrow_bytes_per_row;
+  if (closed_rows_ > 0) {
+    bytes_per_row = static_cast<double>(closed_bytes_) / closed_rows_;
+  }
+  if (bytes_per_row <= 0) {
+    return max_bytes;
+  }
+  return std::max<int64_t>(1, static_cast<int64_t>(max_bytes / bytes_per_row));
+}
+
 // ----------------------------------------------------------------------
 // Column type specialization
 
 template <typename ParquetType, typename ArrowType>
-Status FileWriter::Impl::TypedWriteBatch(ColumnWriter* column_writer,
-                                         const std::shared_ptr<Array>& array,
-                                         int64_t num_levels, const int16_t* def_levels,
-                                         const int16_t* rep_levels) {
+Status ArrowColumnWriter::TypedWriteBatch(ColumnWriter* column_writer,
+                                          const std::shared_ptr<Array>& array,
+                                          int64_t num_levels, const int16_t* def_levels,
+                                          const int16_t* rep_levels) {
   using ArrowCType = typename ArrowType::c_type;
 
   auto data = static_cast<const PrimitiveArray*>(array.get());
@@ -341,51 +523,51 @@ Status FileWriter::Impl::TypedWriteBatch(ColumnWriter* column_writer,
     // no nulls, just dump the data
     RETURN_NOT_OK((WriteNonNullableBatch<ParquetType, ArrowType>(
         writer, static_cast<const ArrowType&>(*array->type()), array->length(),
-        num_levels, def_levels, rep_levels, data_ptr)));
+        num_levels, def_levels, rep_levels, data_ptr, data->values())));
   } else {
     const uint8_t* valid_bits = data->null_bitmap_data();
     RETURN_NOT_OK((WriteNullableBatch<ParquetType, ArrowType>(
         writer, static_cast<const ArrowType&>(*array->type()), data->length(), num_levels,
         def_levels, rep_levels, valid_bits, data->offset(), data_ptr)));
   }
-  PARQUET_CATCH_NOT_OK(writer->Close());
   return Status::OK();
 }
 
 template <typename ParquetType, typename ArrowType>
-Status FileWriter::Impl::WriteNonNullableBatch(
+Status ArrowColumnWriter::WriteNonNullableBatch(
     TypedColumnWriter<ParquetType>* writer, const ArrowType& type, int64_t num_values,
     int64_t num_levels, const int16_t* def_levels, const int16_t* rep_levels,
-    const typename ArrowType::c_type* data_ptr) {
+    const typename ArrowType::c_type* data_ptr,
+    const std::shared_ptr<Buffer>& values_buffer) {
   using ParquetCType = typename ParquetType::c_type;
   RETURN_NOT_OK(data_buffer_.Resize(num_values * sizeof(ParquetCType)));
   auto buffer_ptr = reinterpret_cast<ParquetCType*>(data_buffer_.mutable_data());
-  std::copy(data_ptr, data_ptr + num_values, buffer_ptr);
+  ConvertInts(data_ptr, num_values, buffer_ptr);
   PARQUET_CATCH_NOT_OK(
       writer->WriteBatch(num_levels, def_levels, rep_levels, buffer_ptr));
   return Status::OK();
 }
 
 template <>
-Status FileWriter::Impl::WriteNonNullableBatch<Int32Type, ::arrow::Date64Type>(
+Status ArrowColumnWriter::WriteNonNullableBatch<Int32Type, ::arrow::Date64Type>(
     TypedColumnWriter<Int32Type>* writer, const ::arrow::Date64Type& type,
     int64_t num_values, int64_t num_levels, const int16_t* def_levels,
-    const int16_t* rep_levels, const int64_t* data_ptr) {
+    const int16_t* rep_levels, const int64_t* data_ptr,
+    const std::shared_ptr<Buffer>& values_buffer) {
   RETURN_NOT_OK(data_buffer_.Resize(num_values * sizeof(int32_t)));
   auto buffer_ptr = reinterpret_cast<int32_t*>(data_buffer_.mutable_data());
-  for (int i = 0; i < num_values; i++) {
-    buffer_ptr[i] = static_cast<int32_t>(data_ptr[i] / 86400000);
-  }
+  MillisecondsToDays(data_ptr, num_values, buffer_ptr);
   PARQUET_CATCH_NOT_OK(
       writer->WriteBatch(num_levels, def_levels, rep_levels, buffer_ptr));
   return Status::OK();
 }
 
 template <>
-Status FileWriter::Impl::WriteNonNullableBatch<Int32Type, ::arrow::Time32Type>(
+Status ArrowColumnWriter::WriteNonNullableBatch<Int32Type, ::arrow::Time32Type>(
     TypedColumnWriter<Int32Type>* writer, const ::arrow::Time32Type& type,
     int64_t num_values, int64_t num_levels, const int16_t* def_levels,
-    const int16_t* rep_levels, const int32_t* data_ptr) {
+    const int16_t* rep_levels, const int32_t* data_ptr,
+    const std::shared_ptr<Buffer>& values_buffer) {
   RETURN_NOT_OK(data_buffer_.Resize(num_values * sizeof(int32_t)));
   auto buffer_ptr = reinterpret_cast<int32_t*>(data_buffer_.mutable_data());
   if (type.unit() == TimeUnit::SECOND) {
@@ -402,12 +584,14 @@ Status FileWriter::Impl::WriteNonNullableBatch<Int32Type, ::arrow::Time32Type>(
 
 #define NONNULLABLE_BATCH_FAST_PATH(ParquetType, ArrowType, CType)         \
   template <>                                                              \
-  Status FileWriter::Impl::WriteNonNullableBatch<ParquetType, ArrowType>(  \
+  Status ArrowColumnWriter::WriteNonNullableBatch<ParquetType, ArrowType>( \
       TypedColumnWriter<ParquetType> * writer, const ArrowType& type,      \
       int64_t num_values, int64_t num_levels, const int16_t* def_levels,   \
-      const int16_t* rep_levels, const CType* data_ptr) {                  \
-    PARQUET_CATCH_NOT_OK(                                                  \
-        writer->WriteBatch(num_levels, def_levels, rep_levels, data_ptr)); \
+      const int16_t* rep_levels, const CType* data_ptr,                    \
+      const std::shared_ptr<Buffer>& values_buffer) {                      \
+    PARQUET_CATCH_NOT_OK(writer->WriteBatch(num_levels, def_levels,        \
+                                            rep_levels, data_ptr,          \
+                                            values_buffer));               \
     return Status::OK();                                                   \
   }
 
@@ -419,24 +603,18 @@ NONNULLABLE_BATCH_FAST_PATH(FloatType, ::arrow::FloatType, float)
 NONNULLABLE_BATCH_FAST_PATH(DoubleType, ::arrow::DoubleType, double)
 
 template <typename ParquetType, typename ArrowType>
-Status FileWriter::Impl::WriteNullableBatch(TypedColumnWriter<ParquetType>* writer,
-                                            const ArrowType& type, int64_t num_values,
-                                            int64_t num_levels, const int16_t* def_levels,
-                                            const int16_t* rep_levels,
-                                            const uint8_t* valid_bits,
-                                            int64_t valid_bits_offset,
-                                            const typename ArrowType::c_type* data_ptr) {
+Status ArrowColumnWriter::WriteNullableBatch(
+    TypedColumnWriter<ParquetType>* writer, const ArrowType& type, int64_t num_values,
+    int64_t num_levels, const int16_t* def_levels, const int16_t* rep_levels,
+    const uint8_t* valid_bits, int64_t valid_bits_offset,
+    const typename ArrowType::c_type* data_ptr) {
   using ParquetCType = typename ParquetType::c_type;
 
   RETURN_NOT_OK(data_buffer_.Resize(num_values * sizeof(ParquetCType)));
   auto buffer_ptr = reinterpret_cast<ParquetCType*>(data_buffer_.mutable_data());
-  INIT_BITSET(valid_bits, static_cast<int>(valid_bits_offset));
-  for (int i = 0; i < num_values; i++) {
-    if (bitset_valid_bits & (1 << bit_offset_valid_bits)) {
-      buffer_ptr[i] = static_cast<ParquetCType>(data_ptr[i]);
-    }
-    READ_NEXT_BITSET(valid_bits);
-  }
+  // As for Date64, the null slots are converted too so that the conversion
+  // vectorizes; WriteBatchSpaced skips them
+  ConvertInts(data_ptr, num_values, buffer_ptr);
   PARQUET_CATCH_NOT_OK(writer->WriteBatchSpaced(
       num_levels, def_levels, rep_levels, valid_bits, valid_bits_offset, buffer_ptr));
 
@@ -444,21 +622,16 @@ Status FileWriter::Impl::WriteNullableBatch(TypedColumnWriter<ParquetType>* writ
 }
 
 template <>
-Status FileWriter::Impl::WriteNullableBatch<Int32Type, ::arrow::Date64Type>(
+Status ArrowColumnWriter::WriteNullableBatch<Int32Type, ::arrow::Date64Type>(
     TypedColumnWriter<Int32Type>* writer, const ::arrow::Date64Type& type,
     int64_t num_values, int64_t num_levels, const int16_t* def_levels,
     const int16_t* rep_levels, const uint8_t* valid_bits, int64_t valid_bits_offset,
     const int64_t* data_ptr) {
   RETURN_NOT_OK(data_buffer_.Resize(num_values * sizeof(int32_t)));
   auto buffer_ptr = reinterpret_cast<int32_t*>(data_buffer_.mutable_data());
-  INIT_BITSET(valid_bits, static_cast<int>(valid_bits_offset));
-  for (int i = 0; i < num_values; i++) {
-    if (bitset_valid_bits & (1 << bit_offset_valid_bits)) {
-      // Convert from milliseconds into days since the epoch
-      buffer_ptr[i] = static_cast<int32_t>(data_ptr[i] / 86400000);
-    }
-    READ_NEXT_BITSET(valid_bits);
-  }
+  // The null slots are converted too, rather than branching on the validity
+  // bitmap; WriteBatchSpaced skips them
+  MillisecondsToDays(data_ptr, num_values, buffer_ptr);
   PARQUET_CATCH_NOT_OK(writer->WriteBatchSpaced(
       num_levels, def_levels, rep_levels, valid_bits, valid_bits_offset, buffer_ptr));
 
@@ -466,7 +639,7 @@ Status FileWriter::Impl::WriteNullableBatch<Int32Type, ::arrow::Date64Type>(
 }
 
 template <>
-Status FileWriter::Impl::WriteNullableBatch<Int32Type, ::arrow::Time32Type>(
+Status ArrowColumnWriter::WriteNullableBatch<Int32Type, ::arrow::Time32Type>(
     TypedColumnWriter<Int32Type>* writer, const ::arrow::Time32Type& type,
     int64_t num_values, int64_t num_levels, const int16_t* def_levels,
     const int16_t* rep_levels, const uint8_t* valid_bits, int64_t valid_bits_offset,
@@ -498,7 +671,7 @@ Status FileWriter::Impl::WriteNullableBatch<Int32Type, ::arrow::Time32Type>(
 
 #define NULLABLE_BATCH_FAST_PATH(ParquetType, ArrowType, CType)                        \
   template <>                                                                          \
-  Status FileWriter::Impl::WriteNullableBatch<ParquetType, ArrowType>(                 \
+  Status ArrowColumnWriter::WriteNullableBatch<ParquetType, ArrowType>(                \
       TypedColumnWriter<ParquetType> * writer, const ArrowType& type,                  \
       int64_t num_values, int64_t num_levels, const int16_t* def_levels,               \
       const int16_t* rep_levels, const uint8_t* valid_bits, int64_t valid_bits_offset, \
@@ -522,22 +695,17 @@ NULLABLE_BATCH_FAST_PATH(Int64Type, ::arrow::TimestampType, int64_t)
 NONNULLABLE_BATCH_FAST_PATH(Int64Type, ::arrow::TimestampType, int64_t)
 
 template <>
-Status FileWriter::Impl::WriteNullableBatch<Int96Type, ::arrow::TimestampType>(
+Status ArrowColumnWriter::WriteNullableBatch<Int96Type, ::arrow::TimestampType>(
     TypedColumnWriter<Int96Type>* writer, const ::arrow::TimestampType& type,
     int64_t num_values, int64_t num_levels, const int16_t* def_levels,
     const int16_t* rep_levels, const uint8_t* valid_bits, int64_t valid_bits_offset,
     const int64_t* data_ptr) {
   RETURN_NOT_OK(data_buffer_.Resize(num_values * sizeof(Int96)));
   auto buffer_ptr = reinterpret_cast<Int96*>(data_buffer_.mutable_data());
-  INIT_BITSET(valid_bits, static_cast<int>(valid_bits_offset));
 
   if (type.unit() == TimeUnit::NANO) {
-    for (int i = 0; i < num_values; i++) {
-      if (bitset_valid_bits & (1 << bit_offset_valid_bits)) {
-        internal::NanosecondsToImpalaTimestamp(data_ptr[i], buffer_ptr + i);
-      }
-      READ_NEXT_BITSET(valid_bits);
-    }
+    // The null slots are converted too; WriteBatchSpaced skips them
+    internal::NanosecondsToImpalaTimestamps(data_ptr, num_values, buffer_ptr);
   } else {
     return Status::NotImplemented("Only NANO timestamps are supported for Int96 writing");
   }
@@ -548,16 +716,15 @@ Status FileWriter::Impl::WriteNullableBatch<Int96Type, ::arrow::TimestampType>(
 }
 
 template <>
-Status FileWriter::Impl::WriteNonNullableBatch<Int96Type, ::arrow::TimestampType>(
+Status ArrowColumnWriter::WriteNonNullableBatch<Int96Type, ::arrow::TimestampType>(
     TypedColumnWriter<Int96Type>* writer, const ::arrow::TimestampType& type,
     int64_t num_values, int64_t num_levels, const int16_t* def_levels,
-    const int16_t* rep_levels, const int64_t* data_ptr) {
+    const int16_t* rep_levels, const int64_t* data_ptr,
+    const std::shared_ptr<Buffer>& values_buffer) {
   RETURN_NOT_OK(data_buffer_.Resize(num_values * sizeof(Int96)));
   auto buffer_ptr = reinterpret_cast<Int96*>(data_buffer_.mutable_data());
   if (type.unit() == TimeUnit::NANO) {
-    for (int i = 0; i < num_values; i++) {
-      internal::NanosecondsToImpalaTimestamp(data_ptr[i], buffer_ptr + i);
-    }
+    internal::NanosecondsToImpalaTimestamps(data_ptr, num_values, buffer_ptr);
   } else {
     return Status::NotImplemented("Only NANO timestamps are supported for Int96 writing");
   }
@@ -566,10 +733,10 @@ Status FileWriter::Impl::WriteNonNullableBatch<Int96Type, ::arrow::TimestampType
   return Status::OK();
 }
 
-Status FileWriter::Impl::WriteTimestamps(ColumnWriter* column_writer,
-                                         const std::shared_ptr<Array>& values,
-                                         int64_t num_levels, const int16_t* def_levels,
-                                         const int16_t* rep_levels) {
+Status ArrowColumnWriter::WriteTimestamps(ColumnWriter* column_writer,
+                                          const std::shared_ptr<Array>& values,
+                                          int64_t num_levels, const int16_t* def_levels,
+                                          const int16_t* rep_levels) {
   const auto& type = static_cast<::arrow::TimestampType&>(*values->type());
 
   const bool is_nanosecond = type.unit() == TimeUnit::NANO;
@@ -592,11 +759,11 @@ Status FileWriter::Impl::WriteTimestamps(ColumnWriter* column_writer,
   }
 }
 
-Status FileWriter::Impl::WriteTimestampsCoerce(ColumnWriter* column_writer,
-                                               const std::shared_ptr<Array>& array,
-                                               int64_t num_levels,
-                                               const int16_t* def_levels,
-                                               const int16_t* rep_levels) {
+Status ArrowColumnWriter::WriteTimestampsCoerce(ColumnWriter* column_writer,
+                                                const std::shared_ptr<Array>& array,
+                                                int64_t num_levels,
+                                                const int16_t* def_levels,
+                                                const int16_t* rep_levels) {
   // Note that we can only use data_buffer_ here as we write timestamps with the fast
   // path.
   RETURN_NOT_OK(data_buffer_.Resize(array->length() * sizeof(int64_t)));
@@ -662,7 +829,6 @@ Status FileWriter::Impl::WriteTimestampsCoerce(ColumnWriter* column_writer,
         writer, static_cast<const ::arrow::TimestampType&>(*target_type), array->length(),
         num_levels, def_levels, rep_levels, valid_bits, data.offset(), data_buffer_ptr)));
   }
-  PARQUET_CATCH_NOT_OK(writer->Close());
   return Status::OK();
 }
 
@@ -674,7 +840,7 @@ Status FileWriter::Impl::WriteTimestampsCoerce(ColumnWriter* column_writer,
 //   ArrowType::c_type to ParquetType::c_type
 
 template <>
-Status FileWriter::Impl::TypedWriteBatch<BooleanType, ::arrow::BooleanType>(
+Status ArrowColumnWriter::TypedWriteBatch<BooleanType, ::arrow::BooleanType>(
     ColumnWriter* column_writer, const std::shared_ptr<Array>& array, int64_t num_levels,
     const int16_t* def_levels, const int16_t* rep_levels) {
   RETURN_NOT_OK(data_buffer_.Resize(array->length()));
@@ -692,23 +858,21 @@ Status FileWriter::Impl::TypedWriteBatch<BooleanType, ::arrow::BooleanType>(
   }
   PARQUET_CATCH_NOT_OK(
       writer->WriteBatch(num_levels, def_levels, rep_levels, buffer_ptr));
-  PARQUET_CATCH_NOT_OK(writer->Close());
   return Status::OK();
 }
 
 template <>
-Status FileWriter::Impl::TypedWriteBatch<Int32Type, ::arrow::NullType>(
+Status ArrowColumnWriter::TypedWriteBatch<Int32Type, ::arrow::NullType>(
     ColumnWriter* column_writer, const std::shared_ptr<Array>& array, int64_t num_levels,
     const int16_t* def_levels, const int16_t* rep_levels) {
   auto writer = reinterpret_cast<TypedColumnWriter<Int32Type>*>(column_writer);
 
   PARQUET_CATCH_NOT_OK(writer->WriteBatch(num_levels, def_levels, rep_levels, nullptr));
-  PARQUET_CATCH_NOT_OK(writer->Close());
   return Status::OK();
 }
 
 template <>
-Status FileWriter::Impl::TypedWriteBatch<ByteArrayType, ::arrow::BinaryType>(
+Status ArrowColumnWriter::TypedWriteBatch<ByteArrayType, ::arrow::BinaryType>(
     ColumnWriter* column_writer, const std::shared_ptr<Array>& array, int64_t num_levels,
     const int16_t* def_levels, const int16_t* rep_levels) {
   RETURN_NOT_OK(data_buffer_.Resize(array->length() * sizeof(ByteArray)));
@@ -746,12 +910,11 @@ Status FileWriter::Impl::TypedWriteBatch<ByteArrayType, ::arrow::BinaryType>(
     PARQUET_CATCH_NOT_OK(
         writer->WriteBatch(num_levels, def_levels, rep_levels, buffer_ptr));
   }
-  PARQUET_CATCH_NOT_OK(writer->Close());
   return Status::OK();
 }
 
 template <>
-Status FileWriter::Impl::TypedWriteBatch<FLBAType, ::arrow::FixedSizeBinaryType>(
+Status ArrowColumnWriter::TypedWriteBatch<FLBAType, ::arrow::FixedSizeBinaryType>(
     ColumnWriter* column_writer, const std::shared_ptr<Array>& array, int64_t num_levels,
     const int16_t* def_levels, const int16_t* rep_levels) {
   RETURN_NOT_OK(data_buffer_.Resize(array->length() * sizeof(FLBA), false));
@@ -778,17 +941,85 @@ Status FileWriter::Impl::TypedWriteBatch<FLBAType, ::arrow::FixedSizeBinaryType>
     PARQUET_CATCH_NOT_OK(
         writer->WriteBatch(num_levels, def_levels, rep_levels, buffer_ptr));
   }
-  PARQUET_CATCH_NOT_OK(writer->Close());
   return Status::OK();
 }
 
+// ----------------------------------------------------------------------
+// Write decimals
+
+// The values hold a slot for each decimal of data, nulls included
+template <typename ParquetType>
+static Status WriteDecimalValues(ColumnWriter* column_writer,
+                                 const FixedSizeBinaryArray& data, int64_t num_levels,
+                                 const int16_t* def_levels, const int16_t* rep_levels,
+                                 const typename ParquetType::c_type* values) {
+  auto writer = static_cast<TypedColumnWriter<ParquetType>*>(column_writer);
+  if (writer->descr()->schema_node()->is_required() || (data.null_count() == 0)) {
+    PARQUET_CATCH_NOT_OK(writer->WriteBatch(num_levels, def_levels, rep_levels, values));
+  } else {
+    PARQUET_CATCH_NOT_OK(writer->WriteBatchSpaced(num_levels, def_levels, rep_levels,
+                                                  data.null_bitmap_data(), data.offset(),
+                                                  values));
+  }
+  return Status::OK();
+}
+
+Status ArrowColumnWriter::WriteDecimals(ColumnWriter* column_writer,
+                                        const std::shared_ptr<Array>& values,
+                                        int64_t num_levels, const int16_t* def_levels,
+                                        const int16_t* rep_levels) {
+  const auto& data = static_cast<const FixedSizeBinaryArray&>(*values);
+  const int64_t length = data.length();
+  const uint8_t* decimals = data.GetValue(0);
+
+  // The null slots are converted too, rather than branching on the validity
+  // bitmap; WriteBatchSpaced skips them
+  switch (column_writer->type()) {
+    case ::parquet::Type::INT32: {
+      RETURN_NOT_OK(data_buffer_.Resize(length * sizeof(int32_t), false));
+      auto buffer_ptr = reinterpret_cast<int32_t*>(data_buffer_.mutable_data());
+      DecimalsToInts(decimals, length, buffer_ptr);
+      return WriteDecimalValues<Int32Type>(column_writer, data, num_levels, def_levels,
+                                           rep_levels, buffer_ptr);
+    }
+    case ::parquet::Type::INT64: {
+      RETURN_NOT_OK(data_buffer_.Resize(length * sizeof(int64_t), false));
+      auto buffer_ptr = reinterpret_cast<int64_t*>(data_buffer_.mutable_data());
+      DecimalsToInts(decimals, length, buffer_ptr);
+      return WriteDecimalValues<Int64Type>(column_writer, data, num_levels, def_levels,
+                                           rep_levels, buffer_ptr);
+    }
+    case ::parquet::Type::FIXED_LEN_BYTE_ARRAY: {
+      const int32_t width = column_writer->descr()->type_length();
+      if (width > kDecimalByteWidth) {
+        return Status::NotImplemented("Decimals wider than 16 bytes are not supported");
+      }
+      // The big-endian values are written consecutively, and referenced by
+      // the FLBAs in the data buffer
+      PoolBuffer bytes(pool_);
+      RETURN_NOT_OK(bytes.Resize(length * width, false));
+      DecimalsToBigEndian(decimals, length, width, bytes.mutable_data());
+      RETURN_NOT_OK(data_buffer_.Resize(length * sizeof(FLBA), false));
+      auto buffer_ptr = reinterpret_cast<FLBA*>(data_buffer_.mutable_data());
+      for (int64_t i = 0; i < length; i++) {
+        buffer_ptr[i] = FLBA(bytes.data() + i * width);
+      }
+      return WriteDecimalValues<FLBAType>(column_writer, data, num_levels, def_levels,
+                                          rep_levels, buffer_ptr);
+    }
+    default:
+      std::stringstream ss;
+      ss << "Cannot write decimals to " << TypeToString(column_writer->type())
+         << " columns";
+      return Status::NotImplemented(ss.str());
+  }
+}
+
 // End of column type specializations
 // ----------------------------------------------------------------------
 
 Status FileWriter::Impl::Close() {
-  if (row_group_writer_ != nullptr) {
-    PARQUET_CATCH_NOT_OK(row_group_writer_->Close());
-  }
+  RETURN_NOT_OK(CloseRowGroup());
   PARQUET_CATCH_NOT_OK(writer_->Close());
   return Status::OK();
 }
@@ -797,14 +1028,23 @@ Status FileWriter::NewRowGroup(int64_t chunk_size) {
   return impl_->NewRowGroup(chunk_size);
 }
 
-Status FileWriter::Impl::WriteColumnChunk(const Array& data) {
-  ColumnWriter* column_writer;
-  PARQUET_CATCH_NOT_OK(column_writer = row_group_writer_->NextColumn());
+Status ArrowColumnWriter::Write(int column_index, const Array& data,
+                                ColumnWriter* column_writer) {
+  RETURN_NOT_OK(Append(column_index, data, column_writer));
+  PARQUET_CATCH_NOT_OK(column_writer->Close());
+  return Status::OK();
+}
 
-  int current_column_idx = row_group_writer_->current_column();
+Status ArrowColumnWriter::Append(int column_index, const Array& data,
+                                 ColumnWriter* column_writer) {
   std::shared_ptr<::arrow::Schema> arrow_schema;
-  RETURN_NOT_OK(FromParquetSchema(writer_->schema(), {current_column_idx - 1},
-                                  writer_->key_value_metadata(), &arrow_schema));
+  RETURN_NOT_OK(FromParquetSchema(file_writer_->schema(), {column_index},
+                                  file_writer_->key_value_metadata(), &arrow_schema));
+  if (data.type_id() == ::arrow::Type::DICTIONARY) {
+    return WriteDictionaryArray(static_cast<const ::arrow::DictionaryArray&>(data),
+                                arrow_schema->field(0), column_writer);
+  }
+
   std::shared_ptr<Buffer> def_levels_buffer;
   std::shared_ptr<Buffer> rep_levels_buffer;
   int64_t values_offset;
@@ -835,7 +1075,7 @@ Status FileWriter::Impl::WriteColumnChunk(const Array& data) {
 
   switch (values_type) {
     case ::arrow::Type::UINT32: {
-      if (writer_->properties()->version() == ParquetVersion::PARQUET_1_0) {
+      if (file_writer_->properties()->version() == ParquetVersion::PARQUET_1_0) {
         // Parquet 1.0 reader cannot read the UINT_32 logical type. Thus we need
         // to use the larger Int64Type to store them lossless.
         return TypedWriteBatch<Int64Type, ::arrow::UInt32Type>(
@@ -849,6 +1089,9 @@ Status FileWriter::Impl::WriteColumnChunk(const Array& data) {
     case ::arrow::Type::TIMESTAMP:
       return WriteTimestamps(column_writer, values_array, num_levels, def_levels,
                              rep_levels);
+    case ::arrow::Type::DECIMAL:
+      return WriteDecimals(column_writer, values_array, num_levels, def_levels,
+                           rep_levels);
       WRITE_BATCH_CASE(BOOL, BooleanType, BooleanType)
       WRITE_BATCH_CASE(INT8, Int8Type, Int32Type)
       WRITE_BATCH_CASE(UINT8, UInt8Type, Int32Type)
@@ -871,9 +1114,189 @@ Status FileWriter::Impl::WriteColumnChunk(const Array& data) {
       ss << "Data type not supported as list value: " << values_array->type()->ToString();
       return Status::NotImplemented(ss.str());
   }
+}
 
-  PARQUET_CATCH_NOT_OK(column_writer->Close());
+// Copy the indices of the non-null entries into out, and set num_indices to
+// their number. The indices must be valid positions of the dictionary.
+template <typename ArrowIndexType>
+static Status DenseIndices(const Array& indices, int64_t dictionary_length,
+                           int32_t* out, int64_t* num_indices) {
+  auto values = static_cast<const NumericArray<ArrowIndexType>&>(indices).raw_values();
+  *num_indices = 0;
+  for (int64_t i = 0; i < indices.length(); i++) {
+    if (!indices.IsNull(i)) {
+      if (values[i] < 0 || static_cast<int64_t>(values[i]) >= dictionary_length) {
+        std::stringstream ss;
+        ss << "Dictionary index " << static_cast<int64_t>(values[i])
+           << " is out of range for a dictionary of length " << dictionary_length;
+        return Status::Invalid(ss.str());
+      }
+      out[(*num_indices)++] = static_cast<int32_t>(values[i]);
+    }
+  }
+  return Status::OK();
+}
 
+template <typename ParquetType>
+static Status WriteIndices(ColumnWriter* column_writer, int64_t num_levels,
+                           const int16_t* def_levels, const int16_t* rep_levels,
+                           int64_t num_indices, const int32_t* indices,
+                           int64_t dictionary_length,
+                           const typename ParquetType::c_type* dictionary) {
+  auto writer = static_cast<TypedColumnWriter<ParquetType>*>(column_writer);
+  PARQUET_CATCH_NOT_OK(writer->WriteBatchIndices(num_levels, def_levels, rep_levels,
+                                                 num_indices, indices,
+                                                 dictionary_length, dictionary));
+  return Status::OK();
+}
+
+Status ArrowColumnWriter::WriteDictionaryArray(const ::arrow::DictionaryArray& data,
+                                               const std::shared_ptr<Field>& field,
+                                               ColumnWriter* column_writer) {
+  std::shared_ptr<Array> dictionary = data.dictionary();
+  if (field->type()->num_children() > 0) {
+    return Status::NotImplemented("Nested dictionary arrays are not supported");
+  }
+  if (dictionary->null_count() > 0) {
+    return Status::NotImplemented("Dictionaries with null entries are not supported");
+  }
+
+  // The levels of the array are the ones of its indices
+  std::shared_ptr<Buffer> def_levels_buffer;
+  std::shared_ptr<Buffer> rep_levels_buffer;
+  int64_t values_offset;
+  ::arrow::Type::type values_type;
+  int64_t num_levels;
+  int64_t num_values;
+  std::shared_ptr<Array> indices_array;
+  LevelBuilder level_builder(pool_);
+  RETURN_NOT_OK(level_builder.GenerateLevels(
+      *data.indices(), field, &values_offset, &values_type, &num_values, &num_levels,
+      &def_levels_buffer, &rep_levels_buffer, &indices_array));
+  const int16_t* def_levels = nullptr;
+  if (def_levels_buffer) {
+    def_levels = reinterpret_cast<const int16_t*>(def_levels_buffer->data());
+  }
+
+  RETURN_NOT_OK(data_buffer_.Resize(data.length() * sizeof(int32_t)));
+  auto indices = reinterpret_cast<int32_t*>(data_buffer_.mutable_data());
+  const Array& index_values = *data.indices();
+  int64_t num_indices;
+  switch (index_values.type_id()) {
+    case ::arrow::Type::INT8:
+      RETURN_NOT_OK(DenseIndices<::arrow::Int8Type>(index_values, dictionary->length(),
+                                                    indices, &num_indices));
+      break;
+    case ::arrow::Type::INT16:
+      RETURN_NOT_OK(DenseIndices<::arrow::Int16Type>(index_values, dictionary->length(),
+                                                     indices, &num_indices));
+      break;
+    case ::arrow::Type::INT32:
+      RETURN_NOT_OK(DenseIndices<::arrow::Int32Type>(index_values, dictionary->length(),
+                                                     indices, &num_indices));
+      break;
+    case ::arrow::Type::INT64:
+      RETURN_NOT_OK(DenseIndices<::arrow::Int64Type>(index_values, dictionary->length(),
+                                                     indices, &num_indices));
+      break;
+    default:
+      return Status::NotImplemented("Dictionary indices must be signed integers");
+  }
+
+#define WRITE_INDICES_CASE(ArrowEnum, ArrowType, ParquetType)                 \
+  case ::arrow::Type::ArrowEnum:                                              \
+    return WriteIndices<ParquetType>(                                         \
+        column_writer, num_levels, def_levels, nullptr, num_indices, indices, \
+        dictionary->length(),                                                 \
+        static_cast<const ::arrow::ArrowType##Array&>(*dictionary).raw_values());
+
+  switch (dictionary->type_id()) {
+    WRITE_INDICES_CASE(INT32, Int32, Int32Type)
+    WRITE_INDICES_CASE(INT64, Int64, Int64Type)
+    WRITE_INDICES_CASE(FLOAT, Float, FloatType)
+    WRITE_INDICES_CASE(DOUBLE, Double, DoubleType)
+    case ::arrow::Type::BINARY:
+    case ::arrow::Type::STRING: {
+      auto binary = static_cast<const BinaryArray*>(dictionary.get());
+      const uint8_t* data_ptr = nullptr;
+      if (binary->value_data()) {
+        data_ptr = binary->value_data()->data();
+      }
+      const int32_t* value_offset = binary->raw_value_offsets();
+      std::vector<ByteArray> values(binary->length());
+      for (int64_t i = 0; i < binary->length(); i++) {
+        values[i] =
+            ByteArray(value_offset[i + 1] - value_offset[i], data_ptr + value_offset[i]);
+      }
+      return WriteIndices<ByteArrayType>(column_writer, num_levels, def_levels, nullptr,
+                                         num_indices, indices, binary->length(),
+                                         values.data());
+    }
+    default:
+      std::stringstream ss;
+      ss << "Dictionary arrays with values of type " << dictionary->type()->ToString()
+         << " are not supported";
+      return Status::NotImplemented(ss.str());
+  }
+}
+
+Status FileWriter::Impl::WriteColumnChunk(const Array& data) {
+  if (row_group_writer_ == nullptr) {
+    return Status::Invalid("No row group is open, NewRowGroup must be called first");
+  }
+  ColumnWriter* column_writer;
+  PARQUET_CATCH_NOT_OK(column_writer = row_group_writer_->NextColumn());
+  return column_writer_.Write(row_group_writer_->current_column() - 1, data,
+                              column_writer);
+}
+
+Status FileWriter::Impl::WriteRowGroupParallel(const Table& table, int64_t offset,
+                                               int64_t size) {
+  RETURN_NOT_OK(CloseRowGroup());
+  PARQUET_CATCH_NOT_OK(row_group_writer_ = writer_->AppendBufferedRowGroup(size));
+
+  auto WriteColumnFunc = [&table, offset, size, this](int i) {
+    ColumnWriter* column_writer;
+    PARQUET_CATCH_NOT_OK(column_writer = row_group_writer_->column(i));
+    std::shared_ptr<Array> array = table.column(i)->data()->chunk(0);
+    array = array->Slice(offset, size);
+    // Each task converts the values into its own buffer
+    ArrowColumnWriter writer(pool_, writer_.get(), arrow_properties_);
+    return writer.Write(i, *array, column_writer);
+  };
+
+  int num_columns = table.num_columns();
+  int nthreads = std::min<int>(num_threads_, num_columns);
+  return ParallelFor(thread_pool_.get(), nthreads, num_columns, WriteColumnFunc);
+}
+
+Status FileWriter::Impl::WriteRecordBatch(const RecordBatch& batch) {
+  if (batch.num_columns() != writer_->num_columns()) {
+    std::stringstream ss;
+    ss << "The batch has " << batch.num_columns() << " columns, the file has "
+       << writer_->num_columns();
+    return Status::Invalid(ss.str());
+  }
+
+  int64_t max_rows = properties().max_row_group_length();
+  for (int64_t offset = 0, size = 0; offset < batch.num_rows(); offset += size) {
+    if (!appending_) {
+      RETURN_NOT_OK(CloseRowGroup());
+      PARQUET_CATCH_NOT_OK(row_group_writer_ = writer_->AppendBufferedRowGroup());
+      appending_ = true;
+    }
+    // Split the batch where the row group reaches max_row_group_length
+    size = std::min(batch.num_rows() - offset, max_rows - row_group_writer_->num_rows());
+    for (int i = 0; i < batch.num_columns(); i++) {
+      ColumnWriter* column_writer;
+      PARQUET_CATCH_NOT_OK(column_writer = row_group_writer_->column(i));
+      std::shared_ptr<Array> array = batch.column(i)->Slice(offset, size);
+      RETURN_NOT_OK(column_writer_.Append(i, *array, column_writer));
+    }
+    if (AppendedRowGroupFull()) {
+      RETURN_NOT_OK(CloseRowGroup());
+    }
+  }
   return Status::OK();
 }
 
@@ -881,8 +1304,18 @@ Status FileWriter::WriteColumnChunk(const ::arrow::Array& array) {
   return impl_->WriteColumnChunk(array);
 }
 
+Status FileWriter::WriteRecordBatch(const ::arrow::RecordBatch& batch) {
+  return impl_->WriteRecordBatch(batch);
+}
+
 Status FileWriter::Close() { return impl_->Close(); }
 
+void FileWriter::set_num_threads(int num_threads) { impl_->num_threads_ = num_threads; }
+
+void FileWriter::set_thread_pool(const std::shared_ptr<ThreadPool>& thread_pool) {
+  impl_->thread_pool_ = thread_pool;
+}
+
 MemoryPool* FileWriter::memory_pool() const { return impl_->pool_; }
 
 FileWriter::~FileWriter() {}
@@ -933,6 +1366,34 @@ Status FileWriter::Open(const ::arrow::Schema& schema, ::arrow::MemoryPool* pool
   return Open(schema, pool, wrapper, properties, arrow_properties, writer);
 }
 
+// Size in bytes of the buffers of the array and of its children
+template <typename ArrayDataType>
+static int64_t ArrayDataSize(const ArrayDataType& data) {
+  int64_t size = 0;
+  for (const auto& buffer : data.buffers) {
+    if (buffer != nullptr) {
+      size += buffer->size();
+    }
+  }
+  for (const auto& child : data.child_data) {
+    size += ArrayDataSize(*child);
+  }
+  return size;
+}
+
+// Average size in bytes of a row of the table in memory
+static double ArrowBytesPerRow(const Table& table) {
+  double bytes_per_row = 0;
+  for (int i = 0; i < table.num_columns(); i++) {
+    std::shared_ptr<Array> array = table.column(i)->data()->chunk(0);
+    if (array->length() > 0) {
+      bytes_per_row += static_cast<double>(ArrayDataSize(*array->data())) /
+                       static_cast<double>(array->length());
+    }
+  }
+  return bytes_per_row;
+}
+
 Status FileWriter::WriteTable(const Table& table, int64_t chunk_size) {
   // TODO(ARROW-232) Support writing chunked arrays.
   for (int i = 0; i < table.num_columns(); i++) {
@@ -947,9 +1408,20 @@ Status FileWriter::WriteTable(const Table& table, int64_t chunk_size) {
     chunk_size = impl_->properties().max_row_group_length();
   }
 
-  for (int chunk = 0; chunk * chunk_size < table.num_rows(); chunk++) {
-    int64_t offset = chunk * chunk_size;
-    int64_t size = std::min(chunk_size, table.num_rows() - offset);
+  int64_t max_bytes = impl_->properties().max_row_group_bytes();
+  double arrow_bytes_per_row = max_bytes > 0 ? ArrowBytesPerRow(table) : 0;
+
+  for (int64_t offset = 0, size = 0; offset < table.num_rows(); offset += size) {
+    size = std::min(chunk_size, table.num_rows() - offset);
+    if (max_bytes > 0) {
+      size = std::min(size, impl_->RowGroupLength(max_bytes, arrow_bytes_per_row));
+    }
+
+    if (impl_->num_threads_ > 1 && table.num_columns() > 1) {
+      RETURN_NOT_OK_ELSE(impl_->WriteRowGroupParallel(table, offset, size),
+                         PARQUET_IGNORE_NOT_OK(Close()));
+      continue;
+    }
 
     RETURN_NOT_OK_ELSE(NewRowGroup(size), PARQUET_IGNORE_NOT_OK(Close()));
     for (int i = 0; i < table.num_columns(); i++) {
@@ -18,6 +18,7 @@
 #ifndef PARQUET_ARROW_WRITER_H
 #define PARQUET_ARROW_WRITER_H
 
+#include <cstring>
 #include <memory>
 
 #include "parquet/api/schema.h"
@@ -31,6 +32,7 @@ namespace arrow {
 class Array;
 class MemoryPool;
 class PrimitiveArray;
+class RecordBatch;
 class RowBatch;
 class Schema;
 class Status;
@@ -39,6 +41,9 @@ class Table;
 }  // namespace arrow
 
 namespace parquet {
+
+class ThreadPool;
+
 namespace arrow {
 
 class PARQUET_EXPORT ArrowWriterProperties {
@@ -137,13 +142,42 @@ class PARQUET_EXPORT FileWriter {
    * Write a Table to Parquet.
    *
    * The table shall only consist of columns of primitive type or of primitive lists.
+   *
+   * Each row group holds at most chunk_size rows. If max_row_group_bytes is set in
+   * the WriterProperties, row groups are also closed once they are about that large.
    */
   ::arrow::Status WriteTable(const ::arrow::Table& table, int64_t chunk_size);
 
   ::arrow::Status NewRowGroup(int64_t chunk_size);
   ::arrow::Status WriteColumnChunk(const ::arrow::Array& data);
+
+  /**
+   * Append a RecordBatch to the open row group, starting one if needed.
+   *
+   * The column writers stay open across calls, so that consecutive small
+   * batches end up in the same row group. The row group is closed once it
+   * holds max_row_group_length rows, once its buffered pages reach
+   * max_row_group_bytes if set, or once the memory budget of the
+   * WriterProperties is exceeded and it holds min_row_group_length rows.
+   * Larger batches are split across row groups.
+   * NewRowGroup and Close close a partially filled row group.
+   *
+   * The columns of the batch shall be in the order of the schema, of primitive
+   * type or primitive lists.
+   */
+  ::arrow::Status WriteRecordBatch(const ::arrow::RecordBatch& batch);
+
   ::arrow::Status Close();
 
+  /// Set the number of threads used by WriteTable. By default only 1 thread is
+  /// used. With more threads, the column chunks of each row group are encoded
+  /// and compressed in parallel into memory and then written in schema order.
+  void set_num_threads(int num_threads);
+
+  /// Set the pool on which the threads of WriteTable are scheduled. By default
+  /// the process-wide ThreadPool::Default() is used
+  void set_thread_pool(const std::shared_ptr<ThreadPool>& thread_pool);
+
   virtual ~FileWriter();
 
   ::arrow::MemoryPool* memory_pool() const;
@@ -193,6 +227,23 @@ inline void NanosecondsToImpalaTimestamp(const int64_t nanoseconds,
   *impala_last_day_nanos = last_day_nanos;
 }
 
+/**
+ * Converts a batch of nanosecond timestamps to Impala (Int96) format. Each
+ * value is stored with a single memcpy, which unlike stores through an
+ * int64_t pointer cannot alias the input.
+ */
+inline void NanosecondsToImpalaTimestamps(const int64_t* nanoseconds, int64_t length,
+                                          Int96* impala_timestamps) {
+  for (int64_t i = 0; i < length; ++i) {
+    int64_t julian_days = (nanoseconds[i] / kNanosecondsPerDay) + kJulianEpochOffsetDays;
+    int64_t last_day_nanos = nanoseconds[i] % kNanosecondsPerDay;
+    uint32_t value[3];
+    memcpy(value, &last_day_nanos, sizeof(int64_t));
+    value[2] = static_cast<uint32_t>(julian_days);
+    memcpy(impala_timestamps[i].value, value, sizeof(value));
+  }
+}
+
 }  // namespace internal
 
 }  // namespace arrow
@@ -0,0 +1,224 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "parquet/bloom_filter.h"
+#include "parquet/column_reader.h"
+#include "parquet/column_writer.h"
+#include "parquet/file/reader.h"
+#include "parquet/file/writer.h"
+#include "parquet/schema.h"
+#include "parquet/types.h"
+#include "parquet/util/memory.h"
+
+namespace parquet {
+
+using schema::GroupNode;
+using schema::NodePtr;
+using schema::PrimitiveNode;
+
+namespace test {
+
+static ByteArray ToByteArray(const std::string& s) {
+  return ByteArray(static_cast<uint32_t>(s.size()),
+                   reinterpret_cast<const uint8_t*>(s.data()));
+}
+
+TEST(BloomFilter, XxHash64) {
+  ASSERT_EQ(0xEF46DB3751D8E999ULL, BloomFilter::Hash(ToByteArray("")));
+  ASSERT_EQ(0x44BC2CF5AD770999ULL, BloomFilter::Hash(ToByteArray("abc")));
+
+  // Plain encoding: little-endian values, the raw bytes of byte arrays
+  int64_t value = 0x0102030405060708LL;
+  std::string bytes(reinterpret_cast<const char*>(&value), sizeof(value));
+  ASSERT_EQ(BloomFilter::Hash(ToByteArray(bytes)), BloomFilter::Hash(value));
+  FLBA flba(reinterpret_cast<const uint8_t*>(bytes.data()));
+  ASSERT_EQ(BloomFilter::Hash(value), BloomFilter::Hash(flba, 8));
+}
+
+TEST(BloomFilter, NumOfBytes) {
+  ASSERT_EQ(BloomFilter::kMinimumBytes, BloomFilter(0).num_bytes());
+  ASSERT_EQ(1024U, BloomFilter(1000).num_bytes());
+  ASSERT_EQ(BloomFilter::kMaximumBytes,
+            BloomFilter(BloomFilter::kMaximumBytes + 1).num_bytes());
+
+  ASSERT_EQ(BloomFilter::kMinimumBytes, BloomFilter::OptimalNumOfBytes(0, 0.01));
+  ASSERT_EQ(BloomFilter::kMaximumBytes,
+            BloomFilter::OptimalNumOfBytes(int64_t(1) << 40, 0.01));
+  uint32_t num_bytes = BloomFilter::OptimalNumOfBytes(100000, 0.01);
+  ASSERT_EQ(0U, num_bytes & (num_bytes - 1));
+  ASSERT_LT(BloomFilter::OptimalNumOfBytes(100000, 0.1), num_bytes);
+  ASSERT_GT(BloomFilter::OptimalNumOfBytes(1000000, 0.01), num_bytes);
+  ASSERT_THROW(BloomFilter::OptimalNumOfBytes(10, 1.5), ParquetException);
+}
+
+TEST(BloomFilter, InsertAndFind) {
+  const int ndv = 10000;
+  BloomFilter filter(BloomFilter::OptimalNumOfBytes(ndv, 0.01));
+  for (int32_t i = 0; i < ndv; ++i) {
+    filter.InsertHash(BloomFilter::Hash(i));
+  }
+  for (int32_t i = 0; i < ndv; ++i) {
+    ASSERT_TRUE(filter.FindHash(BloomFilter::Hash(i)));
+  }
+  int false_positives = 0;
+  for (int32_t i = ndv; i < 2 * ndv; ++i) {
+    false_positives += filter.FindHash(BloomFilter::Hash(i));
+  }
+  // The expected rate is 1%
+  ASSERT_LT(false_positives, ndv / 20);
+}
+
+TEST(BloomFilter, SerializeRoundTrip) {
+  BloomFilter filter(256);
+  for (int64_t i = 0; i < 100; ++i) {
+    filter.InsertHash(BloomFilter::Hash(i * 7));
+  }
+  InMemoryOutputStream sink;
+  int64_t length = filter.WriteTo(&sink);
+  std::shared_ptr<Buffer> buffer = sink.GetBuffer();
+  ASSERT_EQ(length, buffer->size());
+
+  uint32_t header_length = static_cast<uint32_t>(buffer->size());
+  ASSERT_EQ(256U, BloomFilter::DeserializeHeader(buffer->data(), &header_length));
+  ASSERT_EQ(length, header_length + 256);
+
+  uint32_t read_length = static_cast<uint32_t>(buffer->size());
+  std::unique_ptr<BloomFilter> result =
+      BloomFilter::Deserialize(buffer->data(), &read_length);
+  ASSERT_EQ(length, read_length);
+  ASSERT_EQ(256U, result->num_bytes());
+  for (int64_t i = 0; i < 100; ++i) {
+    ASSERT_TRUE(result->FindHash(BloomFilter::Hash(i * 7)));
+  }
+
+  uint32_t truncated_length = static_cast<uint32_t>(buffer->size()) - 1;
+  ASSERT_THROW(BloomFilter::Deserialize(buffer->data(), &truncated_length),
+               ParquetException);
+}
+
+TEST(BloomFilter, WriteAndProbeColumnChunks) {
+  const int num_rows = 10000;
+  NodePtr schema = GroupNode::Make(
+      "schema", Repetition::REQUIRED,
+      {PrimitiveNode::Make("dictionary", Repetition::REQUIRED, Type::BYTE_ARRAY),
+       PrimitiveNode::Make("fallback", Repetition::REQUIRED, Type::INT32),
+       PrimitiveNode::Make("plain", Repetition::OPTIONAL, Type::INT64),
+       PrimitiveNode::Make("none", Repetition::REQUIRED, Type::INT32)});
+
+  std::shared_ptr<WriterProperties> properties = WriterProperties::Builder()
+                                                     .dictionary_pagesize_limit(1024)
+                                                     ->disable_dictionary("plain")
+                                                     ->enable_bloom_filter("dictionary")
+                                                     ->enable_bloom_filter("fallback")
+                                                     ->enable_bloom_filter("plain")
+                                                     ->build();
+
+  std::shared_ptr<InMemoryOutputStream> sink(new InMemoryOutputStream());
+  auto file_writer = ParquetFileWriter::Open(
+      sink, std::static_pointer_cast<GroupNode>(schema), properties);
+  auto row_group_writer = file_writer->AppendRowGroup(num_rows);
+
+  std::vector<std::string> strings;
+  std::vector<ByteArray> byte_arrays;
+  for (int i = 0; i < num_rows; ++i) {
+    strings.push_back("key-" + std::to_string(i % 50));
+  }
+  for (const std::string& s : strings) {
+    byte_arrays.push_back(ToByteArray(s));
+  }
+  static_cast<ByteArrayWriter*>(row_group_writer->NextColumn())
+      ->WriteBatch(num_rows, nullptr, nullptr, byte_arrays.data());
+
+  std::vector<int32_t> ints(num_rows);
+  for (int i = 0; i < num_rows; ++i) {
+    ints[i] = i;
+  }
+  static_cast<Int32Writer*>(row_group_writer->NextColumn())
+      ->WriteBatch(num_rows, nullptr, nullptr, ints.data());
+
+  // Every third value is null
+  std::vector<int16_t> def_levels(num_rows);
+  std::vector<int64_t> longs;
+  for (int i = 0; i < num_rows; ++i) {
+    def_levels[i] = i % 3 != 0;
+    if (def_levels[i]) {
+      longs.push_back(i);
+    }
+  }
+  static_cast<Int64Writer*>(row_group_writer->NextColumn())
+      ->WriteBatch(num_rows, def_levels.data(), nullptr, longs.data());
+
+  static_cast<Int32Writer*>(row_group_writer->NextColumn())
+      ->WriteBatch(num_rows, nullptr, nullptr, ints.data());
+  row_group_writer->Close();
+  file_writer->Close();
+
+  auto source = std::make_shared<::arrow::io::BufferReader>(sink->GetBuffer());
+  auto file_reader = ParquetFileReader::Open(source);
+  auto rg_reader = file_reader->RowGroup(0);
+  const ColumnDescriptor* descr = rg_reader->metadata()->schema()->Column(0);
+
+  std::unique_ptr<BloomFilter> filter = rg_reader->GetBloomFilter(0);
+  ASSERT_NE(nullptr, filter);
+  // Sized for the 50 distinct values of the dictionary
+  ASSERT_LE(filter->num_bytes(), 1024U);
+  for (int i = 0; i < 50; ++i) {
+    ASSERT_TRUE(filter->FindHash(BloomFilterHash<ByteArrayType>(descr, byte_arrays[i])));
+  }
+  int false_positives = 0;
+  for (int i = 50; i < 1050; ++i) {
+    std::string absent = "key-" + std::to_string(i);
+    false_positives +=
+        filter->FindHash(BloomFilterHash<ByteArrayType>(descr, ToByteArray(absent)));
+  }
+  ASSERT_LT(false_positives, 200);
+
+  // Values from both before and after the dictionary fallback
+  filter = rg_reader->GetBloomFilter(1);
+  ASSERT_NE(nullptr, filter);
+  ASSERT_TRUE(rg_reader->metadata()->ColumnChunk(1)->has_dictionary_page());
+  for (int i = 0; i < num_rows; ++i) {
+    ASSERT_TRUE(filter->FindHash(BloomFilter::Hash(ints[i])));
+  }
+
+  filter = rg_reader->GetBloomFilter(2);
+  ASSERT_NE(nullptr, filter);
+  for (int64_t value : longs) {
+    ASSERT_TRUE(filter->FindHash(BloomFilter::Hash(value)));
+  }
+
+  ASSERT_FALSE(rg_reader->metadata()->ColumnChunk(3)->has_bloom_filter());
+  ASSERT_EQ(nullptr, rg_reader->GetBloomFilter(3));
+
+  // The chunks are still readable
+  auto reader = std::static_pointer_cast<Int32Reader>(rg_reader->Column(3));
+  std::vector<int32_t> values_out(num_rows);
+  int64_t values_read;
+  reader->ReadBatch(num_rows, nullptr, nullptr, values_out.data(), &values_read);
+  ASSERT_EQ(num_rows, values_read);
+  ASSERT_EQ(ints, values_out);
+}
+
+}  // namespace test
+
+}  // namespace parquet
@@ -0,0 +1,256 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+#include "parquet/bloom_filter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <sstream>
+
+#include "parquet/exception.h"
+#include "parquet/parquet_types.h"
+#include "parquet/thrift.h"
+
+namespace parquet {
+
+constexpr uint32_t BloomFilter::kBytesPerBlock;
+constexpr uint32_t BloomFilter::kMinimumBytes;
+constexpr uint32_t BloomFilter::kMaximumBytes;
+
+namespace {
+
+// Salts of the block insert and check, from the Parquet format specification
+constexpr uint32_t kSalt[8] = {0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+                               0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+
+// ----------------------------------------------------------------------
+// xxHash64, see https://github.com/Cyan4973/xxHash
+
+constexpr uint64_t kPrime1 = 11400714785074694791ULL;
+constexpr uint64_t kPrime2 = 14029467366897019727ULL;
+constexpr uint64_t kPrime3 = 1609587929392839161ULL;
+constexpr uint64_t kPrime4 = 9650029242287828579ULL;
+constexpr uint64_t kPrime5 = 2870177450012600261ULL;
+
+inline uint64_t RotateLeft(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+inline uint64_t Read64(const uint8_t* p) {
+  uint64_t v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+inline uint32_t Read32(const uint8_t* p) {
+  uint32_t v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+inline uint64_t Round(uint64_t acc, uint64_t input) {
+  acc += input * kPrime2;
+  acc = RotateLeft(acc, 31);
+  return acc * kPrime1;
+}
+
+inline uint64_t MergeRound(uint64_t acc, uint64_t val) {
+  acc ^= Round(0, val);
+  return acc * kPrime1 + kPrime4;
+}
+
+uint64_t XxHash64(const uint8_t* data, size_t len) {
+  const uint64_t seed = 0;
+  const uint8_t* p = data;
+  const uint8_t* end = data + len;
+  uint64_t h;
+
+  if (len >= 32) {
+    const uint8_t* limit = end - 32;
+    uint64_t v1 = seed + kPrime1 + kPrime2;
+    uint64_t v2 = seed + kPrime2;
+    uint64_t v3 = seed;
+    uint64_t v4 = seed - kPrime1;
+    do {
+      v1 = Round(v1, Read64(p));
+      v2 = Round(v2, Read64(p + 8));
+      v3 = Round(v3, Read64(p + 16));
+      v4 = Round(v4, Read64(p + 24));
+      p += 32;
+    } while (p <= limit);
+    h = RotateLeft(v1, 1) + RotateLeft(v2, 7) + RotateLeft(v3, 12) + RotateLeft(v4, 18);
+    h = MergeRound(h, v1);
+    h = MergeRound(h, v2);
+    h = MergeRound(h, v3);
+    h = MergeRound(h, v4);
+  } else {
+    h = seed + kPrime5;
+  }
+
+  h += static_cast<uint64_t>(len);
+
+  while (p + 8 <= end) {
+    h ^= Round(0, Read64(p));
+    h = RotateLeft(h, 27) * kPrime1 + kPrime4;
+    p += 8;
+  }
+  if (p + 4 <= end) {
+    h ^= static_cast<uint64_t>(Read32(p)) * kPrime1;
+    h = RotateLeft(h, 23) * kPrime2 + kPrime3;
+    p += 4;
+  }
+  while (p < end) {
+    h ^= (*p) * kPrime5;
+    h = RotateLeft(h, 11) * kPrime1;
+    ++p;
+  }
+
+  h ^= h >> 33;
+  h *= kPrime2;
+  h ^= h >> 29;
+  h *= kPrime3;
+  h ^= h >> 32;
+  return h;
+}
+
+uint32_t RoundNumOfBytes(uint64_t num_bytes) {
+  uint64_t rounded = BloomFilter::kMinimumBytes;
+  while (rounded < num_bytes && rounded < BloomFilter::kMaximumBytes) {
+    rounded <<= 1;
+  }
+  return static_cast<uint32_t>(rounded);
+}
+
+}  // namespace
+
+BloomFilter::BloomFilter(uint32_t num_bytes, ::arrow::MemoryPool* pool)
+    : num_bytes_(RoundNumOfBytes(num_bytes)), bitset_(AllocateBuffer(pool, num_bytes_)) {
+  memset(bitset_->mutable_data(), 0, num_bytes_);
+}
+
+uint32_t BloomFilter::DeserializeHeader(const uint8_t* serialized, uint32_t* len) {
+  format::BloomFilterHeader header;
+  DeserializeThriftMsg(serialized, len, &header);
+  if (!header.algorithm.__isset.BLOCK || !header.hash.__isset.XXHASH ||
+      !header.compression.__isset.UNCOMPRESSED) {
+    throw ParquetException("Unsupported Bloom filter algorithm, hash or compression");
+  }
+  uint32_t num_bytes = static_cast<uint32_t>(header.numBytes);
+  if (header.numBytes <= 0 || num_bytes < kMinimumBytes || num_bytes > kMaximumBytes ||
+      (num_bytes & (num_bytes - 1)) != 0) {
+    std::stringstream ss;
+    ss << "Invalid Bloom filter size: " << header.numBytes;
+    throw ParquetException(ss.str());
+  }
+  return num_bytes;
+}
+
+std::unique_ptr<BloomFilter> BloomFilter::Deserialize(const uint8_t* serialized,
+                                                      uint32_t* len,
+                                                      ::arrow::MemoryPool* pool) {
+  uint32_t header_len = *len;
+  uint32_t num_bytes = DeserializeHeader(serialized, &header_len);
+  if (*len - header_len < num_bytes) {
+    throw ParquetException("Bloom filter bitset is truncated");
+  }
+  std::unique_ptr<BloomFilter> filter(new BloomFilter(num_bytes, pool));
+  memcpy(filter->bitset_->mutable_data(), serialized + header_len, num_bytes);
+  *len = header_len + num_bytes;
+  return filter;
+}
+
+uint32_t BloomFilter::OptimalNumOfBytes(int64_t ndv, double fpp) {
+  if (ndv <= 0) {
+    return kMinimumBytes;
+  }
+  if (!(fpp > 0.0 && fpp < 1.0)) {
+    throw ParquetException("Bloom filter false positive probability must be in (0, 1)");
+  }
+  // Eight bits are set per value, one in each word of a block
+  double num_bits =
+      -8.0 * static_cast<double>(ndv) / std::log(1 - std::pow(fpp, 1.0 / 8));
+  double num_bytes = std::ceil(num_bits / 8);
+  if (num_bytes >= kMaximumBytes) {
+    return kMaximumBytes;
+  }
+  return RoundNumOfBytes(static_cast<uint64_t>(num_bytes));
+}
+
+uint64_t BloomFilter::Hash(int32_t value) {
+  return XxHash64(reinterpret_cast<const uint8_t*>(&value), sizeof(value));
+}
+
+uint64_t BloomFilter::Hash(int64_t value) {
+  return XxHash64(reinterpret_cast<const uint8_t*>(&value), sizeof(value));
+}
+
+uint64_t BloomFilter::Hash(const Int96& value) {
+  return XxHash64(reinterpret_cast<const uint8_t*>(value.value), sizeof(value.value));
+}
+
+uint64_t BloomFilter::Hash(float value) {
+  return XxHash64(reinterpret_cast<const uint8_t*>(&value), sizeof(value));
+}
+
+uint64_t BloomFilter::Hash(double value) {
+  return XxHash64(reinterpret_cast<const uint8_t*>(&value), sizeof(value));
+}
+
+uint64_t BloomFilter::Hash(const ByteArray& value) {
+  return XxHash64(value.ptr, value.len);
+}
+
+uint64_t BloomFilter::Hash(const FLBA& value, int type_length) {
+  return XxHash64(value.ptr, type_length);
+}
+
+void BloomFilter::InsertHash(uint64_t hash) {
+  uint32_t num_blocks = num_bytes_ / kBytesPerBlock;
+  uint32_t block_index = static_cast<uint32_t>(((hash >> 32) * num_blocks) >> 32);
+  uint32_t key = static_cast<uint32_t>(hash);
+  uint32_t* block =
+      reinterpret_cast<uint32_t*>(bitset_->mutable_data()) + block_index * 8;
+  for (int i = 0; i < 8; ++i) {
+    block[i] |= 1U << ((key * kSalt[i]) >> 27);
+  }
+}
+
+bool BloomFilter::FindHash(uint64_t hash) const {
+  uint32_t num_blocks = num_bytes_ / kBytesPerBlock;
+  uint32_t block_index = static_cast<uint32_t>(((hash >> 32) * num_blocks) >> 32);
+  uint32_t key = static_cast<uint32_t>(hash);
+  const uint32_t* block =
+      reinterpret_cast<const uint32_t*>(bitset_->data()) + block_index * 8;
+  for (int i = 0; i < 8; ++i) {
+    if ((block[i] & (1U << ((key * kSalt[i]) >> 27))) == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int64_t BloomFilter::WriteTo(OutputStream* sink) const {
+  format::BloomFilterHeader header;
+  header.__set_numBytes(static_cast<int32_t>(num_bytes_));
+  header.algorithm.__set_BLOCK(format::SplitBlockAlgorithm());
+  header.hash.__set_XXHASH(format::XxHash());
+  header.compression.__set_UNCOMPRESSED(format::Uncompressed());
+  int64_t header_size =
+      SerializeThriftMsg(&header, sizeof(format::BloomFilterHeader), sink);
+  sink->Write(bitset_->data(), num_bytes_);
+  return header_size + num_bytes_;
+}
+
+}  // namespace parquet
@@ -0,0 +1,97 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+#ifndef PARQUET_BLOOM_FILTER_H
+#define PARQUET_BLOOM_FILTER_H
+
+#include <cstdint>
+#include <memory>
+
+#include "parquet/schema.h"
+#include "parquet/types.h"
+#include "parquet/util/memory.h"
+#include "parquet/util/visibility.h"
+
+namespace parquet {
+
+// The split block Bloom filter of the Parquet format. The bitset is made of
+// 32-byte blocks, every inserted hash sets one bit in each of the eight 32-bit
+// words of a single block. Values are hashed with xxHash64 (seed 0) over their
+// plain encoding, without the length prefix for BYTE_ARRAY.
+class PARQUET_EXPORT BloomFilter {
+ public:
+  static constexpr uint32_t kBytesPerBlock = 32;
+  static constexpr uint32_t kMinimumBytes = kBytesPerBlock;
+  static constexpr uint32_t kMaximumBytes = 128 * 1024 * 1024;
+
+  // An empty filter. num_bytes is rounded up to a power of two within
+  // [kMinimumBytes, kMaximumBytes]
+  explicit BloomFilter(uint32_t num_bytes,
+                       ::arrow::MemoryPool* pool = ::arrow::default_memory_pool());
+
+  // Deserialize a BloomFilterHeader and the bitset following it. On input len
+  // is the number of bytes available, on output the number of bytes read.
+  static std::unique_ptr<BloomFilter> Deserialize(
+      const uint8_t* serialized, uint32_t* len,
+      ::arrow::MemoryPool* pool = ::arrow::default_memory_pool());
+
+  // Deserialize just the BloomFilterHeader, returning the size of the bitset.
+  // len is updated as in Deserialize.
+  static uint32_t DeserializeHeader(const uint8_t* serialized, uint32_t* len);
+
+  // The bitset size giving a false positive probability of fpp once ndv
+  // distinct values are inserted
+  static uint32_t OptimalNumOfBytes(int64_t ndv, double fpp);
+
+  static uint64_t Hash(int32_t value);
+  static uint64_t Hash(int64_t value);
+  static uint64_t Hash(const Int96& value);
+  static uint64_t Hash(float value);
+  static uint64_t Hash(double value);
+  static uint64_t Hash(const ByteArray& value);
+  static uint64_t Hash(const FLBA& value, int type_length);
+
+  void InsertHash(uint64_t hash);
+
+  // False positives are possible, false negatives are not
+  bool FindHash(uint64_t hash) const;
+
+  uint32_t num_bytes() const { return num_bytes_; }
+
+  // Serialize the header and the bitset, returning the number of bytes written
+  int64_t WriteTo(OutputStream* sink) const;
+
+ private:
+  uint32_t num_bytes_;
+  std::shared_ptr<PoolBuffer> bitset_;
+};
+
+// The Bloom filter hash of a value of a DType column
+template <typename DType>
+inline uint64_t BloomFilterHash(const ColumnDescriptor* descr,
+                                const typename DType::c_type& value) {
+  return BloomFilter::Hash(value);
+}
+
+template <>
+inline uint64_t BloomFilterHash<FLBAType>(const ColumnDescriptor* descr,
+                                          const FLBA& value) {
+  return BloomFilter::Hash(value, descr->type_length());
+}
+
+}  // namespace parquet
+
+#endif  // PARQUET_BLOOM_FILTER_H
@@ -17,6 +17,10 @@
 
 #include "benchmark/benchmark.h"
 
+#include <iomanip>
+#include <random>
+#include <sstream>
+
 #include "parquet/column_reader.h"
 #include "parquet/column_writer.h"
 #include "parquet/file/reader-internal.h"
@@ -156,13 +160,16 @@ static void BM_RleEncoding(::benchmark::State& state) {
 
 BENCHMARK(BM_RleEncoding)->RangePair(1024, 65536, 1, 16);
 
-static void BM_RleDecoding(::benchmark::State& state) {
+// RLE-encode state.range(0) levels of the given max level, in which every
+// state.range(1)-th level is the max level and the others are 0
+static std::shared_ptr<PoolBuffer> EncodeRleLevels(::benchmark::State& state,
+                                                   int16_t max_level) {
   LevelEncoder level_encoder;
   std::vector<int16_t> levels(state.range(0), 0);
   int64_t n = 0;
-  std::generate(levels.begin(), levels.end(),
-                [&state, &n] { return (n++ % state.range(1)) == 0; });
-  int16_t max_level = 1;
+  std::generate(levels.begin(), levels.end(), [&state, &n, max_level] {
+    return static_cast<int16_t>((n++ % state.range(1)) == 0 ? max_level : 0);
+  });
   int64_t rle_size = LevelEncoder::MaxBufferSize(Encoding::RLE, max_level, levels.size());
   auto buffer_rle = std::make_shared<PoolBuffer>();
   PARQUET_THROW_NOT_OK(buffer_rle->Resize(rle_size + sizeof(int32_t)));
@@ -170,6 +177,13 @@ static void BM_RleDecoding(::benchmark::State& state) {
                      buffer_rle->mutable_data() + sizeof(int32_t), rle_size);
   level_encoder.Encode(levels.size(), levels.data());
   reinterpret_cast<int32_t*>(buffer_rle->mutable_data())[0] = level_encoder.len();
+  return buffer_rle;
+}
+
+static void BM_RleDecoding(::benchmark::State& state) {
+  std::vector<int16_t> levels(state.range(0), 0);
+  int16_t max_level = 1;
+  std::shared_ptr<PoolBuffer> buffer_rle = EncodeRleLevels(state, max_level);
 
   while (state.KeepRunning()) {
     LevelDecoder level_decoder;
@@ -183,6 +197,154 @@ static void BM_RleDecoding(::benchmark::State& state) {
 
 BENCHMARK(BM_RleDecoding)->RangePair(1024, 65536, 1, 16);
 
+static void BM_RleDecodingMaxLevel2(::benchmark::State& state) {
+  std::vector<int16_t> levels(state.range(0), 0);
+  int16_t max_level = 2;
+  std::shared_ptr<PoolBuffer> buffer_rle = EncodeRleLevels(state, max_level);
+
+  while (state.KeepRunning()) {
+    LevelDecoder level_decoder;
+    level_decoder.SetData(Encoding::RLE, max_level, levels.size(), buffer_rle->data());
+    level_decoder.Decode(state.range(0), levels.data());
+  }
+
+  state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(int16_t));
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_RleDecodingMaxLevel2)->RangePair(1024, 65536, 1, 16);
+
+static void BM_RleDecodingToBitmap(::benchmark::State& state) {
+  std::vector<uint8_t> valid_bits(::arrow::BitUtil::BytesForBits(state.range(0)));
+  int16_t max_level = 1;
+  std::shared_ptr<PoolBuffer> buffer_rle = EncodeRleLevels(state, max_level);
+
+  while (state.KeepRunning()) {
+    LevelDecoder level_decoder;
+    level_decoder.SetData(Encoding::RLE, max_level, static_cast<int>(state.range(0)),
+                          buffer_rle->data());
+    int64_t null_count = 0;
+    level_decoder.DecodeBitmap(static_cast<int>(state.range(0)), valid_bits.data(), 0,
+                               &null_count);
+  }
+
+  state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(int16_t));
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_RleDecodingToBitmap)->RangePair(1024, 65536, 1, 16);
+
+// ----------------------------------------------------------------------
+// Page compression and decompression
+
+// Bytes compressed per iteration, split into pages of state.range(1) bytes
+constexpr int64_t kCompressedColumnSize = 8 * 1024 * 1024;
+
+// Random bytes carrying at most entropy_bits bits of entropy each
+static std::vector<uint8_t> MakePageData(int64_t size, int entropy_bits) {
+  std::mt19937 rng(0);
+  std::vector<uint8_t> data(size);
+  uint32_t mask = (1U << entropy_bits) - 1;
+  for (int64_t i = 0; i < size; ++i) {
+    data[i] = static_cast<uint8_t>(rng() & mask);
+  }
+  return data;
+}
+
+// Compress and write the data in pages of page_size bytes, holding int64 values
+static int64_t WriteCompressedPages(const std::vector<uint8_t>& data, int64_t page_size,
+                                    Compression::type codec, OutputStream* sink) {
+  format::ColumnChunk thrift_metadata;
+  std::shared_ptr<ColumnDescriptor> schema = Int64Schema(Repetition::REQUIRED);
+  auto metadata = ColumnChunkMetaDataBuilder::Make(
+      default_writer_properties(), schema.get(),
+      reinterpret_cast<uint8_t*>(&thrift_metadata));
+  SerializedPageWriter pager(sink, codec, metadata.get());
+  auto compressed = std::static_pointer_cast<ResizableBuffer>(
+      AllocateBuffer(::arrow::default_memory_pool()));
+  int64_t compressed_size = 0;
+  for (int64_t offset = 0; offset < static_cast<int64_t>(data.size());
+       offset += page_size) {
+    auto page_data = std::make_shared<Buffer>(data.data() + offset, page_size);
+    std::shared_ptr<Buffer> page_buffer = page_data;
+    if (pager.has_compressor()) {
+      pager.Compress(*page_data, compressed.get());
+      page_buffer = compressed;
+    }
+    int32_t num_values = static_cast<int32_t>(page_size / sizeof(int64_t));
+    CompressedDataPage page(page_buffer, num_values, Encoding::PLAIN, Encoding::RLE,
+                            Encoding::RLE, page_size);
+    pager.WriteDataPage(page);
+    compressed_size += page_buffer->size();
+  }
+  return compressed_size;
+}
+
+static std::string CompressionLabel(int64_t uncompressed_size, int64_t compressed_size) {
+  std::stringstream ss;
+  ss << "ratio " << std::fixed << std::setprecision(2)
+     << static_cast<double>(uncompressed_size) / compressed_size;
+  return ss.str();
+}
+
+// The arguments are the codec, the page size and the bits of entropy per byte
+static void BM_CompressPages(::benchmark::State& state) {
+  auto codec = static_cast<Compression::type>(state.range(0));
+  if (!CodecAvailable(codec)) {
+    state.SkipWithError("Codec not available");
+    return;
+  }
+  int64_t page_size = state.range(1);
+  std::vector<uint8_t> data =
+      MakePageData(kCompressedColumnSize, static_cast<int>(state.range(2)));
+
+  int64_t compressed_size = 0;
+  while (state.KeepRunning()) {
+    InMemoryOutputStream sink;
+    compressed_size = WriteCompressedPages(data, page_size, codec, &sink);
+  }
+  state.SetBytesProcessed(state.iterations() * kCompressedColumnSize);
+  state.SetLabel(CompressionLabel(kCompressedColumnSize, compressed_size));
+}
+
+static void BM_DecompressPages(::benchmark::State& state) {
+  auto codec = static_cast<Compression::type>(state.range(0));
+  if (!CodecAvailable(codec)) {
+    state.SkipWithError("Codec not available");
+    return;
+  }
+  int64_t page_size = state.range(1);
+  std::vector<uint8_t> data =
+      MakePageData(kCompressedColumnSize, static_cast<int>(state.range(2)));
+  InMemoryOutputStream sink;
+  int64_t compressed_size = WriteCompressedPages(data, page_size, codec, &sink);
+  std::shared_ptr<Buffer> buffer = sink.GetBuffer();
+  int64_t num_values = kCompressedColumnSize / sizeof(int64_t);
+
+  while (state.KeepRunning()) {
+    std::unique_ptr<InMemoryInputStream> source(new InMemoryInputStream(buffer));
+    SerializedPageReader pager(std::move(source), num_values, codec);
+    while (pager.NextPage() != nullptr) {
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * kCompressedColumnSize);
+  state.SetLabel(CompressionLabel(kCompressedColumnSize, compressed_size));
+}
+
+static void CompressionArguments(::benchmark::internal::Benchmark* b) {
+  for (int codec : {Compression::UNCOMPRESSED, Compression::SNAPPY, Compression::GZIP,
+                    Compression::ZSTD, Compression::BROTLI, Compression::LZ4}) {
+    for (int page_size : {8 << 10, 64 << 10, 512 << 10, 1 << 20, 8 << 20}) {
+      for (int entropy_bits : {2, 5, 8}) {
+        b->Args({codec, page_size, entropy_bits});
+      }
+    }
+  }
+}
+
+BENCHMARK(BM_CompressPages)->Apply(CompressionArguments);
+BENCHMARK(BM_DecompressPages)->Apply(CompressionArguments);
+
 }  // namespace benchmark
 
 }  // namespace parquet
@@ -23,8 +23,10 @@
 #define PARQUET_COLUMN_PAGE_H
 
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "parquet/statistics.h"
 #include "parquet/types.h"
@@ -32,6 +34,8 @@
 
 namespace parquet {
 
+class BloomFilter;
+
 // TODO: Parallel processing is not yet safe because of memory-ownership
 // semantics (the PageReader may or may not own the memory referenced by a
 // page)
@@ -90,20 +94,69 @@ class DataPage : public Page {
   EncodedStatistics statistics_;
 };
 
+// Sections of a page written in the DATA_PAGE_V2 format: the RLE-encoded
+// repetition and definition levels are stored uncompressed ahead of the
+// values, which are compressed if is_compressed is set
+struct DataPageV2Layout {
+  int32_t num_nulls;
+  int32_t definition_levels_byte_length;
+  int32_t repetition_levels_byte_length;
+  bool is_compressed;
+};
+
+// A data page to be written. Its data may be made of several buffers, such as
+// the levels and the values, which are written one after the other.
 class CompressedDataPage : public DataPage {
  public:
   CompressedDataPage(const std::shared_ptr<Buffer>& buffer, int32_t num_values,
                      Encoding::type encoding, Encoding::type definition_level_encoding,
                      Encoding::type repetition_level_encoding, int64_t uncompressed_size,
-                     const EncodedStatistics& statistics = EncodedStatistics())
-      : DataPage(buffer, num_values, encoding, definition_level_encoding,
-                 repetition_level_encoding, statistics),
-        uncompressed_size_(uncompressed_size) {}
+                     const EncodedStatistics& statistics = EncodedStatistics(),
+                     int64_t num_rows = 0, const DataPageV2Layout* v2_layout = nullptr)
+      : CompressedDataPage(std::vector<std::shared_ptr<Buffer>>{buffer}, num_values,
+                           encoding, definition_level_encoding,
+                           repetition_level_encoding, uncompressed_size, statistics,
+                           num_rows, v2_layout) {}
+
+  // buffer() is only set if the page is made of a single buffer
+  CompressedDataPage(std::vector<std::shared_ptr<Buffer>> buffers, int32_t num_values,
+                     Encoding::type encoding, Encoding::type definition_level_encoding,
+                     Encoding::type repetition_level_encoding, int64_t uncompressed_size,
+                     const EncodedStatistics& statistics = EncodedStatistics(),
+                     int64_t num_rows = 0, const DataPageV2Layout* v2_layout = nullptr)
+      : DataPage(buffers.size() == 1 ? buffers[0] : nullptr, num_values, encoding,
+                 definition_level_encoding, repetition_level_encoding, statistics),
+        buffers_(std::move(buffers)),
+        uncompressed_size_(uncompressed_size),
+        num_rows_(num_rows),
+        is_v2_(v2_layout != nullptr),
+        v2_layout_(is_v2_ ? *v2_layout : DataPageV2Layout()) {}
+
+  const std::vector<std::shared_ptr<Buffer>>& buffers() const { return buffers_; }
+
+  // @returns: the total size in bytes of the page's data buffers
+  int64_t data_size() const {
+    int64_t size = 0;
+    for (const auto& buffer : buffers_) {
+      size += buffer->size();
+    }
+    return size;
+  }
 
   int64_t uncompressed_size() const { return uncompressed_size_; }
 
+  // Number of rows starting in this page, needed for the OffsetIndex
+  int64_t num_rows() const { return num_rows_; }
+
+  // nullptr unless the page is to be written as a DATA_PAGE_V2
+  const DataPageV2Layout* v2_layout() const { return is_v2_ ? &v2_layout_ : nullptr; }
+
  private:
+  std::vector<std::shared_ptr<Buffer>> buffers_;
   int64_t uncompressed_size_;
+  int64_t num_rows_;
+  bool is_v2_;
+  DataPageV2Layout v2_layout_;
 };
 
 class DataPageV2 : public Page {
@@ -111,7 +164,8 @@ class DataPageV2 : public Page {
   DataPageV2(const std::shared_ptr<Buffer>& buffer, int32_t num_values, int32_t num_nulls,
              int32_t num_rows, Encoding::type encoding,
              int32_t definition_levels_byte_length, int32_t repetition_levels_byte_length,
-             bool is_compressed = false)
+             bool is_compressed = false,
+             const EncodedStatistics& statistics = EncodedStatistics())
       : Page(buffer, PageType::DATA_PAGE_V2),
         num_values_(num_values),
         num_nulls_(num_nulls),
@@ -119,7 +173,8 @@ class DataPageV2 : public Page {
         encoding_(encoding),
         definition_levels_byte_length_(definition_levels_byte_length),
         repetition_levels_byte_length_(repetition_levels_byte_length),
-        is_compressed_(is_compressed) {}
+        is_compressed_(is_compressed),
+        statistics_(statistics) {}
 
   int32_t num_values() const { return num_values_; }
 
@@ -135,6 +190,8 @@ class DataPageV2 : public Page {
 
   bool is_compressed() const { return is_compressed_; }
 
+  const EncodedStatistics& statistics() const { return statistics_; }
+
  private:
   int32_t num_values_;
   int32_t num_nulls_;
@@ -143,8 +200,7 @@ class DataPageV2 : public Page {
   int32_t definition_levels_byte_length_;
   int32_t repetition_levels_byte_length_;
   bool is_compressed_;
-
-  // TODO(wesm): format::DataPageHeaderV2.statistics
+  EncodedStatistics statistics_;
 };
 
 class DictionaryPage : public Page {
@@ -170,6 +226,9 @@ class DictionaryPage : public Page {
 
 // Abstract page iterator interface. This way, we can feed column pages to the
 // ColumnReader through whatever mechanism we choose
+// Returns false if a data page with the given statistics can be skipped
+typedef std::function<bool(const EncodedStatistics&)> DataPageFilter;
+
 class PageReader {
  public:
   virtual ~PageReader() {}
@@ -177,6 +236,24 @@ class PageReader {
   // @returns: shared_ptr<Page>(nullptr) on EOS, std::shared_ptr<Page>
   // containing new Page otherwise
   virtual std::shared_ptr<Page> NextPage() = 0;
+
+  // Allows the reader to skip data pages rejected by the filter without
+  // reading or decompressing them. This is only a hint: readers may still
+  // return such pages.
+  virtual void set_data_page_filter(const DataPageFilter& filter) {}
+
+  // Skip whole data pages using the value counts of their headers, without
+  // reading or decompressing them, while they hold at most max_values values
+  // in total. Stops before the first page that is not a data page.
+  //
+  // @returns: the number of values skipped. Readers that do not support it
+  // skip nothing.
+  virtual int64_t SkipDataPages(int64_t max_values) { return 0; }
+
+  // Hints that the data pages are only read for their levels. Readers may
+  // then drop dictionary pages, and return DATA_PAGE_V2 pages holding their
+  // levels only, without decompressing their values.
+  virtual void set_levels_only(bool levels_only) {}
 };
 
 class PageWriter {
@@ -192,9 +269,26 @@ class PageWriter {
 
   virtual int64_t WriteDictionaryPage(const DictionaryPage& page) = 0;
 
+  // Write the Bloom filter of the column chunk. Called after Close, as the
+  // filter is not part of the chunk's pages
+  virtual int64_t WriteBloomFilter(const BloomFilter& filter) = 0;
+
   virtual bool has_compressor() = 0;
 
   virtual void Compress(const Buffer& src_buffer, ResizableBuffer* dest_buffer) = 0;
+
+  // If true, WriteDataPage takes pages whose data is not compressed yet and
+  // compresses them itself. The page buffers must not be modified afterwards.
+  virtual bool compresses_data_pages() { return false; }
+
+  // Wait until all data pages are written. Returns the number of bytes written
+  // for them that were not returned by WriteDataPage.
+  virtual int64_t Flush() { return 0; }
+
+  // Account for the bytes of the data pages that the column writer holds back
+  // while dictionary encoding, not written yet. Returns true if the column
+  // writer should write them, as they make the pager exceed its memory limit.
+  virtual bool HoldDataPages(int64_t size) { return false; }
 };
 
 }  // namespace parquet
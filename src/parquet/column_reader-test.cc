@@ -121,6 +121,38 @@ class TestPrimitiveReader : public ::testing::Test {
     ASSERT_EQ(0, values_read);
   }
 
+  // Every batch but the last one is full, whatever the page size
+  void CheckResultsFull(int64_t batch_size) {
+    vector<int32_t> vresult(num_values_, -1);
+    vector<int16_t> dresult(num_levels_, -1);
+    vector<int16_t> rresult(num_levels_, -1);
+    int64_t values_read = 0;
+    int64_t total_values_read = 0;
+    int64_t levels_read = 0;
+
+    Int32Reader* reader = static_cast<Int32Reader*>(reader_.get());
+    while (levels_read < num_levels_) {
+      int64_t batch = reader->ReadBatchFull(
+          batch_size, dresult.data() + levels_read, rresult.data() + levels_read,
+          vresult.data() + total_values_read, &values_read);
+      ASSERT_EQ(std::min<int64_t>(batch_size, num_levels_ - levels_read), batch);
+      levels_read += batch;
+      total_values_read += values_read;
+    }
+
+    ASSERT_EQ(num_values_, total_values_read);
+    ASSERT_TRUE(vector_equal(values_, vresult));
+    if (max_def_level_ > 0) {
+      ASSERT_TRUE(vector_equal(def_levels_, dresult));
+    }
+    if (max_rep_level_ > 0) {
+      ASSERT_TRUE(vector_equal(rep_levels_, rresult));
+    }
+    ASSERT_EQ(0, reader->ReadBatchFull(batch_size, nullptr, nullptr, nullptr,
+                                       &values_read));
+    ASSERT_EQ(0, values_read);
+  }
+
   void CheckResultsSpaced() {
     vector<int32_t> vresult(num_levels_, -1);
     vector<int16_t> dresult(num_levels_, -1);
@@ -194,6 +226,14 @@ class TestPrimitiveReader : public ::testing::Test {
     InitReader(d);
     CheckResultsSpaced();
     Clear();
+
+    num_values_ =
+        MakePages<Int32Type>(d, num_pages, levels_per_page, def_levels_, rep_levels_,
+                             values_, data_buffer_, pages_, Encoding::PLAIN);
+    num_levels_ = num_pages * levels_per_page;
+    InitReader(d);
+    CheckResultsFull(2 * levels_per_page + levels_per_page / 2);
+    Clear();
   }
 
   void ExecuteDict(int num_pages, int levels_per_page, const ColumnDescriptor* d) {
@@ -260,6 +300,91 @@ TEST_F(TestPrimitiveReader, TestInt32FlatRepeated) {
   ExecuteDict(num_pages, levels_per_page, &descr);
 }
 
+TEST_F(TestPrimitiveReader, TestInt32FlatOptionalShape) {
+  int levels_per_page = 100;
+  int num_pages = 50;
+  max_def_level_ = 1;
+  max_rep_level_ = 0;
+  NodePtr type = schema::Int32("b", Repetition::OPTIONAL);
+  const ColumnDescriptor descr(type, max_def_level_, max_rep_level_);
+  num_values_ = MakePages<Int32Type>(&descr, num_pages, levels_per_page, def_levels_,
+                                     rep_levels_, values_, data_buffer_, pages_,
+                                     Encoding::PLAIN);
+  num_levels_ = num_pages * levels_per_page;
+  InitReader(&descr);
+  ASSERT_EQ(ColumnShape::FLAT_OPTIONAL, reader_->shape());
+
+  vector<int32_t> vresult(num_levels_, -1);
+  vector<int16_t> dresult(num_levels_, -1);
+  vector<uint8_t> valid_bits(num_levels_, 0);
+  int64_t levels_actual = 0;
+  int64_t total_null_count = 0;
+  Int32Reader* reader = static_cast<Int32Reader*>(reader_.get());
+  while (true) {
+    int64_t levels_read;
+    int64_t values_read;
+    int64_t null_count;
+    reader->ReadBatchSpacedAs<ColumnShape::FLAT_OPTIONAL>(
+        128, dresult.data() + levels_actual, nullptr, vresult.data() + levels_actual,
+        valid_bits.data(), levels_actual, &levels_read, &values_read, &null_count);
+    if (levels_read == 0) {
+      break;
+    }
+    ASSERT_EQ(levels_read, values_read);
+    levels_actual += levels_read;
+    total_null_count += null_count;
+  }
+  ASSERT_EQ(num_levels_, levels_actual);
+  ASSERT_EQ(num_levels_ - num_values_, total_null_count);
+  ASSERT_TRUE(vector_equal(def_levels_, dresult));
+  ASSERT_TRUE(vector_equal_with_def_levels(values_, dresult, max_def_level_,
+                                           max_rep_level_, vresult));
+  for (int i = 0; i < num_levels_; i++) {
+    ASSERT_EQ(def_levels_[i] == 1, ::arrow::BitUtil::GetBit(valid_bits.data(), i));
+  }
+  Clear();
+
+  // The other shapes
+  NodePtr required = schema::Int32("a", Repetition::REQUIRED);
+  const ColumnDescriptor required_descr(required, 0, 0);
+  InitReader(&required_descr);
+  ASSERT_EQ(ColumnShape::REQUIRED, reader_->shape());
+  NodePtr repeated = schema::Int32("c", Repetition::REPEATED);
+  const ColumnDescriptor repeated_descr(repeated, 1, 1);
+  InitReader(&repeated_descr);
+  ASSERT_EQ(ColumnShape::NESTED, reader_->shape());
+}
+
+TEST_F(TestPrimitiveReader, TestInt32ReadBatchConverted) {
+  int levels_per_page = 100;
+  int num_pages = 10;
+  max_def_level_ = 0;
+  max_rep_level_ = 0;
+  NodePtr type = schema::Int32("a", Repetition::REQUIRED);
+  const ColumnDescriptor descr(type, max_def_level_, max_rep_level_);
+  for (auto encoding : {Encoding::PLAIN, Encoding::RLE_DICTIONARY}) {
+    num_values_ = MakePages<Int32Type>(&descr, num_pages, levels_per_page, def_levels_,
+                                       rep_levels_, values_, data_buffer_, pages_,
+                                       encoding);
+    InitReader(&descr);
+    Int32Reader* reader = static_cast<Int32Reader*>(reader_.get());
+    vector<int64_t> result(num_values_, -1);
+    int64_t total_values_read = 0;
+    int64_t values_read;
+    do {
+      values_read = reader->ReadBatchConverted(
+          64, result.data() + total_values_read,
+          [](int32_t value) { return static_cast<int64_t>(value) * 2; });
+      total_values_read += values_read;
+    } while (values_read > 0);
+    ASSERT_EQ(num_values_, total_values_read);
+    for (int i = 0; i < num_values_; i++) {
+      ASSERT_EQ(static_cast<int64_t>(values_[i]) * 2, result[i]) << i;
+    }
+    Clear();
+  }
+}
+
 TEST_F(TestPrimitiveReader, TestInt32FlatRequiredSkip) {
   int levels_per_page = 100;
   int num_pages = 5;
@@ -323,6 +448,101 @@ TEST_F(TestPrimitiveReader, TestInt32FlatRequiredSkip) {
   reader_.reset();
 }
 
+TEST_F(TestPrimitiveReader, TestInt32PageFilter) {
+  max_def_level_ = 0;
+  max_rep_level_ = 0;
+  NodePtr type = schema::Int32("a", Repetition::REQUIRED);
+  const ColumnDescriptor descr(type, max_def_level_, max_rep_level_);
+
+  // Page i holds the sorted values [100 * i, 100 * i + 100)
+  int num_pages = 4;
+  int levels_per_page = 100;
+  for (int i = 0; i < num_pages; i++) {
+    vector<int32_t> values(levels_per_page);
+    for (int j = 0; j < levels_per_page; j++) {
+      values[j] = i * levels_per_page + j;
+    }
+    shared_ptr<DataPage> page = MakeDataPage<Int32Type>(
+        &descr, values, levels_per_page, Encoding::PLAIN, NULL, 0, {}, 0, {}, 0);
+    EncodedStatistics stats;
+    stats.set_min(std::string(reinterpret_cast<const char*>(&values.front()), 4));
+    stats.set_max(std::string(reinterpret_cast<const char*>(&values.back()), 4));
+    pages_.push_back(std::make_shared<DataPage>(
+        page->buffer(), page->num_values(), page->encoding(),
+        page->definition_level_encoding(), page->repetition_level_encoding(), stats));
+  }
+  InitReader(&descr);
+
+  Int32Reader* reader = static_cast<Int32Reader*>(reader_.get());
+  reader->SetPageFilter(150, 260);
+
+  vector<int32_t> vresult(num_pages * levels_per_page, -1);
+  int64_t values_read = 0;
+  int64_t total_values_read = 0;
+  while (reader->HasNext()) {
+    reader->ReadBatch(levels_per_page, nullptr, nullptr,
+                      vresult.data() + total_values_read, &values_read);
+    total_values_read += values_read;
+  }
+  // Only the second and the third page can hold values in [150, 260]
+  ASSERT_EQ(2 * levels_per_page, total_values_read);
+  for (int64_t i = 0; i < total_values_read; i++) {
+    ASSERT_EQ(levels_per_page + i, vresult[i]);
+  }
+}
+
+TEST_F(TestPrimitiveReader, TestInt32LevelsOnly) {
+  int levels_per_page = 100;
+  int num_pages = 50;
+  max_def_level_ = 4;
+  max_rep_level_ = 2;
+  NodePtr type = schema::Int32("c", Repetition::REPEATED);
+  const ColumnDescriptor descr(type, max_def_level_, max_rep_level_);
+  num_values_ =
+      MakePages<Int32Type>(&descr, num_pages, levels_per_page, def_levels_, rep_levels_,
+                           values_, data_buffer_, pages_, Encoding::RLE_DICTIONARY);
+  num_levels_ = num_pages * levels_per_page;
+  InitReader(&descr);
+  reader_->set_levels_only(true);
+
+  vector<int16_t> dresult(num_levels_, -1);
+  vector<int16_t> rresult(num_levels_, -1);
+  int64_t total_levels = 0;
+  int64_t total_values = 0;
+  int64_t levels_read = 0;
+  do {
+    int64_t values_read = 0;
+    levels_read = reader_->ReadLevelsOnly(64, dresult.data() + total_levels,
+                                          rresult.data() + total_levels, &values_read);
+    total_levels += levels_read;
+    total_values += values_read;
+  } while (levels_read > 0);
+
+  ASSERT_EQ(num_levels_, total_levels);
+  ASSERT_EQ(num_values_, total_values);
+  ASSERT_TRUE(vector_equal(def_levels_, dresult));
+  ASSERT_TRUE(vector_equal(rep_levels_, rresult));
+  Clear();
+
+  // The values, in an unsupported encoding, are never decoded
+  max_def_level_ = 1;
+  max_rep_level_ = 0;
+  const ColumnDescriptor optional_descr(schema::Int32("b", Repetition::OPTIONAL),
+                                        max_def_level_, max_rep_level_);
+  vector<int16_t> def_levels = {1, 0, 1, 1};
+  pages_.push_back(MakeDataPage<Int32Type>(&optional_descr, {}, 4,
+                                           Encoding::DELTA_BYTE_ARRAY, {}, 0, def_levels,
+                                           max_def_level_, {}, 0));
+  InitReader(&optional_descr);
+  int64_t values_read = 0;
+  ASSERT_THROW(reader_->ReadLevelsOnly(10, nullptr, nullptr, &values_read),
+               ParquetException);
+  reader_->set_levels_only(true);
+  ASSERT_EQ(4, reader_->ReadLevelsOnly(10, nullptr, nullptr, &values_read));
+  ASSERT_EQ(3, values_read);
+  ASSERT_EQ(0, reader_->ReadLevelsOnly(10, nullptr, nullptr, &values_read));
+}
+
 TEST_F(TestPrimitiveReader, TestDictionaryEncodedPages) {
   max_def_level_ = 0;
   max_rep_level_ = 0;
@@ -386,5 +606,33 @@ TEST_F(TestPrimitiveReader, TestDictionaryEncodedPages) {
   pages_.clear();
 }
 
+TEST(TestDefinitionLevels, FlatToBitmap) {
+  // Exercise the unaligned head, the 16- and 8-level blocks and the tail
+  for (int64_t offset : {0, 3, 8}) {
+    for (int64_t num_levels : {0, 5, 16, 37, 100}) {
+      std::vector<int16_t> def_levels(num_levels);
+      int64_t expected_nulls = 0;
+      for (int64_t i = 0; i < num_levels; ++i) {
+        def_levels[i] = (i % 3 == 0 || i % 7 == 0) ? 0 : 1;
+        expected_nulls += def_levels[i] == 0;
+      }
+      // The bits around the written ones are kept
+      std::vector<uint8_t> valid_bits(32, 0xA5);
+      int64_t values_read = 0;
+      int64_t null_count = 0;
+      DefinitionLevelsToBitmap(def_levels.data(), num_levels, 1, 0, &values_read,
+                               &null_count, valid_bits.data(), offset);
+      ASSERT_EQ(num_levels, values_read);
+      ASSERT_EQ(expected_nulls, null_count);
+      for (int64_t i = 0; i < 32 * 8; ++i) {
+        bool expected = (i >= offset && i < offset + num_levels)
+                            ? def_levels[i - offset] == 1
+                            : ((0xA5 >> (i % 8)) & 1) == 1;
+        ASSERT_EQ(expected, ::arrow::BitUtil::GetBit(valid_bits.data(), i));
+      }
+    }
+  }
+}
+
 }  // namespace test
 }  // namespace parquet
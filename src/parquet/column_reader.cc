@@ -19,19 +19,98 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <memory>
 
 #include "arrow/util/rle-encoding.h"
 
 #include "parquet/column_page.h"
 #include "parquet/encoding-internal.h"
+#include "parquet/file/metadata.h"
 #include "parquet/properties.h"
+#include "parquet/statistics.h"
+#include "parquet/util/bitmap.h"
+#include "parquet/util/comparison.h"
 
 using arrow::MemoryPool;
 
 namespace parquet {
 
-LevelDecoder::LevelDecoder() : num_values_remaining_(0) {}
+namespace {
+
+// The levels packed in every possible byte, for bit widths 1 and 2
+struct LevelUnpackTables {
+  int16_t width1[256][8];
+  int16_t width2[256][4];
+
+  LevelUnpackTables() {
+    for (int byte = 0; byte < 256; ++byte) {
+      for (int i = 0; i < 8; ++i) {
+        width1[byte][i] = static_cast<int16_t>((byte >> i) & 1);
+      }
+      for (int i = 0; i < 4; ++i) {
+        width2[byte][i] = static_cast<int16_t>((byte >> (2 * i)) & 3);
+      }
+    }
+  }
+};
+
+const LevelUnpackTables& level_unpack_tables() {
+  static LevelUnpackTables tables;
+  return tables;
+}
+
+inline int16_t UnpackLevel(const uint8_t* data, int64_t bit_offset, int bit_width) {
+  return static_cast<int16_t>((data[bit_offset / 8] >> (bit_offset % 8)) &
+                              ((1 << bit_width) - 1));
+}
+
+// Expand num_values bit-packed levels of bit width 1 or 2, starting
+// bit_offset bits into data. Whole bytes are expanded at once, with SSE2 for
+// bit width 1.
+void UnpackLevels(const uint8_t* data, int64_t bit_offset, int bit_width,
+                  int num_values, int16_t* levels) {
+  int i = 0;
+  // Up to the next byte boundary. The bit width divides 8, so no level
+  // straddles two bytes.
+  for (; i < num_values && bit_offset % 8 != 0; ++i, bit_offset += bit_width) {
+    levels[i] = UnpackLevel(data, bit_offset, bit_width);
+  }
+
+  const uint8_t* bytes = data + bit_offset / 8;
+  const int levels_per_byte = 8 / bit_width;
+  const int num_bytes = (num_values - i) / levels_per_byte;
+  const LevelUnpackTables& tables = level_unpack_tables();
+  int16_t* out = levels + i;
+  int b = 0;
+  if (bit_width == 1) {
+#if defined(PARQUET_USE_SSE) && defined(__SSE2__)
+    const __m128i bits = _mm_setr_epi16(1, 2, 4, 8, 16, 32, 64, 128);
+    for (; b < num_bytes; ++b, out += 8) {
+      __m128i masked = _mm_and_si128(_mm_set1_epi16(bytes[b]), bits);
+      __m128i is_set = _mm_cmpeq_epi16(masked, bits);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_srli_epi16(is_set, 15));
+    }
+#endif
+    for (; b < num_bytes; ++b, out += 8) {
+      memcpy(out, tables.width1[bytes[b]], sizeof(tables.width1[0]));
+    }
+  } else {
+    for (; b < num_bytes; ++b, out += 4) {
+      memcpy(out, tables.width2[bytes[b]], sizeof(tables.width2[0]));
+    }
+  }
+  i += num_bytes * levels_per_byte;
+  bit_offset += static_cast<int64_t>(num_bytes) * 8;
+
+  for (; i < num_values; ++i, bit_offset += bit_width) {
+    levels[i] = UnpackLevel(data, bit_offset, bit_width);
+  }
+}
+
+}  // namespace
+
+LevelDecoder::LevelDecoder() : num_values_remaining_(0), decode_runs_(false) {}
 
 LevelDecoder::~LevelDecoder() {}
 
@@ -44,15 +123,11 @@ int LevelDecoder::SetData(Encoding::type encoding, int16_t max_level,
   switch (encoding) {
     case Encoding::RLE: {
       num_bytes = *reinterpret_cast<const int32_t*>(data);
-      const uint8_t* decoder_data = data + sizeof(int32_t);
-      if (!rle_decoder_) {
-        rle_decoder_.reset(new ::arrow::RleDecoder(decoder_data, num_bytes, bit_width_));
-      } else {
-        rle_decoder_->Reset(decoder_data, num_bytes, bit_width_);
-      }
+      SetRleData(data + sizeof(int32_t), num_bytes);
       return sizeof(int32_t) + num_bytes;
     }
     case Encoding::BIT_PACKED: {
+      decode_runs_ = false;
       num_bytes =
           static_cast<int32_t>(BitUtil::Ceil(num_buffered_values * bit_width_, 8));
       if (!bit_packed_decoder_) {
@@ -68,11 +143,35 @@ int LevelDecoder::SetData(Encoding::type encoding, int16_t max_level,
   return -1;
 }
 
+void LevelDecoder::SetDataV2(int32_t num_bytes, int16_t max_level,
+                             int num_buffered_values, const uint8_t* data) {
+  encoding_ = Encoding::RLE;
+  num_values_remaining_ = num_buffered_values;
+  bit_width_ = BitUtil::Log2(max_level + 1);
+  SetRleData(data, num_bytes);
+}
+
+void LevelDecoder::SetRleData(const uint8_t* data, int32_t num_bytes) {
+  decode_runs_ = bit_width_ == 1 || bit_width_ == 2;
+  if (decode_runs_) {
+    run_data_ = data;
+    run_data_end_ = data + num_bytes;
+    repeat_count_ = 0;
+    literal_count_ = 0;
+  } else if (!rle_decoder_) {
+    rle_decoder_.reset(new ::arrow::RleDecoder(data, num_bytes, bit_width_));
+  } else {
+    rle_decoder_->Reset(data, num_bytes, bit_width_);
+  }
+}
+
 int LevelDecoder::Decode(int batch_size, int16_t* levels) {
   int num_decoded = 0;
 
   int num_values = std::min(num_values_remaining_, batch_size);
-  if (encoding_ == Encoding::RLE) {
+  if (decode_runs_) {
+    num_decoded = DecodeRuns(num_values, levels);
+  } else if (encoding_ == Encoding::RLE) {
     num_decoded = rle_decoder_->GetBatch(levels, num_values);
   } else {
     num_decoded = bit_packed_decoder_->GetBatch(bit_width_, levels, num_values);
@@ -81,21 +180,170 @@ int LevelDecoder::Decode(int batch_size, int16_t* levels) {
   return num_decoded;
 }
 
+int LevelDecoder::DecodeBitmap(int batch_size, uint8_t* valid_bits,
+                               int64_t valid_bits_offset, int64_t* null_count) {
+  if (bit_width_ != 1) {
+    throw ParquetException("Only levels of maximum level 1 decode to a bitmap");
+  }
+  int num_values = std::min(num_values_remaining_, batch_size);
+  int num_decoded = 0;
+  if (decode_runs_) {
+    num_decoded = DecodeRunsToBitmap(num_values, valid_bits, valid_bits_offset,
+                                     null_count);
+    num_values_remaining_ -= num_decoded;
+    return num_decoded;
+  }
+  // BIT_PACKED levels go through the level array
+  const int kBatchSize = 1024;
+  int16_t levels[kBatchSize];
+  while (num_decoded < num_values) {
+    int n = Decode(std::min(kBatchSize, num_values - num_decoded), levels);
+    if (n == 0) break;
+    int64_t values_read = 0;
+    FlatDefinitionLevelsToBitmap(levels, n, &values_read, null_count, valid_bits,
+                                 valid_bits_offset + num_decoded);
+    num_decoded += n;
+  }
+  return num_decoded;
+}
+
+bool LevelDecoder::NextRun() {
+  // ULEB128 run header
+  uint32_t header = 0;
+  for (int shift = 0;; shift += 7) {
+    if (run_data_ == run_data_end_ || shift > 28) return false;
+    uint8_t byte = *run_data_++;
+    header |= static_cast<uint32_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) break;
+  }
+  if (header & 1) {
+    // Groups of 8 bit-packed levels, truncated to the available data
+    int64_t num_bytes = static_cast<int64_t>(header >> 1) * bit_width_;
+    num_bytes = std::min<int64_t>(num_bytes, run_data_end_ - run_data_);
+    literal_count_ = static_cast<int>(num_bytes * 8 / bit_width_);
+    literal_data_ = run_data_;
+    literal_bit_offset_ = 0;
+    run_data_ += num_bytes;
+  } else {
+    // The repeated level takes a single byte for bit widths up to 8
+    if (run_data_ == run_data_end_) return false;
+    repeat_count_ = static_cast<int>(header >> 1);
+    repeat_value_ = *run_data_++;
+  }
+  return true;
+}
+
+int LevelDecoder::DecodeRuns(int num_values, int16_t* levels) {
+  int num_decoded = 0;
+  while (num_decoded < num_values) {
+    if (repeat_count_ == 0 && literal_count_ == 0) {
+      if (!NextRun()) break;
+    } else if (repeat_count_ > 0) {
+      int n = std::min(num_values - num_decoded, repeat_count_);
+      std::fill(levels + num_decoded, levels + num_decoded + n, repeat_value_);
+      repeat_count_ -= n;
+      num_decoded += n;
+    } else {
+      int n = std::min(num_values - num_decoded, literal_count_);
+      UnpackLevels(literal_data_, literal_bit_offset_, bit_width_, n,
+                   levels + num_decoded);
+      literal_bit_offset_ += n * bit_width_;
+      literal_count_ -= n;
+      num_decoded += n;
+    }
+  }
+  return num_decoded;
+}
+
+int LevelDecoder::DecodeRunsToBitmap(int num_values, uint8_t* valid_bits,
+                                     int64_t valid_bits_offset, int64_t* null_count) {
+  int num_decoded = 0;
+  while (num_decoded < num_values) {
+    if (repeat_count_ == 0 && literal_count_ == 0) {
+      if (!NextRun()) break;
+    } else if (repeat_count_ > 0) {
+      int n = std::min(num_values - num_decoded, repeat_count_);
+      FillBitmap(valid_bits, valid_bits_offset + num_decoded, n, repeat_value_ == 1);
+      if (repeat_value_ != 1) *null_count += n;
+      repeat_count_ -= n;
+      num_decoded += n;
+    } else {
+      // Bit-packed levels of bit width 1 are the validity bits themselves
+      int n = std::min(num_values - num_decoded, literal_count_);
+      CopyBitmap(literal_data_, literal_bit_offset_, n, valid_bits,
+                 valid_bits_offset + num_decoded);
+      *null_count += n - ::arrow::CountSetBits(literal_data_, literal_bit_offset_, n);
+      literal_bit_offset_ += n;
+      literal_count_ -= n;
+      num_decoded += n;
+    }
+  }
+  return num_decoded;
+}
+
 ReaderProperties default_reader_properties() {
   static ReaderProperties default_reader_properties;
   return default_reader_properties;
 }
 
+static ColumnShape::type GetColumnShape(const ColumnDescriptor* descr) {
+  if (descr->max_repetition_level() > 0 || descr->max_definition_level() > 1) {
+    return ColumnShape::NESTED;
+  }
+  return descr->max_definition_level() == 1 ? ColumnShape::FLAT_OPTIONAL
+                                            : ColumnShape::REQUIRED;
+}
+
 ColumnReader::ColumnReader(const ColumnDescriptor* descr,
                            std::unique_ptr<PageReader> pager, MemoryPool* pool)
     : descr_(descr),
+      shape_(GetColumnShape(descr)),
       pager_(std::move(pager)),
       num_buffered_values_(0),
       num_decoded_values_(0),
-      pool_(pool) {}
+      pool_(pool),
+      stats_(nullptr),
+      levels_only_(false) {}
 
 ColumnReader::~ColumnReader() {}
 
+int64_t ColumnReader::ReadLevelsOnly(int64_t batch_size, int16_t* def_levels,
+                                     int16_t* rep_levels, int64_t* values_read) {
+  if (!levels_only_) {
+    throw ParquetException("ReadLevelsOnly requires a levels-only column reader");
+  }
+  *values_read = 0;
+  // HasNext invokes ReadNewPage
+  if (!HasNext()) {
+    return 0;
+  }
+  batch_size = std::min(batch_size, num_buffered_values_ - num_decoded_values_);
+
+  int64_t num_levels = batch_size;
+  const int16_t max_definition_level = descr_->max_definition_level();
+  if (max_definition_level > 0) {
+    if (def_levels == nullptr) {
+      scratch_def_levels_.resize(batch_size);
+      def_levels = scratch_def_levels_.data();
+    }
+    num_levels = ReadDefinitionLevels(batch_size, def_levels);
+    for (int64_t i = 0; i < num_levels; ++i) {
+      *values_read += def_levels[i] == max_definition_level;
+    }
+  } else {
+    *values_read = batch_size;
+  }
+
+  if (descr_->max_repetition_level() > 0 && rep_levels) {
+    int64_t num_rep_levels = ReadRepetitionLevels(batch_size, rep_levels);
+    if (num_rep_levels != num_levels) {
+      throw ParquetException("Number of decoded rep / def levels did not match");
+    }
+  }
+  num_decoded_values_ += num_levels;
+  return num_levels;
+}
+
 template <typename DType>
 void TypedColumnReader<DType>::ConfigureDictionary(const DictionaryPage* page) {
   int encoding = static_cast<int>(page->encoding());
@@ -130,12 +378,192 @@ void TypedColumnReader<DType>::ConfigureDictionary(const DictionaryPage* page) {
   current_decoder_ = decoders_[encoding].get();
 }
 
+template <typename DType>
+void TypedColumnReader<DType>::SetPageFilter(const T& min, const T& max) {
+  if (get_sort_order(descr_->logical_type(), descr_->physical_type()) !=
+      SortOrder::SIGNED) {
+    return;
+  }
+  has_page_filter_ = true;
+  filter_min_ = min;
+  filter_max_ = max;
+  pager_->set_data_page_filter(
+      [this](const EncodedStatistics& stats) { return PageMayMatch(stats); });
+}
+
+template <typename DType>
+bool TypedColumnReader<DType>::PageMayMatch(const EncodedStatistics& stats) {
+  if (!stats.has_min || !stats.has_max) {
+    return true;
+  }
+  TypedRowGroupStatistics<DType> page_stats(descr_, stats.min(), stats.max(), 0, 0, 0,
+                                            true, pool_);
+  Compare<T> compare(descr_);
+  return !(compare(page_stats.max(), filter_min_) ||
+           compare(filter_max_, page_stats.min()));
+}
+
+template <typename DType>
+int64_t TypedColumnReader<DType>::ReadBatchIndices(int64_t batch_size,
+                                                   int16_t* def_levels,
+                                                   int16_t* rep_levels, int32_t* indices,
+                                                   int64_t* values_read) {
+  // HasNext invokes ReadNewPage
+  if (!HasNext()) {
+    *values_read = 0;
+    return 0;
+  }
+  if (current_decoder_->encoding() != Encoding::RLE_DICTIONARY) {
+    return -1;
+  }
+  batch_size = std::min(batch_size, num_buffered_values_ - num_decoded_values_);
+
+  int64_t values_to_read = 0;
+  int64_t num_def_levels =
+      ReadLevels(batch_size, def_levels, rep_levels, &values_to_read);
+
+  auto decoder = static_cast<DictionaryDecoder<DType>*>(current_decoder_);
+  {
+    ScopedStopWatch watch(StatsCounter(stats_, &ColumnReaderStats::value_decoding_time));
+    *values_read = decoder->DecodeIndices(indices, static_cast<int>(values_to_read));
+  }
+  int64_t total_values = std::max(num_def_levels, *values_read);
+  num_decoded_values_ += total_values;
+
+  return total_values;
+}
+
+template <typename DType>
+const typename DType::c_type* TypedColumnReader<DType>::dictionary(int* length) const {
+  auto it = decoders_.find(static_cast<int>(Encoding::RLE_DICTIONARY));
+  if (it == decoders_.end()) {
+    *length = 0;
+    return nullptr;
+  }
+  auto decoder = static_cast<const DictionaryDecoder<DType>*>(it->second.get());
+  *length = decoder->dictionary_length();
+  return decoder->dictionary();
+}
+
+// The DELTA encodings are defined for INT32 and INT64 (DELTA_BINARY_PACKED)
+// and BYTE_ARRAY (DELTA_LENGTH_BYTE_ARRAY, DELTA_BYTE_ARRAY) values
+template <typename DType>
+static std::shared_ptr<Decoder<DType>> MakeDeltaDecoder(Encoding::type encoding,
+                                                        const ColumnDescriptor* descr,
+                                                        MemoryPool* pool) {
+  ParquetException::NYI("Unsupported encoding");
+  return nullptr;
+}
+
+template <>
+std::shared_ptr<Decoder<Int32Type>> MakeDeltaDecoder<Int32Type>(
+    Encoding::type encoding, const ColumnDescriptor* descr, MemoryPool* pool) {
+  if (encoding != Encoding::DELTA_BINARY_PACKED) {
+    ParquetException::NYI("Unsupported encoding");
+  }
+  return std::make_shared<DeltaBitPackDecoder<Int32Type>>(descr, pool);
+}
+
+template <>
+std::shared_ptr<Decoder<Int64Type>> MakeDeltaDecoder<Int64Type>(
+    Encoding::type encoding, const ColumnDescriptor* descr, MemoryPool* pool) {
+  if (encoding != Encoding::DELTA_BINARY_PACKED) {
+    ParquetException::NYI("Unsupported encoding");
+  }
+  return std::make_shared<DeltaBitPackDecoder<Int64Type>>(descr, pool);
+}
+
+template <>
+std::shared_ptr<Decoder<ByteArrayType>> MakeDeltaDecoder<ByteArrayType>(
+    Encoding::type encoding, const ColumnDescriptor* descr, MemoryPool* pool) {
+  if (encoding == Encoding::DELTA_LENGTH_BYTE_ARRAY) {
+    return std::make_shared<DeltaLengthByteArrayDecoder>(descr, pool);
+  } else if (encoding == Encoding::DELTA_BYTE_ARRAY) {
+    return std::make_shared<DeltaByteArrayDecoder>(descr, pool);
+  }
+  ParquetException::NYI("Unsupported encoding");
+  return nullptr;
+}
+
+// BYTE_STREAM_SPLIT is defined for FLOAT and DOUBLE values
+template <typename DType>
+static std::shared_ptr<Decoder<DType>> MakeByteStreamSplitDecoder(
+    const ColumnDescriptor* descr) {
+  ParquetException::NYI("Unsupported encoding");
+  return nullptr;
+}
+
+template <>
+std::shared_ptr<Decoder<FloatType>> MakeByteStreamSplitDecoder<FloatType>(
+    const ColumnDescriptor* descr) {
+  return std::make_shared<ByteStreamSplitDecoder<FloatType>>(descr);
+}
+
+template <>
+std::shared_ptr<Decoder<DoubleType>> MakeByteStreamSplitDecoder<DoubleType>(
+    const ColumnDescriptor* descr) {
+  return std::make_shared<ByteStreamSplitDecoder<DoubleType>>(descr);
+}
+
 // PLAIN_DICTIONARY is deprecated but used to be used as a dictionary index
 // encoding.
 static bool IsDictionaryIndexEncoding(const Encoding::type& e) {
   return e == Encoding::RLE_DICTIONARY || e == Encoding::PLAIN_DICTIONARY;
 }
 
+template <typename DType>
+void TypedColumnReader<DType>::InitializeDataDecoder(Encoding::type encoding,
+                                                     const uint8_t* buffer,
+                                                     int64_t data_size) {
+  // Get a decoder object for this page or create a new decoder if this is the
+  // first page with this encoding.
+  if (IsDictionaryIndexEncoding(encoding)) {
+    encoding = Encoding::RLE_DICTIONARY;
+    UpdateStats(stats_, &ColumnReaderStats::dictionary_encoded_pages, 1);
+  }
+
+  auto it = decoders_.find(static_cast<int>(encoding));
+  if (it != decoders_.end()) {
+    if (encoding == Encoding::RLE_DICTIONARY) {
+      DCHECK(current_decoder_->encoding() == Encoding::RLE_DICTIONARY);
+    }
+    current_decoder_ = it->second.get();
+  } else {
+    switch (encoding) {
+      case Encoding::PLAIN: {
+        std::shared_ptr<DecoderType> decoder(new PlainDecoder<DType>(descr_));
+        decoders_[static_cast<int>(encoding)] = decoder;
+        current_decoder_ = decoder.get();
+        break;
+      }
+      case Encoding::RLE_DICTIONARY:
+        throw ParquetException("Dictionary page must be before data page.");
+
+      case Encoding::DELTA_BINARY_PACKED:
+      case Encoding::DELTA_LENGTH_BYTE_ARRAY:
+      case Encoding::DELTA_BYTE_ARRAY: {
+        std::shared_ptr<DecoderType> decoder =
+            MakeDeltaDecoder<DType>(encoding, descr_, pool_);
+        decoders_[static_cast<int>(encoding)] = decoder;
+        current_decoder_ = decoder.get();
+        break;
+      }
+
+      case Encoding::BYTE_STREAM_SPLIT: {
+        std::shared_ptr<DecoderType> decoder = MakeByteStreamSplitDecoder<DType>(descr_);
+        decoders_[static_cast<int>(encoding)] = decoder;
+        current_decoder_ = decoder.get();
+        break;
+      }
+
+      default:
+        throw ParquetException("Unknown encoding type.");
+    }
+  }
+  current_decoder_->SetData(static_cast<int>(num_buffered_values_), buffer,
+                            static_cast<int>(data_size));
+}
+
 template <typename DType>
 bool TypedColumnReader<DType>::ReadNewPage() {
   // Loop until we find the next data page.
@@ -149,11 +577,18 @@ bool TypedColumnReader<DType>::ReadNewPage() {
     }
 
     if (current_page_->type() == PageType::DICTIONARY_PAGE) {
-      ConfigureDictionary(static_cast<const DictionaryPage*>(current_page_.get()));
+      if (!levels_only_) {
+        ConfigureDictionary(static_cast<const DictionaryPage*>(current_page_.get()));
+      }
       continue;
     } else if (current_page_->type() == PageType::DATA_PAGE) {
       const DataPage* page = static_cast<const DataPage*>(current_page_.get());
 
+      if (has_page_filter_ && !PageMayMatch(page->statistics())) {
+        // The PageReader did not skip it already
+        continue;
+      }
+
       // Read a data page.
       num_buffered_values_ = page->num_values();
 
@@ -189,42 +624,48 @@ bool TypedColumnReader<DType>::ReadNewPage() {
         data_size -= def_levels_bytes;
       }
 
-      // Get a decoder object for this page or create a new decoder if this is the
-      // first page with this encoding.
-      Encoding::type encoding = page->encoding();
+      if (!levels_only_) {
+        InitializeDataDecoder(page->encoding(), buffer, data_size);
+      }
+      return true;
+    } else if (current_page_->type() == PageType::DATA_PAGE_V2) {
+      const DataPageV2* page = static_cast<const DataPageV2*>(current_page_.get());
 
-      if (IsDictionaryIndexEncoding(encoding)) {
-        encoding = Encoding::RLE_DICTIONARY;
+      if (has_page_filter_ && !PageMayMatch(page->statistics())) {
+        // The PageReader did not skip it already
+        continue;
       }
 
-      auto it = decoders_.find(static_cast<int>(encoding));
-      if (it != decoders_.end()) {
-        if (encoding == Encoding::RLE_DICTIONARY) {
-          DCHECK(current_decoder_->encoding() == Encoding::RLE_DICTIONARY);
-        }
-        current_decoder_ = it->second.get();
-      } else {
-        switch (encoding) {
-          case Encoding::PLAIN: {
-            std::shared_ptr<DecoderType> decoder(new PlainDecoder<DType>(descr_));
-            decoders_[static_cast<int>(encoding)] = decoder;
-            current_decoder_ = decoder.get();
-            break;
-          }
-          case Encoding::RLE_DICTIONARY:
-            throw ParquetException("Dictionary page must be before data page.");
-
-          case Encoding::DELTA_BINARY_PACKED:
-          case Encoding::DELTA_LENGTH_BYTE_ARRAY:
-          case Encoding::DELTA_BYTE_ARRAY:
-            ParquetException::NYI("Unsupported encoding");
-
-          default:
-            throw ParquetException("Unknown encoding type.");
-        }
+      num_buffered_values_ = page->num_values();
+      num_decoded_values_ = 0;
+      buffer = page->data();
+      int64_t data_size = page->size();
+
+      // Page Layout: Repetition Levels - Definition Levels - encoded values,
+      // with the byte lengths of the RLE-encoded levels in the page header
+      int32_t rep_levels_bytes = page->repetition_levels_byte_length();
+      int32_t def_levels_bytes = page->definition_levels_byte_length();
+      if (rep_levels_bytes + def_levels_bytes > data_size) {
+        throw ParquetException("Data page levels exceed the page size");
+      }
+      if (descr_->max_repetition_level() > 0) {
+        repetition_level_decoder_.SetDataV2(
+            rep_levels_bytes, descr_->max_repetition_level(),
+            static_cast<int>(num_buffered_values_), buffer);
+      }
+      buffer += rep_levels_bytes;
+      data_size -= rep_levels_bytes;
+      if (descr_->max_definition_level() > 0) {
+        definition_level_decoder_.SetDataV2(
+            def_levels_bytes, descr_->max_definition_level(),
+            static_cast<int>(num_buffered_values_), buffer);
+      }
+      buffer += def_levels_bytes;
+      data_size -= def_levels_bytes;
+
+      if (!levels_only_) {
+        InitializeDataDecoder(page->encoding(), buffer, data_size);
       }
-      current_decoder_->SetData(static_cast<int>(num_buffered_values_), buffer,
-                                static_cast<int>(data_size));
       return true;
     } else {
       // We don't know what this page type is. We're allowed to skip non-data
@@ -238,10 +679,81 @@ bool TypedColumnReader<DType>::ReadNewPage() {
 // ----------------------------------------------------------------------
 // Batch read APIs
 
+template <typename DType>
+inline int PlainDecodeZeroCopy(Decoder<DType>* decoder, int max_values,
+                               const uint8_t** out) {
+  return static_cast<PlainDecoder<DType>*>(decoder)->DecodeZeroCopy(max_values, out);
+}
+
+template <>
+inline int PlainDecodeZeroCopy<BooleanType>(Decoder<BooleanType>* decoder, int max_values,
+                                            const uint8_t** out) {
+  ParquetException::NYI("zero-copy decoding of BOOLEAN values");
+  return 0;
+}
+
+template <typename DType>
+int TypedColumnReader<DType>::DecodePlainZeroCopy(int max_values, const uint8_t** out) {
+  return PlainDecodeZeroCopy<DType>(current_decoder_, max_values, out);
+}
+
+template <typename DType>
+int TypedColumnReader<DType>::DecodeDictionaryIndices(int32_t* indices, int max_values) {
+  auto decoder = static_cast<DictionaryDecoder<DType>*>(current_decoder_);
+  return decoder->DecodeIndices(indices, max_values);
+}
+
+template <typename DType>
+bool TypedColumnReader<DType>::ReadBatchZeroCopy(int64_t batch_size,
+                                                 std::shared_ptr<Buffer>* values,
+                                                 int64_t* values_read) {
+  *values_read = 0;
+  if (descr_->max_definition_level() > 0 || descr_->max_repetition_level() > 0) {
+    return false;
+  }
+  switch (descr_->physical_type()) {
+    case Type::INT32:
+    case Type::INT64:
+    case Type::INT96:
+    case Type::FLOAT:
+    case Type::DOUBLE:
+      break;
+    default:
+      return false;
+  }
+
+  // HasNext invokes ReadNewPage
+  if (!HasNext() || current_decoder_->encoding() != Encoding::PLAIN) {
+    return false;
+  }
+
+  // Only slices share the ownership of their memory, other page buffers may
+  // be reused by the page reader
+  std::shared_ptr<Buffer> page_buffer = current_page_->buffer();
+  if (page_buffer->parent() == nullptr) {
+    return false;
+  }
+
+  batch_size = std::min(batch_size, num_buffered_values_ - num_decoded_values_);
+  const uint8_t* data;
+  int num_decoded;
+  {
+    ScopedStopWatch watch(StatsCounter(stats_, &ColumnReaderStats::value_decoding_time));
+    num_decoded =
+        PlainDecodeZeroCopy<DType>(current_decoder_, static_cast<int>(batch_size), &data);
+  }
+  *values = std::make_shared<Buffer>(page_buffer, data - page_buffer->data(),
+                                     num_decoded * sizeof(T));
+  *values_read = num_decoded;
+  num_decoded_values_ += num_decoded;
+  return true;
+}
+
 int64_t ColumnReader::ReadDefinitionLevels(int64_t batch_size, int16_t* levels) {
   if (descr_->max_definition_level() == 0) {
     return 0;
   }
+  ScopedStopWatch watch(StatsCounter(stats_, &ColumnReaderStats::level_decoding_time));
   return definition_level_decoder_.Decode(static_cast<int>(batch_size), levels);
 }
 
@@ -249,6 +761,7 @@ int64_t ColumnReader::ReadRepetitionLevels(int64_t batch_size, int16_t* levels)
   if (descr_->max_repetition_level() == 0) {
     return 0;
   }
+  ScopedStopWatch watch(StatsCounter(stats_, &ColumnReaderStats::level_decoding_time));
   return repetition_level_decoder_.Decode(static_cast<int>(batch_size), levels);
 }
 
@@ -282,6 +795,44 @@ std::shared_ptr<ColumnReader> ColumnReader::Make(const ColumnDescriptor* descr,
   return std::shared_ptr<ColumnReader>(nullptr);
 }
 
+template <>
+int64_t TypedColumnReader<BooleanType>::ReadBatchBitmap(
+    int64_t batch_size, uint8_t* values, int64_t values_offset, uint8_t* valid_bits,
+    int64_t valid_bits_offset, int64_t* null_count) {
+  *null_count = 0;
+  if (descr_->max_repetition_level() > 0 || descr_->max_definition_level() > 1) {
+    throw ParquetException("ReadBatchBitmap only supports flat columns");
+  }
+  // HasNext invokes ReadNewPage
+  if (!HasNext()) {
+    return 0;
+  }
+  batch_size = std::min(batch_size, num_buffered_values_ - num_decoded_values_);
+
+  // BOOLEAN columns have no dictionary encoding, so their pages are PLAIN
+  DCHECK(current_decoder_->encoding() == Encoding::PLAIN);
+  auto decoder = static_cast<PlainDecoder<BooleanType>*>(current_decoder_);
+  int64_t num_values;
+  if (descr_->max_definition_level() > 0) {
+    {
+      ScopedStopWatch watch(
+          StatsCounter(stats_, &ColumnReaderStats::level_decoding_time));
+      num_values = definition_level_decoder_.DecodeBitmap(
+          static_cast<int>(batch_size), valid_bits, valid_bits_offset, null_count);
+    }
+    ScopedStopWatch watch(StatsCounter(stats_, &ColumnReaderStats::value_decoding_time));
+    decoder->DecodeBitmapSpaced(values, values_offset, static_cast<int>(num_values),
+                                static_cast<int>(*null_count), valid_bits,
+                                valid_bits_offset);
+  } else {
+    ScopedStopWatch watch(StatsCounter(stats_, &ColumnReaderStats::value_decoding_time));
+    num_values =
+        decoder->DecodeBitmap(values, values_offset, static_cast<int>(batch_size));
+  }
+  num_decoded_values_ += num_values;
+  return num_values;
+}
+
 // ----------------------------------------------------------------------
 // Instantiate templated classes
 
@@ -23,17 +23,24 @@
 #include <cstring>
 #include <iostream>
 #include <memory>
+#include <type_traits>
 #include <unordered_map>
 #include <vector>
 
 #include <arrow/util/bit-util.h>
 
+#if defined(PARQUET_USE_SSE) && defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 #include "parquet/column_page.h"
 #include "parquet/encoding.h"
 #include "parquet/exception.h"
+#include "parquet/properties.h"
 #include "parquet/schema.h"
 #include "parquet/types.h"
 #include "parquet/util/memory.h"
+#include "parquet/util/stopwatch.h"
 #include "parquet/util/visibility.h"
 
 namespace arrow {
@@ -55,15 +62,57 @@ class PARQUET_EXPORT LevelDecoder {
   int SetData(Encoding::type encoding, int16_t max_level, int num_buffered_values,
               const uint8_t* data);
 
+  // Initialize the LevelDecoder state with the RLE-encoded levels of a
+  // DATA_PAGE_V2 page, which are not prefixed by their length
+  void SetDataV2(int32_t num_bytes, int16_t max_level, int num_buffered_values,
+                 const uint8_t* data);
+
   // Decodes a batch of levels into an array and returns the number of levels decoded
   int Decode(int batch_size, int16_t* levels);
 
+  // Decodes a batch of levels of maximum level 1 into a validity bitmap, in
+  // which the levels equal to 1 are set, and returns the number of levels
+  // decoded. null_count is incremented by the number of levels equal to 0.
+  int DecodeBitmap(int batch_size, uint8_t* valid_bits, int64_t valid_bits_offset,
+                   int64_t* null_count);
+
  private:
+  void SetRleData(const uint8_t* data, int32_t num_bytes);
+
+  // RLE-encoded levels of bit width 1 or 2 are decoded here rather than by
+  // RleDecoder, expanding bit-packed runs a byte at a time. Reads the header
+  // of the next run, and returns false at the end of the data.
+  bool NextRun();
+  int DecodeRuns(int num_values, int16_t* levels);
+  int DecodeRunsToBitmap(int num_values, uint8_t* valid_bits, int64_t valid_bits_offset,
+                         int64_t* null_count);
+
   int bit_width_;
   int num_values_remaining_;
   Encoding::type encoding_;
   std::unique_ptr<::arrow::RleDecoder> rle_decoder_;
   std::unique_ptr<::arrow::BitReader> bit_packed_decoder_;
+
+  bool decode_runs_;
+  const uint8_t* run_data_;
+  const uint8_t* run_data_end_;
+  int repeat_count_;
+  int16_t repeat_value_;
+  int literal_count_;
+  const uint8_t* literal_data_;
+  int64_t literal_bit_offset_;
+};
+
+// The arrangements of levels for which the read paths are specialized
+struct ColumnShape {
+  enum type {
+    // No definition or repetition levels
+    REQUIRED,
+    // Definition levels 0 (null) or 1 (value), no repetition levels
+    FLAT_OPTIONAL,
+    // Any other column: repeated, or nested under optional groups
+    NESTED
+  };
 };
 
 class PARQUET_EXPORT ColumnReader {
@@ -92,6 +141,36 @@ class PARQUET_EXPORT ColumnReader {
 
   const ColumnDescriptor* descr() const { return descr_; }
 
+  // Determined once from the descriptor
+  ColumnShape::type shape() const { return shape_; }
+
+  // Count the dictionary encoded pages and skipped rows, and time the decoding
+  // of levels and values. The stats are not owned.
+  void set_stats(ColumnReaderStats* stats) { stats_ = stats; }
+
+  // If set before the first read, data pages are only read for their levels:
+  // dictionary pages are dropped and no value decoder is set up, and for
+  // DATA_PAGE_V2 pages the PageReader may not even decompress the values.
+  // Only ReadLevelsOnly and Skip may be used to read the column then.
+  void set_levels_only(bool levels_only) {
+    levels_only_ = levels_only;
+    pager_->set_levels_only(levels_only);
+  }
+
+  bool levels_only() const { return levels_only_; }
+
+  // Read a batch of repetition and definition levels of the current data
+  // page, without decoding the values. *values_read is set to the number of
+  // non-null values among them, i.e. levels at the maximum definition level.
+  //
+  // def_levels and rep_levels may be nullptr if not needed; the definition
+  // levels are still decoded to count the values. Throws unless the reader
+  // was set to levels only.
+  //
+  // @returns: the number of levels read
+  int64_t ReadLevelsOnly(int64_t batch_size, int16_t* def_levels, int16_t* rep_levels,
+                         int64_t* values_read);
+
  protected:
   virtual bool ReadNewPage() = 0;
 
@@ -105,6 +184,7 @@ class PARQUET_EXPORT ColumnReader {
   int64_t ReadRepetitionLevels(int64_t batch_size, int16_t* levels);
 
   const ColumnDescriptor* descr_;
+  ColumnShape::type shape_;
 
   std::unique_ptr<PageReader> pager_;
   std::shared_ptr<Page> current_page_;
@@ -128,6 +208,14 @@ class PARQUET_EXPORT ColumnReader {
   int64_t num_decoded_values_;
 
   ::arrow::MemoryPool* pool_;
+
+  // nullptr unless statistics are collected
+  ColumnReaderStats* stats_;
+
+  bool levels_only_;
+
+  // Definition levels decoded by ReadLevelsOnly when none are requested
+  std::vector<int16_t> scratch_def_levels_;
 };
 
 // API to read values from a single column. This is the main client facing API.
@@ -138,7 +226,9 @@ class PARQUET_EXPORT TypedColumnReader : public ColumnReader {
 
   TypedColumnReader(const ColumnDescriptor* schema, std::unique_ptr<PageReader> pager,
                     ::arrow::MemoryPool* pool = ::arrow::default_memory_pool())
-      : ColumnReader(schema, std::move(pager), pool), current_decoder_(NULL) {}
+      : ColumnReader(schema, std::move(pager), pool),
+        current_decoder_(NULL),
+        has_page_filter_(false) {}
   virtual ~TypedColumnReader() {}
 
   // Read a batch of repetition levels, definition levels, and values from the
@@ -161,6 +251,29 @@ class PARQUET_EXPORT TypedColumnReader : public ColumnReader {
   int64_t ReadBatch(int64_t batch_size, int16_t* def_levels, int16_t* rep_levels,
                     T* values, int64_t* values_read);
 
+  // Like ReadBatch, but keeps reading data pages until batch_size levels are
+  // read or the column chunk is exhausted, instead of stopping at the end of
+  // the current page.
+  //
+  // BYTE_ARRAY and FIXED_LEN_BYTE_ARRAY values point into the page data,
+  // whose buffer may be reused for the next page, so batches of these types
+  // still end with their page.
+  int64_t ReadBatchFull(int64_t batch_size, int16_t* def_levels, int16_t* rep_levels,
+                        T* values, int64_t* values_read);
+
+  // Like ReadBatch, but reads the dictionary indices of the values into
+  // indices instead of the values themselves, as long as the current data
+  // page is dictionary-encoded. The indices refer to dictionary(). Returns -1
+  // without reading anything if the current page is not dictionary-encoded,
+  // e.g. after the writer fell back to PLAIN; read it with ReadBatch then.
+  int64_t ReadBatchIndices(int64_t batch_size, int16_t* def_levels,
+                           int16_t* rep_levels, int32_t* indices,
+                           int64_t* values_read);
+
+  // The values of the dictionary page of the column chunk, nullptr if there
+  // is none or it was not read yet. Valid for the lifetime of the reader.
+  const T* dictionary(int* length) const;
+
   /// Read a batch of repetition levels, definition levels, and values from the
   /// column and leave spaces for null entries on the lowest level in the values
   /// buffer.
@@ -200,16 +313,88 @@ class PARQUET_EXPORT TypedColumnReader : public ColumnReader {
                           int64_t* levels_read, int64_t* values_read,
                           int64_t* null_count);
 
+  // ReadBatchSpaced specialized at compile time for the shape of the column,
+  // which must be shape(). The REQUIRED path decodes the values only, leaving
+  // the levels and valid_bits untouched; the FLAT_OPTIONAL path decodes the
+  // definition levels straight into valid_bits. NESTED columns take the
+  // generic path.
+  template <ColumnShape::type SHAPE>
+  int64_t ReadBatchSpacedAs(int64_t batch_size, int16_t* def_levels,
+                            int16_t* rep_levels, T* values, uint8_t* valid_bits,
+                            int64_t valid_bits_offset, int64_t* levels_read,
+                            int64_t* values_read, int64_t* null_count);
+
+  // Read up to batch_size values of a REQUIRED column of the current data
+  // page, storing convert(value) into out. The encoding of the page is
+  // dispatched on once per call to a loop in which the decoding and the
+  // conversion are inlined together: fixed-width PLAIN values are converted
+  // straight from the page data, and dictionary-encoded values from the
+  // dictionary, without an intermediate buffer of values. Other encodings are
+  // decoded in small blocks first.
+  //
+  // @returns: the number of values read
+  template <typename OutType, typename Converter>
+  int64_t ReadBatchConverted(int64_t batch_size, OutType* out, Converter&& convert);
+
+  // BOOLEAN only: reads a flat column like ReadBatchSpaced, but the values
+  // are written as a bitmap, starting at bit values_offset of values, and the
+  // bits of the null slots are cleared. PLAIN pages are copied bit for bit and
+  // the definition levels are decoded straight into valid_bits, which is
+  // unused for required columns.
+  //
+  // @returns: the number of values read, including the nulls
+  int64_t ReadBatchBitmap(int64_t batch_size, uint8_t* values, int64_t values_offset,
+                          uint8_t* valid_bits, int64_t valid_bits_offset,
+                          int64_t* null_count);
+
+  // Zero-copy variant of ReadBatch for required, non-repeated columns of a
+  // fixed-width physical type (INT32, INT64, INT96, FLOAT, DOUBLE). Sets
+  // *values to a slice of the current data page holding up to batch_size
+  // values.
+  //
+  // This only succeeds for PLAIN-encoded pages whose buffer shares ownership
+  // of its memory, such as uncompressed pages read from a memory map, so that
+  // the slice stays valid after the reader moves on. Otherwise returns false
+  // without reading anything.
+  bool ReadBatchZeroCopy(int64_t batch_size, std::shared_ptr<Buffer>* values,
+                         int64_t* values_read);
+
   // Skip reading levels
   // Returns the number of levels skipped
+  //
+  // For flat columns, the data pages covered entirely by the skip are dropped
+  // using their header, without being read or decompressed, when the
+  // PageReader supports it.
   int64_t Skip(int64_t num_rows_to_skip);
 
+  // Skip the data pages whose statistics show that they hold no value in
+  // [min, max]; pass min == max for an equality test. Pages are skipped
+  // before being decompressed when the PageReader supports it. Pages without
+  // min/max statistics are always read, and the filter is ignored for columns
+  // whose statistics are not in SIGNED sort order.
+  //
+  // Values of skipped pages are left out of the column entirely, so the
+  // values read no longer line up with the other columns of the row group.
+  // The pages that are read may still hold values outside of [min, max].
+  void SetPageFilter(const T& min, const T& max);
+
  private:
   typedef Decoder<DType> DecoderType;
 
   // Advance to the next data page
   virtual bool ReadNewPage();
 
+  // Read the levels of the next batch_size values of the current data page
+  // and count the non-null values to decode among them
+  //
+  // @returns: the number of levels read
+  int64_t ReadLevels(int64_t batch_size, int16_t* def_levels, int16_t* rep_levels,
+                     int64_t* values_to_read);
+
+  // Set up the decoder of the values of the new data page
+  void InitializeDataDecoder(Encoding::type encoding, const uint8_t* buffer,
+                             int64_t data_size);
+
   // Read up to batch_size values from the current data page into the
   // pre-allocated memory T*
   //
@@ -224,6 +409,16 @@ class PARQUET_EXPORT TypedColumnReader : public ColumnReader {
   int64_t ReadValuesSpaced(int64_t batch_size, T* out, int null_count,
                            uint8_t* valid_bits, int64_t valid_bits_offset);
 
+  // Set *out to the location in the page data of up to max_values values of
+  // the current PLAIN data page, and skip them. Fixed-width types only.
+  //
+  // @returns: the number of values skipped
+  int DecodePlainZeroCopy(int max_values, const uint8_t** out);
+
+  // Decode up to max_values dictionary indices of the current
+  // dictionary-encoded data page
+  int DecodeDictionaryIndices(int32_t* indices, int max_values);
+
   // Map of encoding type to the respective decoder object. For example, a
   // column chunk's data pages may include both dictionary-encoded and
   // plain-encoded data.
@@ -231,11 +426,25 @@ class PARQUET_EXPORT TypedColumnReader : public ColumnReader {
 
   void ConfigureDictionary(const DictionaryPage* page);
 
+  // Returns false if the page statistics rule out all values of the range
+  // passed to SetPageFilter
+  bool PageMayMatch(const EncodedStatistics& stats);
+
   DecoderType* current_decoder_;
+
+  bool has_page_filter_;
+  T filter_min_;
+  T filter_max_;
 };
 
+template <>
+int64_t TypedColumnReader<BooleanType>::ReadBatchBitmap(
+    int64_t batch_size, uint8_t* values, int64_t values_offset, uint8_t* valid_bits,
+    int64_t valid_bits_offset, int64_t* null_count);
+
 template <typename DType>
 inline int64_t TypedColumnReader<DType>::ReadValues(int64_t batch_size, T* out) {
+  ScopedStopWatch watch(StatsCounter(stats_, &ColumnReaderStats::value_decoding_time));
   int64_t num_decoded = current_decoder_->Decode(out, static_cast<int>(batch_size));
   return num_decoded;
 }
@@ -245,6 +454,7 @@ inline int64_t TypedColumnReader<DType>::ReadValuesSpaced(int64_t batch_size, T*
                                                           int null_count,
                                                           uint8_t* valid_bits,
                                                           int64_t valid_bits_offset) {
+  ScopedStopWatch watch(StatsCounter(stats_, &ColumnReaderStats::value_decoding_time));
   return current_decoder_->DecodeSpaced(out, static_cast<int>(batch_size), null_count,
                                         valid_bits, valid_bits_offset);
 }
@@ -264,10 +474,52 @@ inline int64_t TypedColumnReader<DType>::ReadBatch(int64_t batch_size,
   // row group is finished
   batch_size = std::min(batch_size, num_buffered_values_ - num_decoded_values_);
 
+  int64_t values_to_read = 0;
+  int64_t num_def_levels =
+      ReadLevels(batch_size, def_levels, rep_levels, &values_to_read);
+
+  *values_read = ReadValues(values_to_read, values);
+  int64_t total_values = std::max(num_def_levels, *values_read);
+  num_decoded_values_ += total_values;
+
+  return total_values;
+}
+
+template <typename DType>
+inline int64_t TypedColumnReader<DType>::ReadBatchFull(int64_t batch_size,
+                                                       int16_t* def_levels,
+                                                       int16_t* rep_levels, T* values,
+                                                       int64_t* values_read) {
+  constexpr bool kValuesOutlivePage = !std::is_same<T, ByteArray>::value &&
+                                      !std::is_same<T, FixedLenByteArray>::value;
+  int64_t total_levels = 0;
+  *values_read = 0;
+  while (total_levels < batch_size) {
+    int64_t batch_values = 0;
+    int64_t batch_levels = ReadBatch(
+        batch_size - total_levels, def_levels ? def_levels + total_levels : nullptr,
+        rep_levels ? rep_levels + total_levels : nullptr,
+        values ? values + *values_read : nullptr, &batch_values);
+    if (batch_levels == 0) {
+      break;
+    }
+    total_levels += batch_levels;
+    *values_read += batch_values;
+    if (!kValuesOutlivePage) {
+      break;
+    }
+  }
+  return total_levels;
+}
+
+template <typename DType>
+inline int64_t TypedColumnReader<DType>::ReadLevels(int64_t batch_size,
+                                                    int16_t* def_levels,
+                                                    int16_t* rep_levels,
+                                                    int64_t* values_to_read) {
   int64_t num_def_levels = 0;
   int64_t num_rep_levels = 0;
-
-  int64_t values_to_read = 0;
+  *values_to_read = 0;
 
   // If the field is required and non-repeated, there are no definition levels
   if (descr_->max_definition_level() > 0 && def_levels) {
@@ -276,12 +528,12 @@ inline int64_t TypedColumnReader<DType>::ReadBatch(int64_t batch_size,
     // cache-efficiency if fused with the level decoding.
     for (int64_t i = 0; i < num_def_levels; ++i) {
       if (def_levels[i] == descr_->max_definition_level()) {
-        ++values_to_read;
+        ++*values_to_read;
       }
     }
   } else {
     // Required field, read all values
-    values_to_read = batch_size;
+    *values_to_read = batch_size;
   }
 
   // Not present for non-repeated fields
@@ -291,12 +543,67 @@ inline int64_t TypedColumnReader<DType>::ReadBatch(int64_t batch_size,
       throw ParquetException("Number of decoded rep / def levels did not match");
     }
   }
+  return num_def_levels;
+}
 
-  *values_read = ReadValues(values_to_read, values);
-  int64_t total_values = std::max(num_def_levels, *values_read);
-  num_decoded_values_ += total_values;
-
-  return total_values;
+// DefinitionLevelsToBitmap for flat optional columns, whose definition levels
+// are 0 for nulls and 1 for values. Whole bytes of the bitmap are written at
+// once, 16 levels at a time with SSE2.
+inline void FlatDefinitionLevelsToBitmap(const int16_t* def_levels,
+                                         int64_t num_def_levels, int64_t* values_read,
+                                         int64_t* null_count, uint8_t* valid_bits,
+                                         int64_t valid_bits_offset) {
+  int64_t i = 0;
+  int64_t num_values = 0;
+  // Up to the first byte boundary of the bitmap
+  for (; i < num_def_levels && (valid_bits_offset + i) % 8 != 0; ++i) {
+    if (def_levels[i] == 1) {
+      ::arrow::BitUtil::SetBit(valid_bits, valid_bits_offset + i);
+      ++num_values;
+    } else {
+      ::arrow::BitUtil::ClearBit(valid_bits, valid_bits_offset + i);
+    }
+  }
+  uint8_t* out = valid_bits + (valid_bits_offset + i) / 8;
+
+#if defined(PARQUET_USE_SSE) && defined(__SSE2__)
+  const __m128i ones = _mm_set1_epi16(1);
+  __m128i counts = _mm_setzero_si128();
+  for (; i + 16 <= num_def_levels; i += 16) {
+    __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(def_levels + i));
+    __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(def_levels + i + 8));
+    // One byte per level, 0xFF for values
+    __m128i is_value =
+        _mm_packs_epi16(_mm_cmpeq_epi16(lo, ones), _mm_cmpeq_epi16(hi, ones));
+    int mask = _mm_movemask_epi8(is_value);
+    *out++ = static_cast<uint8_t>(mask);
+    *out++ = static_cast<uint8_t>(mask >> 8);
+    counts = _mm_add_epi64(
+        counts, _mm_sad_epu8(_mm_and_si128(is_value, _mm_set1_epi8(1)),
+                             _mm_setzero_si128()));
+  }
+  num_values += _mm_cvtsi128_si32(counts) + _mm_cvtsi128_si32(_mm_srli_si128(counts, 8));
+#endif
+
+  for (; i + 8 <= num_def_levels; i += 8) {
+    uint8_t byte = 0;
+    for (int j = 0; j < 8; ++j) {
+      uint8_t is_value = def_levels[i + j] == 1;
+      byte = static_cast<uint8_t>(byte | (is_value << j));
+      num_values += is_value;
+    }
+    *out++ = byte;
+  }
+  for (; i < num_def_levels; ++i) {
+    if (def_levels[i] == 1) {
+      ::arrow::BitUtil::SetBit(valid_bits, valid_bits_offset + i);
+      ++num_values;
+    } else {
+      ::arrow::BitUtil::ClearBit(valid_bits, valid_bits_offset + i);
+    }
+  }
+  *null_count += num_def_levels - num_values;
+  *values_read = num_def_levels;
 }
 
 inline void DefinitionLevelsToBitmap(const int16_t* def_levels, int64_t num_def_levels,
@@ -304,6 +611,11 @@ inline void DefinitionLevelsToBitmap(const int16_t* def_levels, int64_t num_def_
                                      int16_t max_repetition_level, int64_t* values_read,
                                      int64_t* null_count, uint8_t* valid_bits,
                                      int64_t valid_bits_offset) {
+  if (max_definition_level == 1 && max_repetition_level == 0) {
+    FlatDefinitionLevelsToBitmap(def_levels, num_def_levels, values_read, null_count,
+                                 valid_bits, valid_bits_offset);
+    return;
+  }
   int byte_offset = static_cast<int>(valid_bits_offset) / 8;
   int bit_offset = static_cast<int>(valid_bits_offset) % 8;
   uint8_t bitset = valid_bits[byte_offset];
@@ -436,10 +748,135 @@ inline int64_t TypedColumnReader<DType>::ReadBatchSpaced(
   return total_values;
 }
 
+template <typename DType>
+template <ColumnShape::type SHAPE>
+inline int64_t TypedColumnReader<DType>::ReadBatchSpacedAs(
+    int64_t batch_size, int16_t* def_levels, int16_t* rep_levels, T* values,
+    uint8_t* valid_bits, int64_t valid_bits_offset, int64_t* levels_read,
+    int64_t* values_read, int64_t* null_count_out) {
+  if (SHAPE == ColumnShape::NESTED) {
+    return ReadBatchSpaced(batch_size, def_levels, rep_levels, values, valid_bits,
+                           valid_bits_offset, levels_read, values_read, null_count_out);
+  }
+  // HasNext invokes ReadNewPage
+  if (!HasNext()) {
+    *levels_read = 0;
+    *values_read = 0;
+    *null_count_out = 0;
+    return 0;
+  }
+  batch_size = std::min(batch_size, num_buffered_values_ - num_decoded_values_);
+
+  int64_t total_values;
+  if (SHAPE == ColumnShape::REQUIRED) {
+    total_values = ReadValues(batch_size, values);
+    *values_read = total_values;
+    *levels_read = total_values;
+    *null_count_out = 0;
+  } else {
+    int64_t num_def_levels = ReadDefinitionLevels(batch_size, def_levels);
+    int64_t null_count = 0;
+    FlatDefinitionLevelsToBitmap(def_levels, num_def_levels, values_read, &null_count,
+                                 valid_bits, valid_bits_offset);
+    if (null_count == 0) {
+      total_values = ReadValues(*values_read, values);
+    } else {
+      total_values = ReadValuesSpaced(*values_read, values, static_cast<int>(null_count),
+                                      valid_bits, valid_bits_offset);
+    }
+    *levels_read = num_def_levels;
+    *null_count_out = null_count;
+  }
+  num_decoded_values_ += *levels_read;
+  return total_values;
+}
+
+template <typename DType>
+template <typename OutType, typename Converter>
+inline int64_t TypedColumnReader<DType>::ReadBatchConverted(int64_t batch_size,
+                                                            OutType* out,
+                                                            Converter&& convert) {
+  constexpr bool kFixedWidth = !std::is_same<T, bool>::value &&
+                               !std::is_same<T, ByteArray>::value &&
+                               !std::is_same<T, FixedLenByteArray>::value;
+  // Block size of the indices and of the values of other encodings
+  constexpr int kBlockSize = 256;
+
+  // HasNext invokes ReadNewPage
+  if (!HasNext()) {
+    return 0;
+  }
+  int num_values =
+      static_cast<int>(std::min(batch_size, num_buffered_values_ - num_decoded_values_));
+
+  int num_read = 0;
+  Encoding::type encoding = current_decoder_->encoding();
+  if (kFixedWidth && encoding == Encoding::PLAIN) {
+    ScopedStopWatch watch(StatsCounter(stats_, &ColumnReaderStats::value_decoding_time));
+    const uint8_t* data;
+    num_read = DecodePlainZeroCopy(num_values, &data);
+    for (int i = 0; i < num_read; ++i) {
+      T value;
+      memcpy(&value, data + i * sizeof(T), sizeof(T));
+      out[i] = convert(value);
+    }
+  } else if (encoding == Encoding::RLE_DICTIONARY) {
+    ScopedStopWatch watch(StatsCounter(stats_, &ColumnReaderStats::value_decoding_time));
+    int dictionary_length;
+    const T* dictionary_values = dictionary(&dictionary_length);
+    int32_t indices[kBlockSize];
+    while (num_read < num_values) {
+      int num_indices =
+          DecodeDictionaryIndices(indices, std::min(kBlockSize, num_values - num_read));
+      if (num_indices == 0) {
+        break;
+      }
+      for (int i = 0; i < num_indices; ++i) {
+        if (static_cast<uint32_t>(indices[i]) >=
+            static_cast<uint32_t>(dictionary_length)) {
+          throw ParquetException("Dictionary index out of range");
+        }
+        out[num_read + i] = convert(dictionary_values[indices[i]]);
+      }
+      num_read += num_indices;
+    }
+  } else {
+    // ReadValues records the decoding time
+    T values[kBlockSize];
+    while (num_read < num_values) {
+      int num_decoded = static_cast<int>(
+          ReadValues(std::min(kBlockSize, num_values - num_read), values));
+      if (num_decoded == 0) {
+        break;
+      }
+      for (int i = 0; i < num_decoded; ++i) {
+        out[num_read + i] = convert(values[i]);
+      }
+      num_read += num_decoded;
+    }
+  }
+  num_decoded_values_ += num_read;
+  return num_read;
+}
+
 template <typename DType>
 inline int64_t TypedColumnReader<DType>::Skip(int64_t num_rows_to_skip) {
   int64_t rows_to_skip = num_rows_to_skip;
-  while (HasNext() && rows_to_skip > 0) {
+  while (rows_to_skip > 0) {
+    // Values and rows are the same for flat columns, so once the current page
+    // is consumed, the following pages that are skipped entirely are dropped
+    // from their header without being decompressed. Pages rejected by the
+    // page filter must not count as skipped rows.
+    if (num_decoded_values_ == num_buffered_values_ && !has_page_filter_ &&
+        descr_->max_repetition_level() == 0) {
+      rows_to_skip -= pager_->SkipDataPages(rows_to_skip);
+      if (rows_to_skip == 0) {
+        break;
+      }
+    }
+    if (!HasNext()) {
+      break;
+    }
     // If the number of rows to skip is more than the number of undecoded values, skip the
     // Page.
     if (rows_to_skip > (num_buffered_values_ - num_decoded_values_)) {
@@ -461,14 +898,20 @@ inline int64_t TypedColumnReader<DType>::Skip(int64_t num_rows_to_skip) {
 
       do {
         batch_size = std::min(batch_size, rows_to_skip);
-        values_read = ReadBatch(static_cast<int>(batch_size),
-                                reinterpret_cast<int16_t*>(def_levels->mutable_data()),
-                                reinterpret_cast<int16_t*>(rep_levels->mutable_data()),
-                                reinterpret_cast<T*>(vals->mutable_data()), &values_read);
+        int16_t* def_levels_data = reinterpret_cast<int16_t*>(def_levels->mutable_data());
+        int16_t* rep_levels_data = reinterpret_cast<int16_t*>(rep_levels->mutable_data());
+        values_read =
+            levels_only_
+                ? ReadLevelsOnly(batch_size, def_levels_data, rep_levels_data,
+                                 &values_read)
+                : ReadBatch(static_cast<int>(batch_size), def_levels_data,
+                            rep_levels_data, reinterpret_cast<T*>(vals->mutable_data()),
+                            &values_read);
         rows_to_skip -= values_read;
       } while (values_read > 0 && rows_to_skip > 0);
     }
   }
+  UpdateStats(stats_, &ColumnReaderStats::rows_skipped, num_rows_to_skip - rows_to_skip);
   return num_rows_to_skip - rows_to_skip;
 }
 
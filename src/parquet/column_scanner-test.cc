@@ -53,6 +53,8 @@ class TestFlatScanner : public ::testing::Test {
  public:
   typedef typename Type::c_type T;
 
+  TestFlatScanner() : visit_batches_(false) {}
+
   void InitScanner(const ColumnDescriptor* d) {
     std::unique_ptr<PageReader> pager(new test::MockPageReader(pages_));
     scanner_ = Scanner::Make(ColumnReader::Make(d, std::move(pager)));
@@ -83,6 +85,47 @@ class TestFlatScanner : public ::testing::Test {
     ASSERT_FALSE(scanner->Next(&val, &def_level, &rep_level, &is_null));
   }
 
+  // Read the first level with Next, then visit the rest
+  void CheckVisitedResults(int batch_size, const ColumnDescriptor* d) {
+    TypedScanner<Type>* scanner = reinterpret_cast<TypedScanner<Type>*>(scanner_.get());
+    T val;
+    bool is_null = false;
+    int16_t def_level;
+    int16_t rep_level;
+    int j = 0;
+    scanner->SetBatchSize(batch_size);
+    ASSERT_TRUE(scanner->Next(&val, &def_level, &rep_level, &is_null));
+    if (!is_null) {
+      j++;
+    }
+
+    int i = 1;
+    int64_t num_visited = scanner->VisitBatches(
+        [this, d, &i, &j](const int16_t* def_levels, const int16_t* rep_levels,
+                          int num_levels, const T* values, int64_t num_values) {
+          EXPECT_EQ(d->max_definition_level() > 0, def_levels != nullptr);
+          EXPECT_EQ(d->max_repetition_level() > 0, rep_levels != nullptr);
+          for (int k = 0; k < num_levels; k++) {
+            if (def_levels != nullptr) {
+              EXPECT_EQ(def_levels_[i + k], def_levels[k]) << i + k << "D";
+            }
+            if (rep_levels != nullptr) {
+              EXPECT_EQ(rep_levels_[i + k], rep_levels[k]) << i + k << "R";
+            }
+          }
+          for (int64_t k = 0; k < num_values; k++) {
+            EXPECT_EQ(values_[j + k], values[k]) << i << "V" << j + k;
+          }
+          i += num_levels;
+          j += static_cast<int>(num_values);
+          return true;
+        });
+    ASSERT_EQ(num_levels_ - 1, num_visited);
+    ASSERT_EQ(num_levels_, i);
+    ASSERT_EQ(num_values_, j);
+    ASSERT_FALSE(scanner->HasNext());
+  }
+
   void Clear() {
     pages_.clear();
     values_.clear();
@@ -96,7 +139,11 @@ class TestFlatScanner : public ::testing::Test {
                                   values_, data_buffer_, pages_, encoding);
     num_levels_ = num_pages * levels_per_page;
     InitScanner(d);
-    CheckResults(batch_size, d);
+    if (visit_batches_) {
+      CheckVisitedResults(batch_size, d);
+    } else {
+      CheckResults(batch_size, d);
+    }
     Clear();
   }
 
@@ -130,6 +177,7 @@ class TestFlatScanner : public ::testing::Test {
   }
 
  protected:
+  bool visit_batches_;
   int num_levels_;
   int num_values_;
   vector<shared_ptr<Page>> pages_;
@@ -157,6 +205,11 @@ TYPED_TEST(TestFlatScanner, TestPlainScanner) {
   this->ExecuteAll(num_pages, num_levels_per_page, batch_size, 0, Encoding::PLAIN);
 }
 
+TYPED_TEST(TestFlatScanner, TestVisitBatches) {
+  this->visit_batches_ = true;
+  this->ExecuteAll(num_pages, num_levels_per_page, batch_size, 0, Encoding::PLAIN);
+}
+
 TYPED_TEST(TestFlatScanner, TestDictScanner) {
   this->ExecuteAll(num_pages, num_levels_per_page, batch_size, 0,
                    Encoding::RLE_DICTIONARY);
@@ -168,6 +168,69 @@ class PARQUET_EXPORT TypedScanner : public Scanner {
     return true;
   }
 
+  // Call visitor(def_levels, rep_levels, num_levels, values, num_values) on
+  // each batch of levels read from the column, starting with those still
+  // buffered by Next or NextValue, until the column is exhausted or the
+  // visitor returns false. The levels and values of a batch are contiguous;
+  // def_levels (rep_levels) is nullptr if the column has no definition
+  // (repetition) levels. Returns the number of levels visited.
+  template <typename Visitor>
+  int64_t VisitBatches(Visitor&& visitor) {
+    const bool has_def_levels = descr()->max_definition_level() > 0;
+    const bool has_rep_levels = descr()->max_repetition_level() > 0;
+    int64_t num_visited = 0;
+    while (true) {
+      if (level_offset_ == levels_buffered_) {
+        levels_buffered_ = static_cast<int>(
+            typed_reader_->ReadBatch(static_cast<int>(batch_size_), def_levels_.data(),
+                                     rep_levels_.data(), values_, &values_buffered_));
+        value_offset_ = 0;
+        level_offset_ = 0;
+        if (!levels_buffered_) {
+          break;
+        }
+      }
+      int num_levels = levels_buffered_ - level_offset_;
+      bool more = visitor(has_def_levels ? def_levels_.data() + level_offset_ : nullptr,
+                          has_rep_levels ? rep_levels_.data() + level_offset_ : nullptr,
+                          num_levels, static_cast<const T*>(values_ + value_offset_),
+                          values_buffered_ - value_offset_);
+      num_visited += num_levels;
+      level_offset_ = levels_buffered_;
+      value_offset_ = static_cast<int>(values_buffered_);
+      if (!more) {
+        break;
+      }
+    }
+    return num_visited;
+  }
+
+  // Call on_value(value) for each non-null value and on_null() for each null
+  // of the rest of the column, in order. Returns the number of levels visited.
+  template <typename ValueFunc, typename NullFunc>
+  int64_t VisitValues(ValueFunc&& on_value, NullFunc&& on_null) {
+    const int16_t max_def_level = descr()->max_definition_level();
+    return VisitBatches([&on_value, &on_null, max_def_level](
+        const int16_t* def_levels, const int16_t*, int num_levels,
+        const T* values, int64_t num_values) {
+      if (def_levels == nullptr) {
+        for (int64_t i = 0; i < num_values; ++i) {
+          on_value(values[i]);
+        }
+        return true;
+      }
+      int64_t value_index = 0;
+      for (int i = 0; i < num_levels; ++i) {
+        if (def_levels[i] == max_def_level) {
+          on_value(values[value_index++]);
+        } else {
+          on_null();
+        }
+      }
+      return true;
+    });
+  }
+
   virtual void PrintNext(std::ostream& out, int width) {
     T val;
     bool is_null = false;
@@ -243,8 +306,8 @@ int64_t ScanAll(int32_t batch_size, int16_t* def_levels, int16_t* rep_levels,
   typedef typename RType::T Type;
   auto typed_reader = static_cast<RType*>(reader);
   auto vals = reinterpret_cast<Type*>(&values[0]);
-  return typed_reader->ReadBatch(batch_size, def_levels, rep_levels, vals,
-                                 values_buffered);
+  return typed_reader->ReadBatchFull(batch_size, def_levels, rep_levels, vals,
+                                     values_buffered);
 }
 
 int64_t PARQUET_EXPORT ScanAllValues(int32_t batch_size, int16_t* def_levels,
@@ -71,11 +71,6 @@ class TestPrimitiveWriter : public PrimitiveTypedTest<TestType> {
   std::shared_ptr<TypedColumnWriter<TestType>> BuildWriter(
       int64_t output_size = SMALL_SIZE,
       const ColumnProperties& column_properties = ColumnProperties()) {
-    sink_.reset(new InMemoryOutputStream());
-    metadata_ = ColumnChunkMetaDataBuilder::Make(
-        writer_properties_, this->descr_, reinterpret_cast<uint8_t*>(&thrift_metadata_));
-    std::unique_ptr<SerializedPageWriter> pager(
-        new SerializedPageWriter(sink_.get(), column_properties.codec, metadata_.get()));
     WriterProperties::Builder wp_builder;
     if (column_properties.encoding == Encoding::PLAIN_DICTIONARY ||
         column_properties.encoding == Encoding::RLE_DICTIONARY) {
@@ -84,7 +79,19 @@ class TestPrimitiveWriter : public PrimitiveTypedTest<TestType> {
       wp_builder.disable_dictionary();
       wp_builder.encoding(column_properties.encoding);
     }
-    writer_properties_ = wp_builder.build();
+    return BuildWriterWithProperties(output_size, column_properties.codec,
+                                     wp_builder.build());
+  }
+
+  std::shared_ptr<TypedColumnWriter<TestType>> BuildWriterWithProperties(
+      int64_t output_size, Compression::type codec,
+      const std::shared_ptr<WriterProperties>& writer_properties) {
+    writer_properties_ = writer_properties;
+    sink_.reset(new InMemoryOutputStream());
+    metadata_ = ColumnChunkMetaDataBuilder::Make(
+        writer_properties_, this->descr_, reinterpret_cast<uint8_t*>(&thrift_metadata_));
+    std::unique_ptr<SerializedPageWriter> pager(
+        new SerializedPageWriter(sink_.get(), codec, metadata_.get()));
     std::shared_ptr<ColumnWriter> writer = ColumnWriter::Make(
         metadata_.get(), std::move(pager), output_size, writer_properties_.get());
     return std::static_pointer_cast<TypedColumnWriter<TestType>>(writer);
@@ -100,6 +107,21 @@ class TestPrimitiveWriter : public PrimitiveTypedTest<TestType> {
 
   void ReadColumnFully(Compression::type compression = Compression::UNCOMPRESSED);
 
+  // Number of values of each of the data pages that were written
+  std::vector<int32_t> DataPageValueCounts(int64_t num_rows) {
+    auto buffer = sink_->GetBuffer();
+    std::unique_ptr<InMemoryInputStream> source(new InMemoryInputStream(buffer));
+    SerializedPageReader page_reader(std::move(source), num_rows,
+                                     Compression::UNCOMPRESSED);
+    std::vector<int32_t> counts;
+    while (std::shared_ptr<Page> page = page_reader.NextPage()) {
+      if (page->type() == PageType::DATA_PAGE) {
+        counts.push_back(static_cast<const DataPage*>(page.get())->num_values());
+      }
+    }
+    return counts;
+  }
+
   void TestRequiredWithEncoding(Encoding::type encoding) {
     return TestRequiredWithSettings(encoding, Compression::UNCOMPRESSED, false, false);
   }
@@ -290,6 +312,96 @@ TYPED_TEST(TestPrimitiveWriter, RequiredRLEDictionary) {
 }
 */
 
+typedef ::testing::Types<Int32Type, Int64Type> TestIntegerTypes;
+
+template <typename TestType>
+class TestIntegerWriter : public TestPrimitiveWriter<TestType> {};
+
+TYPED_TEST_CASE(TestIntegerWriter, TestIntegerTypes);
+
+TYPED_TEST(TestIntegerWriter, RequiredDeltaBinaryPacked) {
+  this->TestRequiredWithEncoding(Encoding::DELTA_BINARY_PACKED);
+}
+
+TYPED_TEST(TestIntegerWriter, RequiredDeltaBinaryPackedLargeChunk) {
+  this->TestRequiredWithSettings(Encoding::DELTA_BINARY_PACKED,
+                                 Compression::UNCOMPRESSED, false, true, LARGE_SIZE);
+}
+
+typedef ::testing::Types<FloatType, DoubleType> TestFloatingPointTypes;
+
+template <typename TestType>
+class TestFloatingPointWriter : public TestPrimitiveWriter<TestType> {};
+
+TYPED_TEST_CASE(TestFloatingPointWriter, TestFloatingPointTypes);
+
+TYPED_TEST(TestFloatingPointWriter, RequiredByteStreamSplit) {
+  this->TestRequiredWithEncoding(Encoding::BYTE_STREAM_SPLIT);
+}
+
+TYPED_TEST(TestFloatingPointWriter, RequiredByteStreamSplitWithSnappyCompression) {
+  this->TestRequiredWithSettings(Encoding::BYTE_STREAM_SPLIT, Compression::SNAPPY, false,
+                                 true, LARGE_SIZE);
+}
+
+TYPED_TEST(TestPrimitiveWriter, RequiredDictionaryManyPagesWithSnappyCompression) {
+  // The pages buffered until the dictionary page is written keep their buffers
+  this->GenerateData(LARGE_SIZE);
+  WriterProperties::Builder builder;
+  builder.data_pagesize(1024)->write_batch_size(100)->compression(Compression::SNAPPY);
+  auto writer =
+      this->BuildWriterWithProperties(LARGE_SIZE, Compression::SNAPPY, builder.build());
+  writer->WriteBatch(this->values_.size(), nullptr, nullptr, this->values_ptr_);
+  writer->Close();
+
+  this->SetupValuesOut(LARGE_SIZE);
+  this->ReadColumnFully(Compression::SNAPPY);
+  ASSERT_EQ(LARGE_SIZE, this->values_read_);
+  ASSERT_EQ(this->values_, this->values_out_);
+}
+
+TYPED_TEST(TestPrimitiveWriter, RequiredPlainFromBuffer) {
+  // The PLAIN pages reference the values of the buffer, across the batches
+  using T = typename TypeParam::c_type;
+  this->GenerateData(LARGE_SIZE);
+  auto values_buffer =
+      std::make_shared<Buffer>(reinterpret_cast<const uint8_t*>(this->values_ptr_),
+                               LARGE_SIZE * static_cast<int64_t>(sizeof(T)));
+  for (auto codec : {Compression::UNCOMPRESSED, Compression::SNAPPY}) {
+    WriterProperties::Builder builder;
+    builder.disable_dictionary()->data_pagesize(1024)->write_batch_size(100);
+    builder.compression(codec);
+    auto writer = this->BuildWriterWithProperties(LARGE_SIZE, codec, builder.build());
+    const int64_t half = LARGE_SIZE / 2;
+    writer->WriteBatch(half, nullptr, nullptr, this->values_ptr_, values_buffer);
+    writer->WriteBatch(LARGE_SIZE - half, nullptr, nullptr, this->values_ptr_ + half,
+                       values_buffer);
+    writer->Close();
+
+    this->SetupValuesOut(LARGE_SIZE);
+    this->ReadColumnFully(codec);
+    ASSERT_EQ(LARGE_SIZE, this->values_read_);
+    ASSERT_EQ(this->values_, this->values_out_);
+  }
+}
+
+TYPED_TEST(TestPrimitiveWriter, RequiredPlainWithDataPageValuesLimit) {
+  this->GenerateData(LARGE_SIZE);
+  WriterProperties::Builder builder;
+  builder.disable_dictionary()->data_page_values_limit(300);
+  auto writer = this->BuildWriterWithProperties(LARGE_SIZE, Compression::UNCOMPRESSED,
+                                                builder.build());
+  writer->WriteBatch(this->values_.size(), nullptr, nullptr, this->values_ptr_);
+  writer->Close();
+
+  std::vector<int32_t> counts = this->DataPageValueCounts(LARGE_SIZE);
+  ASSERT_EQ(static_cast<size_t>((LARGE_SIZE + 299) / 300), counts.size());
+  for (size_t i = 0; i + 1 < counts.size(); i++) {
+    ASSERT_EQ(300, counts[i]);
+  }
+  ASSERT_EQ(LARGE_SIZE % 300, counts.back());
+}
+
 TYPED_TEST(TestPrimitiveWriter, RequiredPlainWithSnappyCompression) {
   this->TestRequiredWithSettings(Encoding::PLAIN, Compression::SNAPPY, false, false,
                                  LARGE_SIZE);
@@ -476,6 +588,218 @@ TYPED_TEST(TestPrimitiveWriter, RequiredVeryLargeChunk) {
   }
 }
 
+using TestByteArrayValuesWriter = TestPrimitiveWriter<ByteArrayType>;
+
+TEST_F(TestByteArrayValuesWriter, RequiredDeltaLengthByteArray) {
+  this->TestRequiredWithEncoding(Encoding::DELTA_LENGTH_BYTE_ARRAY);
+}
+
+TEST_F(TestByteArrayValuesWriter, RequiredDeltaByteArray) {
+  this->TestRequiredWithSettings(Encoding::DELTA_BYTE_ARRAY, Compression::UNCOMPRESSED,
+                                 false, true, LARGE_SIZE);
+}
+
+// The dictionary falls back to the encoding of the column
+TEST_F(TestByteArrayValuesWriter, DictionaryFallbackToDeltaByteArray) {
+  this->GenerateData(VERY_LARGE_SIZE);
+
+  WriterProperties::Builder builder;
+  builder.enable_dictionary()
+      ->encoding(Encoding::DELTA_BYTE_ARRAY)
+      ->dictionary_pagesize_limit(4096);
+  auto writer = this->BuildWriterWithProperties(
+      VERY_LARGE_SIZE, Compression::UNCOMPRESSED, builder.build());
+  writer->WriteBatch(this->values_.size(), nullptr, nullptr, this->values_ptr_);
+  writer->Close();
+
+  this->SetupValuesOut(VERY_LARGE_SIZE);
+  this->ReadColumnFully();
+  ASSERT_EQ(VERY_LARGE_SIZE, this->values_read_);
+  this->values_.resize(VERY_LARGE_SIZE);
+  ASSERT_EQ(this->values_, this->values_out_);
+  std::vector<Encoding::type> encodings = this->metadata_encodings();
+  ASSERT_EQ(4U, encodings.size());
+  ASSERT_EQ(Encoding::PLAIN_DICTIONARY, encodings[0]);
+  ASSERT_EQ(Encoding::PLAIN, encodings[1]);
+  ASSERT_EQ(Encoding::RLE, encodings[2]);
+  ASSERT_EQ(Encoding::DELTA_BYTE_ARRAY, encodings[3]);
+}
+
+// An encoding the type does not support is rejected before any value is
+// written, rather than at the fallback
+TEST_F(TestByteArrayValuesWriter, RejectsUnsupportedFallbackEncoding) {
+  WriterProperties::Builder builder;
+  builder.enable_dictionary()->encoding(Encoding::DELTA_BINARY_PACKED);
+  ASSERT_THROW(this->BuildWriterWithProperties(SMALL_SIZE, Compression::UNCOMPRESSED,
+                                               builder.build()),
+               ParquetException);
+}
+
+using TestInt64ValuesWriter = TestPrimitiveWriter<Int64Type>;
+
+TEST_F(TestInt64ValuesWriter, DictionaryFallbackWithoutSizeBenefit) {
+  // Random values are almost all distinct
+  this->GenerateData(LARGE_SIZE);
+
+  WriterProperties::Builder builder;
+  builder.enable_dictionary()->dictionary_benefit_check_values(1000);
+  auto writer = this->BuildWriterWithProperties(LARGE_SIZE, Compression::UNCOMPRESSED,
+                                                builder.build());
+  writer->WriteBatch(this->values_.size(), nullptr, nullptr, this->values_ptr_);
+  writer->Close();
+  ASSERT_EQ(DictionaryFallback::NO_SIZE_BENEFIT, writer->dictionary_fallback());
+
+  this->SetupValuesOut(LARGE_SIZE);
+  this->ReadColumnFully();
+  ASSERT_EQ(LARGE_SIZE, this->values_read_);
+  ASSERT_EQ(this->values_, this->values_out_);
+
+  std::vector<Encoding::type> encodings = this->metadata_encodings();
+  ASSERT_EQ(Encoding::PLAIN_DICTIONARY, encodings[0]);
+  ASSERT_EQ(Encoding::PLAIN, encodings[1]);
+}
+
+TEST_F(TestInt64ValuesWriter, DictionaryKeptWithSizeBenefit) {
+  this->values_.resize(LARGE_SIZE);
+  for (int i = 0; i < LARGE_SIZE; i++) {
+    this->values_[i] = i % 100;
+  }
+  this->values_ptr_ = this->values_.data();
+
+  WriterProperties::Builder builder;
+  builder.enable_dictionary()->dictionary_benefit_check_values(1000);
+  auto writer = this->BuildWriterWithProperties(LARGE_SIZE, Compression::UNCOMPRESSED,
+                                                builder.build());
+  writer->WriteBatch(this->values_.size(), nullptr, nullptr, this->values_ptr_);
+  writer->Close();
+  ASSERT_EQ(DictionaryFallback::NONE, writer->dictionary_fallback());
+
+  this->SetupValuesOut(LARGE_SIZE);
+  this->ReadColumnFully();
+  ASSERT_EQ(LARGE_SIZE, this->values_read_);
+  ASSERT_EQ(this->values_, this->values_out_);
+}
+
+TEST_F(TestInt64ValuesWriter, MemoryBudget) {
+  this->values_.resize(LARGE_SIZE);
+  for (int i = 0; i < LARGE_SIZE; i++) {
+    this->values_[i] = i % 100;
+  }
+  this->values_ptr_ = this->values_.data();
+
+  // The buffered dictionary indices exceed the budget long before a page is
+  // full, then the PLAIN pages are written before reaching the page size
+  for (bool dictionary : {true, false}) {
+    this->thrift_metadata_ = format::ColumnChunk();
+    auto budget = std::make_shared<WriterMemoryBudget>(64 * 1024);
+    WriterProperties::Builder builder;
+    builder.memory_budget(budget);
+    if (dictionary) {
+      builder.enable_dictionary();
+    } else {
+      builder.disable_dictionary();
+    }
+    auto writer = this->BuildWriterWithProperties(LARGE_SIZE, Compression::UNCOMPRESSED,
+                                                  builder.build());
+    writer->WriteBatch(this->values_.size(), nullptr, nullptr, this->values_ptr_);
+    ASSERT_EQ(writer->memory_bytes(), budget->buffered_size());
+    ASSERT_GE(budget->limit(), budget->buffered_size());
+    writer->Close();
+    ASSERT_EQ(0, budget->buffered_size());
+    ASSERT_EQ(dictionary ? DictionaryFallback::MEMORY_BUDGET : DictionaryFallback::NONE,
+              writer->dictionary_fallback());
+
+    this->SetupValuesOut(LARGE_SIZE);
+    this->ReadColumnFully();
+    ASSERT_EQ(LARGE_SIZE, this->values_read_);
+    ASSERT_EQ(this->values_, this->values_out_);
+  }
+}
+
+TEST_F(TestInt64ValuesWriter, DistinctCount) {
+  const int num_distinct = 20000;
+  this->values_.resize(LARGE_SIZE);
+  for (int i = 0; i < LARGE_SIZE; i++) {
+    this->values_[i] = (i * 7919) % num_distinct;
+  }
+  this->values_ptr_ = this->values_.data();
+
+  // Dictionary kept, fallback on the dictionary page size and no dictionary
+  for (int i = 0; i < 3; i++) {
+    this->thrift_metadata_ = format::ColumnChunk();
+    WriterProperties::Builder builder;
+    builder.enable_distinct_count()->write_distinct_count_sketches(true);
+    if (i == 0) builder.enable_dictionary();
+    if (i == 1) builder.enable_dictionary()->dictionary_pagesize_limit(4096);
+    if (i == 2) builder.disable_dictionary();
+    auto writer = this->BuildWriterWithProperties(LARGE_SIZE, Compression::UNCOMPRESSED,
+                                                  builder.build());
+    writer->WriteBatch(this->values_.size(), nullptr, nullptr, this->values_ptr_);
+    writer->Close();
+    ASSERT_EQ(i == 1, writer->dictionary_fallback() != DictionaryFallback::NONE);
+
+    const format::Statistics& statistics = this->thrift_metadata_.meta_data.statistics;
+    ASSERT_TRUE(statistics.__isset.distinct_count);
+    int64_t distinct_count = statistics.distinct_count;
+    if (i == 0) {
+      ASSERT_EQ(num_distinct, distinct_count);
+    } else {
+      // Well within the standard error of about 1.6%
+      ASSERT_NEAR(num_distinct, distinct_count, num_distinct * 0.06);
+    }
+
+    auto metadata = ColumnChunkMetaData::Make(
+        reinterpret_cast<const uint8_t*>(&this->thrift_metadata_), this->descr_);
+    auto key_value_metadata = metadata->key_value_metadata();
+    ASSERT_NE(nullptr, key_value_metadata);
+    ASSERT_EQ(1, key_value_metadata->size());
+    ASSERT_EQ(HyperLogLog::kColumnChunkKey, key_value_metadata->key(0));
+    auto sketch = HyperLogLog::Deserialize(key_value_metadata->value(0));
+    ASSERT_EQ(DEFAULT_DISTINCT_COUNT_PRECISION, sketch->precision());
+    ASSERT_NEAR(num_distinct, sketch->Estimate(), num_distinct * 0.06);
+  }
+}
+
+TEST_F(TestInt64ValuesWriter, WriteBatchIndices) {
+  // The second dictionary shares some entries with the first, at other indices
+  std::vector<int64_t> dictionary1 = {10, 20, 30};
+  std::vector<int64_t> dictionary2 = {30, 40, 10};
+  std::vector<int32_t> indices(LARGE_SIZE / 2);
+  for (size_t i = 0; i < indices.size(); i++) {
+    indices[i] = static_cast<int32_t>((i * 7) % 3);
+  }
+  this->values_.clear();
+  for (int32_t index : indices) {
+    this->values_.push_back(dictionary1[index]);
+  }
+  for (int32_t index : indices) {
+    this->values_.push_back(dictionary2[index]);
+  }
+
+  for (bool dictionary_enabled : {true, false}) {
+    WriterProperties::Builder builder;
+    if (dictionary_enabled) {
+      builder.enable_dictionary();
+    } else {
+      builder.disable_dictionary();
+    }
+    auto writer = this->BuildWriterWithProperties(
+        LARGE_SIZE, Compression::UNCOMPRESSED, builder.build());
+    writer->WriteBatchIndices(indices.size(), nullptr, nullptr, indices.size(),
+                              indices.data(), dictionary1.size(), dictionary1.data());
+    writer->WriteBatchIndices(indices.size(), nullptr, nullptr, indices.size(),
+                              indices.data(), dictionary2.size(), dictionary2.data());
+    writer->Close();
+
+    this->SetupValuesOut(LARGE_SIZE);
+    this->ReadColumnFully();
+    ASSERT_EQ(LARGE_SIZE, this->values_read_);
+    ASSERT_EQ(this->values_, this->values_out_);
+    std::vector<Encoding::type> encodings = this->metadata_encodings();
+    ASSERT_EQ(dictionary_enabled, encodings[0] == Encoding::PLAIN_DICTIONARY);
+  }
+}
+
 // PARQUET-719
 // Test case for NULL values
 TEST_F(TestNullValuesWriter, OptionalNullValueChunk) {
@@ -673,6 +997,50 @@ TEST(TestLevels, TestLevelsDecodeMultipleSetData) {
   }
 }
 
+// Decode levels of maximum level 1 straight into a validity bitmap, in batches
+// that do not line up with the runs nor with the bytes of the bitmap
+TEST(TestLevels, TestLevelsDecodeBitmap) {
+  std::vector<int16_t> input_levels;
+  for (int i = 0; i < 5000; ++i) {
+    // Long runs of each level, then alternating levels
+    input_levels.push_back(i < 2000 ? (i / 100) % 2 : (i * 7 / 3) % 2);
+  }
+  int num_levels = static_cast<int>(input_levels.size());
+  int64_t expected_null_count =
+      std::count(input_levels.begin(), input_levels.end(), static_cast<int16_t>(0));
+
+  Encoding::type encodings[2] = {Encoding::RLE, Encoding::BIT_PACKED};
+  for (Encoding::type encoding : encodings) {
+    std::vector<uint8_t> bytes;
+    EncodeLevels(encoding, 1, num_levels, input_levels.data(), bytes);
+
+    const int64_t kOffset = 3;
+    std::vector<uint8_t> valid_bits(
+        ::arrow::BitUtil::BytesForBits(num_levels + kOffset), 0xFF);
+    LevelDecoder decoder;
+    decoder.SetData(encoding, 1, num_levels, bytes.data());
+    int64_t null_count = 0;
+    int num_decoded = 0;
+    while (num_decoded < num_levels) {
+      int n = decoder.DecodeBitmap(37, valid_bits.data(), kOffset + num_decoded,
+                                   &null_count);
+      ASSERT_GT(n, 0);
+      num_decoded += n;
+    }
+    ASSERT_EQ(num_levels, num_decoded);
+    ASSERT_EQ(expected_null_count, null_count);
+    for (int i = 0; i < num_levels; ++i) {
+      ASSERT_EQ(input_levels[i] == 1,
+                ::arrow::BitUtil::GetBit(valid_bits.data(), kOffset + i))
+          << i;
+    }
+    // The leading bits are left alone
+    for (int i = 0; i < kOffset; ++i) {
+      ASSERT_TRUE(::arrow::BitUtil::GetBit(valid_bits.data(), i));
+    }
+  }
+}
+
 TEST(TestLevelEncoder, MinimumBufferSize) {
   // PARQUET-676, PARQUET-698
   const int kNumToEncode = 1024;
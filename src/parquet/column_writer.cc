@@ -17,6 +17,9 @@
 
 #include "parquet/column_writer.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "arrow/util/bit-util.h"
 #include "arrow/util/rle-encoding.h"
 
@@ -25,6 +28,7 @@
 #include "parquet/statistics.h"
 #include "parquet/util/logging.h"
 #include "parquet/util/memory.h"
+#include "parquet/util/stopwatch.h"
 
 namespace parquet {
 
@@ -128,9 +132,15 @@ ColumnWriter::ColumnWriter(ColumnChunkMetaDataBuilder* metadata,
       num_buffered_values_(0),
       num_buffered_encoded_values_(0),
       num_rows_(0),
+      num_paged_rows_(0),
       total_bytes_written_(0),
       closed_(false),
-      fallback_(false) {
+      fallback_(false),
+      dictionary_fallback_(DictionaryFallback::NONE),
+      dictionary_benefit_checked_(false),
+      data_pages_size_(0),
+      memory_budget_(properties->memory_budget()),
+      stats_(nullptr) {
   definition_levels_sink_.reset(new InMemoryOutputStream(allocator_));
   repetition_levels_sink_.reset(new InMemoryOutputStream(allocator_));
   definition_levels_rle_ =
@@ -145,6 +155,35 @@ ColumnWriter::ColumnWriter(ColumnChunkMetaDataBuilder* metadata,
   }
 }
 
+ColumnWriter::~ColumnWriter() {
+  if (memory_budget_ != nullptr) {
+    memory_budget_->Update(this, 0);
+  }
+}
+
+int64_t ColumnWriter::buffered_bytes() {
+  return definition_levels_sink_->Tell() + repetition_levels_sink_->Tell() +
+         pool_.total_reserved_bytes() + EstimatedBufferedValueBytes() + data_pages_size_;
+}
+
+int64_t ColumnWriter::memory_bytes() {
+  // The page buffers keep the capacity of the largest page so far
+  int64_t bytes = buffered_bytes() + definition_levels_rle_->capacity() +
+                  repetition_levels_rle_->capacity() + uncompressed_data_->capacity();
+  if (compressed_data_ != nullptr) {
+    bytes += compressed_data_->capacity();
+  }
+  return bytes;
+}
+
+bool ColumnWriter::UpdateMemoryBudget() {
+  if (memory_budget_ == nullptr) {
+    return false;
+  }
+  int64_t bytes = closed_ ? 0 : memory_bytes();
+  return memory_budget_->Update(this, bytes);
+}
+
 void ColumnWriter::InitSinks() {
   definition_levels_sink_->Clear();
   repetition_levels_sink_->Clear();
@@ -164,87 +203,154 @@ void ColumnWriter::WriteRepetitionLevels(int64_t num_levels, const int16_t* leve
 
 // return the size of the encoded buffer
 int64_t ColumnWriter::RleEncodeLevels(const Buffer& src_buffer,
-                                      ResizableBuffer* dest_buffer, int16_t max_level) {
+                                      ResizableBuffer* dest_buffer, int16_t max_level,
+                                      bool include_length) {
+  int64_t prefix_size = include_length ? sizeof(int32_t) : 0;
   // TODO: This only works with due to some RLE specifics
   int64_t rle_size = LevelEncoder::MaxBufferSize(Encoding::RLE, max_level,
                                                  static_cast<int>(num_buffered_values_)) +
-                     sizeof(int32_t);
+                     prefix_size;
 
   // Use Arrow::Buffer::shrink_to_fit = false
   // underlying buffer only keeps growing. Resize to a smaller size does not reallocate.
   PARQUET_THROW_NOT_OK(dest_buffer->Resize(rle_size, false));
 
   level_encoder_.Init(Encoding::RLE, max_level, static_cast<int>(num_buffered_values_),
-                      dest_buffer->mutable_data() + sizeof(int32_t),
-                      static_cast<int>(dest_buffer->size()) - sizeof(int32_t));
+                      dest_buffer->mutable_data() + prefix_size,
+                      static_cast<int>(dest_buffer->size() - prefix_size));
   int encoded =
       level_encoder_.Encode(static_cast<int>(num_buffered_values_),
                             reinterpret_cast<const int16_t*>(src_buffer.data()));
   DCHECK_EQ(encoded, num_buffered_values_);
-  reinterpret_cast<int32_t*>(dest_buffer->mutable_data())[0] = level_encoder_.len();
-  int64_t encoded_size = level_encoder_.len() + sizeof(int32_t);
+  if (include_length) {
+    reinterpret_cast<int32_t*>(dest_buffer->mutable_data())[0] = level_encoder_.len();
+  }
+  int64_t encoded_size = level_encoder_.len() + prefix_size;
   return encoded_size;
 }
 
+// Shrink the allocation of a section of a page to its size. The section is a
+// buffer of the writer, or a slice at its start, no longer used by the writer.
+static std::shared_ptr<Buffer> TrimPageBuffer(std::shared_ptr<Buffer> buffer) {
+  std::shared_ptr<Buffer> parent =
+      buffer->parent() != nullptr ? buffer->parent() : buffer;
+  auto resizable = std::dynamic_pointer_cast<ResizableBuffer>(parent);
+  if (resizable == nullptr || parent->data() != buffer->data()) {
+    return buffer;
+  }
+  int64_t size = buffer->size();
+  // The slice would be left pointing to the previous allocation
+  buffer.reset();
+  parent.reset();
+  PARQUET_THROW_NOT_OK(resizable->Resize(size, true));
+  return resizable;
+}
+
 void ColumnWriter::AddDataPage() {
   int64_t definition_levels_rle_size = 0;
   int64_t repetition_levels_rle_size = 0;
+  bool page_v2 = properties_->data_page_version() == ParquetDataPageVersion::V2;
 
-  std::shared_ptr<Buffer> values = GetValuesBuffer();
+  std::shared_ptr<Buffer> values;
+  {
+    ScopedStopWatch watch(StatsCounter(stats_, &ColumnWriterStats::encoding_time));
+    values = GetValuesBuffer();
 
-  if (descr_->max_definition_level() > 0) {
-    definition_levels_rle_size =
-        RleEncodeLevels(definition_levels_sink_->GetBufferRef(),
-                        definition_levels_rle_.get(), descr_->max_definition_level());
+    if (descr_->max_definition_level() > 0) {
+      definition_levels_rle_size = RleEncodeLevels(
+          definition_levels_sink_->GetBufferRef(), definition_levels_rle_.get(),
+          descr_->max_definition_level(), !page_v2);
+    }
+
+    if (descr_->max_repetition_level() > 0) {
+      repetition_levels_rle_size = RleEncodeLevels(
+          repetition_levels_sink_->GetBufferRef(), repetition_levels_rle_.get(),
+          descr_->max_repetition_level(), !page_v2);
+    }
   }
 
-  if (descr_->max_repetition_level() > 0) {
-    repetition_levels_rle_size =
-        RleEncodeLevels(repetition_levels_sink_->GetBufferRef(),
-                        repetition_levels_rle_.get(), descr_->max_repetition_level());
+  int64_t levels_size = definition_levels_rle_size + repetition_levels_rle_size;
+  int64_t uncompressed_size = levels_size + values->size();
+
+  EncodedStatistics page_stats;
+  {
+    ScopedStopWatch watch(StatsCounter(stats_, &ColumnWriterStats::statistics_time));
+    page_stats = GetPageStatistics();
+    ResetPageStatistics();
   }
 
-  int64_t uncompressed_size =
-      definition_levels_rle_size + repetition_levels_rle_size + values->size();
+  int64_t page_rows = num_rows_ - num_paged_rows_;
+  num_paged_rows_ = num_rows_;
 
-  // Use Arrow::Buffer::shrink_to_fit = false
-  // underlying buffer only keeps growing. Resize to a smaller size does not reallocate.
-  PARQUET_THROW_NOT_OK(uncompressed_data_->Resize(uncompressed_size, false));
+  bool pager_compresses = pager_->compresses_data_pages();
+  bool compress = pager_->has_compressor() && !pager_compresses;
 
-  // Concatenate data into a single buffer
-  uint8_t* uncompressed_ptr = uncompressed_data_->mutable_data();
-  memcpy(uncompressed_ptr, repetition_levels_rle_->data(), repetition_levels_rle_size);
-  uncompressed_ptr += repetition_levels_rle_size;
-  memcpy(uncompressed_ptr, definition_levels_rle_->data(), definition_levels_rle_size);
-  uncompressed_ptr += definition_levels_rle_size;
-  memcpy(uncompressed_ptr, values->data(), values->size());
+  // The sections of the page, written one after the other
+  std::vector<std::shared_ptr<Buffer>> page_buffers;
+  if (repetition_levels_rle_size > 0) {
+    page_buffers.push_back(
+        ::arrow::SliceBuffer(repetition_levels_rle_, 0, repetition_levels_rle_size));
+  }
+  if (definition_levels_rle_size > 0) {
+    page_buffers.push_back(
+        ::arrow::SliceBuffer(definition_levels_rle_, 0, definition_levels_rle_size));
+  }
 
-  EncodedStatistics page_stats = GetPageStatistics();
-  ResetPageStatistics();
+  DataPageV2Layout v2_layout = {0, 0, 0, false};
+  if (page_v2) {
+    // Only the values are compressed, the levels are written ahead of them
+    if (compress) {
+      pager_->Compress(*values, compressed_data_.get());
+      page_buffers.push_back(compressed_data_);
+    } else {
+      page_buffers.push_back(values);
+    }
 
-  std::shared_ptr<Buffer> compressed_data;
-  if (pager_->has_compressor()) {
-    pager_->Compress(*(uncompressed_data_.get()), compressed_data_.get());
-    compressed_data = compressed_data_;
+    v2_layout.num_nulls =
+        static_cast<int32_t>(num_buffered_values_ - num_buffered_encoded_values_);
+    v2_layout.definition_levels_byte_length =
+        static_cast<int32_t>(definition_levels_rle_size);
+    v2_layout.repetition_levels_byte_length =
+        static_cast<int32_t>(repetition_levels_rle_size);
+    v2_layout.is_compressed = pager_->has_compressor();
+  } else if (!compress) {
+    page_buffers.push_back(values);
+  } else if (levels_size == 0) {
+    pager_->Compress(*values, compressed_data_.get());
+    page_buffers.assign(1, compressed_data_);
   } else {
-    compressed_data = uncompressed_data_;
+    // The codec compresses contiguous data only
+    page_buffers.push_back(values);
+    pager_->Compress(*GatherBuffers(page_buffers, uncompressed_data_),
+                     compressed_data_.get());
+    page_buffers.assign(1, compressed_data_);
   }
+  const DataPageV2Layout* page_layout = page_v2 ? &v2_layout : nullptr;
 
   // Write the page to OutputStream eagerly if there is no dictionary or
   // if dictionary encoding has fallen back to PLAIN
-  if (has_dictionary_ && !fallback_) {  // Save pages until end of dictionary encoding
-    std::shared_ptr<Buffer> compressed_data_copy;
-    PARQUET_THROW_NOT_OK(compressed_data->Copy(0, compressed_data->size(), allocator_,
-                                               &compressed_data_copy));
-    CompressedDataPage page(compressed_data_copy,
-                            static_cast<int32_t>(num_buffered_values_), encoding_,
-                            Encoding::RLE, Encoding::RLE, uncompressed_size, page_stats);
+  bool hold_page = has_dictionary_ && !fallback_;
+  if (hold_page) {
+    // The page keeps the writer's buffers until the end of dictionary encoding,
+    // without the capacity reserved for the largest possible encoding
+    ReleasePageBuffers(page_buffers);
+    values.reset();
+    for (auto& buffer : page_buffers) {
+      buffer = TrimPageBuffer(std::move(buffer));
+    }
+  }
+  CompressedDataPage page(page_buffers, static_cast<int32_t>(num_buffered_values_),
+                          encoding_, Encoding::RLE, Encoding::RLE, uncompressed_size,
+                          page_stats, page_rows, page_layout);
+  if (hold_page) {  // Save pages until end of dictionary encoding
+    data_pages_size_ += page.data_size();
     data_pages_.push_back(std::move(page));
   } else {  // Eagerly write pages
-    CompressedDataPage page(compressed_data, static_cast<int32_t>(num_buffered_values_),
-                            encoding_, Encoding::RLE, Encoding::RLE, uncompressed_size,
-                            page_stats);
     WriteDataPage(page);
+    // The pager keeps the pages it compresses itself
+    if (pager_compresses) {
+      ReleasePageBuffers(page_buffers);
+    }
   }
 
   // Re-initialize the sinks for next Page.
@@ -253,6 +359,48 @@ void ColumnWriter::AddDataPage() {
   num_buffered_encoded_values_ = 0;
 }
 
+int64_t ColumnWriter::MiniBatchSize() const {
+  int64_t batch_size = properties_->write_batch_size();
+  int64_t limit = properties_->data_page_values_limit();
+  if (limit > 0) {
+    batch_size = std::min(batch_size, std::max<int64_t>(1, limit - num_buffered_values_));
+  }
+  return batch_size;
+}
+
+void ColumnWriter::ReleasePageBuffers(
+    const std::vector<std::shared_ptr<Buffer>>& page_buffers) {
+  for (const auto& buffer : page_buffers) {
+    ReleasePageBuffer(buffer->parent() != nullptr ? buffer->parent() : buffer);
+  }
+}
+
+void ColumnWriter::ReleasePageBuffer(const std::shared_ptr<Buffer>& page_buffer) {
+  if (page_buffer == definition_levels_rle_) {
+    definition_levels_rle_ =
+        std::static_pointer_cast<ResizableBuffer>(AllocateBuffer(allocator_, 0));
+  } else if (page_buffer == repetition_levels_rle_) {
+    repetition_levels_rle_ =
+        std::static_pointer_cast<ResizableBuffer>(AllocateBuffer(allocator_, 0));
+  } else if (page_buffer == uncompressed_data_) {
+    uncompressed_data_ =
+        std::static_pointer_cast<ResizableBuffer>(AllocateBuffer(allocator_, 0));
+  } else if (page_buffer == compressed_data_) {
+    compressed_data_ =
+        std::static_pointer_cast<ResizableBuffer>(AllocateBuffer(allocator_, 0));
+  }
+}
+
+void ColumnWriter::ResetPageBuffers() {
+  for (std::shared_ptr<ResizableBuffer>* buffer :
+       {&definition_levels_rle_, &repetition_levels_rle_, &uncompressed_data_,
+        &compressed_data_}) {
+    if (*buffer != nullptr) {
+      *buffer = std::static_pointer_cast<ResizableBuffer>(AllocateBuffer(allocator_, 0));
+    }
+  }
+}
+
 void ColumnWriter::WriteDataPage(const CompressedDataPage& page) {
   total_bytes_written_ += pager_->WriteDataPage(page);
 }
@@ -265,13 +413,30 @@ int64_t ColumnWriter::Close() {
     }
 
     FlushBufferedDataPages();
+    total_bytes_written_ += pager_->Flush();
 
-    EncodedStatistics chunk_statistics = GetChunkStatistics();
+    EncodedStatistics chunk_statistics;
+    {
+      ScopedStopWatch watch(StatsCounter(stats_, &ColumnWriterStats::statistics_time));
+      chunk_statistics = GetChunkStatistics();
+    }
     if (chunk_statistics.is_set()) metadata_->SetStatistics(chunk_statistics);
+    // Before Close writes the inline copy of the metadata, so that it matches
+    // the footer
+    const HyperLogLog* sketch = GetDistinctCountSketch();
+    if (sketch != nullptr && properties_->write_distinct_count_sketches()) {
+      metadata_->AddKeyValueMetadata(HyperLogLog::kColumnChunkKey, sketch->Serialize());
+    }
     pager_->Close(has_dictionary_, fallback_);
+
+    const BloomFilter* bloom_filter = GetBloomFilter();
+    if (bloom_filter != nullptr) {
+      total_bytes_written_ += pager_->WriteBloomFilter(*bloom_filter);
+    }
+    UpdateMemoryBudget();
   }
 
-  if (num_rows_ != expected_rows_) {
+  if (expected_rows_ >= 0 && num_rows_ != expected_rows_) {
     std::stringstream ss;
     ss << "Written rows: " << num_rows_ << " != expected rows: " << expected_rows_
        << "in the current column chunk";
@@ -290,11 +455,100 @@ void ColumnWriter::FlushBufferedDataPages() {
     WriteDataPage(data_pages_[i]);
   }
   data_pages_.clear();
+  data_pages_size_ = 0;
+  pager_->HoldDataPages(0);
 }
 
 // ----------------------------------------------------------------------
 // TypedColumnWriter
 
+// The DELTA encodings are defined for INT32 and INT64 (DELTA_BINARY_PACKED)
+// and BYTE_ARRAY (DELTA_LENGTH_BYTE_ARRAY, DELTA_BYTE_ARRAY) values
+template <typename DType>
+static std::unique_ptr<Encoder<DType>> MakeDeltaEncoder(Encoding::type encoding,
+                                                        const ColumnDescriptor* descr,
+                                                        ::arrow::MemoryPool* pool) {
+  ParquetException::NYI("Selected encoding is not supported");
+  return nullptr;
+}
+
+template <>
+std::unique_ptr<Encoder<Int32Type>> MakeDeltaEncoder<Int32Type>(
+    Encoding::type encoding, const ColumnDescriptor* descr, ::arrow::MemoryPool* pool) {
+  if (encoding != Encoding::DELTA_BINARY_PACKED) {
+    ParquetException::NYI("Selected encoding is not supported");
+  }
+  return std::unique_ptr<Encoder<Int32Type>>(
+      new DeltaBitPackEncoder<Int32Type>(descr, pool));
+}
+
+template <>
+std::unique_ptr<Encoder<Int64Type>> MakeDeltaEncoder<Int64Type>(
+    Encoding::type encoding, const ColumnDescriptor* descr, ::arrow::MemoryPool* pool) {
+  if (encoding != Encoding::DELTA_BINARY_PACKED) {
+    ParquetException::NYI("Selected encoding is not supported");
+  }
+  return std::unique_ptr<Encoder<Int64Type>>(
+      new DeltaBitPackEncoder<Int64Type>(descr, pool));
+}
+
+template <>
+std::unique_ptr<Encoder<ByteArrayType>> MakeDeltaEncoder<ByteArrayType>(
+    Encoding::type encoding, const ColumnDescriptor* descr, ::arrow::MemoryPool* pool) {
+  if (encoding == Encoding::DELTA_LENGTH_BYTE_ARRAY) {
+    return std::unique_ptr<Encoder<ByteArrayType>>(
+        new DeltaLengthByteArrayEncoder(descr, pool));
+  } else if (encoding == Encoding::DELTA_BYTE_ARRAY) {
+    return std::unique_ptr<Encoder<ByteArrayType>>(
+        new DeltaByteArrayEncoder(descr, pool));
+  }
+  ParquetException::NYI("Selected encoding is not supported");
+  return nullptr;
+}
+
+// BYTE_STREAM_SPLIT is defined for FLOAT and DOUBLE values
+template <typename DType>
+static std::unique_ptr<Encoder<DType>> MakeByteStreamSplitEncoder(
+    const ColumnDescriptor* descr, ::arrow::MemoryPool* pool) {
+  ParquetException::NYI("Selected encoding is not supported");
+  return nullptr;
+}
+
+template <>
+std::unique_ptr<Encoder<FloatType>> MakeByteStreamSplitEncoder<FloatType>(
+    const ColumnDescriptor* descr, ::arrow::MemoryPool* pool) {
+  return std::unique_ptr<Encoder<FloatType>>(
+      new ByteStreamSplitEncoder<FloatType>(descr, pool));
+}
+
+template <>
+std::unique_ptr<Encoder<DoubleType>> MakeByteStreamSplitEncoder<DoubleType>(
+    const ColumnDescriptor* descr, ::arrow::MemoryPool* pool) {
+  return std::unique_ptr<Encoder<DoubleType>>(
+      new ByteStreamSplitEncoder<DoubleType>(descr, pool));
+}
+
+// Encoders of the encodings used without a dictionary, or after falling back
+// from it
+template <typename DType>
+static std::unique_ptr<Encoder<DType>> MakeValueEncoder(Encoding::type encoding,
+                                                        const ColumnDescriptor* descr,
+                                                        ::arrow::MemoryPool* pool) {
+  switch (encoding) {
+    case Encoding::PLAIN:
+      return std::unique_ptr<Encoder<DType>>(new PlainEncoder<DType>(descr, pool));
+    case Encoding::DELTA_BINARY_PACKED:
+    case Encoding::DELTA_LENGTH_BYTE_ARRAY:
+    case Encoding::DELTA_BYTE_ARRAY:
+      return MakeDeltaEncoder<DType>(encoding, descr, pool);
+    case Encoding::BYTE_STREAM_SPLIT:
+      return MakeByteStreamSplitEncoder<DType>(descr, pool);
+    default:
+      ParquetException::NYI("Selected encoding is not supported");
+  }
+  return nullptr;
+}
+
 template <typename Type>
 TypedColumnWriter<Type>::TypedColumnWriter(ColumnChunkMetaDataBuilder* metadata,
                                            std::unique_ptr<PageWriter> pager,
@@ -304,47 +558,147 @@ TypedColumnWriter<Type>::TypedColumnWriter(ColumnChunkMetaDataBuilder* metadata,
                    (encoding == Encoding::PLAIN_DICTIONARY ||
                     encoding == Encoding::RLE_DICTIONARY),
                    encoding, properties) {
-  switch (encoding) {
-    case Encoding::PLAIN:
-      current_encoder_.reset(new PlainEncoder<Type>(descr_, properties->memory_pool()));
-      break;
-    case Encoding::PLAIN_DICTIONARY:
-    case Encoding::RLE_DICTIONARY:
-      current_encoder_.reset(
-          new DictEncoder<Type>(descr_, &pool_, properties->memory_pool()));
-      break;
-    default:
-      ParquetException::NYI("Selected encoding is not supported");
+  if (has_dictionary_) {
+    current_encoder_.reset(
+        new DictEncoder<Type>(descr_, &pool_, properties->memory_pool()));
+    fallback_encoder_ = MakeValueEncoder<Type>(properties->encoding(descr_->path()),
+                                               descr_, properties->memory_pool());
+  } else {
+    current_encoder_ =
+        MakeValueEncoder<Type>(encoding, descr_, properties->memory_pool());
   }
 
   if (properties->statistics_enabled(descr_->path())) {
     page_statistics_ = std::unique_ptr<TypedStats>(new TypedStats(descr_, allocator_));
     chunk_statistics_ = std::unique_ptr<TypedStats>(new TypedStats(descr_, allocator_));
+    page_statistics_->set_truncate_length(properties->statistics_truncate_length());
+    chunk_statistics_->set_truncate_length(properties->statistics_truncate_length());
+  }
+
+  bloom_filter_enabled_ = properties->bloom_filter_enabled(descr_->path()) &&
+                          descr_->physical_type() != Type::BOOLEAN;
+  if (bloom_filter_enabled_ && !has_dictionary_) {
+    const BloomFilterOptions& options = properties->bloom_filter_options(descr_->path());
+    bloom_filter_.reset(
+        new BloomFilter(BloomFilter::OptimalNumOfBytes(options.ndv, options.fpp),
+                        properties->memory_pool()));
+  }
+
+  // The distinct count is part of the chunk statistics
+  distinct_count_enabled_ =
+      properties->distinct_count_enabled(descr_->path()) && chunk_statistics_ != nullptr;
+  dictionary_distinct_count_ = -1;
+  if (distinct_count_enabled_ && !has_dictionary_) {
+    distinct_count_sketch_.reset(new HyperLogLog(properties->distinct_count_precision()));
   }
 }
 
 // Only one Dictionary Page is written.
-// Fallback to PLAIN if dictionary page limit is reached.
+// Fallback to the column's encoding (PLAIN by default) if dictionary page
+// limit is reached, or if after the first dictionary_benefit_check_values
+// values the dictionary does not make the chunk smaller.
 template <typename Type>
 void TypedColumnWriter<Type>::CheckDictionarySizeLimit() {
   auto dict_encoder = static_cast<DictEncoder<Type>*>(current_encoder_.get());
   if (dict_encoder->dict_encoded_size() >= properties_->dictionary_pagesize_limit()) {
-    WriteDictionaryPage();
-    // Serialize the buffered Dictionary Indicies
-    FlushBufferedDataPages();
-    fallback_ = true;
-    // Only PLAIN encoding is supported for fallback in V1
-    current_encoder_.reset(new PlainEncoder<Type>(descr_, properties_->memory_pool()));
-    encoding_ = Encoding::PLAIN;
+    FallbackToPlainEncoding(DictionaryFallback::DICTIONARY_PAGE_SIZE_LIMIT);
+    return;
+  }
+
+  int64_t check_values = properties_->dictionary_benefit_check_values();
+  if (check_values > 0 && !dictionary_benefit_checked_ &&
+      dict_encoder->num_values() >= check_values) {
+    dictionary_benefit_checked_ = true;
+    // The indices are bit-packed at most, RLE runs only make them smaller
+    int64_t index_bytes =
+        BitUtil::Ceil(dict_encoder->num_values() * dict_encoder->bit_width(), 8);
+    if (dict_encoder->dict_encoded_size() + index_bytes >=
+        dict_encoder->plain_encoded_size()) {
+      FallbackToPlainEncoding(DictionaryFallback::NO_SIZE_BENEFIT);
+    }
+  }
+}
+
+template <typename Type>
+void TypedColumnWriter<Type>::FallbackToPlainEncoding(DictionaryFallback::type reason) {
+  if (bloom_filter_enabled_) {
+    // The values written after the fallback are inserted as well
+    const BloomFilterOptions& options = properties_->bloom_filter_options(descr_->path());
+    bloom_filter_.reset(
+        new BloomFilter(BloomFilter::OptimalNumOfBytes(options.ndv, options.fpp),
+                        properties_->memory_pool()));
+  }
+  if (distinct_count_enabled_) {
+    distinct_count_sketch_.reset(
+        new HyperLogLog(properties_->distinct_count_precision()));
+  }
+  WriteDictionaryPage();
+  // Serialize the buffered Dictionary Indicies
+  FlushBufferedDataPages();
+  fallback_ = true;
+  dictionary_fallback_ = reason;
+  if (stats_ != nullptr) {
+    UpdateStats(stats_, &ColumnWriterStats::dictionary_fallbacks, 1);
+    stats_->last_fallback_reason.store(reason, std::memory_order_relaxed);
+    stats_->last_fallback_row.store(num_rows_, std::memory_order_relaxed);
   }
+  encoding_ = properties_->encoding(descr_->path());
+  current_encoder_ = std::move(fallback_encoder_);
+}
+
+template <typename Type>
+void TypedColumnWriter<Type>::CheckMemoryBudget() {
+  // The pages held while dictionary encoding count towards the memory limit of
+  // buffered row groups too
+  bool write_held_pages =
+      has_dictionary_ && !fallback_ && pager_->HoldDataPages(data_pages_size_);
+  if (!UpdateMemoryBudget() && !write_held_pages) {
+    return;
+  }
+  if (has_dictionary_ && !fallback_) {
+    FallbackToPlainEncoding(DictionaryFallback::MEMORY_BUDGET);
+  } else if (num_buffered_values_ > 0) {
+    AddDataPage();
+  }
+  ResetPageBuffers();
+  UpdateMemoryBudget();
+}
+
+template <typename Type>
+int64_t TypedColumnWriter<Type>::EstimatedBufferedValueBytes() {
+  if (has_dictionary_ && !fallback_) {
+    return static_cast<DictEncoder<Type>*>(current_encoder_.get())->memory_size();
+  }
+  return current_encoder_->EstimatedDataEncodedSize();
 }
 
 template <typename Type>
 void TypedColumnWriter<Type>::WriteDictionaryPage() {
   auto dict_encoder = static_cast<DictEncoder<Type>*>(current_encoder_.get());
+  if (bloom_filter_enabled_ && bloom_filter_ == nullptr) {
+    // No fallback: the chunk has no more distinct values than the dictionary
+    const BloomFilterOptions& options = properties_->bloom_filter_options(descr_->path());
+    int64_t ndv = std::min<int64_t>(options.ndv, dict_encoder->num_entries());
+    bloom_filter_.reset(new BloomFilter(BloomFilter::OptimalNumOfBytes(ndv, options.fpp),
+                                        properties_->memory_pool()));
+  }
+  if (distinct_count_enabled_ && distinct_count_sketch_ == nullptr) {
+    // No fallback: the dictionary holds all the distinct values of the chunk
+    distinct_count_sketch_.reset(
+        new HyperLogLog(properties_->distinct_count_precision()));
+    // Entries passed through from an Arrow dictionary may be unused
+    dictionary_distinct_count_ = dict_encoder->num_referenced_entries();
+  }
+  if (HashesValues()) {
+    // Only done here as the values may not stay valid after WriteDict
+    UpdateValueHashes(dict_encoder->num_entries(), dict_encoder->uniques().data());
+  }
   std::shared_ptr<PoolBuffer> buffer =
       AllocateBuffer(properties_->memory_pool(), dict_encoder->dict_encoded_size());
-  dict_encoder->WriteDict(buffer->mutable_data());
+  {
+    ScopedStopWatch watch(StatsCounter(stats_, &ColumnWriterStats::encoding_time));
+    dict_encoder->WriteDict(buffer->mutable_data());
+  }
   // TODO Get rid of this deep call
   dict_encoder->mem_pool()->FreeAll();
 
@@ -364,6 +718,11 @@ template <typename Type>
 EncodedStatistics TypedColumnWriter<Type>::GetChunkStatistics() {
   EncodedStatistics result;
   if (chunk_statistics_) result = chunk_statistics_->Encode();
+  if (distinct_count_sketch_ != nullptr) {
+    result.set_distinct_count(dictionary_distinct_count_ >= 0
+                                  ? dictionary_distinct_count_
+                                  : distinct_count_sketch_->Estimate());
+  }
   return result;
 }
 
@@ -427,7 +786,8 @@ template <typename DType>
 inline int64_t TypedColumnWriter<DType>::WriteMiniBatch(int64_t num_values,
                                                         const int16_t* def_levels,
                                                         const int16_t* rep_levels,
-                                                        const T* values) {
+                                                        const T* values,
+                                                        const int32_t* indices) {
   int64_t values_to_write = 0;
   // If the field is required and non-repeated, there are no definition levels
   if (descr_->max_definition_level() > 0) {
@@ -459,7 +819,7 @@ inline int64_t TypedColumnWriter<DType>::WriteMiniBatch(int64_t num_values,
     num_rows_ += static_cast<int>(num_values);
   }
 
-  if (num_rows_ > expected_rows_) {
+  if (expected_rows_ >= 0 && num_rows_ > expected_rows_) {
     throw ParquetException("More rows were written in the column chunk than expected");
   }
 
@@ -468,21 +828,35 @@ inline int64_t TypedColumnWriter<DType>::WriteMiniBatch(int64_t num_values,
     DCHECK(nullptr != values) << "Values ptr cannot be NULL";
   }
 
-  WriteValues(values_to_write, values);
+  {
+    ScopedStopWatch watch(StatsCounter(stats_, &ColumnWriterStats::encoding_time));
+    if (indices != nullptr) {
+      auto dict_encoder = static_cast<DictEncoder<DType>*>(current_encoder_.get());
+      dict_encoder->PutIndices(indices, static_cast<int>(values_to_write));
+    } else {
+      WriteValues(values_to_write, values);
+    }
+  }
 
   if (page_statistics_ != nullptr) {
+    ScopedStopWatch watch(StatsCounter(stats_, &ColumnWriterStats::statistics_time));
     page_statistics_->Update(values, values_to_write, num_values - values_to_write);
   }
+  if (HashesValues()) {
+    UpdateValueHashes(values_to_write, values);
+  }
 
   num_buffered_values_ += num_values;
   num_buffered_encoded_values_ += values_to_write;
 
-  if (current_encoder_->EstimatedDataEncodedSize() >= properties_->data_pagesize()) {
+  if (current_encoder_->EstimatedDataEncodedSize() >= properties_->data_pagesize() ||
+      PageValuesLimitReached()) {
     AddDataPage();
   }
   if (has_dictionary_ && !fallback_) {
     CheckDictionarySizeLimit();
   }
+  CheckMemoryBudget();
 
   return values_to_write;
 }
@@ -533,18 +907,32 @@ inline int64_t TypedColumnWriter<DType>::WriteMiniBatchSpaced(
     num_rows_ += static_cast<int>(num_values);
   }
 
-  if (num_rows_ > expected_rows_) {
+  if (expected_rows_ >= 0 && num_rows_ > expected_rows_) {
     throw ParquetException("More rows were written in the column chunk than expected");
   }
 
   if (descr_->schema_node()->is_optional()) {
-    WriteValuesSpaced(spaced_values_to_write, valid_bits, valid_bits_offset, values);
+    {
+      ScopedStopWatch watch(StatsCounter(stats_, &ColumnWriterStats::encoding_time));
+      WriteValuesSpaced(spaced_values_to_write, valid_bits, valid_bits_offset, values);
+    }
+    if (HashesValues()) {
+      UpdateValueHashesSpaced(spaced_values_to_write, valid_bits, valid_bits_offset,
+                              values);
+    }
   } else {
-    WriteValues(values_to_write, values);
+    {
+      ScopedStopWatch watch(StatsCounter(stats_, &ColumnWriterStats::encoding_time));
+      WriteValues(values_to_write, values);
+    }
+    if (HashesValues()) {
+      UpdateValueHashes(values_to_write, values);
+    }
   }
   *num_spaced_written = spaced_values_to_write;
 
   if (page_statistics_ != nullptr) {
+    ScopedStopWatch watch(StatsCounter(stats_, &ColumnWriterStats::statistics_time));
     page_statistics_->UpdateSpaced(values, valid_bits, valid_bits_offset, values_to_write,
                                    num_values - values_to_write);
   }
@@ -552,12 +940,14 @@ inline int64_t TypedColumnWriter<DType>::WriteMiniBatchSpaced(
   num_buffered_values_ += num_values;
   num_buffered_encoded_values_ += values_to_write;
 
-  if (current_encoder_->EstimatedDataEncodedSize() >= properties_->data_pagesize()) {
+  if (current_encoder_->EstimatedDataEncodedSize() >= properties_->data_pagesize() ||
+      PageValuesLimitReached()) {
     AddDataPage();
   }
   if (has_dictionary_ && !fallback_) {
     CheckDictionarySizeLimit();
   }
+  CheckMemoryBudget();
 
   return values_to_write;
 }
@@ -570,20 +960,23 @@ void TypedColumnWriter<DType>::WriteBatch(int64_t num_values, const int16_t* def
   // The purpose of this chunking is to bound this. Even if a user writes large number
   // of values, the chunking will ensure the AddDataPage() is called at a reasonable
   // pagesize limit
-  int64_t write_batch_size = properties_->write_batch_size();
-  int num_batches = static_cast<int>(num_values / write_batch_size);
-  int64_t num_remaining = num_values % write_batch_size;
+  int64_t offset = 0;
   int64_t value_offset = 0;
-  for (int round = 0; round < num_batches; round++) {
-    int64_t offset = round * write_batch_size;
-    int64_t num_values = WriteMiniBatch(write_batch_size, &def_levels[offset],
-                                        &rep_levels[offset], &values[value_offset]);
-    value_offset += num_values;
-  }
-  // Write the remaining values
-  int64_t offset = num_batches * write_batch_size;
-  WriteMiniBatch(num_remaining, &def_levels[offset], &rep_levels[offset],
-                 &values[value_offset]);
+  do {
+    int64_t batch_size = std::min(MiniBatchSize(), num_values - offset);
+    value_offset += WriteMiniBatch(batch_size, &def_levels[offset], &rep_levels[offset],
+                                   &values[value_offset]);
+    offset += batch_size;
+  } while (offset < num_values);
+}
+
+template <typename DType>
+void TypedColumnWriter<DType>::WriteBatch(int64_t num_values, const int16_t* def_levels,
+                                          const int16_t* rep_levels, const T* values,
+                                          const std::shared_ptr<Buffer>& values_buffer) {
+  values_buffer_ = values_buffer;
+  WriteBatch(num_values, def_levels, rep_levels, values);
+  values_buffer_.reset();
 }
 
 template <typename DType>
@@ -595,28 +988,112 @@ void TypedColumnWriter<DType>::WriteBatchSpaced(
   // The purpose of this chunking is to bound this. Even if a user writes large number
   // of values, the chunking will ensure the AddDataPage() is called at a reasonable
   // pagesize limit
-  int64_t write_batch_size = properties_->write_batch_size();
-  int num_batches = static_cast<int>(num_values / write_batch_size);
-  int64_t num_remaining = num_values % write_batch_size;
+  int64_t offset = 0;
   int64_t num_spaced_written = 0;
   int64_t values_offset = 0;
-  for (int round = 0; round < num_batches; round++) {
-    int64_t offset = round * write_batch_size;
-    WriteMiniBatchSpaced(write_batch_size, &def_levels[offset], &rep_levels[offset],
+  do {
+    int64_t batch_size = std::min(MiniBatchSize(), num_values - offset);
+    WriteMiniBatchSpaced(batch_size, &def_levels[offset], &rep_levels[offset],
                          valid_bits, valid_bits_offset + values_offset,
                          values + values_offset, &num_spaced_written);
     values_offset += num_spaced_written;
+    offset += batch_size;
+  } while (offset < num_values);
+}
+
+template <typename DType>
+void TypedColumnWriter<DType>::WriteBatchIndices(int64_t num_values,
+                                                 const int16_t* def_levels,
+                                                 const int16_t* rep_levels,
+                                                 int64_t num_indices,
+                                                 const int32_t* indices,
+                                                 int64_t dictionary_length,
+                                                 const T* dictionary) {
+  // The dense values are still needed for the statistics, and to encode the
+  // values written after a fallback
+  std::shared_ptr<PoolBuffer> values_buffer =
+      AllocateBuffer(properties_->memory_pool(), num_indices * sizeof(T));
+  T* values = reinterpret_cast<T*>(values_buffer->mutable_data());
+  for (int64_t i = 0; i < num_indices; i++) {
+    values[i] = dictionary[indices[i]];
+  }
+
+  // Map the entries of the dictionary to the ones of the chunk's dictionary,
+  // which are the same as long as it started out empty and all of them are
+  // used. Only the referenced entries are added, in the order of their first
+  // use.
+  std::shared_ptr<PoolBuffer> remapped_buffer;
+  const int32_t* chunk_indices = nullptr;
+  if (has_dictionary_ && !fallback_) {
+    auto dict_encoder = static_cast<DictEncoder<DType>*>(current_encoder_.get());
+    std::vector<int32_t> remap(dictionary_length, -1);
+    bool identity = true;
+    for (int64_t i = 0; i < num_indices; i++) {
+      int32_t index = indices[i];
+      if (remap[index] < 0) {
+        remap[index] = dict_encoder->GetOrInsert(dictionary[index]);
+        identity = identity && remap[index] == index;
+      }
+    }
+    chunk_indices = indices;
+    if (!identity) {
+      remapped_buffer =
+          AllocateBuffer(properties_->memory_pool(), num_indices * sizeof(int32_t));
+      int32_t* remapped = reinterpret_cast<int32_t*>(remapped_buffer->mutable_data());
+      for (int64_t i = 0; i < num_indices; i++) {
+        remapped[i] = remap[indices[i]];
+      }
+      chunk_indices = remapped;
+    }
+  }
+
+  int64_t offset = 0;
+  int64_t value_offset = 0;
+  do {
+    int64_t batch_size = std::min(MiniBatchSize(), num_values - offset);
+    // After a fallback, the values are encoded with the column's encoding
+    const int32_t* batch_indices =
+        has_dictionary_ && !fallback_ ? chunk_indices + value_offset : nullptr;
+    value_offset += WriteMiniBatch(batch_size, &def_levels[offset], &rep_levels[offset],
+                                   &values[value_offset], batch_indices);
+    offset += batch_size;
+  } while (offset < num_values);
+}
+
+template <typename DType>
+void TypedColumnWriter<DType>::UpdateValueHashes(int64_t num_values, const T* values) {
+  // The sketch uses the Bloom filter hash, which is well-defined across writers
+  // so that the serialized sketches can be merged
+  for (int64_t i = 0; i < num_values; ++i) {
+    uint64_t hash = BloomFilterHash<DType>(descr_, values[i]);
+    if (bloom_filter_ != nullptr) bloom_filter_->InsertHash(hash);
+    if (distinct_count_sketch_ != nullptr) distinct_count_sketch_->Update(hash);
+  }
+}
+
+template <typename DType>
+void TypedColumnWriter<DType>::UpdateValueHashesSpaced(int64_t num_values,
+                                                       const uint8_t* valid_bits,
+                                                       int64_t valid_bits_offset,
+                                                       const T* values) {
+  for (int64_t i = 0; i < num_values; ++i) {
+    if (::arrow::BitUtil::GetBit(valid_bits, valid_bits_offset + i)) {
+      uint64_t hash = BloomFilterHash<DType>(descr_, values[i]);
+      if (bloom_filter_ != nullptr) bloom_filter_->InsertHash(hash);
+      if (distinct_count_sketch_ != nullptr) distinct_count_sketch_->Update(hash);
+    }
   }
-  // Write the remaining values
-  int64_t offset = num_batches * write_batch_size;
-  WriteMiniBatchSpaced(num_remaining, &def_levels[offset], &rep_levels[offset],
-                       valid_bits, valid_bits_offset + values_offset,
-                       values + values_offset, &num_spaced_written);
 }
 
 template <typename DType>
 void TypedColumnWriter<DType>::WriteValues(int64_t num_values, const T* values) {
-  current_encoder_->Put(values, static_cast<int>(num_values));
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(values);
+  if (values_buffer_ != nullptr && data >= values_buffer_->data() &&
+      data + num_values * sizeof(T) <= values_buffer_->data() + values_buffer_->size()) {
+    current_encoder_->PutFromBuffer(values, static_cast<int>(num_values), values_buffer_);
+  } else {
+    current_encoder_->Put(values, static_cast<int>(num_values));
+  }
 }
 
 template <typename DType>
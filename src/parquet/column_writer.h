@@ -20,9 +20,11 @@
 
 #include <vector>
 
+#include "parquet/bloom_filter.h"
 #include "parquet/column_page.h"
 #include "parquet/encoding.h"
 #include "parquet/file/metadata.h"
+#include "parquet/hyperloglog.h"
 #include "parquet/properties.h"
 #include "parquet/schema.h"
 #include "parquet/statistics.h"
@@ -70,6 +72,22 @@ class PARQUET_EXPORT LevelEncoder {
 };
 
 static constexpr int WRITE_BATCH_SIZE = 1000;
+
+// Why a dictionary encoded column chunk fell back to the column's encoding
+struct DictionaryFallback {
+  enum type {
+    // Still dictionary encoded, or never was
+    NONE,
+    // The dictionary page reached dictionary_pagesize_limit
+    DICTIONARY_PAGE_SIZE_LIMIT,
+    // The dictionary was not smaller than the PLAIN encoded values, see
+    // WriterProperties::dictionary_benefit_check_values
+    NO_SIZE_BENEFIT,
+    // The writers exceeded WriterProperties::memory_budget
+    MEMORY_BUDGET
+  };
+};
+
 class PARQUET_EXPORT ColumnWriter {
  public:
   ColumnWriter(ColumnChunkMetaDataBuilder*, std::unique_ptr<PageWriter>,
@@ -81,6 +99,8 @@ class PARQUET_EXPORT ColumnWriter {
                                             int64_t expected_rows,
                                             const WriterProperties* properties);
 
+  virtual ~ColumnWriter();
+
   Type::type type() const { return descr_->physical_type(); }
 
   const ColumnDescriptor* descr() const { return descr_; }
@@ -88,10 +108,28 @@ class PARQUET_EXPORT ColumnWriter {
   /**
    * Closes the ColumnWriter, commits any buffered values to pages.
    *
-   * @return Total size of the column in bytes
+   * @return Total size of the column in bytes, including its Bloom filter
    */
   int64_t Close();
 
+  DictionaryFallback::type dictionary_fallback() const { return dictionary_fallback_; }
+
+  // Number of rows written so far
+  int64_t rows_written() const { return num_rows_; }
+
+  // Bytes held in memory until the pages are written: the buffered values and
+  // levels, the dictionary and the data pages buffered while dictionary encoding
+  int64_t buffered_bytes();
+
+  // The bytes accounted in the memory budget: buffered_bytes, and the capacity
+  // of the buffers reused from page to page to encode and compress them, which
+  // the writer releases when over the budget
+  int64_t memory_bytes();
+
+  // Time the encoding and statistics, and record the dictionary fallbacks. The
+  // stats are not owned.
+  void set_stats(ColumnWriterStats* stats) { stats_ = stats; }
+
  protected:
   virtual std::shared_ptr<Buffer> GetValuesBuffer() = 0;
 
@@ -113,10 +151,42 @@ class PARQUET_EXPORT ColumnWriter {
   // Merges page statistics into chunk statistics, then resets the values
   virtual void ResetPageStatistics() = 0;
 
+  // Bloom filter of the whole chunk, nullptr if it is not written
+  virtual const BloomFilter* GetBloomFilter() = 0;
+
+  // Distinct count sketch of the whole chunk, nullptr if it is not computed
+  virtual const HyperLogLog* GetDistinctCountSketch() = 0;
+
+  // Bytes held by the value encoder, including its dictionary
+  virtual int64_t EstimatedBufferedValueBytes() = 0;
+
+  // Account for the bytes held by this writer in the memory budget. Returns
+  // true if the writer should release them, see WriterMemoryBudget::Update.
+  bool UpdateMemoryBudget();
+
   // Adds Data Pages to an in memory buffer in dictionary encoding mode
   // Serializes the Data Pages in other encoding modes
   void AddDataPage();
 
+  // Hands the buffer of a page that outlives AddDataPage over to the page: the
+  // member buffer it came from is replaced by a fresh one, instead of copying
+  // the page
+  void ReleasePageBuffer(const std::shared_ptr<Buffer>& page_buffer);
+  // Same for each of the buffers of a page, or the buffers they are slices of
+  void ReleasePageBuffers(const std::vector<std::shared_ptr<Buffer>>& page_buffers);
+  // Replace all the member page buffers by empty ones, releasing their capacity
+  void ResetPageBuffers();
+
+  // Whether the current page holds data_page_values_limit values
+  bool PageValuesLimitReached() const {
+    int64_t limit = properties_->data_page_values_limit();
+    return limit > 0 && num_buffered_values_ >= limit;
+  }
+
+  // Number of levels to write before checking the page limits again: the
+  // write batch size, without going past data_page_values_limit
+  int64_t MiniBatchSize() const;
+
   // Serializes Data Pages
   void WriteDataPage(const CompressedDataPage& page);
 
@@ -126,9 +196,11 @@ class PARQUET_EXPORT ColumnWriter {
   // Write multiple repetition levels
   void WriteRepetitionLevels(int64_t num_levels, const int16_t* levels);
 
-  // RLE encode the src_buffer into dest_buffer and return the encoded size
+  // RLE encode the src_buffer into dest_buffer and return the encoded size.
+  // The encoded levels are preceded by their length unless include_length is
+  // false, as in DATA_PAGE_V2 pages.
   int64_t RleEncodeLevels(const Buffer& src_buffer, ResizableBuffer* dest_buffer,
-                          int16_t max_level);
+                          int16_t max_level, bool include_length = true);
 
   // Serialize the buffered Data Pages
   void FlushBufferedDataPages();
@@ -138,7 +210,8 @@ class PARQUET_EXPORT ColumnWriter {
 
   std::unique_ptr<PageWriter> pager_;
 
-  // The number of rows that should be written in this column chunk.
+  // The number of rows that should be written in this column chunk, negative
+  // if it is not known in advance.
   int64_t expected_rows_;
   bool has_dictionary_;
   Encoding::type encoding_;
@@ -164,6 +237,9 @@ class PARQUET_EXPORT ColumnWriter {
   // Total number of rows written with this ColumnWriter
   int num_rows_;
 
+  // Number of rows in the data pages added so far
+  int64_t num_paged_rows_;
+
   // Records the total number of bytes written by the serializer
   int64_t total_bytes_written_;
 
@@ -172,6 +248,10 @@ class PARQUET_EXPORT ColumnWriter {
 
   // Flag to infer if dictionary encoding has fallen back to PLAIN
   bool fallback_;
+  DictionaryFallback::type dictionary_fallback_;
+
+  // Whether the size of the dictionary was compared with the PLAIN encoded size
+  bool dictionary_benefit_checked_;
 
   std::unique_ptr<InMemoryOutputStream> definition_levels_sink_;
   std::unique_ptr<InMemoryOutputStream> repetition_levels_sink_;
@@ -183,6 +263,13 @@ class PARQUET_EXPORT ColumnWriter {
   std::shared_ptr<ResizableBuffer> compressed_data_;
 
   std::vector<CompressedDataPage> data_pages_;
+  int64_t data_pages_size_;
+
+  // Not owned, nullptr if the memory is not bounded
+  WriterMemoryBudget* memory_budget_;
+
+  // nullptr unless statistics are collected
+  ColumnWriterStats* stats_;
 
  private:
   void InitSinks();
@@ -203,6 +290,13 @@ class PARQUET_EXPORT TypedColumnWriter : public ColumnWriter {
   void WriteBatch(int64_t num_values, const int16_t* def_levels,
                   const int16_t* rep_levels, const T* values);
 
+  // Same as WriteBatch, where the values are owned by values_buffer, which
+  // must stay unchanged while it is referenced. The PLAIN encoding references
+  // the values instead of copying them, until their page is written.
+  void WriteBatch(int64_t num_values, const int16_t* def_levels,
+                  const int16_t* rep_levels, const T* values,
+                  const std::shared_ptr<Buffer>& values_buffer);
+
   /// Write a batch of repetition levels, definition levels, and values to the
   /// column.
   ///
@@ -233,6 +327,20 @@ class PARQUET_EXPORT TypedColumnWriter : public ColumnWriter {
                         const int16_t* rep_levels, const uint8_t* valid_bits,
                         int64_t valid_bits_offset, const T* values);
 
+  /// Write a batch of values given as indices into a dictionary of distinct
+  /// values, such as the ones of an arrow::DictionaryArray.
+  ///
+  /// The levels are the same as for WriteBatch, and indices holds one entry per
+  /// non-null value. While the column chunk is dictionary encoded, the entries of
+  /// dictionary referenced by indices are added to the chunk's dictionary and
+  /// the indices are written as they are, or remapped if the chunk's dictionary
+  /// holds the entries at other positions: the values themselves are not
+  /// hashed.
+  void WriteBatchIndices(int64_t num_values, const int16_t* def_levels,
+                         const int16_t* rep_levels, int64_t num_indices,
+                         const int32_t* indices, int64_t dictionary_length,
+                         const T* dictionary);
+
  protected:
   std::shared_ptr<Buffer> GetValuesBuffer() override {
     return current_encoder_->FlushValues();
@@ -242,10 +350,19 @@ class PARQUET_EXPORT TypedColumnWriter : public ColumnWriter {
   EncodedStatistics GetPageStatistics() override;
   EncodedStatistics GetChunkStatistics() override;
   void ResetPageStatistics() override;
+  const BloomFilter* GetBloomFilter() override { return bloom_filter_.get(); }
+  int64_t EstimatedBufferedValueBytes() override;
+
+  const HyperLogLog* GetDistinctCountSketch() override {
+    return distinct_count_sketch_.get();
+  }
 
  private:
+  // If indices is not null, it holds the indices of the values in the
+  // dictionary of current_encoder_, which are buffered instead of the values
   int64_t WriteMiniBatch(int64_t num_values, const int16_t* def_levels,
-                         const int16_t* rep_levels, const T* values);
+                         const int16_t* rep_levels, const T* values,
+                         const int32_t* indices = nullptr);
 
   int64_t WriteMiniBatchSpaced(int64_t num_values, const int16_t* def_levels,
                                const int16_t* rep_levels, const uint8_t* valid_bits,
@@ -254,15 +371,52 @@ class PARQUET_EXPORT TypedColumnWriter : public ColumnWriter {
 
   typedef Encoder<DType> EncoderType;
 
+  // Write the dictionary page and the buffered pages, and encode the next
+  // values with the column's encoding
+  void FallbackToPlainEncoding(DictionaryFallback::type reason);
+
+  // Release the bytes held by this writer if the memory budget is exceeded:
+  // fall back from dictionary encoding, which writes the buffered pages, or
+  // write the current page
+  void CheckMemoryBudget();
+
   // Write values to a temporary buffer before they are encoded into pages
   void WriteValues(int64_t num_values, const T* values);
   void WriteValuesSpaced(int64_t num_values, const uint8_t* valid_bits,
                          int64_t valid_bits_offset, const T* values);
   std::unique_ptr<EncoderType> current_encoder_;
+  // Made up front with the dictionary encoder, so that an encoding the physical
+  // type does not support is rejected before any page is written
+  std::unique_ptr<EncoderType> fallback_encoder_;
+
+  // Owner of the values of the current WriteBatch call, if known
+  std::shared_ptr<Buffer> values_buffer_;
 
   typedef TypedRowGroupStatistics<DType> TypedStats;
   std::unique_ptr<TypedStats> page_statistics_;
   std::unique_ptr<TypedStats> chunk_statistics_;
+
+  // Insert the hashes of the values written into the Bloom filter and the
+  // distinct count sketch, unless the dictionary still collects them
+  void UpdateValueHashes(int64_t num_values, const T* values);
+  void UpdateValueHashesSpaced(int64_t num_values, const uint8_t* valid_bits,
+                               int64_t valid_bits_offset, const T* values);
+
+  bool HashesValues() const {
+    return bloom_filter_ != nullptr || distinct_count_sketch_ != nullptr;
+  }
+
+  // Created with the first values to insert. While dictionary encoding, only
+  // the distinct values are hashed, when the dictionary page is written.
+  bool bloom_filter_enabled_;
+  std::unique_ptr<BloomFilter> bloom_filter_;
+
+  // Created like the Bloom filter. The distinct count of a chunk that did not
+  // fall back from dictionary encoding is the exact number of dictionary
+  // entries, -1 otherwise.
+  bool distinct_count_enabled_;
+  std::unique_ptr<HyperLogLog> distinct_count_sketch_;
+  int64_t dictionary_distinct_count_;
 };
 
 typedef TypedColumnWriter<BooleanType> BoolWriter;
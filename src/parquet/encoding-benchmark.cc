@@ -17,6 +17,11 @@
 
 #include "benchmark/benchmark.h"
 
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
 #include "parquet/encoding-internal.h"
 #include "parquet/file/reader-internal.h"
 #include "parquet/util/memory.h"
@@ -159,6 +164,281 @@ static void BM_DictDecodingInt64_literals(::benchmark::State& state) {
 
 BENCHMARK(BM_DictDecodingInt64_literals)->Range(1024, 65536);
 
+static void BM_DictDecodingInt64_runs(::benchmark::State& state) {
+  typedef Int64Type Type;
+  typedef typename Type::c_type T;
+
+  // Short runs of repeated values mixed with literal runs
+  std::vector<T> values(state.range(0));
+  for (size_t i = 0; i < values.size(); ++i) {
+    values[i] = (i / 16) % 2 == 0 ? static_cast<T>(i / 16) : static_cast<T>(i);
+  }
+  DecodeDict<Type>(values, state);
+}
+
+BENCHMARK(BM_DictDecodingInt64_runs)->Range(1024, 65536);
+
+// ----------------------------------------------------------------------
+// Decoders of every encoding, across value widths and run lengths
+
+// Values per encoded page
+constexpr int kDecodeValues = 64 * 1024;
+
+static std::shared_ptr<ColumnDescriptor> MakeDescriptor(Type::type type) {
+  auto node = PrimitiveNode::Make("column", Repetition::REQUIRED, type);
+  return std::make_shared<ColumnDescriptor>(node, 0, 0);
+}
+
+// The values of the benchmarked pages, which own the bytes of byte arrays
+template <typename DType>
+struct DecodeValues {
+  typedef typename DType::c_type T;
+
+  // Runs of run_length copies of values with bit_width random bits
+  void MakeRuns(int bit_width, int run_length) {
+    std::mt19937 rng(0);
+    std::uniform_int_distribution<uint64_t> dist(0, (1ULL << bit_width) - 1);
+    for (int i = 0; i < kDecodeValues; i += run_length) {
+      T value = static_cast<T>(dist(rng));
+      for (int k = i; k < std::min(i + run_length, kDecodeValues); ++k) {
+        values.push_back(value);
+      }
+    }
+    value_bytes = kDecodeValues * sizeof(T);
+  }
+
+  // Ascending values, the difference of two consecutive values having
+  // delta_bit_width random bits
+  void MakeDeltas(int delta_bit_width) {
+    std::mt19937 rng(0);
+    uint64_t max_delta = (1ULL << delta_bit_width) - 1;
+    std::uniform_int_distribution<uint64_t> dist(0, max_delta);
+    uint64_t value = 0;
+    for (int i = 0; i < kDecodeValues; ++i) {
+      value += dist(rng);
+      values.push_back(static_cast<T>(value));
+    }
+    value_bytes = kDecodeValues * sizeof(T);
+  }
+
+  std::vector<T> values;
+  int64_t value_bytes = 0;
+};
+
+template <>
+struct DecodeValues<ByteArrayType> {
+  // Strings of value_length bytes, the first prefix_length of which are shared
+  // by runs of run_length values
+  void MakeStrings(int value_length, int prefix_length, int run_length) {
+    std::mt19937 rng(0);
+    std::uniform_int_distribution<int> dist('a', 'z');
+    std::string prefix;
+    for (int i = 0; i < kDecodeValues; ++i) {
+      if (i % run_length == 0) {
+        prefix.clear();
+        for (int k = 0; k < prefix_length; ++k) {
+          prefix.push_back(static_cast<char>(dist(rng)));
+        }
+      }
+      std::string value = prefix;
+      while (static_cast<int>(value.size()) < value_length) {
+        value.push_back(static_cast<char>(dist(rng)));
+      }
+      strings.push_back(value);
+    }
+    Finish();
+  }
+
+  // Runs of run_length copies of strings drawn from 2^bit_width distinct ones
+  void MakeRuns(int bit_width, int run_length) {
+    std::mt19937 rng(0);
+    std::uniform_int_distribution<uint64_t> dist(0, (1ULL << bit_width) - 1);
+    for (int i = 0; i < kDecodeValues; i += run_length) {
+      std::string value = "value-" + std::to_string(dist(rng));
+      for (int k = i; k < std::min(i + run_length, kDecodeValues); ++k) {
+        strings.push_back(value);
+      }
+    }
+    Finish();
+  }
+
+  void Finish() {
+    for (const std::string& value : strings) {
+      values.push_back(ByteArray(static_cast<uint32_t>(value.size()),
+                                 reinterpret_cast<const uint8_t*>(value.data())));
+      value_bytes += value.size();
+    }
+  }
+
+  std::vector<std::string> strings;
+  std::vector<ByteArray> values;
+  int64_t value_bytes = 0;
+};
+
+template <typename DType>
+static void DecodePage(::benchmark::State& state, Decoder<DType>* decoder,
+                       const Buffer& page, const DecodeValues<DType>& values) {
+  std::vector<typename DType::c_type> output(kDecodeValues);
+
+  while (state.KeepRunning()) {
+    decoder->SetData(kDecodeValues, page.data(), static_cast<int>(page.size()));
+    decoder->Decode(output.data(), kDecodeValues);
+  }
+  state.SetItemsProcessed(state.iterations() * kDecodeValues);
+  state.SetBytesProcessed(state.iterations() * values.value_bytes);
+}
+
+template <typename DType>
+static void DecodePlain(::benchmark::State& state, const DecodeValues<DType>& values) {
+  std::shared_ptr<ColumnDescriptor> descr = MakeDescriptor(DType::type_num);
+  PlainEncoder<DType> encoder(descr.get());
+  encoder.Put(values.values.data(), kDecodeValues);
+  std::shared_ptr<Buffer> page = encoder.FlushValues();
+
+  PlainDecoder<DType> decoder(descr.get());
+  DecodePage(state, &decoder, *page, values);
+}
+
+template <typename DType>
+static void DecodeDictionary(::benchmark::State& state,
+                             const DecodeValues<DType>& values) {
+  std::shared_ptr<ColumnDescriptor> descr = MakeDescriptor(DType::type_num);
+  ChunkedAllocator pool;
+  MemoryPool* allocator = default_memory_pool();
+  DictEncoder<DType> encoder(descr.get(), &pool, allocator);
+  encoder.Put(values.values.data(), kDecodeValues);
+
+  std::shared_ptr<PoolBuffer> dictionary =
+      AllocateBuffer(allocator, encoder.dict_encoded_size());
+  encoder.WriteDict(dictionary->mutable_data());
+  std::shared_ptr<PoolBuffer> indices =
+      AllocateBuffer(allocator, encoder.EstimatedDataEncodedSize());
+  int indices_size = encoder.WriteIndices(indices->mutable_data(),
+                                          static_cast<int>(indices->size()));
+  PARQUET_THROW_NOT_OK(indices->Resize(indices_size));
+
+  PlainDecoder<DType> dictionary_decoder(descr.get());
+  dictionary_decoder.SetData(encoder.num_entries(), dictionary->data(),
+                             static_cast<int>(dictionary->size()));
+  DictionaryDecoder<DType> decoder(descr.get());
+  decoder.SetDict(&dictionary_decoder);
+  DecodePage(state, &decoder, *indices, values);
+}
+
+template <typename DType>
+static void BM_PlainDecoding(::benchmark::State& state) {
+  DecodeValues<DType> values;
+  values.MakeRuns(8 * sizeof(typename DType::c_type) - 1, 1);
+  DecodePlain(state, values);
+}
+
+BENCHMARK_TEMPLATE(BM_PlainDecoding, Int32Type);
+BENCHMARK_TEMPLATE(BM_PlainDecoding, Int64Type);
+BENCHMARK_TEMPLATE(BM_PlainDecoding, FloatType);
+BENCHMARK_TEMPLATE(BM_PlainDecoding, DoubleType);
+
+// The argument is the length of the values
+static void BM_PlainDecodingByteArray(::benchmark::State& state) {
+  DecodeValues<ByteArrayType> values;
+  values.MakeStrings(static_cast<int>(state.range(0)), 0, 1);
+  DecodePlain(state, values);
+}
+
+BENCHMARK(BM_PlainDecodingByteArray)->Arg(4)->Arg(16)->Arg(64)->Arg(256);
+
+// The arguments are the bit width of the distinct values and the run length
+template <typename DType>
+static void BM_DictionaryDecoding(::benchmark::State& state) {
+  DecodeValues<DType> values;
+  values.MakeRuns(static_cast<int>(state.range(0)), static_cast<int>(state.range(1)));
+  DecodeDictionary(state, values);
+}
+
+static void DictionaryArguments(::benchmark::internal::Benchmark* b) {
+  for (int bit_width : {1, 4, 8, 12, 16}) {
+    for (int run_length : {1, 8, 64}) {
+      b->Args({bit_width, run_length});
+    }
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_DictionaryDecoding, Int32Type)->Apply(DictionaryArguments);
+BENCHMARK_TEMPLATE(BM_DictionaryDecoding, Int64Type)->Apply(DictionaryArguments);
+BENCHMARK_TEMPLATE(BM_DictionaryDecoding, DoubleType)->Apply(DictionaryArguments);
+BENCHMARK_TEMPLATE(BM_DictionaryDecoding, ByteArrayType)->Apply(DictionaryArguments);
+
+// The argument is the bit width of the deltas
+template <typename DType>
+static void BM_DeltaBitPackDecoding(::benchmark::State& state) {
+  DecodeValues<DType> values;
+  values.MakeDeltas(static_cast<int>(state.range(0)));
+
+  DeltaBitPackEncoder<DType> encoder(nullptr);
+  encoder.Put(values.values.data(), kDecodeValues);
+  std::shared_ptr<Buffer> page = encoder.FlushValues();
+
+  DeltaBitPackDecoder<DType> decoder(nullptr);
+  DecodePage(state, &decoder, *page, values);
+}
+
+BENCHMARK_TEMPLATE(BM_DeltaBitPackDecoding, Int32Type)
+    ->Arg(0)
+    ->Arg(1)
+    ->Arg(4)
+    ->Arg(8)
+    ->Arg(16)
+    ->Arg(24);
+BENCHMARK_TEMPLATE(BM_DeltaBitPackDecoding, Int64Type)
+    ->Arg(0)
+    ->Arg(1)
+    ->Arg(4)
+    ->Arg(8)
+    ->Arg(16)
+    ->Arg(32)
+    ->Arg(48);
+
+// The argument is the length of the values
+static void BM_DeltaLengthByteArrayDecoding(::benchmark::State& state) {
+  DecodeValues<ByteArrayType> values;
+  values.MakeStrings(static_cast<int>(state.range(0)), 0, 1);
+
+  DeltaLengthByteArrayEncoder encoder(nullptr);
+  encoder.Put(values.values.data(), kDecodeValues);
+  std::shared_ptr<Buffer> page = encoder.FlushValues();
+
+  DeltaLengthByteArrayDecoder decoder(nullptr);
+  DecodePage(state, &decoder, *page, values);
+}
+
+BENCHMARK(BM_DeltaLengthByteArrayDecoding)->Arg(4)->Arg(16)->Arg(64)->Arg(256);
+
+// The arguments are the length of the values, the length of the prefixes
+// shared by consecutive values and the number of values sharing a prefix
+static void BM_DeltaByteArrayDecoding(::benchmark::State& state) {
+  DecodeValues<ByteArrayType> values;
+  values.MakeStrings(static_cast<int>(state.range(0)), static_cast<int>(state.range(1)),
+                     static_cast<int>(state.range(2)));
+
+  DeltaByteArrayEncoder encoder(nullptr);
+  encoder.Put(values.values.data(), kDecodeValues);
+  std::shared_ptr<Buffer> page = encoder.FlushValues();
+
+  DeltaByteArrayDecoder decoder(nullptr);
+  DecodePage(state, &decoder, *page, values);
+}
+
+static void DeltaByteArrayArguments(::benchmark::internal::Benchmark* b) {
+  for (int value_length : {16, 64}) {
+    for (int prefix_percent : {0, 50, 90}) {
+      for (int run_length : {1, 8, 64}) {
+        b->Args({value_length, value_length * prefix_percent / 100, run_length});
+      }
+    }
+  }
+}
+
+BENCHMARK(BM_DeltaByteArrayDecoding)->Apply(DeltaByteArrayArguments);
+
 }  // namespace benchmark
 
 }  // namespace parquet
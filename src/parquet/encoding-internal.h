@@ -22,8 +22,18 @@
 #include <cstdint>
 #include <limits>
 #include <memory>
+#include <string>
+#include <type_traits>
 #include <vector>
 
+#if defined(PARQUET_USE_SSE) && defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#if defined(PARQUET_USE_SSE) && defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
 #include "arrow/util/bit-stream-utils.h"
 #include "arrow/util/bit-util.h"
 #include "arrow/util/cpu-info.h"
@@ -35,6 +45,7 @@
 #include "parquet/exception.h"
 #include "parquet/schema.h"
 #include "parquet/types.h"
+#include "parquet/util/bitmap.h"
 #include "parquet/util/memory.h"
 
 namespace parquet {
@@ -70,6 +81,22 @@ class PlainDecoder : public Decoder<DType> {
 
   virtual int Decode(T* buffer, int max_values);
 
+  // Skip over up to max_values fixed-width values and set *out to their
+  // location in the page data instead of copying them. Returns the number of
+  // values skipped.
+  int DecodeZeroCopy(int max_values, const uint8_t** out) {
+    max_values = std::min(max_values, num_values_);
+    int bytes_to_decode = max_values * static_cast<int>(sizeof(T));
+    if (len_ < bytes_to_decode) {
+      ParquetException::EofException();
+    }
+    *out = data_;
+    data_ += bytes_to_decode;
+    len_ -= bytes_to_decode;
+    num_values_ -= max_values;
+    return max_values;
+  }
+
  private:
   using Decoder<DType>::descr_;
   const uint8_t* data_;
@@ -140,38 +167,95 @@ template <>
 class PlainDecoder<BooleanType> : public Decoder<BooleanType> {
  public:
   explicit PlainDecoder(const ColumnDescriptor* descr)
-      : Decoder<BooleanType>(descr, Encoding::PLAIN) {}
+      : Decoder<BooleanType>(descr, Encoding::PLAIN),
+        data_(nullptr),
+        num_bits_(0),
+        bit_offset_(0) {}
 
   virtual void SetData(int num_values, const uint8_t* data, int len) {
     num_values_ = num_values;
-    bit_reader_ = ::arrow::BitReader(data, len);
+    data_ = data;
+    num_bits_ = static_cast<int64_t>(len) * 8;
+    bit_offset_ = 0;
   }
 
   // Two flavors of bool decoding
   int Decode(uint8_t* buffer, int max_values) {
+    return DecodeBitmap(buffer, 0, max_values);
+  }
+
+  virtual int Decode(bool* buffer, int max_values) {
     max_values = std::min(max_values, num_values_);
-    bool val;
+    CheckAvailable(max_values);
     for (int i = 0; i < max_values; ++i) {
-      if (!bit_reader_.GetValue(1, &val)) {
-        ParquetException::EofException();
-      }
-      BitUtil::SetArrayBit(buffer, i, val);
+      buffer[i] = ::arrow::BitUtil::GetBit(data_, bit_offset_ + i);
     }
-    num_values_ -= max_values;
+    Advance(max_values);
     return max_values;
   }
 
-  virtual int Decode(bool* buffer, int max_values) {
+  // PLAIN booleans are bit-packed like an Arrow bitmap, so the values are
+  // copied as is into bits, starting at bit bits_offset
+  int DecodeBitmap(uint8_t* bits, int64_t bits_offset, int max_values) {
     max_values = std::min(max_values, num_values_);
-    if (bit_reader_.GetBatch(1, buffer, max_values) != max_values) {
+    CheckAvailable(max_values);
+    CopyBitmap(data_, bit_offset_, max_values, bits, bits_offset);
+    Advance(max_values);
+    return max_values;
+  }
+
+  // Like DecodeBitmap, but spreads the values over the num_values slots of
+  // the valid_bits bitmap and clears the bits of the null slots
+  int DecodeBitmapSpaced(uint8_t* bits, int64_t bits_offset, int num_values,
+                         int null_count, const uint8_t* valid_bits,
+                         int64_t valid_bits_offset) {
+    if (null_count == 0) {
+      if (DecodeBitmap(bits, bits_offset, num_values) != num_values) {
+        ParquetException::EofException();
+      }
+      return num_values;
+    }
+    int values_to_read = num_values - null_count;
+    if (values_to_read > num_values_) {
       ParquetException::EofException();
     }
-    num_values_ -= max_values;
-    return max_values;
+    CheckAvailable(values_to_read);
+    // Copy the values of each run of valid slots at once
+    int i = 0;
+    while (i < num_values) {
+      bool is_valid = ::arrow::BitUtil::GetBit(valid_bits, valid_bits_offset + i);
+      int run_length = 1;
+      while (i + run_length < num_values &&
+             ::arrow::BitUtil::GetBit(valid_bits, valid_bits_offset + i + run_length) ==
+                 is_valid) {
+        ++run_length;
+      }
+      if (is_valid) {
+        CopyBitmap(data_, bit_offset_, run_length, bits, bits_offset + i);
+        Advance(run_length);
+      } else {
+        FillBitmap(bits, bits_offset + i, run_length, false);
+      }
+      i += run_length;
+    }
+    return num_values;
   }
 
  private:
-  ::arrow::BitReader bit_reader_;
+  void CheckAvailable(int num_values) const {
+    if (bit_offset_ + num_values > num_bits_) {
+      ParquetException::EofException();
+    }
+  }
+
+  void Advance(int num_values) {
+    bit_offset_ += num_values;
+    num_values_ -= num_values;
+  }
+
+  const uint8_t* data_;
+  int64_t num_bits_;
+  int64_t bit_offset_;
 };
 
 // ----------------------------------------------------------------------
@@ -184,17 +268,34 @@ class PlainEncoder : public Encoder<DType> {
 
   explicit PlainEncoder(const ColumnDescriptor* descr,
                         ::arrow::MemoryPool* pool = ::arrow::default_memory_pool())
-      : Encoder<DType>(descr, Encoding::PLAIN, pool) {
-    values_sink_.reset(new InMemoryOutputStream(pool));
+      : Encoder<DType>(descr, Encoding::PLAIN, pool),
+        referenced_data_(nullptr),
+        referenced_size_(0) {
+    values_sink_.reset(new ChunkedOutputStream(pool));
   }
 
-  int64_t EstimatedDataEncodedSize() override { return values_sink_->Tell(); }
+  int64_t EstimatedDataEncodedSize() override {
+    return values_sink_->Tell() + referenced_size_;
+  }
 
   std::shared_ptr<Buffer> FlushValues() override;
   void Put(const T* src, int num_values) override;
 
+  // The values of a page are referenced, and flushed as a slice of the owner,
+  // as long as they are all contiguous in the same buffer
+  void PutFromBuffer(const T* src, int num_values,
+                     const std::shared_ptr<Buffer>& owner) override;
+
  protected:
-  std::unique_ptr<InMemoryOutputStream> values_sink_;
+  // Copy the referenced values into values_sink_
+  void CopyReferencedValues();
+
+  // Chunked, so that the values of large pages are copied once, by FlushValues
+  std::unique_ptr<ChunkedOutputStream> values_sink_;
+
+  std::shared_ptr<Buffer> referenced_;
+  const uint8_t* referenced_data_;
+  int64_t referenced_size_;
 };
 
 template <>
@@ -277,16 +378,49 @@ class PlainEncoder<BooleanType> : public Encoder<BooleanType> {
 
 template <typename DType>
 inline std::shared_ptr<Buffer> PlainEncoder<DType>::FlushValues() {
-  std::shared_ptr<Buffer> buffer = values_sink_->GetBuffer();
-  values_sink_.reset(new InMemoryOutputStream(this->pool_));
-  return buffer;
+  if (referenced_ != nullptr) {
+    std::shared_ptr<Buffer> buffer = ::arrow::SliceBuffer(
+        referenced_, referenced_data_ - referenced_->data(), referenced_size_);
+    referenced_.reset();
+    referenced_data_ = nullptr;
+    referenced_size_ = 0;
+    return buffer;
+  }
+  return values_sink_->GetBuffer();
+}
+
+template <typename DType>
+inline void PlainEncoder<DType>::CopyReferencedValues() {
+  if (referenced_ != nullptr) {
+    values_sink_->Write(referenced_data_, referenced_size_);
+    referenced_.reset();
+    referenced_data_ = nullptr;
+    referenced_size_ = 0;
+  }
 }
 
 template <typename DType>
 inline void PlainEncoder<DType>::Put(const T* buffer, int num_values) {
+  CopyReferencedValues();
   values_sink_->Write(reinterpret_cast<const uint8_t*>(buffer), num_values * sizeof(T));
 }
 
+template <typename DType>
+inline void PlainEncoder<DType>::PutFromBuffer(const T* src, int num_values,
+                                               const std::shared_ptr<Buffer>& owner) {
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(src);
+  const int64_t nbytes = num_values * sizeof(T);
+  if (referenced_ == nullptr && values_sink_->Tell() == 0) {
+    referenced_ = owner;
+    referenced_data_ = data;
+    referenced_size_ = nbytes;
+  } else if (referenced_ == owner && data == referenced_data_ + referenced_size_) {
+    referenced_size_ += nbytes;
+  } else {
+    Put(src, num_values);
+  }
+}
+
 template <>
 inline void PlainEncoder<ByteArrayType>::Put(const ByteArray* src, int num_values) {
   for (int i = 0; i < num_values; ++i) {
@@ -311,9 +445,61 @@ inline void PlainEncoder<FLBAType>::Put(const FixedLenByteArray* src, int num_va
   }
 }
 
+// The encoded values of byte arrays are not laid out as in the owner
+
+template <>
+inline void PlainEncoder<ByteArrayType>::PutFromBuffer(
+    const ByteArray* src, int num_values, const std::shared_ptr<Buffer>& owner) {
+  Put(src, num_values);
+}
+
+template <>
+inline void PlainEncoder<FLBAType>::PutFromBuffer(
+    const FixedLenByteArray* src, int num_values, const std::shared_ptr<Buffer>& owner) {
+  Put(src, num_values);
+}
+
 // ----------------------------------------------------------------------
 // Dictionary encoding and decoding
 
+// Write dictionary[indices[i]] to out[i] for the num_values indices. With
+// AVX2, 4-byte values are gathered 8 at a time and 8-byte values 4 at a time.
+template <typename T>
+inline void GatherDictionary(const T* dictionary, const int32_t* indices,
+                             int num_values, T* out) {
+  int i = 0;
+#if defined(PARQUET_USE_SSE) && defined(__AVX2__)
+  if (sizeof(T) == 4) {
+    const int* base = reinterpret_cast<const int*>(dictionary);
+    for (; i + 8 <= num_values; i += 8) {
+      __m256i index = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices + i));
+      __m256i values = _mm256_i32gather_epi32(base, index, 4);
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), values);
+    }
+  } else if (sizeof(T) == 8) {
+    const long long* base = reinterpret_cast<const long long*>(dictionary);
+    for (; i + 4 <= num_values; i += 4) {
+      __m128i index = _mm_loadu_si128(reinterpret_cast<const __m128i*>(indices + i));
+      __m256i values = _mm256_i32gather_epi64(base, index, 8);
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), values);
+    }
+  }
+#endif
+  for (; i + 4 <= num_values; i += 4) {
+    T v0 = dictionary[indices[i]];
+    T v1 = dictionary[indices[i + 1]];
+    T v2 = dictionary[indices[i + 2]];
+    T v3 = dictionary[indices[i + 3]];
+    out[i] = v0;
+    out[i + 1] = v1;
+    out[i + 2] = v2;
+    out[i + 3] = v3;
+  }
+  for (; i < num_values; ++i) {
+    out[i] = dictionary[indices[i]];
+  }
+}
+
 template <typename Type>
 class DictionaryDecoder : public Decoder<Type> {
  public:
@@ -326,6 +512,7 @@ class DictionaryDecoder : public Decoder<Type> {
                              ::arrow::MemoryPool* pool = ::arrow::default_memory_pool())
       : Decoder<Type>(descr, Encoding::RLE_DICTIONARY),
         dictionary_(0, pool),
+        dictionary_length_(0),
         byte_array_data_(AllocateBuffer(pool, 0)) {}
 
   // Perform type-specific initiatialization
@@ -343,7 +530,9 @@ class DictionaryDecoder : public Decoder<Type> {
   int Decode(T* buffer, int max_values) override {
     max_values = std::min(max_values, num_values_);
     int decoded_values =
-        idx_decoder_.GetBatchWithDict(dictionary_.data(), buffer, max_values);
+        kGatherValues
+            ? GatherBatch(buffer, max_values)
+            : idx_decoder_.GetBatchWithDict(dictionary_.data(), buffer, max_values);
     if (decoded_values != max_values) {
       ParquetException::EofException();
     }
@@ -351,6 +540,20 @@ class DictionaryDecoder : public Decoder<Type> {
     return max_values;
   }
 
+  // Decode the dictionary indices of the next values instead of the values
+  int DecodeIndices(int32_t* indices, int max_values) {
+    max_values = std::min(max_values, num_values_);
+    int decoded_values = idx_decoder_.GetBatch(indices, max_values);
+    if (decoded_values != max_values) {
+      ParquetException::EofException();
+    }
+    num_values_ -= max_values;
+    return max_values;
+  }
+
+  const T* dictionary() const { return dictionary_.data(); }
+  int dictionary_length() const { return dictionary_length_; }
+
   int DecodeSpaced(T* buffer, int num_values, int null_count, const uint8_t* valid_bits,
                    int64_t valid_bits_offset) override {
     int decoded_values =
@@ -365,8 +568,33 @@ class DictionaryDecoder : public Decoder<Type> {
  private:
   using Decoder<Type>::num_values_;
 
+  // RleDecoder::GetBatchWithDict looks values up one at a time and fills
+  // repeated runs. Without AVX2 it is as fast as unpacking the indices first.
+  static constexpr bool kGatherValues =
+#if defined(PARQUET_USE_SSE) && defined(__AVX2__)
+      std::is_arithmetic<T>::value && (sizeof(T) == 4 || sizeof(T) == 8);
+#else
+      false;
+#endif
+
+  // Unpack the indices a block at a time and gather their values
+  int GatherBatch(T* buffer, int num_values) {
+    constexpr int kGatherBatchSize = 1024;
+    int32_t indices[kGatherBatchSize];
+    int decoded_values = 0;
+    while (decoded_values < num_values) {
+      int batch_size = std::min(num_values - decoded_values, kGatherBatchSize);
+      int num_indices = idx_decoder_.GetBatch(indices, batch_size);
+      if (num_indices == 0) break;
+      GatherDictionary(dictionary_.data(), indices, num_indices, buffer + decoded_values);
+      decoded_values += num_indices;
+    }
+    return decoded_values;
+  }
+
   // Only one is set.
   Vector<T> dictionary_;
+  int dictionary_length_;
 
   // Data that contains the byte array data (byte_array_dictionary_ just has the
   // pointers).
@@ -380,6 +608,7 @@ inline void DictionaryDecoder<Type>::SetDict(Decoder<Type>* dictionary) {
   int num_dictionary_values = dictionary->values_left();
   dictionary_.Resize(num_dictionary_values);
   dictionary->Decode(&dictionary_[0], num_dictionary_values);
+  dictionary_length_ = num_dictionary_values;
 }
 
 template <>
@@ -393,6 +622,7 @@ inline void DictionaryDecoder<ByteArrayType>::SetDict(
   int num_dictionary_values = dictionary->values_left();
   dictionary_.Resize(num_dictionary_values);
   dictionary->Decode(&dictionary_[0], num_dictionary_values);
+  dictionary_length_ = num_dictionary_values;
 
   int total_size = 0;
   for (int i = 0; i < num_dictionary_values; ++i) {
@@ -414,6 +644,7 @@ inline void DictionaryDecoder<FLBAType>::SetDict(Decoder<FLBAType>* dictionary)
   int num_dictionary_values = dictionary->values_left();
   dictionary_.Resize(num_dictionary_values);
   dictionary->Decode(&dictionary_[0], num_dictionary_values);
+  dictionary_length_ = num_dictionary_values;
 
   int fixed_len = descr_->type_length();
   int total_size = num_dictionary_values * fixed_len;
@@ -440,6 +671,32 @@ static constexpr int INITIAL_HASH_TABLE_SIZE = 1 << 10;
 typedef int32_t hash_slot_t;
 static constexpr hash_slot_t HASH_SLOT_EMPTY = std::numeric_limits<int32_t>::max();
 
+// Each slot of the hash table holds the hash of a dictionary entry in its upper
+// 32 bits and the entry's index in its lower 32 bits. Most probes that do not
+// match are then rejected without touching the entry itself.
+typedef int64_t packed_hash_slot_t;
+
+static inline packed_hash_slot_t PackHashSlot(int hash, hash_slot_t index) {
+  return static_cast<packed_hash_slot_t>(
+      (static_cast<uint64_t>(static_cast<uint32_t>(hash)) << 32) |
+      static_cast<uint32_t>(index));
+}
+
+static constexpr packed_hash_slot_t PACKED_HASH_SLOT_EMPTY =
+    static_cast<packed_hash_slot_t>(static_cast<uint32_t>(HASH_SLOT_EMPTY));
+
+static inline hash_slot_t HashSlotIndex(packed_hash_slot_t slot) {
+  return static_cast<hash_slot_t>(static_cast<uint32_t>(slot));
+}
+
+static inline int HashSlotHash(packed_hash_slot_t slot) {
+  return static_cast<int>(static_cast<uint32_t>(static_cast<uint64_t>(slot) >> 32));
+}
+
+// Number of values whose hash table slots are prefetched ahead of their
+// insertion by DictEncoder::Put(const T*, int)
+static constexpr int DICT_PUT_BATCH_SIZE = 16;
+
 // The maximum load factor for the hash table before resizing.
 static constexpr double MAX_HASH_LOAD = 0.7;
 
@@ -462,8 +719,12 @@ class DictEncoder : public Encoder<DType> {
         mod_bitmask_(hash_table_size_ - 1),
         hash_slots_(0, allocator),
         dict_encoded_size_(0),
+        num_values_(0),
+        plain_encoded_size_(0),
+        tracks_references_(false),
+        num_referenced_entries_(0),
         type_length_(desc->type_length()) {
-    hash_slots_.Assign(hash_table_size_, HASH_SLOT_EMPTY);
+    hash_slots_.Assign(hash_table_size_, PACKED_HASH_SLOT_EMPTY);
     if (!::arrow::CpuInfo::initialized()) {
       ::arrow::CpuInfo::Init();
     }
@@ -505,12 +766,36 @@ class DictEncoder : public Encoder<DType> {
 
   int hash_table_size() { return hash_table_size_; }
   int dict_encoded_size() { return dict_encoded_size_; }
+
+  /// The number of values put so far, including those already written out
+  int64_t num_values() const { return num_values_; }
+
+  /// The number of bytes the values put so far would take in PLAIN encoding
+  int64_t plain_encoded_size() const { return plain_encoded_size_; }
+
+  /// The bytes held by the hash table, the dictionary entries and the buffered
+  /// indices. The data of byte array entries is held by the ChunkedAllocator.
+  int64_t memory_size() const {
+    return static_cast<int64_t>(hash_table_size_) * sizeof(packed_hash_slot_t) +
+           static_cast<int64_t>(uniques_.capacity() * sizeof(T)) +
+           static_cast<int64_t>(buffered_indices_.capacity() * sizeof(int));
+  }
+
   /// Clears all the indices (but leaves the dictionary).
   void ClearIndices() { buffered_indices_.clear(); }
 
   /// Encode value. Note that this does not actually write any data, just
   /// buffers the value's index to be written later.
-  void Put(const T& value);
+  void Put(const T& value) { Put(value, Hash(value)); }
+
+  /// Add the value to the dictionary unless it is there already, and return
+  /// its index. Unlike Put, no index is buffered: the entry may end up never
+  /// referenced (see num_referenced_entries).
+  int GetOrInsert(const T& value);
+
+  /// Buffer the indices of values that are already in the dictionary, as
+  /// returned by GetOrInsert.
+  void PutIndices(const int32_t* indices, int num_values);
 
   std::shared_ptr<Buffer> FlushValues() override {
     std::shared_ptr<PoolBuffer> buffer =
@@ -522,9 +807,19 @@ class DictEncoder : public Encoder<DType> {
     return buffer;
   };
 
+  // The values are hashed in batches, and the slots they map to prefetched
+  // before they are inserted
   void Put(const T* values, int num_values) override {
-    for (int i = 0; i < num_values; i++) {
-      Put(values[i]);
+    int hashes[DICT_PUT_BATCH_SIZE];
+    for (int offset = 0; offset < num_values; offset += DICT_PUT_BATCH_SIZE) {
+      int batch_size = std::min(DICT_PUT_BATCH_SIZE, num_values - offset);
+      for (int i = 0; i < batch_size; i++) {
+        hashes[i] = Hash(values[offset + i]);
+        PrefetchSlot(hashes[i]);
+      }
+      for (int i = 0; i < batch_size; i++) {
+        Put(values[offset + i], hashes[i]);
+      }
     }
   }
 
@@ -548,6 +843,17 @@ class DictEncoder : public Encoder<DType> {
   /// The number of entries in the dictionary.
   int num_entries() const { return static_cast<int>(uniques_.size()); }
 
+  /// The number of entries referenced by the values put so far: the distinct
+  /// values. Lower than num_entries if entries added by GetOrInsert were never
+  /// put.
+  int num_referenced_entries() const {
+    return tracks_references_ ? num_referenced_entries_ : num_entries();
+  }
+
+  /// The dictionary entries, in index order. BYTE_ARRAY entries point into
+  /// mem_pool().
+  const std::vector<T>& uniques() const { return uniques_; }
+
  private:
   ::arrow::MemoryPool* allocator_;
 
@@ -563,8 +869,8 @@ class DictEncoder : public Encoder<DType> {
 
   // We use a fixed-size hash table with linear probing
   //
-  // These values correspond to the uniques_ array
-  Vector<hash_slot_t> hash_slots_;
+  // The indices in these slots correspond to the uniques_ array
+  Vector<packed_hash_slot_t> hash_slots_;
 
   /// Indices that have not yet be written out by WriteIndices().
   std::vector<int> buffered_indices_;
@@ -572,9 +878,19 @@ class DictEncoder : public Encoder<DType> {
   /// The number of bytes needed to encode the dictionary.
   int dict_encoded_size_;
 
+  int64_t num_values_;
+  int64_t plain_encoded_size_;
+
   // The unique observed values
   std::vector<T> uniques_;
 
+  // Whether the entries are referenced, only tracked once GetOrInsert is used
+  bool tracks_references_;
+  std::vector<bool> referenced_;
+  int num_referenced_entries_;
+
+  void MarkReferenced(int index);
+
   bool SlotDifferent(const T& v, hash_slot_t slot);
   void DoubleTableSize();
 
@@ -584,8 +900,24 @@ class DictEncoder : public Encoder<DType> {
   /// Hash function for mapping a value to a bucket.
   inline int Hash(const T& value) const;
 
+  /// Insert the value, whose hash is already computed
+  inline void Put(const T& value, int hash);
+
+  /// Add the value to the dictionary unless it is there already, and return
+  /// its index
+  inline int Insert(const T& value, int hash);
+
+  inline void PrefetchSlot(int hash) const {
+#if defined(__GNUC__)
+    __builtin_prefetch(hash_slots_.data() + (hash & mod_bitmask_));
+#endif
+  }
+
   /// Adds value to the hash table and updates dict_encoded_size_
   void AddDictKey(const T& value);
+
+  /// Size of the value in PLAIN encoding
+  inline int PlainEncodedSize(const T& value) const;
 };
 
 template <typename DType>
@@ -593,6 +925,41 @@ inline int DictEncoder<DType>::Hash(const typename DType::c_type& value) const {
   return HashUtil::Hash(&value, sizeof(value), 0);
 }
 
+// Values of at most 8 bytes are hashed with a few multiplications (the
+// finalizer of MurmurHash3) rather than the generic byte hash
+static inline int HashFixedWidth(uint64_t bits) {
+  bits ^= bits >> 33;
+  bits *= 0xff51afd7ed558ccdULL;
+  bits ^= bits >> 33;
+  bits *= 0xc4ceb9fe1a85ec53ULL;
+  bits ^= bits >> 33;
+  return static_cast<int>(static_cast<uint32_t>(bits));
+}
+
+template <>
+inline int DictEncoder<Int32Type>::Hash(const int32_t& value) const {
+  return HashFixedWidth(static_cast<uint32_t>(value));
+}
+
+template <>
+inline int DictEncoder<Int64Type>::Hash(const int64_t& value) const {
+  return HashFixedWidth(static_cast<uint64_t>(value));
+}
+
+template <>
+inline int DictEncoder<FloatType>::Hash(const float& value) const {
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return HashFixedWidth(bits);
+}
+
+template <>
+inline int DictEncoder<DoubleType>::Hash(const double& value) const {
+  uint64_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return HashFixedWidth(bits);
+}
+
 template <>
 inline int DictEncoder<ByteArrayType>::Hash(const ByteArray& value) const {
   if (value.len > 0) {
@@ -609,6 +976,21 @@ inline int DictEncoder<FLBAType>::Hash(const FixedLenByteArray& value) const {
   return HashUtil::Hash(value.ptr, type_length_, 0);
 }
 
+template <typename DType>
+inline int DictEncoder<DType>::PlainEncodedSize(const typename DType::c_type&) const {
+  return static_cast<int>(sizeof(typename DType::c_type));
+}
+
+template <>
+inline int DictEncoder<ByteArrayType>::PlainEncodedSize(const ByteArray& value) const {
+  return static_cast<int>(value.len + sizeof(uint32_t));
+}
+
+template <>
+inline int DictEncoder<FLBAType>::PlainEncodedSize(const FixedLenByteArray&) const {
+  return type_length_;
+}
+
 template <typename DType>
 inline bool DictEncoder<DType>::SlotDifferent(const typename DType::c_type& v,
                                               hash_slot_t slot) {
@@ -622,22 +1004,36 @@ inline bool DictEncoder<FLBAType>::SlotDifferent(const FixedLenByteArray& v,
 }
 
 template <typename DType>
-inline void DictEncoder<DType>::Put(const typename DType::c_type& v) {
-  int j = Hash(v) & mod_bitmask_;
-  hash_slot_t index = hash_slots_[j];
+inline void DictEncoder<DType>::Put(const typename DType::c_type& v, int hash) {
+  int index = Insert(v, hash);
+  if (ARROW_PREDICT_FALSE(tracks_references_)) {
+    MarkReferenced(index);
+  }
+  buffered_indices_.push_back(index);
+  ++num_values_;
+  plain_encoded_size_ += PlainEncodedSize(v);
+}
 
-  // Find an empty slot
-  while (HASH_SLOT_EMPTY != index && SlotDifferent(v, index)) {
+template <typename DType>
+inline int DictEncoder<DType>::Insert(const typename DType::c_type& v, int hash) {
+  int j = hash & mod_bitmask_;
+  packed_hash_slot_t slot = hash_slots_[j];
+  hash_slot_t index = HashSlotIndex(slot);
+
+  // Find an empty slot. The value is only compared to entries with the same hash
+  while (HASH_SLOT_EMPTY != index &&
+         (HashSlotHash(slot) != hash || SlotDifferent(v, index))) {
     // Linear probing
     ++j;
     if (j == hash_table_size_) j = 0;
-    index = hash_slots_[j];
+    slot = hash_slots_[j];
+    index = HashSlotIndex(slot);
   }
 
   if (index == HASH_SLOT_EMPTY) {
     // Not in the hash table, so we insert it now
     index = static_cast<hash_slot_t>(uniques_.size());
-    hash_slots_[j] = index;
+    hash_slots_[j] = PackHashSlot(hash, index);
     AddDictKey(v);
 
     if (ARROW_PREDICT_FALSE(static_cast<int>(uniques_.size()) >
@@ -645,39 +1041,73 @@ inline void DictEncoder<DType>::Put(const typename DType::c_type& v) {
       DoubleTableSize();
     }
   }
+  return index;
+}
 
-  buffered_indices_.push_back(index);
+template <typename DType>
+inline void DictEncoder<DType>::MarkReferenced(int index) {
+  if (index == static_cast<int>(referenced_.size())) {
+    // Inserted by Put
+    referenced_.push_back(true);
+    ++num_referenced_entries_;
+  } else if (!referenced_[index]) {
+    referenced_[index] = true;
+    ++num_referenced_entries_;
+  }
+}
+
+template <typename DType>
+inline int DictEncoder<DType>::GetOrInsert(const typename DType::c_type& value) {
+  if (!tracks_references_) {
+    // The entries added so far were all put
+    tracks_references_ = true;
+    referenced_.assign(uniques_.size(), true);
+    num_referenced_entries_ = num_entries();
+  }
+  int index = Insert(value, Hash(value));
+  if (index == static_cast<int>(referenced_.size())) {
+    referenced_.push_back(false);
+  }
+  return index;
+}
+
+template <typename DType>
+inline void DictEncoder<DType>::PutIndices(const int32_t* indices, int num_values) {
+  for (int i = 0; i < num_values; i++) {
+    DCHECK_GE(indices[i], 0);
+    DCHECK_LT(indices[i], num_entries());
+    if (tracks_references_) {
+      MarkReferenced(indices[i]);
+    }
+    buffered_indices_.push_back(indices[i]);
+    plain_encoded_size_ += PlainEncodedSize(uniques_[indices[i]]);
+  }
+  num_values_ += num_values;
 }
 
 template <typename DType>
 inline void DictEncoder<DType>::DoubleTableSize() {
   int new_size = hash_table_size_ * 2;
-  Vector<hash_slot_t> new_hash_slots(0, allocator_);
-  new_hash_slots.Assign(new_size, HASH_SLOT_EMPTY);
-  hash_slot_t index, slot;
-  int j;
+  Vector<packed_hash_slot_t> new_hash_slots(0, allocator_);
+  new_hash_slots.Assign(new_size, PACKED_HASH_SLOT_EMPTY);
   for (int i = 0; i < hash_table_size_; ++i) {
-    index = hash_slots_[i];
+    packed_hash_slot_t slot = hash_slots_[i];
 
-    if (index == HASH_SLOT_EMPTY) {
+    if (HashSlotIndex(slot) == HASH_SLOT_EMPTY) {
       continue;
     }
 
-    // Compute the hash value mod the new table size to start looking for an
-    // empty slot
-    const typename DType::c_type& v = uniques_[index];
-
-    // Find an empty slot in the new hash table
-    j = Hash(v) & (new_size - 1);
-    slot = new_hash_slots[j];
-    while (HASH_SLOT_EMPTY != slot && SlotDifferent(v, slot)) {
+    // The entries are distinct, so the first empty slot starting at the
+    // stored hash mod the new table size is the right one; neither the value
+    // nor its hash need to be looked at again
+    int j = HashSlotHash(slot) & (new_size - 1);
+    while (HashSlotIndex(new_hash_slots[j]) != HASH_SLOT_EMPTY) {
       ++j;
       if (j == new_size) j = 0;
-      slot = new_hash_slots[j];
     }
 
-    // Copy the old slot index to the new hash table
-    new_hash_slots[j] = index;
+    // Copy the old slot to the new hash table
+    new_hash_slots[j] = slot;
   }
 
   hash_table_size_ = new_size;
@@ -775,6 +1205,73 @@ inline int DictEncoder<DType>::WriteIndices(uint8_t* buffer, int buffer_len) {
 // ----------------------------------------------------------------------
 // DeltaBitPackDecoder
 
+namespace internal {
+
+// Unpack 32 little-endian values of kBitWidth bits. Unrolled by the compiler,
+// every load and shift is a constant. Reads up to 4 * kBitWidth + 9 bytes.
+template <int kBitWidth>
+inline void Unpack32(const uint8_t* in, uint64_t* out) {
+  const uint64_t mask = kBitWidth == 64 ? ~0ULL : (1ULL << (kBitWidth % 64)) - 1;
+  for (int i = 0; i < 32; ++i) {
+    const int bit = i * kBitWidth;
+    const int shift = bit % 8;
+    uint64_t word;
+    memcpy(&word, in + bit / 8, sizeof(uint64_t));
+    uint64_t value = word >> shift;
+    if (shift + kBitWidth > 64) {
+      value |= static_cast<uint64_t>(in[bit / 8 + 8]) << ((64 - shift) % 64);
+    }
+    out[i] = value & mask;
+  }
+}
+
+template <>
+inline void Unpack32<0>(const uint8_t* in, uint64_t* out) {
+  std::fill(out, out + 32, 0);
+}
+
+#define PARQUET_UNPACK32_CASE(width) \
+  case width:                        \
+    Unpack32<width>(in, out);        \
+    break;
+
+#define PARQUET_UNPACK32_CASES8(base) \
+  PARQUET_UNPACK32_CASE(base)         \
+  PARQUET_UNPACK32_CASE(base + 1)     \
+  PARQUET_UNPACK32_CASE(base + 2)     \
+  PARQUET_UNPACK32_CASE(base + 3)     \
+  PARQUET_UNPACK32_CASE(base + 4)     \
+  PARQUET_UNPACK32_CASE(base + 5)     \
+  PARQUET_UNPACK32_CASE(base + 6)     \
+  PARQUET_UNPACK32_CASE(base + 7)
+
+// Dispatch to the unpacking routine of each bit width from 0 to 64
+inline void Unpack32(int bit_width, const uint8_t* in, uint64_t* out) {
+  switch (bit_width) {
+    PARQUET_UNPACK32_CASES8(0)
+    PARQUET_UNPACK32_CASES8(8)
+    PARQUET_UNPACK32_CASES8(16)
+    PARQUET_UNPACK32_CASES8(24)
+    PARQUET_UNPACK32_CASES8(32)
+    PARQUET_UNPACK32_CASES8(40)
+    PARQUET_UNPACK32_CASES8(48)
+    PARQUET_UNPACK32_CASES8(56)
+    PARQUET_UNPACK32_CASE(64)
+    default:
+      throw ParquetException("Invalid bit width for DELTA_BINARY_PACKED data");
+  }
+}
+
+#undef PARQUET_UNPACK32_CASES8
+#undef PARQUET_UNPACK32_CASE
+
+}  // namespace internal
+
+// Decodes DELTA_BINARY_PACKED data: a header with the block size, the number
+// of miniblocks per block, the number of values and the first value, then
+// blocks holding their minimum delta, the bit width of each miniblock and
+// the bit-packed miniblocks. Each miniblock is unpacked at once and turned
+// back into values with a running sum over the deltas.
 template <typename DType>
 class DeltaBitPackDecoder : public Decoder<DType> {
  public:
@@ -783,138 +1280,490 @@ class DeltaBitPackDecoder : public Decoder<DType> {
   explicit DeltaBitPackDecoder(const ColumnDescriptor* descr,
                                ::arrow::MemoryPool* pool = ::arrow::default_memory_pool())
       : Decoder<DType>(descr, Encoding::DELTA_BINARY_PACKED),
-        delta_bit_widths_(new PoolBuffer(pool)) {
+        delta_bit_widths_(new PoolBuffer(pool)),
+        mini_block_values_(new PoolBuffer(pool)) {
     if (DType::type_num != Type::INT32 && DType::type_num != Type::INT64) {
       throw ParquetException("Delta bit pack encoding should only be for integer data.");
     }
   }
 
   virtual void SetData(int num_values, const uint8_t* data, int len) {
-    num_values_ = num_values;
-    decoder_ = ::arrow::BitReader(data, len);
-    values_current_block_ = 0;
+    data_ = data;
+    data_end_ = data + len;
+    if (len == 0) {
+      num_values_ = 0;
+      return;
+    }
+
+    uint64_t block_size = GetVlqInt();
+    num_mini_blocks_ = GetVlqInt();
+    uint64_t total_values = GetVlqInt();
+    last_value_ = GetZigZagVlqInt();
+    // The buffers below are sized from the header: the bit widths of a block
+    // take a byte per miniblock of the page, and the block size is bounded
+    if (num_mini_blocks_ == 0 || block_size % num_mini_blocks_ != 0 ||
+        (block_size / num_mini_blocks_) % 32 != 0 || block_size > kMaxBlockSize ||
+        num_mini_blocks_ > static_cast<uint64_t>(len)) {
+      throw ParquetException("Invalid DELTA_BINARY_PACKED block header");
+    }
+    values_per_mini_block_ = static_cast<int>(block_size / num_mini_blocks_);
+    PARQUET_THROW_NOT_OK(delta_bit_widths_->Resize(num_mini_blocks_, false));
+    PARQUET_THROW_NOT_OK(mini_block_values_->Resize(
+        values_per_mini_block_ * sizeof(uint64_t), false));
+
+    num_values_ = static_cast<int>(std::min<uint64_t>(num_values, total_values));
+    first_value_pending_ = true;
+    mini_block_idx_ = num_mini_blocks_;
     values_current_mini_block_ = 0;
   }
 
   virtual int Decode(T* buffer, int max_values) {
-    return GetInternal(buffer, max_values);
+    max_values = std::min(max_values, num_values_);
+    int i = 0;
+    if (max_values > 0 && first_value_pending_) {
+      buffer[i++] = static_cast<T>(last_value_);
+      first_value_pending_ = false;
+    }
+    auto values = reinterpret_cast<const uint64_t*>(mini_block_values_->data());
+    while (i < max_values) {
+      if (values_current_mini_block_ == 0) {
+        DecodeMiniBlock();
+      }
+      int n = std::min(max_values - i, values_current_mini_block_);
+      const uint64_t* in = values + (values_per_mini_block_ - values_current_mini_block_);
+      for (int k = 0; k < n; ++k) {
+        buffer[i + k] = static_cast<T>(in[k]);
+      }
+      i += n;
+      values_current_mini_block_ -= n;
+    }
+    num_values_ -= max_values;
+    return max_values;
   }
 
+  // The position just past the miniblocks of the values decoded so far. Once
+  // all values are decoded, this is the end of the DELTA_BINARY_PACKED data.
+  const uint8_t* position() const { return data_; }
+
  private:
   using Decoder<DType>::num_values_;
 
-  void InitBlock() {
-    int32_t block_size;
-    if (!decoder_.GetVlqInt(&block_size)) ParquetException::EofException();
-    if (!decoder_.GetVlqInt(&num_mini_blocks_)) ParquetException::EofException();
-    if (!decoder_.GetVlqInt(&values_current_block_)) {
-      ParquetException::EofException();
+  uint64_t GetVlqInt() {
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      if (data_ == data_end_) ParquetException::EofException();
+      uint8_t byte = *data_++;
+      value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+      if ((byte & 0x80) == 0) return value;
     }
-    if (!decoder_.GetZigZagVlqInt(&last_value_)) ParquetException::EofException();
-    PARQUET_THROW_NOT_OK(delta_bit_widths_->Resize(num_mini_blocks_, false));
+    throw ParquetException("Invalid VLQ integer in DELTA_BINARY_PACKED data");
+  }
 
-    uint8_t* bit_width_data = delta_bit_widths_->mutable_data();
+  uint64_t GetZigZagVlqInt() {
+    uint64_t value = GetVlqInt();
+    return (value >> 1) ^ (~(value & 1) + 1);
+  }
 
-    if (!decoder_.GetZigZagVlqInt(&min_delta_)) ParquetException::EofException();
-    for (int i = 0; i < num_mini_blocks_; ++i) {
-      if (!decoder_.GetAligned<uint8_t>(1, bit_width_data + i)) {
+  // Read the next block header if needed, then unpack the next miniblock and
+  // reconstruct its values into mini_block_values_
+  void DecodeMiniBlock() {
+    uint8_t* bit_widths = delta_bit_widths_->mutable_data();
+    if (mini_block_idx_ == num_mini_blocks_) {
+      min_delta_ = GetZigZagVlqInt();
+      if (data_end_ - data_ < static_cast<int64_t>(num_mini_blocks_)) {
         ParquetException::EofException();
       }
+      memcpy(bit_widths, data_, num_mini_blocks_);
+      data_ += num_mini_blocks_;
+      mini_block_idx_ = 0;
+    }
+    const int bit_width = bit_widths[mini_block_idx_++];
+    uint64_t* values = reinterpret_cast<uint64_t*>(mini_block_values_->mutable_data());
+
+    // Groups of 32 values take 4 * bit_width bytes. Near the end of the data
+    // they are copied to a padded buffer, as unpacking reads past them; a
+    // truncated last miniblock unpacks to zeros.
+    const int group_bytes = 4 * bit_width;
+    for (int i = 0; i < values_per_mini_block_; i += 32) {
+      if (data_end_ - data_ >= group_bytes + 16) {
+        internal::Unpack32(bit_width, data_, values + i);
+      } else {
+        uint8_t padded[4 * 64 + 16] = {0};
+        memcpy(padded, data_, std::min<int64_t>(group_bytes, data_end_ - data_));
+        internal::Unpack32(bit_width, padded, values + i);
+      }
+      data_ += std::min<int64_t>(group_bytes, data_end_ - data_);
     }
-    values_per_mini_block_ = block_size / num_mini_blocks_;
-    mini_block_idx_ = 0;
-    delta_bit_width_ = bit_width_data[0];
+
+    // Running sum of the deltas, in wrapping unsigned arithmetic
+    uint64_t value = last_value_;
+    for (int i = 0; i < values_per_mini_block_; ++i) {
+      value += min_delta_ + values[i];
+      values[i] = value;
+    }
+    last_value_ = value;
     values_current_mini_block_ = values_per_mini_block_;
   }
 
-  template <typename T>
-  int GetInternal(T* buffer, int max_values) {
-    max_values = std::min(max_values, num_values_);
-    const uint8_t* bit_width_data = delta_bit_widths_->data();
-    for (int i = 0; i < max_values; ++i) {
-      if (ARROW_PREDICT_FALSE(values_current_mini_block_ == 0)) {
-        ++mini_block_idx_;
-        if (mini_block_idx_ < static_cast<size_t>(delta_bit_widths_->size())) {
-          delta_bit_width_ = bit_width_data[mini_block_idx_];
-          values_current_mini_block_ = values_per_mini_block_;
-        } else {
-          InitBlock();
-          buffer[i] = last_value_;
-          continue;
-        }
+  // Writers use blocks of 128 values
+  static constexpr uint64_t kMaxBlockSize = 1 << 16;
+
+  const uint8_t* data_;
+  const uint8_t* data_end_;
+
+  size_t num_mini_blocks_;
+  int values_per_mini_block_;
+  size_t mini_block_idx_;
+  int values_current_mini_block_;
+  uint64_t min_delta_;
+  uint64_t last_value_;
+  bool first_value_pending_;
+
+  std::unique_ptr<PoolBuffer> delta_bit_widths_;
+  std::unique_ptr<PoolBuffer> mini_block_values_;
+};
+
+// ----------------------------------------------------------------------
+// DeltaBitPackEncoder
+
+namespace internal {
+
+// Pack 32 values, each smaller than 2^kBitWidth, into 4 * kBitWidth
+// little-endian bytes: the layout read by Unpack32
+template <int kBitWidth>
+inline void Pack32(const uint64_t* in, uint8_t* out) {
+  uint64_t word = 0;
+  int word_bits = 0;
+  for (int i = 0; i < 32; ++i) {
+    word |= in[i] << word_bits;
+    word_bits += kBitWidth;
+    if (word_bits >= 64) {
+      memcpy(out, &word, sizeof(uint64_t));
+      out += sizeof(uint64_t);
+      word_bits -= 64;
+      word = word_bits == 0 ? 0 : in[i] >> (kBitWidth - word_bits);
+    }
+  }
+  // 32 * kBitWidth is a multiple of 8, so only whole bytes are left
+  memcpy(out, &word, word_bits / 8);
+}
+
+template <>
+inline void Pack32<0>(const uint64_t*, uint8_t*) {}
+
+#define PARQUET_PACK32_CASE(width) \
+  case width:                      \
+    Pack32<width>(in, out);        \
+    break;
+
+#define PARQUET_PACK32_CASES8(base) \
+  PARQUET_PACK32_CASE(base)         \
+  PARQUET_PACK32_CASE(base + 1)     \
+  PARQUET_PACK32_CASE(base + 2)     \
+  PARQUET_PACK32_CASE(base + 3)     \
+  PARQUET_PACK32_CASE(base + 4)     \
+  PARQUET_PACK32_CASE(base + 5)     \
+  PARQUET_PACK32_CASE(base + 6)     \
+  PARQUET_PACK32_CASE(base + 7)
+
+// Dispatch to the packing routine of each bit width from 0 to 64
+inline void Pack32(int bit_width, const uint64_t* in, uint8_t* out) {
+  switch (bit_width) {
+    PARQUET_PACK32_CASES8(0)
+    PARQUET_PACK32_CASES8(8)
+    PARQUET_PACK32_CASES8(16)
+    PARQUET_PACK32_CASES8(24)
+    PARQUET_PACK32_CASES8(32)
+    PARQUET_PACK32_CASES8(40)
+    PARQUET_PACK32_CASES8(48)
+    PARQUET_PACK32_CASES8(56)
+    PARQUET_PACK32_CASE(64)
+    default:
+      throw ParquetException("Invalid bit width for DELTA_BINARY_PACKED data");
+  }
+}
+
+#undef PARQUET_PACK32_CASES8
+#undef PARQUET_PACK32_CASE
+
+// Write a ULEB128 integer, of at most 10 bytes, and return the position
+// past it
+inline uint8_t* PutVlqInt(uint64_t value, uint8_t* out) {
+  while (value >= 0x80) {
+    *out++ = static_cast<uint8_t>(value | 0x80);
+    value >>= 7;
+  }
+  *out++ = static_cast<uint8_t>(value);
+  return out;
+}
+
+inline uint8_t* PutZigZagVlqInt(int64_t value, uint8_t* out) {
+  const uint64_t sign = value < 0 ? ~0ULL : 0;
+  return PutVlqInt((static_cast<uint64_t>(value) << 1) ^ sign, out);
+}
+
+}  // namespace internal
+
+// Encodes DELTA_BINARY_PACKED data in blocks of 128 values, split into 4
+// miniblocks of 32. Each block is packed into the sink as soon as it is
+// full; the page header, which holds the number of values, is prepended by
+// FlushValues.
+template <typename DType>
+class DeltaBitPackEncoder : public Encoder<DType> {
+ public:
+  typedef typename DType::c_type T;
+  // The deltas wrap around at the width of the physical type, so that the
+  // bit widths of INT32 miniblocks never exceed 32
+  typedef typename std::make_unsigned<T>::type UT;
+
+  static constexpr int kBlockSize = 128;
+  static constexpr int kNumMiniBlocks = 4;
+  static constexpr int kValuesPerMiniBlock = kBlockSize / kNumMiniBlocks;
+
+  explicit DeltaBitPackEncoder(const ColumnDescriptor* descr,
+                               ::arrow::MemoryPool* pool = ::arrow::default_memory_pool())
+      : Encoder<DType>(descr, Encoding::DELTA_BINARY_PACKED, pool),
+        values_sink_(new InMemoryOutputStream(pool)),
+        total_values_(0),
+        first_value_(0),
+        last_value_(0),
+        num_deltas_(0) {
+    if (DType::type_num != Type::INT32 && DType::type_num != Type::INT64) {
+      throw ParquetException("Delta bit pack encoding should only be for integer data.");
+    }
+  }
+
+  int64_t EstimatedDataEncodedSize() override {
+    return kMaxHeaderSize + values_sink_->Tell() + num_deltas_ * sizeof(T);
+  }
+
+  std::shared_ptr<Buffer> FlushValues() override {
+    if (num_deltas_ > 0) FlushBlock();
+
+    uint8_t header[kMaxHeaderSize];
+    uint8_t* header_end = internal::PutVlqInt(kBlockSize, header);
+    header_end = internal::PutVlqInt(kNumMiniBlocks, header_end);
+    header_end = internal::PutVlqInt(total_values_, header_end);
+    header_end = internal::PutZigZagVlqInt(first_value_, header_end);
+    const int64_t header_size = header_end - header;
+
+    std::shared_ptr<Buffer> blocks = values_sink_->GetBuffer();
+    std::shared_ptr<PoolBuffer> buffer =
+        AllocateBuffer(this->pool_, header_size + blocks->size());
+    memcpy(buffer->mutable_data(), header, header_size);
+    if (blocks->size() > 0) {
+      memcpy(buffer->mutable_data() + header_size, blocks->data(), blocks->size());
+    }
+
+    values_sink_.reset(new InMemoryOutputStream(this->pool_));
+    total_values_ = 0;
+    return buffer;
+  }
+
+  void Put(const T* src, int num_values) override {
+    int i = 0;
+    if (num_values > 0 && total_values_ == 0) {
+      first_value_ = src[i++];
+      last_value_ = static_cast<UT>(first_value_);
+    }
+    total_values_ += num_values;
+    for (; i < num_values; ++i) {
+      // Wrapping arithmetic: the decoder adds the deltas back the same way
+      const UT value = static_cast<UT>(src[i]);
+      deltas_[num_deltas_++] = static_cast<T>(static_cast<UT>(value - last_value_));
+      last_value_ = value;
+      if (num_deltas_ == kBlockSize) FlushBlock();
+    }
+  }
+
+ private:
+  // Block size, number of miniblocks, number of values and first value
+  static constexpr int kMaxHeaderSize = 4 * 10;
+
+  // Write the minimum delta, the bit widths and the miniblocks of the
+  // buffered deltas. Miniblocks past the last delta are not written and
+  // have a bit width of 0.
+  void FlushBlock() {
+    const T min_delta = *std::min_element(deltas_, deltas_ + num_deltas_);
+    std::fill(deltas_ + num_deltas_, deltas_ + kBlockSize, min_delta);
+
+    uint8_t header[10 + kNumMiniBlocks];
+    uint8_t* bit_widths = internal::PutZigZagVlqInt(min_delta, header);
+    uint64_t relative[kBlockSize];
+    int num_mini_blocks = 0;
+    for (int start = 0; start < num_deltas_; start += kValuesPerMiniBlock) {
+      uint64_t max_relative = 0;
+      for (int i = start; i < start + kValuesPerMiniBlock; ++i) {
+        relative[i] =
+            static_cast<UT>(static_cast<UT>(deltas_[i]) - static_cast<UT>(min_delta));
+        max_relative = std::max(max_relative, relative[i]);
       }
+      int bit_width = 0;
+      while (bit_width < 64 && (max_relative >> bit_width) != 0) ++bit_width;
+      bit_widths[num_mini_blocks++] = static_cast<uint8_t>(bit_width);
+    }
+    std::fill(bit_widths + num_mini_blocks, bit_widths + kNumMiniBlocks, 0);
+    values_sink_->Write(header, bit_widths + kNumMiniBlocks - header);
 
-      // TODO: the key to this algorithm is to decode the entire miniblock at once.
-      int64_t delta;
-      if (!decoder_.GetValue(delta_bit_width_, &delta)) ParquetException::EofException();
-      delta += min_delta_;
-      last_value_ += static_cast<int32_t>(delta);
-      buffer[i] = last_value_;
-      --values_current_mini_block_;
+    uint8_t packed[4 * 64];
+    for (int k = 0; k < num_mini_blocks; ++k) {
+      internal::Pack32(bit_widths[k], relative + k * kValuesPerMiniBlock, packed);
+      values_sink_->Write(packed, 4 * bit_widths[k]);
     }
-    num_values_ -= max_values;
-    return max_values;
+    num_deltas_ = 0;
   }
 
-  ::arrow::BitReader decoder_;
-  int32_t values_current_block_;
-  int32_t num_mini_blocks_;
-  uint64_t values_per_mini_block_;
-  uint64_t values_current_mini_block_;
+  std::unique_ptr<InMemoryOutputStream> values_sink_;
 
-  int32_t min_delta_;
-  size_t mini_block_idx_;
-  std::unique_ptr<PoolBuffer> delta_bit_widths_;
-  int delta_bit_width_;
+  uint64_t total_values_;
+  int64_t first_value_;
+  UT last_value_;
 
-  int32_t last_value_;
+  int num_deltas_;
+  T deltas_[kBlockSize];
 };
 
 // ----------------------------------------------------------------------
 // DELTA_LENGTH_BYTE_ARRAY
 
+// The DELTA_BINARY_PACKED lengths of the values, followed by their
+// concatenated bytes. All the lengths are decoded by SetData, to find where
+// the bytes begin; the decoded values point into the page.
 class DeltaLengthByteArrayDecoder : public Decoder<ByteArrayType> {
  public:
   explicit DeltaLengthByteArrayDecoder(
       const ColumnDescriptor* descr,
       ::arrow::MemoryPool* pool = ::arrow::default_memory_pool())
       : Decoder<ByteArrayType>(descr, Encoding::DELTA_LENGTH_BYTE_ARRAY),
-        len_decoder_(nullptr, pool) {}
+        len_decoder_(nullptr, pool),
+        lengths_(AllocateBuffer(pool, 0)),
+        current_value_(0),
+        data_(nullptr) {}
 
   virtual void SetData(int num_values, const uint8_t* data, int len) {
-    num_values_ = num_values;
+    num_values_ = 0;
+    current_value_ = 0;
     if (len == 0) return;
-    int total_lengths_len = *reinterpret_cast<const int*>(data);
-    data += 4;
-    len_decoder_.SetData(num_values, data, total_lengths_len);
-    data_ = data + total_lengths_len;
-    len_ = len - 4 - total_lengths_len;
+    len_decoder_.SetData(num_values, data, len);
+    num_values_ = len_decoder_.values_left();
+    PARQUET_THROW_NOT_OK(lengths_->Resize(num_values_ * sizeof(int32_t), false));
+    int32_t* lengths = reinterpret_cast<int32_t*>(lengths_->mutable_data());
+    len_decoder_.Decode(lengths, num_values_);
+
+    data_ = len_decoder_.position();
+    int64_t data_size = data + len - data_;
+    int64_t total_length = 0;
+    for (int i = 0; i < num_values_; ++i) {
+      if (lengths[i] < 0) {
+        throw ParquetException("Negative DELTA_LENGTH_BYTE_ARRAY value length");
+      }
+      total_length += lengths[i];
+    }
+    if (total_length > data_size) {
+      ParquetException::EofException();
+    }
   }
 
+  // The values point into the page data
   virtual int Decode(ByteArray* buffer, int max_values) {
     max_values = std::min(max_values, num_values_);
-    std::vector<int> lengths(max_values);
-    len_decoder_.Decode(lengths.data(), max_values);
+    const int32_t* lengths = reinterpret_cast<const int32_t*>(lengths_->data());
     for (int i = 0; i < max_values; ++i) {
-      buffer[i].len = lengths[i];
+      buffer[i].len = static_cast<uint32_t>(lengths[current_value_ + i]);
       buffer[i].ptr = data_;
-      data_ += lengths[i];
-      len_ -= lengths[i];
+      data_ += buffer[i].len;
     }
+    current_value_ += max_values;
     num_values_ -= max_values;
     return max_values;
   }
 
+  // The lengths of the values that are left to decode
+  const int32_t* lengths() const {
+    return reinterpret_cast<const int32_t*>(lengths_->data()) + current_value_;
+  }
+
+  // The bytes of the values that are left to decode, one after the other
+  const uint8_t* data() const { return data_; }
+
  private:
   using Decoder<ByteArrayType>::num_values_;
   DeltaBitPackDecoder<Int32Type> len_decoder_;
+  std::shared_ptr<PoolBuffer> lengths_;
+  int current_value_;
   const uint8_t* data_;
-  int len_;
+};
+
+namespace internal {
+
+// Copy the data of two encoders, one after the other, into a new buffer
+inline std::shared_ptr<Buffer> ConcatenateBuffers(const std::shared_ptr<Buffer>& first,
+                                                  const std::shared_ptr<Buffer>& second,
+                                                  ::arrow::MemoryPool* pool) {
+  std::shared_ptr<PoolBuffer> buffer =
+      AllocateBuffer(pool, first->size() + second->size());
+  if (first->size() > 0) {
+    memcpy(buffer->mutable_data(), first->data(), first->size());
+  }
+  if (second->size() > 0) {
+    memcpy(buffer->mutable_data() + first->size(), second->data(), second->size());
+  }
+  return buffer;
+}
+
+}  // namespace internal
+
+// Encodes the lengths of the values with DELTA_BINARY_PACKED, and appends
+// their bytes to a separate sink as they are put
+class DeltaLengthByteArrayEncoder : public Encoder<ByteArrayType> {
+ public:
+  explicit DeltaLengthByteArrayEncoder(
+      const ColumnDescriptor* descr,
+      ::arrow::MemoryPool* pool = ::arrow::default_memory_pool())
+      : Encoder<ByteArrayType>(descr, Encoding::DELTA_LENGTH_BYTE_ARRAY, pool),
+        len_encoder_(nullptr, pool),
+        values_sink_(new InMemoryOutputStream(pool)) {}
+
+  int64_t EstimatedDataEncodedSize() override {
+    return len_encoder_.EstimatedDataEncodedSize() + values_sink_->Tell();
+  }
+
+  std::shared_ptr<Buffer> FlushValues() override {
+    std::shared_ptr<Buffer> buffer = internal::ConcatenateBuffers(
+        len_encoder_.FlushValues(), values_sink_->GetBuffer(), this->pool_);
+    values_sink_.reset(new InMemoryOutputStream(this->pool_));
+    return buffer;
+  }
+
+  void Put(const ByteArray* src, int num_values) override {
+    constexpr int kBatchSize = 256;
+    int32_t lengths[kBatchSize];
+    for (int i = 0; i < num_values; i += kBatchSize) {
+      const int n = std::min(kBatchSize, num_values - i);
+      for (int k = 0; k < n; ++k) {
+        const ByteArray& value = src[i + k];
+        lengths[k] = static_cast<int32_t>(value.len);
+        if (value.len > 0) {
+          DCHECK(nullptr != value.ptr) << "Value ptr cannot be NULL";
+          values_sink_->Write(value.ptr, value.len);
+        }
+      }
+      len_encoder_.Put(lengths, n);
+    }
+  }
+
+ private:
+  DeltaBitPackEncoder<Int32Type> len_encoder_;
+  std::unique_ptr<InMemoryOutputStream> values_sink_;
 };
 
 // ----------------------------------------------------------------------
 // DELTA_BYTE_ARRAY
 
+// The DELTA_BINARY_PACKED lengths of the prefixes that each value shares
+// with the previous one, followed by the DELTA_LENGTH_BYTE_ARRAY suffixes.
+// SetData reconstructs all the values of the page into one pooled buffer,
+// sized from the decoded lengths, with Arrow-style offsets.
 class DeltaByteArrayDecoder : public Decoder<ByteArrayType> {
  public:
   explicit DeltaByteArrayDecoder(
@@ -922,48 +1771,306 @@ class DeltaByteArrayDecoder : public Decoder<ByteArrayType> {
       ::arrow::MemoryPool* pool = ::arrow::default_memory_pool())
       : Decoder<ByteArrayType>(descr, Encoding::DELTA_BYTE_ARRAY),
         prefix_len_decoder_(nullptr, pool),
-        suffix_decoder_(nullptr, pool) {}
+        suffix_decoder_(nullptr, pool),
+        prefix_lengths_(AllocateBuffer(pool, 0)),
+        offsets_(AllocateBuffer(pool, 0)),
+        values_(AllocateBuffer(pool, 0)),
+        data_(nullptr),
+        current_value_(0) {}
 
   virtual void SetData(int num_values, const uint8_t* data, int len) {
-    num_values_ = num_values;
+    num_values_ = 0;
+    current_value_ = 0;
     if (len == 0) return;
-    int prefix_len_length = *reinterpret_cast<const int*>(data);
-    data += 4;
-    len -= 4;
-    prefix_len_decoder_.SetData(num_values, data, prefix_len_length);
-    data += prefix_len_length;
-    len -= prefix_len_length;
-    suffix_decoder_.SetData(num_values, data, len);
+    prefix_len_decoder_.SetData(num_values, data, len);
+    int decoded_values = prefix_len_decoder_.values_left();
+    PARQUET_THROW_NOT_OK(
+        prefix_lengths_->Resize(decoded_values * sizeof(int32_t), false));
+    int32_t* prefix_lengths = reinterpret_cast<int32_t*>(prefix_lengths_->mutable_data());
+    prefix_len_decoder_.Decode(prefix_lengths, decoded_values);
+
+    const uint8_t* suffix_data = prefix_len_decoder_.position();
+    suffix_decoder_.SetData(decoded_values, suffix_data,
+                            static_cast<int>(data + len - suffix_data));
+    if (suffix_decoder_.values_left() != decoded_values) {
+      ParquetException::EofException();
+    }
+    const int32_t* suffix_lengths = suffix_decoder_.lengths();
+
+    // Size the output from the lengths, then copy each prefix from the
+    // previous value and append the suffix
+    PARQUET_THROW_NOT_OK(offsets_->Resize((decoded_values + 1) * sizeof(int32_t), false));
+    int32_t* offsets = reinterpret_cast<int32_t*>(offsets_->mutable_data());
+    int64_t total_length = 0;
+    int32_t previous_length = 0;
+    for (int i = 0; i < decoded_values; ++i) {
+      if (prefix_lengths[i] < 0 || prefix_lengths[i] > previous_length) {
+        throw ParquetException("Invalid DELTA_BYTE_ARRAY prefix length");
+      }
+      offsets[i] = static_cast<int32_t>(total_length);
+      previous_length = prefix_lengths[i] + suffix_lengths[i];
+      total_length += previous_length;
+      if (total_length > std::numeric_limits<int32_t>::max()) {
+        throw ParquetException("DELTA_BYTE_ARRAY page is too large");
+      }
+    }
+    offsets[decoded_values] = static_cast<int32_t>(total_length);
+    num_values_ = decoded_values;
+
+    const uint8_t* suffixes = suffix_decoder_.data();
+    if (std::all_of(prefix_lengths, prefix_lengths + decoded_values,
+                    [](int32_t length) { return length == 0; })) {
+      // Without prefixes the values are the concatenated suffixes
+      data_ = suffixes;
+      return;
+    }
+    PARQUET_THROW_NOT_OK(values_->Resize(total_length, false));
+    uint8_t* out = values_->mutable_data();
+    for (int i = 0; i < decoded_values; ++i) {
+      uint8_t* value = out + offsets[i];
+      if (prefix_lengths[i] > 0) {
+        memcpy(value, out + offsets[i - 1], prefix_lengths[i]);
+      }
+      memcpy(value + prefix_lengths[i], suffixes, suffix_lengths[i]);
+      suffixes += suffix_lengths[i];
+    }
+    data_ = out;
   }
 
-  // TODO: this doesn't work and requires memory management. We need to allocate
-  // new strings to store the results.
+  // The values point into a buffer of the decoder, or into the page when
+  // no value has a prefix, valid until the next call to SetData
   virtual int Decode(ByteArray* buffer, int max_values) {
     max_values = std::min(max_values, num_values_);
+    const int32_t* offsets = reinterpret_cast<const int32_t*>(offsets_->data()) +
+                             current_value_;
     for (int i = 0; i < max_values; ++i) {
-      int prefix_len = 0;
-      prefix_len_decoder_.Decode(&prefix_len, 1);
-      ByteArray suffix = {0, NULL};
-      suffix_decoder_.Decode(&suffix, 1);
-      buffer[i].len = prefix_len + suffix.len;
-
-      uint8_t* result = reinterpret_cast<uint8_t*>(malloc(buffer[i].len));
-      memcpy(result, last_value_.ptr, prefix_len);
-      memcpy(result + prefix_len, suffix.ptr, suffix.len);
-
-      buffer[i].ptr = result;
-      last_value_ = buffer[i];
+      buffer[i].len = static_cast<uint32_t>(offsets[i + 1] - offsets[i]);
+      buffer[i].ptr = data_ + offsets[i];
     }
+    current_value_ += max_values;
     num_values_ -= max_values;
     return max_values;
   }
 
+  // The offsets into data() of the values left to decode, one more than
+  // values_left(): value i spans [offsets()[i], offsets()[i + 1])
+  const int32_t* offsets() const {
+    return reinterpret_cast<const int32_t*>(offsets_->data()) + current_value_;
+  }
+
+  // The reconstructed values of the page
+  const uint8_t* data() const { return data_; }
+
  private:
   using Decoder<ByteArrayType>::num_values_;
 
   DeltaBitPackDecoder<Int32Type> prefix_len_decoder_;
   DeltaLengthByteArrayDecoder suffix_decoder_;
-  ByteArray last_value_;
+  std::shared_ptr<PoolBuffer> prefix_lengths_;
+  std::shared_ptr<PoolBuffer> offsets_;
+  std::shared_ptr<PoolBuffer> values_;
+  const uint8_t* data_;
+  int current_value_;
+};
+
+// Encodes the length of the prefix each value shares with the previous one
+// with DELTA_BINARY_PACKED, and the rest of the values with
+// DELTA_LENGTH_BYTE_ARRAY. The first value of every page has no prefix.
+class DeltaByteArrayEncoder : public Encoder<ByteArrayType> {
+ public:
+  explicit DeltaByteArrayEncoder(
+      const ColumnDescriptor* descr,
+      ::arrow::MemoryPool* pool = ::arrow::default_memory_pool())
+      : Encoder<ByteArrayType>(descr, Encoding::DELTA_BYTE_ARRAY, pool),
+        prefix_len_encoder_(nullptr, pool),
+        suffix_encoder_(nullptr, pool) {}
+
+  int64_t EstimatedDataEncodedSize() override {
+    return prefix_len_encoder_.EstimatedDataEncodedSize() +
+           suffix_encoder_.EstimatedDataEncodedSize();
+  }
+
+  std::shared_ptr<Buffer> FlushValues() override {
+    last_value_.clear();
+    return internal::ConcatenateBuffers(prefix_len_encoder_.FlushValues(),
+                                        suffix_encoder_.FlushValues(), this->pool_);
+  }
+
+  void Put(const ByteArray* src, int num_values) override {
+    if (num_values == 0) return;
+    constexpr int kBatchSize = 256;
+    int32_t prefix_lengths[kBatchSize];
+    ByteArray suffixes[kBatchSize];
+    ByteArray previous(static_cast<uint32_t>(last_value_.size()),
+                       reinterpret_cast<const uint8_t*>(last_value_.data()));
+    for (int i = 0; i < num_values; i += kBatchSize) {
+      const int n = std::min(kBatchSize, num_values - i);
+      for (int k = 0; k < n; ++k) {
+        const ByteArray& value = src[i + k];
+        const uint32_t prefix = CommonPrefixLength(previous, value);
+        prefix_lengths[k] = static_cast<int32_t>(prefix);
+        suffixes[k] = ByteArray(value.len - prefix, value.ptr + prefix);
+        previous = value;
+      }
+      prefix_len_encoder_.Put(prefix_lengths, n);
+      suffix_encoder_.Put(suffixes, n);
+    }
+    // The values put may not outlive this call
+    if (previous.len > 0) {
+      last_value_.assign(reinterpret_cast<const char*>(previous.ptr), previous.len);
+    } else {
+      last_value_.clear();
+    }
+  }
+
+ private:
+  // Compares a word at a time, then the bytes of the first different word
+  static uint32_t CommonPrefixLength(const ByteArray& a, const ByteArray& b) {
+    const uint32_t length = std::min(a.len, b.len);
+    uint32_t i = 0;
+    for (; i + sizeof(uint64_t) <= length; i += sizeof(uint64_t)) {
+      uint64_t word_a, word_b;
+      memcpy(&word_a, a.ptr + i, sizeof(uint64_t));
+      memcpy(&word_b, b.ptr + i, sizeof(uint64_t));
+      if (word_a != word_b) break;
+    }
+    while (i < length && a.ptr[i] == b.ptr[i]) ++i;
+    return i;
+  }
+
+  DeltaBitPackEncoder<Int32Type> prefix_len_encoder_;
+  DeltaLengthByteArrayEncoder suffix_encoder_;
+  std::string last_value_;
+};
+
+// ----------------------------------------------------------------------
+// BYTE_STREAM_SPLIT
+
+namespace internal {
+
+// Gather the bytes of the values [0, num_values) from kNumStreams streams of
+// stride bytes each: byte k of value i is data[k * stride + i]
+template <int kNumStreams>
+inline void ByteStreamSplitDecode(const uint8_t* data, int64_t stride, int64_t num_values,
+                                  uint8_t* out) {
+  int64_t i = 0;
+#if defined(PARQUET_USE_SSE) && defined(__SSE2__)
+  // Interleaving the bytes of the two halves of the streams log2(kNumStreams)
+  // times turns 16 bytes of each stream into 16 consecutive values
+  constexpr int kNumStreamsLog2 = kNumStreams == 8 ? 3 : 2;
+  constexpr int kNumStreamsHalf = kNumStreams / 2;
+  static_assert(kNumStreams == 4 || kNumStreams == 8, "Unsupported value size");
+  for (; i + 16 <= num_values; i += 16) {
+    __m128i stage[kNumStreamsLog2 + 1][kNumStreams];
+    for (int k = 0; k < kNumStreams; ++k) {
+      stage[0][k] =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + k * stride + i));
+    }
+    for (int step = 0; step < kNumStreamsLog2; ++step) {
+      for (int k = 0; k < kNumStreamsHalf; ++k) {
+        stage[step + 1][2 * k] =
+            _mm_unpacklo_epi8(stage[step][k], stage[step][kNumStreamsHalf + k]);
+        stage[step + 1][2 * k + 1] =
+            _mm_unpackhi_epi8(stage[step][k], stage[step][kNumStreamsHalf + k]);
+      }
+    }
+    for (int k = 0; k < kNumStreams; ++k) {
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out + (i * kNumStreams) + 16 * k),
+                       stage[kNumStreamsLog2][k]);
+    }
+  }
+#endif
+  for (; i < num_values; ++i) {
+    for (int k = 0; k < kNumStreams; ++k) {
+      out[i * kNumStreams + k] = data[k * stride + i];
+    }
+  }
+}
+
+}  // namespace internal
+
+// Scatters the bytes of each value into sizeof(T) streams, so that the
+// streams of the exponent and of the high mantissa bytes of floating point
+// values compress well. The values are buffered until FlushValues.
+template <typename DType>
+class ByteStreamSplitEncoder : public Encoder<DType> {
+ public:
+  typedef typename DType::c_type T;
+
+  explicit ByteStreamSplitEncoder(
+      const ColumnDescriptor* descr,
+      ::arrow::MemoryPool* pool = ::arrow::default_memory_pool())
+      : Encoder<DType>(descr, Encoding::BYTE_STREAM_SPLIT, pool),
+        values_sink_(new InMemoryOutputStream(pool)) {}
+
+  int64_t EstimatedDataEncodedSize() override { return values_sink_->Tell(); }
+
+  std::shared_ptr<Buffer> FlushValues() override {
+    std::shared_ptr<Buffer> values = values_sink_->GetBuffer();
+    const int64_t num_values = values->size() / kNumStreams;
+    std::shared_ptr<PoolBuffer> buffer = AllocateBuffer(this->pool_, values->size());
+    const uint8_t* in = values->data();
+    uint8_t* out = buffer->mutable_data();
+    for (int k = 0; k < kNumStreams; ++k) {
+      uint8_t* stream = out + k * num_values;
+      for (int64_t i = 0; i < num_values; ++i) {
+        stream[i] = in[i * kNumStreams + k];
+      }
+    }
+    values_sink_.reset(new InMemoryOutputStream(this->pool_));
+    return buffer;
+  }
+
+  void Put(const T* src, int num_values) override {
+    values_sink_->Write(reinterpret_cast<const uint8_t*>(src), num_values * sizeof(T));
+  }
+
+ private:
+  static constexpr int kNumStreams = static_cast<int>(sizeof(T));
+
+  std::unique_ptr<InMemoryOutputStream> values_sink_;
+};
+
+template <typename DType>
+class ByteStreamSplitDecoder : public Decoder<DType> {
+ public:
+  typedef typename DType::c_type T;
+
+  explicit ByteStreamSplitDecoder(const ColumnDescriptor* descr)
+      : Decoder<DType>(descr, Encoding::BYTE_STREAM_SPLIT),
+        data_(nullptr),
+        stride_(0),
+        current_value_(0) {}
+
+  virtual void SetData(int num_values, const uint8_t* data, int len) {
+    if (len % kNumStreams != 0) {
+      throw ParquetException("BYTE_STREAM_SPLIT data size is not a multiple of the "
+                             "value size");
+    }
+    data_ = data;
+    stride_ = len / kNumStreams;
+    current_value_ = 0;
+    num_values_ = static_cast<int>(std::min<int64_t>(num_values, stride_));
+  }
+
+  virtual int Decode(T* buffer, int max_values) {
+    max_values = std::min(max_values, num_values_);
+    internal::ByteStreamSplitDecode<kNumStreams>(data_ + current_value_, stride_,
+                                                 max_values,
+                                                 reinterpret_cast<uint8_t*>(buffer));
+    current_value_ += max_values;
+    num_values_ -= max_values;
+    return max_values;
+  }
+
+ private:
+  using Decoder<DType>::num_values_;
+
+  static constexpr int kNumStreams = static_cast<int>(sizeof(T));
+
+  const uint8_t* data_;
+  int64_t stride_;
+  int64_t current_value_;
 };
 
 }  // namespace parquet
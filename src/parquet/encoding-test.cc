@@ -19,6 +19,7 @@
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
+#include <limits>
 #include <string>
 #include <vector>
 
@@ -69,6 +70,67 @@ TEST(VectorBooleanTest, TestEncodeDecode) {
   }
 }
 
+TEST(VectorBooleanTest, TestDecodeBitmap) {
+  int nvalues = 10000;
+  vector<bool> draws = flip_coins_seed(nvalues, 0.5, 0);
+
+  PlainEncoder<BooleanType> encoder(nullptr);
+  encoder.Put(draws, nvalues);
+  std::shared_ptr<Buffer> encode_buffer = encoder.FlushValues();
+
+  // Decode in unaligned batches to an unaligned offset of the bitmap
+  const int64_t kOffset = 5;
+  vector<uint8_t> bits(BitUtil::Ceil(nvalues + kOffset, 8), 0xFF);
+  PlainDecoder<BooleanType> decoder(nullptr);
+  decoder.SetData(nvalues, encode_buffer->data(),
+                  static_cast<int>(encode_buffer->size()));
+  int values_decoded = 0;
+  while (values_decoded < nvalues) {
+    values_decoded += decoder.DecodeBitmap(bits.data(), kOffset + values_decoded, 37);
+  }
+  ASSERT_EQ(nvalues, values_decoded);
+  ASSERT_EQ(0, decoder.values_left());
+  for (int i = 0; i < kOffset; ++i) {
+    ASSERT_TRUE(BitUtil::GetBit(bits.data(), i));
+  }
+  for (int i = 0; i < nvalues; ++i) {
+    ASSERT_EQ(draws[i], BitUtil::GetBit(bits.data(), kOffset + i)) << i;
+  }
+}
+
+TEST(VectorBooleanTest, TestDecodeBitmapSpaced) {
+  int nslots = 10000;
+  vector<bool> valid = flip_coins_seed(nslots, 0.7, 1);
+  vector<uint8_t> valid_bits(BitUtil::Ceil(nslots, 8), 0);
+  vector<bool> draws;
+  for (int i = 0; i < nslots; ++i) {
+    if (valid[i]) {
+      BitUtil::SetBit(valid_bits.data(), i);
+      draws.push_back(i % 3 == 0);
+    }
+  }
+  int nvalues = static_cast<int>(draws.size());
+
+  PlainEncoder<BooleanType> encoder(nullptr);
+  encoder.Put(draws, nvalues);
+  std::shared_ptr<Buffer> encode_buffer = encoder.FlushValues();
+
+  const int64_t kOffset = 3;
+  vector<uint8_t> bits(BitUtil::Ceil(nslots + kOffset, 8), 0xFF);
+  PlainDecoder<BooleanType> decoder(nullptr);
+  decoder.SetData(nvalues, encode_buffer->data(),
+                  static_cast<int>(encode_buffer->size()));
+  ASSERT_EQ(nslots, decoder.DecodeBitmapSpaced(bits.data(), kOffset, nslots,
+                                               nslots - nvalues, valid_bits.data(), 0));
+  ASSERT_EQ(0, decoder.values_left());
+
+  int value = 0;
+  for (int i = 0; i < nslots; ++i) {
+    bool expected = valid[i] ? static_cast<bool>(draws[value++]) : false;
+    ASSERT_EQ(expected, BitUtil::GetBit(bits.data(), kOffset + i)) << i;
+  }
+}
+
 // ----------------------------------------------------------------------
 // test data generation
 
@@ -304,6 +366,456 @@ TEST(TestDictionaryEncoding, CannotDictDecodeBoolean) {
   ASSERT_THROW(decoder.SetDict(&dict_decoder), ParquetException);
 }
 
+TEST(TestDictionaryEncoding, RepeatedValuesAcrossTableGrowth) {
+  // Enough distinct values for the hash table to double several times
+  const int num_distinct = 5000;
+  std::vector<int64_t> values(4 * num_distinct);
+  for (size_t i = 0; i < values.size(); ++i) {
+    values[i] = static_cast<int64_t>((i * 7919) % num_distinct) << 32;
+  }
+  auto descr = ExampleDescr<Int64Type>();
+
+  DictEncoder<Int64Type> encoder(descr.get());
+  encoder.Put(values.data(), static_cast<int>(values.size()));
+  ASSERT_EQ(num_distinct, encoder.num_entries());
+
+  // Inserting the values one by one gives the same dictionary and indices
+  DictEncoder<Int64Type> single_encoder(descr.get());
+  for (int64_t value : values) {
+    single_encoder.Put(value);
+  }
+  ASSERT_EQ(encoder.uniques(), single_encoder.uniques());
+  ASSERT_TRUE(encoder.FlushValues()->Equals(*single_encoder.FlushValues()));
+}
+
+template <typename T>
+void CheckGatherDictionary() {
+  std::vector<T> dictionary = {T(1), T(-2), T(3), T(-4), T(5)};
+  // Odd length to cover both the vectorized and the remainder loops
+  std::vector<int32_t> indices(1027);
+  for (size_t i = 0; i < indices.size(); ++i) {
+    indices[i] = static_cast<int32_t>((i * 7) % dictionary.size());
+  }
+  std::vector<T> out(indices.size());
+  GatherDictionary(dictionary.data(), indices.data(), static_cast<int>(indices.size()),
+                   out.data());
+  for (size_t i = 0; i < indices.size(); ++i) {
+    ASSERT_EQ(dictionary[indices[i]], out[i]) << i;
+  }
+}
+
+TEST(TestDictionaryEncoding, GatherDictionary) {
+  CheckGatherDictionary<int32_t>();
+  CheckGatherDictionary<int64_t>();
+  CheckGatherDictionary<float>();
+  CheckGatherDictionary<double>();
+}
+
+TEST(TestPlainEncoding, PutFromBuffer) {
+  std::vector<int32_t> values(100);
+  for (int i = 0; i < 100; ++i) values[i] = i * 3;
+  auto owner = std::make_shared<Buffer>(reinterpret_cast<const uint8_t*>(values.data()),
+                                        values.size() * sizeof(int32_t));
+  const int64_t value_size = sizeof(int32_t);
+  PlainEncoder<Int32Type> encoder(nullptr);
+
+  // Contiguous values are flushed as a slice of their owner
+  encoder.PutFromBuffer(values.data() + 10, 20, owner);
+  encoder.PutFromBuffer(values.data() + 30, 20, owner);
+  ASSERT_EQ(40 * value_size, encoder.EstimatedDataEncodedSize());
+  std::shared_ptr<Buffer> slice = encoder.FlushValues();
+  ASSERT_EQ(owner->data() + 10 * value_size, slice->data());
+  ASSERT_EQ(40 * value_size, slice->size());
+
+  // Otherwise the values are copied
+  encoder.PutFromBuffer(values.data(), 10, owner);
+  encoder.PutFromBuffer(values.data() + 50, 10, owner);
+  encoder.Put(values.data() + 90, 10);
+  std::shared_ptr<Buffer> copy = encoder.FlushValues();
+  ASSERT_EQ(30 * value_size, copy->size());
+  const int32_t* out = reinterpret_cast<const int32_t*>(copy->data());
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_EQ(values[i], out[i]);
+    ASSERT_EQ(values[50 + i], out[10 + i]);
+    ASSERT_EQ(values[90 + i], out[20 + i]);
+  }
+}
+
+// ----------------------------------------------------------------------
+// DELTA_BINARY_PACKED decoding
+
+TEST(TestDeltaBitPackDecoder, ConstantDelta) {
+  // Block size 128 with 4 miniblocks, 5 values starting at 1, a minimum delta
+  // of 1 and miniblocks of bit width 0
+  std::vector<uint8_t> data = {0x80, 0x01, 0x04, 0x05, 0x02, 0x02, 0, 0, 0, 0};
+  DeltaBitPackDecoder<Int32Type> decoder(nullptr);
+  decoder.SetData(5, data.data(), static_cast<int>(data.size()));
+  std::vector<int32_t> values(5);
+  ASSERT_EQ(5, decoder.Decode(values.data(), 5));
+  ASSERT_EQ(std::vector<int32_t>({1, 2, 3, 4, 5}), values);
+  ASSERT_EQ(0, decoder.values_left());
+}
+
+TEST(TestDeltaBitPackDecoder, BitPackedDeltas) {
+  // 7, 5, 3, 1, 2, 3, 4, 5: a minimum delta of -2, then the deltas
+  // 0, 0, 0, 3, 3, 3, 3 packed in bit width 2
+  std::vector<uint8_t> data = {0x80, 0x01, 0x04, 0x08, 0x0E, 0x03, 2, 0, 0, 0,
+                               0xC0, 0x3F, 0,    0,    0,    0,    0, 0};
+  std::vector<int64_t> expected = {7, 5, 3, 1, 2, 3, 4, 5};
+  DeltaBitPackDecoder<Int64Type> decoder(nullptr);
+  decoder.SetData(8, data.data(), static_cast<int>(data.size()));
+  // Decode in batches that end within the miniblock
+  std::vector<int64_t> values(8);
+  ASSERT_EQ(3, decoder.Decode(values.data(), 3));
+  ASSERT_EQ(5, decoder.Decode(values.data() + 3, 10));
+  ASSERT_EQ(expected, values);
+}
+
+TEST(TestDeltaBitPackDecoder, InvalidBlockHeader) {
+  DeltaBitPackDecoder<Int32Type> decoder(nullptr);
+  // A block size of 2^28 values
+  std::vector<uint8_t> huge_block = {0x80, 0x80, 0x80, 0x80, 0x01, 0x01, 0x05, 0x02};
+  ASSERT_THROW(decoder.SetData(5, huge_block.data(), static_cast<int>(huge_block.size())),
+               ParquetException);
+  // 64 miniblocks of 32 values, more than the bytes of the page
+  std::vector<uint8_t> many_mini_blocks = {0x80, 0x10, 0x40, 0x05, 0x02, 0x02};
+  ASSERT_THROW(decoder.SetData(5, many_mini_blocks.data(),
+                               static_cast<int>(many_mini_blocks.size())),
+               ParquetException);
+}
+
+TEST(TestDeltaBitPackDecoder, UnpackAllBitWidths) {
+  uint8_t packed[4 * 64 + 16] = {0};
+  uint64_t expected[32];
+  uint64_t values[32];
+  for (int bit_width = 0; bit_width <= 64; ++bit_width) {
+    memset(packed, 0, sizeof(packed));
+    for (int i = 0; i < 32; ++i) {
+      uint64_t mask = bit_width == 64 ? ~0ULL : (1ULL << bit_width) - 1;
+      expected[i] = (0x9E3779B97F4A7C15ULL * (i + 1)) & mask;
+      for (int b = 0; b < bit_width; ++b) {
+        if ((expected[i] >> b) & 1) {
+          BitUtil::SetBit(packed, i * bit_width + b);
+        }
+      }
+    }
+    internal::Unpack32(bit_width, packed, values);
+    for (int i = 0; i < 32; ++i) {
+      ASSERT_EQ(expected[i], values[i]) << "bit width " << bit_width << ", value " << i;
+    }
+  }
+}
+
+TEST(TestDeltaBitPackEncoder, PackAllBitWidths) {
+  uint64_t values[32];
+  uint64_t unpacked[32];
+  uint8_t packed[4 * 64 + 16];
+  for (int bit_width = 0; bit_width <= 64; ++bit_width) {
+    uint64_t mask = bit_width == 64 ? ~0ULL : (1ULL << bit_width) - 1;
+    for (int i = 0; i < 32; ++i) {
+      values[i] = (0x9E3779B97F4A7C15ULL * (i + 1)) & mask;
+    }
+    memset(packed, 0, sizeof(packed));
+    internal::Pack32(bit_width, values, packed);
+    internal::Unpack32(bit_width, packed, unpacked);
+    for (int i = 0; i < 32; ++i) {
+      ASSERT_EQ(values[i], unpacked[i]) << "bit width " << bit_width << ", value " << i;
+    }
+  }
+}
+
+template <typename DType>
+static void CheckDeltaBitPackRoundTrip(const std::vector<typename DType::c_type>& values,
+                                       int batch_size) {
+  typedef typename DType::c_type T;
+  DeltaBitPackEncoder<DType> encoder(nullptr);
+  for (size_t i = 0; i < values.size(); i += batch_size) {
+    int n = std::min(batch_size, static_cast<int>(values.size() - i));
+    encoder.Put(values.data() + i, n);
+  }
+  std::shared_ptr<Buffer> buffer = encoder.FlushValues();
+
+  DeltaBitPackDecoder<DType> decoder(nullptr);
+  int num_values = static_cast<int>(values.size());
+  decoder.SetData(num_values, buffer->data(), static_cast<int>(buffer->size()));
+  std::vector<T> decoded(values.size());
+  ASSERT_EQ(num_values, decoder.Decode(decoded.data(), num_values));
+  ASSERT_EQ(values, decoded);
+  // All the miniblocks were consumed
+  ASSERT_EQ(buffer->data() + buffer->size(), decoder.position());
+}
+
+TEST(TestDeltaBitPackEncoder, Int32RoundTrip) {
+  std::vector<int32_t> values;
+  CheckDeltaBitPackRoundTrip<Int32Type>(values, 1);
+  values = {42};
+  CheckDeltaBitPackRoundTrip<Int32Type>(values, 1);
+
+  // Increasing ids span several blocks and end within a miniblock
+  values.clear();
+  for (int i = 0; i < 1000; ++i) values.push_back(1000000 + 3 * i);
+  CheckDeltaBitPackRoundTrip<Int32Type>(values, 1000);
+  CheckDeltaBitPackRoundTrip<Int32Type>(values, 7);
+
+  // Deltas between the extremes do not fit 32 bits
+  values.resize(1000);
+  random_numbers(1000, 0, std::numeric_limits<int32_t>::min(),
+                 std::numeric_limits<int32_t>::max(), values.data());
+  values[0] = std::numeric_limits<int32_t>::max();
+  values[1] = std::numeric_limits<int32_t>::min();
+  CheckDeltaBitPackRoundTrip<Int32Type>(values, 100);
+}
+
+TEST(TestDeltaBitPackEncoder, Int32ExtremesFit32BitMiniBlocks) {
+  // The deltas alternate between the widest positive and negative ones
+  std::vector<int32_t> values;
+  for (int i = 0; i <= 128; ++i) {
+    values.push_back(i % 2 == 0 ? std::numeric_limits<int32_t>::min()
+                                : std::numeric_limits<int32_t>::max());
+  }
+  CheckDeltaBitPackRoundTrip<Int32Type>(values, 129);
+
+  DeltaBitPackEncoder<Int32Type> encoder(nullptr);
+  encoder.Put(values.data(), static_cast<int>(values.size()));
+  std::shared_ptr<Buffer> buffer = encoder.FlushValues();
+
+  // Skip the block size, the number of miniblocks, the number of values, the
+  // first value and the minimum delta of the block to reach its bit widths
+  const uint8_t* data = buffer->data();
+  for (int i = 0; i < 5; ++i) {
+    while (*data & 0x80) ++data;
+    ++data;
+  }
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_LE(data[i], 32) << "miniblock " << i;
+  }
+}
+
+TEST(TestDeltaBitPackEncoder, Int64RoundTrip) {
+  std::vector<int64_t> values;
+  for (int i = 0; i < 2000; ++i) values.push_back(1500000000000LL + i * i);
+  CheckDeltaBitPackRoundTrip<Int64Type>(values, 128);
+
+  // Wrapping deltas
+  values.resize(515);
+  random_numbers(515, 1, std::numeric_limits<int64_t>::min(),
+                 std::numeric_limits<int64_t>::max(), values.data());
+  values[10] = std::numeric_limits<int64_t>::min();
+  values[11] = std::numeric_limits<int64_t>::max();
+  values[12] = std::numeric_limits<int64_t>::min();
+  CheckDeltaBitPackRoundTrip<Int64Type>(values, 33);
+}
+
+TEST(TestDeltaBitPackEncoder, MultiplePages) {
+  DeltaBitPackEncoder<Int64Type> encoder(nullptr);
+  std::vector<int64_t> first = {5, 4, 3};
+  std::vector<int64_t> second = {-1, 100, 1000, 10000};
+  encoder.Put(first.data(), 3);
+  std::shared_ptr<Buffer> first_page = encoder.FlushValues();
+  encoder.Put(second.data(), 4);
+  std::shared_ptr<Buffer> second_page = encoder.FlushValues();
+
+  DeltaBitPackDecoder<Int64Type> decoder(nullptr);
+  std::vector<int64_t> decoded(4);
+  decoder.SetData(3, first_page->data(), static_cast<int>(first_page->size()));
+  ASSERT_EQ(3, decoder.Decode(decoded.data(), 4));
+  ASSERT_EQ(first, std::vector<int64_t>(decoded.begin(), decoded.begin() + 3));
+  decoder.SetData(4, second_page->data(), static_cast<int>(second_page->size()));
+  ASSERT_EQ(4, decoder.Decode(decoded.data(), 4));
+  ASSERT_EQ(second, decoded);
+}
+
+// ----------------------------------------------------------------------
+// DELTA_LENGTH_BYTE_ARRAY and DELTA_BYTE_ARRAY decoding
+
+static std::vector<std::string> DecodeStrings(Decoder<ByteArrayType>* decoder,
+                                              const std::vector<uint8_t>& data,
+                                              int num_values) {
+  decoder->SetData(num_values, data.data(), static_cast<int>(data.size()));
+  std::vector<ByteArray> values(num_values);
+  EXPECT_EQ(num_values, decoder->Decode(values.data(), num_values));
+  std::vector<std::string> out;
+  for (const ByteArray& value : values) {
+    out.emplace_back(reinterpret_cast<const char*>(value.ptr), value.len);
+  }
+  return out;
+}
+
+static void AppendString(const std::string& value, std::vector<uint8_t>* data) {
+  data->insert(data->end(), value.begin(), value.end());
+}
+
+// The lengths 5, 5, 6, 6: the first value 5, a minimum delta of 0 and the
+// deltas 0, 1, 0 in bit width 1
+static const std::vector<uint8_t> kLengths = {0x80, 0x01, 0x04, 0x04, 0x0A, 0x00, 1,
+                                              0,    0,    0,    0x02, 0,    0,    0};
+
+TEST(TestDeltaByteArrayDecoding, DeltaLength) {
+  std::vector<uint8_t> data = kLengths;
+  AppendString("HelloWorldFoobarABCDEF", &data);
+  DeltaLengthByteArrayDecoder decoder(nullptr);
+  ASSERT_EQ(std::vector<std::string>({"Hello", "World", "Foobar", "ABCDEF"}),
+            DecodeStrings(&decoder, data, 4));
+}
+
+TEST(TestDeltaByteArrayDecoding, SharedPrefixes) {
+  // Prefix lengths 0, 2, 0, 3
+  std::vector<uint8_t> data = {0x80, 0x01, 0x04, 0x04, 0x00, 0x03,
+                               3,    0,    0,    0,    0x44, 0x01};
+  data.resize(data.size() + 10, 0);
+  // Suffix lengths 4, 2, 6, 5
+  std::vector<uint8_t> suffix_lengths = {0x80, 0x01, 0x04, 0x04, 0x08, 0x03,
+                                         3,    0,    0,    0,    0x70};
+  data.insert(data.end(), suffix_lengths.begin(), suffix_lengths.end());
+  data.resize(data.size() + 11, 0);
+  AppendString("axislebabbleyhood", &data);
+
+  DeltaByteArrayDecoder decoder(nullptr);
+  ASSERT_EQ(std::vector<std::string>({"axis", "axle", "babble", "babyhood"}),
+            DecodeStrings(&decoder, data, 4));
+}
+
+TEST(TestDeltaByteArrayDecoding, NoPrefixes) {
+  std::vector<uint8_t> data = {0x80, 0x01, 0x04, 0x04, 0x00, 0x00, 0, 0, 0, 0};
+  data.insert(data.end(), kLengths.begin(), kLengths.end());
+  AppendString("HelloWorldFoobarABCDEF", &data);
+  DeltaByteArrayDecoder decoder(nullptr);
+  ASSERT_EQ(std::vector<std::string>({"Hello", "World", "Foobar", "ABCDEF"}),
+            DecodeStrings(&decoder, data, 4));
+}
+
+template <typename EncoderType, typename DecoderType>
+static void CheckByteArrayRoundTrip(const std::vector<std::string>& values,
+                                    int batch_size) {
+  std::vector<ByteArray> byte_arrays;
+  for (const std::string& value : values) {
+    byte_arrays.emplace_back(static_cast<uint32_t>(value.size()),
+                             reinterpret_cast<const uint8_t*>(value.data()));
+  }
+  EncoderType encoder(nullptr);
+  for (size_t i = 0; i < values.size(); i += batch_size) {
+    int n = std::min(batch_size, static_cast<int>(values.size() - i));
+    encoder.Put(byte_arrays.data() + i, n);
+  }
+  std::shared_ptr<Buffer> buffer = encoder.FlushValues();
+  std::vector<uint8_t> data(buffer->data(), buffer->data() + buffer->size());
+
+  DecoderType decoder(nullptr);
+  ASSERT_EQ(values, DecodeStrings(&decoder, data, static_cast<int>(values.size())));
+}
+
+static std::vector<std::string> MakeUrls(int num_values) {
+  std::vector<std::string> values;
+  for (int i = 0; i < num_values; ++i) {
+    std::string value = "https://example.com/path/" + std::to_string(i / 10) + "/item";
+    if (i % 7 == 0) value = "";
+    if (i % 5 == 0) value += std::to_string(i);
+    values.push_back(value);
+  }
+  return values;
+}
+
+TEST(TestDeltaByteArrayEncoding, DeltaLengthRoundTrip) {
+  std::vector<std::string> values = MakeUrls(1000);
+  CheckByteArrayRoundTrip<DeltaLengthByteArrayEncoder, DeltaLengthByteArrayDecoder>(
+      values, 1000);
+  CheckByteArrayRoundTrip<DeltaLengthByteArrayEncoder, DeltaLengthByteArrayDecoder>(
+      values, 3);
+}
+
+TEST(TestDeltaByteArrayEncoding, DeltaByteArrayRoundTrip) {
+  std::vector<std::string> values = MakeUrls(1000);
+  CheckByteArrayRoundTrip<DeltaByteArrayEncoder, DeltaByteArrayDecoder>(values, 1000);
+  // The prefix of the first value of a batch is found in the previous batch
+  CheckByteArrayRoundTrip<DeltaByteArrayEncoder, DeltaByteArrayDecoder>(values, 3);
+
+  values = {"axis", "axle", "babble", "babyhood"};
+  CheckByteArrayRoundTrip<DeltaByteArrayEncoder, DeltaByteArrayDecoder>(values, 4);
+}
+
+TEST(TestDeltaByteArrayEncoding, SharedPrefixesShrinkPages) {
+  std::vector<std::string> values = MakeUrls(1000);
+  std::vector<ByteArray> byte_arrays;
+  for (const std::string& value : values) {
+    byte_arrays.emplace_back(static_cast<uint32_t>(value.size()),
+                             reinterpret_cast<const uint8_t*>(value.data()));
+  }
+  DeltaLengthByteArrayEncoder length_encoder(nullptr);
+  length_encoder.Put(byte_arrays.data(), 1000);
+  DeltaByteArrayEncoder prefix_encoder(nullptr);
+  prefix_encoder.Put(byte_arrays.data(), 1000);
+  ASSERT_LT(2 * prefix_encoder.FlushValues()->size(),
+            length_encoder.FlushValues()->size());
+}
+
+TEST(TestDeltaByteArrayEncoding, PagesDoNotSharePrefixes) {
+  const std::string hello = "Hello";
+  const std::string help = "Help";
+  std::vector<ByteArray> values = {
+      ByteArray(5, reinterpret_cast<const uint8_t*>(hello.data())),
+      ByteArray(4, reinterpret_cast<const uint8_t*>(help.data()))};
+  DeltaByteArrayEncoder encoder(nullptr);
+  encoder.Put(values.data(), 1);
+  std::shared_ptr<Buffer> first_page = encoder.FlushValues();
+  encoder.Put(values.data() + 1, 1);
+  std::shared_ptr<Buffer> second_page = encoder.FlushValues();
+
+  DeltaByteArrayDecoder decoder(nullptr);
+  std::vector<uint8_t> data(second_page->data(),
+                            second_page->data() + second_page->size());
+  ASSERT_EQ(std::vector<std::string>({"Help"}), DecodeStrings(&decoder, data, 1));
+}
+
+// ----------------------------------------------------------------------
+// BYTE_STREAM_SPLIT encoding
+
+template <typename Type>
+class TestByteStreamSplitEncoding : public ::testing::Test {
+ public:
+  typedef typename Type::c_type T;
+
+  void CheckRoundTrip(int num_values, int batch_size) {
+    std::vector<T> values(num_values);
+    random_numbers(num_values, 0, static_cast<T>(-1000), static_cast<T>(1000),
+                   values.data());
+
+    ByteStreamSplitEncoder<Type> encoder(nullptr);
+    encoder.Put(values.data(), num_values);
+    std::shared_ptr<Buffer> buffer = encoder.FlushValues();
+    ASSERT_EQ(static_cast<int64_t>(num_values * sizeof(T)), buffer->size());
+
+    // Byte k of value i is in stream k
+    for (int i = 0; i < num_values; ++i) {
+      const uint8_t* value = reinterpret_cast<const uint8_t*>(&values[i]);
+      for (size_t k = 0; k < sizeof(T); ++k) {
+        ASSERT_EQ(value[k], buffer->data()[k * num_values + i]);
+      }
+    }
+
+    ByteStreamSplitDecoder<Type> decoder(nullptr);
+    decoder.SetData(num_values, buffer->data(), static_cast<int>(buffer->size()));
+    std::vector<T> decoded(num_values);
+    for (int i = 0; i < num_values; i += batch_size) {
+      int n = std::min(batch_size, num_values - i);
+      ASSERT_EQ(n, decoder.Decode(decoded.data() + i, n));
+    }
+    ASSERT_EQ(0, decoder.values_left());
+    ASSERT_EQ(values, decoded);
+  }
+};
+
+typedef ::testing::Types<FloatType, DoubleType> ByteStreamSplitTypes;
+
+TYPED_TEST_CASE(TestByteStreamSplitEncoding, ByteStreamSplitTypes);
+
+TYPED_TEST(TestByteStreamSplitEncoding, RoundTrip) {
+  this->CheckRoundTrip(0, 1);
+  this->CheckRoundTrip(1, 1);
+  // Batches that are not multiples of the 16 values gathered at once
+  this->CheckRoundTrip(1000, 1000);
+  this->CheckRoundTrip(1000, 37);
+}
+
 }  // namespace test
 
 }  // namespace parquet
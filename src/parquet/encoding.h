@@ -70,6 +70,14 @@ class Encoder {
     Put(data, num_valid_values);
   }
 
+  // Same as Put, where the values are owned by the given buffer and stay
+  // unchanged as long as it is alive. Encoders may keep a reference to the
+  // buffer instead of copying the values.
+  virtual void PutFromBuffer(const T* src, int num_values,
+                             const std::shared_ptr<Buffer>& owner) {
+    Put(src, num_values);
+  }
+
   Encoding::type encoding() const { return encoding_; }
 
  protected:
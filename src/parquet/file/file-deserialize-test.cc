@@ -177,6 +177,70 @@ TEST_F(TestPageSerde, TestFailLargePageHeaders) {
   ASSERT_THROW(page_reader_->NextPage(), ParquetException);
 }
 
+TEST_F(TestPageSerde, ManyPageHeaders) {
+  // The headers of a page reader share their Thrift transport and protocol.
+  // Headers of different sizes follow each other, one not fitting in the
+  // first read and parsed again from a larger one.
+  std::vector<int> stats_sizes = {0, 512, 0, 32 * 1024, 16, 0, 1024};
+  std::vector<format::DataPageHeader> headers;
+  int32_t num_rows = 0;
+  for (size_t i = 0; i < stats_sizes.size(); ++i) {
+    data_page_header_ = format::DataPageHeader();
+    data_page_header_.encoding = format::Encoding::PLAIN;
+    data_page_header_.definition_level_encoding = format::Encoding::RLE;
+    data_page_header_.repetition_level_encoding = format::Encoding::RLE;
+    data_page_header_.num_values = static_cast<int32_t>(100 + i);
+    if (stats_sizes[i] > 0) {
+      AddDummyStats(stats_sizes[i], data_page_header_);
+    }
+    WriteDataPageHeader(64 * 1024);
+    headers.push_back(data_page_header_);
+    num_rows += data_page_header_.num_values;
+  }
+
+  InitSerializedPageReader(num_rows);
+  for (const format::DataPageHeader& header : headers) {
+    std::shared_ptr<Page> current_page = page_reader_->NextPage();
+    ASSERT_NE(nullptr, current_page);
+    CheckDataPageHeader(header, current_page.get());
+    const DataPage* data_page = static_cast<const DataPage*>(current_page.get());
+    ASSERT_EQ(header.statistics.__isset.max, data_page->statistics().has_max);
+  }
+  ASSERT_EQ(nullptr, page_reader_->NextPage());
+}
+
+TEST(TestThriftDeserializer, ReusedAfterTruncatedMessage) {
+  format::DataPageHeader header;
+  header.num_values = 1234;
+  header.encoding = format::Encoding::PLAIN;
+  header.definition_level_encoding = format::Encoding::RLE;
+  header.repetition_level_encoding = format::Encoding::RLE;
+  AddDummyStats(100, header);
+  InMemoryOutputStream stream;
+  SerializeThriftMsg(&header, 1024, &stream);
+  std::shared_ptr<Buffer> buffer = stream.GetBuffer();
+
+  ThriftDeserializer deserializer;
+  for (int i = 0; i < 3; ++i) {
+    // The message is cut off within the statistics
+    format::DataPageHeader truncated;
+    uint32_t len = static_cast<uint32_t>(buffer->size() / 2);
+    ASSERT_FALSE(deserializer.TryDeserialize(buffer->data(), &len, &truncated));
+
+    format::DataPageHeader out;
+    len = static_cast<uint32_t>(buffer->size());
+    ASSERT_TRUE(deserializer.TryDeserialize(buffer->data(), &len, &out));
+    ASSERT_EQ(buffer->size(), len);
+    ASSERT_EQ(header.num_values, out.num_values);
+    ASSERT_EQ(header.statistics.max, out.statistics.max);
+  }
+
+  uint32_t len = static_cast<uint32_t>(buffer->size() / 2);
+  format::DataPageHeader truncated;
+  ASSERT_THROW(deserializer.Deserialize(buffer->data(), &len, &truncated),
+               ParquetException);
+}
+
 TEST_F(TestPageSerde, Compression) {
   Compression::type codec_types[3] = {Compression::GZIP, Compression::SNAPPY,
                                       Compression::BROTLI};
@@ -228,6 +292,185 @@ TEST_F(TestPageSerde, Compression) {
   }
 }
 
+TEST_F(TestPageSerde, DataPageFilter) {
+  const int32_t num_rows = 32;  // dummy value
+  data_page_header_.num_values = num_rows;
+  data_page_header_.__isset.statistics = true;
+
+  int num_pages = 4;
+  int data_size = 64;
+  for (int i = 0; i < num_pages; ++i) {
+    data_page_header_.statistics.__set_min(std::to_string(i));
+    WriteDataPageHeader(1024, data_size, data_size);
+    std::vector<uint8_t> data(data_size, static_cast<uint8_t>(i));
+    out_stream_->Write(data.data(), data_size);
+  }
+  InitSerializedPageReader(num_rows * num_pages);
+
+  page_reader_->set_data_page_filter([](const EncodedStatistics& stats) {
+    return stats.min() == "1" || stats.min() == "3";
+  });
+  for (int expected : {1, 3}) {
+    std::shared_ptr<Page> page = page_reader_->NextPage();
+    ASSERT_NE(nullptr, page);
+    ASSERT_EQ(std::to_string(expected),
+              static_cast<const DataPage*>(page.get())->statistics().min());
+    ASSERT_EQ(data_size, page->size());
+    ASSERT_EQ(expected, page->data()[0]);
+  }
+  ASSERT_EQ(nullptr, page_reader_->NextPage());
+}
+
+TEST_F(TestPageSerde, SkipDataPages) {
+  const int32_t num_rows = 32;  // dummy value
+  data_page_header_.num_values = num_rows;
+
+  int num_pages = 4;
+  int data_size = 64;
+  for (int i = 0; i < num_pages; ++i) {
+    WriteDataPageHeader(1024, data_size, data_size);
+    std::vector<uint8_t> data(data_size, static_cast<uint8_t>(i));
+    out_stream_->Write(data.data(), data_size);
+  }
+  InitSerializedPageReader(num_rows * num_pages);
+
+  // Only whole pages are skipped
+  ASSERT_EQ(2 * num_rows, page_reader_->SkipDataPages(3 * num_rows - 1));
+  ASSERT_EQ(0, page_reader_->SkipDataPages(num_rows - 1));
+
+  // The header parsed while skipping is used for the next page
+  std::shared_ptr<Page> page = page_reader_->NextPage();
+  ASSERT_NE(nullptr, page);
+  ASSERT_EQ(data_size, page->size());
+  ASSERT_EQ(2, page->data()[0]);
+
+  ASSERT_EQ(num_rows, page_reader_->SkipDataPages(10 * num_rows));
+  ASSERT_EQ(nullptr, page_reader_->NextPage());
+}
+
+TEST_F(TestPageSerde, DataPageV2) {
+  // The levels stay uncompressed, only the values are decompressed
+  std::vector<uint8_t> levels(16, 7);
+  std::vector<uint8_t> values;
+  test::random_bytes(256, 0, &values);
+  std::unique_ptr<::arrow::Codec> codec = GetCodecFromArrow(Compression::SNAPPY);
+  std::vector<uint8_t> compressed(codec->MaxCompressedLen(values.size(), values.data()));
+  int64_t compressed_size;
+  ASSERT_OK(codec->Compress(values.size(), values.data(), compressed.size(),
+                            compressed.data(), &compressed_size));
+
+  format::DataPageHeaderV2 v2_header;
+  v2_header.__set_num_values(32);
+  v2_header.__set_num_nulls(2);
+  v2_header.__set_num_rows(10);
+  v2_header.__set_encoding(format::Encoding::PLAIN);
+  v2_header.__set_definition_levels_byte_length(10);
+  v2_header.__set_repetition_levels_byte_length(6);
+  v2_header.__set_is_compressed(true);
+  page_header_.__set_data_page_header_v2(v2_header);
+  page_header_.type = format::PageType::DATA_PAGE_V2;
+  page_header_.uncompressed_page_size =
+      static_cast<int32_t>(levels.size() + values.size());
+  page_header_.compressed_page_size =
+      static_cast<int32_t>(levels.size() + compressed_size);
+  ASSERT_NO_THROW(SerializeThriftMsg(&page_header_, 1024, out_stream_.get()));
+  out_stream_->Write(levels.data(), levels.size());
+  out_stream_->Write(compressed.data(), compressed_size);
+
+  InitSerializedPageReader(32, Compression::SNAPPY);
+  std::shared_ptr<Page> page = page_reader_->NextPage();
+  ASSERT_EQ(PageType::DATA_PAGE_V2, page->type());
+  const DataPageV2* data_page = static_cast<const DataPageV2*>(page.get());
+  ASSERT_EQ(32, data_page->num_values());
+  ASSERT_EQ(2, data_page->num_nulls());
+  ASSERT_EQ(10, data_page->num_rows());
+  ASSERT_TRUE(data_page->is_compressed());
+  ASSERT_EQ(0, memcmp(levels.data(), page->data(), levels.size()));
+  ASSERT_EQ(0, memcmp(values.data(), page->data() + levels.size(), values.size()));
+  ASSERT_EQ(nullptr, page_reader_->NextPage());
+}
+
+TEST_F(TestPageSerde, DataPageV2InvalidLevelsLength) {
+  std::vector<uint8_t> data(16, 7);
+  for (int32_t levels_len : {-1, 17}) {
+    ResetStream();
+    format::DataPageHeaderV2 v2_header;
+    v2_header.__set_num_values(32);
+    v2_header.__set_num_nulls(0);
+    v2_header.__set_num_rows(32);
+    v2_header.__set_encoding(format::Encoding::PLAIN);
+    v2_header.__set_definition_levels_byte_length(levels_len);
+    v2_header.__set_repetition_levels_byte_length(0);
+    page_header_.__set_data_page_header_v2(v2_header);
+    page_header_.type = format::PageType::DATA_PAGE_V2;
+    page_header_.uncompressed_page_size = static_cast<int32_t>(data.size());
+    page_header_.compressed_page_size = static_cast<int32_t>(data.size());
+    ASSERT_NO_THROW(SerializeThriftMsg(&page_header_, 1024, out_stream_.get()));
+    out_stream_->Write(data.data(), data.size());
+
+    InitSerializedPageReader(32, Compression::SNAPPY);
+    ASSERT_THROW(page_reader_->NextPage(), ParquetException);
+  }
+}
+
+TEST_F(TestPageSerde, PrefetchPages) {
+  const int32_t num_rows = 32;  // dummy value
+  data_page_header_.num_values = num_rows;
+
+  int num_pages = 10;
+  std::vector<std::vector<uint8_t>> faux_data(num_pages);
+  std::unique_ptr<::arrow::Codec> codec = GetCodecFromArrow(Compression::SNAPPY);
+  std::vector<uint8_t> buffer;
+  for (int i = 0; i < num_pages; ++i) {
+    int data_size = (i + 1) * 64;
+    test::random_bytes(data_size, i, &faux_data[i]);
+    const uint8_t* data = faux_data[i].data();
+
+    int64_t max_compressed_size = codec->MaxCompressedLen(data_size, data);
+    buffer.resize(max_compressed_size);
+    int64_t actual_size;
+    ASSERT_OK(
+        codec->Compress(data_size, data, max_compressed_size, &buffer[0], &actual_size));
+
+    WriteDataPageHeader(1024, data_size, static_cast<int32_t>(actual_size));
+    out_stream_->Write(buffer.data(), actual_size);
+  }
+  EndStream();
+
+  // With a memory limit smaller than a page, only one page is read ahead at a time
+  for (int64_t max_bytes : {static_cast<int64_t>(1), DEFAULT_PAGE_PREFETCH_MEMORY_LIMIT}) {
+    std::unique_ptr<InputStream> stream(new InMemoryInputStream(out_buffer_));
+    std::unique_ptr<SerializedPageReader> page_reader(new SerializedPageReader(
+        std::move(stream), num_rows * num_pages, Compression::SNAPPY));
+    PrefetchingPageReader prefetcher(std::move(page_reader), 3, max_bytes);
+
+    // All pages must stay valid while the next ones are read ahead
+    std::vector<std::shared_ptr<Page>> pages;
+    for (int i = 0; i < num_pages; ++i) {
+      pages.push_back(prefetcher.NextPage());
+      ASSERT_NE(nullptr, pages.back());
+    }
+    ASSERT_EQ(nullptr, prefetcher.NextPage());
+
+    for (int i = 0; i < num_pages; ++i) {
+      int data_size = static_cast<int>(faux_data[i].size());
+      ASSERT_EQ(data_size, pages[i]->size());
+      ASSERT_EQ(0, memcmp(faux_data[i].data(), pages[i]->data(), data_size));
+    }
+  }
+}
+
+TEST_F(TestPageSerde, PrefetchRethrowsErrors) {
+  int stats_size = 256 * 1024;  // 256 KB
+  AddDummyStats(stats_size, data_page_header_);
+  WriteDataPageHeader(512 * 1024);
+  InitSerializedPageReader(1337);
+  page_reader_->set_max_page_header_size(128 * 1024);
+
+  PrefetchingPageReader prefetcher(std::move(page_reader_), 2, 1024);
+  ASSERT_THROW(prefetcher.NextPage(), ParquetException);
+}
+
 TEST_F(TestPageSerde, LZONotSupported) {
   // Must await PARQUET-530
   int data_size = 1024;
@@ -294,4 +537,57 @@ TEST_F(TestParquetFileReader, IncompleteMetadata) {
   AssertInvalidFileThrows(buffer);
 }
 
+// ----------------------------------------------------------------------
+// Coalesced reads
+
+TEST(TestCoalesceReadRanges, Basics) {
+  // Sorted, with a zero-length range dropped and a small hole merged
+  std::vector<ReadRange> ranges = {{110, 10}, {0, 100}, {50, 0}, {300, 20}};
+  auto coalesced = CoalesceReadRanges(ranges, 10, 1000);
+  ASSERT_EQ(2, coalesced.size());
+  ASSERT_EQ(0, coalesced[0].offset);
+  ASSERT_EQ(120, coalesced[0].length);
+  ASSERT_EQ(300, coalesced[1].offset);
+  ASSERT_EQ(20, coalesced[1].length);
+
+  // Overlapping ranges are merged
+  coalesced = CoalesceReadRanges({{0, 100}, {50, 100}}, 0, 1000);
+  ASSERT_EQ(1, coalesced.size());
+  ASSERT_EQ(150, coalesced[0].length);
+
+  // The range size limit stops the merging, but does not split large ranges
+  coalesced = CoalesceReadRanges({{0, 100}, {100, 100}, {200, 500}}, 10, 250);
+  ASSERT_EQ(2, coalesced.size());
+  ASSERT_EQ(200, coalesced[0].length);
+  ASSERT_EQ(200, coalesced[1].offset);
+  ASSERT_EQ(500, coalesced[1].length);
+
+  ASSERT_EQ(0, CoalesceReadRanges({}, 10, 100).size());
+}
+
+TEST(TestReadRangeCache, ReadSlices) {
+  std::vector<uint8_t> data(1000);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<uint8_t>(i % 256);
+  }
+  auto buffer = std::make_shared<Buffer>(data.data(), data.size());
+  ArrowInputFile source(std::make_shared<BufferReader>(buffer));
+
+  ReadRangeCache cache(&source, 50, 1000);
+  cache.Cache({{100, 100}, {220, 30}, {800, 100}});
+
+  auto slice = cache.Read({230, 20});
+  ASSERT_NE(nullptr, slice);
+  ASSERT_EQ(20, slice->size());
+  ASSERT_EQ(0, memcmp(data.data() + 230, slice->data(), 20));
+
+  slice = cache.Read({800, 100});
+  ASSERT_NE(nullptr, slice);
+  ASSERT_EQ(0, memcmp(data.data() + 800, slice->data(), 100));
+
+  // Not (entirely) cached
+  ASSERT_EQ(nullptr, cache.Read({0, 10}));
+  ASSERT_EQ(nullptr, cache.Read({850, 100}));
+}
+
 }  // namespace parquet
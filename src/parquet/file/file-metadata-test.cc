@@ -181,6 +181,79 @@ TEST(Metadata, TestV1Version) {
   ASSERT_EQ(ParquetVersion::PARQUET_1_0, f_accessor->version());
 }
 
+TEST(Metadata, TestLazyDecoding) {
+  parquet::schema::NodeVector fields;
+  parquet::SchemaDescriptor schema;
+  std::shared_ptr<WriterProperties> props = WriterProperties::Builder().build();
+
+  const int num_columns = 50;
+  for (int i = 0; i < num_columns; ++i) {
+    fields.push_back(
+        parquet::schema::Int64("col" + std::to_string(i), Repetition::REQUIRED));
+  }
+  schema.Init(parquet::schema::GroupNode::Make("schema", Repetition::REQUIRED, fields));
+
+  auto f_builder = FileMetaDataBuilder::Make(&schema, props);
+  for (int rg = 0; rg < 3; ++rg) {
+    auto rg_builder = f_builder->AppendRowGroup(100 * (rg + 1));
+    for (int i = 0; i < num_columns; ++i) {
+      auto col_builder = rg_builder->NextColumnChunk();
+      col_builder->Finish(100 * (rg + 1), 0, 0, 1000 * rg + i, 64 + i, 128 + i, false,
+                          false);
+    }
+    rg_builder->Finish(4096 * (rg + 1));
+  }
+  auto eager_built = f_builder->Finish();
+
+  InMemoryOutputStream stream;
+  eager_built->WriteTo(&stream);
+  auto buffer = stream.GetBuffer();
+
+  uint32_t eager_len = static_cast<uint32_t>(buffer->size());
+  uint32_t lazy_len = eager_len;
+  auto eager = FileMetaData::Make(buffer->data(), &eager_len);
+  auto lazy = FileMetaData::Make(buffer->data(), &lazy_len, true);
+
+  ASSERT_EQ(eager_len, lazy_len);
+  ASSERT_EQ(eager->size(), lazy->size());
+  ASSERT_EQ(eager->num_rows(), lazy->num_rows());
+  ASSERT_EQ(eager->num_columns(), lazy->num_columns());
+  ASSERT_EQ(eager->num_row_groups(), lazy->num_row_groups());
+  ASSERT_EQ(eager->version(), lazy->version());
+  ASSERT_EQ(eager->created_by(), lazy->created_by());
+  ASSERT_EQ(eager->num_schema_elements(), lazy->num_schema_elements());
+  ASSERT_TRUE(eager->schema()->Equals(*lazy->schema()));
+
+  // Access the row groups and columns out of order
+  for (int rg = 2; rg >= 0; --rg) {
+    auto eager_rg = eager->RowGroup(rg);
+    auto lazy_rg = lazy->RowGroup(rg);
+    ASSERT_EQ(eager_rg->num_columns(), lazy_rg->num_columns());
+    ASSERT_EQ(eager_rg->num_rows(), lazy_rg->num_rows());
+    ASSERT_EQ(eager_rg->total_byte_size(), lazy_rg->total_byte_size());
+    for (int i = num_columns - 1; i >= 0; i -= 7) {
+      auto eager_col = eager_rg->ColumnChunk(i);
+      auto lazy_col = lazy_rg->ColumnChunk(i);
+      ASSERT_EQ(eager_col->num_values(), lazy_col->num_values());
+      ASSERT_EQ(eager_col->data_page_offset(), lazy_col->data_page_offset());
+      ASSERT_EQ(eager_col->total_compressed_size(), lazy_col->total_compressed_size());
+      ASSERT_EQ(eager_col->total_uncompressed_size(),
+                lazy_col->total_uncompressed_size());
+      ASSERT_EQ(eager_col->path_in_schema()->ToDotString(),
+                lazy_col->path_in_schema()->ToDotString());
+      ASSERT_EQ(eager_col->encodings(), lazy_col->encodings());
+    }
+  }
+  ASSERT_THROW(lazy->RowGroup(3), ParquetException);
+  ASSERT_THROW(lazy->RowGroup(0)->ColumnChunk(num_columns), ParquetException);
+
+  // The serialized form is preserved
+  InMemoryOutputStream lazy_stream;
+  lazy->WriteTo(&lazy_stream);
+  auto lazy_buffer = lazy_stream.GetBuffer();
+  ASSERT_TRUE(lazy_buffer->Equals(*buffer));
+}
+
 TEST(ApplicationVersion, Basics) {
   ApplicationVersion version("parquet-mr version 1.7.9");
   ApplicationVersion version1("parquet-mr version 1.8.0");
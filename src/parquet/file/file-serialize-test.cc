@@ -16,13 +16,21 @@
 // under the License.
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "parquet/column_reader.h"
 #include "parquet/column_writer.h"
+#include "parquet/file/predicate.h"
 #include "parquet/file/reader.h"
+#include "parquet/file/writer-internal.h"
 #include "parquet/file/writer.h"
 #include "parquet/test-specialization.h"
 #include "parquet/test-util.h"
+#include "parquet/thrift.h"
 #include "parquet/types.h"
 #include "parquet/util/memory.h"
 
@@ -47,7 +55,10 @@ class TestSerialize : public PrimitiveTypedTest<TestType> {
  protected:
   int num_columns_;
 
-  void FileSerializeTest(Compression::type codec_type) {
+  void FileSerializeTest(
+      Compression::type codec_type, bool pre_buffer = false,
+      const ReaderProperties& reader_properties = default_reader_properties(),
+      ParquetDataPageVersion::type data_page_version = ParquetDataPageVersion::V1) {
     std::shared_ptr<InMemoryOutputStream> sink(new InMemoryOutputStream());
     auto gnode = std::static_pointer_cast<GroupNode>(this->node_);
 
@@ -56,6 +67,7 @@ class TestSerialize : public PrimitiveTypedTest<TestType> {
     for (int i = 0; i < num_columns_; ++i) {
       prop_builder.compression(this->schema_.Column(i)->name(), codec_type);
     }
+    prop_builder.data_page_version(data_page_version);
     std::shared_ptr<WriterProperties> writer_properties = prop_builder.build();
 
     auto file_writer = ParquetFileWriter::Open(sink, gnode, writer_properties);
@@ -76,11 +88,19 @@ class TestSerialize : public PrimitiveTypedTest<TestType> {
     auto buffer = sink->GetBuffer();
 
     auto source = std::make_shared<::arrow::io::BufferReader>(buffer);
-    auto file_reader = ParquetFileReader::Open(source);
+    auto file_reader = ParquetFileReader::Open(source, reader_properties);
     ASSERT_EQ(num_columns_, file_reader->metadata()->num_columns());
     ASSERT_EQ(1, file_reader->metadata()->num_row_groups());
     ASSERT_EQ(100, file_reader->metadata()->num_rows());
 
+    if (pre_buffer) {
+      std::vector<int> column_indices;
+      for (int i = 0; i < num_columns_; ++i) {
+        column_indices.push_back(i);
+      }
+      file_reader->PreBuffer({0}, column_indices);
+    }
+
     auto rg_reader = file_reader->RowGroup(0);
     ASSERT_EQ(num_columns_, rg_reader->metadata()->num_columns());
     ASSERT_EQ(100, rg_reader->metadata()->num_rows());
@@ -125,6 +145,1430 @@ TYPED_TEST(TestSerialize, SmallFileBrotli) {
 
 TYPED_TEST(TestSerialize, SmallFileGzip) { this->FileSerializeTest(Compression::GZIP); }
 
+TYPED_TEST(TestSerialize, SmallFilePreBuffered) {
+  this->FileSerializeTest(Compression::SNAPPY, true);
+}
+
+TYPED_TEST(TestSerialize, SmallFooterReads) {
+  // The footer is read with a second read
+  ReaderProperties properties;
+  properties.set_footer_read_size(8);
+  this->FileSerializeTest(Compression::UNCOMPRESSED, false, properties);
+
+  // The speculative read covers the whole file
+  properties.set_footer_read_size(1024 * 1024);
+  this->FileSerializeTest(Compression::UNCOMPRESSED, false, properties);
+}
+
+TYPED_TEST(TestSerialize, SmallFileDataPageV2) {
+  this->FileSerializeTest(Compression::UNCOMPRESSED, false, default_reader_properties(),
+                          ParquetDataPageVersion::V2);
+  this->FileSerializeTest(Compression::SNAPPY, false, default_reader_properties(),
+                          ParquetDataPageVersion::V2);
+}
+
+TEST(TestSkip, SkipWholePages) {
+  const int64_t num_rows = 10000;
+  NodePtr schema = GroupNode::Make(
+      "schema", Repetition::REQUIRED,
+      {PrimitiveNode::Make("plain", Repetition::REQUIRED, Type::INT64),
+       PrimitiveNode::Make("dict", Repetition::OPTIONAL, Type::INT64)});
+
+  WriterProperties::Builder builder;
+  builder.data_pagesize(1024)
+      ->write_batch_size(100)
+      ->disable_dictionary("plain")
+      ->compression(Compression::SNAPPY);
+  std::shared_ptr<WriterProperties> writer_properties = builder.build();
+
+  std::shared_ptr<InMemoryOutputStream> sink(new InMemoryOutputStream());
+  auto file_writer = ParquetFileWriter::Open(
+      sink, std::static_pointer_cast<GroupNode>(schema), writer_properties);
+  auto row_group_writer = file_writer->AppendRowGroup(num_rows);
+  std::vector<int64_t> values(num_rows);
+  std::vector<int16_t> def_levels(num_rows, 1);
+  for (int64_t i = 0; i < num_rows; ++i) {
+    values[i] = i;
+  }
+  static_cast<Int64Writer*>(row_group_writer->NextColumn())
+      ->WriteBatch(num_rows, nullptr, nullptr, values.data());
+  for (int64_t i = 0; i < num_rows; ++i) {
+    values[i] = i % 10;
+  }
+  static_cast<Int64Writer*>(row_group_writer->NextColumn())
+      ->WriteBatch(num_rows, def_levels.data(), nullptr, values.data());
+  row_group_writer->Close();
+  file_writer->Close();
+
+  auto source = std::make_shared<::arrow::io::BufferReader>(sink->GetBuffer());
+  auto file_reader = ParquetFileReader::Open(source);
+  auto rg_reader = file_reader->RowGroup(0);
+
+  int64_t value;
+  int16_t def_level;
+  int64_t values_read;
+  for (int i = 0; i < 2; ++i) {
+    auto col_reader = std::static_pointer_cast<Int64Reader>(rg_reader->Column(i));
+    int64_t row = 0;
+    // Skips within a page, up to a page boundary and across many pages
+    for (int64_t skip : {10, 117, 1, 4000, 2500, 3000}) {
+      ASSERT_EQ(skip, col_reader->Skip(skip));
+      row += skip;
+      col_reader->ReadBatch(1, &def_level, nullptr, &value, &values_read);
+      ASSERT_EQ(1, values_read);
+      ASSERT_EQ(i == 0 ? row : row % 10, value);
+      ++row;
+    }
+    ASSERT_EQ(num_rows - row, col_reader->Skip(num_rows));
+    ASSERT_FALSE(col_reader->HasNext());
+  }
+}
+
+TEST(TestPageIndex, SeekToPages) {
+  const int64_t num_rows = 10000;
+  NodePtr schema = GroupNode::Make(
+      "schema", Repetition::REQUIRED,
+      {PrimitiveNode::Make("plain", Repetition::REQUIRED, Type::INT64),
+       PrimitiveNode::Make("dict", Repetition::REQUIRED, Type::INT64)});
+
+  std::shared_ptr<WriterProperties> writer_properties = WriterProperties::Builder()
+                                                            .data_pagesize(1024)
+                                                            ->write_batch_size(100)
+                                                            ->disable_dictionary("plain")
+                                                            ->enable_page_index()
+                                                            ->build();
+
+  std::shared_ptr<InMemoryOutputStream> sink(new InMemoryOutputStream());
+  auto file_writer = ParquetFileWriter::Open(
+      sink, std::static_pointer_cast<GroupNode>(schema), writer_properties);
+  auto row_group_writer = file_writer->AppendRowGroup(num_rows);
+  std::vector<int64_t> values(num_rows);
+  for (int64_t i = 0; i < num_rows; ++i) {
+    values[i] = i;
+  }
+  static_cast<Int64Writer*>(row_group_writer->NextColumn())
+      ->WriteBatch(num_rows, nullptr, nullptr, values.data());
+  for (int64_t i = 0; i < num_rows; ++i) {
+    values[i] = i % 10;
+  }
+  static_cast<Int64Writer*>(row_group_writer->NextColumn())
+      ->WriteBatch(num_rows, nullptr, nullptr, values.data());
+  row_group_writer->Close();
+  file_writer->Close();
+
+  auto source = std::make_shared<::arrow::io::BufferReader>(sink->GetBuffer());
+  auto file_reader = ParquetFileReader::Open(source);
+  auto rg_reader = file_reader->RowGroup(0);
+
+  std::unique_ptr<OffsetIndex> offset_index = rg_reader->GetOffsetIndex(0);
+  std::unique_ptr<ColumnIndex> column_index = rg_reader->GetColumnIndex(0);
+  ASSERT_NE(nullptr, offset_index);
+  ASSERT_NE(nullptr, column_index);
+  ASSERT_GT(offset_index->num_pages(), 1);
+  ASSERT_EQ(offset_index->num_pages(), column_index->num_pages());
+  ASSERT_EQ(0, offset_index->page_location(0).first_row_index);
+  ASSERT_EQ(rg_reader->metadata()->ColumnChunk(0)->data_page_offset(),
+            offset_index->page_location(0).offset);
+  for (int i = 1; i < offset_index->num_pages(); ++i) {
+    ASSERT_LT(offset_index->page_location(i - 1).first_row_index,
+              offset_index->page_location(i).first_row_index);
+    ASSERT_EQ(offset_index->page_location(i - 1).offset +
+                  offset_index->page_location(i - 1).compressed_page_size,
+              offset_index->page_location(i).offset);
+  }
+
+  // A value range maps to a single page here as the column is sorted
+  std::vector<int> pages = column_index->FindPages<Int64Type>(5000, 5000);
+  ASSERT_EQ(1U, pages.size());
+  ASSERT_EQ(offset_index->FindPage(5000), pages[0]);
+  ASSERT_FALSE(column_index->null_page(pages[0]));
+
+  int64_t first_row = offset_index->page_location(pages[0]).first_row_index;
+  auto col_reader = std::static_pointer_cast<Int64Reader>(
+      rg_reader->ColumnFromPage(0, *offset_index, pages[0]));
+  ASSERT_EQ(5000 - first_row, col_reader->Skip(5000 - first_row));
+  int64_t value;
+  int64_t values_read;
+  col_reader->ReadBatch(1, nullptr, nullptr, &value, &values_read);
+  ASSERT_EQ(1, values_read);
+  ASSERT_EQ(5000, value);
+
+  // Only the pages up to the end page are read
+  int64_t end_row = offset_index->page_location(pages[0] + 1).first_row_index;
+  col_reader = std::static_pointer_cast<Int64Reader>(
+      rg_reader->ColumnFromPage(0, *offset_index, pages[0], pages[0] + 1));
+  ASSERT_EQ(end_row - first_row, col_reader->Skip(num_rows));
+  ASSERT_FALSE(col_reader->HasNext());
+  ASSERT_THROW(rg_reader->ColumnFromPage(0, *offset_index, pages[0], pages[0]),
+               ParquetException);
+
+  // The dictionary page is still read for dictionary-encoded chunks
+  offset_index = rg_reader->GetOffsetIndex(1);
+  ASSERT_NE(nullptr, offset_index);
+  ASSERT_GT(offset_index->num_pages(), 1);
+  int page = offset_index->FindPage(7777);
+  first_row = offset_index->page_location(page).first_row_index;
+  col_reader = std::static_pointer_cast<Int64Reader>(
+      rg_reader->ColumnFromPage(1, *offset_index, page));
+  col_reader->Skip(7777 - first_row);
+  col_reader->ReadBatch(1, nullptr, nullptr, &value, &values_read);
+  ASSERT_EQ(1, values_read);
+  ASSERT_EQ(7, value);
+  ASSERT_EQ(-1, offset_index->FindPage(-1));
+  ASSERT_EQ(offset_index->num_pages() - 1, offset_index->FindPage(num_rows - 1));
+}
+
+TEST(TestPageIndex, ScanOffsetIndex) {
+  const int64_t num_rows = 10000;
+  NodePtr schema = GroupNode::Make(
+      "schema", Repetition::REQUIRED,
+      {PrimitiveNode::Make("plain", Repetition::REQUIRED, Type::INT64),
+       PrimitiveNode::Make("dict", Repetition::OPTIONAL, Type::INT64)});
+
+  std::shared_ptr<WriterProperties> writer_properties = WriterProperties::Builder()
+                                                            .data_pagesize(1024)
+                                                            ->write_batch_size(100)
+                                                            ->disable_dictionary("plain")
+                                                            ->enable_page_index()
+                                                            ->build();
+
+  std::shared_ptr<InMemoryOutputStream> sink(new InMemoryOutputStream());
+  auto file_writer = ParquetFileWriter::Open(
+      sink, std::static_pointer_cast<GroupNode>(schema), writer_properties);
+  auto row_group_writer = file_writer->AppendRowGroup(num_rows);
+  std::vector<int64_t> values(num_rows);
+  std::vector<int16_t> def_levels(num_rows);
+  for (int64_t i = 0; i < num_rows; ++i) {
+    values[i] = i % 10;
+    def_levels[i] = i % 3 == 0 ? 0 : 1;
+  }
+  static_cast<Int64Writer*>(row_group_writer->NextColumn())
+      ->WriteBatch(num_rows, nullptr, nullptr, values.data());
+  static_cast<Int64Writer*>(row_group_writer->NextColumn())
+      ->WriteBatch(num_rows, def_levels.data(), nullptr, values.data());
+  row_group_writer->Close();
+  file_writer->Close();
+
+  auto source = std::make_shared<::arrow::io::BufferReader>(sink->GetBuffer());
+  auto file_reader = ParquetFileReader::Open(source);
+  auto rg_reader = file_reader->RowGroup(0);
+
+  // The page headers give the same locations as the written page index
+  for (int i = 0; i < 2; ++i) {
+    std::unique_ptr<OffsetIndex> written = rg_reader->GetOffsetIndex(i);
+    std::unique_ptr<OffsetIndex> scanned = rg_reader->ScanOffsetIndex(i);
+    ASSERT_NE(nullptr, scanned);
+    ASSERT_GT(scanned->num_pages(), 1);
+    ASSERT_EQ(written->num_pages(), scanned->num_pages());
+    for (int j = 0; j < written->num_pages(); ++j) {
+      ASSERT_EQ(written->page_location(j).offset, scanned->page_location(j).offset);
+      ASSERT_EQ(written->page_location(j).compressed_page_size,
+                scanned->page_location(j).compressed_page_size);
+      ASSERT_EQ(written->page_location(j).first_row_index,
+                scanned->page_location(j).first_row_index);
+    }
+  }
+}
+
+TEST(TestPageIndex, NoColumnIndexForUnsignedSortOrders) {
+  NodePtr schema = GroupNode::Make(
+      "schema", Repetition::REQUIRED,
+      {PrimitiveNode::Make("signed", Repetition::REQUIRED, Type::INT32),
+       PrimitiveNode::Make("unsigned", Repetition::REQUIRED, Type::INT32,
+                           LogicalType::UINT_32),
+       PrimitiveNode::Make("utf8", Repetition::REQUIRED, Type::BYTE_ARRAY,
+                           LogicalType::UTF8)});
+  std::shared_ptr<InMemoryOutputStream> sink(new InMemoryOutputStream());
+  auto file_writer =
+      ParquetFileWriter::Open(sink, std::static_pointer_cast<GroupNode>(schema),
+                              WriterProperties::Builder().enable_page_index()->build());
+  auto row_group_writer = file_writer->AppendRowGroup(2);
+  std::vector<int32_t> ints = {-1, 1};
+  static_cast<Int32Writer*>(row_group_writer->NextColumn())
+      ->WriteBatch(2, nullptr, nullptr, ints.data());
+  static_cast<Int32Writer*>(row_group_writer->NextColumn())
+      ->WriteBatch(2, nullptr, nullptr, ints.data());
+  const uint8_t bytes[] = {'a', 0xe9};
+  std::vector<ByteArray> strings = {ByteArray(1, bytes), ByteArray(1, bytes + 1)};
+  static_cast<ByteArrayWriter*>(row_group_writer->NextColumn())
+      ->WriteBatch(2, nullptr, nullptr, strings.data());
+  row_group_writer->Close();
+  file_writer->Close();
+
+  auto source = std::make_shared<::arrow::io::BufferReader>(sink->GetBuffer());
+  auto file_reader = ParquetFileReader::Open(source);
+  auto rg_reader = file_reader->RowGroup(0);
+  ASSERT_NE(nullptr, rg_reader->GetColumnIndex(0));
+  for (int i = 1; i < 3; ++i) {
+    ASSERT_NE(nullptr, rg_reader->GetOffsetIndex(i));
+    ASSERT_EQ(nullptr, rg_reader->GetColumnIndex(i));
+  }
+}
+
+TEST(TestPageIndex, NotWrittenByDefault) {
+  NodePtr schema =
+      GroupNode::Make("schema", Repetition::REQUIRED,
+                      {PrimitiveNode::Make("a", Repetition::REQUIRED, Type::INT32)});
+  std::shared_ptr<InMemoryOutputStream> sink(new InMemoryOutputStream());
+  auto file_writer =
+      ParquetFileWriter::Open(sink, std::static_pointer_cast<GroupNode>(schema));
+  auto row_group_writer = file_writer->AppendRowGroup(1);
+  int32_t value = 1;
+  static_cast<Int32Writer*>(row_group_writer->NextColumn())
+      ->WriteBatch(1, nullptr, nullptr, &value);
+  row_group_writer->Close();
+  file_writer->Close();
+
+  auto source = std::make_shared<::arrow::io::BufferReader>(sink->GetBuffer());
+  auto file_reader = ParquetFileReader::Open(source);
+  auto rg_reader = file_reader->RowGroup(0);
+  ASSERT_FALSE(rg_reader->metadata()->ColumnChunk(0)->has_offset_index());
+  ASSERT_EQ(nullptr, rg_reader->GetOffsetIndex(0));
+  ASSERT_EQ(nullptr, rg_reader->GetColumnIndex(0));
+}
+
+// Writes two row groups of a plain and a dictionary-encoded column, the second
+// one either sequentially or buffered, with its columns written in reverse order
+static std::shared_ptr<Buffer> WriteTwoRowGroups(bool buffered,
+                                                 int64_t output_buffer_size = 0) {
+  const int64_t num_rows = 10000;
+  NodePtr schema = GroupNode::Make(
+      "schema", Repetition::REQUIRED,
+      {PrimitiveNode::Make("plain", Repetition::REQUIRED, Type::INT64),
+       PrimitiveNode::Make("dict", Repetition::REQUIRED, Type::INT64)});
+
+  WriterProperties::Builder builder;
+  builder.data_pagesize(1024)
+      ->write_batch_size(100)
+      ->disable_dictionary("plain")
+      ->compression(Compression::SNAPPY)
+      ->enable_page_index()
+      ->output_buffer_size(output_buffer_size);
+  std::shared_ptr<WriterProperties> writer_properties = builder.build();
+
+  std::vector<int64_t> plain_values(num_rows);
+  std::vector<int64_t> dict_values(num_rows);
+  for (int64_t i = 0; i < num_rows; ++i) {
+    plain_values[i] = i;
+    dict_values[i] = i % 10;
+  }
+
+  std::shared_ptr<InMemoryOutputStream> sink(new InMemoryOutputStream());
+  auto file_writer = ParquetFileWriter::Open(
+      sink, std::static_pointer_cast<GroupNode>(schema), writer_properties);
+  auto row_group_writer = file_writer->AppendRowGroup(num_rows);
+  static_cast<Int64Writer*>(row_group_writer->NextColumn())
+      ->WriteBatch(num_rows, nullptr, nullptr, plain_values.data());
+  static_cast<Int64Writer*>(row_group_writer->NextColumn())
+      ->WriteBatch(num_rows, nullptr, nullptr, dict_values.data());
+
+  if (buffered) {
+    row_group_writer = file_writer->AppendBufferedRowGroup(num_rows);
+    auto dict_writer = static_cast<Int64Writer*>(row_group_writer->column(1));
+    dict_writer->WriteBatch(num_rows, nullptr, nullptr, dict_values.data());
+    dict_writer->Close();
+    static_cast<Int64Writer*>(row_group_writer->column(0))
+        ->WriteBatch(num_rows, nullptr, nullptr, plain_values.data());
+  } else {
+    row_group_writer = file_writer->AppendRowGroup(num_rows);
+    static_cast<Int64Writer*>(row_group_writer->NextColumn())
+        ->WriteBatch(num_rows, nullptr, nullptr, plain_values.data());
+    static_cast<Int64Writer*>(row_group_writer->NextColumn())
+        ->WriteBatch(num_rows, nullptr, nullptr, dict_values.data());
+  }
+  row_group_writer->Close();
+  file_writer->Close();
+  return sink->GetBuffer();
+}
+
+TEST(TestBufferedRowGroup, SameLayoutAsSequentialWrites) {
+  std::shared_ptr<Buffer> sequential = WriteTwoRowGroups(false);
+  std::shared_ptr<Buffer> buffered = WriteTwoRowGroups(true);
+
+  // The chunks are laid out in schema order with the same offsets, also in
+  // the page index
+  ASSERT_TRUE(sequential->Equals(*buffered));
+
+  auto source = std::make_shared<::arrow::io::BufferReader>(buffered);
+  auto file_reader = ParquetFileReader::Open(source);
+  ASSERT_EQ(2, file_reader->metadata()->num_row_groups());
+  auto rg_reader = file_reader->RowGroup(1);
+  auto dict_chunk = rg_reader->metadata()->ColumnChunk(1);
+  ASSERT_TRUE(dict_chunk->has_dictionary_page());
+  ASSERT_LT(rg_reader->metadata()->ColumnChunk(0)->data_page_offset(),
+            dict_chunk->dictionary_page_offset());
+
+  std::unique_ptr<OffsetIndex> offset_index = rg_reader->GetOffsetIndex(1);
+  ASSERT_NE(nullptr, offset_index);
+  int page = offset_index->FindPage(7777);
+  int64_t first_row = offset_index->page_location(page).first_row_index;
+  auto col_reader = std::static_pointer_cast<Int64Reader>(
+      rg_reader->ColumnFromPage(1, *offset_index, page));
+  col_reader->Skip(7777 - first_row);
+  int64_t value;
+  int64_t values_read;
+  col_reader->ReadBatch(1, nullptr, nullptr, &value, &values_read);
+  ASSERT_EQ(1, values_read);
+  ASSERT_EQ(7, value);
+}
+
+TEST(TestOutputBuffer, SameFileAsUnbufferedWrites) {
+  std::shared_ptr<Buffer> expected = WriteTwoRowGroups(false);
+  // Smaller and larger than the pages
+  for (int64_t output_buffer_size : {100, 64 * 1024}) {
+    ASSERT_TRUE(expected->Equals(*WriteTwoRowGroups(false, output_buffer_size)));
+    ASSERT_TRUE(expected->Equals(*WriteTwoRowGroups(true, output_buffer_size)));
+  }
+}
+
+TEST(TestSummaryFile, OpensDataFilesFromSummary) {
+  std::vector<std::shared_ptr<Buffer>> files = {WriteTwoRowGroups(false),
+                                                WriteTwoRowGroups(true)};
+  std::vector<std::string> file_paths = {"part-0.parquet", "part-1.parquet"};
+
+  std::shared_ptr<FileMetaData> summary;
+  for (size_t i = 0; i < files.size(); ++i) {
+    auto source = std::make_shared<::arrow::io::BufferReader>(files[i]);
+    std::shared_ptr<FileMetaData> metadata = ParquetFileReader::Open(source)->metadata();
+    if (summary == nullptr) {
+      summary = metadata->Subset({});
+    }
+    summary->AppendRowGroups(*metadata, file_paths[i]);
+  }
+  ASSERT_EQ(4, summary->num_row_groups());
+  ASSERT_EQ(40000, summary->num_rows());
+
+  InMemoryOutputStream sink;
+  WriteMetaDataFile(*summary, &sink);
+  auto summary_source = std::make_shared<::arrow::io::BufferReader>(sink.GetBuffer());
+  auto summary_reader = ParquetFileReader::Open(summary_source);
+  std::shared_ptr<FileMetaData> read_summary = summary_reader->metadata();
+  ASSERT_EQ(4, read_summary->num_row_groups());
+  ASSERT_EQ("part-1.parquet", read_summary->RowGroup(3)->ColumnChunk(1)->file_path());
+
+  std::vector<SummaryDataFile> data_files = SplitSummaryMetaData(*read_summary);
+  ASSERT_EQ(2, static_cast<int>(data_files.size()));
+  for (size_t i = 0; i < data_files.size(); ++i) {
+    ASSERT_EQ(file_paths[i], data_files[i].file_path);
+    ASSERT_EQ(2, data_files[i].metadata->num_row_groups());
+    ASSERT_EQ(20000, data_files[i].metadata->num_rows());
+
+    // The data file is read with the metadata of the summary
+    auto source = std::make_shared<::arrow::io::BufferReader>(files[i]);
+    auto file_reader = ParquetFileReader::Open(source, default_reader_properties(),
+                                               data_files[i].metadata);
+    auto col_reader =
+        std::static_pointer_cast<Int64Reader>(file_reader->RowGroup(1)->Column(0));
+    int64_t value;
+    int64_t values_read;
+    col_reader->Skip(1234);
+    col_reader->ReadBatch(1, nullptr, nullptr, &value, &values_read);
+    ASSERT_EQ(1, values_read);
+    ASSERT_EQ(1234, value);
+  }
+}
+
+TEST(TestCompaction, CopiesRowGroupsVerbatim) {
+  std::vector<std::shared_ptr<Buffer>> files = {WriteTwoRowGroups(false),
+                                                WriteTwoRowGroups(true)};
+  std::vector<std::unique_ptr<ParquetFileReader>> readers;
+  std::vector<ParquetFileReader*> inputs;
+  for (const auto& file : files) {
+    readers.push_back(
+        ParquetFileReader::Open(std::make_shared<::arrow::io::BufferReader>(file)));
+    inputs.push_back(readers.back().get());
+  }
+
+  WriterProperties::Builder builder;
+  builder.enable_page_index();
+  std::shared_ptr<InMemoryOutputStream> sink(new InMemoryOutputStream());
+  std::shared_ptr<FileMetaData> metadata = CompactFiles(inputs, sink, builder.build());
+  ASSERT_EQ(4, metadata->num_row_groups());
+  ASSERT_EQ(40000, metadata->num_rows());
+
+  auto source = std::make_shared<::arrow::io::BufferReader>(sink->GetBuffer());
+  auto file_reader = ParquetFileReader::Open(source);
+  ASSERT_EQ(4, file_reader->metadata()->num_row_groups());
+  for (int i = 0; i < 4; ++i) {
+    auto rg_reader = file_reader->RowGroup(i);
+    auto source_rg_reader = readers[i / 2]->RowGroup(i % 2);
+    for (int j = 0; j < 2; ++j) {
+      auto chunk = rg_reader->metadata()->ColumnChunk(j);
+      auto source_chunk = source_rg_reader->metadata()->ColumnChunk(j);
+      ASSERT_EQ(source_chunk->total_compressed_size(), chunk->total_compressed_size());
+      ASSERT_EQ(source_chunk->has_dictionary_page(), chunk->has_dictionary_page());
+      ASSERT_EQ(source_chunk->compression(), chunk->compression());
+    }
+
+    // The values are read through the moved page index
+    std::unique_ptr<OffsetIndex> offset_index = rg_reader->GetOffsetIndex(1);
+    ASSERT_NE(nullptr, offset_index);
+    ASSERT_NE(nullptr, rg_reader->GetColumnIndex(1));
+    int page = offset_index->FindPage(7777);
+    int64_t first_row = offset_index->page_location(page).first_row_index;
+    auto dict_reader = std::static_pointer_cast<Int64Reader>(
+        rg_reader->ColumnFromPage(1, *offset_index, page));
+    dict_reader->Skip(7777 - first_row);
+    int64_t value;
+    int64_t values_read;
+    dict_reader->ReadBatch(1, nullptr, nullptr, &value, &values_read);
+    ASSERT_EQ(1, values_read);
+    ASSERT_EQ(7, value);
+
+    auto plain_reader = std::static_pointer_cast<Int64Reader>(rg_reader->Column(0));
+    std::vector<int64_t> values(10000);
+    ASSERT_EQ(10000, plain_reader->ReadBatchFull(10000, nullptr, nullptr, values.data(),
+                                                 &values_read));
+    ASSERT_EQ(10000, values_read);
+    for (int64_t k = 0; k < 10000; ++k) {
+      ASSERT_EQ(k, values[k]);
+    }
+  }
+}
+
+TEST(TestCompaction, RejectsDifferentSchema) {
+  NodePtr schema =
+      GroupNode::Make("schema", Repetition::REQUIRED,
+                      {PrimitiveNode::Make("a", Repetition::REQUIRED, Type::INT32)});
+  std::shared_ptr<InMemoryOutputStream> sink(new InMemoryOutputStream());
+  auto file_writer =
+      ParquetFileWriter::Open(sink, std::static_pointer_cast<GroupNode>(schema));
+
+  auto source = std::make_shared<::arrow::io::BufferReader>(WriteTwoRowGroups(false));
+  auto file_reader = ParquetFileReader::Open(source);
+  ASSERT_THROW(file_writer->CopyRowGroup(file_reader->RowGroup(0).get()),
+               ParquetException);
+}
+
+TEST(TestRecompression, ChangesOnlyTheCodec) {
+  auto source = std::make_shared<::arrow::io::BufferReader>(WriteTwoRowGroups(false));
+  auto input = ParquetFileReader::Open(source);
+
+  WriterProperties::Builder builder;
+  builder.compression(Compression::GZIP)->enable_page_index();
+  std::shared_ptr<InMemoryOutputStream> sink(new InMemoryOutputStream());
+  std::shared_ptr<FileMetaData> metadata =
+      RecompressFile(input.get(), sink, builder.build(), 2);
+  ASSERT_EQ(2, metadata->num_row_groups());
+  ASSERT_EQ(20000, metadata->num_rows());
+
+  auto file_reader = ParquetFileReader::Open(
+      std::make_shared<::arrow::io::BufferReader>(sink->GetBuffer()));
+  for (int i = 0; i < 2; ++i) {
+    auto rg_reader = file_reader->RowGroup(i);
+    auto source_rg_reader = input->RowGroup(i);
+    for (int j = 0; j < 2; ++j) {
+      auto chunk = rg_reader->metadata()->ColumnChunk(j);
+      auto source_chunk = source_rg_reader->metadata()->ColumnChunk(j);
+      ASSERT_EQ(Compression::GZIP, chunk->compression());
+      ASSERT_EQ(source_chunk->num_values(), chunk->num_values());
+      ASSERT_EQ(source_chunk->encodings(), chunk->encodings());
+      ASSERT_EQ(source_chunk->has_dictionary_page(), chunk->has_dictionary_page());
+      ASSERT_EQ(source_chunk->is_stats_set(), chunk->is_stats_set());
+    }
+
+    std::unique_ptr<OffsetIndex> offset_index = rg_reader->GetOffsetIndex(1);
+    ASSERT_NE(nullptr, offset_index);
+    ASSERT_EQ(source_rg_reader->GetOffsetIndex(1)->num_pages(),
+              offset_index->num_pages());
+    int page = offset_index->FindPage(7777);
+    int64_t first_row = offset_index->page_location(page).first_row_index;
+    auto dict_reader = std::static_pointer_cast<Int64Reader>(
+        rg_reader->ColumnFromPage(1, *offset_index, page));
+    dict_reader->Skip(7777 - first_row);
+    int64_t value;
+    int64_t values_read;
+    dict_reader->ReadBatch(1, nullptr, nullptr, &value, &values_read);
+    ASSERT_EQ(1, values_read);
+    ASSERT_EQ(7, value);
+
+    auto plain_reader = std::static_pointer_cast<Int64Reader>(rg_reader->Column(0));
+    std::vector<int64_t> values(10000);
+    ASSERT_EQ(10000, plain_reader->ReadBatchFull(10000, nullptr, nullptr, values.data(),
+                                                 &values_read));
+    ASSERT_EQ(10000, values_read);
+    for (int64_t k = 0; k < 10000; ++k) {
+      ASSERT_EQ(k, values[k]);
+    }
+  }
+}
+
+// The statistics of the BYTE_ARRAY pages written by parquet-mr before
+// PARQUET-251 are wrong, and would be trusted coming from this writer
+TEST(TestRecompression, DropsStatisticsOfOldWriters) {
+  NodePtr schema = GroupNode::Make(
+      "schema", Repetition::REQUIRED,
+      {PrimitiveNode::Make("s", Repetition::REQUIRED, Type::BYTE_ARRAY)});
+  std::shared_ptr<InMemoryOutputStream> old_sink(new InMemoryOutputStream());
+  auto old_writer = ParquetFileWriter::Open(
+      old_sink, std::static_pointer_cast<GroupNode>(schema),
+      WriterProperties::Builder()
+          .created_by("parquet-mr version 1.2.0")
+          ->disable_dictionary()
+          ->compression(Compression::SNAPPY)
+          ->build());
+  const uint8_t bytes[] = {'a', 'b', 'c'};
+  std::vector<ByteArray> strings = {ByteArray(1, bytes), ByteArray(2, bytes + 1)};
+  static_cast<ByteArrayWriter*>(old_writer->AppendRowGroup(2)->NextColumn())
+      ->WriteBatch(2, nullptr, nullptr, strings.data());
+  old_writer->Close();
+  auto input = ParquetFileReader::Open(
+      std::make_shared<::arrow::io::BufferReader>(old_sink->GetBuffer()));
+  std::unique_ptr<PageReader> source_pages = input->RowGroup(0)->GetColumnPageReader(0);
+  std::shared_ptr<Page> source_page = source_pages->NextPage();
+  ASSERT_TRUE(static_cast<const DataPage*>(source_page.get())->statistics().has_min);
+
+  for (bool recompress : {false, true}) {
+    std::shared_ptr<InMemoryOutputStream> sink(new InMemoryOutputStream());
+    auto file_writer =
+        ParquetFileWriter::Open(sink, std::static_pointer_cast<GroupNode>(schema));
+    if (recompress) {
+      file_writer->RecompressRowGroup(input->RowGroup(0).get());
+    } else {
+      file_writer->CopyRowGroup(input->RowGroup(0).get());
+    }
+    file_writer->Close();
+
+    auto file_reader = ParquetFileReader::Open(
+        std::make_shared<::arrow::io::BufferReader>(sink->GetBuffer()));
+    auto rg_reader = file_reader->RowGroup(0);
+    ASSERT_FALSE(rg_reader->metadata()->ColumnChunk(0)->is_stats_set());
+    ASSERT_EQ(recompress ? Compression::UNCOMPRESSED : Compression::SNAPPY,
+              rg_reader->metadata()->ColumnChunk(0)->compression());
+    std::unique_ptr<PageReader> pages = rg_reader->GetColumnPageReader(0);
+    std::shared_ptr<Page> page;
+    while ((page = pages->NextPage()) != nullptr) {
+      if (page->type() == PageType::DATA_PAGE) {
+        const EncodedStatistics& statistics =
+            static_cast<const DataPage*>(page.get())->statistics();
+        ASSERT_FALSE(statistics.has_min);
+        ASSERT_FALSE(statistics.has_max);
+      }
+    }
+
+    auto column = std::static_pointer_cast<ByteArrayReader>(rg_reader->Column(0));
+    ByteArray values[2];
+    int64_t values_read;
+    ASSERT_EQ(2, column->ReadBatch(2, nullptr, nullptr, values, &values_read));
+    ASSERT_EQ(strings[1], values[1]);
+  }
+}
+
+// Write two row groups of 1000 values each with Bloom filters, directly or
+// through buffered row groups
+static std::shared_ptr<Buffer> WriteBloomFilteredFile(bool buffered,
+                                                      bool bloom_filter = true) {
+  NodePtr schema = GroupNode::Make(
+      "schema", Repetition::REQUIRED,
+      {PrimitiveNode::Make("values", Repetition::REQUIRED, Type::INT64)});
+  WriterProperties::Builder builder;
+  if (bloom_filter) builder.enable_bloom_filter("values");
+  std::shared_ptr<InMemoryOutputStream> sink(new InMemoryOutputStream());
+  auto file_writer = ParquetFileWriter::Open(
+      sink, std::static_pointer_cast<GroupNode>(schema), builder.build());
+  std::vector<int64_t> values(1000);
+  for (int i = 0; i < 2; ++i) {
+    for (int64_t j = 0; j < 1000; ++j) {
+      values[j] = i * 1000 + j;
+    }
+    RowGroupWriter* row_group_writer;
+    Int64Writer* writer;
+    if (buffered) {
+      row_group_writer = file_writer->AppendBufferedRowGroup(1000);
+      writer = static_cast<Int64Writer*>(row_group_writer->column(0));
+    } else {
+      row_group_writer = file_writer->AppendRowGroup(1000);
+      writer = static_cast<Int64Writer*>(row_group_writer->NextColumn());
+    }
+    writer->WriteBatch(1000, nullptr, nullptr, values.data());
+    row_group_writer->Close();
+  }
+  file_writer->Close();
+  return sink->GetBuffer();
+}
+
+TEST(TestBufferedRowGroup, BloomFiltersKeepTheSequentialLayout) {
+  std::shared_ptr<Buffer> expected = WriteBloomFilteredFile(false);
+  std::shared_ptr<Buffer> actual = WriteBloomFilteredFile(true);
+  ASSERT_TRUE(expected->Equals(*actual));
+}
+
+TEST(TestCompaction, CopiesBloomFiltersAfterTheMetadata) {
+  std::shared_ptr<Buffer> file = WriteBloomFilteredFile(false);
+  std::unique_ptr<ParquetFileReader> input =
+      ParquetFileReader::Open(std::make_shared<::arrow::io::BufferReader>(file));
+  std::shared_ptr<InMemoryOutputStream> sink(new InMemoryOutputStream());
+  CompactFiles({input.get()}, sink, default_writer_properties());
+  std::shared_ptr<Buffer> buffer = sink->GetBuffer();
+
+  auto file_reader =
+      ParquetFileReader::Open(std::make_shared<::arrow::io::BufferReader>(buffer));
+  ASSERT_EQ(2, file_reader->metadata()->num_row_groups());
+  for (int i = 0; i < 2; ++i) {
+    auto rg_reader = file_reader->RowGroup(i);
+    auto chunk = rg_reader->metadata()->ColumnChunk(0);
+    ASSERT_TRUE(chunk->has_bloom_filter());
+    ASSERT_LT(chunk->file_offset(), chunk->bloom_filter_offset());
+
+    // The inline copy of the metadata is where file_offset points
+    format::ColumnChunk inline_chunk;
+    uint32_t length = static_cast<uint32_t>(buffer->size() - chunk->file_offset());
+    DeserializeThriftMsg(buffer->data() + chunk->file_offset(), &length, &inline_chunk);
+    ASSERT_EQ(1000, inline_chunk.meta_data.num_values);
+    ASSERT_EQ(chunk->data_page_offset(), inline_chunk.meta_data.data_page_offset);
+
+    std::unique_ptr<BloomFilter> filter = rg_reader->GetBloomFilter(0);
+    ASSERT_NE(nullptr, filter);
+    for (int64_t j = 0; j < 1000; ++j) {
+      ASSERT_TRUE(filter->FindHash(BloomFilter::Hash(i * 1000 + j)));
+    }
+  }
+}
+
+TEST(TestBloomFilterWrite, CountsTowardsTheRowGroupSize) {
+  for (bool buffered : {false, true}) {
+    std::shared_ptr<Buffer> unfiltered = WriteBloomFilteredFile(buffered, false);
+    auto without_filters =
+        ParquetFileReader::Open(std::make_shared<::arrow::io::BufferReader>(unfiltered));
+    std::shared_ptr<Buffer> file = WriteBloomFilteredFile(buffered);
+    auto with_filters =
+        ParquetFileReader::Open(std::make_shared<::arrow::io::BufferReader>(file));
+    for (int i = 0; i < 2; ++i) {
+      auto rg_metadata = with_filters->metadata()->RowGroup(i);
+      ASSERT_EQ(without_filters->metadata()->RowGroup(i)->total_byte_size() +
+                    rg_metadata->ColumnChunk(0)->bloom_filter_length(),
+                rg_metadata->total_byte_size());
+    }
+
+    // The copies keep the size of the source row groups
+    std::unique_ptr<ParquetFileReader> input =
+        ParquetFileReader::Open(std::make_shared<::arrow::io::BufferReader>(file));
+    std::shared_ptr<InMemoryOutputStream> sink(new InMemoryOutputStream());
+    CompactFiles({input.get()}, sink, default_writer_properties());
+    auto compacted = ParquetFileReader::Open(
+        std::make_shared<::arrow::io::BufferReader>(sink->GetBuffer()));
+    for (int i = 0; i < 2; ++i) {
+      ASSERT_EQ(with_filters->metadata()->RowGroup(i)->total_byte_size(),
+                compacted->metadata()->RowGroup(i)->total_byte_size());
+    }
+  }
+}
+
+// Write row groups of 1000 consecutive values each, starting at 0
+static std::shared_ptr<Buffer> WriteSortedFile(int num_row_groups, bool declare_sorted) {
+  NodePtr schema = GroupNode::Make(
+      "schema", Repetition::REQUIRED,
+      {PrimitiveNode::Make("sorted", Repetition::REQUIRED, Type::INT64)});
+  WriterProperties::Builder builder;
+  builder.data_pagesize(1024)->write_batch_size(100)->disable_dictionary();
+  builder.enable_page_index();
+  if (declare_sorted) {
+    builder.sorting_columns({SortingColumn{0, false, false}});
+  }
+  std::shared_ptr<InMemoryOutputStream> sink(new InMemoryOutputStream());
+  auto file_writer = ParquetFileWriter::Open(
+      sink, std::static_pointer_cast<GroupNode>(schema), builder.build());
+  std::vector<int64_t> values(1000);
+  for (int i = 0; i < num_row_groups; ++i) {
+    auto row_group_writer = file_writer->AppendRowGroup(1000);
+    for (int64_t j = 0; j < 1000; ++j) {
+      values[j] = i * 1000 + j;
+    }
+    static_cast<Int64Writer*>(row_group_writer->NextColumn())
+        ->WriteBatch(1000, nullptr, nullptr, values.data());
+    row_group_writer->Close();
+  }
+  file_writer->Close();
+  return sink->GetBuffer();
+}
+
+TEST(TestSortedSearch, FindsRowGroupsAndPages) {
+  auto file_reader = ParquetFileReader::Open(
+      std::make_shared<::arrow::io::BufferReader>(WriteSortedFile(10, true)));
+  std::shared_ptr<FileMetaData> metadata = file_reader->metadata();
+  std::vector<SortingColumn> sorting_columns = metadata->RowGroup(3)->sorting_columns();
+  ASSERT_EQ(1U, sorting_columns.size());
+  ASSERT_EQ(0, sorting_columns[0].column_index);
+  ASSERT_FALSE(sorting_columns[0].descending);
+
+  ASSERT_EQ(std::vector<int>({2, 3, 4}),
+            FindSortedRowGroups<Int64Type>(*metadata, 0, 2500, 4000));
+  ASSERT_EQ(std::vector<int>({9}),
+            FindSortedRowGroups<Int64Type>(*metadata, 0, 9999, 20000));
+  ASSERT_TRUE(FindSortedRowGroups<Int64Type>(*metadata, 0, 10000, 20000).empty());
+  ASSERT_TRUE(FindSortedRowGroups<Int64Type>(*metadata, 0, -10, -1).empty());
+
+  auto rg_reader = file_reader->RowGroup(5);
+  std::unique_ptr<ColumnIndex> column_index = rg_reader->GetColumnIndex(0);
+  ASSERT_NE(nullptr, column_index);
+  ASSERT_GT(column_index->num_pages(), 2);
+  const RowGroupMetaData& rg_metadata = *rg_reader->metadata();
+  ASSERT_EQ(column_index->FindPages<Int64Type>(5100, 5400),
+            FindSortedPages<Int64Type>(rg_metadata, *column_index, 5100, 5400));
+  ASSERT_EQ(column_index->FindPages<Int64Type>(0, 5000),
+            FindSortedPages<Int64Type>(rg_metadata, *column_index, 0, 5000));
+
+  // Without the declared order the statistics of every row group are checked
+  file_reader = ParquetFileReader::Open(
+      std::make_shared<::arrow::io::BufferReader>(WriteSortedFile(10, false)));
+  metadata = file_reader->metadata();
+  ASSERT_TRUE(metadata->RowGroup(0)->sorting_columns().empty());
+  ASSERT_EQ(std::vector<int>({2, 3, 4}),
+            FindSortedRowGroups<Int64Type>(*metadata, 0, 2500, 4000));
+}
+
+TEST(TestSortedSearch, CompactedSortedFiles) {
+  // Each row group is sorted, but the row groups of the second file start
+  // over: the bounds are [0, 999], [1000, 1999], [0, 999], [1000, 1999]
+  std::vector<std::shared_ptr<Buffer>> files = {WriteSortedFile(2, true),
+                                                WriteSortedFile(2, true)};
+  std::vector<std::unique_ptr<ParquetFileReader>> readers;
+  std::vector<ParquetFileReader*> inputs;
+  for (const auto& file : files) {
+    readers.push_back(
+        ParquetFileReader::Open(std::make_shared<::arrow::io::BufferReader>(file)));
+    inputs.push_back(readers.back().get());
+  }
+  std::shared_ptr<InMemoryOutputStream> sink(new InMemoryOutputStream());
+  std::shared_ptr<FileMetaData> metadata =
+      CompactFiles(inputs, sink, default_writer_properties());
+  ASSERT_EQ(4, metadata->num_row_groups());
+  ASSERT_FALSE(metadata->RowGroup(3)->sorting_columns().empty());
+
+  ASSERT_EQ(std::vector<int>({1, 3}),
+            FindSortedRowGroups<Int64Type>(*metadata, 0, 1500, 1600));
+  ASSERT_EQ(std::vector<int>({0, 1, 2, 3}),
+            FindSortedRowGroups<Int64Type>(*metadata, 0, 999, 1000));
+}
+
+TEST(TestScanFileContents, ParallelScanStats) {
+  auto file_reader = ParquetFileReader::Open(
+      std::make_shared<::arrow::io::BufferReader>(WriteTwoRowGroups(false)));
+  std::vector<ColumnScanStats> stats;
+  ASSERT_EQ(20000, ScanFileContents({}, 256, file_reader.get(), 2, &stats));
+  ASSERT_EQ(2U, stats.size());
+  for (int i = 0; i < 2; ++i) {
+    int64_t bytes = 0;
+    for (int j = 0; j < 2; ++j) {
+      auto chunk = file_reader->metadata()->RowGroup(j)->ColumnChunk(i);
+      bytes += chunk->total_compressed_size();
+    }
+    ASSERT_EQ(bytes, stats[i].bytes_read);
+    ASSERT_LT(0, stats[i].decompressed_bytes);
+    ASSERT_LE(0, stats[i].decode_seconds);
+  }
+
+  // Projected columns
+  ASSERT_EQ(20000, ScanFileContents({1}, 256, file_reader.get(), 4, &stats));
+  ASSERT_EQ(1U, stats.size());
+}
+
+TEST(TestFileWriter, MetadataAfterClose) {
+  NodePtr schema =
+      GroupNode::Make("schema", Repetition::REQUIRED,
+                      {PrimitiveNode::Make("a", Repetition::REQUIRED, Type::INT32)});
+  std::shared_ptr<InMemoryOutputStream> sink(new InMemoryOutputStream());
+  auto file_writer =
+      ParquetFileWriter::Open(sink, std::static_pointer_cast<GroupNode>(schema));
+  int32_t value = 42;
+  static_cast<Int32Writer*>(file_writer->AppendRowGroup(1)->NextColumn())
+      ->WriteBatch(1, nullptr, nullptr, &value);
+  ASSERT_EQ(nullptr, file_writer->metadata());
+  file_writer->Close();
+  ASSERT_NE(nullptr, file_writer->metadata());
+  ASSERT_EQ(1, file_writer->metadata()->num_rows());
+  ASSERT_EQ(1, file_writer->metadata()->num_row_groups());
+}
+
+TEST(TestBufferedRowGroup, ColumnAccess) {
+  NodePtr schema =
+      GroupNode::Make("schema", Repetition::REQUIRED,
+                      {PrimitiveNode::Make("a", Repetition::REQUIRED, Type::INT32)});
+  std::shared_ptr<InMemoryOutputStream> sink(new InMemoryOutputStream());
+  auto file_writer =
+      ParquetFileWriter::Open(sink, std::static_pointer_cast<GroupNode>(schema));
+
+  auto row_group_writer = file_writer->AppendRowGroup(1);
+  ASSERT_THROW(row_group_writer->column(0), ParquetException);
+  int32_t value = 1;
+  static_cast<Int32Writer*>(row_group_writer->NextColumn())
+      ->WriteBatch(1, nullptr, nullptr, &value);
+
+  row_group_writer = file_writer->AppendBufferedRowGroup(1);
+  ASSERT_THROW(row_group_writer->NextColumn(), ParquetException);
+  ASSERT_THROW(row_group_writer->column(1), ParquetException);
+  static_cast<Int32Writer*>(row_group_writer->column(0))
+      ->WriteBatch(1, nullptr, nullptr, &value);
+  file_writer->Close();
+
+  auto source = std::make_shared<::arrow::io::BufferReader>(sink->GetBuffer());
+  auto file_reader = ParquetFileReader::Open(source);
+  ASSERT_EQ(2, file_reader->metadata()->num_row_groups());
+  ASSERT_EQ(2, file_reader->metadata()->num_rows());
+}
+
+TEST(TestBufferedRowGroup, UnknownNumberOfRows) {
+  NodePtr schema =
+      GroupNode::Make("schema", Repetition::REQUIRED,
+                      {PrimitiveNode::Make("a", Repetition::REQUIRED, Type::INT32),
+                       PrimitiveNode::Make("b", Repetition::REQUIRED, Type::INT32)});
+  std::shared_ptr<InMemoryOutputStream> sink(new InMemoryOutputStream());
+  auto file_writer =
+      ParquetFileWriter::Open(sink, std::static_pointer_cast<GroupNode>(schema));
+
+  // The number of rows is taken from the columns, written in several batches
+  std::vector<int32_t> values = {1, 2, 3};
+  auto row_group_writer = file_writer->AppendBufferedRowGroup();
+  for (int batch = 0; batch < 2; batch++) {
+    for (int i = 0; i < 2; i++) {
+      static_cast<Int32Writer*>(row_group_writer->column(i))
+          ->WriteBatch(3, nullptr, nullptr, values.data());
+    }
+  }
+  ASSERT_EQ(6, row_group_writer->num_rows());
+  ASSERT_EQ(6, file_writer->num_rows());
+  ASSERT_LT(0, row_group_writer->buffered_bytes());
+
+  // The columns must agree on the number of rows
+  row_group_writer = file_writer->AppendBufferedRowGroup();
+  static_cast<Int32Writer*>(row_group_writer->column(0))
+      ->WriteBatch(3, nullptr, nullptr, values.data());
+  static_cast<Int32Writer*>(row_group_writer->column(1))
+      ->WriteBatch(2, nullptr, nullptr, values.data());
+  ASSERT_THROW(row_group_writer->Close(), ParquetException);
+
+  ASSERT_THROW(file_writer->AppendRowGroup(-1), ParquetException);
+}
+
+// Read the single INT32 column of the row group
+static std::vector<int32_t> ReadInt32RowGroup(RowGroupReader* row_group) {
+  int64_t num_rows = row_group->metadata()->num_rows();
+  std::vector<int32_t> values(num_rows);
+  int64_t values_read;
+  std::static_pointer_cast<Int32Reader>(row_group->Column(0))
+      ->ReadBatch(num_rows, nullptr, nullptr, values.data(), &values_read);
+  return values;
+}
+
+TEST(TestConcurrentRowGroups, AppendedInCompletionOrder) {
+  const int num_threads = 4;
+  const int num_rows = 1000;
+  NodePtr schema = GroupNode::Make(
+      "schema", Repetition::REQUIRED,
+      {PrimitiveNode::Make("a", Repetition::REQUIRED, Type::INT32)});
+  std::shared_ptr<InMemoryOutputStream> sink(new InMemoryOutputStream());
+  auto file_writer = ParquetFileWriter::Open(
+      sink, std::static_pointer_cast<GroupNode>(schema),
+      WriterProperties::Builder().data_pagesize(1024)->enable_page_index()->build());
+
+  // Each thread writes the values of one row group, all equal to its index
+  std::vector<std::thread> threads;
+  for (int i = 0; i < num_threads; ++i) {
+    threads.emplace_back([&file_writer, i, num_rows]() {
+      std::unique_ptr<RowGroupWriter> row_group_writer =
+          file_writer->AppendConcurrentRowGroup();
+      std::vector<int32_t> values(num_rows, i);
+      for (int batch = 0; batch < 10; ++batch) {
+        static_cast<Int32Writer*>(row_group_writer->column(0))
+            ->WriteBatch(num_rows / 10, nullptr, nullptr, values.data());
+      }
+      row_group_writer->Close();
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(num_threads * num_rows, file_writer->num_rows());
+  file_writer->Close();
+
+  auto file_reader = ParquetFileReader::Open(
+      std::make_shared<::arrow::io::BufferReader>(sink->GetBuffer()));
+  ASSERT_EQ(num_threads, file_reader->metadata()->num_row_groups());
+  std::vector<bool> seen(num_threads, false);
+  int64_t previous_offset = 0;
+  for (int i = 0; i < num_threads; ++i) {
+    auto rg_reader = file_reader->RowGroup(i);
+    // The row groups are listed in file order
+    int64_t offset = rg_reader->metadata()->ColumnChunk(0)->data_page_offset();
+    ASSERT_LT(previous_offset, offset);
+    previous_offset = offset;
+
+    std::vector<int32_t> values = ReadInt32RowGroup(rg_reader.get());
+    ASSERT_EQ(num_rows, static_cast<int>(values.size()));
+    ASSERT_FALSE(seen[values[0]]);
+    seen[values[0]] = true;
+    ASSERT_EQ(std::vector<int32_t>(num_rows, values[0]), values);
+
+    std::unique_ptr<OffsetIndex> offset_index = rg_reader->GetOffsetIndex(0);
+    ASSERT_NE(nullptr, offset_index);
+    ASSERT_EQ(offset, offset_index->page_location(0).offset);
+  }
+}
+
+TEST(TestConcurrentRowGroups, KeepOrder) {
+  NodePtr schema = GroupNode::Make(
+      "schema", Repetition::REQUIRED,
+      {PrimitiveNode::Make("a", Repetition::REQUIRED, Type::INT32)});
+  std::shared_ptr<InMemoryOutputStream> sink(new InMemoryOutputStream());
+  auto file_writer =
+      ParquetFileWriter::Open(sink, std::static_pointer_cast<GroupNode>(schema));
+
+  std::vector<int32_t> values = {1, 2, 3, 4};
+  std::unique_ptr<RowGroupWriter> first = file_writer->AppendConcurrentRowGroup(3, true);
+  std::unique_ptr<RowGroupWriter> second = file_writer->AppendConcurrentRowGroup(3, true);
+  static_cast<Int32Writer*>(first->column(0))
+      ->WriteBatch(3, nullptr, nullptr, values.data());
+  static_cast<Int32Writer*>(second->column(0))
+      ->WriteBatch(3, nullptr, nullptr, values.data() + 1);
+  ASSERT_THROW(file_writer->AppendRowGroup(3), ParquetException);
+
+  // The second row group waits for the first one
+  second->Close();
+  ASSERT_THROW(file_writer->Close(), ParquetException);
+  first->Close();
+  file_writer->Close();
+
+  auto file_reader = ParquetFileReader::Open(
+      std::make_shared<::arrow::io::BufferReader>(sink->GetBuffer()));
+  ASSERT_EQ(2, file_reader->metadata()->num_row_groups());
+  ASSERT_EQ(1, ReadInt32RowGroup(file_reader->RowGroup(0).get())[0]);
+  ASSERT_EQ(2, ReadInt32RowGroup(file_reader->RowGroup(1).get())[0]);
+}
+
+TEST(TestConcurrentRowGroups, FailedRowGroupIsDropped) {
+  NodePtr schema = GroupNode::Make(
+      "schema", Repetition::REQUIRED,
+      {PrimitiveNode::Make("a", Repetition::REQUIRED, Type::INT32)});
+  std::shared_ptr<InMemoryOutputStream> sink(new InMemoryOutputStream());
+  auto file_writer = ParquetFileWriter::Open(
+      sink, std::static_pointer_cast<GroupNode>(schema),
+      WriterProperties::Builder().enable_page_index()->build());
+
+  std::vector<int32_t> values = {1, 2, 3, 4};
+  std::unique_ptr<RowGroupWriter> first = file_writer->AppendConcurrentRowGroup(3, true);
+  std::unique_ptr<RowGroupWriter> second = file_writer->AppendConcurrentRowGroup(3, true);
+  static_cast<Int32Writer*>(second->column(0))
+      ->WriteBatch(3, nullptr, nullptr, values.data() + 1);
+  second->Close();
+
+  // Too few rows: the first row group fails and the held one is appended
+  static_cast<Int32Writer*>(first->column(0))
+      ->WriteBatch(2, nullptr, nullptr, values.data());
+  ASSERT_THROW(first->Close(), ParquetException);
+  ASSERT_EQ(1, file_writer->num_row_groups());
+  ASSERT_EQ(3, file_writer->num_rows());
+  file_writer->Close();
+
+  auto file_reader = ParquetFileReader::Open(
+      std::make_shared<::arrow::io::BufferReader>(sink->GetBuffer()));
+  ASSERT_EQ(1, file_reader->metadata()->num_row_groups());
+  ASSERT_EQ(3, file_reader->metadata()->num_rows());
+  ASSERT_EQ(2, ReadInt32RowGroup(file_reader->RowGroup(0).get())[0]);
+  ASSERT_NE(nullptr, file_reader->RowGroup(0)->GetOffsetIndex(0));
+}
+
+// Writes a sequential and a buffered row group of a plain, a dictionary-encoded
+// and a dictionary column falling back to PLAIN, all compressed
+static std::shared_ptr<Buffer> WriteCompressedColumns(
+    bool async_compression, ParquetDataPageVersion::type data_page_version) {
+  const int64_t num_rows = 10000;
+  NodePtr schema = GroupNode::Make(
+      "schema", Repetition::REQUIRED,
+      {PrimitiveNode::Make("plain", Repetition::REQUIRED, Type::INT64),
+       PrimitiveNode::Make("dict", Repetition::OPTIONAL, Type::INT64),
+       PrimitiveNode::Make("fallback", Repetition::REQUIRED, Type::INT64)});
+
+  WriterProperties::Builder builder;
+  builder.data_pagesize(1024)
+      ->dictionary_pagesize_limit(1024)
+      ->write_batch_size(100)
+      ->disable_dictionary("plain")
+      ->compression(Compression::SNAPPY)
+      ->data_page_version(data_page_version)
+      ->enable_page_index()
+      ->async_compression_queue_size(2);
+  if (async_compression) {
+    builder.enable_async_compression();
+  }
+
+  std::vector<int64_t> values(num_rows);
+  std::vector<int64_t> dict_values(num_rows);
+  std::vector<int16_t> def_levels(num_rows);
+  for (int64_t i = 0; i < num_rows; ++i) {
+    values[i] = i;
+    dict_values[i] = i % 10;
+    def_levels[i] = i % 3 == 0 ? 0 : 1;
+  }
+
+  std::shared_ptr<InMemoryOutputStream> sink(new InMemoryOutputStream());
+  auto file_writer = ParquetFileWriter::Open(
+      sink, std::static_pointer_cast<GroupNode>(schema), builder.build());
+  for (int rg = 0; rg < 2; ++rg) {
+    RowGroupWriter* row_group_writer;
+    std::vector<Int64Writer*> writers;
+    if (rg == 0) {
+      row_group_writer = file_writer->AppendRowGroup(num_rows);
+    } else {
+      row_group_writer = file_writer->AppendBufferedRowGroup(num_rows);
+    }
+    for (int i = 0; i < 3; ++i) {
+      auto column_writer = static_cast<Int64Writer*>(
+          rg == 0 ? row_group_writer->NextColumn() : row_group_writer->column(i));
+      if (i == 1) {
+        column_writer->WriteBatch(num_rows, def_levels.data(), nullptr,
+                                  dict_values.data());
+      } else {
+        column_writer->WriteBatch(num_rows, nullptr, nullptr, values.data());
+      }
+    }
+  }
+  file_writer->Close();
+  return sink->GetBuffer();
+}
+
+TEST(TestAsyncCompression, SameFileAsSynchronousCompression) {
+  for (auto version : {ParquetDataPageVersion::V1, ParquetDataPageVersion::V2}) {
+    std::shared_ptr<Buffer> expected = WriteCompressedColumns(false, version);
+    std::shared_ptr<Buffer> actual = WriteCompressedColumns(true, version);
+    ASSERT_TRUE(expected->Equals(*actual));
+
+    auto source = std::make_shared<::arrow::io::BufferReader>(actual);
+    auto file_reader = ParquetFileReader::Open(source);
+    ASSERT_EQ(2, file_reader->metadata()->num_row_groups());
+    for (int rg = 0; rg < 2; ++rg) {
+      auto rg_reader = file_reader->RowGroup(rg);
+      auto col_reader = std::static_pointer_cast<Int64Reader>(rg_reader->Column(2));
+      std::vector<int64_t> values(10000);
+      int64_t values_read;
+      col_reader->ReadBatch(10000, nullptr, nullptr, values.data(), &values_read);
+      ASSERT_EQ(10000, values_read);
+      ASSERT_EQ(9999, values[9999]);
+    }
+  }
+}
+
+TEST(TestDecompressionBufferPool, SharedByColumnReaders) {
+  std::shared_ptr<Buffer> buffer =
+      WriteCompressedColumns(false, ParquetDataPageVersion::V1);
+  auto buffer_pool = std::make_shared<DecompressionBufferPool>();
+  ReaderProperties properties;
+  properties.set_decompression_buffer_pool(buffer_pool);
+
+  auto source = std::make_shared<::arrow::io::BufferReader>(buffer);
+  auto file_reader = ParquetFileReader::Open(source, properties);
+  for (int rg = 0; rg < 2; ++rg) {
+    auto col_reader =
+        std::static_pointer_cast<Int64Reader>(file_reader->RowGroup(rg)->Column(0));
+    std::vector<int64_t> values(10000);
+    int64_t values_read;
+    col_reader->ReadBatch(10000, nullptr, nullptr, values.data(), &values_read);
+    ASSERT_EQ(10000, values_read);
+    ASSERT_EQ(9999, values[9999]);
+  }
+  // The buffers of the pages read are back in the pool
+  ASSERT_LT(0, buffer_pool->retained_bytes());
+}
+
+TEST(TestReaderStats, CountsPagesAndSkippedRows) {
+  std::shared_ptr<Buffer> buffer =
+      WriteCompressedColumns(false, ParquetDataPageVersion::V1);
+  auto stats = std::make_shared<ReaderStats>();
+  ReaderProperties properties;
+  properties.set_reader_stats(stats);
+
+  auto source = std::make_shared<::arrow::io::BufferReader>(buffer);
+  auto file_reader = ParquetFileReader::Open(source, properties);
+  std::vector<int64_t> values(10000);
+  std::vector<int16_t> def_levels(10000);
+  int64_t values_read;
+  for (int rg = 0; rg < 2; ++rg) {
+    auto row_group = file_reader->RowGroup(rg);
+    for (int i = 0; i < 2; ++i) {
+      auto col_reader = std::static_pointer_cast<Int64Reader>(row_group->Column(i));
+      col_reader->ReadBatch(10000, def_levels.data(), nullptr, values.data(),
+                            &values_read);
+    }
+  }
+  auto col_reader =
+      std::static_pointer_cast<Int64Reader>(file_reader->RowGroup(0)->Column(2));
+  ASSERT_EQ(5000, col_reader->Skip(5000));
+
+  ASSERT_EQ(3, stats->num_columns());
+  ColumnReaderStats* plain = stats->column(0);
+  ASSERT_LT(2, plain->data_pages.load());
+  ASSERT_EQ(0, plain->dictionary_pages.load());
+  ASSERT_EQ(0, plain->dictionary_encoded_pages.load());
+  ASSERT_LT(0, plain->compressed_bytes.load());
+  ASSERT_LT(0, plain->uncompressed_bytes.load());
+  ASSERT_LE(0, plain->io_time.load());
+  ASSERT_LE(0, plain->decompression_time.load());
+
+  ColumnReaderStats* dict = stats->column(1);
+  ASSERT_EQ(2, dict->dictionary_pages.load());
+  ASSERT_EQ(dict->data_pages.load(), dict->dictionary_encoded_pages.load());
+  ASSERT_LE(0, dict->level_decoding_time.load());
+
+  ColumnReaderStats* fallback = stats->column(2);
+  ASSERT_EQ(5000, fallback->rows_skipped.load());
+  ASSERT_LT(0, fallback->pages_skipped.load());
+}
+
+// Records the access hints instead of passing them to the OS
+class AdviceRecorder : public ArrowInputFile {
+ public:
+  struct Advice {
+    int64_t position;
+    int64_t nbytes;
+    AccessHint::type hint;
+  };
+
+  explicit AdviceRecorder(const std::shared_ptr<::arrow::io::ReadableFileInterface>& file)
+      : ArrowInputFile(file) {}
+
+  void Advise(int64_t position, int64_t nbytes, AccessHint::type hint) override {
+    advice_.push_back({position, nbytes, hint});
+  }
+
+  std::vector<Advice> advice_;
+};
+
+static void AssertAdvice(const ColumnChunkMetaData& column, AccessHint::type hint,
+                         const AdviceRecorder::Advice& advice) {
+  ASSERT_EQ(column.data_page_offset(), advice.position);
+  ASSERT_EQ(column.total_compressed_size(), advice.nbytes);
+  ASSERT_EQ(hint, advice.hint);
+}
+
+TEST(TestAccessHints, AnnounceNextChunksAndDropPreviousOne) {
+  std::shared_ptr<Buffer> buffer =
+      WriteCompressedColumns(false, ParquetDataPageVersion::V1);
+  auto source = std::make_shared<::arrow::io::BufferReader>(buffer);
+
+  // Disabled by default
+  std::unique_ptr<AdviceRecorder> recorder(new AdviceRecorder(source));
+  AdviceRecorder* advice = recorder.get();
+  auto file_reader = ParquetFileReader::Open(std::move(recorder));
+  file_reader->RowGroup(0)->Column(0);
+  ASSERT_TRUE(advice->advice_.empty());
+
+  ReaderProperties properties;
+  properties.enable_access_hints();
+  recorder.reset(new AdviceRecorder(source));
+  advice = recorder.get();
+  file_reader = ParquetFileReader::Open(std::move(recorder), properties);
+  auto metadata = file_reader->metadata();
+
+  // The chunk and the one of the next row group
+  file_reader->RowGroup(0)->Column(0);
+  ASSERT_EQ(2U, advice->advice_.size());
+  AssertAdvice(*metadata->RowGroup(0)->ColumnChunk(0), AccessHint::WILL_NEED,
+               advice->advice_[0]);
+  AssertAdvice(*metadata->RowGroup(1)->ColumnChunk(0), AccessHint::WILL_NEED,
+               advice->advice_[1]);
+
+  // The last row group has no next one, and the previous chunk is dropped
+  advice->advice_.clear();
+  file_reader->RowGroup(1)->Column(0);
+  ASSERT_EQ(2U, advice->advice_.size());
+  AssertAdvice(*metadata->RowGroup(1)->ColumnChunk(0), AccessHint::WILL_NEED,
+               advice->advice_[0]);
+  AssertAdvice(*metadata->RowGroup(0)->ColumnChunk(0), AccessHint::DONT_NEED,
+               advice->advice_[1]);
+}
+
+TEST(TestWriterStats, CountsPagesAndDictionaryFallbacks) {
+  const int64_t num_rows = 10000;
+  NodePtr schema = GroupNode::Make(
+      "schema", Repetition::REQUIRED,
+      {PrimitiveNode::Make("plain", Repetition::REQUIRED, Type::INT64),
+       PrimitiveNode::Make("fallback", Repetition::REQUIRED, Type::INT64)});
+
+  auto stats = std::make_shared<WriterStats>();
+  WriterProperties::Builder builder;
+  builder.data_pagesize(1024)
+      ->dictionary_pagesize_limit(1024)
+      ->write_batch_size(100)
+      ->disable_dictionary("plain")
+      ->compression(Compression::SNAPPY)
+      ->writer_stats(stats);
+
+  std::vector<int64_t> values(num_rows);
+  for (int64_t i = 0; i < num_rows; ++i) {
+    values[i] = i;
+  }
+  std::shared_ptr<InMemoryOutputStream> sink(new InMemoryOutputStream());
+  auto file_writer = ParquetFileWriter::Open(
+      sink, std::static_pointer_cast<GroupNode>(schema), builder.build());
+  for (int rg = 0; rg < 2; ++rg) {
+    RowGroupWriter* row_group_writer;
+    if (rg == 0) {
+      row_group_writer = file_writer->AppendRowGroup(num_rows);
+    } else {
+      row_group_writer = file_writer->AppendBufferedRowGroup(num_rows);
+    }
+    for (int i = 0; i < 2; ++i) {
+      auto column_writer = static_cast<Int64Writer*>(
+          rg == 0 ? row_group_writer->NextColumn() : row_group_writer->column(i));
+      column_writer->WriteBatch(num_rows, nullptr, nullptr, values.data());
+    }
+    row_group_writer->Close();
+  }
+  file_writer->Close();
+
+  ASSERT_EQ(2, stats->num_columns());
+  ColumnWriterStats* plain = stats->column(0);
+  ASSERT_EQ(2 * num_rows, plain->values.load());
+  ASSERT_LT(2, plain->data_pages.load());
+  ASSERT_EQ(0, plain->dictionary_pages.load());
+  ASSERT_EQ(0, plain->dictionary_fallbacks.load());
+  ASSERT_EQ(-1, plain->last_fallback_row.load());
+  ASSERT_LT(0, plain->encoded_bytes.load());
+  ASSERT_LT(0, plain->compressed_bytes.load());
+  ASSERT_LE(0, plain->compression_time.load());
+  ASSERT_LE(0, plain->io_time.load());
+
+  ColumnWriterStats* fallback = stats->column(1);
+  ASSERT_EQ(2 * num_rows, fallback->values.load());
+  ASSERT_EQ(2, fallback->dictionary_pages.load());
+  ASSERT_LT(0, fallback->dictionary_bytes.load());
+  ASSERT_EQ(2, fallback->dictionary_fallbacks.load());
+  ASSERT_EQ(DictionaryFallback::DICTIONARY_PAGE_SIZE_LIMIT,
+            fallback->last_fallback_reason.load());
+  ASSERT_LT(0, fallback->last_fallback_row.load());
+  ASSERT_GT(num_rows, fallback->last_fallback_row.load());
+  ASSERT_LE(0, fallback->encoding_time.load());
+  ASSERT_LE(0, fallback->statistics_time.load());
+}
+
+TEST(TestSpillableOutputStream, SpilledBytesComeFirst) {
+  std::vector<uint8_t> data(10000);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<uint8_t>(i * 7);
+  }
+  SpillableOutputStream stream;
+  stream.Write(data.data(), 3000);
+  stream.Spill();
+  ASSERT_EQ(0, stream.buffered_size());
+  ASSERT_EQ(3000, stream.Tell());
+  stream.Write(data.data() + 3000, 5000);
+  stream.Spill();
+  stream.Write(data.data() + 8000, 2000);
+  ASSERT_EQ(2000, stream.buffered_size());
+  ASSERT_EQ(8000, stream.spilled_size());
+  ASSERT_EQ(10000, stream.Tell());
+
+  InMemoryOutputStream sink;
+  stream.WriteTo(&sink);
+  std::shared_ptr<Buffer> buffer = sink.GetBuffer();
+  ASSERT_EQ(10000, buffer->size());
+  ASSERT_EQ(0, memcmp(data.data(), buffer->data(), data.size()));
+}
+
+// Writes a buffered row group of three columns a few rows at a time,
+// interleaving the columns. Dictionary encodes the last two, returning why
+// the last one fell back in fallback.
+static std::shared_ptr<Buffer> WriteRowsIncrementally(
+    int64_t memory_limit, bool dictionary = false,
+    DictionaryFallback::type* fallback = nullptr) {
+  const int64_t num_rows = 10000;
+  const int64_t batch_size = 7;
+  NodePtr schema = GroupNode::Make(
+      "schema", Repetition::REQUIRED,
+      {PrimitiveNode::Make("a", Repetition::REQUIRED, Type::INT64),
+       PrimitiveNode::Make("b", Repetition::OPTIONAL, Type::INT64),
+       PrimitiveNode::Make("c", Repetition::REQUIRED, Type::BYTE_ARRAY)});
+
+  WriterProperties::Builder builder;
+  builder.data_pagesize(1024)
+      ->disable_dictionary("a")
+      ->buffered_row_group_memory_limit(memory_limit);
+  if (!dictionary) {
+    builder.disable_dictionary();
+  }
+
+  std::vector<int64_t> values(num_rows);
+  std::vector<int16_t> def_levels(num_rows);
+  std::vector<std::string> strings(num_rows);
+  std::vector<ByteArray> byte_arrays(num_rows);
+  for (int64_t i = 0; i < num_rows; ++i) {
+    values[i] = i * 31;
+    def_levels[i] = i % 5 == 0 ? 0 : 1;
+    strings[i] = "value-" + std::to_string(i);
+    byte_arrays[i] = ByteArray(static_cast<uint32_t>(strings[i].size()),
+                               reinterpret_cast<const uint8_t*>(strings[i].data()));
+  }
+
+  std::shared_ptr<InMemoryOutputStream> sink(new InMemoryOutputStream());
+  auto file_writer = ParquetFileWriter::Open(
+      sink, std::static_pointer_cast<GroupNode>(schema), builder.build());
+  RowGroupWriter* row_group_writer = file_writer->AppendBufferedRowGroup(num_rows);
+  auto a_writer = static_cast<Int64Writer*>(row_group_writer->column(0));
+  auto b_writer = static_cast<Int64Writer*>(row_group_writer->column(1));
+  auto c_writer = static_cast<ByteArrayWriter*>(row_group_writer->column(2));
+  int64_t b_offset = 0;
+  for (int64_t row = 0; row < num_rows; row += batch_size) {
+    int64_t length = std::min(batch_size, num_rows - row);
+    a_writer->WriteBatch(length, nullptr, nullptr, values.data() + row);
+    b_writer->WriteBatch(length, def_levels.data() + row, nullptr,
+                         values.data() + b_offset);
+    for (int64_t i = row; i < row + length; ++i) {
+      b_offset += def_levels[i];
+    }
+    c_writer->WriteBatch(length, nullptr, nullptr, byte_arrays.data() + row);
+  }
+  if (fallback != nullptr) {
+    *fallback = c_writer->dictionary_fallback();
+  }
+  file_writer->Close();
+  return sink->GetBuffer();
+}
+
+TEST(TestBufferedRowGroup, InterleavedWritesUnderMemoryLimit) {
+  // The pages spill as soon as a second one is buffered
+  std::shared_ptr<Buffer> expected = WriteRowsIncrementally(0);
+  std::shared_ptr<Buffer> actual = WriteRowsIncrementally(2048);
+  ASSERT_TRUE(expected->Equals(*actual));
+
+  auto source = std::make_shared<::arrow::io::BufferReader>(actual);
+  auto file_reader = ParquetFileReader::Open(source);
+  auto rg_reader = file_reader->RowGroup(0);
+  auto a_reader = std::static_pointer_cast<Int64Reader>(rg_reader->Column(0));
+  auto c_reader = std::static_pointer_cast<ByteArrayReader>(rg_reader->Column(2));
+  std::vector<int64_t> values(10000);
+  std::vector<ByteArray> strings(10000);
+  int64_t values_read;
+  a_reader->ReadBatch(10000, nullptr, nullptr, values.data(), &values_read);
+  ASSERT_EQ(10000, values_read);
+  c_reader->ReadBatch(10000, nullptr, nullptr, strings.data(), &values_read);
+  ASSERT_EQ(10000, values_read);
+  for (int64_t i = 0; i < 10000; ++i) {
+    ASSERT_EQ(i * 31, values[i]);
+    ASSERT_EQ("value-" + std::to_string(i),
+              std::string(reinterpret_cast<const char*>(strings[i].ptr), strings[i].len));
+  }
+}
+
+TEST(TestBufferedRowGroup, HeldDictionaryPagesCountTowardsMemoryLimit) {
+  DictionaryFallback::type fallback;
+  WriteRowsIncrementally(0, true, &fallback);
+  ASSERT_EQ(DictionaryFallback::NONE, fallback);
+
+  std::shared_ptr<Buffer> buffer = WriteRowsIncrementally(2048, true, &fallback);
+  ASSERT_EQ(DictionaryFallback::MEMORY_BUDGET, fallback);
+  auto file_reader =
+      ParquetFileReader::Open(std::make_shared<::arrow::io::BufferReader>(buffer));
+  auto c_reader =
+      std::static_pointer_cast<ByteArrayReader>(file_reader->RowGroup(0)->Column(2));
+  std::vector<ByteArray> strings(10000);
+  int64_t values_read;
+  c_reader->ReadBatch(10000, nullptr, nullptr, strings.data(), &values_read);
+  ASSERT_EQ(10000, values_read);
+  for (int64_t i = 0; i < 10000; ++i) {
+    ASSERT_EQ("value-" + std::to_string(i),
+              std::string(reinterpret_cast<const char*>(strings[i].ptr), strings[i].len));
+  }
+}
+
 }  // namespace test
 
 }  // namespace parquet
@@ -0,0 +1,228 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "benchmark/benchmark.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "arrow/api.h"
+
+#include "parquet/arrow/schema.h"
+#include "parquet/file/metadata.h"
+#include "parquet/schema.h"
+#include "parquet/statistics.h"
+#include "parquet/util/memory.h"
+
+namespace parquet {
+
+using schema::GroupNode;
+using schema::NodePtr;
+using schema::NodeVector;
+using schema::PrimitiveNode;
+
+namespace benchmark {
+
+// Leaves per struct of the nested schemas
+constexpr int kStructSize = 10;
+
+// Upper bound of the column chunks of the benchmarked metadata
+constexpr int64_t kMaxColumnChunks = 1000 * 1000;
+
+static NodePtr MakeLeaf(int i) {
+  std::string name = "column" + std::to_string(i);
+  switch (i % 3) {
+    case 0:
+      return PrimitiveNode::Make(name, Repetition::REQUIRED, Type::INT64);
+    case 1:
+      return PrimitiveNode::Make(name, Repetition::OPTIONAL, Type::BYTE_ARRAY,
+                                 LogicalType::UTF8);
+    default:
+      return PrimitiveNode::Make(name, Repetition::OPTIONAL, Type::DOUBLE);
+  }
+}
+
+// A schema of num_columns leaves. If nested, the leaves are grouped in
+// optional structs of kStructSize leaves, the last of which is a list.
+static NodePtr MakeSchema(int num_columns, bool nested) {
+  NodeVector fields;
+  if (!nested) {
+    for (int i = 0; i < num_columns; ++i) {
+      fields.push_back(MakeLeaf(i));
+    }
+  } else {
+    for (int i = 0; i < num_columns; i += kStructSize) {
+      NodeVector struct_fields;
+      for (int j = i; j < std::min(i + kStructSize, num_columns) - 1; ++j) {
+        struct_fields.push_back(MakeLeaf(j));
+      }
+      NodePtr element = PrimitiveNode::Make("element", Repetition::OPTIONAL, Type::INT64);
+      NodePtr list = GroupNode::Make("list", Repetition::REPEATED, {element});
+      struct_fields.push_back(
+          GroupNode::Make("list" + std::to_string(i), Repetition::OPTIONAL, {list},
+                          LogicalType::LIST));
+      fields.push_back(GroupNode::Make("struct" + std::to_string(i),
+                                       Repetition::OPTIONAL, struct_fields));
+    }
+  }
+  return GroupNode::Make("schema", Repetition::REQUIRED, fields);
+}
+
+// Metadata of num_row_groups row groups, whose column chunks all have
+// statistics
+static std::unique_ptr<FileMetaData> MakeFileMetaData(const SchemaDescriptor* schema,
+                                                      int num_row_groups) {
+  const int64_t num_rows = 10000;
+  int64_t min = 0;
+  int64_t max = num_rows;
+  EncodedStatistics statistics;
+  statistics.set_null_count(0)
+      .set_min(std::string(reinterpret_cast<const char*>(&min), sizeof(min)))
+      .set_max(std::string(reinterpret_cast<const char*>(&max), sizeof(max)));
+
+  auto builder = FileMetaDataBuilder::Make(schema, default_writer_properties());
+  int64_t offset = 4;
+  for (int rg = 0; rg < num_row_groups; ++rg) {
+    RowGroupMetaDataBuilder* row_group = builder->AppendRowGroup(num_rows);
+    int64_t row_group_offset = offset;
+    for (int i = 0; i < schema->num_columns(); ++i) {
+      ColumnChunkMetaDataBuilder* column = row_group->NextColumnChunk();
+      column->SetStatistics(statistics);
+      column->Finish(num_rows, offset, 0, offset + 100, 1000, 2000, true, false);
+      offset += 1000;
+    }
+    row_group->Finish(offset - row_group_offset);
+  }
+  return builder->Finish();
+}
+
+static std::shared_ptr<Buffer> SerializeFileMetaData(const FileMetaData& metadata) {
+  InMemoryOutputStream stream;
+  metadata.WriteTo(&stream);
+  return stream.GetBuffer();
+}
+
+static void SetColumnChunksProcessed(::benchmark::State& state, int64_t num_columns,
+                                     int64_t num_row_groups) {
+  state.SetItemsProcessed(state.iterations() * num_columns * num_row_groups);
+}
+
+// The arguments are the number of columns and whether the schema is nested
+static void BM_SchemaDescriptorInit(::benchmark::State& state) {
+  NodePtr root = MakeSchema(static_cast<int>(state.range(0)), state.range(1) != 0);
+
+  while (state.KeepRunning()) {
+    SchemaDescriptor schema;
+    schema.Init(root);
+  }
+  SetColumnChunksProcessed(state, state.range(0), 1);
+}
+
+static void BM_FromParquetSchema(::benchmark::State& state) {
+  SchemaDescriptor schema;
+  schema.Init(MakeSchema(static_cast<int>(state.range(0)), state.range(1) != 0));
+
+  while (state.KeepRunning()) {
+    std::shared_ptr<::arrow::Schema> arrow_schema;
+    PARQUET_THROW_NOT_OK(arrow::FromParquetSchema(&schema, &arrow_schema));
+  }
+  SetColumnChunksProcessed(state, state.range(0), 1);
+}
+
+static void SchemaArguments(::benchmark::internal::Benchmark* b) {
+  for (int num_columns : {10, 100, 1000, 10000, 50000}) {
+    for (int nested : {0, 1}) {
+      b->Args({num_columns, nested});
+    }
+  }
+}
+
+BENCHMARK(BM_SchemaDescriptorInit)->Apply(SchemaArguments);
+BENCHMARK(BM_FromParquetSchema)->Apply(SchemaArguments);
+
+// The arguments are the number of columns, of row groups, and whether the
+// schema is nested
+struct MetaDataCase {
+  explicit MetaDataCase(const ::benchmark::State& state)
+      : num_columns(static_cast<int>(state.range(0))),
+        num_row_groups(static_cast<int>(state.range(1))) {
+    schema.Init(MakeSchema(num_columns, state.range(2) != 0));
+  }
+
+  int num_columns;
+  int num_row_groups;
+  SchemaDescriptor schema;
+};
+
+static void BM_FileMetaDataFinish(::benchmark::State& state) {
+  MetaDataCase test_case(state);
+
+  while (state.KeepRunning()) {
+    MakeFileMetaData(&test_case.schema, test_case.num_row_groups);
+  }
+  SetColumnChunksProcessed(state, test_case.num_columns, test_case.num_row_groups);
+}
+
+static void BM_FileMetaDataWriteTo(::benchmark::State& state) {
+  MetaDataCase test_case(state);
+  std::unique_ptr<FileMetaData> metadata =
+      MakeFileMetaData(&test_case.schema, test_case.num_row_groups);
+
+  int64_t size = 0;
+  while (state.KeepRunning()) {
+    size = SerializeFileMetaData(*metadata)->size();
+  }
+  state.SetBytesProcessed(state.iterations() * size);
+  SetColumnChunksProcessed(state, test_case.num_columns, test_case.num_row_groups);
+}
+
+template <bool lazy>
+static void BM_FileMetaDataMake(::benchmark::State& state) {
+  MetaDataCase test_case(state);
+  std::shared_ptr<Buffer> buffer = SerializeFileMetaData(
+      *MakeFileMetaData(&test_case.schema, test_case.num_row_groups));
+
+  while (state.KeepRunning()) {
+    uint32_t metadata_len = static_cast<uint32_t>(buffer->size());
+    FileMetaData::Make(buffer->data(), &metadata_len, lazy);
+  }
+  state.SetBytesProcessed(state.iterations() * buffer->size());
+  SetColumnChunksProcessed(state, test_case.num_columns, test_case.num_row_groups);
+}
+
+static void MetaDataArguments(::benchmark::internal::Benchmark* b) {
+  for (int num_columns : {10, 100, 1000, 10000, 50000}) {
+    for (int num_row_groups : {1, 10, 100, 1000, 5000}) {
+      if (static_cast<int64_t>(num_columns) * num_row_groups > kMaxColumnChunks) {
+        continue;
+      }
+      for (int nested : {0, 1}) {
+        b->Args({num_columns, num_row_groups, nested});
+      }
+    }
+  }
+}
+
+BENCHMARK(BM_FileMetaDataFinish)->Apply(MetaDataArguments);
+BENCHMARK(BM_FileMetaDataWriteTo)->Apply(MetaDataArguments);
+BENCHMARK_TEMPLATE(BM_FileMetaDataMake, false)->Apply(MetaDataArguments);
+BENCHMARK_TEMPLATE(BM_FileMetaDataMake, true)->Apply(MetaDataArguments);
+
+}  // namespace benchmark
+
+}  // namespace parquet
@@ -16,7 +16,9 @@
 // under the License.
 
 #include <algorithm>
+#include <mutex>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "parquet/exception.h"
@@ -137,6 +139,8 @@ class ColumnChunkMetaData::ColumnChunkMetaDataImpl {
   }
   ~ColumnChunkMetaDataImpl() {}
 
+  const format::ColumnChunk* column_chunk() const { return column_; }
+
   // column chunk
   inline int64_t file_offset() const { return column_->file_offset; }
   inline const std::string& file_path() const { return column_->file_path; }
@@ -164,6 +168,20 @@ class ColumnChunkMetaData::ColumnChunkMetaDataImpl {
                get_sort_order(descr_->logical_type(), descr_->physical_type());
   }
 
+  inline bool has_null_count() const {
+    DCHECK(writer_version_ != nullptr);
+    return column_->meta_data.__isset.statistics &&
+           column_->meta_data.statistics.__isset.null_count &&
+           writer_version_->HasCorrectStatistics(type());
+  }
+
+  inline int64_t null_count() const { return column_->meta_data.statistics.null_count; }
+
+  inline bool has_correct_statistics() const {
+    DCHECK(writer_version_ != nullptr);
+    return writer_version_->HasCorrectStatistics(type());
+  }
+
   inline std::shared_ptr<RowGroupStatistics> statistics() const {
     if (stats_ == nullptr && is_stats_set()) {
       stats_ = MakeColumnStats(column_->meta_data, descr_);
@@ -199,6 +217,41 @@ class ColumnChunkMetaData::ColumnChunkMetaDataImpl {
     return column_->meta_data.total_uncompressed_size;
   }
 
+  inline bool has_column_index() const { return column_->__isset.column_index_offset; }
+
+  inline int64_t column_index_offset() const { return column_->column_index_offset; }
+
+  inline int32_t column_index_length() const { return column_->column_index_length; }
+
+  inline bool has_offset_index() const { return column_->__isset.offset_index_offset; }
+
+  inline int64_t offset_index_offset() const { return column_->offset_index_offset; }
+
+  inline int32_t offset_index_length() const { return column_->offset_index_length; }
+
+  inline bool has_bloom_filter() const {
+    return column_->meta_data.__isset.bloom_filter_offset;
+  }
+
+  inline int64_t bloom_filter_offset() const {
+    return column_->meta_data.bloom_filter_offset;
+  }
+
+  inline int32_t bloom_filter_length() const {
+    return column_->meta_data.__isset.bloom_filter_length
+               ? column_->meta_data.bloom_filter_length
+               : 0;
+  }
+
+  std::shared_ptr<const KeyValueMetadata> key_value_metadata() const {
+    if (!column_->meta_data.__isset.key_value_metadata) return nullptr;
+    auto metadata = std::make_shared<KeyValueMetadata>();
+    for (const auto& it : column_->meta_data.key_value_metadata) {
+      metadata->Append(it.key, it.value);
+    }
+    return metadata;
+  }
+
  private:
   mutable std::shared_ptr<RowGroupStatistics> stats_;
   std::vector<Encoding::type> encodings_;
@@ -242,6 +295,14 @@ std::shared_ptr<RowGroupStatistics> ColumnChunkMetaData::statistics() const {
 
 bool ColumnChunkMetaData::is_stats_set() const { return impl_->is_stats_set(); }
 
+bool ColumnChunkMetaData::has_null_count() const { return impl_->has_null_count(); }
+
+int64_t ColumnChunkMetaData::null_count() const { return impl_->null_count(); }
+
+bool ColumnChunkMetaData::has_correct_statistics() const {
+  return impl_->has_correct_statistics();
+}
+
 int64_t ColumnChunkMetaData::has_dictionary_page() const {
   return impl_->has_dictionary_page();
 }
@@ -274,16 +335,206 @@ int64_t ColumnChunkMetaData::total_compressed_size() const {
   return impl_->total_compressed_size();
 }
 
+bool ColumnChunkMetaData::has_column_index() const { return impl_->has_column_index(); }
+
+int64_t ColumnChunkMetaData::column_index_offset() const {
+  return impl_->column_index_offset();
+}
+
+int32_t ColumnChunkMetaData::column_index_length() const {
+  return impl_->column_index_length();
+}
+
+bool ColumnChunkMetaData::has_offset_index() const { return impl_->has_offset_index(); }
+
+int64_t ColumnChunkMetaData::offset_index_offset() const {
+  return impl_->offset_index_offset();
+}
+
+int32_t ColumnChunkMetaData::offset_index_length() const {
+  return impl_->offset_index_length();
+}
+
+bool ColumnChunkMetaData::has_bloom_filter() const { return impl_->has_bloom_filter(); }
+
+int64_t ColumnChunkMetaData::bloom_filter_offset() const {
+  return impl_->bloom_filter_offset();
+}
+
+int32_t ColumnChunkMetaData::bloom_filter_length() const {
+  return impl_->bloom_filter_length();
+}
+
+std::shared_ptr<const KeyValueMetadata> ColumnChunkMetaData::key_value_metadata() const {
+  return impl_->key_value_metadata();
+}
+
+// ----------------------------------------------------------------------
+// Lazy metadata decoding
+//
+// The elements of the row_groups and columns lists are skipped over while
+// parsing their parent struct; only the byte range of each element is kept
+// and the element is deserialized on first access.
+
+namespace {
+
+using ThriftMemoryBuffer = apache::thrift::transport::TMemoryBuffer;
+
+struct ThriftRange {
+  uint32_t offset;
+  uint32_t length;
+};
+
+// Compact protocol reader over a serialized Thrift struct that knows its
+// position in the serialized bytes
+class ThriftStructReader {
+ public:
+  ThriftStructReader(const uint8_t* data, uint32_t len)
+      : len_(len), transport_(new ThriftMemoryBuffer(const_cast<uint8_t*>(data), len)) {
+    apache::thrift::protocol::TCompactProtocolFactoryT<ThriftMemoryBuffer> factory;
+    protocol_ = factory.getProtocol(transport_);
+  }
+
+  apache::thrift::protocol::TProtocol* protocol() { return protocol_.get(); }
+
+  uint32_t position() const { return len_ - transport_->available_read(); }
+
+  // Skip over a list field, recording the byte range of each element
+  void SkipList(std::vector<ThriftRange>* ranges) {
+    apache::thrift::protocol::TType elem_type;
+    uint32_t size;
+    protocol_->readListBegin(elem_type, size);
+    ranges->reserve(size);
+    for (uint32_t i = 0; i < size; ++i) {
+      uint32_t begin = position();
+      protocol_->skip(elem_type);
+      ranges->push_back({begin, position() - begin});
+    }
+    protocol_->readListEnd();
+  }
+
+  template <typename T>
+  void ReadList(std::vector<T>* out) {
+    apache::thrift::protocol::TType elem_type;
+    uint32_t size;
+    protocol_->readListBegin(elem_type, size);
+    out->resize(size);
+    for (uint32_t i = 0; i < size; ++i) {
+      (*out)[i].read(protocol_.get());
+    }
+    protocol_->readListEnd();
+  }
+
+ private:
+  uint32_t len_;
+  boost::shared_ptr<ThriftMemoryBuffer> transport_;
+  boost::shared_ptr<apache::thrift::protocol::TProtocol> protocol_;
+};
+
+// Calls visit(field_id, field_type) for every field of the struct at the
+// reader's position. visit returns false for the fields it did not consume.
+template <typename VisitField>
+void ReadThriftStruct(ThriftStructReader* reader, VisitField&& visit) {
+  apache::thrift::protocol::TProtocol* proto = reader->protocol();
+  std::string name;
+  apache::thrift::protocol::TType field_type;
+  int16_t field_id;
+  try {
+    proto->readStructBegin(name);
+    while (true) {
+      proto->readFieldBegin(name, field_type, field_id);
+      if (field_type == apache::thrift::protocol::T_STOP) break;
+      if (!visit(field_id, field_type)) {
+        proto->skip(field_type);
+      }
+      proto->readFieldEnd();
+    }
+    proto->readStructEnd();
+  } catch (std::exception& e) {
+    std::stringstream ss;
+    ss << "Couldn't deserialize thrift: " << e.what() << "\n";
+    throw ParquetException(ss.str());
+  }
+}
+
+}  // namespace
+
+// A row group whose column chunks are deserialized on first access. The
+// serialized bytes are owned by the FileMetaData.
+class LazyRowGroup {
+ public:
+  LazyRowGroup(const uint8_t* data, uint32_t len) : data_(data) {
+    using apache::thrift::protocol::T_I64;
+    using apache::thrift::protocol::T_LIST;
+    ThriftStructReader reader(data, len);
+    ReadThriftStruct(&reader, [this, &reader](int16_t id,
+                                              apache::thrift::protocol::TType type) {
+      auto proto = reader.protocol();
+      if (id == 1 && type == T_LIST) {
+        reader.SkipList(&column_ranges_);
+      } else if (id == 2 && type == T_I64) {
+        proto->readI64(row_group_.total_byte_size);
+      } else if (id == 3 && type == T_I64) {
+        proto->readI64(row_group_.num_rows);
+      } else if (id == 4 && type == T_LIST) {
+        reader.ReadList(&row_group_.sorting_columns);
+        row_group_.__isset.sorting_columns = true;
+      } else {
+        return false;
+      }
+      return true;
+    });
+    columns_.resize(column_ranges_.size());
+  }
+
+  // The columns of the returned RowGroup are not populated
+  const format::RowGroup& row_group() const { return row_group_; }
+
+  int num_columns() const { return static_cast<int>(column_ranges_.size()); }
+
+  const format::ColumnChunk* column(int i) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!columns_[i]) {
+      const ThriftRange& range = column_ranges_[i];
+      uint32_t len = range.length;
+      std::unique_ptr<format::ColumnChunk> column(new format::ColumnChunk);
+      DeserializeThriftMsg(data_ + range.offset, &len, column.get());
+      columns_[i] = std::move(column);
+    }
+    return columns_[i].get();
+  }
+
+ private:
+  const uint8_t* data_;
+  format::RowGroup row_group_;
+  std::vector<ThriftRange> column_ranges_;
+  std::vector<std::unique_ptr<format::ColumnChunk>> columns_;
+  std::mutex mutex_;
+};
+
 // row-group metadata
 class RowGroupMetaData::RowGroupMetaDataImpl {
  public:
   explicit RowGroupMetaDataImpl(const format::RowGroup* row_group,
                                 const SchemaDescriptor* schema,
                                 const ApplicationVersion* writer_version)
-      : row_group_(row_group), schema_(schema), writer_version_(writer_version) {}
+      : row_group_(row_group),
+        lazy_row_group_(nullptr),
+        schema_(schema),
+        writer_version_(writer_version) {}
+
+  explicit RowGroupMetaDataImpl(LazyRowGroup* row_group, const SchemaDescriptor* schema,
+                                const ApplicationVersion* writer_version)
+      : row_group_(&row_group->row_group()),
+        lazy_row_group_(row_group),
+        schema_(schema),
+        writer_version_(writer_version) {}
   ~RowGroupMetaDataImpl() {}
 
-  inline int num_columns() const { return static_cast<int>(row_group_->columns.size()); }
+  inline int num_columns() const {
+    if (lazy_row_group_ != nullptr) return lazy_row_group_->num_columns();
+    return static_cast<int>(row_group_->columns.size());
+  }
 
   inline int64_t num_rows() const { return row_group_->num_rows; }
 
@@ -291,6 +542,14 @@ class RowGroupMetaData::RowGroupMetaDataImpl {
 
   inline const SchemaDescriptor* schema() const { return schema_; }
 
+  std::vector<SortingColumn> sorting_columns() const {
+    std::vector<SortingColumn> columns;
+    for (const format::SortingColumn& column : row_group_->sorting_columns) {
+      columns.push_back({column.column_idx, column.descending, column.nulls_first});
+    }
+    return columns;
+  }
+
   std::unique_ptr<ColumnChunkMetaData> ColumnChunk(int i) {
     if (!(i < num_columns())) {
       std::stringstream ss;
@@ -298,13 +557,16 @@ class RowGroupMetaData::RowGroupMetaDataImpl {
          << " columns, requested metadata for column: " << i;
       throw ParquetException(ss.str());
     }
-    return ColumnChunkMetaData::Make(
-        reinterpret_cast<const uint8_t*>(&row_group_->columns[i]), schema_->Column(i),
-        writer_version_);
+    const format::ColumnChunk* column = lazy_row_group_ != nullptr
+                                            ? lazy_row_group_->column(i)
+                                            : &row_group_->columns[i];
+    return ColumnChunkMetaData::Make(reinterpret_cast<const uint8_t*>(column),
+                                     schema_->Column(i), writer_version_);
   }
 
  private:
   const format::RowGroup* row_group_;
+  LazyRowGroup* lazy_row_group_;
   const SchemaDescriptor* schema_;
   const ApplicationVersion* writer_version_;
 };
@@ -322,6 +584,9 @@ RowGroupMetaData::RowGroupMetaData(const uint8_t* metadata,
     : impl_{std::unique_ptr<RowGroupMetaDataImpl>(new RowGroupMetaDataImpl(
           reinterpret_cast<const format::RowGroup*>(metadata), schema, writer_version))} {
 }
+
+RowGroupMetaData::RowGroupMetaData(std::unique_ptr<RowGroupMetaDataImpl> impl)
+    : impl_(std::move(impl)) {}
 RowGroupMetaData::~RowGroupMetaData() {}
 
 int RowGroupMetaData::num_columns() const { return impl_->num_columns(); }
@@ -332,6 +597,10 @@ int64_t RowGroupMetaData::total_byte_size() const { return impl_->total_byte_siz
 
 const SchemaDescriptor* RowGroupMetaData::schema() const { return impl_->schema(); }
 
+std::vector<SortingColumn> RowGroupMetaData::sorting_columns() const {
+  return impl_->sorting_columns();
+}
+
 std::unique_ptr<ColumnChunkMetaData> RowGroupMetaData::ColumnChunk(int i) const {
   return impl_->ColumnChunk(i);
 }
@@ -339,12 +608,16 @@ std::unique_ptr<ColumnChunkMetaData> RowGroupMetaData::ColumnChunk(int i) const
 // file metadata
 class FileMetaData::FileMetaDataImpl {
  public:
-  FileMetaDataImpl() : metadata_len_(0) {}
+  FileMetaDataImpl() : metadata_len_(0), lazy_(false) {}
 
-  explicit FileMetaDataImpl(const uint8_t* metadata, uint32_t* metadata_len)
-      : metadata_len_(0) {
+  explicit FileMetaDataImpl(const uint8_t* metadata, uint32_t* metadata_len, bool lazy)
+      : metadata_len_(0), lazy_(lazy) {
     metadata_.reset(new format::FileMetaData);
-    DeserializeThriftMsg(metadata, metadata_len, metadata_.get());
+    if (lazy_) {
+      DeserializeLazily(metadata, metadata_len);
+    } else {
+      DeserializeThriftMsg(metadata, metadata_len, metadata_.get());
+    }
     metadata_len_ = *metadata_len;
 
     if (metadata_->__isset.created_by) {
@@ -362,6 +635,7 @@ class FileMetaData::FileMetaDataImpl {
   inline int num_columns() const { return schema_.num_columns(); }
   inline int64_t num_rows() const { return metadata_->num_rows; }
   inline int num_row_groups() const {
+    if (lazy_) return static_cast<int>(row_group_ranges_.size());
     return static_cast<int>(metadata_->row_groups.size());
   }
   inline int32_t version() const { return metadata_->version; }
@@ -372,7 +646,15 @@ class FileMetaData::FileMetaDataImpl {
 
   const ApplicationVersion& writer_version() const { return writer_version_; }
 
-  void WriteTo(OutputStream* dst) { SerializeThriftMsg(metadata_.get(), 1024, dst); }
+  void WriteTo(OutputStream* dst) {
+    if (lazy_) {
+      // The row groups were never decoded, write back the original bytes
+      dst->Write(reinterpret_cast<const uint8_t*>(serialized_.data()),
+                 static_cast<int64_t>(serialized_.size()));
+      return;
+    }
+    SerializeThriftMsg(metadata_.get(), 1024, dst);
+  }
 
   std::unique_ptr<RowGroupMetaData> RowGroup(int i) {
     if (!(i < num_row_groups())) {
@@ -381,6 +663,12 @@ class FileMetaData::FileMetaDataImpl {
          << " row groups, requested metadata for row group: " << i;
       throw ParquetException(ss.str());
     }
+    if (lazy_) {
+      return std::unique_ptr<RowGroupMetaData>(
+          new RowGroupMetaData(std::unique_ptr<RowGroupMetaData::RowGroupMetaDataImpl>(
+              new RowGroupMetaData::RowGroupMetaDataImpl(GetLazyRowGroup(i), &schema_,
+                                                         &writer_version_))));
+    }
     return RowGroupMetaData::Make(
         reinterpret_cast<const uint8_t*>(&metadata_->row_groups[i]), &schema_,
         &writer_version_);
@@ -392,10 +680,134 @@ class FileMetaData::FileMetaDataImpl {
     return key_value_metadata_;
   }
 
+  void AppendRowGroups(FileMetaDataImpl* other, const std::string& file_path) {
+    if (lazy_) {
+      throw ParquetException("Cannot append row groups to lazily decoded metadata");
+    }
+    if (!schema_.Equals(other->schema_)) {
+      throw ParquetException("AppendRowGroups requires the same schema");
+    }
+    // Other may be this metadata
+    const int num_row_groups = other->num_row_groups();
+    for (int i = 0; i < num_row_groups; ++i) {
+      format::RowGroup row_group = other->ThriftRowGroup(i);
+      if (!file_path.empty()) {
+        for (auto& column : row_group.columns) {
+          column.__set_file_path(file_path);
+        }
+      }
+      metadata_->num_rows += row_group.num_rows;
+      metadata_->row_groups.push_back(std::move(row_group));
+    }
+  }
+
+  std::unique_ptr<FileMetaDataImpl> Subset(const std::vector<int>& row_groups) {
+    std::unique_ptr<FileMetaDataImpl> result(new FileMetaDataImpl());
+    // Copy all fields but the row groups, which may be many
+    result->metadata_.reset(new format::FileMetaData);
+    format::FileMetaData* md = result->metadata_.get();
+    md->__set_version(metadata_->version);
+    md->__set_schema(metadata_->schema);
+    md->__set_num_rows(0);
+    if (metadata_->__isset.key_value_metadata) {
+      md->__set_key_value_metadata(metadata_->key_value_metadata);
+    }
+    if (metadata_->__isset.created_by) {
+      md->__set_created_by(metadata_->created_by);
+    }
+    if (metadata_->__isset.column_orders) {
+      md->__set_column_orders(metadata_->column_orders);
+    }
+    for (int i : row_groups) {
+      if (i < 0 || i >= num_row_groups()) {
+        std::stringstream ss;
+        ss << "The file only has " << num_row_groups()
+           << " row groups, requested metadata for row group: " << i;
+        throw ParquetException(ss.str());
+      }
+      md->row_groups.push_back(ThriftRowGroup(i));
+      md->num_rows += md->row_groups.back().num_rows;
+    }
+    result->writer_version_ = writer_version_;
+    result->InitSchema();
+    result->InitKeyValueMetadata();
+    return result;
+  }
+
  private:
   friend FileMetaDataBuilder;
+
+  // A copy of the i-th row group, with all its column chunks
+  format::RowGroup ThriftRowGroup(int i) {
+    if (!lazy_) {
+      return metadata_->row_groups[i];
+    }
+    LazyRowGroup* lazy_row_group = GetLazyRowGroup(i);
+    format::RowGroup result = lazy_row_group->row_group();
+    for (int j = 0; j < lazy_row_group->num_columns(); ++j) {
+      result.columns.push_back(*lazy_row_group->column(j));
+    }
+    return result;
+  }
+
   uint32_t metadata_len_;
   std::unique_ptr<format::FileMetaData> metadata_;
+
+  // Lazy mode: metadata_ holds everything but the row groups, which are
+  // decoded from serialized_ on first access
+  bool lazy_;
+  std::string serialized_;
+  std::vector<ThriftRange> row_group_ranges_;
+  std::vector<std::unique_ptr<LazyRowGroup>> row_groups_;
+  std::mutex row_groups_mutex_;
+
+  void DeserializeLazily(const uint8_t* metadata, uint32_t* metadata_len) {
+    using apache::thrift::protocol::T_I32;
+    using apache::thrift::protocol::T_I64;
+    using apache::thrift::protocol::T_LIST;
+    using apache::thrift::protocol::T_STRING;
+    format::FileMetaData* md = metadata_.get();
+    ThriftStructReader reader(metadata, *metadata_len);
+    ReadThriftStruct(&reader, [this, md, &reader](int16_t id,
+                                                  apache::thrift::protocol::TType type) {
+      auto proto = reader.protocol();
+      if (id == 1 && type == T_I32) {
+        proto->readI32(md->version);
+      } else if (id == 2 && type == T_LIST) {
+        reader.ReadList(&md->schema);
+      } else if (id == 3 && type == T_I64) {
+        proto->readI64(md->num_rows);
+      } else if (id == 4 && type == T_LIST) {
+        reader.SkipList(&row_group_ranges_);
+      } else if (id == 5 && type == T_LIST) {
+        reader.ReadList(&md->key_value_metadata);
+        md->__isset.key_value_metadata = true;
+      } else if (id == 6 && type == T_STRING) {
+        proto->readString(md->created_by);
+        md->__isset.created_by = true;
+      } else if (id == 7 && type == T_LIST) {
+        reader.ReadList(&md->column_orders);
+        md->__isset.column_orders = true;
+      } else {
+        return false;
+      }
+      return true;
+    });
+    *metadata_len = reader.position();
+    serialized_.assign(reinterpret_cast<const char*>(metadata), *metadata_len);
+    row_groups_.resize(row_group_ranges_.size());
+  }
+
+  LazyRowGroup* GetLazyRowGroup(int i) {
+    std::lock_guard<std::mutex> lock(row_groups_mutex_);
+    if (!row_groups_[i]) {
+      const ThriftRange& range = row_group_ranges_[i];
+      row_groups_[i].reset(new LazyRowGroup(
+          reinterpret_cast<const uint8_t*>(serialized_.data()) + range.offset,
+          range.length));
+    }
+    return row_groups_[i].get();
+  }
   void InitSchema() {
     schema::FlatSchemaConverter converter(&metadata_->schema[0],
                                           static_cast<int>(metadata_->schema.size()));
@@ -419,14 +831,14 @@ class FileMetaData::FileMetaDataImpl {
 };
 
 std::shared_ptr<FileMetaData> FileMetaData::Make(const uint8_t* metadata,
-                                                 uint32_t* metadata_len) {
+                                                 uint32_t* metadata_len, bool lazy) {
   // This FileMetaData ctor is private, not compatible with std::make_shared
-  return std::shared_ptr<FileMetaData>(new FileMetaData(metadata, metadata_len));
+  return std::shared_ptr<FileMetaData>(new FileMetaData(metadata, metadata_len, lazy));
 }
 
-FileMetaData::FileMetaData(const uint8_t* metadata, uint32_t* metadata_len)
+FileMetaData::FileMetaData(const uint8_t* metadata, uint32_t* metadata_len, bool lazy)
     : impl_{std::unique_ptr<FileMetaDataImpl>(
-          new FileMetaDataImpl(metadata, metadata_len))} {}
+          new FileMetaDataImpl(metadata, metadata_len, lazy))} {}
 
 FileMetaData::FileMetaData()
     : impl_{std::unique_ptr<FileMetaDataImpl>(new FileMetaDataImpl())} {}
@@ -472,7 +884,19 @@ std::shared_ptr<const KeyValueMetadata> FileMetaData::key_value_metadata() const
   return impl_->key_value_metadata();
 }
 
-void FileMetaData::WriteTo(OutputStream* dst) { return impl_->WriteTo(dst); }
+void FileMetaData::WriteTo(OutputStream* dst) const { return impl_->WriteTo(dst); }
+
+void FileMetaData::AppendRowGroups(const FileMetaData& other,
+                                   const std::string& file_path) {
+  impl_->AppendRowGroups(other.impl_.get(), file_path);
+}
+
+std::shared_ptr<FileMetaData> FileMetaData::Subset(
+    const std::vector<int>& row_groups) const {
+  std::shared_ptr<FileMetaData> result(new FileMetaData());
+  result->impl_ = impl_->Subset(row_groups);
+  return result;
+}
 
 ApplicationVersion::ApplicationVersion(const std::string& created_by) {
   boost::regex app_regex{ApplicationVersion::APPLICATION_FORMAT};
@@ -564,7 +988,7 @@ class ColumnChunkMetaDataBuilder::ColumnChunkMetaDataBuilderImpl {
   explicit ColumnChunkMetaDataBuilderImpl(const std::shared_ptr<WriterProperties>& props,
                                           const ColumnDescriptor* column,
                                           uint8_t* contents)
-      : properties_(props), column_(column) {
+      : properties_(props), column_(column), has_encodings_(false) {
     column_chunk_ = reinterpret_cast<format::ColumnChunk*>(contents);
     column_chunk_->meta_data.__set_type(ToThrift(column->physical_type()));
     column_chunk_->meta_data.__set_path_in_schema(column->path()->ToDotVector());
@@ -607,6 +1031,10 @@ class ColumnChunkMetaDataBuilder::ColumnChunkMetaDataBuilderImpl {
     column_chunk_->meta_data.__set_data_page_offset(data_page_offset);
     column_chunk_->meta_data.__set_total_uncompressed_size(uncompressed_size);
     column_chunk_->meta_data.__set_total_compressed_size(compressed_size);
+    if (has_encodings_) {
+      column_chunk_->meta_data.__set_encodings(encodings_);
+      return;
+    }
     std::vector<format::Encoding::type> thrift_encodings;
     if (has_dictionary) {
       thrift_encodings.push_back(ToThrift(properties_->dictionary_index_encoding()));
@@ -619,10 +1047,8 @@ class ColumnChunkMetaDataBuilder::ColumnChunkMetaDataBuilderImpl {
       thrift_encodings.push_back(ToThrift(properties_->encoding(column_->path())));
     }
     thrift_encodings.push_back(ToThrift(Encoding::RLE));
-    // Only PLAIN encoding is supported for fallback in V1
-    // TODO(majetideepak): Use user specified encoding for V2
     if (dictionary_fallback) {
-      thrift_encodings.push_back(ToThrift(Encoding::PLAIN));
+      thrift_encodings.push_back(ToThrift(properties_->encoding(column_->path())));
     }
     column_chunk_->meta_data.__set_encodings(thrift_encodings);
   }
@@ -631,12 +1057,82 @@ class ColumnChunkMetaDataBuilder::ColumnChunkMetaDataBuilderImpl {
     SerializeThriftMsg(column_chunk_, sizeof(format::ColumnChunk), sink);
   }
 
+  void SetColumnIndexLocation(int64_t offset, int32_t length) {
+    column_chunk_->__set_column_index_offset(offset);
+    column_chunk_->__set_column_index_length(length);
+  }
+
+  void SetOffsetIndexLocation(int64_t offset, int32_t length) {
+    column_chunk_->__set_offset_index_offset(offset);
+    column_chunk_->__set_offset_index_length(length);
+  }
+
+  void SetBloomFilterLocation(int64_t offset, int32_t length) {
+    column_chunk_->meta_data.__set_bloom_filter_offset(offset);
+    column_chunk_->meta_data.__set_bloom_filter_length(length);
+  }
+
+  void AddKeyValueMetadata(const std::string& key, const std::string& value) {
+    format::KeyValue kv_pair;
+    kv_pair.__set_key(key);
+    kv_pair.__set_value(value);
+    column_chunk_->meta_data.key_value_metadata.push_back(kv_pair);
+    column_chunk_->meta_data.__isset.key_value_metadata = true;
+  }
+
+  void SetEncodings(const std::vector<Encoding::type>& encodings) {
+    encodings_.clear();
+    for (Encoding::type encoding : encodings) {
+      encodings_.push_back(ToThrift(encoding));
+    }
+    has_encodings_ = true;
+  }
+
+  void CopyFrom(const format::ColumnChunk& source, int64_t chunk_offset,
+                bool keep_statistics) {
+    *column_chunk_ = source;
+    format::ColumnMetaData& meta_data = column_chunk_->meta_data;
+    // Statistics the reader would not trust coming from the source's writer
+    // would be trusted coming from this one
+    if (!keep_statistics) {
+      meta_data.__isset.statistics = false;
+    }
+    int64_t source_offset = meta_data.data_page_offset;
+    if (meta_data.__isset.dictionary_page_offset &&
+        meta_data.dictionary_page_offset < source_offset) {
+      source_offset = meta_data.dictionary_page_offset;
+    }
+    int64_t delta = chunk_offset - source_offset;
+
+    column_chunk_->__isset.file_path = false;
+    column_chunk_->file_path.clear();
+    // The chunk metadata is written right after the chunk
+    column_chunk_->__set_file_offset(chunk_offset + meta_data.total_compressed_size);
+    meta_data.__set_data_page_offset(meta_data.data_page_offset + delta);
+    if (meta_data.__isset.dictionary_page_offset) {
+      meta_data.__set_dictionary_page_offset(meta_data.dictionary_page_offset + delta);
+    }
+    if (meta_data.index_page_offset > 0) {
+      meta_data.__set_index_page_offset(meta_data.index_page_offset + delta);
+    }
+
+    meta_data.__isset.bloom_filter_offset = false;
+    meta_data.__isset.bloom_filter_length = false;
+    column_chunk_->__isset.offset_index_offset = false;
+    column_chunk_->__isset.offset_index_length = false;
+    column_chunk_->__isset.column_index_offset = false;
+    column_chunk_->__isset.column_index_length = false;
+  }
+
   const ColumnDescriptor* descr() const { return column_; }
 
  private:
   format::ColumnChunk* column_chunk_;
   const std::shared_ptr<WriterProperties> properties_;
   const ColumnDescriptor* column_;
+  // Set by SetEncodings
+  bool has_encodings_;
+  std::vector<format::Encoding::type> encodings_;
 };
 
 std::unique_ptr<ColumnChunkMetaDataBuilder> ColumnChunkMetaDataBuilder::Make(
@@ -670,6 +1166,34 @@ void ColumnChunkMetaDataBuilder::Finish(int64_t num_values,
 
 void ColumnChunkMetaDataBuilder::WriteTo(OutputStream* sink) { impl_->WriteTo(sink); }
 
+void ColumnChunkMetaDataBuilder::SetColumnIndexLocation(int64_t offset, int32_t length) {
+  impl_->SetColumnIndexLocation(offset, length);
+}
+
+void ColumnChunkMetaDataBuilder::SetOffsetIndexLocation(int64_t offset, int32_t length) {
+  impl_->SetOffsetIndexLocation(offset, length);
+}
+
+void ColumnChunkMetaDataBuilder::SetEncodings(
+    const std::vector<Encoding::type>& encodings) {
+  impl_->SetEncodings(encodings);
+}
+
+void ColumnChunkMetaDataBuilder::CopyFrom(const ColumnChunkMetaData& source,
+                                          int64_t chunk_offset) {
+  impl_->CopyFrom(*source.impl_->column_chunk(), chunk_offset,
+                  source.is_stats_set());
+}
+
+void ColumnChunkMetaDataBuilder::SetBloomFilterLocation(int64_t offset, int32_t length) {
+  impl_->SetBloomFilterLocation(offset, length);
+}
+
+void ColumnChunkMetaDataBuilder::AddKeyValueMetadata(const std::string& key,
+                                                     const std::string& value) {
+  impl_->AddKeyValueMetadata(key, value);
+}
+
 const ColumnDescriptor* ColumnChunkMetaDataBuilder::descr() const {
   return impl_->descr();
 }
@@ -687,6 +1211,9 @@ class RowGroupMetaDataBuilder::RowGroupMetaDataBuilderImpl {
     row_group_ = reinterpret_cast<format::RowGroup*>(contents);
     InitializeColumns(schema->num_columns());
     row_group_->__set_num_rows(num_rows);
+    if (!props->sorting_columns().empty()) {
+      set_sorting_columns(props->sorting_columns());
+    }
   }
   ~RowGroupMetaDataBuilderImpl() {}
 
@@ -708,6 +1235,27 @@ class RowGroupMetaDataBuilder::RowGroupMetaDataBuilderImpl {
 
   int current_column() { return current_column_; }
 
+  void set_num_rows(int64_t num_rows) { row_group_->__set_num_rows(num_rows); }
+
+  void set_sorting_columns(const std::vector<SortingColumn>& columns) {
+    std::vector<format::SortingColumn> thrift_columns;
+    for (const SortingColumn& column : columns) {
+      if (column.column_index < 0 || column.column_index >= schema_->num_columns()) {
+        std::stringstream ss;
+        ss << "Sorting column " << column.column_index << " but the schema only has "
+           << schema_->num_columns() << " columns";
+        throw ParquetException(ss.str());
+      }
+      format::SortingColumn thrift_column;
+      thrift_column.__set_column_idx(column.column_index);
+      thrift_column.__set_descending(column.descending);
+      thrift_column.__set_nulls_first(column.nulls_first);
+      thrift_columns.push_back(thrift_column);
+    }
+    row_group_->__set_sorting_columns(thrift_columns);
+    row_group_->__isset.sorting_columns = !thrift_columns.empty();
+  }
+
   void Finish(int64_t total_bytes_written) {
     if (!(current_column_ == schema_->num_columns())) {
       std::stringstream ss;
@@ -766,6 +1314,15 @@ int RowGroupMetaDataBuilder::current_column() const { return impl_->current_colu
 
 int RowGroupMetaDataBuilder::num_columns() { return impl_->num_columns(); }
 
+void RowGroupMetaDataBuilder::set_num_rows(int64_t num_rows) {
+  impl_->set_num_rows(num_rows);
+}
+
+void RowGroupMetaDataBuilder::set_sorting_columns(
+    const std::vector<SortingColumn>& columns) {
+  impl_->set_sorting_columns(columns);
+}
+
 void RowGroupMetaDataBuilder::Finish(int64_t total_bytes_written) {
   impl_->Finish(total_bytes_written);
 }
@@ -792,6 +1349,16 @@ class FileMetaDataBuilder::FileMetaDataBuilderImpl {
     return row_group_ptr;
   }
 
+  void RemoveRowGroup(RowGroupMetaDataBuilder* row_group) {
+    for (size_t i = 0; i < row_group_builders_.size(); ++i) {
+      if (row_group_builders_[i].get() == row_group) {
+        row_group_builders_.erase(row_group_builders_.begin() + i);
+        row_groups_.erase(row_groups_.begin() + i);
+        return;
+      }
+    }
+  }
+
   std::unique_ptr<FileMetaData> Finish() {
     int64_t total_rows = 0;
     std::vector<format::RowGroup> row_groups;
@@ -801,6 +1368,16 @@ class FileMetaDataBuilder::FileMetaDataBuilderImpl {
       row_groups.push_back(rowgroup);
       total_rows += rowgroup.num_rows;
     }
+    // Concurrent row groups are appended to the file as they are closed, list
+    // all row groups in the order of their chunks in the file
+    auto file_offset = [](const format::RowGroup& row_group) {
+      return row_group.columns.empty() ? 0 : row_group.columns[0].file_offset;
+    };
+    std::stable_sort(
+        row_groups.begin(), row_groups.end(),
+        [&file_offset](const format::RowGroup& a, const format::RowGroup& b) {
+          return file_offset(a) < file_offset(b);
+        });
     metadata_->__set_num_rows(total_rows);
     metadata_->__set_row_groups(row_groups);
 
@@ -869,6 +1446,10 @@ RowGroupMetaDataBuilder* FileMetaDataBuilder::AppendRowGroup(int64_t num_rows) {
   return impl_->AppendRowGroup(num_rows);
 }
 
+void FileMetaDataBuilder::RemoveRowGroup(RowGroupMetaDataBuilder* row_group) {
+  impl_->RemoveRowGroup(row_group);
+}
+
 std::unique_ptr<FileMetaData> FileMetaDataBuilder::Finish() { return impl_->Finish(); }
 
 }  // namespace parquet
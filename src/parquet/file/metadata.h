@@ -46,6 +46,10 @@ using KeyValueMetadata = ::arrow::KeyValueMetadata;
 // See PARQUET-686.
 enum SortOrder { SIGNED, UNSIGNED, UNKNOWN };
 
+// Return the SortOrder of a column using its logical or physical type
+PARQUET_EXPORT
+SortOrder get_sort_order(LogicalType::type converted, Type::type primitive);
+
 class ApplicationVersion {
  public:
   // Known Versions with Issues
@@ -114,6 +118,14 @@ class PARQUET_EXPORT ColumnChunkMetaData {
   std::shared_ptr<schema::ColumnPath> path_in_schema() const;
   bool is_stats_set() const;
   std::shared_ptr<RowGroupStatistics> statistics() const;
+  // Whether the statistics hold the number of levels of the chunk that are
+  // not values, which does not depend on the sort order of the column
+  bool has_null_count() const;
+  int64_t null_count() const;
+  // Whether the writer of the file computed the statistics of the chunk and
+  // of its pages correctly for its type, see
+  // ApplicationVersion::HasCorrectStatistics
+  bool has_correct_statistics() const;
   Compression::type compression() const;
   const std::vector<Encoding::type>& encodings() const;
   int64_t has_dictionary_page() const;
@@ -122,8 +134,23 @@ class PARQUET_EXPORT ColumnChunkMetaData {
   int64_t index_page_offset() const;
   int64_t total_compressed_size() const;
   int64_t total_uncompressed_size() const;
+  // page index, see file/page_index.h
+  bool has_column_index() const;
+  int64_t column_index_offset() const;
+  int32_t column_index_length() const;
+  bool has_offset_index() const;
+  int64_t offset_index_offset() const;
+  int32_t offset_index_length() const;
+  // Bloom filter, see bloom_filter.h. The length is 0 if the writer did not
+  // record it
+  bool has_bloom_filter() const;
+  int64_t bloom_filter_offset() const;
+  int32_t bloom_filter_length() const;
+  // Key-value metadata of the column chunk, nullptr if there is none
+  std::shared_ptr<const KeyValueMetadata> key_value_metadata() const;
 
  private:
+  friend class ColumnChunkMetaDataBuilder;
   explicit ColumnChunkMetaData(const uint8_t* metadata, const ColumnDescriptor* descr,
                                const ApplicationVersion* writer_version = NULL);
   // PIMPL Idiom
@@ -147,12 +174,17 @@ class PARQUET_EXPORT RowGroupMetaData {
   // Return const-pointer to make it clear that this object is not to be copied
   const SchemaDescriptor* schema() const;
   std::unique_ptr<ColumnChunkMetaData> ColumnChunk(int i) const;
+  // The columns by which the rows are sorted, the first one taking precedence.
+  // Empty if the writer did not declare any.
+  std::vector<SortingColumn> sorting_columns() const;
 
  private:
+  friend class FileMetaData;
   explicit RowGroupMetaData(const uint8_t* metadata, const SchemaDescriptor* schema,
                             const ApplicationVersion* writer_version = NULL);
   // PIMPL Idiom
   class RowGroupMetaDataImpl;
+  explicit RowGroupMetaData(std::unique_ptr<RowGroupMetaDataImpl> impl);
   std::unique_ptr<RowGroupMetaDataImpl> impl_;
 };
 
@@ -161,8 +193,13 @@ class FileMetaDataBuilder;
 class PARQUET_EXPORT FileMetaData {
  public:
   // API convenience to get a MetaData accessor
+  //
+  // If lazy is true, only the file-level fields are decoded up front. The
+  // metadata of a row group is decoded when it is first accessed, and the
+  // metadata of a column chunk when RowGroupMetaData::ColumnChunk() first
+  // asks for it, which keeps opening very wide files cheap.
   static std::shared_ptr<FileMetaData> Make(const uint8_t* serialized_metadata,
-                                            uint32_t* metadata_len);
+                                            uint32_t* metadata_len, bool lazy = false);
 
   ~FileMetaData();
 
@@ -178,16 +215,26 @@ class PARQUET_EXPORT FileMetaData {
 
   const ApplicationVersion& writer_version() const;
 
-  void WriteTo(OutputStream* dst);
+  void WriteTo(OutputStream* dst) const;
 
   // Return const-pointer to make it clear that this object is not to be copied
   const SchemaDescriptor* schema() const;
 
   std::shared_ptr<const KeyValueMetadata> key_value_metadata() const;
 
+  // Append the row groups of other, which must have the same schema. If
+  // file_path is not empty, the column chunks of the appended row groups
+  // refer to the file at that path, as in the _metadata summary file of a
+  // dataset. Not supported for lazily decoded metadata.
+  void AppendRowGroups(const FileMetaData& other, const std::string& file_path = "");
+
+  // A copy of the metadata with only the indicated row groups
+  std::shared_ptr<FileMetaData> Subset(const std::vector<int>& row_groups) const;
+
  private:
   friend FileMetaDataBuilder;
-  explicit FileMetaData(const uint8_t* serialized_metadata, uint32_t* metadata_len);
+  explicit FileMetaData(const uint8_t* serialized_metadata, uint32_t* metadata_len,
+                        bool lazy);
 
   // PIMPL Idiom
   FileMetaData();
@@ -221,6 +268,26 @@ class PARQUET_EXPORT ColumnChunkMetaDataBuilder {
   // For writing metadata at end of column chunk
   void WriteTo(OutputStream* sink);
 
+  // Record where the page index of the chunk was written. These are only
+  // known once the chunk itself has been written, so they may be set after
+  // Finish
+  void SetColumnIndexLocation(int64_t offset, int32_t length);
+  void SetOffsetIndexLocation(int64_t offset, int32_t length);
+  void SetBloomFilterLocation(int64_t offset, int32_t length);
+
+  void AddKeyValueMetadata(const std::string& key, const std::string& value);
+
+  // Record these encodings in Finish instead of the ones derived from the
+  // writer properties, for chunks whose pages were not encoded by the writer
+  void SetEncodings(const std::vector<Encoding::type>& encodings);
+
+  // Take the metadata of a column chunk of another file whose bytes were
+  // copied verbatim to chunk_offset, instead of calling Finish. The page
+  // offsets are moved along, while the locations of the page index and of the
+  // Bloom filter, which are stored apart from the chunk, are cleared. So are
+  // the statistics if the source's writer is known to get them wrong.
+  void CopyFrom(const ColumnChunkMetaData& source, int64_t chunk_offset);
+
  private:
   explicit ColumnChunkMetaDataBuilder(const std::shared_ptr<WriterProperties>& props,
                                       const ColumnDescriptor* column, uint8_t* contents);
@@ -242,6 +309,13 @@ class PARQUET_EXPORT RowGroupMetaDataBuilder {
   int num_columns();
   int current_column() const;
 
+  // Set the number of rows of a row group that was started without knowing it
+  void set_num_rows(int64_t num_rows);
+
+  // Replace the sorting columns taken from the writer properties, e.g. with
+  // those of a copied row group
+  void set_sorting_columns(const std::vector<SortingColumn>& columns);
+
   // commit the metadata
   void Finish(int64_t total_bytes_written);
 
@@ -265,6 +339,9 @@ class PARQUET_EXPORT FileMetaDataBuilder {
 
   RowGroupMetaDataBuilder* AppendRowGroup(int64_t num_rows);
 
+  // Drop a row group that will not be written, along with its builder
+  void RemoveRowGroup(RowGroupMetaDataBuilder* row_group);
+
   // commit the metadata
   std::unique_ptr<FileMetaData> Finish();
 
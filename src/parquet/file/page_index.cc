@@ -0,0 +1,130 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+#include "parquet/file/page_index.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include "parquet/exception.h"
+#include "parquet/file/metadata.h"
+#include "parquet/parquet_types.h"
+#include "parquet/statistics.h"
+#include "parquet/thrift.h"
+#include "parquet/util/comparison.h"
+
+namespace parquet {
+
+// ----------------------------------------------------------------------
+// OffsetIndex
+
+std::unique_ptr<OffsetIndex> OffsetIndex::Make(const uint8_t* serialized_index,
+                                               uint32_t* len) {
+  format::OffsetIndex index;
+  DeserializeThriftMsg(serialized_index, len, &index);
+
+  std::vector<PageLocation> page_locations;
+  page_locations.reserve(index.page_locations.size());
+  for (const format::PageLocation& location : index.page_locations) {
+    page_locations.push_back(
+        {location.offset, location.compressed_page_size, location.first_row_index});
+  }
+  return std::unique_ptr<OffsetIndex>(new OffsetIndex(page_locations));
+}
+
+OffsetIndex::OffsetIndex(const std::vector<PageLocation>& page_locations)
+    : page_locations_(page_locations) {}
+
+int OffsetIndex::FindPage(int64_t row) const {
+  // First page starting after the row
+  auto it = std::upper_bound(
+      page_locations_.begin(), page_locations_.end(), row,
+      [](int64_t row, const PageLocation& page) { return row < page.first_row_index; });
+  return static_cast<int>(it - page_locations_.begin()) - 1;
+}
+
+// ----------------------------------------------------------------------
+// ColumnIndex
+
+std::unique_ptr<ColumnIndex> ColumnIndex::Make(const ColumnDescriptor* descr,
+                                               const uint8_t* serialized_index,
+                                               uint32_t* len) {
+  format::ColumnIndex index;
+  DeserializeThriftMsg(serialized_index, len, &index);
+
+  size_t num_pages = index.null_pages.size();
+  if (index.min_values.size() != num_pages || index.max_values.size() != num_pages ||
+      (index.__isset.null_counts && index.null_counts.size() != num_pages)) {
+    throw ParquetException("Corrupt ColumnIndex: list lengths do not match");
+  }
+
+  std::unique_ptr<ColumnIndex> result(new ColumnIndex(descr));
+  result->null_pages_ = index.null_pages;
+  result->min_values_ = std::move(index.min_values);
+  result->max_values_ = std::move(index.max_values);
+  if (index.__isset.null_counts) {
+    result->null_counts_ = std::move(index.null_counts);
+  }
+  result->boundary_order_ = static_cast<BoundaryOrder::type>(index.boundary_order);
+  return result;
+}
+
+template <typename DType>
+std::vector<int> ColumnIndex::FindPages(const typename DType::c_type& min,
+                                        const typename DType::c_type& max) const {
+  if (DType::type_num != descr_->physical_type()) {
+    std::stringstream ss;
+    ss << "ColumnIndex of a " << TypeToString(descr_->physical_type())
+       << " column searched with a " << TypeToString(DType::type_num) << " range";
+    throw ParquetException(ss.str());
+  }
+
+  std::vector<int> pages;
+  bool signed_order = get_sort_order(descr_->logical_type(), descr_->physical_type()) ==
+                      SortOrder::SIGNED;
+  Compare<typename DType::c_type> less(descr_);
+  for (int i = 0; i < num_pages(); ++i) {
+    if (null_pages_[i]) {
+      continue;
+    }
+    if (signed_order) {
+      TypedRowGroupStatistics<DType> page_stats(descr_, min_values_[i], max_values_[i],
+                                                0, 0, 0, true);
+      if (less(page_stats.max(), min) || less(max, page_stats.min())) {
+        continue;
+      }
+    }
+    pages.push_back(i);
+  }
+  return pages;
+}
+
+#define COLUMN_INDEX_FIND_PAGES_INSTANTIATION(DType)                     \
+  template PARQUET_EXPORT std::vector<int> ColumnIndex::FindPages<DType>( \
+      const DType::c_type& min, const DType::c_type& max) const
+
+COLUMN_INDEX_FIND_PAGES_INSTANTIATION(BooleanType);
+COLUMN_INDEX_FIND_PAGES_INSTANTIATION(Int32Type);
+COLUMN_INDEX_FIND_PAGES_INSTANTIATION(Int64Type);
+COLUMN_INDEX_FIND_PAGES_INSTANTIATION(Int96Type);
+COLUMN_INDEX_FIND_PAGES_INSTANTIATION(FloatType);
+COLUMN_INDEX_FIND_PAGES_INSTANTIATION(DoubleType);
+COLUMN_INDEX_FIND_PAGES_INSTANTIATION(ByteArrayType);
+COLUMN_INDEX_FIND_PAGES_INSTANTIATION(FLBAType);
+
+#undef COLUMN_INDEX_FIND_PAGES_INSTANTIATION
+
+}  // namespace parquet
@@ -0,0 +1,110 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+#ifndef PARQUET_FILE_PAGE_INDEX_H
+#define PARQUET_FILE_PAGE_INDEX_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "parquet/schema.h"
+#include "parquet/types.h"
+#include "parquet/util/visibility.h"
+
+namespace parquet {
+
+struct BoundaryOrder {
+  enum type { UNORDERED = 0, ASCENDING = 1, DESCENDING = 2 };
+};
+
+struct PARQUET_EXPORT PageLocation {
+  // Offset of the page header in the file
+  int64_t offset;
+  // Size of the page, including its header
+  int32_t compressed_page_size;
+  // Index within the row group of the first row of the page
+  int64_t first_row_index;
+};
+
+// The locations of the data pages of a column chunk. With it the page holding
+// a given row can be read directly, without going through the headers of the
+// pages that precede it.
+class PARQUET_EXPORT OffsetIndex {
+ public:
+  static std::unique_ptr<OffsetIndex> Make(const uint8_t* serialized_index,
+                                           uint32_t* len);
+
+  explicit OffsetIndex(const std::vector<PageLocation>& page_locations);
+
+  int num_pages() const { return static_cast<int>(page_locations_.size()); }
+  const PageLocation& page_location(int i) const { return page_locations_[i]; }
+  const std::vector<PageLocation>& page_locations() const { return page_locations_; }
+
+  // Index of the page holding the given row of the row group, -1 if there is
+  // no such page
+  int FindPage(int64_t row) const;
+
+ private:
+  std::vector<PageLocation> page_locations_;
+};
+
+// The bounds and null counts of the data pages of a column chunk, listed in
+// the order of the pages of its OffsetIndex.
+class PARQUET_EXPORT ColumnIndex {
+ public:
+  static std::unique_ptr<ColumnIndex> Make(const ColumnDescriptor* descr,
+                                           const uint8_t* serialized_index,
+                                           uint32_t* len);
+
+  const ColumnDescriptor* descr() const { return descr_; }
+
+  int num_pages() const { return static_cast<int>(null_pages_.size()); }
+
+  // A null page only holds null values and has no bounds
+  bool null_page(int i) const { return null_pages_[i]; }
+
+  // Plain-encoded lower and upper bounds of the values of a page
+  const std::string& encoded_min(int i) const { return min_values_[i]; }
+  const std::string& encoded_max(int i) const { return max_values_[i]; }
+
+  bool has_null_counts() const { return !null_counts_.empty(); }
+  int64_t null_count(int i) const { return null_counts_[i]; }
+
+  BoundaryOrder::type boundary_order() const { return boundary_order_; }
+
+  // Return the pages that may hold values in [min, max]. DType must be the
+  // physical type of the column. Unless the column has a signed sort order, no
+  // page can be ruled out and all of them are returned.
+  template <typename DType>
+  std::vector<int> FindPages(const typename DType::c_type& min,
+                             const typename DType::c_type& max) const;
+
+ private:
+  explicit ColumnIndex(const ColumnDescriptor* descr) : descr_(descr) {}
+
+  const ColumnDescriptor* descr_;
+  std::vector<bool> null_pages_;
+  std::vector<std::string> min_values_;
+  std::vector<std::string> max_values_;
+  std::vector<int64_t> null_counts_;
+  BoundaryOrder::type boundary_order_;
+};
+
+}  // namespace parquet
+
+#endif  // PARQUET_FILE_PAGE_INDEX_H
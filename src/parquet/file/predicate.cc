@@ -0,0 +1,304 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "parquet/file/predicate.h"
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "parquet/exception.h"
+#include "parquet/util/comparison.h"
+
+namespace parquet {
+
+namespace {
+
+template <typename DType>
+struct Literal {
+  using T = typename DType::c_type;
+  explicit Literal(const T& value) : value(value) {}
+  T value;
+};
+
+template <>
+struct Literal<ByteArrayType> {
+  explicit Literal(const ByteArray& literal)
+      : bytes(reinterpret_cast<const char*>(literal.ptr), literal.len),
+        value(literal.len, reinterpret_cast<const uint8_t*>(bytes.data())) {}
+  std::string bytes;
+  ByteArray value;
+};
+
+}  // namespace
+
+template <typename DType>
+RowGroupPredicate& RowGroupPredicate::Add(int column_index, CompareOperator::type op,
+                                          const typename DType::c_type& literal) {
+  using T = typename DType::c_type;
+  auto lit = std::make_shared<Literal<DType>>(literal);
+
+  Term term;
+  term.column_index = column_index;
+  term.physical_type = DType::type_num;
+  term.may_match = [lit, op](const ColumnDescriptor* descr,
+                             RowGroupStatistics* statistics) {
+    auto typed = static_cast<TypedRowGroupStatistics<DType>*>(statistics);
+    Compare<T> less(descr);
+    const T& min = typed->min();
+    const T& max = typed->max();
+    const T& value = lit->value;
+    switch (op) {
+      case CompareOperator::EQ:
+        return !less(value, min) && !less(max, value);
+      case CompareOperator::NE:
+        // Only an all-equal chunk is ruled out
+        return less(min, max) || less(min, value) || less(value, min);
+      case CompareOperator::LT:
+        return less(min, value);
+      case CompareOperator::LE:
+        return !less(value, min);
+      case CompareOperator::GT:
+        return less(value, max);
+      case CompareOperator::GE:
+        return !less(max, value);
+    }
+    return true;
+  };
+  terms_.push_back(term);
+  return *this;
+}
+
+bool RowGroupPredicate::MayMatch(const RowGroupMetaData& row_group) const {
+  for (const Term& term : terms_) {
+    if (term.column_index < 0 || term.column_index >= row_group.num_columns()) {
+      std::stringstream ss;
+      ss << "Predicate on column " << term.column_index << " but the row group only has "
+         << row_group.num_columns() << " columns";
+      throw ParquetException(ss.str());
+    }
+    auto column = row_group.ColumnChunk(term.column_index);
+    if (column->type() != term.physical_type) {
+      std::stringstream ss;
+      ss << "Predicate literal for column " << term.column_index << " is of type "
+         << TypeToString(term.physical_type) << ", the column is of type "
+         << TypeToString(column->type());
+      throw ParquetException(ss.str());
+    }
+    std::shared_ptr<RowGroupStatistics> statistics = column->statistics();
+    if (statistics == nullptr) {
+      continue;
+    }
+    if (column->num_values() > 0 && statistics->null_count() == column->num_values()) {
+      // Only nulls
+      return false;
+    }
+    if (statistics->HasMinMax() &&
+        !term.may_match(row_group.schema()->Column(term.column_index),
+                        statistics.get())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::vector<int> RowGroupPredicate::SelectRowGroups(const FileMetaData& metadata) const {
+  std::vector<int> row_groups;
+  for (int i = 0; i < metadata.num_row_groups(); ++i) {
+    if (MayMatch(*metadata.RowGroup(i))) {
+      row_groups.push_back(i);
+    }
+  }
+  return row_groups;
+}
+
+namespace {
+
+// The first index of [begin, end) for which pred is false, pred being true on
+// a prefix of the range
+template <typename Predicate>
+int PartitionPoint(int begin, int end, Predicate&& pred) {
+  while (begin < end) {
+    int middle = begin + (end - begin) / 2;
+    if (pred(middle)) {
+      begin = middle + 1;
+    } else {
+      end = middle;
+    }
+  }
+  return begin;
+}
+
+// Binary search among the items [begin, end), whose values are sorted across
+// them, for the ones whose bounds overlap [min, max]. get_bounds(i) returns the
+// statistics of the i-th item, nullptr if its bounds are unknown. Returns
+// false if the search reached such an item.
+template <typename DType, typename GetBounds>
+bool SearchSorted(int begin, int end, const typename DType::c_type& min,
+                  const typename DType::c_type& max, bool descending,
+                  const ColumnDescriptor* descr, GetBounds&& get_bounds,
+                  std::vector<int>* out) {
+  using T = typename DType::c_type;
+  Compare<T> less(descr);
+  bool known = true;
+  // Whether the item comes before the ones that may match
+  auto before = [&](int i) {
+    std::shared_ptr<TypedRowGroupStatistics<DType>> bounds = get_bounds(i);
+    if (bounds == nullptr) {
+      known = false;
+      return false;
+    }
+    return descending ? less(max, bounds->min()) : less(bounds->max(), min);
+  };
+  // Whether the item does not come after the ones that may match
+  auto not_after = [&](int i) {
+    std::shared_ptr<TypedRowGroupStatistics<DType>> bounds = get_bounds(i);
+    if (bounds == nullptr) {
+      known = false;
+      return false;
+    }
+    return descending ? !less(bounds->max(), min) : !less(max, bounds->min());
+  };
+  int first = PartitionPoint(begin, end, before);
+  int last = PartitionPoint(first, end, not_after);
+  if (!known) {
+    return false;
+  }
+  for (int i = first; i < last; ++i) {
+    out->push_back(i);
+  }
+  return true;
+}
+
+}  // namespace
+
+template <typename DType>
+std::vector<int> FindSortedRowGroups(const FileMetaData& metadata, int column_index,
+                                     const typename DType::c_type& min,
+                                     const typename DType::c_type& max) {
+  if (column_index < 0 || column_index >= metadata.num_columns()) {
+    std::stringstream ss;
+    ss << "Search on column " << column_index << " but the file only has "
+       << metadata.num_columns() << " columns";
+    throw ParquetException(ss.str());
+  }
+  const ColumnDescriptor* descr = metadata.schema()->Column(column_index);
+  if (descr->physical_type() != DType::type_num) {
+    std::stringstream ss;
+    ss << "Search of a " << TypeToString(descr->physical_type()) << " column with a "
+       << TypeToString(DType::type_num) << " range";
+    throw ParquetException(ss.str());
+  }
+
+  // The declared sort order only holds within each row group: the row groups
+  // of concatenated sorted files are each sorted, but not across them. Telling
+  // the two apart takes the statistics of all row groups, which a scan reads
+  // once anyway.
+  RowGroupPredicate predicate;
+  predicate.Add<DType>(column_index, CompareOperator::GE, min)
+      .Add<DType>(column_index, CompareOperator::LE, max);
+  return predicate.SelectRowGroups(metadata);
+}
+
+template <typename DType>
+std::vector<int> FindSortedPages(const RowGroupMetaData& row_group,
+                                 const ColumnIndex& column_index,
+                                 const typename DType::c_type& min,
+                                 const typename DType::c_type& max) {
+  const ColumnDescriptor* descr = column_index.descr();
+  bool sorted = true;
+  bool descending = false;
+  if (column_index.boundary_order() == BoundaryOrder::ASCENDING) {
+    descending = false;
+  } else if (column_index.boundary_order() == BoundaryOrder::DESCENDING) {
+    descending = true;
+  } else {
+    std::vector<SortingColumn> sorting_columns = row_group.sorting_columns();
+    sorted = !sorting_columns.empty() &&
+             sorting_columns[0].column_index ==
+                 row_group.schema()->ColumnIndex(*descr->schema_node());
+    descending = sorted && sorting_columns[0].descending;
+  }
+  // The bounds of the pages are only meaningful in signed order, see
+  // ColumnIndex::FindPages
+  sorted = sorted && DType::type_num == descr->physical_type() &&
+           get_sort_order(descr->logical_type(), descr->physical_type()) ==
+               SortOrder::SIGNED;
+  if (!sorted) {
+    return column_index.FindPages<DType>(min, max);
+  }
+
+  // The null pages are grouped at either end
+  int begin = 0;
+  int end = column_index.num_pages();
+  while (begin < end && column_index.null_page(begin)) {
+    ++begin;
+  }
+  while (end > begin && column_index.null_page(end - 1)) {
+    --end;
+  }
+  auto get_bounds = [&](int i) -> std::shared_ptr<TypedRowGroupStatistics<DType>> {
+    if (column_index.null_page(i)) {
+      return nullptr;
+    }
+    return std::make_shared<TypedRowGroupStatistics<DType>>(
+        descr, column_index.encoded_min(i), column_index.encoded_max(i), 0, 0, 0, true);
+  };
+  std::vector<int> pages;
+  if (SearchSorted<DType>(begin, end, min, max, descending, descr, get_bounds,
+                          &pages)) {
+    return pages;
+  }
+  return column_index.FindPages<DType>(min, max);
+}
+
+#define PREDICATE_ADD_INSTANTIATION(DType)                                 \
+  template PARQUET_EXPORT RowGroupPredicate& RowGroupPredicate::Add<DType>( \
+      int column_index, CompareOperator::type op, const DType::c_type& literal)
+
+PREDICATE_ADD_INSTANTIATION(BooleanType);
+PREDICATE_ADD_INSTANTIATION(Int32Type);
+PREDICATE_ADD_INSTANTIATION(Int64Type);
+PREDICATE_ADD_INSTANTIATION(Int96Type);
+PREDICATE_ADD_INSTANTIATION(FloatType);
+PREDICATE_ADD_INSTANTIATION(DoubleType);
+PREDICATE_ADD_INSTANTIATION(ByteArrayType);
+PREDICATE_ADD_INSTANTIATION(FLBAType);
+
+#undef PREDICATE_ADD_INSTANTIATION
+
+#define FIND_SORTED_INSTANTIATION(DType)                                         \
+  template PARQUET_EXPORT std::vector<int> FindSortedRowGroups<DType>(           \
+      const FileMetaData& metadata, int column_index, const DType::c_type& min,  \
+      const DType::c_type& max);                                                 \
+  template PARQUET_EXPORT std::vector<int> FindSortedPages<DType>(               \
+      const RowGroupMetaData& row_group, const ColumnIndex& column_index,        \
+      const DType::c_type& min, const DType::c_type& max)
+
+FIND_SORTED_INSTANTIATION(BooleanType);
+FIND_SORTED_INSTANTIATION(Int32Type);
+FIND_SORTED_INSTANTIATION(Int64Type);
+FIND_SORTED_INSTANTIATION(Int96Type);
+FIND_SORTED_INSTANTIATION(FloatType);
+FIND_SORTED_INSTANTIATION(DoubleType);
+FIND_SORTED_INSTANTIATION(ByteArrayType);
+FIND_SORTED_INSTANTIATION(FLBAType);
+
+#undef FIND_SORTED_INSTANTIATION
+
+}  // namespace parquet
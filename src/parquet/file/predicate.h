@@ -0,0 +1,100 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef PARQUET_FILE_PREDICATE_H
+#define PARQUET_FILE_PREDICATE_H
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "parquet/file/metadata.h"
+#include "parquet/file/page_index.h"
+#include "parquet/statistics.h"
+#include "parquet/types.h"
+#include "parquet/util/visibility.h"
+
+namespace parquet {
+
+struct CompareOperator {
+  enum type { EQ, NE, LT, LE, GT, GE };
+};
+
+// A conjunction of "column <op> literal" terms, evaluated against the column
+// chunk statistics of row groups to skip the ones where no row can match.
+// Literals are given in the physical type of the leaf column, e.g.
+//
+//   RowGroupPredicate predicate;
+//   predicate.Add<Int64Type>(0, CompareOperator::GE, 100)
+//       .Add<Int64Type>(0, CompareOperator::LT, 200);
+//
+// Statistics are only trusted where ColumnChunkMetaData::is_stats_set() does
+// (see ApplicationVersion::HasCorrectStatistics): row groups without usable
+// statistics are never skipped. Null values never match a term.
+class PARQUET_EXPORT RowGroupPredicate {
+ public:
+  // The bytes referenced by BYTE_ARRAY literals are copied. Those of
+  // FIXED_LEN_BYTE_ARRAY literals must outlive the predicate.
+  template <typename DType>
+  RowGroupPredicate& Add(int column_index, CompareOperator::type op,
+                         const typename DType::c_type& literal);
+
+  // Returns false if the statistics show that no row of the row group matches
+  bool MayMatch(const RowGroupMetaData& row_group) const;
+
+  // Return the indices of the row groups of the file that may match
+  std::vector<int> SelectRowGroups(const FileMetaData& metadata) const;
+
+  bool empty() const { return terms_.empty(); }
+
+ private:
+  struct Term {
+    int column_index;
+    Type::type physical_type;
+    // Evaluated on statistics that have min and max values
+    std::function<bool(const ColumnDescriptor*, RowGroupStatistics*)> may_match;
+  };
+  std::vector<Term> terms_;
+};
+
+// Return the row groups of the file whose values of the column may lie in
+// [min, max], from the statistics of each row group. Unlike the pages of a
+// sorted chunk (see FindSortedPages), the row groups are not binary searched:
+// the declared sorting columns (see WriterProperties::Builder::sorting_columns)
+// only hold within each row group, as in a compaction of several sorted files.
+template <typename DType>
+PARQUET_EXPORT std::vector<int> FindSortedRowGroups(const FileMetaData& metadata,
+                                                    int column_index,
+                                                    const typename DType::c_type& min,
+                                                    const typename DType::c_type& max);
+
+// Return the pages of the column index whose values may lie in [min, max], for
+// a column chunk whose values are sorted: the ColumnIndex has an ascending or
+// descending boundary order, or else the column is the first sorting column
+// of the row group. The pages are found by binary search, the null pages at
+// either end excepted.
+//
+// Falls back to ColumnIndex::FindPages if the chunk is not known to be sorted.
+template <typename DType>
+PARQUET_EXPORT std::vector<int> FindSortedPages(const RowGroupMetaData& row_group,
+                                                const ColumnIndex& column_index,
+                                                const typename DType::c_type& min,
+                                                const typename DType::c_type& max);
+
+}  // namespace parquet
+
+#endif  // PARQUET_FILE_PREDICATE_H
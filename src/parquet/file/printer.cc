@@ -17,33 +17,393 @@
 
 #include "parquet/file/printer.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <limits>
 #include <string>
 #include <vector>
 
-#include "parquet/column_scanner.h"
+#include "parquet/column_reader.h"
 
 using std::string;
 using std::vector;
 
 namespace parquet {
+
 // ----------------------------------------------------------------------
-// ParquetFilePrinter::DebugPrint
+// Batched value formatting
+
+// Width of the columns of the TABLE format
+static constexpr int kColumnWidth = 30;
+
+// Rows formatted and written to the stream at a time
+static constexpr int64_t kPrintBatchSize = 1024;
+
+namespace {
+
+void AppendInt(int64_t value, std::string* out) {
+  char digits[20];
+  uint64_t magnitude =
+      value < 0 ? 0 - static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+  int num_digits = 0;
+  do {
+    digits[num_digits++] = static_cast<char>('0' + magnitude % 10);
+    magnitude /= 10;
+  } while (magnitude > 0);
+  if (value < 0) {
+    out->push_back('-');
+  }
+  while (num_digits > 0) {
+    out->push_back(digits[--num_digits]);
+  }
+}
 
-// the fixed initial size is just for an example
-#define COL_WIDTH "30"
+template <typename T>
+void AppendFloatingPoint(T value, std::string* out) {
+  if (std::isnan(value)) {
+    out->append("NaN");
+  } else if (std::isinf(value)) {
+    out->append(value < 0 ? "-Infinity" : "Infinity");
+  } else {
+    // As many significant digits as the type holds exactly
+    char buffer[32];
+    int length = snprintf(buffer, sizeof(buffer), "%.*g",
+                          std::numeric_limits<T>::digits10, static_cast<double>(value));
+    out->append(buffer, length);
+  }
+}
 
-void ParquetFilePrinter::DebugPrint(std::ostream& stream, std::list<int> selected_columns,
-                                    bool print_values, const char* filename) {
-  const FileMetaData* file_metadata = fileReader->metadata().get();
+void FormatValue(bool value, const ColumnDescriptor*, std::string* out) {
+  out->append(value ? "true" : "false");
+}
 
-  stream << "File Name: " << filename << "\n";
-  stream << "Version: " << file_metadata->version() << "\n";
-  stream << "Created By: " << file_metadata->created_by() << "\n";
-  stream << "Total rows: " << file_metadata->num_rows() << "\n";
-  stream << "Number of RowGroups: " << file_metadata->num_row_groups() << "\n";
-  stream << "Number of Real Columns: "
-         << file_metadata->schema()->group_node()->field_count() << "\n";
+void FormatValue(int32_t value, const ColumnDescriptor*, std::string* out) {
+  AppendInt(value, out);
+}
+
+void FormatValue(int64_t value, const ColumnDescriptor*, std::string* out) {
+  AppendInt(value, out);
+}
+
+void FormatValue(const Int96& value, const ColumnDescriptor*, std::string* out) {
+  for (int i = 0; i < 3; ++i) {
+    if (i > 0) {
+      out->push_back(' ');
+    }
+    AppendInt(value.value[i], out);
+  }
+}
+
+void FormatValue(float value, const ColumnDescriptor*, std::string* out) {
+  AppendFloatingPoint(value, out);
+}
+
+void FormatValue(double value, const ColumnDescriptor*, std::string* out) {
+  AppendFloatingPoint(value, out);
+}
+
+void FormatValue(const ByteArray& value, const ColumnDescriptor*, std::string* out) {
+  out->append(reinterpret_cast<const char*>(value.ptr), value.len);
+}
+
+void FormatValue(const FixedLenByteArray& value, const ColumnDescriptor* descr,
+                 std::string* out) {
+  for (int i = 0; i < descr->type_length(); ++i) {
+    if (i > 0) {
+      out->push_back(' ');
+    }
+    AppendInt(value.ptr[i], out);
+  }
+}
+
+// Formats the values of a column chunk into cells, a batch of rows at a time.
+// The values of repeated columns are each formatted as a row of their own.
+class ColumnFormatter {
+ public:
+  ColumnFormatter(const ColumnDescriptor* descr, int64_t batch_size)
+      : descr_(descr), cells_(batch_size), nulls_(batch_size), num_cells_(0) {}
+
+  virtual ~ColumnFormatter() {}
+
+  // Format the next num_rows rows at most, fewer at the end of the column
+  // chunk. Returns the number of rows formatted.
+  virtual int64_t Next(int64_t num_rows) = 0;
+
+  const ColumnDescriptor* descr() const { return descr_; }
+
+  // Whether the values are quoted in JSON
+  bool is_text() const {
+    return descr_->physical_type() == Type::BYTE_ARRAY ||
+           descr_->physical_type() == Type::FIXED_LEN_BYTE_ARRAY ||
+           descr_->physical_type() == Type::INT96;
+  }
+
+  // The cells of the last batch; the cells of nulls are empty
+  int64_t num_cells() const { return num_cells_; }
+  const std::string& cell(int64_t i) const { return cells_[i]; }
+  bool is_null(int64_t i) const { return nulls_[i]; }
+
+ protected:
+  const ColumnDescriptor* descr_;
+  std::vector<std::string> cells_;
+  std::vector<bool> nulls_;
+  int64_t num_cells_;
+};
+
+template <typename DType>
+class TypedColumnFormatter : public ColumnFormatter {
+ public:
+  typedef typename DType::c_type T;
+
+  TypedColumnFormatter(const std::shared_ptr<ColumnReader>& reader, int64_t batch_size)
+      : ColumnFormatter(reader->descr(), batch_size),
+        reader_(reader),
+        typed_reader_(static_cast<TypedColumnReader<DType>*>(reader.get())),
+        def_levels_(batch_size),
+        rep_levels_(batch_size),
+        values_(new T[batch_size]) {}
+
+  int64_t Next(int64_t num_rows) override {
+    const int16_t max_def_level = descr_->max_definition_level();
+    num_cells_ = 0;
+    // The byte array values only stay valid until the end of their page, so
+    // they are formatted one page at a time
+    while (num_cells_ < num_rows) {
+      int64_t values_read = 0;
+      int64_t levels_read = typed_reader_->ReadBatchFull(
+          num_rows - num_cells_, def_levels_.data(), rep_levels_.data(), values_.get(),
+          &values_read);
+      if (levels_read == 0) {
+        break;
+      }
+      int64_t value_index = 0;
+      for (int64_t i = 0; i < levels_read; ++i, ++num_cells_) {
+        std::string* cell = &cells_[num_cells_];
+        cell->clear();
+        nulls_[num_cells_] = max_def_level > 0 && def_levels_[i] < max_def_level;
+        if (!nulls_[num_cells_]) {
+          FormatValue(values_[value_index++], descr_, cell);
+        }
+      }
+    }
+    return num_cells_;
+  }
+
+ private:
+  std::shared_ptr<ColumnReader> reader_;
+  TypedColumnReader<DType>* typed_reader_;
+  std::vector<int16_t> def_levels_;
+  std::vector<int16_t> rep_levels_;
+  std::unique_ptr<T[]> values_;
+};
+
+std::unique_ptr<ColumnFormatter> MakeColumnFormatter(
+    const std::shared_ptr<ColumnReader>& reader, int64_t batch_size) {
+  switch (reader->type()) {
+    case Type::BOOLEAN:
+      return std::unique_ptr<ColumnFormatter>(
+          new TypedColumnFormatter<BooleanType>(reader, batch_size));
+    case Type::INT32:
+      return std::unique_ptr<ColumnFormatter>(
+          new TypedColumnFormatter<Int32Type>(reader, batch_size));
+    case Type::INT64:
+      return std::unique_ptr<ColumnFormatter>(
+          new TypedColumnFormatter<Int64Type>(reader, batch_size));
+    case Type::INT96:
+      return std::unique_ptr<ColumnFormatter>(
+          new TypedColumnFormatter<Int96Type>(reader, batch_size));
+    case Type::FLOAT:
+      return std::unique_ptr<ColumnFormatter>(
+          new TypedColumnFormatter<FloatType>(reader, batch_size));
+    case Type::DOUBLE:
+      return std::unique_ptr<ColumnFormatter>(
+          new TypedColumnFormatter<DoubleType>(reader, batch_size));
+    case Type::BYTE_ARRAY:
+      return std::unique_ptr<ColumnFormatter>(
+          new TypedColumnFormatter<ByteArrayType>(reader, batch_size));
+    case Type::FIXED_LEN_BYTE_ARRAY:
+      return std::unique_ptr<ColumnFormatter>(
+          new TypedColumnFormatter<FLBAType>(reader, batch_size));
+    default:
+      ParquetException::NYI("type formatter not implemented");
+  }
+  // Unreachable code, but supress compiler warning
+  return nullptr;
+}
+
+// Pad with spaces to kColumnWidth, keeping at least one space
+void AppendTableCell(const std::string& text, std::string* out) {
+  out->append(text);
+  out->append(std::max<int64_t>(kColumnWidth - static_cast<int64_t>(text.size()), 1),
+              ' ');
+}
+
+// Quote the field if it holds a separator, a quote or a line break
+void AppendCsvField(const std::string& text, std::string* out) {
+  if (text.find_first_of(",\"\r\n") == std::string::npos) {
+    out->append(text);
+    return;
+  }
+  out->push_back('"');
+  for (char c : text) {
+    if (c == '"') {
+      out->push_back('"');
+    }
+    out->push_back(c);
+  }
+  out->push_back('"');
+}
+
+// NaN and the infinities have no JSON number representation
+bool IsJsonNumber(const std::string& cell) {
+  return cell != "NaN" && cell != "Infinity" && cell != "-Infinity";
+}
+
+void AppendJsonString(const std::string& text, std::string* out) {
+  out->push_back('"');
+  for (char c : text) {
+    switch (c) {
+      case '"':
+        out->append("\\\"");
+        break;
+      case '\\':
+        out->append("\\\\");
+        break;
+      case '\n':
+        out->append("\\n");
+        break;
+      case '\r':
+        out->append("\\r");
+        break;
+      case '\t':
+        out->append("\\t");
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          char escaped[8];
+          snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned char>(c));
+          out->append(escaped);
+        } else {
+          out->push_back(c);
+        }
+    }
+  }
+  out->push_back('"');
+}
+
+void PrintHeader(std::ostream& stream, const FileMetaData* file_metadata,
+                 const std::list<int>& selected_columns, PrintFormat::type format) {
+  if (format == PrintFormat::JSON) {
+    return;
+  }
+  std::string line;
+  bool first = true;
+  for (auto i : selected_columns) {
+    const std::string& name = file_metadata->schema()->Column(i)->name();
+    if (format == PrintFormat::TABLE) {
+      AppendTableCell(name, &line);
+    } else {
+      if (!first) {
+        line.push_back(',');
+      }
+      AppendCsvField(name, &line);
+    }
+    first = false;
+  }
+  line.push_back('\n');
+  stream << line;
+}
 
+// Append a row of the last batch of the formatters. The columns with fewer
+// rows in the batch, such as flat columns next to repeated ones, are left
+// blank.
+void AppendRow(const std::vector<std::unique_ptr<ColumnFormatter>>& formatters,
+               int64_t row, PrintFormat::type format, std::string* out) {
+  if (format == PrintFormat::JSON) {
+    out->push_back('{');
+  }
+  for (size_t j = 0; j < formatters.size(); ++j) {
+    const ColumnFormatter& formatter = *formatters[j];
+    const bool is_null = row >= formatter.num_cells() || formatter.is_null(row);
+    switch (format) {
+      case PrintFormat::TABLE:
+        if (row >= formatter.num_cells()) {
+          AppendTableCell("", out);
+        } else {
+          AppendTableCell(is_null ? "NULL" : formatter.cell(row), out);
+        }
+        break;
+      case PrintFormat::CSV:
+        if (j > 0) {
+          out->push_back(',');
+        }
+        if (!is_null) {
+          AppendCsvField(formatter.cell(row), out);
+        }
+        break;
+      case PrintFormat::JSON:
+        if (j > 0) {
+          out->append(", ");
+        }
+        AppendJsonString(formatter.descr()->name(), out);
+        out->append(": ");
+        if (is_null) {
+          out->append("null");
+        } else if (formatter.is_text() || !IsJsonNumber(formatter.cell(row))) {
+          AppendJsonString(formatter.cell(row), out);
+        } else {
+          out->append(formatter.cell(row));
+        }
+        break;
+    }
+  }
+  if (format == PrintFormat::JSON) {
+    out->push_back('}');
+  }
+  out->push_back('\n');
+}
+
+// Print the values of the first max_rows rows of the row group, all of them
+// if max_rows is negative, a batch at a time. Returns the number of rows
+// printed.
+int64_t PrintRowGroupValues(std::ostream& stream, RowGroupReader* group_reader,
+                            const std::list<int>& selected_columns, int64_t max_rows,
+                            PrintFormat::type format) {
+  std::vector<std::unique_ptr<ColumnFormatter>> formatters;
+  for (auto i : selected_columns) {
+    formatters.push_back(MakeColumnFormatter(group_reader->Column(i), kPrintBatchSize));
+  }
+
+  int64_t num_printed = 0;
+  std::string batch;
+  while (max_rows < 0 || num_printed < max_rows) {
+    int64_t num_rows = kPrintBatchSize;
+    if (max_rows >= 0) {
+      num_rows = std::min(num_rows, max_rows - num_printed);
+    }
+    int64_t batch_rows = 0;
+    for (auto& formatter : formatters) {
+      batch_rows = std::max(batch_rows, formatter->Next(num_rows));
+    }
+    if (batch_rows == 0) {
+      break;
+    }
+    batch.clear();
+    for (int64_t row = 0; row < batch_rows; ++row) {
+      AppendRow(formatters, row, format, &batch);
+    }
+    stream << batch;
+    num_printed += batch_rows;
+  }
+  return num_printed;
+}
+
+}  // namespace
+
+// Check the selected columns, selecting all of them if there are none
+static std::list<int> SelectColumns(const FileMetaData* file_metadata,
+                                    std::list<int> selected_columns) {
   if (selected_columns.size() == 0) {
     for (int i = 0; i < file_metadata->num_columns(); i++) {
       selected_columns.push_back(i);
@@ -55,6 +415,26 @@ void ParquetFilePrinter::DebugPrint(std::ostream& stream, std::list<int> selecte
       }
     }
   }
+  return selected_columns;
+}
+
+// ----------------------------------------------------------------------
+// ParquetFilePrinter::DebugPrint
+
+void ParquetFilePrinter::DebugPrint(std::ostream& stream, std::list<int> selected_columns,
+                                    bool print_values, const char* filename,
+                                    int64_t max_rows) {
+  const FileMetaData* file_metadata = fileReader->metadata().get();
+
+  stream << "File Name: " << filename << "\n";
+  stream << "Version: " << file_metadata->version() << "\n";
+  stream << "Created By: " << file_metadata->created_by() << "\n";
+  stream << "Total rows: " << file_metadata->num_rows() << "\n";
+  stream << "Number of RowGroups: " << file_metadata->num_row_groups() << "\n";
+  stream << "Number of Real Columns: "
+         << file_metadata->schema()->group_node()->field_count() << "\n";
+
+  selected_columns = SelectColumns(file_metadata, selected_columns);
 
   stream << "Number of Columns: " << file_metadata->num_columns() << "\n";
   stream << "Number of Selected Columns: " << selected_columns.size() << "\n";
@@ -101,44 +481,37 @@ void ParquetFilePrinter::DebugPrint(std::ostream& stream, std::list<int> selecte
              << std::endl;
     }
 
-    if (!print_values) {
+    // The row groups past the limit are not read
+    if (!print_values || max_rows == 0) {
       continue;
     }
+    PrintHeader(stream, file_metadata, selected_columns, PrintFormat::TABLE);
+    int64_t num_printed = PrintRowGroupValues(stream, group_reader.get(),
+                                              selected_columns, max_rows,
+                                              PrintFormat::TABLE);
+    if (max_rows >= 0) {
+      max_rows -= num_printed;
+    }
+  }
+}
 
-    static constexpr int bufsize = 25;
-    char buffer[bufsize];
-
-    // Create readers for selected columns and print contents
-    vector<std::shared_ptr<Scanner>> scanners(selected_columns.size(), NULL);
-    int j = 0;
-    for (auto i : selected_columns) {
-      std::shared_ptr<ColumnReader> col_reader = group_reader->Column(i);
-
-      std::stringstream ss;
-      ss << "%-" << COL_WIDTH << "s";
-      std::string fmt = ss.str();
+// ----------------------------------------------------------------------
+// ParquetFilePrinter::PrintValues
 
-      snprintf(buffer, bufsize, fmt.c_str(),
-               file_metadata->schema()->Column(i)->name().c_str());
-      stream << buffer;
+void ParquetFilePrinter::PrintValues(std::ostream& stream,
+                                     std::list<int> selected_columns, int64_t max_rows,
+                                     PrintFormat::type format) {
+  const FileMetaData* file_metadata = fileReader->metadata().get();
+  selected_columns = SelectColumns(file_metadata, selected_columns);
 
-      // This is OK in this method as long as the RowGroupReader does not get
-      // deleted
-      scanners[j++] = Scanner::Make(col_reader);
+  PrintHeader(stream, file_metadata, selected_columns, format);
+  for (int r = 0; r < file_metadata->num_row_groups() && max_rows != 0; ++r) {
+    auto group_reader = fileReader->RowGroup(r);
+    int64_t num_printed = PrintRowGroupValues(stream, group_reader.get(),
+                                              selected_columns, max_rows, format);
+    if (max_rows >= 0) {
+      max_rows -= num_printed;
     }
-    stream << "\n";
-
-    bool hasRow;
-    do {
-      hasRow = false;
-      for (auto scanner : scanners) {
-        if (scanner->HasNext()) {
-          hasRow = true;
-          scanner->PrintNext(stream, 27);
-        }
-      }
-      stream << "\n";
-    } while (hasRow);
   }
 }
 
@@ -155,17 +528,7 @@ void ParquetFilePrinter::JSONPrint(std::ostream& stream, std::list<int> selected
          << file_metadata->schema()->group_node()->field_count() << "\",\n";
   stream << "  \"NumberOfColumns\": \"" << file_metadata->num_columns() << "\",\n";
 
-  if (selected_columns.size() == 0) {
-    for (int i = 0; i < file_metadata->num_columns(); i++) {
-      selected_columns.push_back(i);
-    }
-  } else {
-    for (auto i : selected_columns) {
-      if (i < 0 || i >= file_metadata->num_columns()) {
-        throw ParquetException("Selected column is out of range");
-      }
-    }
-  }
+  selected_columns = SelectColumns(file_metadata, selected_columns);
 
   stream << "  \"Columns\": [\n";
   int c = 0;
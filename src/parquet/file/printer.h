@@ -29,6 +29,14 @@
 
 namespace parquet {
 
+// Layouts of the values printed by ParquetFilePrinter: padded columns, CSV
+// with a header row, or one JSON object per row. JSON has no number for NaN
+// and the infinities, they are printed as the strings "NaN", "Infinity" and
+// "-Infinity".
+struct PrintFormat {
+  enum type { TABLE, CSV, JSON };
+};
+
 class PARQUET_EXPORT ParquetFilePrinter {
  private:
   ParquetFileReader* fileReader;
@@ -37,8 +45,17 @@ class PARQUET_EXPORT ParquetFilePrinter {
   explicit ParquetFilePrinter(ParquetFileReader* reader) : fileReader(reader) {}
   ~ParquetFilePrinter() {}
 
+  // The values of the first max_rows rows are printed after the metadata of
+  // their row group, all of them if max_rows is negative. The column chunks
+  // are only read up to the last printed row, and not at all past max_rows.
   void DebugPrint(std::ostream& stream, std::list<int> selected_columns,
-                  bool print_values = true, const char* fileame = "No Name");
+                  bool print_values = true, const char* fileame = "No Name",
+                  int64_t max_rows = -1);
+
+  // Print the values of the first max_rows rows of the selected columns, or of
+  // all the rows if max_rows is negative, without the metadata
+  void PrintValues(std::ostream& stream, std::list<int> selected_columns,
+                   int64_t max_rows = -1, PrintFormat::type format = PrintFormat::CSV);
 
   void JSONPrint(std::ostream& stream, std::list<int> selected_columns,
                  const char* filename = "No Name");
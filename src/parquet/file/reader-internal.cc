@@ -19,8 +19,12 @@
 
 #include <string.h>
 #include <algorithm>
+#include <condition_variable>
+#include <deque>
 #include <exception>
+#include <future>
 #include <ostream>
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -32,6 +36,7 @@
 #include "parquet/thrift.h"
 #include "parquet/types.h"
 #include "parquet/util/memory.h"
+#include "parquet/util/stopwatch.h"
 
 using arrow::MemoryPool;
 
@@ -45,79 +50,284 @@ SerializedPageReader::SerializedPageReader(std::unique_ptr<InputStream> stream,
                                            int64_t total_num_rows,
                                            Compression::type codec, MemoryPool* pool)
     : stream_(std::move(stream)),
+      pool_(pool),
+      has_page_header_(false),
+      current_page_header_size_(0),
       decompression_buffer_(AllocateBuffer(pool, 0)),
       seen_num_rows_(0),
-      total_num_rows_(total_num_rows) {
+      total_num_rows_(total_num_rows),
+      detach_page_buffers_(false),
+      zero_copy_(false),
+      levels_only_(false),
+      stats_(nullptr),
+      header_deserializer_(new ThriftDeserializer()) {
   max_page_header_size_ = DEFAULT_MAX_PAGE_HEADER_SIZE;
   decompressor_ = GetCodecFromArrow(codec);
 }
 
+SerializedPageReader::~SerializedPageReader() {}
+
+// Works for both format::DataPageHeader and format::DataPageHeaderV2
+template <typename DataPageHeader>
+static EncodedStatistics PageStatistics(const DataPageHeader& header) {
+  EncodedStatistics page_statistics;
+  if (header.__isset.statistics) {
+    const format::Statistics& stats = header.statistics;
+    if (stats.__isset.max) {
+      page_statistics.set_max(stats.max);
+    }
+    if (stats.__isset.min) {
+      page_statistics.set_min(stats.min);
+    }
+    if (stats.__isset.null_count) {
+      page_statistics.set_null_count(stats.null_count);
+    }
+    if (stats.__isset.distinct_count) {
+      page_statistics.set_distinct_count(stats.distinct_count);
+    }
+  }
+  return page_statistics;
+}
+
+static bool IsDataPage(const format::PageHeader& header) {
+  return header.type == format::PageType::DATA_PAGE ||
+         header.type == format::PageType::DATA_PAGE_V2;
+}
+
+// The number of values and the statistics of a data page of either version
+static int32_t DataPageNumValues(const format::PageHeader& header) {
+  if (header.type == format::PageType::DATA_PAGE_V2) {
+    return header.data_page_header_v2.num_values;
+  }
+  return header.data_page_header.num_values;
+}
+
+static EncodedStatistics DataPageStatistics(const format::PageHeader& header) {
+  if (header.type == format::PageType::DATA_PAGE_V2) {
+    return PageStatistics(header.data_page_header_v2);
+  }
+  return PageStatistics(header.data_page_header);
+}
+
+bool SerializedPageReader::ReadPageHeader() {
+  if (has_page_header_) {
+    return true;
+  }
+  int64_t bytes_available = 0;
+  uint32_t header_size = 0;
+  const uint8_t* buffer;
+  uint32_t allowed_page_size = DEFAULT_PAGE_HEADER_SIZE;
+
+  // Page headers can be very large because of page statistics. If the header
+  // does not fit in the default size, all bytes up to the maximum allowed
+  // header size are peeked at once, so that it is parsed at most twice.
+  while (true) {
+    buffer = stream_->Peek(allowed_page_size, &bytes_available);
+    if (bytes_available == 0) {
+      return false;
+    }
+
+    // This gets used, then set by TryDeserialize
+    header_size = static_cast<uint32_t>(bytes_available);
+    if (header_deserializer_->TryDeserialize(buffer, &header_size,
+                                             &current_page_header_)) {
+      break;
+    }
+    if (bytes_available < allowed_page_size ||
+        allowed_page_size >= max_page_header_size_) {
+      throw ParquetException("Deserializing page header failed.\n");
+    }
+    allowed_page_size = max_page_header_size_;
+  }
+  // Advance the stream offset
+  stream_->Advance(header_size);
+  current_page_header_size_ = header_size;
+  has_page_header_ = true;
+  return true;
+}
+
+std::vector<PageLocation> SerializedPageReader::ScanDataPages() {
+  std::vector<PageLocation> locations;
+  int64_t offset = 0;
+  if (has_page_header_) {
+    // The pending header was already consumed from the stream
+    offset = -static_cast<int64_t>(current_page_header_size_);
+  }
+  while (seen_num_rows_ < total_num_rows_ && ReadPageHeader()) {
+    has_page_header_ = false;
+    int32_t page_size =
+        static_cast<int32_t>(current_page_header_size_) +
+        current_page_header_.compressed_page_size;
+    if (IsDataPage(current_page_header_)) {
+      locations.push_back({offset, page_size, seen_num_rows_});
+      seen_num_rows_ += DataPageNumValues(current_page_header_);
+    }
+    stream_->Advance(current_page_header_.compressed_page_size);
+    offset += page_size;
+  }
+  return locations;
+}
+
+int64_t SerializedPageReader::SkipDataPages(int64_t max_values) {
+  int64_t values_skipped = 0;
+  while (seen_num_rows_ < total_num_rows_ && ReadPageHeader()) {
+    if (!IsDataPage(current_page_header_)) {
+      break;
+    }
+    int32_t num_values = DataPageNumValues(current_page_header_);
+    if (values_skipped + num_values > max_values) {
+      break;
+    }
+    // The header stays pending for NextPage if the page is not skipped
+    stream_->Advance(current_page_header_.compressed_page_size);
+    has_page_header_ = false;
+    seen_num_rows_ += num_values;
+    values_skipped += num_values;
+    UpdateStats(stats_, &ColumnReaderStats::pages_skipped, 1);
+  }
+  return values_skipped;
+}
+
 std::shared_ptr<Page> SerializedPageReader::NextPage() {
   // Loop here because there may be unhandled page types that we skip until
   // finding a page that we do know what to do with
   while (seen_num_rows_ < total_num_rows_) {
-    int64_t bytes_read = 0;
-    int64_t bytes_available = 0;
-    uint32_t header_size = 0;
-    const uint8_t* buffer;
-    uint32_t allowed_page_size = DEFAULT_PAGE_HEADER_SIZE;
-
-    // Page headers can be very large because of page statistics
-    // We try to deserialize a larger buffer progressively
-    // until a maximum allowed header limit
-    while (true) {
-      buffer = stream_->Peek(allowed_page_size, &bytes_available);
-      if (bytes_available == 0) {
+    {
+      ScopedStopWatch io_watch(StatsCounter(stats_, &ColumnReaderStats::io_time));
+      if (!ReadPageHeader()) {
         return std::shared_ptr<Page>(nullptr);
       }
-
-      // This gets used, then set by DeserializeThriftMsg
-      header_size = static_cast<uint32_t>(bytes_available);
-      try {
-        DeserializeThriftMsg(buffer, &header_size, &current_page_header_);
-        break;
-      } catch (std::exception& e) {
-        // Failed to deserialize. Double the allowed page header size and try again
-        std::stringstream ss;
-        ss << e.what();
-        allowed_page_size *= 2;
-        if (allowed_page_size > max_page_header_size_) {
-          ss << "Deserializing page header failed.\n";
-          throw ParquetException(ss.str());
-        }
-      }
     }
-    // Advance the stream offset
-    stream_->Advance(header_size);
+    has_page_header_ = false;
+
+    int64_t bytes_read = 0;
+    const uint8_t* buffer;
 
     int compressed_len = current_page_header_.compressed_page_size;
     int uncompressed_len = current_page_header_.uncompressed_page_size;
 
-    // Read the compressed data page.
-    buffer = stream_->Read(compressed_len, &bytes_read);
-    if (bytes_read != compressed_len) {
-      ParquetException::EofException();
+    if (data_page_filter_ && IsDataPage(current_page_header_)) {
+      if (!data_page_filter_(DataPageStatistics(current_page_header_))) {
+        stream_->Advance(compressed_len);
+        seen_num_rows_ += DataPageNumValues(current_page_header_);
+        UpdateStats(stats_, &ColumnReaderStats::pages_skipped, 1);
+        continue;
+      }
+    }
+
+    if (levels_only_ && current_page_header_.type == format::PageType::DICTIONARY_PAGE) {
+      stream_->Advance(compressed_len);
+      continue;
     }
 
-    // Uncompress it if we need to
-    if (decompressor_ != NULL) {
-      // Grow the uncompressed buffer if we need to.
-      if (uncompressed_len > static_cast<int>(decompression_buffer_->size())) {
-        PARQUET_THROW_NOT_OK(decompression_buffer_->Resize(uncompressed_len, false));
+    // DATA_PAGE_V2 pages keep their levels uncompressed ahead of the values,
+    // which may not be compressed either
+    bool is_compressed = decompressor_ != NULL;
+    int levels_len = 0;
+    if (current_page_header_.type == format::PageType::DATA_PAGE_V2) {
+      const format::DataPageHeaderV2& header = current_page_header_.data_page_header_v2;
+      // The levels are copied and the values decompressed past them, both
+      // guided by lengths read from the file
+      int64_t total_levels_len =
+          static_cast<int64_t>(header.definition_levels_byte_length) +
+          header.repetition_levels_byte_length;
+      if (header.definition_levels_byte_length < 0 ||
+          header.repetition_levels_byte_length < 0 || total_levels_len > compressed_len ||
+          total_levels_len > uncompressed_len) {
+        throw ParquetException("Corrupt DATA_PAGE_V2 header, invalid levels length");
+      }
+      levels_len = static_cast<int>(total_levels_len);
+      if (header.__isset.is_compressed && !header.is_compressed) {
+        is_compressed = false;
       }
-      PARQUET_THROW_NOT_OK(
-          decompressor_->Decompress(compressed_len, buffer, uncompressed_len,
-                                    decompression_buffer_->mutable_data()));
-      buffer = decompression_buffer_->data();
     }
 
-    auto page_buffer = std::make_shared<Buffer>(buffer, uncompressed_len);
+    // The values of a DATA_PAGE_V2 page are not needed for its levels
+    bool levels_only_page =
+        levels_only_ && current_page_header_.type == format::PageType::DATA_PAGE_V2;
+
+    std::shared_ptr<Buffer> page_buffer;
+
+    // Read the compressed data page. Uncompressed pages are referenced instead
+    // of copied when possible.
+    {
+      ScopedStopWatch io_watch(StatsCounter(stats_, &ColumnReaderStats::io_time));
+      if (zero_copy_ && (!is_compressed || levels_only_page)) {
+        page_buffer = stream_->ReadSlice(compressed_len);
+      }
+      if (page_buffer != nullptr) {
+        if (page_buffer->size() != compressed_len) {
+          ParquetException::EofException();
+        }
+        buffer = page_buffer->data();
+      } else {
+        buffer = stream_->Read(compressed_len, &bytes_read);
+        if (bytes_read != compressed_len) {
+          ParquetException::EofException();
+        }
+      }
+    }
+    UpdateStats(stats_, &ColumnReaderStats::compressed_bytes, compressed_len);
+    UpdateStats(stats_, &ColumnReaderStats::uncompressed_bytes, uncompressed_len);
+
+    if (levels_only_page) {
+      if (page_buffer != nullptr) {
+        page_buffer = ::arrow::SliceBuffer(page_buffer, 0, levels_len);
+      } else if (detach_page_buffers_) {
+        std::shared_ptr<PoolBuffer> copy = AllocateBuffer(pool_, levels_len);
+        memcpy(copy->mutable_data(), buffer, levels_len);
+        page_buffer = copy;
+      } else {
+        page_buffer = std::make_shared<Buffer>(buffer, levels_len);
+      }
+      is_compressed = false;
+    } else if (is_compressed) {
+      // Uncompress it if we need to
+      ScopedStopWatch decompression_watch(
+          StatsCounter(stats_, &ColumnReaderStats::decompression_time));
+      std::shared_ptr<ResizableBuffer> leased;
+      uint8_t* decompressed;
+      if (decompression_buffer_pool_ != nullptr) {
+        leased = decompression_buffer_pool_->Lease(uncompressed_len);
+        decompressed = leased->mutable_data();
+      } else {
+        if (detach_page_buffers_) {
+          decompression_buffer_ = AllocateBuffer(pool_, uncompressed_len);
+        } else if (uncompressed_len > static_cast<int>(decompression_buffer_->size())) {
+          // Grow the uncompressed buffer if we need to.
+          PARQUET_THROW_NOT_OK(decompression_buffer_->Resize(uncompressed_len, false));
+        }
+        decompressed = decompression_buffer_->mutable_data();
+      }
+      memcpy(decompressed, buffer, levels_len);
+      PARQUET_THROW_NOT_OK(decompressor_->Decompress(
+          compressed_len - levels_len, buffer + levels_len, uncompressed_len - levels_len,
+          decompressed + levels_len));
+      if (leased != nullptr) {
+        page_buffer = leased;
+      } else if (detach_page_buffers_) {
+        page_buffer = decompression_buffer_;
+      } else {
+        page_buffer =
+            std::make_shared<Buffer>(decompression_buffer_->data(), uncompressed_len);
+      }
+    } else if (page_buffer != nullptr) {
+      // Zero-copy slice of the stream
+    } else if (detach_page_buffers_) {
+      // The stream may reuse its memory for the next read
+      std::shared_ptr<PoolBuffer> copy = AllocateBuffer(pool_, uncompressed_len);
+      memcpy(copy->mutable_data(), buffer, uncompressed_len);
+      page_buffer = copy;
+    } else {
+      page_buffer = std::make_shared<Buffer>(buffer, uncompressed_len);
+    }
 
     if (current_page_header_.type == format::PageType::DICTIONARY_PAGE) {
       const format::DictionaryPageHeader& dict_header =
           current_page_header_.dictionary_page_header;
 
       bool is_sorted = dict_header.__isset.is_sorted ? dict_header.is_sorted : false;
+      UpdateStats(stats_, &ColumnReaderStats::dictionary_pages, 1);
 
       return std::make_shared<DictionaryPage>(page_buffer, dict_header.num_values,
                                               FromThrift(dict_header.encoding),
@@ -125,39 +335,23 @@ std::shared_ptr<Page> SerializedPageReader::NextPage() {
     } else if (current_page_header_.type == format::PageType::DATA_PAGE) {
       const format::DataPageHeader& header = current_page_header_.data_page_header;
 
-      EncodedStatistics page_statistics;
-      if (header.__isset.statistics) {
-        const format::Statistics& stats = header.statistics;
-        if (stats.__isset.max) {
-          page_statistics.set_max(stats.max);
-        }
-        if (stats.__isset.min) {
-          page_statistics.set_min(stats.min);
-        }
-        if (stats.__isset.null_count) {
-          page_statistics.set_null_count(stats.null_count);
-        }
-        if (stats.__isset.distinct_count) {
-          page_statistics.set_distinct_count(stats.distinct_count);
-        }
-      }
-
       seen_num_rows_ += header.num_values;
+      UpdateStats(stats_, &ColumnReaderStats::data_pages, 1);
 
       return std::make_shared<DataPage>(
           page_buffer, header.num_values, FromThrift(header.encoding),
           FromThrift(header.definition_level_encoding),
-          FromThrift(header.repetition_level_encoding), page_statistics);
+          FromThrift(header.repetition_level_encoding), PageStatistics(header));
     } else if (current_page_header_.type == format::PageType::DATA_PAGE_V2) {
       const format::DataPageHeaderV2& header = current_page_header_.data_page_header_v2;
-      bool is_compressed = header.__isset.is_compressed ? header.is_compressed : false;
 
       seen_num_rows_ += header.num_values;
+      UpdateStats(stats_, &ColumnReaderStats::data_pages, 1);
 
       return std::make_shared<DataPageV2>(
           page_buffer, header.num_values, header.num_nulls, header.num_rows,
           FromThrift(header.encoding), header.definition_levels_byte_length,
-          header.repetition_levels_byte_length, is_compressed);
+          header.repetition_levels_byte_length, is_compressed, PageStatistics(header));
     } else {
       // We don't know what this page type is. We're allowed to skip non-data
       // pages.
@@ -167,10 +361,277 @@ std::shared_ptr<Page> SerializedPageReader::NextPage() {
   return std::shared_ptr<Page>(nullptr);
 }
 
+// ----------------------------------------------------------------------
+// PrefetchingPageReader
+
+struct PrefetchingPageReader::State
+    : public std::enable_shared_from_this<PrefetchingPageReader::State> {
+  State(std::unique_ptr<SerializedPageReader> page_reader, int page_limit,
+        int64_t byte_limit)
+      : reader(std::move(page_reader)),
+        max_pages(page_limit),
+        max_bytes(byte_limit),
+        buffered_bytes(0),
+        finished(false),
+        stopped(false),
+        reading(false),
+        task_scheduled(false) {}
+
+  // Whether another page may be read ahead. Requires the lock.
+  bool HasRoom() const {
+    return pages.empty() ||
+           (static_cast<int>(pages.size()) < max_pages && buffered_bytes < max_bytes);
+  }
+
+  // Reads the next page, with the lock released. Requires reading to have
+  // been set by the caller; clears it.
+  void ReadPage(std::unique_lock<std::mutex>* lock) {
+    lock->unlock();
+    std::shared_ptr<Page> page;
+    std::exception_ptr read_error;
+    try {
+      page = reader->NextPage();
+    } catch (...) {
+      read_error = std::current_exception();
+    }
+    lock->lock();
+    reading = false;
+    if (read_error) {
+      error = read_error;
+      finished = true;
+    } else if (page == nullptr) {
+      finished = true;
+    } else {
+      buffered_bytes += page->size();
+      pages.push_back(page);
+    }
+    cv.notify_all();
+  }
+
+  // Submits a task reading ahead until the window is full, unless one is
+  // pending already. Requires the lock.
+  void ScheduleReadAhead(ThreadPool* pool) {
+    if (task_scheduled || finished || stopped || !HasRoom()) {
+      return;
+    }
+    task_scheduled = true;
+    std::shared_ptr<State> self = shared_from_this();
+    pool->Submit([self]() {
+      std::unique_lock<std::mutex> lock(self->mutex);
+      while (!self->reading && !self->finished && !self->stopped && self->HasRoom()) {
+        self->reading = true;
+        self->ReadPage(&lock);
+      }
+      self->task_scheduled = false;
+    });
+  }
+
+  std::unique_ptr<SerializedPageReader> reader;
+  const int max_pages;
+  const int64_t max_bytes;
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::deque<std::shared_ptr<Page>> pages;
+  int64_t buffered_bytes;
+  bool finished;
+  bool stopped;
+  // Whether a page is being read, by a task or by the consumer
+  bool reading;
+  // Whether a task was submitted and did not return yet
+  bool task_scheduled;
+  std::exception_ptr error;
+};
+
+PrefetchingPageReader::PrefetchingPageReader(std::unique_ptr<SerializedPageReader> reader,
+                                             int max_pages, int64_t max_bytes)
+    : state_(std::make_shared<State>(std::move(reader), std::max(max_pages, 1),
+                                     max_bytes)),
+      pool_(ThreadPool::Default()) {
+  state_->reader->set_detach_page_buffers(true);
+  std::lock_guard<std::mutex> lock(state_->mutex);
+  state_->ScheduleReadAhead(pool_.get());
+}
+
+PrefetchingPageReader::~PrefetchingPageReader() {
+  // The page being read references the source of the file reader, which
+  // may be closed once this returns
+  std::unique_lock<std::mutex> lock(state_->mutex);
+  state_->stopped = true;
+  state_->cv.wait(lock, [this]() { return !state_->reading; });
+  // A task still queued only finds the reader stopped
+  state_->reader.reset();
+}
+
+std::shared_ptr<Page> PrefetchingPageReader::NextPage() {
+  std::unique_lock<std::mutex> lock(state_->mutex);
+  while (state_->pages.empty() && !state_->finished) {
+    if (state_->reading) {
+      state_->cv.wait(lock);
+    } else {
+      // No task is reading: a queued one may not start before long
+      state_->reading = true;
+      state_->ReadPage(&lock);
+    }
+  }
+  if (state_->pages.empty()) {
+    if (state_->error) {
+      std::exception_ptr error = state_->error;
+      state_->error = nullptr;
+      std::rethrow_exception(error);
+    }
+    return std::shared_ptr<Page>(nullptr);
+  }
+  std::shared_ptr<Page> page = state_->pages.front();
+  state_->pages.pop_front();
+  state_->buffered_bytes -= page->size();
+  state_->ScheduleReadAhead(pool_.get());
+  return page;
+}
+
+// ----------------------------------------------------------------------
+// ChainedPageReader
+
+ChainedPageReader::ChainedPageReader(std::vector<std::unique_ptr<PageReader>> readers)
+    : readers_(std::move(readers)), current_reader_(0) {}
+
+std::shared_ptr<Page> ChainedPageReader::NextPage() {
+  while (current_reader_ < readers_.size()) {
+    std::shared_ptr<Page> page = readers_[current_reader_]->NextPage();
+    if (page) {
+      return page;
+    }
+    ++current_reader_;
+  }
+  return std::shared_ptr<Page>(nullptr);
+}
+
+void ChainedPageReader::set_data_page_filter(const DataPageFilter& filter) {
+  for (const auto& reader : readers_) {
+    reader->set_data_page_filter(filter);
+  }
+}
+
+void ChainedPageReader::set_levels_only(bool levels_only) {
+  for (const auto& reader : readers_) {
+    reader->set_levels_only(levels_only);
+  }
+}
+
+int64_t ChainedPageReader::SkipDataPages(int64_t max_values) {
+  if (current_reader_ >= readers_.size()) {
+    return 0;
+  }
+  return readers_[current_reader_]->SkipDataPages(max_values);
+}
+
+// ----------------------------------------------------------------------
+// Coalescing of column chunk reads
+
+std::vector<ReadRange> CoalesceReadRanges(std::vector<ReadRange> ranges,
+                                          int64_t hole_size_limit,
+                                          int64_t range_size_limit) {
+  ranges.erase(std::remove_if(ranges.begin(), ranges.end(),
+                              [](const ReadRange& range) { return range.length <= 0; }),
+               ranges.end());
+  if (ranges.empty()) {
+    return ranges;
+  }
+  std::sort(ranges.begin(), ranges.end(), [](const ReadRange& a, const ReadRange& b) {
+    return a.offset < b.offset;
+  });
+
+  std::vector<ReadRange> coalesced;
+  ReadRange current = ranges[0];
+  for (size_t i = 1; i < ranges.size(); ++i) {
+    const ReadRange& next = ranges[i];
+    int64_t current_end = current.offset + current.length;
+    int64_t merged_end = std::max(current_end, next.offset + next.length);
+    if (next.offset - current_end <= hole_size_limit &&
+        merged_end - current.offset <= range_size_limit) {
+      current.length = merged_end - current.offset;
+    } else {
+      coalesced.push_back(current);
+      current = next;
+    }
+  }
+  coalesced.push_back(current);
+  return coalesced;
+}
+
+ReadRangeCache::ReadRangeCache(RandomAccessSource* source, int64_t hole_size_limit,
+                               int64_t range_size_limit)
+    : source_(source),
+      hole_size_limit_(hole_size_limit),
+      range_size_limit_(range_size_limit) {}
+
+void ReadRangeCache::Cache(const std::vector<ReadRange>& ranges) {
+  std::vector<ReadRange> coalesced =
+      CoalesceReadRanges(ranges, hole_size_limit_, range_size_limit_);
+
+  // All the reads are in flight at once. Every one of them is waited for
+  // before an error is rethrown, as they reference the source.
+  std::vector<std::future<std::shared_ptr<Buffer>>> reads;
+  reads.reserve(coalesced.size());
+  for (const ReadRange& range : coalesced) {
+    reads.push_back(source_->ReadAtAsync(range.offset, range.length));
+  }
+  std::vector<Entry> new_entries;
+  new_entries.reserve(coalesced.size());
+  std::exception_ptr error;
+  for (size_t i = 0; i < reads.size(); ++i) {
+    try {
+      std::shared_ptr<Buffer> buffer = reads[i].get();
+      if (buffer->size() < coalesced[i].length) {
+        throw ParquetException("Unable to read column chunk data");
+      }
+      new_entries.push_back({coalesced[i], buffer});
+    } catch (...) {
+      if (!error) {
+        error = std::current_exception();
+      }
+    }
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.insert(entries_.end(), new_entries.begin(), new_entries.end());
+  std::sort(entries_.begin(), entries_.end(), [](const Entry& a, const Entry& b) {
+    return a.range.offset < b.range.offset;
+  });
+}
+
+std::shared_ptr<Buffer> ReadRangeCache::Read(const ReadRange& range) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  // Walk back from the first entry starting after the range
+  auto it = std::upper_bound(
+      entries_.begin(), entries_.end(), range.offset,
+      [](int64_t offset, const Entry& entry) { return offset < entry.range.offset; });
+  while (it != entries_.begin()) {
+    --it;
+    const ReadRange& cached = it->range;
+    if (cached.offset + cached.length >= range.offset + range.length) {
+      return std::make_shared<Buffer>(it->buffer, range.offset - cached.offset,
+                                      range.length);
+    }
+  }
+  return nullptr;
+}
+
+// ----------------------------------------------------------------------
+// SerializedRowGroup
+
 SerializedRowGroup::SerializedRowGroup(RandomAccessSource* source,
                                        FileMetaData* file_metadata, int row_group_number,
-                                       const ReaderProperties& props)
-    : source_(source), file_metadata_(file_metadata), properties_(props) {
+                                       const ReaderProperties& props,
+                                       const ReadRangeCache* cached_source)
+    : source_(source),
+      file_metadata_(file_metadata),
+      row_group_number_(row_group_number),
+      properties_(props),
+      cached_source_(cached_source) {
   row_group_metadata_ = file_metadata->RowGroup(row_group_number);
 }
 const RowGroupMetaData* SerializedRowGroup::metadata() const {
@@ -182,8 +643,7 @@ const ReaderProperties* SerializedRowGroup::properties() const { return &propert
 // For PARQUET-816
 static constexpr int64_t kMaxDictHeaderSize = 100;
 
-std::unique_ptr<PageReader> SerializedRowGroup::GetColumnPageReader(int i) {
-  // Read column chunk from the file
+ReadRange SerializedRowGroup::ColumnChunkRange(int i) const {
   auto col = row_group_metadata_->ColumnChunk(i);
 
   int64_t col_start = col->data_page_offset();
@@ -192,7 +652,6 @@ std::unique_ptr<PageReader> SerializedRowGroup::GetColumnPageReader(int i) {
   }
 
   int64_t col_length = col->total_compressed_size();
-  std::unique_ptr<InputStream> stream;
 
   // PARQUET-816 workaround for old files created by older parquet-mr
   const ApplicationVersion& version = file_metadata_->writer_version();
@@ -205,18 +664,212 @@ std::unique_ptr<PageReader> SerializedRowGroup::GetColumnPageReader(int i) {
     col_length += padding;
   }
 
-  stream = properties_.GetStream(source_, col_start, col_length);
+  return {col_start, col_length};
+}
+
+std::unique_ptr<InputStream> SerializedRowGroup::GetStream(const ReadRange& range) {
+  std::shared_ptr<Buffer> cached_buffer;
+  if (cached_source_ != nullptr) {
+    cached_buffer = cached_source_->Read(range);
+  }
+
+  if (cached_buffer != nullptr) {
+    return std::unique_ptr<InputStream>(new InMemoryInputStream(cached_buffer));
+  }
+  return properties_.GetStream(source_, range.offset, range.length);
+}
 
-  return std::unique_ptr<PageReader>(
-      new SerializedPageReader(std::move(stream), col->num_values(), col->compression(),
+std::unique_ptr<SerializedPageReader> SerializedRowGroup::MakePageReader(
+    std::unique_ptr<InputStream> stream, const ColumnChunkMetaData& col) {
+  std::unique_ptr<SerializedPageReader> page_reader(
+      new SerializedPageReader(std::move(stream), col.num_values(), col.compression(),
                                properties_.memory_pool()));
+  page_reader->set_zero_copy(source_->supports_zero_copy());
+  page_reader->set_decompression_buffer_pool(properties_.decompression_buffer_pool());
+  return page_reader;
+}
+
+ColumnReaderStats* SerializedRowGroup::ColumnStats(int i) {
+  const std::shared_ptr<ReaderStats>& stats = properties_.reader_stats();
+  return stats != nullptr ? stats->column(i) : nullptr;
+}
+
+void SerializedRowGroup::AdviseColumnChunkScan(int i) {
+  if (!properties_.are_access_hints_enabled()) {
+    return;
+  }
+  ReadRange range = ColumnChunkRange(i);
+  source_->Advise(range.offset, range.length, AccessHint::WILL_NEED);
+  const int last_row_group = std::min(row_group_number_ + properties_.access_hint_depth(),
+                                      file_metadata_->num_row_groups() - 1);
+  for (int row_group = row_group_number_ + 1; row_group <= last_row_group; ++row_group) {
+    range = SerializedRowGroup(source_, file_metadata_, row_group, properties_)
+                .ColumnChunkRange(i);
+    source_->Advise(range.offset, range.length, AccessHint::WILL_NEED);
+  }
+  if (row_group_number_ > 0) {
+    const int previous_row_group = row_group_number_ - 1;
+    range = SerializedRowGroup(source_, file_metadata_, previous_row_group, properties_)
+                .ColumnChunkRange(i);
+    source_->Advise(range.offset, range.length, AccessHint::DONT_NEED);
+  }
+}
+
+std::unique_ptr<PageReader> SerializedRowGroup::GetColumnPageReader(int i) {
+  // Read column chunk from the file
+  auto col = row_group_metadata_->ColumnChunk(i);
+  ColumnReaderStats* stats = ColumnStats(i);
+  AdviseColumnChunkScan(i);
+  std::unique_ptr<InputStream> stream;
+  {
+    ScopedStopWatch io_watch(StatsCounter(stats, &ColumnReaderStats::io_time));
+    stream = GetStream(ColumnChunkRange(i));
+  }
+  std::unique_ptr<SerializedPageReader> page_reader =
+      MakePageReader(std::move(stream), *col);
+  page_reader->set_stats(stats);
+  if (properties_.is_page_prefetch_enabled()) {
+    return std::unique_ptr<PageReader>(new PrefetchingPageReader(
+        std::move(page_reader), properties_.page_prefetch_depth(),
+        properties_.page_prefetch_memory_limit()));
+  }
+  return std::move(page_reader);
+}
+
+std::unique_ptr<PageReader> SerializedRowGroup::GetColumnPageReaderAt(
+    int i, const OffsetIndex& offset_index, int page, int end_page) {
+  if (page < 0 || page >= offset_index.num_pages()) {
+    std::stringstream ss;
+    ss << "Page " << page << " is out of range, the column chunk has "
+       << offset_index.num_pages() << " pages";
+    throw ParquetException(ss.str());
+  }
+  if (end_page != -1 && (end_page <= page || end_page > offset_index.num_pages())) {
+    std::stringstream ss;
+    ss << "End page " << end_page << " is out of range, the column chunk has "
+       << offset_index.num_pages() << " pages";
+    throw ParquetException(ss.str());
+  }
+  auto col = row_group_metadata_->ColumnChunk(i);
+  ReadRange col_range = ColumnChunkRange(i);
+  // The data pages end where the page after the last one starts
+  int64_t data_end = end_page == -1 || end_page == offset_index.num_pages()
+                         ? col_range.offset + col_range.length
+                         : offset_index.page_location(end_page).offset;
+
+  ColumnReaderStats* stats = ColumnStats(i);
+  ScopedStopWatch io_watch(StatsCounter(stats, &ColumnReaderStats::io_time));
+  std::vector<std::unique_ptr<PageReader>> readers;
+  if (col->has_dictionary_page() &&
+      col->dictionary_page_offset() < col->data_page_offset()) {
+    // The dictionary page precedes the first data page
+    ReadRange dict_range = {col->dictionary_page_offset(),
+                            col->data_page_offset() - col->dictionary_page_offset()};
+    std::unique_ptr<SerializedPageReader> dict_reader =
+        MakePageReader(GetStream(dict_range), *col);
+    dict_reader->set_stats(stats);
+    readers.push_back(std::move(dict_reader));
+  }
+  int64_t page_offset = offset_index.page_location(page).offset;
+  std::unique_ptr<SerializedPageReader> data_reader =
+      MakePageReader(GetStream({page_offset, data_end - page_offset}), *col);
+  data_reader->set_stats(stats);
+  readers.push_back(std::move(data_reader));
+  return std::unique_ptr<PageReader>(new ChainedPageReader(std::move(readers)));
+}
+
+std::unique_ptr<ColumnIndex> SerializedRowGroup::GetColumnIndex(int i) {
+  auto col = row_group_metadata_->ColumnChunk(i);
+  if (!col->has_column_index()) {
+    return nullptr;
+  }
+  std::shared_ptr<Buffer> buffer =
+      source_->ReadAt(col->column_index_offset(), col->column_index_length());
+  uint32_t length = static_cast<uint32_t>(buffer->size());
+  return ColumnIndex::Make(row_group_metadata_->schema()->Column(i), buffer->data(),
+                           &length);
+}
+
+std::unique_ptr<OffsetIndex> SerializedRowGroup::ScanOffsetIndex(int i) {
+  if (row_group_metadata_->schema()->Column(i)->max_repetition_level() > 0) {
+    // The rows of a page are only known from the levels of repeated columns
+    return nullptr;
+  }
+  ReadRange col_range = ColumnChunkRange(i);
+  std::unique_ptr<SerializedPageReader> page_reader =
+      MakePageReader(GetStream(col_range), *row_group_metadata_->ColumnChunk(i));
+  std::vector<PageLocation> locations = page_reader->ScanDataPages();
+  for (PageLocation& location : locations) {
+    location.offset += col_range.offset;
+  }
+  return std::unique_ptr<OffsetIndex>(new OffsetIndex(locations));
+}
+
+std::unique_ptr<OffsetIndex> SerializedRowGroup::GetOffsetIndex(int i) {
+  auto col = row_group_metadata_->ColumnChunk(i);
+  if (!col->has_offset_index()) {
+    return nullptr;
+  }
+  std::shared_ptr<Buffer> buffer =
+      source_->ReadAt(col->offset_index_offset(), col->offset_index_length());
+  uint32_t length = static_cast<uint32_t>(buffer->size());
+  return OffsetIndex::Make(buffer->data(), &length);
+}
+
+// Enough for any BloomFilterHeader, used when the length of the filter is
+// not in the metadata
+static constexpr int64_t kBloomFilterHeaderReadSize = 256;
+
+std::unique_ptr<BloomFilter> SerializedRowGroup::GetBloomFilter(int i) {
+  auto col = row_group_metadata_->ColumnChunk(i);
+  if (!col->has_bloom_filter()) {
+    return nullptr;
+  }
+  int64_t offset = col->bloom_filter_offset();
+  int64_t length = col->bloom_filter_length();
+  if (length <= 0) {
+    std::shared_ptr<Buffer> header = source_->ReadAt(
+        offset, std::min<int64_t>(kBloomFilterHeaderReadSize, source_->Size() - offset));
+    uint32_t header_length = static_cast<uint32_t>(header->size());
+    uint32_t num_bytes = BloomFilter::DeserializeHeader(header->data(), &header_length);
+    length = header_length + num_bytes;
+  }
+  std::shared_ptr<Buffer> buffer = source_->ReadAt(offset, length);
+  uint32_t buffer_length = static_cast<uint32_t>(buffer->size());
+  return BloomFilter::Deserialize(buffer->data(), &buffer_length,
+                                  properties_.memory_pool());
+}
+
+// Size of the blocks in which column chunks are copied
+static constexpr int64_t kCopyBlockSize = 1 << 20;
+
+int64_t SerializedRowGroup::CopyColumnChunk(int i, OutputStream* sink) {
+  // The padded range of PARQUET-816 would spill over the next chunk
+  const ApplicationVersion& version = file_metadata_->writer_version();
+  if (version.VersionLt(ApplicationVersion::PARQUET_816_FIXED_VERSION)) {
+    throw ParquetException(
+        "Column chunks of files written by parquet-mr 1.2.8 and below cannot be "
+        "copied, their size is not known");
+  }
+  ReadRange range = ColumnChunkRange(i);
+  std::unique_ptr<InputStream> stream = GetStream(range);
+  int64_t remaining = range.length;
+  while (remaining > 0) {
+    int64_t bytes_read;
+    const uint8_t* data =
+        stream->Read(std::min<int64_t>(kCopyBlockSize, remaining), &bytes_read);
+    if (bytes_read <= 0) {
+      throw ParquetException("Unable to read column chunk data");
+    }
+    sink->Write(data, bytes_read);
+    remaining -= bytes_read;
+  }
+  return range.length;
 }
 
 // ----------------------------------------------------------------------
 // SerializedFile: Parquet on-disk layout
 
-// PARQUET-978: Minimize footer reads by reading 64 KB from the end of the file
-static constexpr int64_t DEFAULT_FOOTER_READ_SIZE = 64 * 1024;
 static constexpr uint32_t FOOTER_SIZE = 8;
 static constexpr uint8_t PARQUET_MAGIC[4] = {'P', 'A', 'R', '1'};
 
@@ -249,17 +902,42 @@ SerializedFile::~SerializedFile() {
 }
 
 std::shared_ptr<RowGroupReader> SerializedFile::GetRowGroup(int i) {
-  std::unique_ptr<SerializedRowGroup> contents(
-      new SerializedRowGroup(source_.get(), file_metadata_.get(), i, properties_));
+  std::unique_ptr<SerializedRowGroup> contents(new SerializedRowGroup(
+      source_.get(), file_metadata_.get(), i, properties_, cached_source_.get()));
   return std::make_shared<RowGroupReader>(std::move(contents));
 }
 
 std::shared_ptr<FileMetaData> SerializedFile::metadata() const { return file_metadata_; }
 
+void SerializedFile::PreBuffer(const std::vector<int>& row_groups,
+                               const std::vector<int>& column_indices) {
+  std::vector<ReadRange> ranges;
+  for (int row_group : row_groups) {
+    SerializedRowGroup row_group_contents(source_.get(), file_metadata_.get(), row_group,
+                                          properties_);
+    for (int column : column_indices) {
+      ranges.push_back(row_group_contents.ColumnChunkRange(column));
+    }
+  }
+
+  if (!cached_source_) {
+    cached_source_.reset(new ReadRangeCache(source_.get(),
+                                            properties_.coalesce_hole_size_limit(),
+                                            properties_.coalesce_range_size_limit()));
+  }
+  cached_source_->Cache(ranges);
+}
+
 SerializedFile::SerializedFile(
     std::unique_ptr<RandomAccessSource> source,
     const ReaderProperties& props = default_reader_properties())
-    : source_(std::move(source)), properties_(props) {}
+    : source_(std::move(source)), properties_(props) {
+  // The columns of all row groups share the decompression buffers
+  if (properties_.decompression_buffer_pool() == nullptr) {
+    properties_.set_decompression_buffer_pool(
+        std::make_shared<DecompressionBufferPool>(properties_.memory_pool()));
+  }
+}
 
 void SerializedFile::ParseMetaData() {
   int64_t file_size = source_->Size();
@@ -268,19 +946,22 @@ void SerializedFile::ParseMetaData() {
     throw ParquetException("Corrupted file, smaller than file footer");
   }
 
-  uint8_t footer_buffer[DEFAULT_FOOTER_READ_SIZE];
-  int64_t footer_read_size = std::min(file_size, DEFAULT_FOOTER_READ_SIZE);
-  int64_t bytes_read =
-      source_->ReadAt(file_size - footer_read_size, footer_read_size, footer_buffer);
+  // Speculatively read the tail of the file, in the hope that it covers the
+  // whole file metadata
+  int64_t footer_read_size = std::min(
+      file_size,
+      std::max(properties_.footer_read_size(), static_cast<int64_t>(FOOTER_SIZE)));
+  std::shared_ptr<Buffer> footer_buffer =
+      source_->ReadAt(file_size - footer_read_size, footer_read_size);
 
   // Check if all bytes are read. Check if last 4 bytes read have the magic bits
-  if (bytes_read != footer_read_size ||
-      memcmp(footer_buffer + footer_read_size - 4, PARQUET_MAGIC, 4) != 0) {
+  if (footer_buffer->size() != footer_read_size ||
+      memcmp(footer_buffer->data() + footer_read_size - 4, PARQUET_MAGIC, 4) != 0) {
     throw ParquetException("Invalid parquet file. Corrupt footer.");
   }
 
-  uint32_t metadata_len =
-      *reinterpret_cast<uint32_t*>(footer_buffer + footer_read_size - FOOTER_SIZE);
+  uint32_t metadata_len = *reinterpret_cast<const uint32_t*>(
+      footer_buffer->data() + footer_read_size - FOOTER_SIZE);
   int64_t metadata_start = file_size - FOOTER_SIZE - metadata_len;
   if (FOOTER_SIZE + metadata_len > file_size) {
     throw ParquetException(
@@ -288,22 +969,20 @@ void SerializedFile::ParseMetaData() {
         "file metadata size.");
   }
 
-  std::shared_ptr<PoolBuffer> metadata_buffer =
-      AllocateBuffer(properties_.memory_pool(), metadata_len);
-
   // Check if the footer_buffer contains the entire metadata
+  std::shared_ptr<Buffer> metadata_buffer;
   if (footer_read_size >= (metadata_len + FOOTER_SIZE)) {
-    memcpy(metadata_buffer->mutable_data(),
-           footer_buffer + (footer_read_size - metadata_len - FOOTER_SIZE), metadata_len);
+    metadata_buffer = std::make_shared<Buffer>(
+        footer_buffer, footer_read_size - metadata_len - FOOTER_SIZE, metadata_len);
   } else {
-    bytes_read =
-        source_->ReadAt(metadata_start, metadata_len, metadata_buffer->mutable_data());
-    if (bytes_read != metadata_len) {
+    metadata_buffer = source_->ReadAt(metadata_start, metadata_len);
+    if (metadata_buffer->size() != metadata_len) {
       throw ParquetException("Invalid parquet file. Could not read metadata bytes.");
     }
   }
 
-  file_metadata_ = FileMetaData::Make(metadata_buffer->data(), &metadata_len);
+  file_metadata_ = FileMetaData::Make(metadata_buffer->data(), &metadata_len,
+                                      properties_.is_lazy_metadata_enabled());
 }
 
 }  // namespace parquet
@@ -20,6 +20,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #include "parquet/column_page.h"
@@ -29,6 +30,7 @@
 #include "parquet/properties.h"
 #include "parquet/types.h"
 #include "parquet/util/memory.h"
+#include "parquet/util/thread-pool.h"
 #include "parquet/util/visibility.h"
 
 namespace arrow {
@@ -38,6 +40,8 @@ class Codec;
 
 namespace parquet {
 
+class ThriftDeserializer;
+
 // 16 MB is the default maximum page header size
 static constexpr uint32_t DEFAULT_MAX_PAGE_HEADER_SIZE = 16 * 1024 * 1024;
 
@@ -53,22 +57,70 @@ class PARQUET_EXPORT SerializedPageReader : public PageReader {
                        Compression::type codec,
                        ::arrow::MemoryPool* pool = ::arrow::default_memory_pool());
 
-  virtual ~SerializedPageReader() {}
+  virtual ~SerializedPageReader();
 
   // Implement the PageReader interface
   virtual std::shared_ptr<Page> NextPage();
 
   void set_max_page_header_size(uint32_t size) { max_page_header_size_ = size; }
 
+  // If set, every returned page owns its data buffer, which stays valid after
+  // subsequent calls to NextPage. Otherwise the buffer may be reused.
+  void set_detach_page_buffers(bool detach) { detach_page_buffers_ = detach; }
+
+  // If set, uncompressed pages reference the stream's memory (see
+  // InputStream::ReadSlice) instead of being copied or wrapped. Enabled for
+  // zero-copy sources such as memory maps.
+  void set_zero_copy(bool zero_copy) { zero_copy_ = zero_copy; }
+
+  // If set, each decompressed page leases its buffer from the pool until the
+  // page is released, and owns it as if its buffer was detached
+  void set_decompression_buffer_pool(
+      const std::shared_ptr<DecompressionBufferPool>& buffer_pool) {
+    decompression_buffer_pool_ = buffer_pool;
+  }
+
+  // Count the pages read and skipped, and time their reads and decompression
+  void set_stats(ColumnReaderStats* stats) { stats_ = stats; }
+
+  // If set, dictionary pages are skipped after their header is parsed, and
+  // the buffers of DATA_PAGE_V2 pages only hold their levels, the values
+  // being neither decompressed nor copied
+  void set_levels_only(bool levels_only) override { levels_only_ = levels_only; }
+
+  // Data pages rejected by the filter are skipped right after their header
+  // is parsed
+  void set_data_page_filter(const DataPageFilter& filter) override {
+    data_page_filter_ = filter;
+  }
+
+  int64_t SkipDataPages(int64_t max_values) override;
+
+  // Parse the remaining page headers without reading the pages, and return
+  // the locations of the data pages, with offsets relative to the current
+  // position of the stream. The row indices assume a flat column, whose
+  // values are its rows.
+  std::vector<PageLocation> ScanDataPages();
+
  private:
+  // Parse the next page header into current_page_header_, unless a header
+  // parsed by SkipDataPages is still pending. Returns false at the end of
+  // the stream.
+  bool ReadPageHeader();
+
   std::unique_ptr<InputStream> stream_;
+  ::arrow::MemoryPool* pool_;
 
   format::PageHeader current_page_header_;
+  bool has_page_header_;
+  // Serialized size of current_page_header_
+  uint32_t current_page_header_size_;
   std::shared_ptr<Page> current_page_;
 
   // Compression codec to use.
   std::unique_ptr<::arrow::Codec> decompressor_;
   std::shared_ptr<PoolBuffer> decompression_buffer_;
+  std::shared_ptr<DecompressionBufferPool> decompression_buffer_pool_;
 
   // Maximum allowed page size
   uint32_t max_page_header_size_;
@@ -78,13 +130,120 @@ class PARQUET_EXPORT SerializedPageReader : public PageReader {
 
   // Number of rows in all the data pages
   int64_t total_num_rows_;
+
+  bool detach_page_buffers_;
+  bool zero_copy_;
+  bool levels_only_;
+
+  DataPageFilter data_page_filter_;
+
+  // Not owned, nullptr unless statistics are collected
+  ColumnReaderStats* stats_;
+
+  // Reused for every page header
+  std::unique_ptr<ThriftDeserializer> header_deserializer_;
+};
+
+// Reads and decompresses the pages of a SerializedPageReader on the threads of
+// ThreadPool::Default(), keeping at most max_pages pages (or, beyond the first
+// page, max_bytes bytes) ahead of the consumer. At most one task of the pool
+// reads ahead at a time. When no page is ready and no task is reading, the
+// consumer reads the next page itself, so that it never waits on a task
+// queued behind busy workers.
+class PARQUET_EXPORT PrefetchingPageReader : public PageReader {
+ public:
+  PrefetchingPageReader(std::unique_ptr<SerializedPageReader> reader, int max_pages,
+                        int64_t max_bytes);
+
+  // Waits for the page being read ahead, if any
+  virtual ~PrefetchingPageReader();
+
+  // Implement the PageReader interface. Exceptions raised while reading ahead
+  // are rethrown here.
+  //
+  // The data page filter is not supported as pages are read before it could
+  // be applied.
+  std::shared_ptr<Page> NextPage() override;
+
+ private:
+  // Shared with the tasks of the pool, which may only start after the
+  // destruction of the reader
+  struct State;
+
+  std::shared_ptr<State> state_;
+  std::shared_ptr<ThreadPool> pool_;
+};
+
+// Returns the pages of each of the readers in turn. The readers are kept
+// until destruction, so that the pages they returned stay valid.
+class PARQUET_EXPORT ChainedPageReader : public PageReader {
+ public:
+  explicit ChainedPageReader(std::vector<std::unique_ptr<PageReader>> readers);
+
+  std::shared_ptr<Page> NextPage() override;
+
+  void set_data_page_filter(const DataPageFilter& filter) override;
+
+  // Only skips pages of the current reader
+  int64_t SkipDataPages(int64_t max_values) override;
+
+  void set_levels_only(bool levels_only) override;
+
+ private:
+  std::vector<std::unique_ptr<PageReader>> readers_;
+  size_t current_reader_;
+};
+
+// A contiguous byte range [offset, offset + length) of a file
+struct PARQUET_EXPORT ReadRange {
+  int64_t offset;
+  int64_t length;
+};
+
+// Sort the ranges by offset and merge the ones that overlap or that are
+// separated by at most hole_size_limit bytes. A merged range is not grown past
+// range_size_limit bytes, but ranges that are larger on their own are kept
+// intact.
+PARQUET_EXPORT
+std::vector<ReadRange> CoalesceReadRanges(std::vector<ReadRange> ranges,
+                                          int64_t hole_size_limit,
+                                          int64_t range_size_limit);
+
+// Holds the result of a few large coalesced reads and hands out zero-copy
+// slices of them for the byte ranges that were requested. Thread-safe.
+class PARQUET_EXPORT ReadRangeCache {
+ public:
+  ReadRangeCache(RandomAccessSource* source, int64_t hole_size_limit,
+                 int64_t range_size_limit);
+
+  // Coalesce the ranges and read them eagerly from the source
+  void Cache(const std::vector<ReadRange>& ranges);
+
+  // Returns a slice of the cached data covering the range, or nullptr if the
+  // range was not entirely pre-buffered
+  std::shared_ptr<Buffer> Read(const ReadRange& range) const;
+
+ private:
+  struct Entry {
+    ReadRange range;
+    std::shared_ptr<Buffer> buffer;
+  };
+
+  RandomAccessSource* source_;
+  int64_t hole_size_limit_;
+  int64_t range_size_limit_;
+
+  // Sorted by range offset
+  std::vector<Entry> entries_;
+  mutable std::mutex mutex_;
 };
 
 // RowGroupReader::Contents implementation for the Parquet file specification
 class PARQUET_EXPORT SerializedRowGroup : public RowGroupReader::Contents {
  public:
   SerializedRowGroup(RandomAccessSource* source, FileMetaData* file_metadata,
-                     int row_group_number, const ReaderProperties& props);
+                     int row_group_number, const ReaderProperties& props,
+                     const ReadRangeCache* cached_source = nullptr);
 
   virtual const RowGroupMetaData* metadata() const;
 
@@ -92,11 +251,44 @@ class PARQUET_EXPORT SerializedRowGroup : public RowGroupReader::Contents {
 
   virtual std::unique_ptr<PageReader> GetColumnPageReader(int i);
 
+  std::unique_ptr<PageReader> GetColumnPageReaderAt(int i,
+                                                    const OffsetIndex& offset_index,
+                                                    int page, int end_page) override;
+
+  std::unique_ptr<ColumnIndex> GetColumnIndex(int i) override;
+
+  std::unique_ptr<OffsetIndex> GetOffsetIndex(int i) override;
+
+  std::unique_ptr<OffsetIndex> ScanOffsetIndex(int i) override;
+
+  std::unique_ptr<BloomFilter> GetBloomFilter(int i) override;
+
+  int64_t CopyColumnChunk(int i, OutputStream* sink) override;
+
+  // The byte range of the i-th column chunk, including the dictionary page
+  ReadRange ColumnChunkRange(int i) const;
+
  private:
+  // Read through the pre-buffered data if it covers the range
+  std::unique_ptr<InputStream> GetStream(const ReadRange& range);
+
+  std::unique_ptr<SerializedPageReader> MakePageReader(
+      std::unique_ptr<InputStream> stream, const ColumnChunkMetaData& col);
+
+  // The counters of the i-th column, nullptr unless statistics are collected
+  ColumnReaderStats* ColumnStats(int i);
+
+  // Pass the access hints of a scan of the i-th column chunk to the source if
+  // enabled: the next chunks of the column will be needed, the previous one
+  // will not
+  void AdviseColumnChunkScan(int i);
+
   RandomAccessSource* source_;
   FileMetaData* file_metadata_;
+  int row_group_number_;
   std::unique_ptr<RowGroupMetaData> row_group_metadata_;
   ReaderProperties properties_;
+  const ReadRangeCache* cached_source_;
 };
 
 // An implementation of ParquetFileReader::Contents that deals with the Parquet
@@ -114,6 +306,8 @@ class PARQUET_EXPORT SerializedFile : public ParquetFileReader::Contents {
   void Close() override;
   std::shared_ptr<RowGroupReader> GetRowGroup(int i) override;
   std::shared_ptr<FileMetaData> metadata() const override;
+  void PreBuffer(const std::vector<int>& row_groups,
+                 const std::vector<int>& column_indices) override;
   virtual ~SerializedFile();
 
  private:
@@ -124,6 +318,7 @@ class PARQUET_EXPORT SerializedFile : public ParquetFileReader::Contents {
   std::unique_ptr<RandomAccessSource> source_;
   std::shared_ptr<FileMetaData> file_metadata_;
   ReaderProperties properties_;
+  std::unique_ptr<ReadRangeCache> cached_source_;
 
   void ParseMetaData();
 };
@@ -17,11 +17,16 @@
 
 #include "parquet/file/reader.h"
 
+#include <sys/stat.h>
+
+#include <chrono>
 #include <cstdio>
 #include <memory>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "arrow/io/file.h"
 
@@ -33,6 +38,7 @@
 #include "parquet/types.h"
 #include "parquet/util/logging.h"
 #include "parquet/util/memory.h"
+#include "parquet/util/thread-pool.h"
 
 using std::string;
 
@@ -51,9 +57,63 @@ std::shared_ptr<ColumnReader> RowGroupReader::Column(int i) {
   const ColumnDescriptor* descr = metadata()->schema()->Column(i);
 
   std::unique_ptr<PageReader> page_reader = contents_->GetColumnPageReader(i);
-  return ColumnReader::Make(
-      descr, std::move(page_reader),
-      const_cast<ReaderProperties*>(contents_->properties())->memory_pool());
+  return MakeColumnReader(i, descr, std::move(page_reader));
+}
+
+std::unique_ptr<ColumnIndex> RowGroupReader::GetColumnIndex(int i) {
+  return contents_->GetColumnIndex(i);
+}
+
+std::unique_ptr<OffsetIndex> RowGroupReader::GetOffsetIndex(int i) {
+  return contents_->GetOffsetIndex(i);
+}
+
+std::unique_ptr<OffsetIndex> RowGroupReader::ScanOffsetIndex(int i) {
+  return contents_->ScanOffsetIndex(i);
+}
+
+std::unique_ptr<BloomFilter> RowGroupReader::GetBloomFilter(int i) {
+  return contents_->GetBloomFilter(i);
+}
+
+std::unique_ptr<PageReader> RowGroupReader::GetColumnPageReader(int i) {
+  return contents_->GetColumnPageReader(i);
+}
+
+int64_t RowGroupReader::CopyColumnChunk(int i, OutputStream* sink) {
+  return contents_->CopyColumnChunk(i, sink);
+}
+
+std::shared_ptr<ColumnReader> RowGroupReader::ColumnFromPage(
+    int i, const OffsetIndex& offset_index, int page, int end_page) {
+  const ColumnDescriptor* descr = metadata()->schema()->Column(i);
+
+  std::unique_ptr<PageReader> page_reader =
+      contents_->GetColumnPageReaderAt(i, offset_index, page, end_page);
+  return MakeColumnReader(i, descr, std::move(page_reader));
+}
+
+std::shared_ptr<ColumnReader> RowGroupReader::MakeColumnReader(
+    int i, const ColumnDescriptor* descr, std::unique_ptr<PageReader> page_reader) {
+  const ReaderProperties* properties = contents_->properties();
+  std::shared_ptr<ColumnReader> reader =
+      ColumnReader::Make(descr, std::move(page_reader),
+                         const_cast<ReaderProperties*>(properties)->memory_pool());
+  if (properties->reader_stats() != nullptr) {
+    reader->set_stats(properties->reader_stats()->column(i));
+  }
+  return reader;
+}
+
+std::unique_ptr<PageReader> RowGroupReader::Contents::GetColumnPageReaderAt(
+    int i, const OffsetIndex& offset_index, int page, int end_page) {
+  ParquetException::NYI("Reading a column chunk from a page of its offset index");
+  return nullptr;
+}
+
+int64_t RowGroupReader::Contents::CopyColumnChunk(int i, OutputStream* sink) {
+  ParquetException::NYI("Copying the pages of a column chunk");
+  return 0;
 }
 
 // Returns the rowgroup metadata
@@ -91,14 +151,14 @@ std::unique_ptr<ParquetFileReader> ParquetFileReader::OpenFile(
     const std::shared_ptr<FileMetaData>& metadata) {
   std::shared_ptr<::arrow::io::ReadableFileInterface> source;
   if (memory_map) {
-    std::shared_ptr<::arrow::io::ReadableFile> handle;
+    std::shared_ptr<::arrow::io::MemoryMappedFile> handle;
     PARQUET_THROW_NOT_OK(
-        ::arrow::io::ReadableFile::Open(path, props.memory_pool(), &handle));
+        ::arrow::io::MemoryMappedFile::Open(path, ::arrow::io::FileMode::READ, &handle));
     source = handle;
   } else {
-    std::shared_ptr<::arrow::io::MemoryMappedFile> handle;
+    std::shared_ptr<::arrow::io::ReadableFile> handle;
     PARQUET_THROW_NOT_OK(
-        ::arrow::io::MemoryMappedFile::Open(path, ::arrow::io::FileMode::READ, &handle));
+        ::arrow::io::ReadableFile::Open(path, props.memory_pool(), &handle));
     source = handle;
   }
 
@@ -119,6 +179,21 @@ std::shared_ptr<FileMetaData> ParquetFileReader::metadata() const {
   return contents_->metadata();
 }
 
+void ParquetFileReader::PreBuffer(const std::vector<int>& row_groups,
+                                  const std::vector<int>& column_indices) {
+  for (int i : row_groups) {
+    DCHECK(i < metadata()->num_row_groups()) << "The file only has "
+                                             << metadata()->num_row_groups()
+                                             << "row groups, requested: " << i;
+  }
+  for (int i : column_indices) {
+    DCHECK(i < metadata()->num_columns()) << "The file only has "
+                                          << metadata()->num_columns()
+                                          << "columns, requested: " << i;
+  }
+  contents_->PreBuffer(row_groups, column_indices);
+}
+
 std::shared_ptr<RowGroupReader> ParquetFileReader::RowGroup(int i) {
   DCHECK(i < metadata()->num_row_groups()) << "The file only has "
                                            << metadata()->num_row_groups()
@@ -134,6 +209,117 @@ std::shared_ptr<FileMetaData> ReadMetaData(
   return ParquetFileReader::Open(source)->metadata();
 }
 
+// ----------------------------------------------------------------------
+// FileMetaDataCache
+
+FileMetaDataCache::FileMetaDataCache(int64_t capacity) : capacity_(capacity), size_(0) {}
+
+std::shared_ptr<FileMetaData> FileMetaDataCache::Get(const std::string& path,
+                                                     int64_t file_size, int64_t mtime) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = index_.find(path);
+  if (it == index_.end()) {
+    return nullptr;
+  }
+  const Entry& entry = *it->second;
+  if (entry.file_size != file_size || entry.mtime != mtime) {
+    return nullptr;
+  }
+  // Move to the front of the LRU list
+  entries_.splice(entries_.begin(), entries_, it->second);
+  return entry.metadata;
+}
+
+void FileMetaDataCache::Put(const std::string& path, int64_t file_size, int64_t mtime,
+                            const std::shared_ptr<FileMetaData>& metadata) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = index_.find(path);
+  if (it != index_.end()) {
+    size_ -= it->second->metadata->size();
+    entries_.erase(it->second);
+    index_.erase(it);
+  }
+  entries_.push_front({path, file_size, mtime, metadata});
+  index_[path] = entries_.begin();
+  size_ += metadata->size();
+  EvictIfNeeded();
+}
+
+void FileMetaDataCache::EvictIfNeeded() {
+  // Always keep the most recent entry
+  while (size_ > capacity_ && entries_.size() > 1) {
+    const Entry& entry = entries_.back();
+    size_ -= entry.metadata->size();
+    index_.erase(entry.path);
+    entries_.pop_back();
+  }
+}
+
+std::shared_ptr<FileMetaData> FileMetaDataCache::GetOrRead(
+    const std::string& path, const ReaderProperties& props) {
+  struct stat file_stat;
+  if (stat(path.c_str(), &file_stat) != 0) {
+    std::stringstream ss;
+    ss << "Could not stat file: " << path;
+    throw ParquetException(ss.str());
+  }
+  int64_t file_size = static_cast<int64_t>(file_stat.st_size);
+  int64_t mtime = static_cast<int64_t>(file_stat.st_mtime);
+
+  std::shared_ptr<FileMetaData> metadata = Get(path, file_size, mtime);
+  if (metadata == nullptr) {
+    // Parse the footer outside of the lock; concurrent misses for the same
+    // file may read it more than once
+    metadata = ParquetFileReader::OpenFile(path, false, props)->metadata();
+    Put(path, file_size, mtime, metadata);
+  }
+  return metadata;
+}
+
+void FileMetaDataCache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.clear();
+  index_.clear();
+  size_ = 0;
+}
+
+int64_t FileMetaDataCache::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return size_;
+}
+
+int FileMetaDataCache::num_entries() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return static_cast<int>(entries_.size());
+}
+
+// ----------------------------------------------------------------------
+// Summary files
+
+std::vector<SummaryDataFile> SplitSummaryMetaData(const FileMetaData& summary) {
+  std::vector<std::string> file_paths;
+  std::unordered_map<std::string, std::vector<int>> row_groups;
+  for (int i = 0; i < summary.num_row_groups(); ++i) {
+    std::unique_ptr<RowGroupMetaData> row_group = summary.RowGroup(i);
+    if (row_group->num_columns() == 0) {
+      continue;
+    }
+    // All column chunks of a row group are in the same file
+    std::string file_path = row_group->ColumnChunk(0)->file_path();
+    auto insertion = row_groups.emplace(file_path, std::vector<int>());
+    if (insertion.second) {
+      file_paths.push_back(file_path);
+    }
+    insertion.first->second.push_back(i);
+  }
+
+  std::vector<SummaryDataFile> result;
+  for (const std::string& file_path : file_paths) {
+    result.push_back({file_path, summary.Subset(row_groups[file_path])});
+  }
+  return result;
+}
+
 // ----------------------------------------------------------------------
 // File scanner for performance testing
 
@@ -182,4 +368,106 @@ int64_t ScanFileContents(std::vector<int> columns, const int32_t column_batch_si
   return total_rows[0];
 }
 
+using ScanClock = std::chrono::steady_clock;
+
+static double SecondsSince(ScanClock::time_point start) {
+  return std::chrono::duration<double>(ScanClock::now() - start).count();
+}
+
+namespace {
+
+// Times the reads of the wrapped page reader, and counts the bytes of the
+// returned pages
+class TimedPageReader : public PageReader {
+ public:
+  TimedPageReader(std::unique_ptr<PageReader> pager, ColumnScanStats* stats)
+      : pager_(std::move(pager)), stats_(stats) {}
+
+  std::shared_ptr<Page> NextPage() override {
+    ScanClock::time_point start = ScanClock::now();
+    std::shared_ptr<Page> page = pager_->NextPage();
+    stats_->decompression_seconds += SecondsSince(start);
+    if (page != nullptr) {
+      stats_->decompressed_bytes += page->size();
+    }
+    return page;
+  }
+
+ private:
+  std::unique_ptr<PageReader> pager_;
+  ColumnScanStats* stats_;
+};
+
+}  // namespace
+
+int64_t ScanFileContents(std::vector<int> columns, const int32_t column_batch_size,
+                         ParquetFileReader* reader, int num_threads,
+                         std::vector<ColumnScanStats>* stats) {
+  if (columns.size() == 0) {
+    columns.resize(reader->metadata()->num_columns());
+    for (size_t i = 0; i < columns.size(); i++) {
+      columns[i] = static_cast<int>(i);
+    }
+  }
+  int num_columns = static_cast<int>(columns.size());
+  int num_row_groups = reader->metadata()->num_row_groups();
+
+  // One task per row group and column, merged per column once all are done
+  int num_tasks = num_row_groups * num_columns;
+  std::vector<ColumnScanStats> task_stats(num_tasks);
+  std::vector<int64_t> task_rows(num_tasks, 0);
+  PARQUET_THROW_NOT_OK(ParallelFor(
+      ThreadPool::Default().get(), num_threads, num_tasks, [&](int task) {
+        int column = columns[task % num_columns];
+        ColumnScanStats* column_stats = &task_stats[task];
+        std::shared_ptr<RowGroupReader> group_reader =
+            reader->RowGroup(task / num_columns);
+        const ColumnDescriptor* descr = reader->metadata()->schema()->Column(column);
+        column_stats->bytes_read =
+            group_reader->metadata()->ColumnChunk(column)->total_compressed_size();
+
+        ScanClock::time_point start = ScanClock::now();
+        std::unique_ptr<PageReader> pager = group_reader->GetColumnPageReader(column);
+        column_stats->io_seconds = SecondsSince(start);
+
+        start = ScanClock::now();
+        std::shared_ptr<ColumnReader> col_reader = ColumnReader::Make(
+            descr, std::unique_ptr<PageReader>(
+                       new TimedPageReader(std::move(pager), column_stats)));
+        std::vector<int16_t> rep_levels(column_batch_size);
+        std::vector<int16_t> def_levels(column_batch_size);
+        std::vector<uint8_t> values(column_batch_size *
+                                    GetTypeByteSize(descr->physical_type()));
+        int64_t values_read = 0;
+        while (col_reader->HasNext()) {
+          task_rows[task] +=
+              ScanAllValues(column_batch_size, def_levels.data(), rep_levels.data(),
+                            values.data(), &values_read, col_reader.get());
+        }
+        // The time spent in the page reader is not decoding
+        column_stats->decode_seconds =
+            SecondsSince(start) - column_stats->decompression_seconds;
+        return ::arrow::Status::OK();
+      }));
+
+  stats->assign(num_columns, ColumnScanStats());
+  std::vector<int64_t> total_rows(num_columns, 0);
+  for (int task = 0; task < num_tasks; ++task) {
+    int col = task % num_columns;
+    ColumnScanStats& column_stats = (*stats)[col];
+    column_stats.bytes_read += task_stats[task].bytes_read;
+    column_stats.decompressed_bytes += task_stats[task].decompressed_bytes;
+    column_stats.io_seconds += task_stats[task].io_seconds;
+    column_stats.decompression_seconds += task_stats[task].decompression_seconds;
+    column_stats.decode_seconds += task_stats[task].decode_seconds;
+    total_rows[col] += task_rows[task];
+  }
+  for (int i = 1; i < num_columns; ++i) {
+    if (total_rows[0] != total_rows[i]) {
+      throw ParquetException("Parquet error: Total rows among columns do not match");
+    }
+  }
+  return num_columns > 0 ? total_rows[0] : 0;
+}
+
 }  // namespace parquet
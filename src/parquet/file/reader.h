@@ -22,11 +22,16 @@
 #include <iosfwd>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include "parquet/bloom_filter.h"
 #include "parquet/column_page.h"
 #include "parquet/file/metadata.h"
+#include "parquet/file/page_index.h"
 #include "parquet/properties.h"
 #include "parquet/schema.h"
 #include "parquet/statistics.h"
@@ -37,6 +42,12 @@ namespace parquet {
 
 class ColumnReader;
 
+// The rows [offset, offset + length) of a row group
+struct PARQUET_EXPORT RowRange {
+  int64_t offset;
+  int64_t length;
+};
+
 class PARQUET_EXPORT RowGroupReader {
  public:
   // Forward declare a virtual class 'Contents' to aid dependency injection and more
@@ -47,6 +58,20 @@ class PARQUET_EXPORT RowGroupReader {
     virtual std::unique_ptr<PageReader> GetColumnPageReader(int i) = 0;
     virtual const RowGroupMetaData* metadata() const = 0;
     virtual const ReaderProperties* properties() const = 0;
+    // The pages of the i-th column chunk from the given page of the offset
+    // index up to end_page (excluded, -1 for the end of the chunk), preceded
+    // by the dictionary page if any
+    virtual std::unique_ptr<PageReader> GetColumnPageReaderAt(
+        int i, const OffsetIndex& offset_index, int page, int end_page);
+    // nullptr if the column chunk has no page index
+    virtual std::unique_ptr<ColumnIndex> GetColumnIndex(int i) { return nullptr; }
+    virtual std::unique_ptr<OffsetIndex> GetOffsetIndex(int i) { return nullptr; }
+    // nullptr if the page headers cannot be scanned
+    virtual std::unique_ptr<OffsetIndex> ScanOffsetIndex(int i) { return nullptr; }
+    // nullptr if the column chunk has no Bloom filter
+    virtual std::unique_ptr<BloomFilter> GetBloomFilter(int i) { return nullptr; }
+    // Write the serialized pages of the i-th column chunk to the sink
+    virtual int64_t CopyColumnChunk(int i, OutputStream* sink);
   };
 
   explicit RowGroupReader(std::unique_ptr<Contents> contents);
@@ -58,7 +83,46 @@ class PARQUET_EXPORT RowGroupReader {
   // column. Ownership is shared with the RowGroupReader.
   std::shared_ptr<ColumnReader> Column(int i);
 
+  // The page index of the i-th column chunk, nullptr if it was not written
+  // (see WriterProperties::Builder::enable_page_index)
+  std::unique_ptr<ColumnIndex> GetColumnIndex(int i);
+  std::unique_ptr<OffsetIndex> GetOffsetIndex(int i);
+
+  // Build the offset index of the i-th column chunk by parsing its page
+  // headers, for files written without a page index. The pages themselves are
+  // not decompressed. Returns nullptr for repeated columns, whose page
+  // headers do not tell the number of rows.
+  std::unique_ptr<OffsetIndex> ScanOffsetIndex(int i);
+
+  // The Bloom filter of the i-th column chunk, nullptr if it was not written
+  // (see WriterProperties::Builder::enable_bloom_filter). A chunk can be
+  // skipped for an equality lookup if
+  //
+  //   !filter->FindHash(BloomFilterHash<DType>(descr, value))
+  std::unique_ptr<BloomFilter> GetBloomFilter(int i);
+
+  // The pages of the i-th column chunk, decompressed but not decoded
+  std::unique_ptr<PageReader> GetColumnPageReader(int i);
+
+  // Write the pages of the i-th column chunk to the sink exactly as they are
+  // stored, without decompressing them, and return the number of bytes
+  // written (see ParquetFileWriter::CopyRowGroup)
+  int64_t CopyColumnChunk(int i, OutputStream* sink);
+
+  // Construct a ColumnReader for the i-th column that starts at the given page
+  // of the column chunk's offset index, that is at row
+  // offset_index.page_location(page).first_row_index. The pages before it are
+  // not read. Use OffsetIndex::FindPage to locate the page holding a row, and
+  // ColumnIndex::FindPages the pages holding a range of values. Given an
+  // end_page, only the pages before it are read, from their own byte range.
+  std::shared_ptr<ColumnReader> ColumnFromPage(int i, const OffsetIndex& offset_index,
+                                               int page, int end_page = -1);
+
  private:
+  // Attaches the column's counters of the reader properties' statistics
+  std::shared_ptr<ColumnReader> MakeColumnReader(int i, const ColumnDescriptor* descr,
+                                                 std::unique_ptr<PageReader> page_reader);
+
   // Holds a pointer to an instance of Contents implementation
   std::unique_ptr<Contents> contents_;
 };
@@ -74,6 +138,9 @@ class PARQUET_EXPORT ParquetFileReader {
     virtual void Close() = 0;
     virtual std::shared_ptr<RowGroupReader> GetRowGroup(int i) = 0;
     virtual std::shared_ptr<FileMetaData> metadata() const = 0;
+    // Eagerly read the indicated column chunks, see ParquetFileReader::PreBuffer
+    virtual void PreBuffer(const std::vector<int>& row_groups,
+                           const std::vector<int>& column_indices) {}
   };
 
   ParquetFileReader();
@@ -112,6 +179,16 @@ class PARQUET_EXPORT ParquetFileReader {
   // Returns the file metadata. Only one instance is ever created
   std::shared_ptr<FileMetaData> metadata() const;
 
+  // Plan and issue the reads for the indicated column chunks of the indicated
+  // row groups up front. Byte ranges that are close to each other (see
+  // ReaderProperties::coalesce_hole_size_limit) are merged into a few large
+  // reads, and the column readers subsequently created for these chunks are
+  // served from the cached buffers instead of reading from the source.
+  //
+  // The cached data is retained for the lifetime of the reader.
+  void PreBuffer(const std::vector<int>& row_groups,
+                 const std::vector<int>& column_indices);
+
  private:
   // Holds a pointer to an instance of Contents implementation
   std::unique_ptr<Contents> contents_;
@@ -121,6 +198,77 @@ class PARQUET_EXPORT ParquetFileReader {
 std::shared_ptr<FileMetaData> PARQUET_EXPORT
 ReadMetaData(const std::shared_ptr<::arrow::io::ReadableFileInterface>& source);
 
+// 64 MB of serialized file metadata
+static constexpr int64_t DEFAULT_METADATA_CACHE_CAPACITY = 64 * 1024 * 1024;
+
+// Thread-safe cache of parsed file metadata, keyed by file path along with the
+// size and modification time of the file so that rewritten files are not
+// served stale metadata. Entries are evicted in least-recently-used order
+// once the total serialized size of the cached metadata exceeds the capacity.
+//
+// The returned FileMetaData instances are immutable and can be shared by any
+// number of readers, see ParquetFileReader::Open.
+class PARQUET_EXPORT FileMetaDataCache {
+ public:
+  explicit FileMetaDataCache(int64_t capacity = DEFAULT_METADATA_CACHE_CAPACITY);
+
+  // Returns nullptr if the file is not cached
+  std::shared_ptr<FileMetaData> Get(const std::string& path, int64_t file_size,
+                                    int64_t mtime);
+
+  void Put(const std::string& path, int64_t file_size, int64_t mtime,
+           const std::shared_ptr<FileMetaData>& metadata);
+
+  // Stat the file at the path, and return its cached metadata or read and
+  // cache it if it is missing or outdated
+  std::shared_ptr<FileMetaData> GetOrRead(
+      const std::string& path,
+      const ReaderProperties& props = default_reader_properties());
+
+  void Clear();
+
+  int64_t capacity() const { return capacity_; }
+
+  // Total serialized size of the cached metadata
+  int64_t size() const;
+
+  int num_entries() const;
+
+ private:
+  struct Entry {
+    std::string path;
+    int64_t file_size;
+    int64_t mtime;
+    std::shared_ptr<FileMetaData> metadata;
+  };
+  typedef std::list<Entry> EntryList;
+
+  void EvictIfNeeded();
+
+  int64_t capacity_;
+  int64_t size_;
+
+  // Most recently used first
+  EntryList entries_;
+  std::unordered_map<std::string, EntryList::iterator> index_;
+  mutable std::mutex mutex_;
+};
+
+// A data file of a dataset, with the metadata of its row groups taken from
+// the _metadata summary file of the dataset
+struct PARQUET_EXPORT SummaryDataFile {
+  // As recorded in the summary, usually relative to its directory
+  std::string file_path;
+  std::shared_ptr<FileMetaData> metadata;
+};
+
+// Split the metadata of a _metadata summary file by the data file holding
+// each row group, in the order in which the files first appear. A data file
+// opened with its metadata (see ParquetFileReader::Open) is read without
+// reading or parsing its own footer.
+PARQUET_EXPORT
+std::vector<SummaryDataFile> SplitSummaryMetaData(const FileMetaData& summary);
+
 /// \brief Scan all values in file. Useful for performance testing
 /// \param[in] columns the column numbers to scan. If empty scans all
 /// \param[in] column_batch_size number of values to read at a time when scanning column
@@ -130,6 +278,31 @@ PARQUET_EXPORT
 int64_t ScanFileContents(std::vector<int> columns, const int32_t column_batch_size,
                          ParquetFileReader* reader);
 
+/// \brief Bytes and time spent scanning a column, see ScanFileContents
+struct PARQUET_EXPORT ColumnScanStats {
+  /// Bytes of the column chunks read from the file
+  int64_t bytes_read = 0;
+  /// Bytes of their pages once decompressed
+  int64_t decompressed_bytes = 0;
+  /// Seconds spent in each phase, summed over the threads. The I/O is the read
+  /// of the chunk by RowGroupReader::GetColumnPageReader, which reads it whole
+  /// unless buffered streams are enabled, in which case the reads are counted
+  /// as decompression.
+  double io_seconds = 0;
+  double decompression_seconds = 0;
+  double decode_seconds = 0;
+};
+
+/// \brief Scan all values in file with one task per row group and column, on
+/// up to num_threads threads of ThreadPool::Default()
+/// \param[out] stats the bytes and time spent for each scanned column, in the
+/// order of columns
+/// \return number of semantic rows in file
+PARQUET_EXPORT
+int64_t ScanFileContents(std::vector<int> columns, const int32_t column_batch_size,
+                         ParquetFileReader* reader, int num_threads,
+                         std::vector<ColumnScanStats>* stats);
+
 }  // namespace parquet
 
 #endif  // PARQUET_FILE_READER_H
@@ -17,16 +17,24 @@
 
 #include "parquet/file/writer-internal.h"
 
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <memory>
+#include <sstream>
+#include <vector>
 
 #include "arrow/util/compression.h"
 
+#include "parquet/bloom_filter.h"
 #include "parquet/column_writer.h"
+#include "parquet/file/reader.h"
 #include "parquet/schema-internal.h"
 #include "parquet/schema.h"
 #include "parquet/thrift.h"
 #include "parquet/util/memory.h"
+#include "parquet/util/stopwatch.h"
+#include "parquet/util/thread-pool.h"
 
 using arrow::MemoryPool;
 
@@ -38,21 +46,131 @@ namespace parquet {
 // FIXME: copied from reader-internal.cc
 static constexpr uint8_t PARQUET_MAGIC[4] = {'P', 'A', 'R', '1'};
 
+// ----------------------------------------------------------------------
+// Page index
+
+ColumnPageIndexBuilder::ColumnPageIndexBuilder(ColumnChunkMetaDataBuilder* metadata)
+    : metadata_(metadata), num_rows_(0) {
+  // The page statistics are computed with signed comparisons, as the chunk
+  // statistics, which readers ignore for the other sort orders too
+  const ColumnDescriptor* descr = metadata->descr();
+  column_index_valid_ = SortOrder::SIGNED ==
+                        get_sort_order(descr->logical_type(), descr->physical_type());
+  column_index_.__set_boundary_order(format::BoundaryOrder::UNORDERED);
+}
+
+void ColumnPageIndexBuilder::AddPage(int64_t offset, int32_t compressed_page_size,
+                                     int64_t num_rows,
+                                     const EncodedStatistics& statistics) {
+  format::PageLocation location;
+  location.__set_offset(offset);
+  location.__set_compressed_page_size(compressed_page_size);
+  location.__set_first_row_index(num_rows_);
+  offset_index_.page_locations.push_back(location);
+  num_rows_ += num_rows;
+
+  if (!column_index_valid_) {
+    return;
+  }
+  if (statistics.has_min && statistics.has_max) {
+    column_index_.null_pages.push_back(false);
+    column_index_.min_values.push_back(statistics.min());
+    column_index_.max_values.push_back(statistics.max());
+  } else if (statistics.has_null_count) {
+    // No min and max although the null count is known: all values are null
+    column_index_.null_pages.push_back(true);
+    column_index_.min_values.push_back("");
+    column_index_.max_values.push_back("");
+  } else {
+    column_index_valid_ = false;
+    return;
+  }
+  column_index_.null_counts.push_back(statistics.null_count);
+}
+
+void ColumnPageIndexBuilder::WriteColumnIndex(OutputStream* sink) {
+  if (!column_index_valid_ || column_index_.null_pages.empty()) {
+    return;
+  }
+  column_index_.__isset.null_counts = true;
+  int64_t offset = sink->Tell();
+  int64_t length = SerializeThriftMsg(&column_index_, sizeof(format::ColumnIndex), sink);
+  metadata_->SetColumnIndexLocation(offset, static_cast<int32_t>(length));
+}
+
+void ColumnPageIndexBuilder::WriteOffsetIndex(OutputStream* sink) {
+  if (offset_index_.page_locations.empty()) {
+    return;
+  }
+  int64_t offset = sink->Tell();
+  int64_t length = SerializeThriftMsg(&offset_index_, sizeof(format::OffsetIndex), sink);
+  metadata_->SetOffsetIndexLocation(offset, static_cast<int32_t>(length));
+}
+
+void ColumnPageIndexBuilder::ShiftPageOffsets(int64_t delta) {
+  for (format::PageLocation& location : offset_index_.page_locations) {
+    location.__set_offset(location.offset + delta);
+  }
+}
+
+ColumnPageIndexBuilder* PageIndexBuilder::AppendColumnChunk(
+    ColumnChunkMetaDataBuilder* metadata) {
+  column_chunks_.emplace_back(new ColumnPageIndexBuilder(metadata));
+  return column_chunks_.back().get();
+}
+
+void PageIndexBuilder::RemoveColumnChunks(
+    const std::vector<ColumnPageIndexBuilder*>& column_chunks) {
+  auto removed = [&column_chunks](const std::unique_ptr<ColumnPageIndexBuilder>& chunk) {
+    return std::find(column_chunks.begin(), column_chunks.end(), chunk.get()) !=
+           column_chunks.end();
+  };
+  column_chunks_.erase(
+      std::remove_if(column_chunks_.begin(), column_chunks_.end(), removed),
+      column_chunks_.end());
+}
+
+void PageIndexBuilder::WriteTo(OutputStream* sink) {
+  for (const auto& column_chunk : column_chunks_) {
+    column_chunk->WriteColumnIndex(sink);
+  }
+  for (const auto& column_chunk : column_chunks_) {
+    column_chunk->WriteOffsetIndex(sink);
+  }
+}
+
 // ----------------------------------------------------------------------
 // SerializedPageWriter
 
 SerializedPageWriter::SerializedPageWriter(OutputStream* sink, Compression::type codec,
                                            ColumnChunkMetaDataBuilder* metadata,
-                                           MemoryPool* pool)
+                                           MemoryPool* pool,
+                                           ColumnPageIndexBuilder* page_index,
+                                           int compression_level, CodecPool* codec_pool)
     : sink_(sink),
       metadata_(metadata),
       pool_(pool),
       num_values_(0),
-      dictionary_page_offset_(0),
-      data_page_offset_(0),
+      dictionary_page_offset_(-1),
+      data_page_offset_(-1),
       total_uncompressed_size_(0),
-      total_compressed_size_(0) {
-  compressor_ = GetCodecFromArrow(codec);
+      total_compressed_size_(0),
+      page_index_(page_index),
+      codec_(codec),
+      compression_level_(compression_level),
+      codec_pool_(codec_pool),
+      stats_(nullptr) {
+  if (codec_pool_ != nullptr) {
+    compressor_ = codec_pool_->Acquire(codec, compression_level);
+  } else {
+    compressor_ = GetCodecFromArrow(codec);
+  }
+}
+
+SerializedPageWriter::~SerializedPageWriter() {
+  if (codec_pool_ != nullptr) {
+    codec_pool_->Release(codec_, compression_level_, std::move(compressor_));
+  }
 }
 
 static format::Statistics ToThrift(const EncodedStatistics& row_group_statistics) {
@@ -67,18 +185,28 @@ static format::Statistics ToThrift(const EncodedStatistics& row_group_statistics
 }
 
 void SerializedPageWriter::Close(bool has_dictionary, bool fallback) {
-  // index_page_offset = 0 since they are not supported
-  metadata_->Finish(num_values_, dictionary_page_offset_, 0, data_page_offset_,
-                    total_compressed_size_, total_uncompressed_size_, has_dictionary,
-                    fallback);
+  FinishMetadata(0, has_dictionary, fallback);
 
   // Write metadata at end of column chunk
   metadata_->WriteTo(sink_);
 }
 
+void SerializedPageWriter::FinishMetadata(int64_t base_offset, bool has_dictionary,
+                                          bool fallback) {
+  // A dictionary page offset of 0 means that there is no dictionary page
+  int64_t dictionary_page_offset =
+      dictionary_page_offset_ >= 0 ? base_offset + dictionary_page_offset_ : 0;
+  int64_t data_page_offset = base_offset + std::max<int64_t>(data_page_offset_, 0);
+  // index_page_offset = 0 since they are not supported
+  metadata_->Finish(num_values_, dictionary_page_offset, 0, data_page_offset,
+                    total_compressed_size_, total_uncompressed_size_, has_dictionary,
+                    fallback);
+}
+
 void SerializedPageWriter::Compress(const Buffer& src_buffer,
                                     ResizableBuffer* dest_buffer) {
   DCHECK(compressor_ != nullptr);
+  ScopedStopWatch watch(StatsCounter(stats_, &ColumnWriterStats::compression_time));
 
   // Compress the data
   int64_t max_compressed_size =
@@ -97,37 +225,67 @@ void SerializedPageWriter::Compress(const Buffer& src_buffer,
 
 int64_t SerializedPageWriter::WriteDataPage(const CompressedDataPage& page) {
   int64_t uncompressed_size = page.uncompressed_size();
-  std::shared_ptr<Buffer> compressed_data = page.buffer();
-
-  format::DataPageHeader data_page_header;
-  data_page_header.__set_num_values(page.num_values());
-  data_page_header.__set_encoding(ToThrift(page.encoding()));
-  data_page_header.__set_definition_level_encoding(
-      ToThrift(page.definition_level_encoding()));
-  data_page_header.__set_repetition_level_encoding(
-      ToThrift(page.repetition_level_encoding()));
-  data_page_header.__set_statistics(ToThrift(page.statistics()));
+  int64_t compressed_size = page.data_size();
 
   format::PageHeader page_header;
-  page_header.__set_type(format::PageType::DATA_PAGE);
+  const DataPageV2Layout* v2_layout = page.v2_layout();
+  if (v2_layout != nullptr) {
+    format::DataPageHeaderV2 data_page_header;
+    data_page_header.__set_num_values(page.num_values());
+    data_page_header.__set_num_nulls(v2_layout->num_nulls);
+    data_page_header.__set_num_rows(static_cast<int32_t>(page.num_rows()));
+    data_page_header.__set_encoding(ToThrift(page.encoding()));
+    data_page_header.__set_definition_levels_byte_length(
+        v2_layout->definition_levels_byte_length);
+    data_page_header.__set_repetition_levels_byte_length(
+        v2_layout->repetition_levels_byte_length);
+    data_page_header.__set_is_compressed(v2_layout->is_compressed);
+    data_page_header.__set_statistics(ToThrift(page.statistics()));
+
+    page_header.__set_type(format::PageType::DATA_PAGE_V2);
+    page_header.__set_data_page_header_v2(data_page_header);
+  } else {
+    format::DataPageHeader data_page_header;
+    data_page_header.__set_num_values(page.num_values());
+    data_page_header.__set_encoding(ToThrift(page.encoding()));
+    data_page_header.__set_definition_level_encoding(
+        ToThrift(page.definition_level_encoding()));
+    data_page_header.__set_repetition_level_encoding(
+        ToThrift(page.repetition_level_encoding()));
+    data_page_header.__set_statistics(ToThrift(page.statistics()));
+
+    page_header.__set_type(format::PageType::DATA_PAGE);
+    page_header.__set_data_page_header(data_page_header);
+  }
   page_header.__set_uncompressed_page_size(static_cast<int32_t>(uncompressed_size));
-  page_header.__set_compressed_page_size(static_cast<int32_t>(compressed_data->size()));
-  page_header.__set_data_page_header(data_page_header);
+  page_header.__set_compressed_page_size(static_cast<int32_t>(compressed_size));
   // TODO(PARQUET-594) crc checksum
 
   int64_t start_pos = sink_->Tell();
-  if (data_page_offset_ == 0) {
+  if (data_page_offset_ < 0) {
     data_page_offset_ = start_pos;
   }
 
-  int64_t header_size =
-      SerializeThriftMsg(&page_header, sizeof(format::PageHeader), sink_);
-  sink_->Write(compressed_data->data(), compressed_data->size());
+  int64_t header_size;
+  {
+    ScopedStopWatch watch(StatsCounter(stats_, &ColumnWriterStats::io_time));
+    header_size = SerializeThriftMsg(&page_header, sizeof(format::PageHeader), sink_);
+    sink_->WriteBuffers(page.buffers());
+  }
+  UpdateStats(stats_, &ColumnWriterStats::values, page.num_values());
+  UpdateStats(stats_, &ColumnWriterStats::data_pages, 1);
+  UpdateStats(stats_, &ColumnWriterStats::encoded_bytes, uncompressed_size);
+  UpdateStats(stats_, &ColumnWriterStats::compressed_bytes, compressed_size);
 
   total_uncompressed_size_ += uncompressed_size + header_size;
-  total_compressed_size_ += compressed_data->size() + header_size;
+  total_compressed_size_ += compressed_size + header_size;
   num_values_ += page.num_values();
 
+  if (page_index_ != nullptr) {
+    page_index_->AddPage(start_pos, static_cast<int32_t>(header_size + compressed_size),
+                         page.num_rows(), page.statistics());
+  }
+
   return sink_->Tell() - start_pos;
 }
 
@@ -151,17 +309,24 @@ int64_t SerializedPageWriter::WriteDictionaryPage(const DictionaryPage& page) {
   format::PageHeader page_header;
   page_header.__set_type(format::PageType::DICTIONARY_PAGE);
   page_header.__set_uncompressed_page_size(static_cast<int32_t>(uncompressed_size));
-  page_header.__set_compressed_page_size(static_cast<int32_t>(compressed_data->size()));
+  page_header.__set_compressed_page_size(static_cast<int32_t>(compressed_size));
   page_header.__set_dictionary_page_header(dict_page_header);
   // TODO(PARQUET-594) crc checksum
 
   int64_t start_pos = sink_->Tell();
-  if (dictionary_page_offset_ == 0) {
+  if (dictionary_page_offset_ < 0) {
     dictionary_page_offset_ = start_pos;
   }
-  int64_t header_size =
-      SerializeThriftMsg(&page_header, sizeof(format::PageHeader), sink_);
-  sink_->Write(compressed_data->data(), compressed_data->size());
+  int64_t header_size;
+  {
+    ScopedStopWatch watch(StatsCounter(stats_, &ColumnWriterStats::io_time));
+    header_size = SerializeThriftMsg(&page_header, sizeof(format::PageHeader), sink_);
+    sink_->Write(compressed_data->data(), compressed_data->size());
+  }
+  UpdateStats(stats_, &ColumnWriterStats::dictionary_pages, 1);
+  UpdateStats(stats_, &ColumnWriterStats::dictionary_bytes, uncompressed_size);
+  UpdateStats(stats_, &ColumnWriterStats::encoded_bytes, uncompressed_size);
+  UpdateStats(stats_, &ColumnWriterStats::compressed_bytes, compressed_data->size());
 
   total_uncompressed_size_ += uncompressed_size + header_size;
   total_compressed_size_ += compressed_data->size() + header_size;
@@ -169,14 +334,452 @@ int64_t SerializedPageWriter::WriteDictionaryPage(const DictionaryPage& page) {
   return sink_->Tell() - start_pos;
 }
 
+int64_t SerializedPageWriter::WriteBloomFilter(const BloomFilter& filter) {
+  int64_t offset = sink_->Tell();
+  int64_t length = filter.WriteTo(sink_);
+  // The copy of the metadata written by Close does not have the location
+  metadata_->SetBloomFilterLocation(offset, static_cast<int32_t>(length));
+  return length;
+}
+
+// ----------------------------------------------------------------------
+// SpillableOutputStream
+
+// Size of the chunks in which spilled bytes are read back
+static constexpr int64_t kSpillReadSize = 1 << 20;
+
+SpillableOutputStream::SpillableOutputStream(MemoryPool* pool)
+    : pool_(pool),
+      buffer_(pool),
+      spill_file_(nullptr),
+      spilled_size_(0) {}
+
+SpillableOutputStream::~SpillableOutputStream() {
+  if (spill_file_ != nullptr) {
+    std::fclose(spill_file_);
+  }
+}
+
+int64_t SpillableOutputStream::Tell() { return spilled_size_ + buffer_.Tell(); }
+
+void SpillableOutputStream::Write(const uint8_t* data, int64_t length) {
+  buffer_.Write(data, length);
+}
+
+void SpillableOutputStream::Spill() {
+  int64_t size = buffer_.Tell();
+  if (size == 0) {
+    return;
+  }
+  if (spill_file_ == nullptr) {
+    spill_file_ = std::tmpfile();
+    if (spill_file_ == nullptr) {
+      throw ParquetException("Could not create a temporary file to spill to");
+    }
+  }
+  // Releases the memory of each block once it is written
+  for (auto& block : buffer_.GetBuffers()) {
+    size_t length = static_cast<size_t>(block->size());
+    if (std::fwrite(block->data(), 1, length, spill_file_) != length) {
+      throw ParquetException("Could not spill to the temporary file");
+    }
+    block.reset();
+  }
+  spilled_size_ += size;
+}
+
+void SpillableOutputStream::WriteTo(OutputStream* sink) {
+  if (spill_file_ != nullptr) {
+    if (std::fflush(spill_file_) != 0 || std::fseek(spill_file_, 0, SEEK_SET) != 0) {
+      throw ParquetException("Could not read back the temporary file");
+    }
+    auto chunk = AllocateBuffer(pool_, std::min(kSpillReadSize, spilled_size_));
+    int64_t remaining = spilled_size_;
+    while (remaining > 0) {
+      size_t length = static_cast<size_t>(std::min(kSpillReadSize, remaining));
+      if (std::fread(chunk->mutable_data(), 1, length, spill_file_) != length) {
+        throw ParquetException("Could not read back the temporary file");
+      }
+      sink->Write(chunk->data(), static_cast<int64_t>(length));
+      remaining -= static_cast<int64_t>(length);
+    }
+  }
+  buffer_.WriteTo(sink);
+}
+
+// ----------------------------------------------------------------------
+// BufferedPageWriter
+
+BufferedPageWriter::BufferedPageWriter(Compression::type codec,
+                                       ColumnChunkMetaDataBuilder* metadata,
+                                       MemoryPool* pool,
+                                       ColumnPageIndexBuilder* page_index,
+                                       BufferedRowGroupMemory* memory,
+                                       WriterMemoryBudget* budget, int compression_level,
+                                       CodecPool* codec_pool)
+    : pool_(pool),
+      metadata_(metadata),
+      page_index_(page_index),
+      buffer_sink_(new SpillableOutputStream(pool)),
+      pager_(new SerializedPageWriter(buffer_sink_.get(), codec, metadata, pool,
+                                      page_index, compression_level, codec_pool)),
+      memory_(memory),
+      budget_(budget),
+      accounted_size_(0),
+      held_size_(0),
+      has_dictionary_(false),
+      fallback_(false) {}
+
+BufferedPageWriter::~BufferedPageWriter() {
+  if (budget_ != nullptr) {
+    budget_->Update(this, 0);
+  }
+}
+
+void BufferedPageWriter::UpdateMemory() {
+  int64_t buffered_size = buffer_sink_->buffered_size();
+  bool spill = memory_ != nullptr && memory_->Update(buffered_size - accounted_size_);
+  if (budget_ != nullptr && budget_->Update(this, buffered_size)) {
+    spill = true;
+  }
+  accounted_size_ = buffered_size;
+  if (spill) {
+    buffer_sink_->Spill();
+    if (memory_ != nullptr) {
+      memory_->Update(-accounted_size_);
+    }
+    if (budget_ != nullptr) {
+      budget_->Update(this, 0);
+    }
+    accounted_size_ = 0;
+  }
+}
+
+int64_t BufferedPageWriter::WriteDataPage(const CompressedDataPage& page) {
+  int64_t bytes_written = pager_->WriteDataPage(page);
+  UpdateMemory();
+  return bytes_written;
+}
+
+int64_t BufferedPageWriter::WriteDictionaryPage(const DictionaryPage& page) {
+  int64_t bytes_written = pager_->WriteDictionaryPage(page);
+  UpdateMemory();
+  return bytes_written;
+}
+
+int64_t BufferedPageWriter::WriteBloomFilter(const BloomFilter& filter) {
+  InMemoryOutputStream filter_sink(pool_);
+  int64_t length = filter.WriteTo(&filter_sink);
+  bloom_filter_ = filter_sink.GetBuffer();
+  return length;
+}
+
+bool BufferedPageWriter::HoldDataPages(int64_t size) {
+  if (memory_ == nullptr) {
+    return false;
+  }
+  bool exceeded = memory_->Update(size - held_size_);
+  held_size_ = size;
+  return exceeded && size > 0;
+}
+
+void BufferedPageWriter::Close(bool has_dictionary, bool fallback) {
+  has_dictionary_ = has_dictionary;
+  fallback_ = fallback;
+}
+
+void BufferedPageWriter::WriteTo(OutputStream* sink) {
+  int64_t base_offset = sink->Tell();
+  buffer_sink_->WriteTo(sink);
+
+  pager_->FinishMetadata(base_offset, has_dictionary_, fallback_);
+  if (page_index_ != nullptr) {
+    page_index_->ShiftPageOffsets(base_offset);
+  }
+  metadata_->WriteTo(sink);
+  // As SerializedPageWriter::WriteBloomFilter, the location is only in the
+  // footer copy of the metadata
+  if (bloom_filter_ != nullptr) {
+    int64_t offset = sink->Tell();
+    sink->Write(bloom_filter_->data(), bloom_filter_->size());
+    metadata_->SetBloomFilterLocation(offset,
+                                      static_cast<int32_t>(bloom_filter_->size()));
+  }
+}
+
+// ----------------------------------------------------------------------
+// PipelinedPageWriter
+
+struct PipelinedPageWriter::State
+    : public std::enable_shared_from_this<PipelinedPageWriter::State> {
+  State(std::unique_ptr<PageWriter> page_writer, int max_pending_pages, MemoryPool* pool)
+      : pager(std::move(page_writer)),
+        max_pages(max_pending_pages),
+        compressed_data(
+            std::static_pointer_cast<ResizableBuffer>(AllocateBuffer(pool, 0))),
+        page_data(std::static_pointer_cast<ResizableBuffer>(AllocateBuffer(pool, 0))),
+        bytes_written(0),
+        stopped(false),
+        compressing(false),
+        task_scheduled(false) {}
+
+  // Compresses and writes the front page, with the lock released. Requires
+  // compressing to have been set by the caller; clears it.
+  void CompressPage(std::unique_lock<std::mutex>* lock) {
+    // Stays valid as only the compressing thread removes pages
+    const CompressedDataPage* page = &pages.front();
+    lock->unlock();
+    int64_t page_bytes_written = 0;
+    std::exception_ptr page_error;
+    try {
+      std::vector<std::shared_ptr<Buffer>> page_buffers;
+      const DataPageV2Layout* v2_layout = page->v2_layout();
+      if (v2_layout != nullptr) {
+        // Only the values are compressed, the levels are written ahead of them
+        int64_t levels_size = v2_layout->definition_levels_byte_length +
+                              v2_layout->repetition_levels_byte_length;
+        const std::vector<std::shared_ptr<Buffer>>& buffers = page->buffers();
+        if (buffers.back()->size() == page->data_size() - levels_size) {
+          // The values are the last buffer
+          page_buffers.assign(buffers.begin(), buffers.end() - 1);
+          pager->Compress(*buffers.back(), compressed_data.get());
+        } else {
+          std::shared_ptr<Buffer> data = GatherBuffers(page->buffers(), page_data);
+          page_buffers.push_back(::arrow::SliceBuffer(data, 0, levels_size));
+          Buffer values(data->data() + levels_size, data->size() - levels_size);
+          pager->Compress(values, compressed_data.get());
+        }
+      } else {
+        // The codec compresses contiguous data only
+        pager->Compress(*GatherBuffers(page->buffers(), page_data),
+                        compressed_data.get());
+      }
+      page_buffers.push_back(compressed_data);
+      CompressedDataPage compressed_page(
+          std::move(page_buffers), page->num_values(), page->encoding(),
+          page->definition_level_encoding(), page->repetition_level_encoding(),
+          page->uncompressed_size(), page->statistics(), page->num_rows(), v2_layout);
+      page_bytes_written = pager->WriteDataPage(compressed_page);
+    } catch (...) {
+      page_error = std::current_exception();
+    }
+    lock->lock();
+    compressing = false;
+    bytes_written += page_bytes_written;
+    if (page_error) {
+      // The chunk is incomplete, the pages still queued are dropped
+      error = page_error;
+      pages.clear();
+    } else {
+      pages.pop_front();
+    }
+    cv.notify_all();
+  }
+
+  // Submits a task compressing the queued pages, unless one is pending
+  // already. Requires the lock.
+  void ScheduleCompression(ThreadPool* pool) {
+    if (task_scheduled || stopped || pages.empty()) {
+      return;
+    }
+    task_scheduled = true;
+    std::shared_ptr<State> self = shared_from_this();
+    pool->Submit([self]() {
+      std::unique_lock<std::mutex> lock(self->mutex);
+      while (!self->compressing && !self->stopped && !self->pages.empty()) {
+        self->compressing = true;
+        self->CompressPage(&lock);
+      }
+      self->task_scheduled = false;
+    });
+  }
+
+  // Rethrows the error of the compression, if any. Requires the lock.
+  void RethrowError() {
+    if (error) {
+      std::exception_ptr page_error = error;
+      error = nullptr;
+      std::rethrow_exception(page_error);
+    }
+  }
+
+  std::unique_ptr<PageWriter> pager;
+  const int max_pages;
+  std::shared_ptr<ResizableBuffer> compressed_data;
+  std::shared_ptr<ResizableBuffer> page_data;
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  // The front page is only removed once it is written
+  std::deque<CompressedDataPage> pages;
+  int64_t bytes_written;
+  bool stopped;
+  // Whether the front page is being compressed, by a task or by the writer
+  bool compressing;
+  // Whether a task was submitted and did not return yet
+  bool task_scheduled;
+  std::exception_ptr error;
+};
+
+PipelinedPageWriter::PipelinedPageWriter(std::unique_ptr<PageWriter> pager,
+                                         int max_pending_pages, MemoryPool* pool)
+    : state_(std::make_shared<State>(std::move(pager), std::max(max_pending_pages, 1),
+                                     pool)),
+      pager_(state_->pager.get()),
+      pool_(ThreadPool::Default()) {}
+
+PipelinedPageWriter::~PipelinedPageWriter() {
+  // The page being compressed is written to the chunk of the row group, which
+  // may be destroyed once this returns
+  std::unique_lock<std::mutex> lock(state_->mutex);
+  state_->stopped = true;
+  state_->cv.wait(lock, [this]() { return !state_->compressing; });
+  // A task still queued only finds the writer stopped
+  state_->pages.clear();
+  state_->pager.reset();
+}
+
+int64_t PipelinedPageWriter::WriteDataPage(const CompressedDataPage& page) {
+  std::unique_lock<std::mutex> lock(state_->mutex);
+  while (!state_->error && static_cast<int>(state_->pages.size()) >= state_->max_pages) {
+    if (state_->compressing) {
+      state_->cv.wait(lock);
+    } else {
+      // No task is compressing: a queued one may not start before long
+      state_->compressing = true;
+      state_->CompressPage(&lock);
+    }
+  }
+  state_->RethrowError();
+  state_->pages.push_back(page);
+  state_->ScheduleCompression(pool_.get());
+  return 0;
+}
+
+void PipelinedPageWriter::Drain() {
+  std::unique_lock<std::mutex> lock(state_->mutex);
+  while (!state_->pages.empty()) {
+    if (state_->compressing) {
+      state_->cv.wait(lock);
+    } else {
+      state_->compressing = true;
+      state_->CompressPage(&lock);
+    }
+  }
+  state_->RethrowError();
+}
+
+int64_t PipelinedPageWriter::WriteDictionaryPage(const DictionaryPage& page) {
+  Drain();
+  return pager_->WriteDictionaryPage(page);
+}
+
+int64_t PipelinedPageWriter::WriteBloomFilter(const BloomFilter& filter) {
+  Drain();
+  return pager_->WriteBloomFilter(filter);
+}
+
+void PipelinedPageWriter::Compress(const Buffer& src_buffer,
+                                   ResizableBuffer* dest_buffer) {
+  // The codec must not be used by both threads at once
+  Drain();
+  pager_->Compress(src_buffer, dest_buffer);
+}
+
+int64_t PipelinedPageWriter::Flush() {
+  Drain();
+  std::lock_guard<std::mutex> lock(state_->mutex);
+  int64_t bytes_written = state_->bytes_written;
+  state_->bytes_written = 0;
+  return bytes_written;
+}
+
+void PipelinedPageWriter::Close(bool has_dictionary, bool fallback) {
+  Drain();
+  pager_->Close(has_dictionary, fallback);
+}
+
 // ----------------------------------------------------------------------
 // RowGroupSerializer
 
 int RowGroupSerializer::num_columns() const { return metadata_->num_columns(); }
 
-int64_t RowGroupSerializer::num_rows() const { return num_rows_; }
+int64_t RowGroupSerializer::num_rows() const {
+  if (num_rows_ < 0) {
+    return column_writers_.empty() ? 0 : column_writers_[0]->rows_written();
+  }
+  return num_rows_;
+}
+
+int64_t RowGroupSerializer::total_bytes_written() const { return total_bytes_written_; }
+
+int64_t RowGroupSerializer::buffered_bytes() {
+  int64_t bytes = 0;
+  for (size_t i = 0; i < column_writers_.size(); ++i) {
+    bytes += buffered_pagers_[i]->buffered_size() + column_writers_[i]->buffered_bytes();
+  }
+  return bytes;
+}
+
+ColumnWriterStats* RowGroupSerializer::ColumnStats(int i) const {
+  const std::shared_ptr<WriterStats>& stats = properties_->writer_stats();
+  return stats != nullptr ? stats->column(i) : nullptr;
+}
+
+// Wrap the page writer to compress the data pages on the thread pool, if
+// enabled and the column is compressed
+static std::unique_ptr<PageWriter> MaybePipelineCompression(
+    std::unique_ptr<PageWriter> pager, const WriterProperties& properties) {
+  if (!properties.async_compression_enabled() || !pager->has_compressor()) {
+    return pager;
+  }
+  return std::unique_ptr<PageWriter>(new PipelinedPageWriter(
+      std::move(pager), properties.async_compression_queue_size(),
+      properties.memory_pool()));
+}
+
+void RowGroupSerializer::InitBufferedColumns() {
+  for (int i = 0; i < num_columns(); ++i) {
+    auto col_meta = metadata_->NextColumnChunk();
+    const ColumnDescriptor* column_descr = col_meta->descr();
+    ColumnPageIndexBuilder* page_index =
+        page_index_ != nullptr ? page_index_->AppendColumnChunk(col_meta) : nullptr;
+    if (page_index != nullptr) {
+      page_indexes_.push_back(page_index);
+    }
+    BufferedPageWriter* pager = new BufferedPageWriter(
+        properties_->compression(column_descr->path()), col_meta,
+        properties_->memory_pool(), page_index, &memory_, properties_->memory_budget(),
+        properties_->compression_level(column_descr->path()), codec_pool_);
+    ColumnWriterStats* stats = ColumnStats(i);
+    pager->set_stats(stats);
+    buffered_pagers_.push_back(pager);
+    column_writers_.push_back(ColumnWriter::Make(
+        col_meta,
+        MaybePipelineCompression(std::unique_ptr<PageWriter>(pager), *properties_),
+        num_rows_, properties_));
+    column_writers_.back()->set_stats(stats);
+  }
+}
+
+ColumnWriter* RowGroupSerializer::column(int i) {
+  if (!buffered_) {
+    throw ParquetException(
+        "Columns can only be accessed in any order in buffered row groups");
+  }
+  if (i < 0 || i >= static_cast<int>(column_writers_.size())) {
+    std::stringstream ss;
+    ss << "Column " << i << " is out of bounds, the row group has "
+       << column_writers_.size() << " columns";
+    throw ParquetException(ss.str());
+  }
+  return column_writers_[i].get();
+}
 
 ColumnWriter* RowGroupSerializer::NextColumn() {
+  if (buffered_) {
+    throw ParquetException("NextColumn is not supported by buffered row groups");
+  }
   // Throws an error if more columns are being written
   auto col_meta = metadata_->NextColumnChunk();
 
@@ -185,29 +788,80 @@ ColumnWriter* RowGroupSerializer::NextColumn() {
   }
 
   const ColumnDescriptor* column_descr = col_meta->descr();
-  std::unique_ptr<PageWriter> pager(
-      new SerializedPageWriter(sink_, properties_->compression(column_descr->path()),
-                               col_meta, properties_->memory_pool()));
-  current_column_writer_ =
-      ColumnWriter::Make(col_meta, std::move(pager), num_rows_, properties_);
+  ColumnPageIndexBuilder* page_index =
+      page_index_ != nullptr ? page_index_->AppendColumnChunk(col_meta) : nullptr;
+  // NextColumnChunk moved the metadata past this column
+  ColumnWriterStats* stats = ColumnStats(metadata_->current_column() - 1);
+  std::unique_ptr<SerializedPageWriter> pager(new SerializedPageWriter(
+      sink_, properties_->compression(column_descr->path()), col_meta,
+      properties_->memory_pool(), page_index,
+      properties_->compression_level(column_descr->path()), codec_pool_));
+  pager->set_stats(stats);
+  current_column_writer_ = ColumnWriter::Make(
+      col_meta, MaybePipelineCompression(std::move(pager), *properties_), num_rows_,
+      properties_);
+  current_column_writer_->set_stats(stats);
   return current_column_writer_.get();
 }
 
 int RowGroupSerializer::current_column() const { return metadata_->current_column(); }
 
+void RowGroupSerializer::FinishColumns() {
+  if (columns_finished_) {
+    return;
+  }
+  columns_finished_ = true;
+
+  if (current_column_writer_) {
+    total_bytes_written_ += current_column_writer_->Close();
+    current_column_writer_.reset();
+  }
+  if (num_rows_ < 0) {
+    num_rows_ = num_rows();
+    for (const auto& column_writer : column_writers_) {
+      if (column_writer->rows_written() != num_rows_) {
+        std::stringstream ss;
+        ss << "Written rows: " << column_writer->rows_written()
+           << " != rows of the first column: " << num_rows_ << " in column "
+           << column_writer->descr()->path()->ToDotString();
+        throw ParquetException(ss.str());
+      }
+    }
+    metadata_->set_num_rows(num_rows_);
+  }
+  for (const auto& column_writer : column_writers_) {
+    total_bytes_written_ += column_writer->Close();
+  }
+}
+
 void RowGroupSerializer::Close() {
   if (!closed_) {
     closed_ = true;
 
-    if (current_column_writer_) {
-      total_bytes_written_ += current_column_writer_->Close();
-      current_column_writer_.reset();
+    FinishColumns();
+    // The chunks are appended in schema order
+    for (BufferedPageWriter* pager : buffered_pagers_) {
+      pager->WriteTo(sink_);
+    }
+    column_writers_.clear();
+    buffered_pagers_.clear();
+    // The allocators of the column writers returned their chunks by now
+    ChunkCache* chunk_cache = ChunkCache::ForPool(properties_->memory_pool());
+    if (chunk_cache != nullptr) {
+      chunk_cache->Trim();
     }
     // Ensures all columns have been written
     metadata_->Finish(total_bytes_written_);
   }
 }
 
+void ConcurrentRowGroupSerializer::Close() {
+  if (!closed_) {
+    closed_ = true;
+    file_->CloseConcurrentRowGroup(sequence_);
+  }
+}
+
 // ----------------------------------------------------------------------
 // FileSerializer
 
@@ -223,9 +877,17 @@ std::unique_ptr<ParquetFileWriter::Contents> FileSerializer::Open(
 
 void FileSerializer::Close() {
   if (is_open_) {
-    if (row_group_writer_) {
-      row_group_writer_->Close();
+    {
+      std::lock_guard<std::mutex> lock(concurrent_mutex_);
+      if (!concurrent_row_groups_.empty()) {
+        std::stringstream ss;
+        ss << concurrent_row_groups_.size()
+           << " concurrent row groups are not appended to the file, all of them "
+              "must be closed before the file";
+        throw ParquetException(ss.str());
+      }
     }
+    CloseRowGroup();
     row_group_writer_.reset();
 
     // Write magic bytes and metadata
@@ -240,25 +902,392 @@ int FileSerializer::num_columns() const { return schema_.num_columns(); }
 
 int FileSerializer::num_row_groups() const { return num_row_groups_; }
 
-int64_t FileSerializer::num_rows() const { return num_rows_; }
+int64_t FileSerializer::num_rows() const {
+  if (deferred_num_rows_) {
+    return num_rows_ + row_group_writer_->num_rows();
+  }
+  return num_rows_;
+}
 
 const std::shared_ptr<WriterProperties>& FileSerializer::properties() const {
   return properties_;
 }
 
 RowGroupWriter* FileSerializer::AppendRowGroup(int64_t num_rows) {
+  return StartRowGroup(num_rows, false);
+}
+
+RowGroupWriter* FileSerializer::AppendBufferedRowGroup(int64_t num_rows) {
+  return StartRowGroup(num_rows, true);
+}
+
+void FileSerializer::CloseRowGroup() {
   if (row_group_writer_) {
     row_group_writer_->Close();
+    sink_->Flush();
+  }
+  if (deferred_num_rows_) {
+    num_rows_ += row_group_writer_->num_rows();
+    deferred_num_rows_ = false;
+  }
+}
+
+void FileSerializer::CheckNoConcurrentRowGroups() {
+  std::lock_guard<std::mutex> lock(concurrent_mutex_);
+  if (!concurrent_row_groups_.empty()) {
+    throw ParquetException(
+        "Row groups cannot be appended while concurrent row groups are open");
+  }
+}
+
+RowGroupWriter* FileSerializer::StartRowGroup(int64_t num_rows, bool buffered) {
+  if (num_rows < 0 && !buffered) {
+    throw ParquetException("The number of rows of unbuffered row groups must be known");
+  }
+  CheckNoConcurrentRowGroups();
+  CloseRowGroup();
+  if (num_rows < 0) {
+    deferred_num_rows_ = true;
+  } else {
+    num_rows_ += num_rows;
   }
-  num_rows_ += num_rows;
   num_row_groups_++;
   auto rg_metadata = metadata_->AppendRowGroup(num_rows);
   std::unique_ptr<RowGroupWriter::Contents> contents(
-      new RowGroupSerializer(num_rows, sink_.get(), rg_metadata, properties_.get()));
+      new RowGroupSerializer(num_rows, sink_.get(), rg_metadata, properties_.get(),
+                             page_index_.get(), buffered, &codec_pool_));
   row_group_writer_.reset(new RowGroupWriter(std::move(contents)));
   return row_group_writer_.get();
 }
 
+std::unique_ptr<RowGroupWriter> FileSerializer::AppendConcurrentRowGroup(
+    int64_t num_rows, bool keep_order) {
+  std::lock_guard<std::mutex> lock(concurrent_mutex_);
+  CloseRowGroup();
+  row_group_writer_.reset();
+  if (num_rows >= 0) {
+    num_rows_ += num_rows;
+  }
+  num_row_groups_++;
+  auto rg_metadata = metadata_->AppendRowGroup(num_rows);
+
+  int64_t sequence = next_concurrent_sequence_++;
+  ConcurrentRowGroup& row_group = concurrent_row_groups_[sequence];
+  row_group.contents.reset(new RowGroupSerializer(num_rows, sink_.get(), rg_metadata,
+                                                  properties_.get(), page_index_.get(),
+                                                  true, &codec_pool_));
+  row_group.keep_order = keep_order;
+  row_group.closed = false;
+  row_group.deferred_num_rows = num_rows < 0;
+  std::unique_ptr<RowGroupWriter::Contents> contents(
+      new ConcurrentRowGroupSerializer(this, sequence, row_group.contents.get()));
+  return std::unique_ptr<RowGroupWriter>(new RowGroupWriter(std::move(contents)));
+}
+
+void FileSerializer::CloseConcurrentRowGroup(int64_t sequence) {
+  std::map<int64_t, ConcurrentRowGroup>::iterator row_group;
+  {
+    std::lock_guard<std::mutex> lock(concurrent_mutex_);
+    row_group = concurrent_row_groups_.find(sequence);
+  }
+  // Only the appending of the chunks is serialized, their last pages are
+  // encoded by the closing thread
+  try {
+    row_group->second.contents->FinishColumns();
+  } catch (...) {
+    std::lock_guard<std::mutex> lock(concurrent_mutex_);
+    DropConcurrentRowGroup(row_group);
+    AppendHeldRowGroups();
+    throw;
+  }
+
+  std::lock_guard<std::mutex> lock(concurrent_mutex_);
+  row_group->second.closed = true;
+  if (!row_group->second.keep_order || row_group == concurrent_row_groups_.begin()) {
+    AppendClosedRowGroup(row_group);
+  }
+  AppendHeldRowGroups();
+}
+
+void FileSerializer::AppendHeldRowGroups() {
+  while (!concurrent_row_groups_.empty() &&
+         concurrent_row_groups_.begin()->second.closed) {
+    AppendClosedRowGroup(concurrent_row_groups_.begin());
+  }
+}
+
+void FileSerializer::AppendClosedRowGroup(
+    std::map<int64_t, ConcurrentRowGroup>::iterator row_group) {
+  RowGroupSerializer* contents = row_group->second.contents.get();
+  try {
+    contents->Close();
+  } catch (...) {
+    // The chunks written so far are left unreferenced in the file
+    DropConcurrentRowGroup(row_group);
+    throw;
+  }
+  if (row_group->second.deferred_num_rows) {
+    num_rows_ += contents->num_rows();
+  }
+  sink_->Flush();
+  concurrent_row_groups_.erase(row_group);
+}
+
+void FileSerializer::DropConcurrentRowGroup(
+    std::map<int64_t, ConcurrentRowGroup>::iterator row_group) {
+  RowGroupSerializer* contents = row_group->second.contents.get();
+  if (!row_group->second.deferred_num_rows) {
+    num_rows_ -= contents->num_rows();
+  }
+  num_row_groups_--;
+  RowGroupMetaDataBuilder* metadata = contents->metadata();
+  std::vector<ColumnPageIndexBuilder*> page_indexes = contents->page_indexes();
+  // The column writers refer to the metadata, drop them first
+  concurrent_row_groups_.erase(row_group);
+  if (page_index_ != nullptr) {
+    page_index_->RemoveColumnChunks(page_indexes);
+  }
+  metadata_->RemoveRowGroup(metadata);
+}
+
+// Rebuild the page index of a copied column chunk, whose pages moved by delta
+// bytes. Chunks without an OffsetIndex get none, and the ColumnIndex is only
+// kept if the source has one with null counts.
+static void CopyPageIndex(RowGroupReader* row_group, int i, int64_t delta,
+                          PageIndexBuilder* page_index,
+                          ColumnChunkMetaDataBuilder* metadata) {
+  std::unique_ptr<OffsetIndex> offset_index = row_group->GetOffsetIndex(i);
+  if (offset_index == nullptr) {
+    return;
+  }
+  std::unique_ptr<ColumnIndex> column_index = row_group->GetColumnIndex(i);
+  int num_pages = offset_index->num_pages();
+  if (column_index != nullptr &&
+      (column_index->num_pages() != num_pages || !column_index->has_null_counts())) {
+    column_index.reset();
+  }
+  int64_t num_rows = row_group->metadata()->num_rows();
+
+  ColumnPageIndexBuilder* builder = page_index->AppendColumnChunk(metadata);
+  for (int page = 0; page < num_pages; ++page) {
+    const PageLocation& location = offset_index->page_location(page);
+    int64_t end_row = page + 1 < num_pages
+                          ? offset_index->page_location(page + 1).first_row_index
+                          : num_rows;
+    EncodedStatistics statistics;
+    if (column_index != nullptr) {
+      if (!column_index->null_page(page)) {
+        statistics.set_min(column_index->encoded_min(page));
+        statistics.set_max(column_index->encoded_max(page));
+      }
+      statistics.set_null_count(column_index->null_count(page));
+    }
+    builder->AddPage(location.offset + delta, location.compressed_page_size,
+                     end_row - location.first_row_index, statistics);
+  }
+}
+
+RowGroupMetaDataBuilder* FileSerializer::StartCopiedRowGroup(
+    const RowGroupMetaData& source) {
+  if (!source.schema()->Equals(schema_)) {
+    throw ParquetException("The row group to copy does not have the schema of the file");
+  }
+  CheckNoConcurrentRowGroups();
+  CloseRowGroup();
+  row_group_writer_.reset();
+  num_rows_ += source.num_rows();
+  num_row_groups_++;
+  RowGroupMetaDataBuilder* rg_metadata = metadata_->AppendRowGroup(source.num_rows());
+  // The order of the rows is the source's
+  rg_metadata->set_sorting_columns(source.sorting_columns());
+  return rg_metadata;
+}
+
+// Write the pages of the reader to the pager with its codec instead of theirs,
+// with their statistics if keep_statistics. Returns the number of bytes
+// written for them.
+static int64_t RecompressPages(PageReader* pages, BufferedPageWriter* pager,
+                               bool flat_column, bool keep_statistics,
+                               MemoryPool* pool) {
+  const EncodedStatistics no_statistics;
+  int64_t bytes_written = 0;
+  bool has_dictionary = false;
+  std::shared_ptr<Page> page;
+  while ((page = pages->NextPage()) != nullptr) {
+    if (page->type() == PageType::DICTIONARY_PAGE) {
+      const DictionaryPage& dict_page = static_cast<const DictionaryPage&>(*page);
+      bytes_written += pager->WriteDictionaryPage(dict_page);
+      has_dictionary = true;
+    } else if (page->type() == PageType::DATA_PAGE) {
+      const DataPage& data_page = static_cast<const DataPage&>(*page);
+      const EncodedStatistics& statistics =
+          keep_statistics ? data_page.statistics() : no_statistics;
+      std::shared_ptr<Buffer> data = data_page.buffer();
+      if (pager->has_compressor()) {
+        std::shared_ptr<PoolBuffer> compressed = AllocateBuffer(pool, 0);
+        pager->Compress(*data, compressed.get());
+        data = compressed;
+      }
+      CompressedDataPage out_page(data, data_page.num_values(), data_page.encoding(),
+                                  data_page.definition_level_encoding(),
+                                  data_page.repetition_level_encoding(),
+                                  data_page.size(), statistics,
+                                  flat_column ? data_page.num_values() : 0);
+      bytes_written += pager->WriteDataPage(out_page);
+    } else if (page->type() == PageType::DATA_PAGE_V2) {
+      const DataPageV2& data_page = static_cast<const DataPageV2&>(*page);
+      const EncodedStatistics& statistics =
+          keep_statistics ? data_page.statistics() : no_statistics;
+      // The levels stay uncompressed ahead of the values
+      int64_t levels_size = data_page.definition_levels_byte_length() +
+                            data_page.repetition_levels_byte_length();
+      std::shared_ptr<Buffer> levels =
+          std::make_shared<Buffer>(data_page.buffer(), 0, levels_size);
+      std::shared_ptr<Buffer> values = std::make_shared<Buffer>(
+          data_page.buffer(), levels_size, data_page.size() - levels_size);
+      if (pager->has_compressor()) {
+        std::shared_ptr<PoolBuffer> compressed = AllocateBuffer(pool, 0);
+        pager->Compress(*values, compressed.get());
+        values = compressed;
+      }
+      DataPageV2Layout layout;
+      layout.num_nulls = data_page.num_nulls();
+      layout.definition_levels_byte_length = data_page.definition_levels_byte_length();
+      layout.repetition_levels_byte_length = data_page.repetition_levels_byte_length();
+      layout.is_compressed = pager->has_compressor();
+      CompressedDataPage out_page({levels, values}, data_page.num_values(),
+                                  data_page.encoding(), Encoding::RLE, Encoding::RLE,
+                                  data_page.size(), statistics,
+                                  data_page.num_rows(), &layout);
+      bytes_written += pager->WriteDataPage(out_page);
+    }
+  }
+  pager->Close(has_dictionary, false);
+  return bytes_written;
+}
+
+int64_t FileSerializer::RewriteWithoutStatistics(RowGroupReader* row_group, int i,
+                                                 ColumnChunkMetaDataBuilder* col_meta) {
+  std::unique_ptr<ColumnChunkMetaData> source_chunk =
+      row_group->metadata()->ColumnChunk(i);
+  bool flat_column = col_meta->descr()->max_repetition_level() == 0;
+  ColumnPageIndexBuilder* page_index = nullptr;
+  if (page_index_ != nullptr && flat_column) {
+    page_index = page_index_->AppendColumnChunk(col_meta);
+  }
+  BufferedRowGroupMemory memory(properties_->buffered_row_group_memory_limit());
+  BufferedPageWriter pager(source_chunk->compression(), col_meta,
+                           properties_->memory_pool(), page_index, &memory,
+                           properties_->memory_budget(), kDefaultCompressionLevel,
+                           &codec_pool_);
+  col_meta->SetEncodings(source_chunk->encodings());
+
+  std::unique_ptr<PageReader> pages = row_group->GetColumnPageReader(i);
+  int64_t bytes_written = RecompressPages(pages.get(), &pager, flat_column, false,
+                                          properties_->memory_pool());
+  std::unique_ptr<BloomFilter> bloom_filter = row_group->GetBloomFilter(i);
+  if (bloom_filter != nullptr) {
+    bytes_written += pager.WriteBloomFilter(*bloom_filter);
+  }
+  pager.WriteTo(sink_.get());
+  return bytes_written;
+}
+
+void FileSerializer::CopyRowGroup(RowGroupReader* row_group) {
+  const RowGroupMetaData* source = row_group->metadata();
+  auto rg_metadata = StartCopiedRowGroup(*source);
+  int64_t total_bytes_written = 0;
+  for (int i = 0; i < source->num_columns(); ++i) {
+    std::unique_ptr<ColumnChunkMetaData> source_chunk = source->ColumnChunk(i);
+    auto col_meta = rg_metadata->NextColumnChunk();
+
+    if (!source_chunk->has_correct_statistics()) {
+      total_bytes_written += RewriteWithoutStatistics(row_group, i, col_meta);
+      continue;
+    }
+
+    int64_t chunk_offset = sink_->Tell();
+    total_bytes_written += row_group->CopyColumnChunk(i, sink_.get());
+    col_meta->CopyFrom(*source_chunk, chunk_offset);
+
+    if (page_index_) {
+      int64_t source_offset = source_chunk->data_page_offset();
+      if (source_chunk->has_dictionary_page() &&
+          source_chunk->dictionary_page_offset() < source_offset) {
+        source_offset = source_chunk->dictionary_page_offset();
+      }
+      CopyPageIndex(row_group, i, chunk_offset - source_offset, page_index_.get(),
+                    col_meta);
+    }
+    // As written by the column writers: the metadata right after the chunk,
+    // where its file_offset points, then the Bloom filter, whose location
+    // is only in the footer copy of the metadata
+    col_meta->WriteTo(sink_.get());
+    std::unique_ptr<BloomFilter> bloom_filter = row_group->GetBloomFilter(i);
+    if (bloom_filter != nullptr) {
+      int64_t offset = sink_->Tell();
+      int64_t length = bloom_filter->WriteTo(sink_.get());
+      col_meta->SetBloomFilterLocation(offset, static_cast<int32_t>(length));
+      total_bytes_written += length;
+    }
+  }
+  rg_metadata->Finish(total_bytes_written);
+  sink_->Flush();
+}
+
+void FileSerializer::RecompressRowGroup(RowGroupReader* row_group, int num_threads) {
+  const RowGroupMetaData* source = row_group->metadata();
+  auto rg_metadata = StartCopiedRowGroup(*source);
+  int num_columns = source->num_columns();
+
+  BufferedRowGroupMemory memory(properties_->buffered_row_group_memory_limit());
+  std::vector<std::unique_ptr<ColumnChunkMetaData>> source_chunks;
+  std::vector<std::unique_ptr<BufferedPageWriter>> pagers;
+  for (int i = 0; i < num_columns; ++i) {
+    source_chunks.push_back(source->ColumnChunk(i));
+    auto col_meta = rg_metadata->NextColumnChunk();
+    const ColumnDescriptor* column_descr = col_meta->descr();
+    ColumnPageIndexBuilder* page_index = nullptr;
+    if (page_index_ != nullptr && column_descr->max_repetition_level() == 0) {
+      page_index = page_index_->AppendColumnChunk(col_meta);
+    }
+    pagers.emplace_back(new BufferedPageWriter(
+        properties_->compression(column_descr->path()), col_meta,
+        properties_->memory_pool(), page_index, &memory, properties_->memory_budget(),
+        properties_->compression_level(column_descr->path()), &codec_pool_));
+
+    col_meta->SetEncodings(source_chunks[i]->encodings());
+    std::shared_ptr<RowGroupStatistics> statistics = source_chunks[i]->statistics();
+    if (statistics != nullptr) {
+      col_meta->SetStatistics(statistics->Encode());
+    }
+  }
+
+  std::vector<int64_t> bytes_written(num_columns);
+  PARQUET_THROW_NOT_OK(ParallelFor(
+      ThreadPool::Default().get(), num_threads, num_columns, [&](int i) {
+        std::unique_ptr<PageReader> pages = row_group->GetColumnPageReader(i);
+        bytes_written[i] = RecompressPages(
+            pages.get(), pagers[i].get(),
+            source->schema()->Column(i)->max_repetition_level() == 0,
+            source_chunks[i]->has_correct_statistics(), properties_->memory_pool());
+        std::unique_ptr<BloomFilter> bloom_filter = row_group->GetBloomFilter(i);
+        if (bloom_filter != nullptr) {
+          bytes_written[i] += pagers[i]->WriteBloomFilter(*bloom_filter);
+        }
+        return ::arrow::Status::OK();
+      }));
+
+  // The chunks are appended in schema order
+  int64_t total_bytes_written = 0;
+  for (int i = 0; i < num_columns; ++i) {
+    pagers[i]->WriteTo(sink_.get());
+    total_bytes_written += bytes_written[i];
+  }
+  rg_metadata->Finish(total_bytes_written);
+  sink_->Flush();
+}
+
 FileSerializer::~FileSerializer() {
   try {
     Close();
@@ -266,18 +1295,39 @@ FileSerializer::~FileSerializer() {
   }
 }
 
+// Write the metadata and the footer that closes the file
+static void WriteFileFooter(const FileMetaData& metadata, OutputStream* sink) {
+  int64_t start = sink->Tell();
+  metadata.WriteTo(sink);
+  uint32_t metadata_len = static_cast<uint32_t>(sink->Tell() - start);
+
+  sink->Write(reinterpret_cast<uint8_t*>(&metadata_len), 4);
+  sink->Write(PARQUET_MAGIC, 4);
+}
+
 void FileSerializer::WriteMetaData() {
-  // Write MetaData
-  uint32_t metadata_len = static_cast<uint32_t>(sink_->Tell());
+  // The page index locations have to be known before the metadata is finished
+  if (page_index_) {
+    page_index_->WriteTo(sink_.get());
+  }
 
-  // Get a FileMetaData
-  auto metadata = metadata_->Finish();
-  metadata->WriteTo(sink_.get());
-  metadata_len = static_cast<uint32_t>(sink_->Tell()) - metadata_len;
+  file_metadata_ = metadata_->Finish();
+  WriteFileFooter(*file_metadata_, sink_.get());
+}
 
-  // Write Footer
-  sink_->Write(reinterpret_cast<uint8_t*>(&metadata_len), 4);
-  sink_->Write(PARQUET_MAGIC, 4);
+void WriteMetaDataFile(const FileMetaData& metadata, OutputStream* sink) {
+  sink->Write(PARQUET_MAGIC, 4);
+  WriteFileFooter(metadata, sink);
+}
+
+// Combine the small writes to the sink if enabled
+static std::shared_ptr<OutputStream> MaybeBufferOutput(
+    const std::shared_ptr<OutputStream>& sink, const WriterProperties& properties) {
+  if (properties.output_buffer_size() <= 0) {
+    return sink;
+  }
+  return std::make_shared<BufferedOutputStream>(sink, properties.output_buffer_size(),
+                                                properties.memory_pool());
 }
 
 FileSerializer::FileSerializer(
@@ -285,12 +1335,17 @@ FileSerializer::FileSerializer(
     const std::shared_ptr<WriterProperties>& properties,
     const std::shared_ptr<const KeyValueMetadata>& key_value_metadata)
     : ParquetFileWriter::Contents(schema, key_value_metadata),
-      sink_(sink),
+      sink_(MaybeBufferOutput(sink, *properties)),
       is_open_(true),
       properties_(properties),
       num_row_groups_(0),
       num_rows_(0),
-      metadata_(FileMetaDataBuilder::Make(&schema_, properties, key_value_metadata)) {
+      metadata_(FileMetaDataBuilder::Make(&schema_, properties, key_value_metadata)),
+      deferred_num_rows_(false),
+      next_concurrent_sequence_(0) {
+  if (properties->page_index_enabled()) {
+    page_index_.reset(new PageIndexBuilder());
+  }
   StartFile();
 }
 
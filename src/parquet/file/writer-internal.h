@@ -18,7 +18,14 @@
 #ifndef PARQUET_FILE_WRITER_INTERNAL_H
 #define PARQUET_FILE_WRITER_INTERNAL_H
 
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <exception>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #include "parquet/column_page.h"
@@ -34,21 +41,74 @@ class Codec;
 
 namespace parquet {
 
+class ThreadPool;
+
+// Collects the ColumnIndex and OffsetIndex of a column chunk while its data
+// pages are written
+class ColumnPageIndexBuilder {
+ public:
+  explicit ColumnPageIndexBuilder(ColumnChunkMetaDataBuilder* metadata);
+
+  void AddPage(int64_t offset, int32_t compressed_page_size, int64_t num_rows,
+               const EncodedStatistics& statistics);
+
+  // Serialize the indexes and record their location in the chunk metadata.
+  // The ColumnIndex is left out if some page has no statistics, or if the
+  // sort order of the column is not SIGNED.
+  void WriteColumnIndex(OutputStream* sink);
+  void WriteOffsetIndex(OutputStream* sink);
+
+  // Move the pages added so far by delta bytes, for chunks that were written
+  // to a buffer first
+  void ShiftPageOffsets(int64_t delta);
+
+ private:
+  ColumnChunkMetaDataBuilder* metadata_;
+  format::ColumnIndex column_index_;
+  format::OffsetIndex offset_index_;
+  bool column_index_valid_;
+  int64_t num_rows_;
+};
+
+// The page indexes of all column chunks of a file. They are written together
+// after the last row group, so that the column chunks stay contiguous.
+class PageIndexBuilder {
+ public:
+  // The returned builder is owned by this instance
+  ColumnPageIndexBuilder* AppendColumnChunk(ColumnChunkMetaDataBuilder* metadata);
+
+  // Drop the indexes of column chunks that will not be written
+  void RemoveColumnChunks(const std::vector<ColumnPageIndexBuilder*>& column_chunks);
+
+  // Write all ColumnIndexes, then all OffsetIndexes
+  void WriteTo(OutputStream* sink);
+
+ private:
+  std::vector<std::unique_ptr<ColumnPageIndexBuilder>> column_chunks_;
+};
+
 // This subclass delimits pages appearing in a serialized stream, each preceded
 // by a serialized Thrift format::PageHeader indicating the type of each page
 // and the page metadata.
 class SerializedPageWriter : public PageWriter {
  public:
+  // The codec is taken from the codec pool if given, and released to it on
+  // destruction
   SerializedPageWriter(OutputStream* sink, Compression::type codec,
                        ColumnChunkMetaDataBuilder* metadata,
-                       ::arrow::MemoryPool* pool = ::arrow::default_memory_pool());
+                       ::arrow::MemoryPool* pool = ::arrow::default_memory_pool(),
+                       ColumnPageIndexBuilder* page_index = nullptr,
+                       int compression_level = kDefaultCompressionLevel,
+                       CodecPool* codec_pool = nullptr);
 
-  virtual ~SerializedPageWriter() {}
+  virtual ~SerializedPageWriter();
 
   int64_t WriteDataPage(const CompressedDataPage& page) override;
 
   int64_t WriteDictionaryPage(const DictionaryPage& page) override;
 
+  int64_t WriteBloomFilter(const BloomFilter& filter) override;
+
   /**
    * Compress a buffer.
    */
@@ -58,6 +118,14 @@ class SerializedPageWriter : public PageWriter {
 
   void Close(bool has_dictionary, bool fallback) override;
 
+  // Finish the chunk metadata without writing it, with the page offsets
+  // moved by base_offset bytes
+  void FinishMetadata(int64_t base_offset, bool has_dictionary, bool fallback);
+
+  // Count the pages written and their sizes, and time their compression and
+  // writes
+  void set_stats(ColumnWriterStats* stats) { stats_ = stats; }
+
  private:
   OutputStream* sink_;
   ColumnChunkMetaDataBuilder* metadata_;
@@ -68,8 +136,195 @@ class SerializedPageWriter : public PageWriter {
   int64_t total_uncompressed_size_;
   int64_t total_compressed_size_;
 
+  // Not owned, nullptr unless the page index is written
+  ColumnPageIndexBuilder* page_index_;
+
   // Compression codec to use.
+  Compression::type codec_;
+  int compression_level_;
   std::unique_ptr<::arrow::Codec> compressor_;
+  // Not owned, nullptr if the codec is not reused
+  CodecPool* codec_pool_;
+
+  // Not owned, nullptr unless statistics are collected
+  ColumnWriterStats* stats_;
+};
+
+// An output stream kept in memory until Spill moves the bytes written so far
+// to an anonymous temporary file. Tell counts the spilled bytes too.
+class SpillableOutputStream : public OutputStream {
+ public:
+  explicit SpillableOutputStream(
+      ::arrow::MemoryPool* pool = ::arrow::default_memory_pool());
+
+  ~SpillableOutputStream() override;
+
+  void Close() override {}
+
+  int64_t Tell() override;
+
+  void Write(const uint8_t* data, int64_t length) override;
+
+  // Number of bytes held in memory
+  int64_t buffered_size() { return buffer_.Tell(); }
+
+  int64_t spilled_size() const { return spilled_size_; }
+
+  // Move the bytes held in memory to the temporary file, releasing the memory
+  void Spill();
+
+  // Append all bytes written, the spilled ones first, to the sink
+  void WriteTo(OutputStream* sink);
+
+ private:
+  ::arrow::MemoryPool* pool_;
+  ChunkedOutputStream buffer_;
+  std::FILE* spill_file_;
+  int64_t spilled_size_;
+};
+
+// The bytes held in memory by the buffered chunks of a row group. Once they
+// exceed the limit, the chunk that is being written spills its buffer.
+// Thread-safe, as all chunks share it.
+class BufferedRowGroupMemory {
+ public:
+  // A limit of 0 means that the chunks never spill
+  explicit BufferedRowGroupMemory(int64_t limit) : limit_(limit), buffered_size_(0) {}
+
+  // Account for a change of the in-memory size of a chunk. Returns true if the
+  // chunk should spill.
+  bool Update(int64_t delta) {
+    int64_t buffered_size = buffered_size_.fetch_add(delta) + delta;
+    return limit_ > 0 && buffered_size > limit_;
+  }
+
+  int64_t buffered_size() const { return buffered_size_.load(); }
+
+ private:
+  int64_t limit_;
+  std::atomic<int64_t> buffered_size_;
+};
+
+// Writes the pages of a column chunk to an in-memory sink, so that the chunk
+// can be encoded independently of the other chunks of its row group. WriteTo
+// appends the chunk to the file, and finishes its metadata with the final
+// offsets. If a memory budget is given, the pages are spilled to a temporary
+// file when the buffered chunks of the row group exceed it, or when the
+// writers exceed the WriterMemoryBudget. The pages held back by the column
+// writer while dictionary encoding count towards the row group's memory too.
+class BufferedPageWriter : public PageWriter {
+ public:
+  BufferedPageWriter(Compression::type codec, ColumnChunkMetaDataBuilder* metadata,
+                     ::arrow::MemoryPool* pool = ::arrow::default_memory_pool(),
+                     ColumnPageIndexBuilder* page_index = nullptr,
+                     BufferedRowGroupMemory* memory = nullptr,
+                     WriterMemoryBudget* budget = nullptr,
+                     int compression_level = kDefaultCompressionLevel,
+                     CodecPool* codec_pool = nullptr);
+
+  ~BufferedPageWriter() override;
+
+  int64_t WriteDataPage(const CompressedDataPage& page) override;
+
+  int64_t WriteDictionaryPage(const DictionaryPage& page) override;
+
+  int64_t WriteBloomFilter(const BloomFilter& filter) override;
+
+  void Compress(const Buffer& src_buffer, ResizableBuffer* dest_buffer) override {
+    pager_->Compress(src_buffer, dest_buffer);
+  }
+
+  bool has_compressor() override { return pager_->has_compressor(); }
+
+  // Only records how the chunk was encoded, the metadata is finished by WriteTo
+  void Close(bool has_dictionary, bool fallback) override;
+
+  // The held pages count towards the memory of the row group only, the column
+  // writer accounts for them in the WriterMemoryBudget
+  bool HoldDataPages(int64_t size) override;
+
+  // Append the pages, the chunk metadata and the Bloom filter to the sink, in
+  // the order of a SerializedPageWriter
+  void WriteTo(OutputStream* sink);
+
+  // Number of bytes moved to the temporary file
+  int64_t spilled_size() const { return buffer_sink_->spilled_size(); }
+
+  // Number of bytes buffered so far, in memory or in the temporary file
+  int64_t buffered_size() {
+    return buffer_sink_->Tell() + (bloom_filter_ != nullptr ? bloom_filter_->size() : 0);
+  }
+
+  void set_stats(ColumnWriterStats* stats) { pager_->set_stats(stats); }
+
+ private:
+  // Account for the bytes just buffered, and spill if over the budget
+  void UpdateMemory();
+
+  ::arrow::MemoryPool* pool_;
+  ColumnChunkMetaDataBuilder* metadata_;
+  ColumnPageIndexBuilder* page_index_;
+  std::unique_ptr<SpillableOutputStream> buffer_sink_;
+  std::unique_ptr<SerializedPageWriter> pager_;
+  // Not owned, nullptr if there is no budget
+  BufferedRowGroupMemory* memory_;
+  WriterMemoryBudget* budget_;
+  // The in-memory size last accounted in memory_
+  int64_t accounted_size_;
+  // The size of the pages held by the column writer, accounted in memory_
+  int64_t held_size_;
+
+  bool has_dictionary_;
+  bool fallback_;
+  // Kept apart from the pages as it follows the metadata, nullptr if there is
+  // no Bloom filter
+  std::shared_ptr<Buffer> bloom_filter_;
+};
+
+// Compresses the data pages of a column chunk on the default ThreadPool while
+// the column writer encodes the next ones. WriteDataPage queues the
+// uncompressed page, and a task writes the compressed pages to the wrapped
+// page writer in the order they were queued. While max_pending_pages pages are
+// waiting, WriteDataPage compresses the next one itself unless a task is at
+// it, so that a busy pool does not hold the writer back. Errors raised by a
+// task are rethrown by the next call.
+class PipelinedPageWriter : public PageWriter {
+ public:
+  PipelinedPageWriter(std::unique_ptr<PageWriter> pager, int max_pending_pages,
+                      ::arrow::MemoryPool* pool = ::arrow::default_memory_pool());
+
+  ~PipelinedPageWriter() override;
+
+  // Returns 0, the size of the written pages is returned by Flush
+  int64_t WriteDataPage(const CompressedDataPage& page) override;
+
+  int64_t WriteDictionaryPage(const DictionaryPage& page) override;
+
+  int64_t WriteBloomFilter(const BloomFilter& filter) override;
+
+  void Compress(const Buffer& src_buffer, ResizableBuffer* dest_buffer) override;
+
+  bool has_compressor() override { return pager_->has_compressor(); }
+
+  bool compresses_data_pages() override { return true; }
+
+  bool HoldDataPages(int64_t size) override { return pager_->HoldDataPages(size); }
+
+  int64_t Flush() override;
+
+  void Close(bool has_dictionary, bool fallback) override;
+
+ private:
+  // Wait until the queue is empty, and rethrow the error of a task if any
+  void Drain();
+
+  // Shared with the tasks, which may outlive the writer
+  struct State;
+  std::shared_ptr<State> state_;
+  // The wrapped page writer, owned by state_, for the calls that do not
+  // compress
+  PageWriter* pager_;
+  std::shared_ptr<ThreadPool> pool_;
 };
 
 // RowGroupWriter::Contents implementation for the Parquet file specification
@@ -77,30 +332,107 @@ class RowGroupSerializer : public RowGroupWriter::Contents {
  public:
   RowGroupSerializer(int64_t num_rows, OutputStream* sink,
                      RowGroupMetaDataBuilder* metadata,
-                     const WriterProperties* properties)
+                     const WriterProperties* properties,
+                     PageIndexBuilder* page_index = nullptr, bool buffered = false,
+                     CodecPool* codec_pool = nullptr)
       : num_rows_(num_rows),
         sink_(sink),
         metadata_(metadata),
         properties_(properties),
+        page_index_(page_index),
         total_bytes_written_(0),
-        closed_(false) {}
+        closed_(false),
+        columns_finished_(false),
+        buffered_(buffered),
+        codec_pool_(codec_pool),
+        memory_(properties->buffered_row_group_memory_limit()) {
+    if (buffered_) {
+      InitBufferedColumns();
+    }
+  }
 
   int num_columns() const override;
   int64_t num_rows() const override;
+  int64_t total_bytes_written() const override;
+  int64_t buffered_bytes() override;
 
   ColumnWriter* NextColumn() override;
+  ColumnWriter* column(int i) override;
   int current_column() const override;
   void Close() override;
 
+  // Close the column writers, which encodes their last pages, without
+  // appending the buffered chunks to the sink yet. Called by Close.
+  void FinishColumns();
+
+  RowGroupMetaDataBuilder* metadata() const { return metadata_; }
+
+  // The page indexes of the buffered column chunks, if any
+  const std::vector<ColumnPageIndexBuilder*>& page_indexes() const {
+    return page_indexes_;
+  }
+
  private:
+  // Create the writers of all columns, each with its own buffer
+  void InitBufferedColumns();
+
+  // The counters of the i-th column, nullptr unless statistics are collected
+  ColumnWriterStats* ColumnStats(int i) const;
+
+  // Negative until Close if the row group was started without a number of rows
   int64_t num_rows_;
   OutputStream* sink_;
   RowGroupMetaDataBuilder* metadata_;
   const WriterProperties* properties_;
+  PageIndexBuilder* page_index_;
   int64_t total_bytes_written_;
   bool closed_;
+  bool columns_finished_;
+  bool buffered_;
+  // Not owned, nullptr if codecs are not reused
+  CodecPool* codec_pool_;
 
   std::shared_ptr<ColumnWriter> current_column_writer_;
+
+  // Only used by buffered row groups. The page writers are owned by the
+  // column writers.
+  std::vector<std::shared_ptr<ColumnWriter>> column_writers_;
+  std::vector<BufferedPageWriter*> buffered_pagers_;
+  std::vector<ColumnPageIndexBuilder*> page_indexes_;
+  BufferedRowGroupMemory memory_;
+};
+
+class FileSerializer;
+
+// RowGroupWriter::Contents of a concurrent row group, see
+// ParquetFileWriter::AppendConcurrentRowGroup. The buffered row group itself
+// is owned by the FileSerializer until it is appended to the file.
+class ConcurrentRowGroupSerializer : public RowGroupWriter::Contents {
+ public:
+  ConcurrentRowGroupSerializer(FileSerializer* file, int64_t sequence,
+                               RowGroupSerializer* row_group)
+      : file_(file), sequence_(sequence), row_group_(row_group), closed_(false) {}
+
+  int num_columns() const override { return row_group_->num_columns(); }
+  int64_t num_rows() const override { return row_group_->num_rows(); }
+  int64_t total_bytes_written() const override {
+    return row_group_->total_bytes_written();
+  }
+  int64_t buffered_bytes() override { return row_group_->buffered_bytes(); }
+
+  ColumnWriter* NextColumn() override { return row_group_->NextColumn(); }
+  ColumnWriter* column(int i) override { return row_group_->column(i); }
+  int current_column() const override { return row_group_->current_column(); }
+
+  // Hands the row group over to the file, after which it must not be used,
+  // even if closing it failed
+  void Close() override;
+
+ private:
+  FileSerializer* file_;
+  int64_t sequence_;
+  RowGroupSerializer* row_group_;
+  bool closed_;
 };
 
 // An implementation of ParquetFileWriter::Contents that deals with the Parquet
@@ -118,12 +450,27 @@ class FileSerializer : public ParquetFileWriter::Contents {
 
   RowGroupWriter* AppendRowGroup(int64_t num_rows) override;
 
+  RowGroupWriter* AppendBufferedRowGroup(int64_t num_rows) override;
+
+  void CopyRowGroup(RowGroupReader* row_group) override;
+
+  void RecompressRowGroup(RowGroupReader* row_group, int num_threads) override;
+
+  std::unique_ptr<RowGroupWriter> AppendConcurrentRowGroup(int64_t num_rows,
+                                                           bool keep_order) override;
+
+  // Append the closed concurrent row group to the sink, or hold it until the
+  // row groups started before it are appended if it keeps their order
+  void CloseConcurrentRowGroup(int64_t sequence);
+
   const std::shared_ptr<WriterProperties>& properties() const override;
 
   int num_columns() const override;
   int num_row_groups() const override;
   int64_t num_rows() const override;
 
+  std::shared_ptr<FileMetaData> metadata() const override { return file_metadata_; }
+
   virtual ~FileSerializer();
 
  private:
@@ -137,9 +484,64 @@ class FileSerializer : public ParquetFileWriter::Contents {
   bool is_open_;
   const std::shared_ptr<WriterProperties> properties_;
   int num_row_groups_;
+  // Rows of the row groups started so far, except for the current one if its
+  // number of rows is only known once it is closed
   int64_t num_rows_;
   std::unique_ptr<FileMetaDataBuilder> metadata_;
+  // Shared by the column chunks of all row groups, must outlive them
+  CodecPool codec_pool_;
   std::unique_ptr<RowGroupWriter> row_group_writer_;
+  // Whether the number of rows of row_group_writer_ is not counted in num_rows_
+  bool deferred_num_rows_;
+  // nullptr unless WriterProperties::page_index_enabled()
+  std::unique_ptr<PageIndexBuilder> page_index_;
+  // Set once the metadata is written
+  std::shared_ptr<FileMetaData> file_metadata_;
+
+  struct ConcurrentRowGroup {
+    std::unique_ptr<RowGroupSerializer> contents;
+    bool keep_order;
+    bool closed;
+    // Whether the number of rows is not counted in num_rows_ yet
+    bool deferred_num_rows;
+  };
+
+  // Guards the sink and the metadata while concurrent row groups are open
+  std::mutex concurrent_mutex_;
+  int64_t next_concurrent_sequence_;
+  // The concurrent row groups not appended yet, in the order they were started
+  std::map<int64_t, ConcurrentRowGroup> concurrent_row_groups_;
+
+  RowGroupWriter* StartRowGroup(int64_t num_rows, bool buffered);
+
+  // Throws if concurrent row groups are open, as the other row groups would
+  // be written to the sink at the same time
+  void CheckNoConcurrentRowGroups();
+
+  // Write a closed concurrent row group to the sink and drop it. Requires
+  // concurrent_mutex_.
+  void AppendClosedRowGroup(std::map<int64_t, ConcurrentRowGroup>::iterator row_group);
+
+  // Append the closed row groups no longer held by an open one started
+  // before them. Requires concurrent_mutex_.
+  void AppendHeldRowGroups();
+
+  // Drop a concurrent row group that failed, along with its metadata and page
+  // indexes, so that the file can still be written without it. Requires
+  // concurrent_mutex_.
+  void DropConcurrentRowGroup(std::map<int64_t, ConcurrentRowGroup>::iterator row_group);
+
+  // Close the current row group and start the metadata of a copied one
+  RowGroupMetaDataBuilder* StartCopiedRowGroup(const RowGroupMetaData& source);
+
+  // Write the pages of the i-th column chunk of the row group with their
+  // codec but without their statistics, for CopyRowGroup. Returns the number
+  // of bytes written for them.
+  int64_t RewriteWithoutStatistics(RowGroupReader* row_group, int i,
+                                   ColumnChunkMetaDataBuilder* col_meta);
+
+  // Close the current row group, if any
+  void CloseRowGroup();
 
   void StartFile();
   void WriteMetaData();
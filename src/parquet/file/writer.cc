@@ -17,6 +17,7 @@
 
 #include "parquet/file/writer.h"
 
+#include "parquet/file/reader.h"
 #include "parquet/file/writer-internal.h"
 #include "parquet/util/memory.h"
 
@@ -39,12 +40,20 @@ void RowGroupWriter::Close() {
 
 ColumnWriter* RowGroupWriter::NextColumn() { return contents_->NextColumn(); }
 
+ColumnWriter* RowGroupWriter::column(int i) { return contents_->column(i); }
+
 int RowGroupWriter::current_column() { return contents_->current_column(); }
 
 int RowGroupWriter::num_columns() const { return contents_->num_columns(); }
 
 int64_t RowGroupWriter::num_rows() const { return contents_->num_rows(); }
 
+int64_t RowGroupWriter::buffered_bytes() { return contents_->buffered_bytes(); }
+
+int64_t RowGroupWriter::total_bytes_written() const {
+  return contents_->total_bytes_written();
+}
+
 // ----------------------------------------------------------------------
 // ParquetFileWriter public API
 
@@ -94,6 +103,10 @@ const std::shared_ptr<const KeyValueMetadata>& ParquetFileWriter::key_value_meta
   return contents_->key_value_metadata();
 }
 
+const std::shared_ptr<FileMetaData>& ParquetFileWriter::metadata() const {
+  return file_metadata_;
+}
+
 void ParquetFileWriter::Open(std::unique_ptr<ParquetFileWriter::Contents> contents) {
   contents_ = std::move(contents);
 }
@@ -101,6 +114,7 @@ void ParquetFileWriter::Open(std::unique_ptr<ParquetFileWriter::Contents> conten
 void ParquetFileWriter::Close() {
   if (contents_) {
     contents_->Close();
+    file_metadata_ = contents_->metadata();
     contents_.reset();
   }
 }
@@ -109,8 +123,64 @@ RowGroupWriter* ParquetFileWriter::AppendRowGroup(int64_t num_rows) {
   return contents_->AppendRowGroup(num_rows);
 }
 
+RowGroupWriter* ParquetFileWriter::AppendBufferedRowGroup(int64_t num_rows) {
+  return contents_->AppendBufferedRowGroup(num_rows);
+}
+
+RowGroupWriter* ParquetFileWriter::AppendBufferedRowGroup() {
+  return contents_->AppendBufferedRowGroup(-1);
+}
+
+std::unique_ptr<RowGroupWriter> ParquetFileWriter::AppendConcurrentRowGroup(
+    int64_t num_rows, bool keep_order) {
+  return contents_->AppendConcurrentRowGroup(num_rows, keep_order);
+}
+
+void ParquetFileWriter::CopyRowGroup(RowGroupReader* row_group) {
+  contents_->CopyRowGroup(row_group);
+}
+
+void ParquetFileWriter::RecompressRowGroup(RowGroupReader* row_group, int num_threads) {
+  contents_->RecompressRowGroup(row_group, num_threads);
+}
+
 const std::shared_ptr<WriterProperties>& ParquetFileWriter::properties() const {
   return contents_->properties();
 }
 
+std::shared_ptr<FileMetaData> CompactFiles(
+    const std::vector<ParquetFileReader*>& inputs,
+    const std::shared_ptr<OutputStream>& sink,
+    const std::shared_ptr<WriterProperties>& properties) {
+  if (inputs.empty()) {
+    throw ParquetException("No files to compact");
+  }
+  std::shared_ptr<FileMetaData> first_metadata = inputs[0]->metadata();
+  auto schema =
+      std::static_pointer_cast<GroupNode>(first_metadata->schema()->schema_root());
+  std::unique_ptr<ParquetFileWriter> file_writer = ParquetFileWriter::Open(
+      sink, schema, properties, first_metadata->key_value_metadata());
+  for (ParquetFileReader* input : inputs) {
+    for (int i = 0; i < input->metadata()->num_row_groups(); ++i) {
+      file_writer->CopyRowGroup(input->RowGroup(i).get());
+    }
+  }
+  file_writer->Close();
+  return file_writer->metadata();
+}
+
+std::shared_ptr<FileMetaData> RecompressFile(
+    ParquetFileReader* input, const std::shared_ptr<OutputStream>& sink,
+    const std::shared_ptr<WriterProperties>& properties, int num_threads) {
+  std::shared_ptr<FileMetaData> metadata = input->metadata();
+  auto schema = std::static_pointer_cast<GroupNode>(metadata->schema()->schema_root());
+  std::unique_ptr<ParquetFileWriter> file_writer =
+      ParquetFileWriter::Open(sink, schema, properties, metadata->key_value_metadata());
+  for (int i = 0; i < metadata->num_row_groups(); ++i) {
+    file_writer->RecompressRowGroup(input->RowGroup(i).get(), num_threads);
+  }
+  file_writer->Close();
+  return file_writer->metadata();
+}
+
 }  // namespace parquet
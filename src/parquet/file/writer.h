@@ -20,6 +20,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 #include "parquet/file/metadata.h"
 #include "parquet/properties.h"
@@ -32,6 +33,8 @@ namespace parquet {
 class ColumnWriter;
 class PageWriter;
 class OutputStream;
+class ParquetFileReader;
+class RowGroupReader;
 
 namespace schema {
 
@@ -48,8 +51,11 @@ class PARQUET_EXPORT RowGroupWriter {
     virtual ~Contents() = default;
     virtual int num_columns() const = 0;
     virtual int64_t num_rows() const = 0;
+    virtual int64_t total_bytes_written() const = 0;
+    virtual int64_t buffered_bytes() = 0;
 
     virtual ColumnWriter* NextColumn() = 0;
+    virtual ColumnWriter* column(int i) = 0;
     virtual int current_column() const = 0;
     virtual void Close() = 0;
   };
@@ -65,6 +71,16 @@ class PARQUET_EXPORT RowGroupWriter {
    * modified anymore.
    */
   ColumnWriter* NextColumn();
+
+  /**
+   * The ColumnWriter of the indicated column of a buffered row group, see
+   * ParquetFileWriter::AppendBufferedRowGroup.
+   *
+   * All ColumnWriters are valid until Close. Each of them may be used from a
+   * different thread, but a single ColumnWriter must not be used concurrently.
+   */
+  ColumnWriter* column(int i);
+
   /// Index of currently written column
   int current_column();
   void Close();
@@ -73,9 +89,27 @@ class PARQUET_EXPORT RowGroupWriter {
 
   /**
    * Number of rows that shall be written as part of this RowGroup.
+   *
+   * For a buffered RowGroup started without a number of rows, this is the
+   * number of rows written so far to its columns.
    */
   int64_t num_rows() const;
 
+  /**
+   * Size in bytes of the column chunks closed so far, with their Bloom
+   * filters. Once the RowGroup is closed, this is the size of the whole
+   * RowGroup in the file.
+   */
+  int64_t total_bytes_written() const;
+
+  /**
+   * Size in bytes of the pages buffered by the columns of a buffered RowGroup
+   * that is still open, including the values and levels not yet assembled
+   * into pages. This approximates the size the RowGroup will have once
+   * closed. Returns 0 for other RowGroups.
+   */
+  int64_t buffered_bytes();
+
  private:
   // Holds a pointer to an instance of Contents implementation
   std::unique_ptr<Contents> contents_;
@@ -97,6 +131,11 @@ class PARQUET_EXPORT ParquetFileWriter {
     virtual void Close() = 0;
 
     virtual RowGroupWriter* AppendRowGroup(int64_t num_rows) = 0;
+    virtual RowGroupWriter* AppendBufferedRowGroup(int64_t num_rows) = 0;
+    virtual void CopyRowGroup(RowGroupReader* row_group) = 0;
+    virtual void RecompressRowGroup(RowGroupReader* row_group, int num_threads) = 0;
+    virtual std::unique_ptr<RowGroupWriter> AppendConcurrentRowGroup(int64_t num_rows,
+                                                                     bool keep_order) = 0;
 
     virtual int64_t num_rows() const = 0;
     virtual int num_columns() const = 0;
@@ -104,6 +143,9 @@ class PARQUET_EXPORT ParquetFileWriter {
 
     virtual const std::shared_ptr<WriterProperties>& properties() const = 0;
 
+    // The metadata written by Close, nullptr until then
+    virtual std::shared_ptr<FileMetaData> metadata() const { return nullptr; }
+
     const std::shared_ptr<const KeyValueMetadata>& key_value_metadata() const {
       return key_value_metadata_;
     }
@@ -145,6 +187,80 @@ class PARQUET_EXPORT ParquetFileWriter {
    */
   RowGroupWriter* AppendRowGroup(int64_t num_rows);
 
+  /**
+   * Construct a RowGroupWriter whose columns can be written in any order, or
+   * concurrently, through RowGroupWriter::column.
+   *
+   * Each column chunk is buffered until RowGroupWriter::Close appends the
+   * chunks to the sink in schema order. The pages are kept in memory, or in
+   * temporary files beyond WriterProperties::buffered_row_group_memory_limit.
+   * The columns can be written incrementally, a batch of rows at a time.
+   *
+   * @param num_rows The number of rows that are stored in the new RowGroup
+   */
+  RowGroupWriter* AppendBufferedRowGroup(int64_t num_rows);
+
+  /**
+   * Construct a buffered RowGroupWriter without knowing its number of rows in
+   * advance. The number of rows is taken from the columns at
+   * RowGroupWriter::Close, all of which must have been written the same
+   * number of rows.
+   */
+  RowGroupWriter* AppendBufferedRowGroup();
+
+  /**
+   * Construct a buffered RowGroupWriter that is filled independently of the
+   * other row groups of the file, e.g. by its own producer thread. Any number
+   * of them may be open at the same time. Each one is buffered like the row
+   * groups of AppendBufferedRowGroup, and RowGroupWriter::Close appends it to
+   * the sink after the concurrent row groups closed before it.
+   *
+   * If keep_order is set, the row group is instead appended after all
+   * concurrent row groups started before it. Closing it first keeps it in its
+   * buffer until the last of them is appended.
+   *
+   * Closes the current RowGroupWriter, if any. No other row group can be
+   * appended until all concurrent row groups are appended, and they must all
+   * be closed before the file. This method and RowGroupWriter::Close of the
+   * returned writers are thread-safe. A row group whose Close throws is left
+   * out of the file, which can still be closed.
+   *
+   * @param num_rows The number of rows that are stored in the new RowGroup,
+   * -1 if it is only known once closed
+   */
+  std::unique_ptr<RowGroupWriter> AppendConcurrentRowGroup(int64_t num_rows = -1,
+                                                           bool keep_order = false);
+
+  /**
+   * Append a row group of another file with the same schema by copying its
+   * column chunks verbatim, without decoding or recompressing their pages.
+   * Only the offsets in the chunk metadata are rewritten. The statistics,
+   * Bloom filters and, if enabled, the page indexes of the chunks are carried
+   * over. The chunks whose statistics the writer of the file got wrong (see
+   * ApplicationVersion::HasCorrectStatistics) are the exception: their pages
+   * are rewritten with the same codec but without statistics, since readers
+   * would trust them coming from this writer.
+   *
+   * Closes the current RowGroupWriter, if any.
+   */
+  void CopyRowGroup(RowGroupReader* row_group);
+
+  /**
+   * Append a row group of another file with the same schema, changing only
+   * the compression of its pages to the codecs of the writer properties. The
+   * pages are decompressed and recompressed without decoding their values,
+   * which keeps their encodings, levels and statistics, unless the writer of
+   * the file got them wrong. The Bloom filters and, if enabled, the page
+   * indexes of flat columns are carried over.
+   *
+   * Up to num_threads columns are rewritten in parallel on
+   * ThreadPool::Default(), each into its own buffer like the columns of a
+   * buffered row group.
+   *
+   * Closes the current RowGroupWriter, if any.
+   */
+  void RecompressRowGroup(RowGroupReader* row_group, int num_threads = 1);
+
   /**
    * Number of columns.
    *
@@ -185,11 +301,43 @@ class PARQUET_EXPORT ParquetFileWriter {
    */
   const std::shared_ptr<const KeyValueMetadata>& key_value_metadata() const;
 
+  /**
+   * Returns the metadata written to the file footer, once the file is closed.
+   * The metadata of the files of a dataset can be gathered into a _metadata
+   * summary file, see FileMetaData::AppendRowGroups and WriteMetaDataFile.
+   */
+  const std::shared_ptr<FileMetaData>& metadata() const;
+
  private:
   // Holds a pointer to an instance of Contents implementation
   std::unique_ptr<Contents> contents_;
+  // Set by Close
+  std::shared_ptr<FileMetaData> file_metadata_;
 };
 
+// Write a Parquet file made of the metadata only, such as the _metadata
+// summary file of a dataset, whose column chunks refer to other files
+PARQUET_EXPORT
+void WriteMetaDataFile(const FileMetaData& metadata, OutputStream* sink);
+
+// Write the row groups of the input files, all of which must have the schema
+// of the first one, to a single file by copying them with CopyRowGroup. The
+// row groups are neither merged nor split, and the key-value metadata of the
+// first file is kept. Returns the metadata of the written file.
+PARQUET_EXPORT
+std::shared_ptr<FileMetaData> CompactFiles(
+    const std::vector<ParquetFileReader*>& inputs,
+    const std::shared_ptr<OutputStream>& sink,
+    const std::shared_ptr<WriterProperties>& properties = default_writer_properties());
+
+// Rewrite the input file with the codecs of the writer properties, see
+// ParquetFileWriter::RecompressRowGroup. Returns the metadata of the written
+// file.
+PARQUET_EXPORT
+std::shared_ptr<FileMetaData> RecompressFile(
+    ParquetFileReader* input, const std::shared_ptr<OutputStream>& sink,
+    const std::shared_ptr<WriterProperties>& properties, int num_threads = 1);
+
 }  // namespace parquet
 
 #endif  // PARQUET_FILE_WRITER_H
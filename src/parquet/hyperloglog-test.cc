@@ -0,0 +1,91 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "parquet/bloom_filter.h"
+#include "parquet/exception.h"
+#include "parquet/hyperloglog.h"
+
+namespace parquet {
+
+namespace test {
+
+TEST(HyperLogLog, Estimate) {
+  for (int precision : {HyperLogLog::kMinPrecision, 10, 14}) {
+    // The relative standard error of the estimate
+    const double error = 1.04 / std::sqrt(static_cast<double>(1 << precision));
+    for (int64_t num_distinct : {1, 10, 1000, 100000}) {
+      HyperLogLog sketch(precision);
+      // Inserting a value again does not change the estimate
+      for (int repeat = 0; repeat < 2; ++repeat) {
+        for (int64_t i = 0; i < num_distinct; ++i) {
+          sketch.Update(BloomFilter::Hash(i));
+        }
+      }
+      ASSERT_NEAR(num_distinct, sketch.Estimate(), 4 * error * num_distinct + 1)
+          << "precision " << precision;
+    }
+    ASSERT_EQ(0, HyperLogLog(precision).Estimate());
+  }
+}
+
+TEST(HyperLogLog, Merge) {
+  HyperLogLog first(12), second(12), both(12);
+  for (int64_t i = 0; i < 30000; ++i) {
+    uint64_t hash = BloomFilter::Hash(i);
+    // Half of the values are in both sketches
+    if (i < 20000) first.Update(hash);
+    if (i >= 10000) second.Update(hash);
+    both.Update(hash);
+  }
+  first.Merge(second);
+  ASSERT_EQ(both.Estimate(), first.Estimate());
+  ASSERT_EQ(both.Serialize(), first.Serialize());
+
+  ASSERT_THROW(first.Merge(HyperLogLog(10)), ParquetException);
+}
+
+TEST(HyperLogLog, Serialize) {
+  HyperLogLog sketch(HyperLogLog::kMinPrecision);
+  for (int64_t i = 0; i < 100; ++i) {
+    sketch.Update(BloomFilter::Hash(i));
+  }
+  std::string serialized = sketch.Serialize();
+  ASSERT_EQ(2 + 16U, serialized.size());
+  ASSERT_EQ("4:", serialized.substr(0, 2));
+
+  std::unique_ptr<HyperLogLog> deserialized = HyperLogLog::Deserialize(serialized);
+  ASSERT_EQ(sketch.precision(), deserialized->precision());
+  ASSERT_EQ(sketch.Estimate(), deserialized->Estimate());
+  ASSERT_EQ(serialized, deserialized->Serialize());
+
+  ASSERT_THROW(HyperLogLog::Deserialize(""), ParquetException);
+  ASSERT_THROW(HyperLogLog::Deserialize("4:AAAA"), ParquetException);
+  ASSERT_THROW(HyperLogLog::Deserialize("3:AAAAAAAA"), ParquetException);
+  ASSERT_THROW(HyperLogLog::Deserialize("4:AAAAAAAAAAAAAAA*"), ParquetException);
+  ASSERT_THROW(HyperLogLog(HyperLogLog::kMaxPrecision + 1), ParquetException);
+}
+
+}  // namespace test
+
+}  // namespace parquet
@@ -0,0 +1,132 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "parquet/hyperloglog.h"
+
+#include <cmath>
+#include <sstream>
+
+#include "parquet/exception.h"
+
+namespace parquet {
+
+constexpr int HyperLogLog::kMinPrecision;
+constexpr int HyperLogLog::kMaxPrecision;
+const char HyperLogLog::kColumnChunkKey[] = "parquet.distinct_count.hll";
+
+namespace {
+
+// The registers hold ranks of at most 64 - kMinPrecision + 1 = 61, so each fits
+// a character of the base64 alphabet
+const char kRegisterChars[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+int RegisterValue(char c) {
+  if (c >= 'A' && c <= 'Z') return c - 'A';
+  if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+  if (c >= '0' && c <= '9') return c - '0' + 52;
+  if (c == '+') return 62;
+  if (c == '/') return 63;
+  return -1;
+}
+
+}  // namespace
+
+HyperLogLog::HyperLogLog(int precision) : precision_(precision) {
+  if (precision < kMinPrecision || precision > kMaxPrecision) {
+    std::stringstream ss;
+    ss << "HyperLogLog precision must be in [" << kMinPrecision << ", " << kMaxPrecision
+       << "], got " << precision;
+    throw ParquetException(ss.str());
+  }
+  registers_.assign(static_cast<size_t>(1) << precision, 0);
+}
+
+void HyperLogLog::Merge(const HyperLogLog& other) {
+  if (other.precision_ != precision_) {
+    throw ParquetException("Cannot merge HyperLogLog sketches of different precisions");
+  }
+  for (size_t i = 0; i < registers_.size(); ++i) {
+    if (registers_[i] < other.registers_[i]) registers_[i] = other.registers_[i];
+  }
+}
+
+int64_t HyperLogLog::Estimate() const {
+  const double m = static_cast<double>(registers_.size());
+  double sum = 0;
+  int64_t num_zeros = 0;
+  for (uint8_t value : registers_) {
+    sum += std::ldexp(1.0, -value);
+    if (value == 0) ++num_zeros;
+  }
+  double alpha;
+  switch (precision_) {
+    case 4:
+      alpha = 0.673;
+      break;
+    case 5:
+      alpha = 0.697;
+      break;
+    case 6:
+      alpha = 0.709;
+      break;
+    default:
+      alpha = 0.7213 / (1 + 1.079 / m);
+      break;
+  }
+  double estimate = alpha * m * m / sum;
+  // Small cardinalities are better estimated by linear counting. The hashes
+  // being 64-bit, no correction is needed for large ones.
+  if (estimate <= 2.5 * m && num_zeros > 0) {
+    estimate = m * std::log(m / static_cast<double>(num_zeros));
+  }
+  return static_cast<int64_t>(std::llround(estimate));
+}
+
+std::string HyperLogLog::Serialize() const {
+  std::stringstream ss;
+  ss << precision_ << ':';
+  std::string result = ss.str();
+  result.reserve(result.size() + registers_.size());
+  for (uint8_t value : registers_) result.push_back(kRegisterChars[value]);
+  return result;
+}
+
+std::unique_ptr<HyperLogLog> HyperLogLog::Deserialize(const std::string& serialized) {
+  size_t colon = serialized.find(':');
+  int precision = 0;
+  for (size_t i = 0; i < colon && i < 3; ++i) {
+    if (serialized[i] < '0' || serialized[i] > '9') break;
+    precision = precision * 10 + (serialized[i] - '0');
+  }
+  if (colon == std::string::npos || colon == 0 || colon > 2 ||
+      precision < kMinPrecision || precision > kMaxPrecision ||
+      serialized.size() - colon - 1 != (static_cast<size_t>(1) << precision)) {
+    throw ParquetException("Invalid serialized HyperLogLog sketch");
+  }
+  std::unique_ptr<HyperLogLog> sketch(new HyperLogLog(precision));
+  for (size_t i = 0; i < sketch->registers_.size(); ++i) {
+    int value = RegisterValue(serialized[colon + 1 + i]);
+    if (value < 0 || value > 64 - precision + 1) {
+      throw ParquetException("Invalid serialized HyperLogLog sketch");
+    }
+    sketch->registers_[i] = static_cast<uint8_t>(value);
+  }
+  return sketch;
+}
+
+}  // namespace parquet
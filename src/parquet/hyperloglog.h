@@ -0,0 +1,82 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef PARQUET_HYPERLOGLOG_H
+#define PARQUET_HYPERLOGLOG_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "parquet/util/visibility.h"
+
+namespace parquet {
+
+// A HyperLogLog sketch estimating the number of distinct values among the
+// 64-bit hashes inserted in it. It has 2^precision one-byte registers and the
+// relative standard error of its estimate is about 1.04 / sqrt(2^precision).
+// Sketches of the same precision are merged by taking the maximum of each
+// register, so the sketches of the column chunks of a column can be combined
+// into the sketch of the whole column.
+class PARQUET_EXPORT HyperLogLog {
+ public:
+  static constexpr int kMinPrecision = 4;
+  static constexpr int kMaxPrecision = 18;
+
+  // Key of the column chunk key-value metadata holding the serialized sketch
+  // of the chunk, see WriterProperties::Builder::write_distinct_count_sketches
+  static const char kColumnChunkKey[];
+
+  explicit HyperLogLog(int precision);
+
+  // Parse a sketch written by Serialize
+  static std::unique_ptr<HyperLogLog> Deserialize(const std::string& serialized);
+
+  void Update(uint64_t hash) {
+    const uint32_t index = static_cast<uint32_t>(hash >> (64 - precision_));
+    // Rank of the first set bit among the remaining ones, the register
+    // index bits being shifted out
+    uint64_t bits = hash << precision_;
+    uint8_t rank = 1;
+    const uint8_t max_rank = static_cast<uint8_t>(64 - precision_ + 1);
+    while (rank < max_rank && (bits & (1ULL << 63)) == 0) {
+      bits <<= 1;
+      ++rank;
+    }
+    if (registers_[index] < rank) registers_[index] = rank;
+  }
+
+  // Merge a sketch of the same precision into this one
+  void Merge(const HyperLogLog& other);
+
+  int64_t Estimate() const;
+
+  int precision() const { return precision_; }
+
+  // Printable form of the precision and the registers, one character per
+  // register
+  std::string Serialize() const;
+
+ private:
+  int precision_;
+  std::vector<uint8_t> registers_;
+};
+
+}  // namespace parquet
+
+#endif  // PARQUET_HYPERLOGLOG_H
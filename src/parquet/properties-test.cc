@@ -35,6 +35,19 @@ TEST(TestReaderProperties, Basics) {
   ASSERT_EQ(DEFAULT_USE_BUFFERED_STREAM, props.is_buffered_stream_enabled());
 }
 
+TEST(TestReaderProperties, AccessHintDepth) {
+  ReaderProperties props;
+
+  ASSERT_EQ(DEFAULT_ACCESS_HINT_DEPTH, props.access_hint_depth());
+  props.set_access_hint_depth(0);
+  ASSERT_EQ(0, props.access_hint_depth());
+  props.set_access_hint_depth(MAX_ACCESS_HINT_DEPTH);
+  ASSERT_EQ(MAX_ACCESS_HINT_DEPTH, props.access_hint_depth());
+  ASSERT_THROW(props.set_access_hint_depth(-1), ParquetException);
+  ASSERT_THROW(props.set_access_hint_depth(MAX_ACCESS_HINT_DEPTH + 1), ParquetException);
+  ASSERT_EQ(MAX_ACCESS_HINT_DEPTH, props.access_hint_depth());
+}
+
 TEST(TestWriterProperties, Basics) {
   std::shared_ptr<WriterProperties> props = WriterProperties::Builder().build();
 
@@ -60,5 +73,59 @@ TEST(TestWriterProperties, AdvancedHandling) {
             props->encoding(ColumnPath::FromDotString("delta-length")));
 }
 
+TEST(TestWriterProperties, CompressionLevel) {
+  // The codecs have no level setting yet, only uncompressed columns may be
+  // given a level
+  WriterProperties::Builder builder;
+  builder.compression(Compression::ZSTD);
+  builder.compression("raw", Compression::UNCOMPRESSED);
+  builder.compression_level("raw", 19);
+  std::shared_ptr<WriterProperties> props = builder.build();
+  ASSERT_EQ(DEFAULT_COMPRESSION_LEVEL,
+            props->compression_level(ColumnPath::FromDotString("other")));
+  ASSERT_EQ(19, props->compression_level(ColumnPath::FromDotString("raw")));
+
+  builder.compression_level("cold", 19);
+  ASSERT_THROW(builder.build(), ParquetException);
+
+  WriterProperties::Builder default_level;
+  default_level.compression(Compression::SNAPPY)->compression_level(1);
+  ASSERT_THROW(default_level.build(), ParquetException);
+}
+
+TEST(TestWriterMemoryBudget, LargestWriterReleasesDownToLowWaterMark) {
+  WriterMemoryBudget budget(1000, 600);
+  int a, b, c;
+  ASSERT_FALSE(budget.Update(&a, 500));
+  ASSERT_FALSE(budget.Update(&b, 400));
+  // Over the limit, only the largest writer releases
+  ASSERT_FALSE(budget.Update(&c, 200));
+  ASSERT_TRUE(budget.exceeded());
+  ASSERT_FALSE(budget.Update(&b, 410));
+  ASSERT_TRUE(budget.Update(&a, 500));
+  ASSERT_FALSE(budget.Update(&a, 0));
+  ASSERT_EQ(610, budget.buffered_size());
+  // Still above the low water mark, the next largest writer releases
+  ASSERT_FALSE(budget.Update(&c, 200));
+  ASSERT_TRUE(budget.Update(&b, 420));
+  ASSERT_FALSE(budget.Update(&b, 0));
+  // Under the limit again, nobody releases until it is exceeded
+  ASSERT_FALSE(budget.Update(&c, 900));
+  ASSERT_FALSE(budget.exceeded());
+  ASSERT_FALSE(budget.Update(&c, 0));
+  ASSERT_EQ(0, budget.buffered_size());
+}
+
+TEST(TestWriterMemoryBudget, AnyWriterReleasesFarOverTheLimit) {
+  WriterMemoryBudget budget(1000);
+  ASSERT_EQ(750, budget.low_water_mark());
+  int a, b;
+  ASSERT_FALSE(budget.Update(&a, 900));
+  ASSERT_FALSE(budget.Update(&b, 200));
+  // The largest writer is not updated again
+  ASSERT_FALSE(budget.Update(&b, 300));
+  ASSERT_TRUE(budget.Update(&b, 400));
+}
+
 }  // namespace test
 }  // namespace parquet
@@ -18,9 +18,13 @@
 #ifndef PARQUET_COLUMN_PROPERTIES_H
 #define PARQUET_COLUMN_PROPERTIES_H
 
+#include <algorithm>
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "parquet/exception.h"
 #include "parquet/parquet_version.h"
@@ -35,8 +39,107 @@ struct ParquetVersion {
   enum type { PARQUET_1_0, PARQUET_2_0 };
 };
 
+// Format of the data pages: V2 pages store the levels uncompressed ahead of
+// the values, so that they can be decoded without decompressing the page
+struct ParquetDataPageVersion {
+  enum type { V1, V2 };
+};
+
 static int64_t DEFAULT_BUFFER_SIZE = 0;
 static bool DEFAULT_USE_BUFFERED_STREAM = false;
+static constexpr bool DEFAULT_IS_READ_AHEAD_ENABLED = false;
+
+// When pre-buffering column chunks, byte ranges separated by at most this
+// many bytes are merged into a single read
+static constexpr int64_t DEFAULT_COALESCE_HOLE_SIZE_LIMIT = 8 * 1024;
+// Merged ranges are not grown beyond this size, so that a single coalesced
+// read stays bounded
+static constexpr int64_t DEFAULT_COALESCE_RANGE_SIZE_LIMIT = 32 * 1024 * 1024;
+// PARQUET-978: Minimize footer reads by reading 64 KB from the end of the file
+static constexpr int64_t DEFAULT_FOOTER_READ_SIZE = 64 * 1024;
+static constexpr bool DEFAULT_IS_PAGE_PREFETCH_ENABLED = false;
+// Number of decompressed pages a column chunk reader may hold ahead of the
+// page being decoded
+static constexpr int DEFAULT_PAGE_PREFETCH_DEPTH = 4;
+static constexpr int64_t DEFAULT_PAGE_PREFETCH_MEMORY_LIMIT = 16 * 1024 * 1024;
+static constexpr bool DEFAULT_IS_LAZY_METADATA_ENABLED = false;
+static constexpr bool DEFAULT_ARE_ACCESS_HINTS_ENABLED = false;
+// Number of row groups ahead of the one being read whose column chunks are
+// announced to the OS
+static constexpr int DEFAULT_ACCESS_HINT_DEPTH = 1;
+// Each opened column chunk issues a hint per row group of the depth
+static constexpr int MAX_ACCESS_HINT_DEPTH = 64;
+
+// Counters of the reads of one column, accumulated over its column chunks.
+// The times are in nanoseconds.
+struct PARQUET_EXPORT ColumnReaderStats {
+  std::atomic<int64_t> data_pages{0};
+  std::atomic<int64_t> dictionary_pages{0};
+  // Data pages whose values are dictionary-encoded, the others are PLAIN or
+  // use another encoding
+  std::atomic<int64_t> dictionary_encoded_pages{0};
+  // Data pages dropped from their header, by a page filter or while skipping
+  // rows, without being read or decompressed
+  std::atomic<int64_t> pages_skipped{0};
+  std::atomic<int64_t> rows_skipped{0};
+  // Sizes of the pages read, as stored and once decompressed
+  std::atomic<int64_t> compressed_bytes{0};
+  std::atomic<int64_t> uncompressed_bytes{0};
+  std::atomic<int64_t> io_time{0};
+  std::atomic<int64_t> decompression_time{0};
+  std::atomic<int64_t> level_decoding_time{0};
+  std::atomic<int64_t> value_decoding_time{0};
+};
+
+// The counter of the statistics, nullptr if they are not collected (see
+// ScopedStopWatch)
+template <typename Stats>
+inline std::atomic<int64_t>* StatsCounter(Stats* stats,
+                                          std::atomic<int64_t> Stats::*counter) {
+  return stats != nullptr ? &(stats->*counter) : nullptr;
+}
+
+// Add delta to the counter, if the statistics are collected
+template <typename Stats>
+inline void UpdateStats(Stats* stats, std::atomic<int64_t> Stats::*counter,
+                        int64_t delta) {
+  if (stats != nullptr) {
+    (stats->*counter).fetch_add(delta, std::memory_order_relaxed);
+  }
+}
+
+// Counters of one or more files, per leaf column index, created on first use.
+// Thread-safe, so that columns and row groups may be read or written in
+// parallel.
+template <typename ColumnStats>
+class PerColumnStats {
+ public:
+  PerColumnStats() {}
+
+  // The counters of the i-th leaf column. The returned pointer is valid for
+  // the lifetime of this instance.
+  ColumnStats* column(int i) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    while (static_cast<int>(columns_.size()) <= i) {
+      columns_.emplace_back(new ColumnStats());
+    }
+    return columns_[i].get();
+  }
+
+  // Number of columns with counters
+  int num_columns() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<int>(columns_.size());
+  }
+
+ private:
+  std::mutex mutex_;
+  std::vector<std::unique_ptr<ColumnStats>> columns_;
+};
+
+// Performance counters of the readers, collected only if set on the
+// ReaderProperties, see ReaderProperties::set_reader_stats
+using ReaderStats = PerColumnStats<ColumnReaderStats>;
 
 class PARQUET_EXPORT ReaderProperties {
  public:
@@ -44,6 +147,16 @@ class PARQUET_EXPORT ReaderProperties {
       : pool_(pool) {
     buffered_stream_enabled_ = DEFAULT_USE_BUFFERED_STREAM;
     buffer_size_ = DEFAULT_BUFFER_SIZE;
+    read_ahead_enabled_ = DEFAULT_IS_READ_AHEAD_ENABLED;
+    coalesce_hole_size_limit_ = DEFAULT_COALESCE_HOLE_SIZE_LIMIT;
+    coalesce_range_size_limit_ = DEFAULT_COALESCE_RANGE_SIZE_LIMIT;
+    page_prefetch_enabled_ = DEFAULT_IS_PAGE_PREFETCH_ENABLED;
+    page_prefetch_depth_ = DEFAULT_PAGE_PREFETCH_DEPTH;
+    page_prefetch_memory_limit_ = DEFAULT_PAGE_PREFETCH_MEMORY_LIMIT;
+    footer_read_size_ = DEFAULT_FOOTER_READ_SIZE;
+    lazy_metadata_enabled_ = DEFAULT_IS_LAZY_METADATA_ENABLED;
+    access_hints_enabled_ = DEFAULT_ARE_ACCESS_HINTS_ENABLED;
+    access_hint_depth_ = DEFAULT_ACCESS_HINT_DEPTH;
   }
 
   ::arrow::MemoryPool* memory_pool() const { return pool_; }
@@ -51,9 +164,15 @@ class PARQUET_EXPORT ReaderProperties {
   std::unique_ptr<InputStream> GetStream(RandomAccessSource* source, int64_t start,
                                          int64_t num_bytes) {
     std::unique_ptr<InputStream> stream;
-    if (buffered_stream_enabled_) {
-      stream.reset(
-          new BufferedInputStream(pool_, buffer_size_, source, start, num_bytes));
+    // Buffering a zero-copy source (e.g. a memory map) would only add copies
+    if (buffered_stream_enabled_ && !source->supports_zero_copy()) {
+      if (read_ahead_enabled_) {
+        stream.reset(
+            new ReadAheadInputStream(pool_, buffer_size_, source, start, num_bytes));
+      } else {
+        stream.reset(
+            new BufferedInputStream(pool_, buffer_size_, source, start, num_bytes));
+      }
     } else {
       stream.reset(new InMemoryInputStream(source, start, num_bytes));
     }
@@ -70,10 +189,120 @@ class PARQUET_EXPORT ReaderProperties {
 
   int64_t buffer_size() const { return buffer_size_; }
 
+  // When enabled, buffered streams read their next window in the background
+  // and grow it with every refill, starting at buffer_size bytes
+  bool is_read_ahead_enabled() const { return read_ahead_enabled_; }
+
+  void enable_read_ahead() { read_ahead_enabled_ = true; }
+
+  void disable_read_ahead() { read_ahead_enabled_ = false; }
+
+  // Byte ranges closer than this are read together by ParquetFileReader::PreBuffer
+  void set_coalesce_hole_size_limit(int64_t limit) { coalesce_hole_size_limit_ = limit; }
+
+  int64_t coalesce_hole_size_limit() const { return coalesce_hole_size_limit_; }
+
+  // Upper bound on the size of a single coalesced read
+  void set_coalesce_range_size_limit(int64_t limit) {
+    coalesce_range_size_limit_ = limit;
+  }
+
+  int64_t coalesce_range_size_limit() const { return coalesce_range_size_limit_; }
+
+  // When enabled, every column chunk reader reads and decompresses its next
+  // pages on a background thread while the current page is being decoded
+  bool is_page_prefetch_enabled() const { return page_prefetch_enabled_; }
+
+  void enable_page_prefetch() { page_prefetch_enabled_ = true; }
+
+  void disable_page_prefetch() { page_prefetch_enabled_ = false; }
+
+  // Maximum number of pages read ahead
+  void set_page_prefetch_depth(int depth) { page_prefetch_depth_ = depth; }
+
+  int page_prefetch_depth() const { return page_prefetch_depth_; }
+
+  // Maximum number of decompressed bytes read ahead. At least one page is
+  // always read ahead, even if it is larger.
+  void set_page_prefetch_memory_limit(int64_t limit) {
+    page_prefetch_memory_limit_ = limit;
+  }
+
+  int64_t page_prefetch_memory_limit() const { return page_prefetch_memory_limit_; }
+
+  // Number of bytes speculatively read from the end of the file when opening
+  // it. If the file metadata fits, it is parsed from this single read; a
+  // second read is only issued for larger footers.
+  void set_footer_read_size(int64_t size) { footer_read_size_ = size; }
+
+  int64_t footer_read_size() const { return footer_read_size_; }
+
+  // When enabled, the row group and column chunk metadata of the file footer
+  // is only decoded when it is first accessed. Useful for very wide files of
+  // which only a few columns are read.
+  bool is_lazy_metadata_enabled() const { return lazy_metadata_enabled_; }
+
+  void enable_lazy_metadata() { lazy_metadata_enabled_ = true; }
+
+  void disable_lazy_metadata() { lazy_metadata_enabled_ = false; }
+
+  // When enabled, opening a column chunk for a scan tells the OS that it and
+  // the same column in the next access_hint_depth row groups are about to be
+  // read sequentially, and that the chunk of the previous row group is no
+  // longer needed (see RandomAccessSource::Advise). Useful for large scans of
+  // local files, which would otherwise evict the rest of the page cache.
+  bool are_access_hints_enabled() const { return access_hints_enabled_; }
+
+  void enable_access_hints() { access_hints_enabled_ = true; }
+
+  void disable_access_hints() { access_hints_enabled_ = false; }
+
+  // Between 0 and MAX_ACCESS_HINT_DEPTH
+  void set_access_hint_depth(int depth) {
+    if (depth < 0 || depth > MAX_ACCESS_HINT_DEPTH) {
+      throw ParquetException("The access hint depth must be between 0 and " +
+                             std::to_string(MAX_ACCESS_HINT_DEPTH));
+    }
+    access_hint_depth_ = depth;
+  }
+
+  int access_hint_depth() const { return access_hint_depth_; }
+
+  // Pool from which the page readers lease their decompression buffers. If
+  // unset, each file reader creates its own pool, shared by its columns.
+  void set_decompression_buffer_pool(
+      const std::shared_ptr<DecompressionBufferPool>& buffer_pool) {
+    decompression_buffer_pool_ = buffer_pool;
+  }
+
+  const std::shared_ptr<DecompressionBufferPool>& decompression_buffer_pool() const {
+    return decompression_buffer_pool_;
+  }
+
+  // Counters updated by the page and column readers, nullptr by default as
+  // they are not collected
+  void set_reader_stats(const std::shared_ptr<ReaderStats>& stats) {
+    reader_stats_ = stats;
+  }
+
+  const std::shared_ptr<ReaderStats>& reader_stats() const { return reader_stats_; }
+
  private:
   ::arrow::MemoryPool* pool_;
   int64_t buffer_size_;
   bool buffered_stream_enabled_;
+  bool read_ahead_enabled_;
+  int64_t coalesce_hole_size_limit_;
+  int64_t coalesce_range_size_limit_;
+  bool page_prefetch_enabled_;
+  int page_prefetch_depth_;
+  int64_t page_prefetch_memory_limit_;
+  int64_t footer_read_size_;
+  bool lazy_metadata_enabled_;
+  bool access_hints_enabled_;
+  int access_hint_depth_;
+  std::shared_ptr<DecompressionBufferPool> decompression_buffer_pool_;
+  std::shared_ptr<ReaderStats> reader_stats_;
 };
 
 ReaderProperties PARQUET_EXPORT default_reader_properties();
@@ -81,6 +310,8 @@ ReaderProperties PARQUET_EXPORT default_reader_properties();
 static constexpr int64_t DEFAULT_PAGE_SIZE = 1024 * 1024;
 static constexpr bool DEFAULT_IS_DICTIONARY_ENABLED = true;
 static constexpr int64_t DEFAULT_DICTIONARY_PAGE_SIZE_LIMIT = DEFAULT_PAGE_SIZE;
+// 0 means that dictionary encoding only falls back once the dictionary page is full
+static constexpr int64_t DEFAULT_DICTIONARY_BENEFIT_CHECK_VALUES = 0;
 static constexpr int64_t DEFAULT_WRITE_BATCH_SIZE = 1024;
 static constexpr int64_t DEFAULT_MAX_ROW_GROUP_LENGTH = 64 * 1024 * 1024;
 static constexpr bool DEFAULT_ARE_STATISTICS_ENABLED = true;
@@ -89,22 +320,170 @@ static constexpr ParquetVersion::type DEFAULT_WRITER_VERSION =
     ParquetVersion::PARQUET_1_0;
 static const char DEFAULT_CREATED_BY[] = CREATED_BY_VERSION;
 static constexpr Compression::type DEFAULT_COMPRESSION_TYPE = Compression::UNCOMPRESSED;
+static constexpr int DEFAULT_COMPRESSION_LEVEL = kDefaultCompressionLevel;
+static constexpr bool DEFAULT_IS_PAGE_INDEX_ENABLED = false;
+static constexpr ParquetDataPageVersion::type DEFAULT_DATA_PAGE_VERSION =
+    ParquetDataPageVersion::V1;
+static constexpr bool DEFAULT_IS_BLOOM_FILTER_ENABLED = false;
+static constexpr int64_t DEFAULT_BLOOM_FILTER_NDV = 1024 * 1024;
+static constexpr double DEFAULT_BLOOM_FILTER_FPP = 0.05;
+static constexpr bool DEFAULT_IS_ASYNC_COMPRESSION_ENABLED = false;
+static constexpr int DEFAULT_ASYNC_COMPRESSION_QUEUE_SIZE = 4;
+// 0 means that buffered row groups are kept in memory entirely
+static constexpr int64_t DEFAULT_BUFFERED_ROW_GROUP_MEMORY_LIMIT = 0;
+// 0 means that data pages are only limited by their size
+static constexpr int64_t DEFAULT_DATA_PAGE_VALUES_LIMIT = 0;
+// 0 means that row groups are only limited by their number of rows
+static constexpr int64_t DEFAULT_MAX_ROW_GROUP_BYTES = 0;
+static constexpr int64_t DEFAULT_MIN_ROW_GROUP_LENGTH = 64 * 1024;
+// 0 means that the min and max statistics are written in full
+static constexpr int64_t DEFAULT_STATISTICS_TRUNCATE_LENGTH = 0;
+static constexpr bool DEFAULT_IS_DISTINCT_COUNT_ENABLED = false;
+// 2^12 registers, for a relative standard error of about 1.6%
+static constexpr int DEFAULT_DISTINCT_COUNT_PRECISION = 12;
+static constexpr bool DEFAULT_WRITE_DISTINCT_COUNT_SKETCHES = false;
+// 0 means that every write goes straight to the sink
+static constexpr int64_t DEFAULT_OUTPUT_BUFFER_SIZE = 0;
+
+struct BloomFilterOptions {
+  BloomFilterOptions(int64_t ndv = DEFAULT_BLOOM_FILTER_NDV,
+                     double fpp = DEFAULT_BLOOM_FILTER_FPP)
+      : ndv(ndv), fpp(fpp) {}
+
+  // Number of distinct values expected in a column chunk. Dictionary-encoded
+  // chunks with fewer distinct values get a smaller filter.
+  int64_t ndv;
+  // False positive probability once ndv distinct values are inserted
+  double fpp;
+};
+
+// Counters of the writes of one column, accumulated over its column chunks.
+// The times are in nanoseconds.
+struct PARQUET_EXPORT ColumnWriterStats {
+  // Values and levels in the data pages written
+  std::atomic<int64_t> values{0};
+  std::atomic<int64_t> data_pages{0};
+  std::atomic<int64_t> dictionary_pages{0};
+  // Sizes of the pages written, once encoded and as stored
+  std::atomic<int64_t> encoded_bytes{0};
+  std::atomic<int64_t> compressed_bytes{0};
+  // Encoded size of the dictionary pages
+  std::atomic<int64_t> dictionary_bytes{0};
+  // Column chunks which fell back from dictionary encoding, and the
+  // DictionaryFallback::type and number of rows written to the chunk at the
+  // last fallback
+  std::atomic<int64_t> dictionary_fallbacks{0};
+  std::atomic<int64_t> last_fallback_reason{0};
+  std::atomic<int64_t> last_fallback_row{-1};
+  std::atomic<int64_t> encoding_time{0};
+  std::atomic<int64_t> statistics_time{0};
+  std::atomic<int64_t> compression_time{0};
+  // Time spent writing to the sink, which is in memory for buffered row groups
+  std::atomic<int64_t> io_time{0};
+};
+
+// Performance counters of the writers, collected only if set on the
+// WriterProperties, see WriterProperties::Builder::writer_stats
+using WriterStats = PerColumnStats<ColumnWriterStats>;
+
+// Bounds the bytes that column writers hold in memory until their pages are
+// written: buffered values and levels, dictionaries and the pages buffered
+// while dictionary encoding, as well as the in-memory pages of buffered row
+// groups. Once the total exceeds the limit, the writers release what they
+// hold, falling back from dictionary encoding or writing their current page,
+// the largest one first, until the total is back under the low water mark.
+// The budget may be shared by several file writers. Thread-safe.
+class PARQUET_EXPORT WriterMemoryBudget {
+ public:
+  // The low water mark defaults to 3/4 of the limit
+  explicit WriterMemoryBudget(int64_t limit, int64_t low_water_mark = -1)
+      : limit_(limit),
+        low_water_mark_(low_water_mark >= 0 ? std::min(low_water_mark, limit)
+                                            : limit / 4 * 3),
+        buffered_size_(0),
+        releasing_(false) {}
+
+  // Set the bytes held by a writer, identified by consumer, 0 once it holds
+  // none. Returns true if the writer should release what it holds: the
+  // budget is being released down to the low water mark and it is the
+  // largest writer. Should the largest writer not be updated again, any
+  // writer releases once the total exceeds the limit by as much as the low
+  // water mark is below it.
+  bool Update(const void* consumer, int64_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = consumers_.find(consumer);
+    int64_t previous = it != consumers_.end() ? it->second : 0;
+    int64_t buffered_size = buffered_size_.load() + bytes - previous;
+    buffered_size_.store(buffered_size);
+    if (bytes > 0) {
+      consumers_[consumer] = bytes;
+    } else if (it != consumers_.end()) {
+      consumers_.erase(it);
+    }
+    if (buffered_size > limit_) {
+      releasing_ = true;
+    } else if (buffered_size <= low_water_mark_) {
+      releasing_ = false;
+    }
+    if (!releasing_ || bytes == 0) {
+      return false;
+    }
+    if (buffered_size > 2 * limit_ - low_water_mark_) {
+      return true;
+    }
+    for (const auto& item : consumers_) {
+      if (item.second > bytes) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // If true, callers that can close their row group early should do so
+  bool exceeded() const { return buffered_size() > limit_; }
+
+  int64_t limit() const { return limit_; }
+
+  int64_t low_water_mark() const { return low_water_mark_; }
+
+  int64_t buffered_size() const { return buffered_size_.load(); }
+
+ private:
+  int64_t limit_;
+  int64_t low_water_mark_;
+  std::mutex mutex_;
+  // The bytes held by each writer holding any
+  std::unordered_map<const void*, int64_t> consumers_;
+  std::atomic<int64_t> buffered_size_;
+  // Whether the total went over the limit and not yet under the low water mark
+  bool releasing_;
+};
 
 class PARQUET_EXPORT ColumnProperties {
  public:
   ColumnProperties(Encoding::type encoding = DEFAULT_ENCODING,
                    Compression::type codec = DEFAULT_COMPRESSION_TYPE,
                    bool dictionary_enabled = DEFAULT_IS_DICTIONARY_ENABLED,
-                   bool statistics_enabled = DEFAULT_ARE_STATISTICS_ENABLED)
+                   bool statistics_enabled = DEFAULT_ARE_STATISTICS_ENABLED,
+                   bool bloom_filter_enabled = DEFAULT_IS_BLOOM_FILTER_ENABLED,
+                   bool distinct_count_enabled = DEFAULT_IS_DISTINCT_COUNT_ENABLED,
+                   int compression_level = DEFAULT_COMPRESSION_LEVEL)
       : encoding(encoding),
         codec(codec),
         dictionary_enabled(dictionary_enabled),
-        statistics_enabled(statistics_enabled) {}
+        statistics_enabled(statistics_enabled),
+        bloom_filter_enabled(bloom_filter_enabled),
+        distinct_count_enabled(distinct_count_enabled),
+        compression_level(compression_level) {}
 
   Encoding::type encoding;
   Compression::type codec;
   bool dictionary_enabled;
   bool statistics_enabled;
+  bool bloom_filter_enabled;
+  BloomFilterOptions bloom_filter_options;
+  bool distinct_count_enabled;
+  int compression_level;
 };
 
 class PARQUET_EXPORT WriterProperties {
@@ -114,11 +493,24 @@ class PARQUET_EXPORT WriterProperties {
     Builder()
         : pool_(::arrow::default_memory_pool()),
           dictionary_pagesize_limit_(DEFAULT_DICTIONARY_PAGE_SIZE_LIMIT),
+          dictionary_benefit_check_values_(DEFAULT_DICTIONARY_BENEFIT_CHECK_VALUES),
           write_batch_size_(DEFAULT_WRITE_BATCH_SIZE),
           max_row_group_length_(DEFAULT_MAX_ROW_GROUP_LENGTH),
           pagesize_(DEFAULT_PAGE_SIZE),
           version_(DEFAULT_WRITER_VERSION),
-          created_by_(DEFAULT_CREATED_BY) {}
+          created_by_(DEFAULT_CREATED_BY),
+          page_index_enabled_(DEFAULT_IS_PAGE_INDEX_ENABLED),
+          data_page_version_(DEFAULT_DATA_PAGE_VERSION),
+          async_compression_enabled_(DEFAULT_IS_ASYNC_COMPRESSION_ENABLED),
+          async_compression_queue_size_(DEFAULT_ASYNC_COMPRESSION_QUEUE_SIZE),
+          buffered_row_group_memory_limit_(DEFAULT_BUFFERED_ROW_GROUP_MEMORY_LIMIT),
+          data_page_values_limit_(DEFAULT_DATA_PAGE_VALUES_LIMIT),
+          max_row_group_bytes_(DEFAULT_MAX_ROW_GROUP_BYTES),
+          min_row_group_length_(DEFAULT_MIN_ROW_GROUP_LENGTH),
+          statistics_truncate_length_(DEFAULT_STATISTICS_TRUNCATE_LENGTH),
+          distinct_count_precision_(DEFAULT_DISTINCT_COUNT_PRECISION),
+          write_distinct_count_sketches_(DEFAULT_WRITE_DISTINCT_COUNT_SKETCHES),
+          output_buffer_size_(DEFAULT_OUTPUT_BUFFER_SIZE) {}
     virtual ~Builder() {}
 
     Builder* memory_pool(::arrow::MemoryPool* pool) {
@@ -159,6 +551,17 @@ class PARQUET_EXPORT WriterProperties {
       return this;
     }
 
+    /**
+     * Once this many values of a column chunk are dictionary encoded, compare
+     * the size of the dictionary and of the indices with the PLAIN encoded size
+     * of the values, and fall back to the column's encoding right away if the
+     * dictionary is not smaller. 0 disables the check.
+     */
+    Builder* dictionary_benefit_check_values(int64_t num_values) {
+      dictionary_benefit_check_values_ = num_values;
+      return this;
+    }
+
     Builder* write_batch_size(int64_t write_batch_size) {
       write_batch_size_ = write_batch_size;
       return this;
@@ -169,11 +572,54 @@ class PARQUET_EXPORT WriterProperties {
       return this;
     }
 
+    /**
+     * Target size in bytes of the row groups written by parquet::arrow::FileWriter.
+     * Their number of rows is derived from the encoded size of the rows written
+     * so far, and is still bounded by max_row_group_length and the chunk size
+     * passed to WriteTable. 0 disables the limit.
+     */
+    Builder* max_row_group_bytes(int64_t max_row_group_bytes) {
+      max_row_group_bytes_ = max_row_group_bytes;
+      return this;
+    }
+
+    /**
+     * Number of rows below which parquet::arrow::FileWriter does not close a
+     * row group early because the memory budget is exceeded (see
+     * memory_budget). The column writers still release their memory, without
+     * cutting the row group into many small ones while memory is tight.
+     */
+    Builder* min_row_group_length(int64_t min_row_group_length) {
+      min_row_group_length_ = min_row_group_length;
+      return this;
+    }
+
+    /**
+     * Maximum length in bytes of the min and max statistics of BYTE_ARRAY
+     * columns, in the page headers and the column chunk metadata. Longer
+     * values are truncated: the min to a prefix, the max to a prefix rounded
+     * up, so that both still bound the values. 0 disables truncation.
+     */
+    Builder* statistics_truncate_length(int64_t length) {
+      statistics_truncate_length_ = length;
+      return this;
+    }
+
     Builder* data_pagesize(int64_t pg_size) {
       pagesize_ = pg_size;
       return this;
     }
 
+    /**
+     * Maximum number of values (including nulls) of a data page. A page is
+     * completed once it reaches this number of values or data_pagesize bytes,
+     * whichever comes first. 0 disables the limit.
+     */
+    Builder* data_page_values_limit(int64_t limit) {
+      data_page_values_limit_ = limit;
+      return this;
+    }
+
     Builder* version(ParquetVersion::type version) {
       version_ = version;
       return this;
@@ -184,6 +630,67 @@ class PARQUET_EXPORT WriterProperties {
       return this;
     }
 
+    /**
+     * Write a ColumnIndex and an OffsetIndex for every column chunk, placed
+     * before the file footer. The ColumnIndex is only written for chunks where
+     * all pages have statistics.
+     */
+    Builder* enable_page_index() {
+      page_index_enabled_ = true;
+      return this;
+    }
+
+    Builder* disable_page_index() {
+      page_index_enabled_ = false;
+      return this;
+    }
+
+    /**
+     * Write DATA_PAGE_V2 pages, whose header also records the number of nulls
+     * and rows of the page. Only the values are compressed.
+     */
+    Builder* data_page_version(ParquetDataPageVersion::type data_page_version) {
+      data_page_version_ = data_page_version;
+      return this;
+    }
+
+    /**
+     * Compress the data pages of compressed columns on the default
+     * ThreadPool while the next pages are encoded. The pages are still
+     * written in order.
+     */
+    Builder* enable_async_compression() {
+      async_compression_enabled_ = true;
+      return this;
+    }
+
+    Builder* disable_async_compression() {
+      async_compression_enabled_ = false;
+      return this;
+    }
+
+    /**
+     * Maximum number of encoded pages waiting for compression. Encoding blocks
+     * when it is reached.
+     */
+    Builder* async_compression_queue_size(int queue_size) {
+      async_compression_queue_size_ = queue_size;
+      return this;
+    }
+
+    /**
+     * Maximum number of bytes of encoded pages that the column chunks of a
+     * buffered row group (see ParquetFileWriter::AppendBufferedRowGroup) keep
+     * in memory, including the pages held while dictionary encoding. Beyond
+     * it, the chunk being written moves its pages to a temporary file, from
+     * which they are copied when the row group is closed, falling back from
+     * dictionary encoding first if it holds pages. 0 disables the limit.
+     */
+    Builder* buffered_row_group_memory_limit(int64_t limit) {
+      buffered_row_group_memory_limit_ = limit;
+      return this;
+    }
+
     /**
      * Define the encoding that is used when we don't utilise dictionary encoding.
      *
@@ -242,6 +749,28 @@ class PARQUET_EXPORT WriterProperties {
       return this->compression(path->ToDotString(), codec);
     }
 
+    /**
+     * Compression level of the codec, e.g. 1 to write hot columns fast with
+     * ZSTD and 19 for archival ones. DEFAULT_COMPRESSION_LEVEL selects the
+     * default level of the codec. Not implemented yet: the codecs of Arrow
+     * have no level setting, so build() throws NYI if a compressed column is
+     * given any other level.
+     */
+    Builder* compression_level(int level) {
+      default_column_properties_.compression_level = level;
+      return this;
+    }
+
+    Builder* compression_level(const std::string& path, int level) {
+      compression_levels_[path] = level;
+      return this;
+    }
+
+    Builder* compression_level(const std::shared_ptr<schema::ColumnPath>& path,
+                               int level) {
+      return this->compression_level(path->ToDotString(), level);
+    }
+
     Builder* enable_statistics() {
       default_column_properties_.statistics_enabled = true;
       return this;
@@ -270,6 +799,139 @@ class PARQUET_EXPORT WriterProperties {
       return this->disable_statistics(path->ToDotString());
     }
 
+    /**
+     * Write a split block Bloom filter for every chunk of the column, for
+     * equality lookups (see RowGroupReader::GetBloomFilter). BOOLEAN columns
+     * never get one.
+     */
+    Builder* enable_bloom_filter(
+        const std::string& path,
+        const BloomFilterOptions& options = BloomFilterOptions()) {
+      bloom_filter_enabled_[path] = true;
+      bloom_filter_options_[path] = options;
+      return this;
+    }
+
+    Builder* enable_bloom_filter(
+        const std::shared_ptr<schema::ColumnPath>& path,
+        const BloomFilterOptions& options = BloomFilterOptions()) {
+      return this->enable_bloom_filter(path->ToDotString(), options);
+    }
+
+    Builder* disable_bloom_filter(const std::string& path) {
+      bloom_filter_enabled_[path] = false;
+      return this;
+    }
+
+    Builder* disable_bloom_filter(const std::shared_ptr<schema::ColumnPath>& path) {
+      return this->disable_bloom_filter(path->ToDotString());
+    }
+
+    /**
+     * Estimate the number of distinct values of every chunk of the column with
+     * a HyperLogLog sketch (see hyperloglog.h), written as the distinct_count
+     * of the chunk statistics. The count is exact for chunks that are entirely
+     * dictionary-encoded. Requires statistics to be enabled for the column.
+     */
+    Builder* enable_distinct_count() {
+      default_column_properties_.distinct_count_enabled = true;
+      return this;
+    }
+
+    Builder* disable_distinct_count() {
+      default_column_properties_.distinct_count_enabled = false;
+      return this;
+    }
+
+    Builder* enable_distinct_count(const std::string& path) {
+      distinct_count_enabled_[path] = true;
+      return this;
+    }
+
+    Builder* enable_distinct_count(const std::shared_ptr<schema::ColumnPath>& path) {
+      return this->enable_distinct_count(path->ToDotString());
+    }
+
+    Builder* disable_distinct_count(const std::string& path) {
+      distinct_count_enabled_[path] = false;
+      return this;
+    }
+
+    Builder* disable_distinct_count(const std::shared_ptr<schema::ColumnPath>& path) {
+      return this->disable_distinct_count(path->ToDotString());
+    }
+
+    /**
+     * Number of index bits of the distinct count sketches: they have
+     * 2^precision registers, in [HyperLogLog::kMinPrecision,
+     * HyperLogLog::kMaxPrecision].
+     */
+    Builder* distinct_count_precision(int precision) {
+      distinct_count_precision_ = precision;
+      return this;
+    }
+
+    /**
+     * Also store the serialized distinct count sketch of each chunk in its
+     * key-value metadata, under HyperLogLog::kColumnChunkKey, so that the
+     * sketches of several chunks or files can be merged. Each takes
+     * 2^precision bytes in the footer.
+     */
+    Builder* write_distinct_count_sketches(bool write) {
+      write_distinct_count_sketches_ = write;
+      return this;
+    }
+
+    /**
+     * Bound the memory held by the column writers, see WriterMemoryBudget.
+     * Writers built from the same properties share the budget.
+     */
+    Builder* memory_budget(const std::shared_ptr<WriterMemoryBudget>& budget) {
+      memory_budget_ = budget;
+      return this;
+    }
+
+    /**
+     * Same as memory_budget with a new budget of limit bytes. 0 disables the
+     * budget.
+     */
+    Builder* memory_limit(int64_t limit) {
+      memory_budget_ = limit > 0 ? std::make_shared<WriterMemoryBudget>(limit) : nullptr;
+      return this;
+    }
+
+    /**
+     * Collect performance counters of the column writers, see WriterStats.
+     * Writers built from the same properties update the same counters.
+     */
+    Builder* writer_stats(const std::shared_ptr<WriterStats>& stats) {
+      writer_stats_ = stats;
+      return this;
+    }
+
+    /**
+     * Combine the writes to the sink that are smaller than size bytes, such as
+     * page headers, small pages and the footer, into writes of about size
+     * bytes. The buffer is flushed at the end of each row group. Useful for
+     * sinks where each write is costly, e.g. on network file systems.
+     */
+    Builder* output_buffer_size(int64_t size) {
+      output_buffer_size_ = size;
+      return this;
+    }
+
+    /**
+     * Declare that the rows of every row group are sorted by these columns,
+     * the first one taking precedence. Recorded as the sorting_columns of the
+     * row group metadata, and used by the reader to binary search the pages
+     * of sorted column chunks (see FindSortedPages). The writer does not check
+     * the order.
+     */
+    Builder* sorting_columns(const std::vector<SortingColumn>& columns) {
+      sorting_columns_ = columns;
+      return this;
+    }
+
     std::shared_ptr<WriterProperties> build() {
       std::unordered_map<std::string, ColumnProperties> column_properties;
       auto get = [&](const std::string& key) -> ColumnProperties& {
@@ -282,48 +944,145 @@ class PARQUET_EXPORT WriterProperties {
 
       for (const auto& item : encodings_) get(item.first).encoding = item.second;
       for (const auto& item : codecs_) get(item.first).codec = item.second;
+      for (const auto& item : compression_levels_)
+        get(item.first).compression_level = item.second;
       for (const auto& item : dictionary_enabled_)
         get(item.first).dictionary_enabled = item.second;
       for (const auto& item : statistics_enabled_)
         get(item.first).statistics_enabled = item.second;
+      for (const auto& item : bloom_filter_enabled_)
+        get(item.first).bloom_filter_enabled = item.second;
+      for (const auto& item : bloom_filter_options_)
+        get(item.first).bloom_filter_options = item.second;
+      for (const auto& item : distinct_count_enabled_)
+        get(item.first).distinct_count_enabled = item.second;
+
+      CheckCompressionLevel(default_column_properties_);
+      for (const auto& item : column_properties) CheckCompressionLevel(item.second);
 
       return std::shared_ptr<WriterProperties>(
-          new WriterProperties(pool_, dictionary_pagesize_limit_, write_batch_size_,
+          new WriterProperties(pool_, dictionary_pagesize_limit_,
+                               dictionary_benefit_check_values_, write_batch_size_,
                                max_row_group_length_, pagesize_, version_, created_by_,
+                               page_index_enabled_, data_page_version_,
+                               async_compression_enabled_, async_compression_queue_size_,
+                               buffered_row_group_memory_limit_,
+                               data_page_values_limit_, max_row_group_bytes_,
+                               min_row_group_length_, statistics_truncate_length_,
+                               distinct_count_precision_,
+                               write_distinct_count_sketches_, memory_budget_,
+                               writer_stats_, output_buffer_size_, sorting_columns_,
                                default_column_properties_, column_properties));
     }
 
    private:
     ::arrow::MemoryPool* pool_;
     int64_t dictionary_pagesize_limit_;
+    int64_t dictionary_benefit_check_values_;
     int64_t write_batch_size_;
     int64_t max_row_group_length_;
     int64_t pagesize_;
     ParquetVersion::type version_;
     std::string created_by_;
+    bool page_index_enabled_;
+    ParquetDataPageVersion::type data_page_version_;
+    bool async_compression_enabled_;
+    int async_compression_queue_size_;
+    int64_t buffered_row_group_memory_limit_;
+    int64_t data_page_values_limit_;
+    int64_t max_row_group_bytes_;
+    int64_t min_row_group_length_;
+    int64_t statistics_truncate_length_;
+    int distinct_count_precision_;
+    bool write_distinct_count_sketches_;
+    std::shared_ptr<WriterMemoryBudget> memory_budget_;
+    std::shared_ptr<WriterStats> writer_stats_;
+    int64_t output_buffer_size_;
+    std::vector<SortingColumn> sorting_columns_;
 
     // Settings used for each column unless overridden in any of the maps below
     ColumnProperties default_column_properties_;
     std::unordered_map<std::string, Encoding::type> encodings_;
     std::unordered_map<std::string, Compression::type> codecs_;
+    std::unordered_map<std::string, int> compression_levels_;
+
+    static void CheckCompressionLevel(const ColumnProperties& properties) {
+      if (properties.codec != Compression::UNCOMPRESSED &&
+          properties.compression_level != DEFAULT_COMPRESSION_LEVEL) {
+        ParquetException::NYI("Compression levels other than the codec default");
+      }
+    }
     std::unordered_map<std::string, bool> dictionary_enabled_;
     std::unordered_map<std::string, bool> statistics_enabled_;
+    std::unordered_map<std::string, bool> bloom_filter_enabled_;
+    std::unordered_map<std::string, BloomFilterOptions> bloom_filter_options_;
+    std::unordered_map<std::string, bool> distinct_count_enabled_;
   };
 
   inline ::arrow::MemoryPool* memory_pool() const { return pool_; }
 
   inline int64_t dictionary_pagesize_limit() const { return dictionary_pagesize_limit_; }
 
+  inline int64_t dictionary_benefit_check_values() const {
+    return dictionary_benefit_check_values_;
+  }
+
   inline int64_t write_batch_size() const { return write_batch_size_; }
 
   inline int64_t max_row_group_length() const { return max_row_group_length_; }
 
+  inline int64_t max_row_group_bytes() const { return max_row_group_bytes_; }
+
+  inline int64_t min_row_group_length() const { return min_row_group_length_; }
+
+  inline int64_t statistics_truncate_length() const {
+    return statistics_truncate_length_;
+  }
+
+  inline int distinct_count_precision() const { return distinct_count_precision_; }
+
+  inline bool write_distinct_count_sketches() const {
+    return write_distinct_count_sketches_;
+  }
+
+  // nullptr if the memory of the writers is not bounded
+  inline WriterMemoryBudget* memory_budget() const { return memory_budget_.get(); }
+
+  // nullptr if the performance counters are not collected
+  inline const std::shared_ptr<WriterStats>& writer_stats() const {
+    return writer_stats_;
+  }
+
+  inline int64_t output_buffer_size() const { return output_buffer_size_; }
+
+  inline const std::vector<SortingColumn>& sorting_columns() const {
+    return sorting_columns_;
+  }
+
   inline int64_t data_pagesize() const { return pagesize_; }
 
+  inline int64_t data_page_values_limit() const { return data_page_values_limit_; }
+
   inline ParquetVersion::type version() const { return parquet_version_; }
 
   inline std::string created_by() const { return parquet_created_by_; }
 
+  inline bool page_index_enabled() const { return page_index_enabled_; }
+
+  inline ParquetDataPageVersion::type data_page_version() const {
+    return data_page_version_;
+  }
+
+  inline bool async_compression_enabled() const { return async_compression_enabled_; }
+
+  inline int async_compression_queue_size() const {
+    return async_compression_queue_size_;
+  }
+
+  inline int64_t buffered_row_group_memory_limit() const {
+    return buffered_row_group_memory_limit_;
+  }
+
   inline Encoding::type dictionary_index_encoding() const {
     if (parquet_version_ == ParquetVersion::PARQUET_1_0) {
       return Encoding::PLAIN_DICTIONARY;
@@ -355,6 +1114,10 @@ class PARQUET_EXPORT WriterProperties {
     return column_properties(path).codec;
   }
 
+  int compression_level(const std::shared_ptr<schema::ColumnPath>& path) const {
+    return column_properties(path).compression_level;
+  }
+
   bool dictionary_enabled(const std::shared_ptr<schema::ColumnPath>& path) const {
     return column_properties(path).dictionary_enabled;
   }
@@ -363,30 +1126,85 @@ class PARQUET_EXPORT WriterProperties {
     return column_properties(path).statistics_enabled;
   }
 
+  bool bloom_filter_enabled(const std::shared_ptr<schema::ColumnPath>& path) const {
+    return column_properties(path).bloom_filter_enabled;
+  }
+
+  const BloomFilterOptions& bloom_filter_options(
+      const std::shared_ptr<schema::ColumnPath>& path) const {
+    return column_properties(path).bloom_filter_options;
+  }
+
+  bool distinct_count_enabled(const std::shared_ptr<schema::ColumnPath>& path) const {
+    return column_properties(path).distinct_count_enabled;
+  }
+
  private:
   explicit WriterProperties(
       ::arrow::MemoryPool* pool, int64_t dictionary_pagesize_limit,
-      int64_t write_batch_size, int64_t max_row_group_length, int64_t pagesize,
+      int64_t dictionary_benefit_check_values, int64_t write_batch_size,
+      int64_t max_row_group_length, int64_t pagesize,
       ParquetVersion::type version, const std::string& created_by,
+      bool page_index_enabled, ParquetDataPageVersion::type data_page_version,
+      bool async_compression_enabled, int async_compression_queue_size,
+      int64_t buffered_row_group_memory_limit, int64_t data_page_values_limit,
+      int64_t max_row_group_bytes, int64_t min_row_group_length,
+      int64_t statistics_truncate_length,
+      int distinct_count_precision, bool write_distinct_count_sketches,
+      const std::shared_ptr<WriterMemoryBudget>& memory_budget,
+      const std::shared_ptr<WriterStats>& writer_stats, int64_t output_buffer_size,
+      const std::vector<SortingColumn>& sorting_columns,
       const ColumnProperties& default_column_properties,
       const std::unordered_map<std::string, ColumnProperties>& column_properties)
       : pool_(pool),
         dictionary_pagesize_limit_(dictionary_pagesize_limit),
+        dictionary_benefit_check_values_(dictionary_benefit_check_values),
         write_batch_size_(write_batch_size),
         max_row_group_length_(max_row_group_length),
         pagesize_(pagesize),
         parquet_version_(version),
         parquet_created_by_(created_by),
+        page_index_enabled_(page_index_enabled),
+        data_page_version_(data_page_version),
+        async_compression_enabled_(async_compression_enabled),
+        async_compression_queue_size_(async_compression_queue_size),
+        buffered_row_group_memory_limit_(buffered_row_group_memory_limit),
+        data_page_values_limit_(data_page_values_limit),
+        max_row_group_bytes_(max_row_group_bytes),
+        min_row_group_length_(min_row_group_length),
+        statistics_truncate_length_(statistics_truncate_length),
+        distinct_count_precision_(distinct_count_precision),
+        write_distinct_count_sketches_(write_distinct_count_sketches),
+        memory_budget_(memory_budget),
+        writer_stats_(writer_stats),
+        output_buffer_size_(output_buffer_size),
+        sorting_columns_(sorting_columns),
         default_column_properties_(default_column_properties),
         column_properties_(column_properties) {}
 
   ::arrow::MemoryPool* pool_;
   int64_t dictionary_pagesize_limit_;
+  int64_t dictionary_benefit_check_values_;
   int64_t write_batch_size_;
   int64_t max_row_group_length_;
   int64_t pagesize_;
   ParquetVersion::type parquet_version_;
   std::string parquet_created_by_;
+  bool page_index_enabled_;
+  ParquetDataPageVersion::type data_page_version_;
+  bool async_compression_enabled_;
+  int async_compression_queue_size_;
+  int64_t buffered_row_group_memory_limit_;
+  int64_t data_page_values_limit_;
+  int64_t max_row_group_bytes_;
+  int64_t min_row_group_length_;
+  int64_t statistics_truncate_length_;
+  int distinct_count_precision_;
+  bool write_distinct_count_sketches_;
+  std::shared_ptr<WriterMemoryBudget> memory_budget_;
+  std::shared_ptr<WriterStats> writer_stats_;
+  int64_t output_buffer_size_;
+  std::vector<SortingColumn> sorting_columns_;
   ColumnProperties default_column_properties_;
   std::unordered_map<std::string, ColumnProperties> column_properties_;
 };
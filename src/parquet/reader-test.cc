@@ -20,16 +20,21 @@
 #include <cstdint>
 #include <cstdlib>
 #include <iostream>
+#include <limits>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "arrow/io/file.h"
+#include "arrow/io/memory.h"
 
 #include "parquet/column_reader.h"
 #include "parquet/column_scanner.h"
 #include "parquet/file/printer.h"
 #include "parquet/file/reader-internal.h"
 #include "parquet/file/reader.h"
+#include "parquet/file/writer.h"
+#include "parquet/schema.h"
 #include "parquet/util/memory.h"
 
 using std::string;
@@ -155,6 +160,91 @@ TEST_F(TestAllTypesPlain, ColumnSelection) {
   ASSERT_GT(result.size(), 0);
 }
 
+TEST_F(TestAllTypesPlain, DebugPrintRowLimit) {
+  std::list<int> columns;
+  columns.push_back(0);
+  ParquetFilePrinter printer(reader_.get());
+
+  std::stringstream all_rows;
+  printer.DebugPrint(all_rows, columns);
+  std::stringstream no_rows;
+  printer.DebugPrint(no_rows, columns, true, "No Name", 0);
+  std::stringstream two_rows;
+  printer.DebugPrint(two_rows, columns, true, "No Name", 2);
+
+  ASSERT_EQ(std::string::npos, no_rows.str().find("\n4 "));
+  ASSERT_NE(std::string::npos, two_rows.str().find("\n4 "));
+  ASSERT_NE(std::string::npos, two_rows.str().find("\n5 "));
+  ASSERT_EQ(std::string::npos, two_rows.str().find("\n6 "));
+  ASSERT_NE(std::string::npos, all_rows.str().find("\n1 "));
+}
+
+TEST_F(TestAllTypesPlain, PrintValuesCsv) {
+  std::stringstream ss;
+
+  std::list<int> columns;
+  columns.push_back(0);
+  columns.push_back(1);
+  ParquetFilePrinter printer(reader_.get());
+  printer.PrintValues(ss, columns, 3, PrintFormat::CSV);
+
+  ASSERT_EQ("id,bool_col\n4,true\n5,false\n6,true\n", ss.str());
+}
+
+TEST_F(TestAllTypesPlain, PrintValuesJson) {
+  std::stringstream ss;
+
+  std::list<int> columns;
+  columns.push_back(0);
+  columns.push_back(9);
+  ParquetFilePrinter printer(reader_.get());
+  printer.PrintValues(ss, columns, 2, PrintFormat::JSON);
+
+  ASSERT_EQ(
+      "{\"id\": 4, \"string_col\": \"0\"}\n"
+      "{\"id\": 5, \"string_col\": \"1\"}\n",
+      ss.str());
+}
+
+TEST(TestPrintValues, JsonQuotesNonFiniteFloats) {
+  auto schema = std::static_pointer_cast<schema::GroupNode>(schema::GroupNode::Make(
+      "schema", Repetition::REQUIRED,
+      {schema::PrimitiveNode::Make("d", Repetition::REQUIRED, Type::DOUBLE)}));
+  std::vector<double> values = {1.5, std::numeric_limits<double>::quiet_NaN(),
+                                std::numeric_limits<double>::infinity(),
+                                -std::numeric_limits<double>::infinity()};
+  std::shared_ptr<InMemoryOutputStream> sink(new InMemoryOutputStream());
+  auto file_writer = ParquetFileWriter::Open(sink, schema);
+  auto writer =
+      static_cast<DoubleWriter*>(file_writer->AppendRowGroup(4)->NextColumn());
+  writer->WriteBatch(4, nullptr, nullptr, values.data());
+  file_writer->Close();
+
+  std::unique_ptr<ParquetFileReader> reader = ParquetFileReader::Open(
+      std::make_shared<::arrow::io::BufferReader>(sink->GetBuffer()));
+  std::stringstream ss;
+  ParquetFilePrinter printer(reader.get());
+  printer.PrintValues(ss, {0}, 4, PrintFormat::JSON);
+
+  ASSERT_EQ(
+      "{\"d\": 1.5}\n"
+      "{\"d\": \"NaN\"}\n"
+      "{\"d\": \"Infinity\"}\n"
+      "{\"d\": \"-Infinity\"}\n",
+      ss.str());
+}
+
+TEST_F(TestAllTypesPlain, PrintValuesAllRows) {
+  std::stringstream ss;
+
+  std::list<int> columns;
+  columns.push_back(0);
+  ParquetFilePrinter printer(reader_.get());
+  printer.PrintValues(ss, columns);
+
+  ASSERT_EQ("id\n4\n5\n6\n7\n2\n3\n0\n1\n", ss.str());
+}
+
 TEST_F(TestAllTypesPlain, ColumnSelectionOutOfRange) {
   std::stringstream ss;
 
@@ -234,6 +324,50 @@ TEST_F(TestLocalFile, OpenWithMetadata) {
   ASSERT_EQ(metadata.get(), reader2->metadata().get());
 }
 
+TEST(TestFileMetaDataCache, GetOrRead) {
+  FileMetaDataCache cache;
+  auto metadata = cache.GetOrRead(alltypes_plain());
+  ASSERT_EQ(1, cache.num_entries());
+  ASSERT_EQ(metadata->size(), cache.size());
+
+  // Served from the cache
+  ASSERT_EQ(metadata.get(), cache.GetOrRead(alltypes_plain()).get());
+  auto reader = ParquetFileReader::OpenFile(alltypes_plain(), false,
+                                            default_reader_properties(), metadata);
+  ASSERT_EQ(metadata.get(), reader->metadata().get());
+
+  // A changed file size or modification time invalidates the entry
+  ASSERT_EQ(nullptr, cache.Get(alltypes_plain(), 0, 0));
+
+  cache.Clear();
+  ASSERT_EQ(0, cache.num_entries());
+  ASSERT_EQ(0, cache.size());
+  ASSERT_THROW(cache.GetOrRead("/nonexistent/file.parquet"), ParquetException);
+}
+
+TEST(TestFileMetaDataCache, Eviction) {
+  auto metadata = ParquetFileReader::OpenFile(alltypes_plain())->metadata();
+
+  // Room for two entries
+  FileMetaDataCache cache(2 * metadata->size());
+  cache.Put("a", 1, 1, metadata);
+  cache.Put("b", 1, 1, metadata);
+  // Touch "a" so that "b" is the least recently used
+  ASSERT_NE(nullptr, cache.Get("a", 1, 1));
+  cache.Put("c", 1, 1, metadata);
+
+  ASSERT_EQ(2, cache.num_entries());
+  ASSERT_NE(nullptr, cache.Get("a", 1, 1));
+  ASSERT_EQ(nullptr, cache.Get("b", 1, 1));
+  ASSERT_NE(nullptr, cache.Get("c", 1, 1));
+
+  // Replacing an entry does not grow the cache
+  cache.Put("c", 2, 2, metadata);
+  ASSERT_EQ(2, cache.num_entries());
+  ASSERT_EQ(nullptr, cache.Get("c", 1, 1));
+  ASSERT_NE(nullptr, cache.Get("c", 2, 2));
+}
+
 TEST(TestFileReaderAdHoc, NationDictTruncatedDataPage) {
   // PARQUET-816. Some files generated by older Parquet implementations may
   // contain malformed data page metadata, and we can successfully decode them
@@ -692,6 +692,13 @@ TEST_F(TestSchemaDescriptor, BuildTree) {
   ASSERT_EQ(bag.get(), descr_.GetColumnRoot(4).get());
   ASSERT_EQ(bag.get(), descr_.GetColumnRoot(5).get());
 
+  ASSERT_EQ(4, descr_.ColumnIndex("bag.records.item2"));
+  ASSERT_GT(0, descr_.ColumnIndex("bag.records"));
+  ASSERT_EQ(3, descr_.FieldIndex("bag"));
+  ASSERT_GT(0, descr_.FieldIndex("item1"));
+  ASSERT_EQ(std::vector<int>({0}), descr_.FieldColumnIndices(0));
+  ASSERT_EQ(std::vector<int>({3, 4, 5}), descr_.FieldColumnIndices(3));
+
   ASSERT_EQ(schema.get(), descr_.group_node());
 
   // Init clears the leaves
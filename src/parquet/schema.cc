@@ -608,9 +608,17 @@ void SchemaDescriptor::Init(const NodePtr& schema) {
 
   group_node_ = static_cast<const GroupNode*>(schema_.get());
   leaves_.clear();
+  leaf_to_base_.clear();
+  leaf_to_idx_.clear();
+  node_to_idx_.clear();
+  field_to_leaves_.assign(group_node_->field_count(), std::vector<int>());
 
   for (int i = 0; i < group_node_->field_count(); ++i) {
+    int first_leaf = num_columns();
     BuildTree(group_node_->field(i), 0, 0, group_node_->field(i));
+    for (int leaf = first_leaf; leaf < num_columns(); ++leaf) {
+      field_to_leaves_[i].push_back(leaf);
+    }
   }
 }
 
@@ -651,6 +659,7 @@ void SchemaDescriptor::BuildTree(const NodePtr& node, int16_t max_def_level,
     leaf_to_base_.emplace(static_cast<int>(leaves_.size()) - 1, base);
     leaf_to_idx_.emplace(node->path()->ToDotString(),
                          static_cast<int>(leaves_.size()) - 1);
+    node_to_idx_.emplace(node.get(), static_cast<int>(leaves_.size()) - 1);
   }
 }
 
@@ -689,6 +698,10 @@ int SchemaDescriptor::ColumnIndex(const std::string& node_path) const {
 }
 
 int SchemaDescriptor::ColumnIndex(const Node& node) const {
+  auto search = node_to_idx_.find(&node);
+  if (search != node_to_idx_.end()) {
+    return search->second;
+  }
   int result = ColumnIndex(node.path()->ToDotString());
   if (result < 0) {
     return -1;
@@ -701,6 +714,11 @@ int SchemaDescriptor::ColumnIndex(const Node& node) const {
   return result;
 }
 
+const std::vector<int>& SchemaDescriptor::FieldColumnIndices(int i) const {
+  DCHECK(i >= 0 && i < static_cast<int>(field_to_leaves_.size()));
+  return field_to_leaves_[i];
+}
+
 const schema::NodePtr& SchemaDescriptor::GetColumnRoot(int i) const {
   DCHECK(i >= 0 && i < static_cast<int>(leaves_.size()));
   return leaf_to_base_.find(i)->second;
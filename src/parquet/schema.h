@@ -384,6 +384,13 @@ class PARQUET_EXPORT SchemaDescriptor {
   // Get the index of a column by its node, or negative value if not found
   int ColumnIndex(const schema::Node& node) const;
 
+  // Get the index of a field of the schema root by its name, or negative value
+  // if not found
+  int FieldIndex(const std::string& name) const { return group_node_->FieldIndex(name); }
+
+  // The indices of the columns below the i-th field of the schema root
+  const std::vector<int>& FieldColumnIndices(int i) const;
+
   bool Equals(const SchemaDescriptor& other) const;
 
   // The number of physical columns appearing in the file
@@ -423,6 +430,13 @@ class PARQUET_EXPORT SchemaDescriptor {
 
   // Mapping between ColumnPath DotString to the leaf index
   std::unordered_map<std::string, int> leaf_to_idx_;
+
+  // Mapping between the leaf nodes of this schema and their index, to look up
+  // these nodes without building their path
+  std::unordered_map<const schema::Node*, int> node_to_idx_;
+
+  // The leaf indices below each field of the schema root
+  std::vector<std::vector<int>> field_to_leaves_;
 };
 
 }  // namespace parquet
@@ -21,6 +21,7 @@
 #include <array>
 #include <cstdint>
 #include <cstring>
+#include <limits>
 #include <memory>
 #include <vector>
 
@@ -300,7 +301,45 @@ TYPED_TEST(TestRowGroupStatistics, FullRoundtrip) {
 }
 
 template <typename TestType>
-class TestNumericRowGroupStatistics : public TestRowGroupStatistics<TestType> {};
+class TestNumericRowGroupStatistics : public TestRowGroupStatistics<TestType> {
+ public:
+  using T = typename TestType::c_type;
+  using TypedStats = TypedRowGroupStatistics<TestType>;
+
+  // Compare UpdateSpaced on slices of various offsets and lengths, with runs
+  // of valid and null values, against a value-by-value computation
+  void TestUpdateSpaced() {
+    const int num_values = 1000;
+    this->GenerateData(num_values);
+    std::vector<uint8_t> valid_bits(BitUtil::RoundUpNumBytes(num_values), 0);
+    for (int i = 0; i < num_values; i++) {
+      if ((i / 37) % 3 == 0 || i % 5 != 0) BitUtil::SetBit(valid_bits.data(), i);
+    }
+
+    for (int offset : {0, 1, 3, 8, 13}) {
+      for (int length : {1, 3, 7, 9, 33, 130, num_values - 13}) {
+        int64_t num_not_null = 0;
+        T min = T(), max = T();
+        for (int i = offset; i < offset + length; i++) {
+          if (!BitUtil::GetBit(valid_bits.data(), i)) continue;
+          const T& value = this->values_[i];
+          min = num_not_null == 0 ? value : std::min(min, value);
+          max = num_not_null == 0 ? value : std::max(max, value);
+          num_not_null++;
+        }
+
+        TypedStats statistics(this->schema_.Column(0));
+        statistics.UpdateSpaced(this->values_ptr_ + offset, valid_bits.data(), offset,
+                                num_not_null, length - num_not_null);
+        ASSERT_EQ(num_not_null > 0, statistics.HasMinMax());
+        if (num_not_null > 0) {
+          ASSERT_EQ(min, statistics.min());
+          ASSERT_EQ(max, statistics.max());
+        }
+      }
+    }
+  }
+};
 
 using NumericTypes = ::testing::Types<Int32Type, Int64Type, FloatType, DoubleType>;
 
@@ -311,6 +350,111 @@ TYPED_TEST(TestNumericRowGroupStatistics, Merge) {
   this->TestMerge();
 }
 
+TYPED_TEST(TestNumericRowGroupStatistics, UpdateSpaced) {
+  this->SetUpSchema(Repetition::OPTIONAL);
+  this->TestUpdateSpaced();
+}
+
+template <typename TestType>
+class TestFloatingPointStatistics : public ::testing::Test {
+ public:
+  using T = typename TestType::c_type;
+
+  void SetUp() override {
+    node_ = PrimitiveNode::Make("column", Repetition::OPTIONAL, TestType::type_num);
+    descr_.reset(new ColumnDescriptor(node_, 1, 0));
+  }
+
+ protected:
+  NodePtr node_;
+  std::unique_ptr<ColumnDescriptor> descr_;
+};
+
+using FloatingPointTypes = ::testing::Types<FloatType, DoubleType>;
+
+TYPED_TEST_CASE(TestFloatingPointStatistics, FloatingPointTypes);
+
+TYPED_TEST(TestFloatingPointStatistics, NaNsIgnored) {
+  using T = typename TypeParam::c_type;
+  const T nan = std::numeric_limits<T>::quiet_NaN();
+  // Long enough for the vectorized loops, with NaNs in and after them
+  std::vector<T> values(21, nan);
+  values[2] = 3;
+  values[5] = -1;
+  values[11] = 7;
+  values[19] = -4;
+
+  TypedRowGroupStatistics<TypeParam> statistics(this->descr_.get());
+  statistics.Update(values.data(), values.size(), 0);
+  ASSERT_TRUE(statistics.HasMinMax());
+  ASSERT_EQ(-4, statistics.min());
+  ASSERT_EQ(7, statistics.max());
+
+  std::vector<uint8_t> valid_bits(BitUtil::RoundUpNumBytes(21), 255);
+  BitUtil::ClearBit(valid_bits.data(), 19);
+  TypedRowGroupStatistics<TypeParam> spaced(this->descr_.get());
+  spaced.UpdateSpaced(values.data(), valid_bits.data(), 0, 20, 1);
+  ASSERT_TRUE(spaced.HasMinMax());
+  ASSERT_EQ(-1, spaced.min());
+  ASSERT_EQ(7, spaced.max());
+}
+
+TYPED_TEST(TestFloatingPointStatistics, AllNaNs) {
+  using T = typename TypeParam::c_type;
+  std::vector<T> values(10, std::numeric_limits<T>::quiet_NaN());
+
+  TypedRowGroupStatistics<TypeParam> statistics(this->descr_.get());
+  statistics.Update(values.data(), values.size(), 0);
+  ASSERT_FALSE(statistics.HasMinMax());
+  ASSERT_EQ(10, statistics.num_values());
+  ASSERT_EQ("", statistics.EncodeMin());
+
+  // Later values still set the min and max
+  values[4] = 2;
+  statistics.Update(values.data(), values.size(), 0);
+  ASSERT_TRUE(statistics.HasMinMax());
+  ASSERT_EQ(2, statistics.min());
+  ASSERT_EQ(2, statistics.max());
+}
+
+TEST(TestByteArrayStatistics, TruncatedMinMax) {
+  NodePtr node = PrimitiveNode::Make("column", Repetition::REQUIRED, Type::BYTE_ARRAY);
+  ColumnDescriptor descr(node, 0, 0);
+  auto make_value = [](const std::string& s) {
+    return ByteArray(static_cast<uint32_t>(s.size()),
+                     reinterpret_cast<const uint8_t*>(s.data()));
+  };
+
+  std::vector<std::string> strings = {"abcdefgh", "ab", "b\x7f\x7f\x7f\x7f"};
+  std::vector<ByteArray> values;
+  for (const auto& s : strings) values.push_back(make_value(s));
+
+  TypedRowGroupStatistics<ByteArrayType> statistics(&descr);
+  statistics.Update(values.data(), values.size(), 0);
+  ASSERT_EQ("ab", statistics.EncodeMin());
+  ASSERT_EQ(strings[2], statistics.EncodeMax());
+
+  // The trailing 0x7f bytes are dropped and 'b' is rounded up
+  statistics.set_truncate_length(3);
+  ASSERT_EQ("ab", statistics.EncodeMin());
+  ASSERT_EQ("c", statistics.EncodeMax());
+
+  TypedRowGroupStatistics<ByteArrayType> long_min(&descr);
+  long_min.set_truncate_length(3);
+  long_min.Update(values.data(), 1, 0);
+  ASSERT_EQ("abc", long_min.EncodeMin());
+  ASSERT_EQ("abd", long_min.EncodeMax());
+
+  // A max that cannot be rounded up is kept in full
+  std::string highest(5, '\x7f');
+  ByteArray highest_value = make_value(highest);
+  TypedRowGroupStatistics<ByteArrayType> full_max(&descr);
+  full_max.set_truncate_length(3);
+  full_max.Update(&highest_value, 1, 0);
+  ASSERT_EQ(std::string(3, '\x7f'), full_max.EncodeMin());
+  ASSERT_EQ(highest, full_max.EncodeMax());
+}
+
 TEST(CorruptStatistics, Basics) {
   ApplicationVersion version("parquet-mr version 1.8.0");
   SchemaDescriptor schema;
@@ -17,10 +17,16 @@
 
 #include <algorithm>
 #include <cstring>
+#include <limits>
+
+#if defined(PARQUET_USE_SSE) && defined(__AVX2__)
+#include <immintrin.h>
+#endif
 
 #include "parquet/encoding-internal.h"
 #include "parquet/exception.h"
 #include "parquet/statistics.h"
+#include "parquet/util/bitmap.h"
 #include "parquet/util/comparison.h"
 #include "parquet/util/memory.h"
 
@@ -29,6 +35,157 @@ using arrow::MemoryPool;
 
 namespace parquet {
 
+namespace {
+
+// Fold the values into min and max. For floating point values, std::min and
+// std::max keep their first argument when the second is NaN, so NaNs are
+// skipped as long as min and max are not NaN themselves.
+template <typename T>
+inline void ScalarMinMax(const T* values, int64_t length, T* min, T* max) {
+  for (int64_t i = 0; i < length; ++i) {
+    *min = std::min(*min, values[i]);
+    *max = std::max(*max, values[i]);
+  }
+}
+
+// Fold a prefix of the values into min and max with vector instructions and
+// return its length. The remaining values are left to ScalarMinMax.
+template <typename T>
+inline int64_t VectorMinMax(const T*, int64_t, T*, T*) {
+  return 0;
+}
+
+#if defined(PARQUET_USE_SSE) && defined(__AVX2__)
+
+// The lanes of the accumulators are folded once at the end of the batch
+template <typename T, typename V>
+inline void FoldLanes(V vmin, V vmax, T* min, T* max) {
+  constexpr int kLanes = static_cast<int>(sizeof(V) / sizeof(T));
+  T min_lanes[kLanes], max_lanes[kLanes];
+  std::memcpy(min_lanes, &vmin, sizeof(V));
+  std::memcpy(max_lanes, &vmax, sizeof(V));
+  for (int i = 0; i < kLanes; ++i) {
+    *min = std::min(*min, min_lanes[i]);
+    *max = std::max(*max, max_lanes[i]);
+  }
+}
+
+template <>
+inline int64_t VectorMinMax(const int32_t* values, int64_t length, int32_t* min,
+                            int32_t* max) {
+  __m256i vmin = _mm256_set1_epi32(*min);
+  __m256i vmax = _mm256_set1_epi32(*max);
+  int64_t i = 0;
+  for (; i + 8 <= length; i += 8) {
+    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+    vmin = _mm256_min_epi32(vmin, v);
+    vmax = _mm256_max_epi32(vmax, v);
+  }
+  FoldLanes(vmin, vmax, min, max);
+  return i;
+}
+
+template <>
+inline int64_t VectorMinMax(const int64_t* values, int64_t length, int64_t* min,
+                            int64_t* max) {
+  // AVX2 has no 64-bit integer min/max, so select with comparison masks
+  __m256i vmin = _mm256_set1_epi64x(*min);
+  __m256i vmax = _mm256_set1_epi64x(*max);
+  int64_t i = 0;
+  for (; i + 4 <= length; i += 4) {
+    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+    vmin = _mm256_blendv_epi8(vmin, v, _mm256_cmpgt_epi64(vmin, v));
+    vmax = _mm256_blendv_epi8(vmax, v, _mm256_cmpgt_epi64(v, vmax));
+  }
+  FoldLanes(vmin, vmax, min, max);
+  return i;
+}
+
+// _mm256_min_ps / _mm256_max_ps return their second operand when either one is
+// NaN, which skips NaN values as the accumulators are passed second.
+
+template <>
+inline int64_t VectorMinMax(const float* values, int64_t length, float* min,
+                            float* max) {
+  __m256 vmin = _mm256_set1_ps(*min);
+  __m256 vmax = _mm256_set1_ps(*max);
+  int64_t i = 0;
+  for (; i + 8 <= length; i += 8) {
+    const __m256 v = _mm256_loadu_ps(values + i);
+    vmin = _mm256_min_ps(v, vmin);
+    vmax = _mm256_max_ps(v, vmax);
+  }
+  FoldLanes(vmin, vmax, min, max);
+  return i;
+}
+
+template <>
+inline int64_t VectorMinMax(const double* values, int64_t length, double* min,
+                            double* max) {
+  __m256d vmin = _mm256_set1_pd(*min);
+  __m256d vmax = _mm256_set1_pd(*max);
+  int64_t i = 0;
+  for (; i + 4 <= length; i += 4) {
+    const __m256d v = _mm256_loadu_pd(values + i);
+    vmin = _mm256_min_pd(v, vmin);
+    vmax = _mm256_max_pd(v, vmax);
+  }
+  FoldLanes(vmin, vmax, min, max);
+  return i;
+}
+
+#endif
+
+// Min and max of integer and floating point values, ignoring NaNs. Returns
+// false if there are no such values.
+template <typename T>
+inline bool ArithmeticMinMax(const T* values, int64_t length, T* out_min, T* out_max) {
+  using limits = std::numeric_limits<T>;
+  T min = limits::has_infinity ? limits::infinity() : limits::max();
+  T max = limits::has_infinity ? -limits::infinity() : limits::lowest();
+  const int64_t vectorized = VectorMinMax(values, length, &min, &max);
+  ScalarMinMax(values + vectorized, length - vectorized, &min, &max);
+  // Only false when the values were all NaN (or there were none)
+  if (!(min <= max)) return false;
+  *out_min = min;
+  *out_max = max;
+  return true;
+}
+
+// Min and max of a batch of values under the column's sort order. Returns
+// false if the batch has no values that can be ordered.
+template <typename T>
+inline bool BatchMinMax(const T* values, int64_t length, Compare<T>& compare, T* min,
+                        T* max) {
+  if (length == 0) return false;
+  auto batch_minmax = std::minmax_element(values, values + length, compare);
+  *min = *batch_minmax.first;
+  *max = *batch_minmax.second;
+  return true;
+}
+
+inline bool BatchMinMax(const int32_t* values, int64_t length, Compare<int32_t>&,
+                        int32_t* min, int32_t* max) {
+  return ArithmeticMinMax(values, length, min, max);
+}
+
+inline bool BatchMinMax(const int64_t* values, int64_t length, Compare<int64_t>&,
+                        int64_t* min, int64_t* max) {
+  return ArithmeticMinMax(values, length, min, max);
+}
+
+inline bool BatchMinMax(const float* values, int64_t length, Compare<float>&,
+                        float* min, float* max) {
+  return ArithmeticMinMax(values, length, min, max);
+}
+
+inline bool BatchMinMax(const double* values, int64_t length, Compare<double>&,
+                        double* min, double* max) {
+  return ArithmeticMinMax(values, length, min, max);
+}
+
+}  // namespace
+
 template <typename DType>
 TypedRowGroupStatistics<DType>::TypedRowGroupStatistics(const ColumnDescriptor* schema,
                                                         MemoryPool* pool)
@@ -103,14 +260,9 @@ void TypedRowGroupStatistics<DType>::Update(const T* values, int64_t num_not_nul
   if (num_not_null == 0) return;
 
   Compare<T> compare(descr_);
-  auto batch_minmax = std::minmax_element(values, values + num_not_null, compare);
-  if (!has_min_max_) {
-    has_min_max_ = true;
-    Copy(*batch_minmax.first, &min_, min_buffer_.get());
-    Copy(*batch_minmax.second, &max_, max_buffer_.get());
-  } else {
-    Copy(std::min(min_, *batch_minmax.first, compare), &min_, min_buffer_.get());
-    Copy(std::max(max_, *batch_minmax.second, compare), &max_, max_buffer_.get());
+  T min, max;
+  if (BatchMinMax(values, num_not_null, compare, &min, &max)) {
+    UpdateMinMax(min, max);
   }
 }
 
@@ -128,35 +280,37 @@ void TypedRowGroupStatistics<DType>::UpdateSpaced(const T* values,
   // TODO: support distinct count?
   if (num_not_null == 0) return;
 
+  // Compute the min/max of each run of valid values with the batch kernels
   Compare<T> compare(descr_);
-  INIT_BITSET(valid_bits, static_cast<int>(valid_bits_offset));
-  // Find first valid entry and use that for min/max
-  // As (num_not_null != 0) there must be one
-  int64_t length = num_null + num_not_null;
-  int64_t i = 0;
-  for (; i < length; i++) {
-    if (bitset_valid_bits & (1 << bit_offset_valid_bits)) {
-      break;
-    }
-    READ_NEXT_BITSET(valid_bits);
-  }
-  T min = values[i];
-  T max = values[i];
-  for (; i < length; i++) {
-    if (bitset_valid_bits & (1 << bit_offset_valid_bits)) {
-      if (compare(values[i], min)) {
-        min = values[i];
-      } else if (compare(max, values[i])) {
-        max = values[i];
-      }
-    }
-    READ_NEXT_BITSET(valid_bits);
-  }
+  bool has_min_max = false;
+  T min, max;
+  VisitSetBitRuns(valid_bits, valid_bits_offset, num_null + num_not_null,
+                  [&](int64_t position, int64_t length) {
+                    T run_min, run_max;
+                    if (!BatchMinMax(values + position, length, compare, &run_min,
+                                     &run_max)) {
+                      return;
+                    }
+                    if (!has_min_max) {
+                      has_min_max = true;
+                      min = run_min;
+                      max = run_max;
+                    } else {
+                      min = std::min(min, run_min, compare);
+                      max = std::max(max, run_max, compare);
+                    }
+                  });
+  if (has_min_max) UpdateMinMax(min, max);
+}
+
+template <typename DType>
+void TypedRowGroupStatistics<DType>::UpdateMinMax(const T& min, const T& max) {
   if (!has_min_max_) {
     has_min_max_ = true;
     Copy(min, &min_, min_buffer_.get());
     Copy(max, &max_, max_buffer_.get());
   } else {
+    Compare<T> compare(descr_);
     Copy(std::min(min_, min, compare), &min_, min_buffer_.get());
     Copy(std::max(max_, max, compare), &max_, max_buffer_.get());
   }
@@ -177,17 +331,7 @@ void TypedRowGroupStatistics<DType>::Merge(const TypedRowGroupStatistics<DType>&
   this->MergeCounts(other);
 
   if (!other.HasMinMax()) return;
-
-  if (!has_min_max_) {
-    Copy(other.min_, &this->min_, min_buffer_.get());
-    Copy(other.max_, &this->max_, max_buffer_.get());
-    has_min_max_ = true;
-    return;
-  }
-
-  Compare<T> compare(descr_);
-  Copy(std::min(this->min_, other.min_, compare), &this->min_, min_buffer_.get());
-  Copy(std::max(this->max_, other.max_, compare), &this->max_, max_buffer_.get());
+  UpdateMinMax(other.min_, other.max_);
 }
 
 template <typename DType>
@@ -204,6 +348,49 @@ std::string TypedRowGroupStatistics<DType>::EncodeMax() {
   return s;
 }
 
+namespace {
+
+// Cut the value to a prefix of at most length bytes, and increment its last
+// byte that can be so that it is larger than all the values it is a prefix of,
+// in the signed byte order of Compare<ByteArray>. The value is kept in full if
+// none of its bytes can be incremented.
+void TruncateMax(int64_t length, std::string* value) {
+  if (static_cast<int64_t>(value->size()) <= length) return;
+  for (int64_t i = length - 1; i >= 0; --i) {
+    const int8_t byte = static_cast<int8_t>((*value)[i]);
+    if (byte != std::numeric_limits<int8_t>::max()) {
+      value->resize(i + 1);
+      (*value)[i] = static_cast<char>(byte + 1);
+      return;
+    }
+  }
+}
+
+}  // namespace
+
+template <>
+std::string TypedRowGroupStatistics<ByteArrayType>::EncodeMin() {
+  std::string s;
+  if (HasMinMax()) {
+    s.assign(reinterpret_cast<const char*>(min_.ptr), min_.len);
+    // Any prefix of the min is still smaller than the values
+    if (truncate_length_ > 0 && static_cast<int64_t>(s.size()) > truncate_length_) {
+      s.resize(truncate_length_);
+    }
+  }
+  return s;
+}
+
+template <>
+std::string TypedRowGroupStatistics<ByteArrayType>::EncodeMax() {
+  std::string s;
+  if (HasMinMax()) {
+    s.assign(reinterpret_cast<const char*>(max_.ptr), max_.len);
+    if (truncate_length_ > 0) TruncateMax(truncate_length_, &s);
+  }
+  return s;
+}
+
 template <typename DType>
 EncodedStatistics TypedRowGroupStatistics<DType>::Encode() {
   EncodedStatistics s;
@@ -148,6 +148,7 @@ class TypedRowGroupStatistics : public RowGroupStatistics {
   void Reset() override;
   void Merge(const TypedRowGroupStatistics<DType>& other);
 
+  // For floating point columns, NaN values do not contribute to the min and max
   void Update(const T* values, int64_t num_not_null, int64_t num_null);
   void UpdateSpaced(const T* values, const uint8_t* valid_bits, int64_t valid_bits_spaced,
                     int64_t num_not_null, int64_t num_null);
@@ -155,6 +156,11 @@ class TypedRowGroupStatistics : public RowGroupStatistics {
   const T& min() const;
   const T& max() const;
 
+  // If positive, the encoded min and max of BYTE_ARRAY values are truncated to
+  // at most this many bytes, the max being rounded up so that it still bounds
+  // the values. Other types are always encoded in full.
+  void set_truncate_length(int64_t length) { truncate_length_ = length; }
+
   std::string EncodeMin() override;
   std::string EncodeMax() override;
   EncodedStatistics Encode() override;
@@ -164,10 +170,13 @@ class TypedRowGroupStatistics : public RowGroupStatistics {
   T min_;
   T max_;
   ::arrow::MemoryPool* pool_;
+  int64_t truncate_length_ = 0;
 
   void PlainEncode(const T& src, std::string* dst);
   void PlainDecode(const std::string& src, T* dst);
   void Copy(const T& src, T* dst, PoolBuffer* buffer);
+  // Widen min_ and max_ to include the given range of values
+  void UpdateMinMax(const T& min, const T& max);
 
   std::shared_ptr<PoolBuffer> min_buffer_, max_buffer_;
 };
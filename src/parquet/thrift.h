@@ -19,6 +19,7 @@
 #define PARQUET_THRIFT_UTIL_H
 
 #include <cstdint>
+#include <memory>
 
 // Needed for thrift
 #include <boost/shared_ptr.hpp>
@@ -90,28 +91,70 @@ static inline format::CompressionCodec::type ToThrift(Compression::type type) {
 // ----------------------------------------------------------------------
 // Thrift struct serialization / deserialization utilities
 
+// Deserializes thrift messages from memory, reusing the same transport and
+// protocol for every message so that no allocations are made per message
+class ThriftDeserializer {
+ public:
+  ThriftDeserializer()
+      : transport_(new apache::thrift::transport::TMemoryBuffer()) {
+    ResetProtocol();
+  }
+
+  // Deserialize a thrift message from buf/len.  buf/len must at least contain
+  // all the bytes needed to store the thrift message.  On return, len will be
+  // set to the actual length of the message.
+  template <class T>
+  void Deserialize(const uint8_t* buf, uint32_t* len, T* deserialized_msg) {
+    if (!TryDeserialize(buf, len, deserialized_msg)) {
+      throw ParquetException(
+          "Couldn't deserialize thrift: the message is truncated or corrupt\n");
+    }
+  }
+
+  // Like Deserialize, but returns false rather than throwing if buf/len ends
+  // before the end of the message, in which case it may parse from more bytes
+  template <class T>
+  bool TryDeserialize(const uint8_t* buf, uint32_t* len, T* deserialized_msg) {
+    transport_->resetBuffer(const_cast<uint8_t*>(buf), *len);
+    try {
+      deserialized_msg->read(protocol_.get());
+    } catch (apache::thrift::transport::TTransportException& e) {
+      // The protocol keeps the state of the nested structs it was reading
+      ResetProtocol();
+      if (e.getType() == apache::thrift::transport::TTransportException::END_OF_FILE) {
+        return false;
+      }
+      std::stringstream ss;
+      ss << "Couldn't deserialize thrift: " << e.what() << "\n";
+      throw ParquetException(ss.str());
+    } catch (std::exception& e) {
+      ResetProtocol();
+      std::stringstream ss;
+      ss << "Couldn't deserialize thrift: " << e.what() << "\n";
+      throw ParquetException(ss.str());
+    }
+    uint32_t bytes_left = transport_->available_read();
+    *len = *len - bytes_left;
+    return true;
+  }
+
+ private:
+  typedef apache::thrift::protocol::TCompactProtocolT<
+      apache::thrift::transport::TMemoryBuffer>
+      Protocol;
+
+  void ResetProtocol() { protocol_.reset(new Protocol(transport_)); }
+
+  boost::shared_ptr<apache::thrift::transport::TMemoryBuffer> transport_;
+  std::unique_ptr<Protocol> protocol_;
+};
+
 // Deserialize a thrift message from buf/len.  buf/len must at least contain
 // all the bytes needed to store the thrift message.  On return, len will be
 // set to the actual length of the header.
 template <class T>
 inline void DeserializeThriftMsg(const uint8_t* buf, uint32_t* len, T* deserialized_msg) {
-  // Deserialize msg bytes into c++ thrift msg using memory transport.
-  boost::shared_ptr<apache::thrift::transport::TMemoryBuffer> tmem_transport(
-      new apache::thrift::transport::TMemoryBuffer(const_cast<uint8_t*>(buf), *len));
-  apache::thrift::protocol::TCompactProtocolFactoryT<
-      apache::thrift::transport::TMemoryBuffer>
-      tproto_factory;
-  boost::shared_ptr<apache::thrift::protocol::TProtocol> tproto =
-      tproto_factory.getProtocol(tmem_transport);
-  try {
-    deserialized_msg->read(tproto.get());
-  } catch (std::exception& e) {
-    std::stringstream ss;
-    ss << "Couldn't deserialize thrift: " << e.what() << "\n";
-    throw ParquetException(ss.str());
-  }
-  uint32_t bytes_left = tmem_transport->available_read();
-  *len = *len - bytes_left;
+  ThriftDeserializer().Deserialize(buf, len, deserialized_msg);
 }
 
 // Serialize obj into a buffer. The result is returned as a string.
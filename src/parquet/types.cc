@@ -88,6 +88,9 @@ std::string EncodingToString(Encoding::type t) {
     case Encoding::RLE_DICTIONARY:
       return "RLE_DICTIONARY";
       break;
+    case Encoding::BYTE_STREAM_SPLIT:
+      return "BYTE_STREAM_SPLIT";
+      break;
     default:
       return "UNKNOWN";
       break;
@@ -108,6 +111,15 @@ std::string CompressionToString(Compression::type t) {
     case Compression::LZO:
       return "LZO";
       break;
+    case Compression::BROTLI:
+      return "BROTLI";
+      break;
+    case Compression::LZ4:
+      return "LZ4";
+      break;
+    case Compression::ZSTD:
+      return "ZSTD";
+      break;
     default:
       return "UNKNOWN";
       break;
@@ -102,13 +102,14 @@ struct Encoding {
     DELTA_BINARY_PACKED = 5,
     DELTA_LENGTH_BYTE_ARRAY = 6,
     DELTA_BYTE_ARRAY = 7,
-    RLE_DICTIONARY = 8
+    RLE_DICTIONARY = 8,
+    BYTE_STREAM_SPLIT = 9
   };
 };
 
 // Compression, mirrors parquet::CompressionCodec
 struct Compression {
-  enum type { UNCOMPRESSED, SNAPPY, GZIP, LZO, BROTLI };
+  enum type { UNCOMPRESSED, SNAPPY, GZIP, LZO, BROTLI, LZ4, ZSTD };
 };
 
 // parquet::PageType
@@ -116,6 +117,15 @@ struct PageType {
   enum type { DATA_PAGE, INDEX_PAGE, DICTIONARY_PAGE, DATA_PAGE_V2 };
 };
 
+// parquet::SortingColumn, a column by which the rows of a row group are sorted
+struct SortingColumn {
+  // Index of the leaf column
+  int column_index;
+  bool descending;
+  // Whether the nulls come before the values
+  bool nulls_first;
+};
+
 // ----------------------------------------------------------------------
 
 struct ByteArray {
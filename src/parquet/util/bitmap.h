@@ -0,0 +1,144 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef PARQUET_UTIL_BITMAP_H
+#define PARQUET_UTIL_BITMAP_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#include "arrow/util/bit-util.h"
+
+namespace parquet {
+
+namespace internal {
+
+inline void SetBitTo(uint8_t* bits, int64_t i, bool value) {
+  if (value) {
+    ::arrow::BitUtil::SetBit(bits, i);
+  } else {
+    ::arrow::BitUtil::ClearBit(bits, i);
+  }
+}
+
+// Copy the up to 8 bits that fit in the current bytes of both src and dst
+inline int64_t CopyBitsInByte(const uint8_t* src, int64_t src_offset, int64_t length,
+                              uint8_t* dst, int64_t dst_offset) {
+  int src_shift = static_cast<int>(src_offset % 8);
+  int dst_shift = static_cast<int>(dst_offset % 8);
+  int n = static_cast<int>(std::min<int64_t>(length, 8 - std::max(src_shift, dst_shift)));
+  int mask = (1 << n) - 1;
+  int bits = (src[src_offset / 8] >> src_shift) & mask;
+  uint8_t* out = dst + dst_offset / 8;
+  *out = static_cast<uint8_t>((*out & ~(mask << dst_shift)) | (bits << dst_shift));
+  return n;
+}
+
+}  // namespace internal
+
+// Copy length bits of src, starting at bit src_offset, to dst starting at
+// bit dst_offset. The other bits of dst are left unchanged. Once dst is
+// byte-aligned, whole bytes are copied, shifted if src is not aligned.
+inline void CopyBitmap(const uint8_t* src, int64_t src_offset, int64_t length,
+                       uint8_t* dst, int64_t dst_offset) {
+  while (length > 0 && dst_offset % 8 != 0) {
+    int64_t n = internal::CopyBitsInByte(src, src_offset, length, dst, dst_offset);
+    src_offset += n;
+    dst_offset += n;
+    length -= n;
+  }
+
+  const int64_t num_bytes = length / 8;
+  const uint8_t* in = src + src_offset / 8;
+  uint8_t* out = dst + dst_offset / 8;
+  const int shift = static_cast<int>(src_offset % 8);
+  if (shift == 0) {
+    memcpy(out, in, static_cast<size_t>(num_bytes));
+  } else {
+    // The high bits of each output byte come from the next input byte, which
+    // is always part of the copied range
+    for (int64_t i = 0; i < num_bytes; ++i) {
+      out[i] = static_cast<uint8_t>((in[i] >> shift) | (in[i + 1] << (8 - shift)));
+    }
+  }
+  src_offset += num_bytes * 8;
+  dst_offset += num_bytes * 8;
+  length -= num_bytes * 8;
+
+  while (length > 0) {
+    int64_t n = internal::CopyBitsInByte(src, src_offset, length, dst, dst_offset);
+    src_offset += n;
+    dst_offset += n;
+    length -= n;
+  }
+}
+
+// Set length bits of the bitmap, starting at bit offset, to value
+inline void FillBitmap(uint8_t* bits, int64_t offset, int64_t length, bool value) {
+  for (; length > 0 && offset % 8 != 0; ++offset, --length) {
+    internal::SetBitTo(bits, offset, value);
+  }
+  const int64_t num_bytes = length / 8;
+  memset(bits + offset / 8, value ? 0xFF : 0, static_cast<size_t>(num_bytes));
+  offset += num_bytes * 8;
+  length -= num_bytes * 8;
+  for (; length > 0; ++offset, --length) {
+    internal::SetBitTo(bits, offset, value);
+  }
+}
+
+// Call visit(position, run_length) for each run of set bits among the length
+// bits starting at bit offset, with positions relative to offset. Whole bytes
+// that are all set or all unset are handled at once.
+template <typename Visit>
+inline void VisitSetBitRuns(const uint8_t* bits, int64_t offset, int64_t length,
+                            Visit&& visit) {
+  int64_t run_start = -1;
+  int64_t i = 0;
+  while (i < length) {
+    const int64_t bit = offset + i;
+    if (bit % 8 == 0 && length - i >= 8) {
+      const uint8_t byte = bits[bit / 8];
+      if (byte == 0xFF) {
+        if (run_start < 0) run_start = i;
+        i += 8;
+        continue;
+      }
+      if (byte == 0) {
+        if (run_start >= 0) {
+          visit(run_start, i - run_start);
+          run_start = -1;
+        }
+        i += 8;
+        continue;
+      }
+    }
+    if (::arrow::BitUtil::GetBit(bits, bit)) {
+      if (run_start < 0) run_start = i;
+    } else if (run_start >= 0) {
+      visit(run_start, i - run_start);
+      run_start = -1;
+    }
+    ++i;
+  }
+  if (run_start >= 0) visit(run_start, length - run_start);
+}
+
+}  // namespace parquet
+
+#endif  // PARQUET_UTIL_BITMAP_H
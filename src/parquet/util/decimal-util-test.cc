@@ -0,0 +1,129 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "parquet/util/decimal-util.h"
+
+namespace parquet {
+
+// The two halves of the decimal of a value, assuming a little-endian host
+static std::vector<int64_t> Halves(const uint8_t* decimal) {
+  std::vector<int64_t> halves(2);
+  memcpy(halves.data(), decimal, kDecimalByteWidth);
+  return halves;
+}
+
+TEST(TestDecimalUtil, DecimalByteWidth) {
+  ASSERT_EQ(1, DecimalByteWidth(1));
+  ASSERT_EQ(1, DecimalByteWidth(2));
+  ASSERT_EQ(2, DecimalByteWidth(3));
+  ASSERT_EQ(4, DecimalByteWidth(9));
+  ASSERT_EQ(8, DecimalByteWidth(18));
+  ASSERT_EQ(9, DecimalByteWidth(19));
+  ASSERT_EQ(16, DecimalByteWidth(38));
+}
+
+template <typename T>
+class TestIntDecimals : public ::testing::Test {};
+
+typedef ::testing::Types<int32_t, int64_t> IntTypes;
+
+TYPED_TEST_CASE(TestIntDecimals, IntTypes);
+
+TYPED_TEST(TestIntDecimals, RoundTrip) {
+  std::vector<TypeParam> values;
+  for (int i = 0; i < 37; ++i) {
+    values.push_back(static_cast<TypeParam>(i % 2 ? -i * 12345 : i * 6789));
+  }
+  values.push_back(std::numeric_limits<TypeParam>::min());
+  values.push_back(std::numeric_limits<TypeParam>::max());
+
+  const int64_t length = static_cast<int64_t>(values.size());
+  std::vector<uint8_t> decimals(length * kDecimalByteWidth);
+  IntsToDecimals(values.data(), length, decimals.data());
+  for (int64_t i = 0; i < length; ++i) {
+    std::vector<int64_t> halves = Halves(decimals.data() + i * kDecimalByteWidth);
+    ASSERT_EQ(static_cast<int64_t>(values[i]), halves[0]) << i;
+    ASSERT_EQ(values[i] < 0 ? -1 : 0, halves[1]) << i;
+  }
+
+  std::vector<TypeParam> out(length);
+  DecimalsToInts(decimals.data(), length, out.data());
+  ASSERT_EQ(values, out);
+}
+
+TEST(TestDecimalUtil, BigEndianRoundTrip) {
+  // -2, 256 and -2^64 as 16-byte big-endian values
+  std::vector<uint8_t> big_endian(3 * kDecimalByteWidth, 0);
+  memset(big_endian.data(), 0xFF, kDecimalByteWidth);
+  big_endian[kDecimalByteWidth - 1] = 0xFE;
+  big_endian[2 * kDecimalByteWidth - 2] = 0x01;
+  memset(big_endian.data() + 2 * kDecimalByteWidth, 0xFF, 8);
+
+  std::vector<FLBA> values;
+  for (int i = 0; i < 3; ++i) {
+    values.push_back(FLBA(big_endian.data() + i * kDecimalByteWidth));
+  }
+  std::vector<uint8_t> decimals(3 * kDecimalByteWidth);
+  FLBAsToDecimals(values.data(), 3, kDecimalByteWidth, nullptr, 0, decimals.data());
+  ASSERT_EQ(std::vector<int64_t>({-2, -1}), Halves(decimals.data()));
+  ASSERT_EQ(std::vector<int64_t>({256, 0}), Halves(decimals.data() + 16));
+  ASSERT_EQ(std::vector<int64_t>({0, -1}), Halves(decimals.data() + 32));
+
+  std::vector<uint8_t> out(big_endian.size());
+  DecimalsToBigEndian(decimals.data(), 3, kDecimalByteWidth, out.data());
+  ASSERT_EQ(big_endian, out);
+}
+
+TEST(TestDecimalUtil, NarrowBigEndian) {
+  // -2 and 256 in 2 bytes
+  std::vector<uint8_t> big_endian = {0xFF, 0xFE, 0x01, 0x00};
+  std::vector<FLBA> values = {FLBA(big_endian.data()), FLBA(big_endian.data() + 2)};
+  std::vector<uint8_t> decimals(2 * kDecimalByteWidth);
+  FLBAsToDecimals(values.data(), 2, 2, nullptr, 0, decimals.data());
+  ASSERT_EQ(std::vector<int64_t>({-2, -1}), Halves(decimals.data()));
+  ASSERT_EQ(std::vector<int64_t>({256, 0}), Halves(decimals.data() + 16));
+
+  std::vector<uint8_t> out(big_endian.size());
+  DecimalsToBigEndian(decimals.data(), 2, 2, out.data());
+  ASSERT_EQ(big_endian, out);
+}
+
+TEST(TestDecimalUtil, ByteArraysToDecimals) {
+  std::vector<uint8_t> bytes = {0x80, 0x7F, 0xFF};
+  // The null in the middle points nowhere
+  std::vector<ByteArray> values = {ByteArray(1, bytes.data()), ByteArray(0, nullptr),
+                                   ByteArray(2, bytes.data() + 1)};
+  const uint8_t valid_bits = 0x5;
+  std::vector<uint8_t> decimals(3 * kDecimalByteWidth, 0xAA);
+  ASSERT_TRUE(ByteArraysToDecimals(values.data(), 3, &valid_bits, 0, decimals.data()));
+  ASSERT_EQ(std::vector<int64_t>({-128, -1}), Halves(decimals.data()));
+  ASSERT_EQ(std::vector<int64_t>({0, 0}), Halves(decimals.data() + 16));
+  ASSERT_EQ(std::vector<int64_t>({0x7FFF, 0}), Halves(decimals.data() + 32));
+
+  std::vector<uint8_t> wide(kDecimalByteWidth + 1);
+  values = {ByteArray(static_cast<uint32_t>(wide.size()), wide.data())};
+  ASSERT_FALSE(ByteArraysToDecimals(values.data(), 1, nullptr, 0, decimals.data()));
+}
+
+}  // namespace parquet
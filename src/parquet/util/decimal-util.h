@@ -0,0 +1,218 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef PARQUET_UTIL_DECIMAL_UTIL_H
+#define PARQUET_UTIL_DECIMAL_UTIL_H
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#if defined(PARQUET_USE_SSE) && defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "arrow/util/bit-util.h"
+
+#include "parquet/types.h"
+
+// Conversions between the 16-byte little-endian two's complement values of
+// Arrow decimal arrays and the representations of Parquet decimals: INT32,
+// INT64, and big-endian two's complement FIXED_LEN_BYTE_ARRAY or BYTE_ARRAY
+// values. Each converts a whole batch of values.
+
+namespace parquet {
+
+constexpr int32_t kDecimalByteWidth = 16;
+
+// Highest precision of the decimals that fit in INT32 and INT64
+constexpr int32_t kMaxInt32DecimalPrecision = 9;
+constexpr int32_t kMaxInt64DecimalPrecision = 18;
+
+// The narrowest FIXED_LEN_BYTE_ARRAY width holding decimals of the precision
+inline int32_t DecimalByteWidth(int32_t precision) {
+  int32_t byte_width = 1;
+  while (std::pow(2.0, 8 * byte_width - 1) < std::pow(10.0, precision)) {
+    ++byte_width;
+  }
+  return byte_width;
+}
+
+namespace internal {
+
+inline void StoreDecimal(uint64_t low, uint64_t high, uint8_t* out) {
+  memcpy(out, &low, sizeof(low));
+  memcpy(out + sizeof(low), &high, sizeof(high));
+}
+
+// Sign-extend the width big-endian bytes to 16 bytes and swap them
+inline void BigEndianToDecimal(const uint8_t* in, int32_t width, uint8_t* out) {
+  uint8_t bytes[kDecimalByteWidth];
+  memset(bytes, (width > 0 && (in[0] & 0x80)) ? 0xFF : 0, kDecimalByteWidth - width);
+  memcpy(bytes + kDecimalByteWidth - width, in, width);
+  uint64_t high, low;
+  memcpy(&high, bytes, sizeof(high));
+  memcpy(&low, bytes + sizeof(high), sizeof(low));
+  StoreDecimal(::arrow::BitUtil::FromBigEndian(low),
+               ::arrow::BitUtil::FromBigEndian(high), out);
+}
+
+}  // namespace internal
+
+// Sign-extend INT32 or INT64 values into decimals
+template <typename T>
+inline void IntsToDecimals(const T* in, int64_t length, uint8_t* out) {
+  for (int64_t i = 0; i < length; ++i) {
+    const int64_t value = in[i];
+    internal::StoreDecimal(static_cast<uint64_t>(value),
+                           static_cast<uint64_t>(value >> 63),
+                           out + i * kDecimalByteWidth);
+  }
+}
+
+// The values of the nulls, which may be stale, are not read and their
+// decimals are zeroed. All the values are valid if valid_bits is null.
+inline void FLBAsToDecimals(const FLBA* in, int64_t length, int32_t width,
+                            const uint8_t* valid_bits, int64_t valid_bits_offset,
+                            uint8_t* out) {
+  for (int64_t i = 0; i < length; ++i, out += kDecimalByteWidth) {
+    if (valid_bits && !::arrow::BitUtil::GetBit(valid_bits, valid_bits_offset + i)) {
+      memset(out, 0, kDecimalByteWidth);
+    } else {
+      internal::BigEndianToDecimal(in[i].ptr, width, out);
+    }
+  }
+}
+
+// As FLBAsToDecimals. Returns false if a value is wider than 16 bytes.
+inline bool ByteArraysToDecimals(const ByteArray* in, int64_t length,
+                                 const uint8_t* valid_bits, int64_t valid_bits_offset,
+                                 uint8_t* out) {
+  for (int64_t i = 0; i < length; ++i, out += kDecimalByteWidth) {
+    if (valid_bits && !::arrow::BitUtil::GetBit(valid_bits, valid_bits_offset + i)) {
+      memset(out, 0, kDecimalByteWidth);
+    } else if (in[i].len > kDecimalByteWidth) {
+      return false;
+    } else {
+      internal::BigEndianToDecimal(in[i].ptr, static_cast<int32_t>(in[i].len), out);
+    }
+  }
+  return true;
+}
+
+// Truncate decimals to INT32 or INT64, which are wide enough for their
+// precision
+template <typename T>
+inline void DecimalsToInts(const uint8_t* in, int64_t length, T* out) {
+  for (int64_t i = 0; i < length; ++i) {
+    memcpy(out + i, in + i * kDecimalByteWidth, sizeof(T));
+  }
+}
+
+// Write the decimals as consecutive big-endian values of width bytes
+inline void DecimalsToBigEndian(const uint8_t* in, int64_t length, int32_t width,
+                                uint8_t* out) {
+  for (int64_t i = 0; i < length; ++i, in += kDecimalByteWidth, out += width) {
+    uint64_t low, high;
+    memcpy(&low, in, sizeof(low));
+    memcpy(&high, in + sizeof(low), sizeof(high));
+    uint8_t bytes[kDecimalByteWidth];
+    high = ::arrow::BitUtil::ToBigEndian(high);
+    low = ::arrow::BitUtil::ToBigEndian(low);
+    memcpy(bytes, &high, sizeof(high));
+    memcpy(bytes + sizeof(high), &low, sizeof(low));
+    memcpy(out, bytes + kDecimalByteWidth - width, width);
+  }
+}
+
+#if defined(PARQUET_USE_SSE) && defined(__SSE2__)
+
+template <>
+inline void IntsToDecimals<int32_t>(const int32_t* in, int64_t length, uint8_t* out) {
+  int64_t i = 0;
+  for (; i + 4 <= length; i += 4) {
+    const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+    const __m128i sign = _mm_srai_epi32(x, 31);
+    // The 64-bit lanes of the values, and their sign extensions
+    const __m128i lo = _mm_unpacklo_epi32(x, sign);
+    const __m128i hi = _mm_unpackhi_epi32(x, sign);
+    const __m128i lo_sign = _mm_unpacklo_epi32(sign, sign);
+    const __m128i hi_sign = _mm_unpackhi_epi32(sign, sign);
+    __m128i* dst = reinterpret_cast<__m128i*>(out + i * kDecimalByteWidth);
+    _mm_storeu_si128(dst, _mm_unpacklo_epi64(lo, lo_sign));
+    _mm_storeu_si128(dst + 1, _mm_unpackhi_epi64(lo, lo_sign));
+    _mm_storeu_si128(dst + 2, _mm_unpacklo_epi64(hi, hi_sign));
+    _mm_storeu_si128(dst + 3, _mm_unpackhi_epi64(hi, hi_sign));
+  }
+  for (; i < length; ++i) {
+    internal::StoreDecimal(static_cast<uint64_t>(static_cast<int64_t>(in[i])),
+                           static_cast<uint64_t>(in[i] >> 31),
+                           out + i * kDecimalByteWidth);
+  }
+}
+
+template <>
+inline void IntsToDecimals<int64_t>(const int64_t* in, int64_t length, uint8_t* out) {
+  int64_t i = 0;
+  for (; i + 2 <= length; i += 2) {
+    const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+    // Broadcast the sign of the high half of each value
+    const __m128i sign = _mm_srai_epi32(_mm_shuffle_epi32(x, _MM_SHUFFLE(3, 3, 1, 1)), 31);
+    __m128i* dst = reinterpret_cast<__m128i*>(out + i * kDecimalByteWidth);
+    _mm_storeu_si128(dst, _mm_unpacklo_epi64(x, sign));
+    _mm_storeu_si128(dst + 1, _mm_unpackhi_epi64(x, sign));
+  }
+  for (; i < length; ++i) {
+    internal::StoreDecimal(static_cast<uint64_t>(in[i]),
+                           static_cast<uint64_t>(in[i] >> 63),
+                           out + i * kDecimalByteWidth);
+  }
+}
+
+template <>
+inline void DecimalsToInts<int32_t>(const uint8_t* in, int64_t length, int32_t* out) {
+  int64_t i = 0;
+  for (; i + 4 <= length; i += 4) {
+    const __m128i* src = reinterpret_cast<const __m128i*>(in + i * kDecimalByteWidth);
+    const __m128i a = _mm_unpacklo_epi32(_mm_loadu_si128(src), _mm_loadu_si128(src + 1));
+    const __m128i b =
+        _mm_unpacklo_epi32(_mm_loadu_si128(src + 2), _mm_loadu_si128(src + 3));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_unpacklo_epi64(a, b));
+  }
+  for (; i < length; ++i) {
+    memcpy(out + i, in + i * kDecimalByteWidth, sizeof(int32_t));
+  }
+}
+
+template <>
+inline void DecimalsToInts<int64_t>(const uint8_t* in, int64_t length, int64_t* out) {
+  int64_t i = 0;
+  for (; i + 2 <= length; i += 2) {
+    const __m128i* src = reinterpret_cast<const __m128i*>(in + i * kDecimalByteWidth);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i),
+                     _mm_unpacklo_epi64(_mm_loadu_si128(src), _mm_loadu_si128(src + 1)));
+  }
+  for (; i < length; ++i) {
+    memcpy(out + i, in + i * kDecimalByteWidth, sizeof(int64_t));
+  }
+}
+
+#endif  // defined(PARQUET_USE_SSE) && defined(__SSE2__)
+
+}  // namespace parquet
+
+#endif  // PARQUET_UTIL_DECIMAL_UTIL_H
@@ -0,0 +1,83 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "parquet/util/int-util.h"
+
+namespace parquet {
+
+template <typename Types>
+class TestConvertInts : public ::testing::Test {};
+
+template <typename In, typename Out>
+struct Conversion {
+  using InType = In;
+  using OutType = Out;
+};
+
+typedef ::testing::Types<Conversion<int8_t, int32_t>, Conversion<uint8_t, int32_t>,
+                         Conversion<int16_t, int32_t>, Conversion<uint16_t, int32_t>,
+                         Conversion<uint32_t, int64_t>, Conversion<uint32_t, int32_t>,
+                         Conversion<int32_t, int8_t>, Conversion<int32_t, uint8_t>,
+                         Conversion<int32_t, int16_t>, Conversion<int32_t, uint16_t>>
+    ConversionTypes;
+
+TYPED_TEST_CASE(TestConvertInts, ConversionTypes);
+
+TYPED_TEST(TestConvertInts, MatchesStaticCast) {
+  using InType = typename TypeParam::InType;
+  using OutType = typename TypeParam::OutType;
+
+  std::mt19937_64 gen(42);
+  std::vector<InType> in(100);
+  for (auto& value : in) {
+    value = static_cast<InType>(gen());
+  }
+  in[0] = std::numeric_limits<InType>::min();
+  in[1] = std::numeric_limits<InType>::max();
+
+  // Unaligned starts and lengths that leave a tail to the scalar loop
+  for (int offset : {0, 1, 3}) {
+    for (int length : {0, 7, 16, 97 - offset}) {
+      std::vector<OutType> out(in.size());
+      ConvertInts(in.data() + offset, length, out.data() + offset);
+      for (int i = 0; i < length; ++i) {
+        ASSERT_EQ(static_cast<OutType>(in[offset + i]), out[offset + i]) << i;
+      }
+    }
+  }
+}
+
+TEST(TestMultiplyWidenInts, MatchesScalar) {
+  const uint32_t factor = 86400000;
+  std::vector<int32_t> in = {0, 1, -1, 100000, -100000, 7, -7,
+                             std::numeric_limits<int32_t>::max(),
+                             std::numeric_limits<int32_t>::min()};
+  std::vector<int64_t> out(in.size());
+  MultiplyWidenInts(in.data(), static_cast<int64_t>(in.size()), factor, out.data());
+  for (size_t i = 0; i < in.size(); ++i) {
+    ASSERT_EQ(static_cast<int64_t>(in[i]) * factor, out[i]) << i;
+  }
+}
+
+}  // namespace parquet
@@ -0,0 +1,213 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef PARQUET_UTIL_INT_UTIL_H
+#define PARQUET_UTIL_INT_UTIL_H
+
+#include <cstdint>
+
+#if defined(PARQUET_USE_SSE) && defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace parquet {
+
+// Convert length values with static_cast semantics: widening sign- or
+// zero-extends, narrowing truncates. The conversions between the Arrow
+// integer types and the Parquet physical types are vectorized.
+template <typename InType, typename OutType>
+inline void ConvertInts(const InType* in, int64_t length, OutType* out) {
+  for (int64_t i = 0; i < length; ++i) {
+    out[i] = static_cast<OutType>(in[i]);
+  }
+}
+
+#if defined(PARQUET_USE_SSE) && defined(__SSE2__)
+
+namespace internal {
+
+// The kernels convert a prefix of the values, which they return the length
+// of, leaving the tail to the scalar loop
+
+template <bool is_signed>
+inline int64_t Widen8To32(const uint8_t* in, int64_t length, int32_t* out) {
+  const __m128i zero = _mm_setzero_si128();
+  int64_t i = 0;
+  for (; i + 16 <= length; i += 16) {
+    const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+    __m128i lo, hi;
+    if (is_signed) {
+      lo = _mm_srai_epi16(_mm_unpacklo_epi8(x, x), 8);
+      hi = _mm_srai_epi16(_mm_unpackhi_epi8(x, x), 8);
+    } else {
+      lo = _mm_unpacklo_epi8(x, zero);
+      hi = _mm_unpackhi_epi8(x, zero);
+    }
+    __m128i* dst = reinterpret_cast<__m128i*>(out + i);
+    if (is_signed) {
+      _mm_storeu_si128(dst, _mm_srai_epi32(_mm_unpacklo_epi16(lo, lo), 16));
+      _mm_storeu_si128(dst + 1, _mm_srai_epi32(_mm_unpackhi_epi16(lo, lo), 16));
+      _mm_storeu_si128(dst + 2, _mm_srai_epi32(_mm_unpacklo_epi16(hi, hi), 16));
+      _mm_storeu_si128(dst + 3, _mm_srai_epi32(_mm_unpackhi_epi16(hi, hi), 16));
+    } else {
+      _mm_storeu_si128(dst, _mm_unpacklo_epi16(lo, zero));
+      _mm_storeu_si128(dst + 1, _mm_unpackhi_epi16(lo, zero));
+      _mm_storeu_si128(dst + 2, _mm_unpacklo_epi16(hi, zero));
+      _mm_storeu_si128(dst + 3, _mm_unpackhi_epi16(hi, zero));
+    }
+  }
+  return i;
+}
+
+template <bool is_signed>
+inline int64_t Widen16To32(const uint16_t* in, int64_t length, int32_t* out) {
+  const __m128i zero = _mm_setzero_si128();
+  int64_t i = 0;
+  for (; i + 8 <= length; i += 8) {
+    const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+    __m128i* dst = reinterpret_cast<__m128i*>(out + i);
+    if (is_signed) {
+      _mm_storeu_si128(dst, _mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16));
+      _mm_storeu_si128(dst + 1, _mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16));
+    } else {
+      _mm_storeu_si128(dst, _mm_unpacklo_epi16(x, zero));
+      _mm_storeu_si128(dst + 1, _mm_unpackhi_epi16(x, zero));
+    }
+  }
+  return i;
+}
+
+inline int64_t WidenUInt32To64(const uint32_t* in, int64_t length, int64_t* out) {
+  const __m128i zero = _mm_setzero_si128();
+  int64_t i = 0;
+  for (; i + 4 <= length; i += 4) {
+    const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+    __m128i* dst = reinterpret_cast<__m128i*>(out + i);
+    _mm_storeu_si128(dst, _mm_unpacklo_epi32(x, zero));
+    _mm_storeu_si128(dst + 1, _mm_unpackhi_epi32(x, zero));
+  }
+  return i;
+}
+
+// Sign-extend the low 16 bits of each 32-bit lane, so that the saturating
+// pack truncates
+inline __m128i Truncate32To16(const __m128i* src) {
+  const __m128i a = _mm_loadu_si128(src);
+  const __m128i b = _mm_loadu_si128(src + 1);
+  return _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(a, 16), 16),
+                         _mm_srai_epi32(_mm_slli_epi32(b, 16), 16));
+}
+
+inline int64_t Narrow32To16(const int32_t* in, int64_t length, uint16_t* out) {
+  int64_t i = 0;
+  for (; i + 8 <= length; i += 8) {
+    const __m128i* src = reinterpret_cast<const __m128i*>(in + i);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), Truncate32To16(src));
+  }
+  return i;
+}
+
+inline int64_t Narrow32To8(const int32_t* in, int64_t length, uint8_t* out) {
+  const __m128i low_byte = _mm_set1_epi16(0xFF);
+  int64_t i = 0;
+  for (; i + 16 <= length; i += 16) {
+    const __m128i* src = reinterpret_cast<const __m128i*>(in + i);
+    const __m128i lo = _mm_and_si128(Truncate32To16(src), low_byte);
+    const __m128i hi = _mm_and_si128(Truncate32To16(src + 2), low_byte);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(lo, hi));
+  }
+  return i;
+}
+
+}  // namespace internal
+
+#define PARQUET_VECTORIZED_CONVERT_INTS(InType, OutType, KernelInType, KernelOutType, \
+                                        Kernel)                                       \
+  template <>                                                                         \
+  inline void ConvertInts<InType, OutType>(const InType* in, int64_t length,          \
+                                           OutType* out) {                            \
+    int64_t i = Kernel(reinterpret_cast<const KernelInType*>(in), length,             \
+                       reinterpret_cast<KernelOutType*>(out));                        \
+    for (; i < length; ++i) {                                                         \
+      out[i] = static_cast<OutType>(in[i]);                                           \
+    }                                                                                 \
+  }
+
+PARQUET_VECTORIZED_CONVERT_INTS(int8_t, int32_t, uint8_t, int32_t,
+                                internal::Widen8To32<true>)
+PARQUET_VECTORIZED_CONVERT_INTS(uint8_t, int32_t, uint8_t, int32_t,
+                                internal::Widen8To32<false>)
+PARQUET_VECTORIZED_CONVERT_INTS(int16_t, int32_t, uint16_t, int32_t,
+                                internal::Widen16To32<true>)
+PARQUET_VECTORIZED_CONVERT_INTS(uint16_t, int32_t, uint16_t, int32_t,
+                                internal::Widen16To32<false>)
+PARQUET_VECTORIZED_CONVERT_INTS(uint32_t, int64_t, uint32_t, int64_t,
+                                internal::WidenUInt32To64)
+PARQUET_VECTORIZED_CONVERT_INTS(int32_t, int16_t, int32_t, uint16_t,
+                                internal::Narrow32To16)
+PARQUET_VECTORIZED_CONVERT_INTS(int32_t, uint16_t, int32_t, uint16_t,
+                                internal::Narrow32To16)
+PARQUET_VECTORIZED_CONVERT_INTS(int32_t, int8_t, int32_t, uint8_t, internal::Narrow32To8)
+PARQUET_VECTORIZED_CONVERT_INTS(int32_t, uint8_t, int32_t, uint8_t, internal::Narrow32To8)
+
+#undef PARQUET_VECTORIZED_CONVERT_INTS
+
+namespace internal {
+
+// SSE2 only multiplies unsigned 32-bit lanes into 64 bits: the product of a
+// 64-bit lane is that of its low half plus that of its high half shifted by
+// 32 bits
+inline __m128i MultiplyWide(__m128i wide, __m128i factors) {
+  const __m128i low = _mm_mul_epu32(wide, factors);
+  const __m128i high = _mm_mul_epu32(_mm_srli_epi64(wide, 32), factors);
+  return _mm_add_epi64(low, _mm_slli_epi64(high, 32));
+}
+
+}  // namespace internal
+
+// Multiply each of the length values by factor, widening them to 64 bits
+inline void MultiplyWidenInts(const int32_t* in, int64_t length, uint32_t factor,
+                              int64_t* out) {
+  const __m128i factors = _mm_set1_epi32(static_cast<int32_t>(factor));
+  int64_t i = 0;
+  for (; i + 4 <= length; i += 4) {
+    const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+    const __m128i sign = _mm_srai_epi32(x, 31);
+    __m128i* dst = reinterpret_cast<__m128i*>(out + i);
+    _mm_storeu_si128(dst, internal::MultiplyWide(_mm_unpacklo_epi32(x, sign), factors));
+    _mm_storeu_si128(dst + 1,
+                     internal::MultiplyWide(_mm_unpackhi_epi32(x, sign), factors));
+  }
+  for (; i < length; ++i) {
+    out[i] = static_cast<int64_t>(in[i]) * factor;
+  }
+}
+
+#else
+
+inline void MultiplyWidenInts(const int32_t* in, int64_t length, uint32_t factor,
+                              int64_t* out) {
+  for (int64_t i = 0; i < length; ++i) {
+    out[i] = static_cast<int64_t>(in[i]) * factor;
+  }
+}
+
+#endif  // defined(PARQUET_USE_SSE) && defined(__SSE2__)
+
+}  // namespace parquet
+
+#endif  // PARQUET_UTIL_INT_UTIL_H
@@ -17,6 +17,8 @@
 
 #include <cstdint>
 #include <cstdio>
+#include <cstring>
+#include <future>
 #include <memory>
 #include <string>
 #include <vector>
@@ -250,6 +252,74 @@ TEST(ChunkedAllocatorTest, FragmentationOverhead) {
   p.FreeAll();
 }
 
+TEST(ChunkedAllocatorTest, ReusesCachedChunks) {
+  MemoryPool* pool = default_memory_pool();
+  ChunkCache cache(pool, 3 * ChunkedAllocatorTest::INITIAL_CHUNK_SIZE);
+
+  uint8_t* first_chunk;
+  {
+    ChunkedAllocator p(pool, &cache);
+    first_chunk = p.Allocate(100);
+    p.Allocate(ChunkedAllocatorTest::INITIAL_CHUNK_SIZE);
+    p.FreeAll();
+    // Both chunks (4K, 8K) fit, the next ones would not
+    ASSERT_EQ(3 * ChunkedAllocatorTest::INITIAL_CHUNK_SIZE, cache.cached_bytes());
+  }
+
+  // A new allocator, as for the next row group, does no pool allocations
+  int64_t allocated = pool->bytes_allocated();
+  {
+    ChunkedAllocator p(pool, &cache);
+    ASSERT_EQ(first_chunk, p.Allocate(100));
+    p.Allocate(ChunkedAllocatorTest::INITIAL_CHUNK_SIZE);
+    ASSERT_EQ(allocated, pool->bytes_allocated());
+    ASSERT_EQ(0, cache.cached_bytes());
+
+    // Chunks beyond the capacity go back to the pool
+    p.Allocate(2 * ChunkedAllocatorTest::INITIAL_CHUNK_SIZE);
+    ASSERT_LT(allocated, pool->bytes_allocated());
+    p.FreeAll();
+  }
+  ASSERT_EQ(allocated, pool->bytes_allocated());
+  ASSERT_EQ(3 * ChunkedAllocatorTest::INITIAL_CHUNK_SIZE, cache.cached_bytes());
+
+  cache.Clear();
+  ASSERT_EQ(0, cache.cached_bytes());
+  ASSERT_EQ(allocated - 3 * ChunkedAllocatorTest::INITIAL_CHUNK_SIZE,
+            pool->bytes_allocated());
+}
+
+TEST(ChunkedAllocatorTest, TrimsUnusedCachedChunks) {
+  MemoryPool* pool = default_memory_pool();
+  const int64_t chunk_size = ChunkedAllocatorTest::INITIAL_CHUNK_SIZE;
+  ChunkCache cache(pool, 16 * chunk_size);
+  {
+    ChunkedAllocator p(pool, &cache);
+    p.Allocate(100);
+    p.Allocate(static_cast<int>(chunk_size));
+    p.Allocate(static_cast<int>(2 * chunk_size));
+    p.FreeAll();
+  }
+  // Chunks of 4K, 8K and 16K
+  ASSERT_EQ(7 * chunk_size, cache.cached_bytes());
+  cache.Trim();
+  ASSERT_EQ(7 * chunk_size, cache.cached_bytes());
+
+  // A larger chunk serves a smaller request
+  int64_t size;
+  uint8_t* data = cache.Take(3 * chunk_size, &size);
+  ASSERT_NE(nullptr, data);
+  ASSERT_EQ(4 * chunk_size, size);
+  ASSERT_EQ(nullptr, cache.Take(5 * chunk_size, &size));
+
+  // The 4K and 8K chunks were not needed since the last trim
+  cache.Put(data, size);
+  cache.Trim();
+  ASSERT_EQ(4 * chunk_size, cache.cached_bytes());
+  cache.Trim();
+  ASSERT_EQ(0, cache.cached_bytes());
+}
+
 TEST(TestBufferedInputStream, Basics) {
   int64_t source_size = 256;
   int64_t stream_offset = 10;
@@ -312,6 +382,49 @@ TEST(TestBufferedInputStream, Basics) {
   }
 }
 
+TEST(TestReadAheadInputStream, Basics) {
+  int64_t source_size = 100000;
+  int64_t stream_offset = 10;
+  std::shared_ptr<PoolBuffer> buf = AllocateBuffer(default_memory_pool(), source_size);
+  for (int64_t i = 0; i < source_size; i++) {
+    buf->mutable_data()[i] = static_cast<uint8_t>(i % 251);
+  }
+  auto wrapper =
+      std::make_shared<ArrowInputFile>(std::make_shared<::arrow::io::BufferReader>(buf));
+
+  ReadAheadInputStream stream(default_memory_pool(), 1000, wrapper.get(),
+                              stream_offset, source_size - stream_offset);
+
+  int64_t position = stream_offset;
+  auto check_read = [&](int64_t num_to_read, int64_t expected) {
+    int64_t bytes_read;
+    const uint8_t* output = stream.Peek(num_to_read, &bytes_read);
+    ASSERT_EQ(expected, bytes_read);
+    output = stream.Read(num_to_read, &bytes_read);
+    ASSERT_EQ(expected, bytes_read);
+    for (int64_t i = 0; i < bytes_read; i++) {
+      ASSERT_EQ((position + i) % 251, output[i]) << position + i;
+    }
+    position += bytes_read;
+  };
+
+  // Small reads through windows that are read ahead and grow
+  for (int i = 0; i < 500; i++) {
+    check_read(37, 37);
+  }
+  // Larger than the window
+  check_read(30000, 30000);
+  // Skip past the bytes read ahead
+  check_read(600, 600);
+  stream.Advance(20000);
+  position += 20000;
+  check_read(100, 100);
+  // Until the end of the stream
+  int64_t remaining = source_size - position;
+  check_read(remaining + 50, remaining);
+  check_read(10, 0);
+}
+
 TEST(TestArrowInputFile, Basics) {
   std::string data = "this is the data";
   auto data_buffer = reinterpret_cast<const uint8_t*>(data.c_str());
@@ -336,4 +449,232 @@ TEST(TestArrowInputFile, Basics) {
   ASSERT_TRUE(expected_buffer->Equals(*pq_buffer.get()));
 }
 
+// Exercises the reads through the IO thread pool
+class CopyingInputFile : public ArrowInputFile {
+ public:
+  using ArrowInputFile::ArrowInputFile;
+
+  bool supports_zero_copy() const override { return false; }
+};
+
+TEST(TestArrowInputFile, ReadAtAsync) {
+  std::string data = "this is the data";
+  auto data_buffer = reinterpret_cast<const uint8_t*>(data.c_str());
+
+  auto file = std::make_shared<::arrow::io::BufferReader>(data_buffer, data.size());
+  for (bool zero_copy : {true, false}) {
+    std::unique_ptr<RandomAccessSource> source;
+    if (zero_copy) {
+      source.reset(new ArrowInputFile(file));
+    } else {
+      source.reset(new CopyingInputFile(file));
+    }
+    ASSERT_EQ(zero_copy, source->supports_zero_copy());
+
+    std::vector<std::future<std::shared_ptr<Buffer>>> reads;
+    for (int64_t i = 0; i < 4; ++i) {
+      reads.push_back(source->ReadAtAsync(i * 4, 4));
+    }
+    for (int64_t i = 0; i < 4; ++i) {
+      std::shared_ptr<Buffer> buffer = reads[i].get();
+      Buffer expected(data_buffer + i * 4, 4);
+      ASSERT_TRUE(expected.Equals(*buffer));
+    }
+  }
+}
+
+TEST(TestChunkedOutputStream, Basics) {
+  std::vector<uint8_t> data(100);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<uint8_t>(i);
+  }
+
+  // Blocks of 8, 16, 32, 32 and 32 bytes
+  ChunkedOutputStream stream(default_memory_pool(), 8, 32);
+  stream.Write(data.data(), 5);
+  auto single = stream.GetBuffer();
+  ASSERT_EQ(5, single->size());
+  ASSERT_EQ(0, stream.Tell());
+
+  stream.Write(data.data(), 3);
+  stream.Write(data.data() + 3, 90);
+  stream.Write(data.data() + 93, 7);
+  ASSERT_EQ(100, stream.Tell());
+
+  InMemoryOutputStream sink;
+  stream.WriteTo(&sink);
+  std::shared_ptr<Buffer> written = sink.GetBuffer();
+  ASSERT_EQ(100, written->size());
+  ASSERT_EQ(0, memcmp(data.data(), written->data(), data.size()));
+
+  std::vector<std::shared_ptr<Buffer>> blocks = stream.GetBuffers();
+  ASSERT_EQ(5, static_cast<int>(blocks.size()));
+  ASSERT_EQ(8, blocks[0]->size());
+  ASSERT_EQ(16, blocks[1]->size());
+  ASSERT_EQ(12, blocks[4]->size());
+  ASSERT_EQ(0, stream.Tell());
+
+  stream.Write(data.data(), 8);
+  stream.Write(data.data() + 8, 92);
+  std::shared_ptr<Buffer> result = stream.GetBuffer();
+  ASSERT_EQ(100, result->size());
+  ASSERT_EQ(0, memcmp(data.data(), result->data(), data.size()));
+}
+
+// Counts the writes that reach an in-memory stream
+class CountingOutputStream : public OutputStream {
+ public:
+  CountingOutputStream() : num_writes(0) {}
+
+  void Close() override {}
+  int64_t Tell() override { return stream.Tell(); }
+  void Write(const uint8_t* data, int64_t length) override {
+    ++num_writes;
+    stream.Write(data, length);
+  }
+
+  InMemoryOutputStream stream;
+  int num_writes;
+};
+
+TEST(TestBufferedOutputStream, Basics) {
+  std::vector<uint8_t> data(100);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<uint8_t>(i);
+  }
+
+  auto sink = std::make_shared<CountingOutputStream>();
+  sink->Write(data.data(), 1);
+  BufferedOutputStream stream(sink, 10);
+  ASSERT_EQ(1, stream.Tell());
+
+  // The small writes are combined until the buffer is full
+  stream.Write(data.data() + 1, 4);
+  stream.Write(data.data() + 5, 4);
+  ASSERT_EQ(1, sink->num_writes);
+  ASSERT_EQ(9, stream.Tell());
+  stream.Write(data.data() + 9, 4);
+  ASSERT_EQ(2, sink->num_writes);
+  ASSERT_EQ(13, stream.Tell());
+
+  // Larger writes go through, after the buffered bytes
+  stream.Write(data.data() + 13, 50);
+  ASSERT_EQ(4, sink->num_writes);
+  ASSERT_EQ(63, stream.Tell());
+
+  stream.Write(data.data() + 63, 37);
+  stream.Flush();
+  stream.Flush();
+  ASSERT_EQ(5, sink->num_writes);
+  ASSERT_EQ(100, stream.Tell());
+
+  std::shared_ptr<Buffer> result = sink->stream.GetBuffer();
+  ASSERT_EQ(100, result->size());
+  ASSERT_EQ(0, memcmp(data.data(), result->data(), data.size()));
+}
+
+TEST(TestCodecPool, ReusesReleasedCodecs) {
+  CodecPool pool;
+  ASSERT_EQ(nullptr, pool.Acquire(Compression::UNCOMPRESSED, kDefaultCompressionLevel));
+
+  std::unique_ptr<::arrow::Codec> codec =
+      pool.Acquire(Compression::SNAPPY, kDefaultCompressionLevel);
+  ASSERT_NE(nullptr, codec);
+  ::arrow::Codec* released = codec.get();
+  pool.Release(Compression::SNAPPY, kDefaultCompressionLevel, std::move(codec));
+  ASSERT_EQ(1, pool.num_released());
+
+  codec = pool.Acquire(Compression::SNAPPY, kDefaultCompressionLevel);
+  ASSERT_EQ(released, codec.get());
+  ASSERT_EQ(0, pool.num_released());
+
+  // A codec in use is not handed out twice
+  std::unique_ptr<::arrow::Codec> other =
+      pool.Acquire(Compression::SNAPPY, kDefaultCompressionLevel);
+  ASSERT_NE(released, other.get());
+}
+
+TEST(TestCodecPool, RejectsCompressionLevels) {
+  CodecPool pool;
+  ASSERT_THROW(pool.Acquire(Compression::SNAPPY, 1), ParquetException);
+  // Without a codec there is nothing to set the level of
+  ASSERT_EQ(nullptr, pool.Acquire(Compression::UNCOMPRESSED, 1));
+}
+
+TEST(TestDecompressionBufferPool, ReusesReleasedBuffers) {
+  auto pool = std::make_shared<DecompressionBufferPool>(default_memory_pool(), 1024);
+
+  std::shared_ptr<ResizableBuffer> large = pool->Lease(512);
+  std::shared_ptr<ResizableBuffer> small = pool->Lease(100);
+  ASSERT_EQ(512, large->size());
+  const uint8_t* large_data = large->data();
+  const uint8_t* small_data = small->data();
+  large.reset();
+  small.reset();
+  ASSERT_LE(612, pool->retained_bytes());
+
+  // The smallest buffer that fits is leased
+  std::shared_ptr<ResizableBuffer> buffer = pool->Lease(50);
+  ASSERT_EQ(50, buffer->size());
+  ASSERT_EQ(small_data, buffer->data());
+  std::shared_ptr<ResizableBuffer> other = pool->Lease(200);
+  ASSERT_EQ(large_data, other->data());
+  ASSERT_EQ(0, pool->retained_bytes());
+
+  // Slices keep the lease
+  std::shared_ptr<Buffer> slice = ::arrow::SliceBuffer(buffer, 10, 10);
+  buffer.reset();
+  ASSERT_EQ(0, pool->retained_bytes());
+  slice.reset();
+  ASSERT_LT(0, pool->retained_bytes());
+
+  // Beyond max_retained_bytes the buffers are freed
+  other.reset();
+  buffer = pool->Lease(2048);
+  int64_t retained = pool->retained_bytes();
+  buffer.reset();
+  ASSERT_EQ(retained, pool->retained_bytes());
+}
+
+TEST(TestGatherBuffers, Basics) {
+  std::string first = "levels";
+  std::string second = "values";
+  std::vector<std::shared_ptr<Buffer>> buffers = {
+      std::make_shared<Buffer>(reinterpret_cast<const uint8_t*>(first.c_str()), 6),
+      std::make_shared<Buffer>(reinterpret_cast<const uint8_t*>(second.c_str()), 6)};
+  auto scratch = std::static_pointer_cast<ResizableBuffer>(
+      AllocateBuffer(default_memory_pool(), 0));
+
+  // A single buffer is not copied
+  std::vector<std::shared_ptr<Buffer>> single = {buffers[0]};
+  ASSERT_EQ(buffers[0], GatherBuffers(single, scratch));
+
+  std::shared_ptr<Buffer> gathered = GatherBuffers(buffers, scratch);
+  ASSERT_EQ(12, gathered->size());
+  ASSERT_EQ(0, std::memcmp(gathered->data(), "levelsvalues", 12));
+
+  // Written one after the other
+  InMemoryOutputStream stream;
+  stream.WriteBuffers(buffers);
+  ASSERT_TRUE(gathered->Equals(*stream.GetBuffer()));
+}
+
+TEST(TestResizePadded, AlignedWithTailPadding) {
+  std::shared_ptr<PoolBuffer> buffer = AllocateBuffer(default_memory_pool(), 0);
+  ASSERT_TRUE(ResizePadded(buffer.get(), 100).ok());
+  ASSERT_EQ(100, buffer->size());
+  ASSERT_GE(buffer->capacity(), 100 + kBufferPadding);
+  ASSERT_EQ(0U, reinterpret_cast<uintptr_t>(buffer->data()) % kBufferAlignment);
+
+  // Shrinking keeps the memory for the next, larger, batch
+  const uint8_t* data = buffer->data();
+  ASSERT_TRUE(ResizePadded(buffer.get(), 10).ok());
+  ASSERT_EQ(10, buffer->size());
+  ASSERT_TRUE(ResizePadded(buffer.get(), 100).ok());
+  ASSERT_EQ(data, buffer->data());
+
+  Vector<int64_t> vector(3, default_memory_pool());
+  ASSERT_EQ(0U, reinterpret_cast<uintptr_t>(vector.data()) % kBufferAlignment);
+}
+
 }  // namespace parquet
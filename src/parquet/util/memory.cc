@@ -20,26 +20,44 @@
 #include <algorithm>
 #include <cstdint>
 #include <cstdio>
+#include <cstring>
+#include <exception>
+#include <future>
+#include <iterator>
 #include <string>
 #include <utility>
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "arrow/io/file.h"
 #include "arrow/status.h"
 #include "arrow/util/bit-util.h"
 
 #include "parquet/exception.h"
 #include "parquet/types.h"
 #include "parquet/util/logging.h"
+#include "parquet/util/thread-pool.h"
 
 using arrow::MemoryPool;
 
 namespace parquet {
 
+::arrow::Status ResizePadded(ResizableBuffer* buffer, int64_t size) {
+  if (buffer->capacity() < size + kBufferPadding) {
+    RETURN_NOT_OK(buffer->Reserve(size + kBufferPadding));
+  }
+  return buffer->Resize(size, false);
+}
+
 template <class T>
 Vector<T>::Vector(int64_t size, MemoryPool* pool)
-    : buffer_(AllocateUniqueBuffer(pool, size * sizeof(T))),
-      size_(size),
-      capacity_(size) {
+    : buffer_(AllocateUniqueBuffer(pool)), size_(size), capacity_(size) {
   if (size > 0) {
+    PARQUET_THROW_NOT_OK(ResizePadded(buffer_.get(), size * sizeof(T)));
     data_ = reinterpret_cast<T*>(buffer_->mutable_data());
   } else {
     data_ = nullptr;
@@ -49,7 +67,7 @@ Vector<T>::Vector(int64_t size, MemoryPool* pool)
 template <class T>
 void Vector<T>::Reserve(int64_t new_capacity) {
   if (new_capacity > capacity_) {
-    PARQUET_THROW_NOT_OK(buffer_->Resize(new_capacity * sizeof(T)));
+    PARQUET_THROW_NOT_OK(ResizePadded(buffer_.get(), new_capacity * sizeof(T)));
     data_ = reinterpret_cast<T*>(buffer_->mutable_data());
     capacity_ = new_capacity;
   }
@@ -89,13 +107,94 @@ template class Vector<FixedLenByteArray>;
 const int ChunkedAllocator::INITIAL_CHUNK_SIZE;
 const int ChunkedAllocator::MAX_CHUNK_SIZE;
 
-ChunkedAllocator::ChunkedAllocator(MemoryPool* pool)
+ChunkCache::ChunkCache(MemoryPool* pool, int64_t capacity)
+    : pool_(pool), capacity_(capacity), cached_bytes_(0), min_cached_bytes_(0) {}
+
+ChunkCache::~ChunkCache() { Clear(); }
+
+ChunkCache* ChunkCache::Default() {
+  // Intentionally leaked, so that chunks are never freed into the default pool
+  // after it is destroyed at exit
+  static ChunkCache* cache = new ChunkCache(::arrow::default_memory_pool());
+  return cache;
+}
+
+ChunkCache* ChunkCache::ForPool(MemoryPool* pool) {
+  return pool == ::arrow::default_memory_pool() ? Default() : nullptr;
+}
+
+uint8_t* ChunkCache::Take(int64_t min_size, int64_t* size) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = chunks_.lower_bound(min_size);
+  if (it == chunks_.end()) return nullptr;
+  uint8_t* data = it->second;
+  *size = it->first;
+  chunks_.erase(it);
+  cached_bytes_ -= *size;
+  min_cached_bytes_ = std::min(min_cached_bytes_, cached_bytes_);
+  return data;
+}
+
+void ChunkCache::Put(uint8_t* data, int64_t size) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (cached_bytes_ + size <= capacity_) {
+      chunks_.emplace(size, data);
+      cached_bytes_ += size;
+      return;
+    }
+  }
+  pool_->Free(data, size);
+}
+
+void ChunkCache::set_capacity(int64_t capacity) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  capacity_ = capacity;
+  // Free the largest chunks first, the small ones are the most reused
+  while (cached_bytes_ > capacity_) {
+    auto it = std::prev(chunks_.end());
+    pool_->Free(it->second, it->first);
+    cached_bytes_ -= it->first;
+    chunks_.erase(it);
+  }
+  min_cached_bytes_ = std::min(min_cached_bytes_, cached_bytes_);
+}
+
+void ChunkCache::Trim() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  // These bytes were not needed since the previous call
+  int64_t unused_bytes = min_cached_bytes_;
+  auto it = chunks_.end();
+  while (it != chunks_.begin() && unused_bytes > 0) {
+    --it;
+    if (it->first <= unused_bytes) {
+      pool_->Free(it->second, it->first);
+      cached_bytes_ -= it->first;
+      unused_bytes -= it->first;
+      it = chunks_.erase(it);
+    }
+  }
+  min_cached_bytes_ = cached_bytes_;
+}
+
+int64_t ChunkCache::cached_bytes() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return cached_bytes_;
+}
+
+ChunkedAllocator::ChunkedAllocator(MemoryPool* pool, ChunkCache* chunk_cache)
     : current_chunk_idx_(-1),
       next_chunk_size_(INITIAL_CHUNK_SIZE),
       total_allocated_bytes_(0),
       peak_allocated_bytes_(0),
       total_reserved_bytes_(0),
-      pool_(pool) {}
+      pool_(pool),
+      chunk_cache_(chunk_cache) {
+  if (chunk_cache_ == nullptr) {
+    chunk_cache_ = ChunkCache::ForPool(pool_);
+  }
+  DCHECK(chunk_cache_ == nullptr || chunk_cache_->pool() == pool_);
+}
 
 ChunkedAllocator::ChunkInfo::ChunkInfo(int64_t size, uint8_t* buf)
     : data(buf), size(size), allocated_bytes(0) {}
@@ -104,7 +203,7 @@ ChunkedAllocator::~ChunkedAllocator() {
   int64_t total_bytes_released = 0;
   for (size_t i = 0; i < chunks_.size(); ++i) {
     total_bytes_released += chunks_[i].size;
-    pool_->Free(chunks_[i].data, chunks_[i].size);
+    FreeChunk(chunks_[i].data, chunks_[i].size);
   }
 
   DCHECK(chunks_.empty()) << "Must call FreeAll() or AcquireData() for this pool";
@@ -155,7 +254,7 @@ void ChunkedAllocator::FreeAll() {
   int64_t total_bytes_released = 0;
   for (size_t i = 0; i < chunks_.size(); ++i) {
     total_bytes_released += chunks_[i].size;
-    pool_->Free(chunks_[i].data, chunks_[i].size);
+    FreeChunk(chunks_[i].data, chunks_[i].size);
   }
   chunks_.clear();
   next_chunk_size_ = INITIAL_CHUNK_SIZE;
@@ -164,6 +263,22 @@ void ChunkedAllocator::FreeAll() {
   total_reserved_bytes_ = 0;
 }
 
+uint8_t* ChunkedAllocator::AllocateChunk(int64_t* size) {
+  uint8_t* buf = chunk_cache_ ? chunk_cache_->Take(*size, size) : nullptr;
+  if (buf == nullptr) {
+    PARQUET_THROW_NOT_OK(pool_->Allocate(*size, &buf));
+  }
+  return buf;
+}
+
+void ChunkedAllocator::FreeChunk(uint8_t* data, int64_t size) {
+  if (chunk_cache_) {
+    chunk_cache_->Put(data, size);
+  } else {
+    pool_->Free(data, size);
+  }
+}
+
 bool ChunkedAllocator::FindChunk(int64_t min_size) {
   // Try to allocate from a free chunk. The first free chunk, if any, will be immediately
   // after the current chunk.
@@ -193,8 +308,7 @@ bool ChunkedAllocator::FindChunk(int64_t min_size) {
     chunk_size = std::max<int64_t>(min_size, next_chunk_size_);
 
     // Allocate a new chunk. Return early if malloc fails.
-    uint8_t* buf = nullptr;
-    PARQUET_THROW_NOT_OK(pool_->Allocate(chunk_size, &buf));
+    uint8_t* buf = AllocateChunk(&chunk_size);
     if (ARROW_PREDICT_FALSE(buf == NULL)) {
       DCHECK_EQ(current_chunk_idx_, static_cast<int>(chunks_.size()));
       current_chunk_idx_ = static_cast<int>(chunks_.size()) - 1;
@@ -366,6 +480,62 @@ int64_t ArrowInputFile::ReadAt(int64_t position, int64_t nbytes, uint8_t* out) {
   return bytes_read;
 }
 
+std::future<std::shared_ptr<Buffer>> RandomAccessSource::ReadAtAsync(
+    int64_t position, int64_t nbytes) {
+  if (supports_zero_copy()) {
+    // Only slices the source's memory, not worth a thread hop
+    std::promise<std::shared_ptr<Buffer>> result;
+    try {
+      result.set_value(ReadAt(position, nbytes));
+    } catch (...) {
+      result.set_exception(std::current_exception());
+    }
+    return result.get_future();
+  }
+  auto task = std::make_shared<std::packaged_task<std::shared_ptr<Buffer>()>>(
+      [this, position, nbytes]() { return ReadAt(position, nbytes); });
+  std::future<std::shared_ptr<Buffer>> result = task->get_future();
+  ThreadPool::DefaultIO()->Submit([task]() { (*task)(); });
+  return result;
+}
+
+bool ArrowInputFile::supports_zero_copy() const { return file_->supports_zero_copy(); }
+
+void ArrowInputFile::Advise(int64_t position, int64_t nbytes, AccessHint::type hint) {
+  if (nbytes <= 0) {
+    return;
+  }
+#if defined(MADV_WILLNEED)
+  // Only file-backed maps: other zero-copy sources are plain memory, whose
+  // contents MADV_DONTNEED would discard
+  if (dynamic_cast<::arrow::io::MemoryMappedFile*>(file_.get()) != nullptr) {
+    std::shared_ptr<Buffer> mapped;
+    if (!file_->ReadAt(position, nbytes, &mapped).ok() || mapped->size() == 0) {
+      return;
+    }
+    // madvise needs a page-aligned address
+    const uintptr_t page_size = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+    const uintptr_t start = reinterpret_cast<uintptr_t>(mapped->data());
+    const uintptr_t aligned_start = start & ~(page_size - 1);
+    madvise(reinterpret_cast<void*>(aligned_start),
+            static_cast<size_t>(start - aligned_start + mapped->size()),
+            hint == AccessHint::WILL_NEED ? MADV_WILLNEED : MADV_DONTNEED);
+    return;
+  }
+#endif
+#if defined(POSIX_FADV_WILLNEED)
+  auto file = dynamic_cast<::arrow::io::ReadableFile*>(file_.get());
+  if (file != nullptr) {
+    if (hint == AccessHint::WILL_NEED) {
+      posix_fadvise(file->file_descriptor(), position, nbytes, POSIX_FADV_SEQUENTIAL);
+      posix_fadvise(file->file_descriptor(), position, nbytes, POSIX_FADV_WILLNEED);
+    } else {
+      posix_fadvise(file->file_descriptor(), position, nbytes, POSIX_FADV_DONTNEED);
+    }
+  }
+#endif
+}
+
 ArrowOutputStream::ArrowOutputStream(
     const std::shared_ptr<::arrow::io::OutputStream> file)
     : file_(file) {}
@@ -408,6 +578,13 @@ const uint8_t* InMemoryInputStream::Read(int64_t num_to_read, int64_t* num_bytes
 
 void InMemoryInputStream::Advance(int64_t num_bytes) { offset_ += num_bytes; }
 
+std::shared_ptr<Buffer> InMemoryInputStream::ReadSlice(int64_t num_to_read) {
+  int64_t num_bytes = std::min(num_to_read, len_ - offset_);
+  auto result = std::make_shared<Buffer>(buffer_, offset_, num_bytes);
+  offset_ += num_bytes;
+  return result;
+}
+
 // ----------------------------------------------------------------------
 // In-memory output stream
 
@@ -445,6 +622,213 @@ std::shared_ptr<Buffer> InMemoryOutputStream::GetBuffer() {
   return result;
 }
 
+// ----------------------------------------------------------------------
+// ChunkedOutputStream
+
+ChunkedOutputStream::ChunkedOutputStream(MemoryPool* pool, int64_t initial_block_size,
+                                         int64_t max_block_size)
+    : pool_(pool),
+      initial_block_size_(initial_block_size > 0 ? initial_block_size
+                                                 : kInMemoryDefaultCapacity),
+      max_block_size_(std::max(max_block_size, initial_block_size_)),
+      block_size_(0),
+      size_(0) {}
+
+void ChunkedOutputStream::Write(const uint8_t* data, int64_t length) {
+  while (length > 0) {
+    if (blocks_.empty() || block_size_ == blocks_.back()->size()) {
+      int64_t capacity =
+          blocks_.empty() ? initial_block_size_
+                          : std::min(blocks_.back()->size() * 2, max_block_size_);
+      blocks_.push_back(AllocateBuffer(pool_, capacity));
+      block_size_ = 0;
+    }
+    PoolBuffer* block = blocks_.back().get();
+    int64_t bytes = std::min(length, block->size() - block_size_);
+    memcpy(block->mutable_data() + block_size_, data, bytes);
+    block_size_ += bytes;
+    size_ += bytes;
+    data += bytes;
+    length -= bytes;
+  }
+}
+
+void ChunkedOutputStream::Clear() {
+  blocks_.clear();
+  block_size_ = 0;
+  size_ = 0;
+}
+
+std::vector<std::shared_ptr<Buffer>> ChunkedOutputStream::GetBuffers() {
+  std::vector<std::shared_ptr<Buffer>> result;
+  for (size_t i = 0; i < blocks_.size(); ++i) {
+    int64_t length = i + 1 == blocks_.size() ? block_size_ : blocks_[i]->size();
+    result.push_back(::arrow::SliceBuffer(blocks_[i], 0, length));
+  }
+  Clear();
+  return result;
+}
+
+std::shared_ptr<Buffer> ChunkedOutputStream::GetBuffer() {
+  if (blocks_.size() == 1) {
+    return GetBuffers()[0];
+  }
+  std::shared_ptr<PoolBuffer> result = AllocateBuffer(pool_, size_);
+  int64_t offset = 0;
+  for (const auto& block : GetBuffers()) {
+    memcpy(result->mutable_data() + offset, block->data(), block->size());
+    offset += block->size();
+  }
+  return result;
+}
+
+void ChunkedOutputStream::WriteTo(OutputStream* sink) const {
+  for (size_t i = 0; i < blocks_.size(); ++i) {
+    int64_t length = i + 1 == blocks_.size() ? block_size_ : blocks_[i]->size();
+    sink->Write(blocks_[i]->data(), length);
+  }
+}
+
+// ----------------------------------------------------------------------
+// CodecPool
+
+std::unique_ptr<::arrow::Codec> CodecPool::Acquire(Compression::type codec, int level) {
+  if (codec != Compression::UNCOMPRESSED && level != kDefaultCompressionLevel) {
+    ParquetException::NYI("Compression levels other than the codec default");
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = codecs_.find(std::make_pair(codec, level));
+    if (it != codecs_.end() && !it->second.empty()) {
+      std::unique_ptr<::arrow::Codec> result = std::move(it->second.back());
+      it->second.pop_back();
+      return result;
+    }
+  }
+  return GetCodecFromArrow(codec);
+}
+
+void CodecPool::Release(Compression::type codec, int level,
+                        std::unique_ptr<::arrow::Codec> c) {
+  if (c == nullptr) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  codecs_[std::make_pair(codec, level)].push_back(std::move(c));
+}
+
+int64_t CodecPool::num_released() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  int64_t result = 0;
+  for (const auto& item : codecs_) {
+    result += static_cast<int64_t>(item.second.size());
+  }
+  return result;
+}
+
+// ----------------------------------------------------------------------
+// DecompressionBufferPool
+
+DecompressionBufferPool::DecompressionBufferPool(MemoryPool* pool,
+                                                 int64_t max_retained_bytes)
+    : pool_(pool), max_retained_bytes_(max_retained_bytes), retained_bytes_(0) {}
+
+std::shared_ptr<ResizableBuffer> DecompressionBufferPool::Lease(int64_t size) {
+  std::unique_ptr<PoolBuffer> buffer;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Best fit, or else the largest buffer, which grows the least
+    auto best = buffers_.end();
+    for (auto it = buffers_.begin(); it != buffers_.end(); ++it) {
+      if (best == buffers_.end()) {
+        best = it;
+        continue;
+      }
+      int64_t capacity = (*it)->capacity();
+      int64_t best_capacity = (*best)->capacity();
+      bool fits = capacity >= size;
+      bool best_fits = best_capacity >= size;
+      if ((fits && (!best_fits || capacity < best_capacity)) ||
+          (!fits && !best_fits && capacity > best_capacity)) {
+        best = it;
+      }
+    }
+    if (best != buffers_.end()) {
+      retained_bytes_ -= (*best)->capacity();
+      buffer = std::move(*best);
+      buffers_.erase(best);
+    }
+  }
+  if (buffer == nullptr) {
+    buffer.reset(new PoolBuffer(pool_));
+  }
+  PARQUET_THROW_NOT_OK(buffer->Resize(size, false));
+
+  std::shared_ptr<DecompressionBufferPool> self = shared_from_this();
+  return std::shared_ptr<ResizableBuffer>(
+      buffer.release(), [self](ResizableBuffer* leased) {
+        self->Release(static_cast<PoolBuffer*>(leased));
+      });
+}
+
+void DecompressionBufferPool::Release(PoolBuffer* buffer) {
+  std::unique_ptr<PoolBuffer> owned(buffer);
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (retained_bytes_ + owned->capacity() <= max_retained_bytes_) {
+    retained_bytes_ += owned->capacity();
+    buffers_.push_back(std::move(owned));
+  }
+}
+
+int64_t DecompressionBufferPool::retained_bytes() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return retained_bytes_;
+}
+
+// ----------------------------------------------------------------------
+// BufferedOutputStream
+
+BufferedOutputStream::BufferedOutputStream(const std::shared_ptr<OutputStream>& sink,
+                                           int64_t buffer_size, MemoryPool* pool)
+    : sink_(sink),
+      buffer_(AllocateBuffer(pool, buffer_size)),
+      buffer_size_(buffer_size),
+      buffered_size_(0),
+      position_(sink->Tell()) {}
+
+BufferedOutputStream::~BufferedOutputStream() {
+  try {
+    Flush();
+  } catch (...) {
+  }
+}
+
+void BufferedOutputStream::Close() {
+  Flush();
+  sink_->Close();
+}
+
+void BufferedOutputStream::Write(const uint8_t* data, int64_t length) {
+  if (buffered_size_ + length > buffer_size_) {
+    Flush();
+  }
+  if (length >= buffer_size_) {
+    sink_->Write(data, length);
+  } else {
+    std::memcpy(buffer_->mutable_data() + buffered_size_, data, length);
+    buffered_size_ += length;
+  }
+  position_ += length;
+}
+
+void BufferedOutputStream::Flush() {
+  if (buffered_size_ > 0) {
+    sink_->Write(buffer_->data(), buffered_size_);
+    buffered_size_ = 0;
+  }
+  sink_->Flush();
+}
+
 // ----------------------------------------------------------------------
 // BufferedInputStream
 
@@ -491,6 +875,133 @@ void BufferedInputStream::Advance(int64_t num_bytes) {
   buffer_offset_ += num_bytes;
 }
 
+constexpr int64_t ReadAheadInputStream::kMaxWindowMultiple;
+
+ReadAheadInputStream::ReadAheadInputStream(MemoryPool* pool, int64_t buffer_size,
+                                           RandomAccessSource* source, int64_t start,
+                                           int64_t num_bytes)
+    : pool_(pool),
+      source_(source),
+      stream_offset_(start),
+      stream_end_(start + num_bytes),
+      window_size_(std::max(buffer_size, kInMemoryDefaultCapacity)),
+      max_window_size_(window_size_ * kMaxWindowMultiple),
+      window_data_(nullptr),
+      window_start_(start),
+      window_end_(start),
+      next_headroom_(0),
+      next_size_(0) {}
+
+ReadAheadInputStream::~ReadAheadInputStream() {
+  if (next_read_.valid()) {
+    next_read_.wait();
+  }
+}
+
+const uint8_t* ReadAheadInputStream::Peek(int64_t num_to_peek, int64_t* num_bytes) {
+  *num_bytes = std::min(num_to_peek, stream_end_ - stream_offset_);
+  if (stream_offset_ < window_start_ || stream_offset_ + *num_bytes > window_end_) {
+    Refill(*num_bytes);
+  }
+  MaybeReadAhead();
+  return window_data_ + (stream_offset_ - window_start_);
+}
+
+const uint8_t* ReadAheadInputStream::Read(int64_t num_to_read, int64_t* num_bytes) {
+  const uint8_t* result = Peek(num_to_read, num_bytes);
+  stream_offset_ += *num_bytes;
+  return result;
+}
+
+void ReadAheadInputStream::Advance(int64_t num_bytes) { stream_offset_ += num_bytes; }
+
+void ReadAheadInputStream::Refill(int64_t num_bytes) {
+  int64_t end = stream_offset_ + num_bytes;
+  // Grow the window with every refill, a large chunk is read in few requests
+  int64_t length = std::max(num_bytes, window_size_);
+  window_size_ =
+      std::min({window_size_ * 2, max_window_size_, stream_end_ - window_start_});
+
+  if (next_read_.valid()) {
+    int64_t next_start = window_end_;
+    int64_t next_end = next_start + next_size_;
+    int64_t bytes_read = next_read_.get();
+    if (bytes_read != next_size_) {
+      throw ParquetException("Failed reading column data from source");
+    }
+    if (stream_offset_ >= window_start_ && end <= next_end) {
+      // Move the unconsumed end of the window in front of the bytes read ahead
+      int64_t unconsumed = std::max<int64_t>(0, window_end_ - stream_offset_);
+      DCHECK_LE(unconsumed, next_headroom_);
+      uint8_t* data = next_buffer_->mutable_data() + next_headroom_ - unconsumed;
+      if (unconsumed > 0) {
+        memcpy(data, window_data_ + (stream_offset_ - window_start_),
+               static_cast<size_t>(unconsumed));
+      }
+      spare_buffer_ = window_buffer_;
+      window_buffer_ = next_buffer_;
+      next_buffer_.reset();
+      window_data_ = data;
+      window_start_ = next_start - unconsumed;
+      window_end_ = next_end;
+      return;
+    }
+    // Skipped past the bytes read ahead, or a larger read is needed
+    spare_buffer_ = next_buffer_;
+    next_buffer_.reset();
+  }
+  ReadWindow(stream_offset_, std::min(length, stream_end_ - stream_offset_));
+}
+
+void ReadAheadInputStream::ReadWindow(int64_t start, int64_t length) {
+  std::shared_ptr<PoolBuffer> buffer = GetBuffer(length);
+  int64_t bytes_read = source_->ReadAt(start, length, buffer->mutable_data());
+  if (bytes_read < length) {
+    throw ParquetException("Failed reading column data from source");
+  }
+  if (window_buffer_ != nullptr) {
+    spare_buffer_ = window_buffer_;
+  }
+  window_buffer_ = buffer;
+  window_data_ = buffer->data();
+  window_start_ = start;
+  window_end_ = start + length;
+}
+
+void ReadAheadInputStream::MaybeReadAhead() {
+  int64_t consumed = stream_offset_ - window_start_;
+  if (next_read_.valid() || window_end_ >= stream_end_ ||
+      consumed * 2 < window_end_ - window_start_) {
+    return;
+  }
+  next_headroom_ = window_end_ - std::min(stream_offset_, window_end_);
+  next_size_ = std::min(window_size_, stream_end_ - window_end_);
+  next_buffer_ = GetBuffer(next_headroom_ + next_size_);
+
+  RandomAccessSource* source = source_;
+  int64_t position = window_end_;
+  int64_t length = next_size_;
+  uint8_t* out = next_buffer_->mutable_data() + next_headroom_;
+  auto task = std::make_shared<std::packaged_task<int64_t()>>(
+      [source, position, length, out]() {
+        return source->ReadAt(position, length, out);
+      });
+  next_read_ = task->get_future();
+  ThreadPool::DefaultIO()->Submit([task]() { (*task)(); });
+}
+
+std::shared_ptr<PoolBuffer> ReadAheadInputStream::GetBuffer(int64_t size) {
+  std::shared_ptr<PoolBuffer> buffer;
+  if (spare_buffer_ != nullptr && spare_buffer_.use_count() == 1) {
+    buffer = spare_buffer_;
+    PARQUET_THROW_NOT_OK(buffer->Resize(size, false));
+  } else {
+    buffer = AllocateBuffer(pool_, size);
+  }
+  spare_buffer_.reset();
+  return buffer;
+}
+
 std::shared_ptr<PoolBuffer> AllocateBuffer(MemoryPool* pool, int64_t size) {
   auto result = std::make_shared<PoolBuffer>(pool);
   if (size > 0) {
@@ -507,4 +1018,24 @@ std::unique_ptr<PoolBuffer> AllocateUniqueBuffer(MemoryPool* pool, int64_t size)
   return result;
 }
 
+std::shared_ptr<Buffer> GatherBuffers(const std::vector<std::shared_ptr<Buffer>>& buffers,
+                                      const std::shared_ptr<ResizableBuffer>& scratch) {
+  if (buffers.size() == 1) {
+    return buffers[0];
+  }
+  int64_t size = 0;
+  for (const auto& buffer : buffers) {
+    size += buffer->size();
+  }
+  // Use Arrow::Buffer::shrink_to_fit = false, the underlying buffer only keeps
+  // growing
+  PARQUET_THROW_NOT_OK(scratch->Resize(size, false));
+  uint8_t* out = scratch->mutable_data();
+  for (const auto& buffer : buffers) {
+    memcpy(out, buffer->data(), buffer->size());
+    out += buffer->size();
+  }
+  return scratch;
+}
+
 }  // namespace parquet
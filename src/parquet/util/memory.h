@@ -22,8 +22,13 @@
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
+#include <future>
+#include <limits>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "arrow/buffer.h"
@@ -57,12 +62,57 @@ static inline std::unique_ptr<::arrow::Codec> GetCodecFromArrow(Compression::typ
     case Compression::BROTLI:
       PARQUET_THROW_NOT_OK(::arrow::Codec::Create(::arrow::Compression::BROTLI, &result));
       break;
+    case Compression::LZ4:
+      PARQUET_THROW_NOT_OK(::arrow::Codec::Create(::arrow::Compression::LZ4, &result));
+      break;
+    case Compression::ZSTD:
+      PARQUET_THROW_NOT_OK(::arrow::Codec::Create(::arrow::Compression::ZSTD, &result));
+      break;
     default:
       break;
   }
   return result;
 }
 
+// Whether the codec is built into Arrow. The benchmarks skip the cases of
+// the codecs that are not.
+static inline bool CodecAvailable(Compression::type codec) {
+  try {
+    GetCodecFromArrow(codec);
+    return true;
+  } catch (const ParquetException&) {
+    return false;
+  }
+}
+
+// Compression level that selects the default level of the codec
+static constexpr int kDefaultCompressionLevel = std::numeric_limits<int>::min();
+
+// Keeps the codecs released by the column chunks written so far, so that the
+// following chunks reuse them instead of creating their own. Codecs are kept
+// per type and level. A codec is only used by one chunk at a time, so that
+// stateful codecs can be shared too. Thread-safe.
+class PARQUET_EXPORT CodecPool {
+ public:
+  // A released codec of the type and level, or a new one if there is none.
+  // nullptr for UNCOMPRESSED.
+  //
+  // The codecs of Arrow have no level setting yet: throws NYI for any level
+  // but kDefaultCompressionLevel, rather than silently ignoring it.
+  std::unique_ptr<::arrow::Codec> Acquire(Compression::type codec, int level);
+
+  void Release(Compression::type codec, int level, std::unique_ptr<::arrow::Codec> c);
+
+  // Number of codecs available for reuse
+  int64_t num_released();
+
+ private:
+  std::mutex mutex_;
+  std::map<std::pair<Compression::type, int>,
+           std::vector<std::unique_ptr<::arrow::Codec>>>
+      codecs_;
+};
+
 static constexpr int64_t kInMemoryDefaultCapacity = 1024;
 
 using Buffer = ::arrow::Buffer;
@@ -70,6 +120,51 @@ using MutableBuffer = ::arrow::MutableBuffer;
 using ResizableBuffer = ::arrow::ResizableBuffer;
 using PoolBuffer = ::arrow::PoolBuffer;
 
+// The Arrow memory pools return 64-byte aligned memory. The hot-path scratch
+// and output buffers additionally keep kBufferPadding writable bytes past
+// their size, so that vectorized kernels may load and store whole 64-byte
+// blocks at the tail instead of finishing with a scalar loop.
+static constexpr int64_t kBufferAlignment = 64;
+static constexpr int64_t kBufferPadding = 64;
+
+// Resize the buffer to size bytes followed by at least kBufferPadding bytes of
+// capacity. The capacity is never shrunk, so a buffer reused for successive
+// batches is only reallocated when it grows.
+PARQUET_EXPORT ::arrow::Status ResizePadded(ResizableBuffer* buffer, int64_t size);
+
+static constexpr int64_t kDecompressionBufferPoolRetainedBytes = 64 * 1024 * 1024;
+
+// Scratch buffers for decompressed pages, shared by the page readers of one
+// or more files. A page leases a buffer for as long as the buffer is
+// referenced, by the page or by anything sliced from it, after which the
+// buffer goes back to the pool for the next page of any column. At most
+// max_retained_bytes of capacity are kept for reuse. Thread-safe.
+class PARQUET_EXPORT DecompressionBufferPool
+    : public std::enable_shared_from_this<DecompressionBufferPool> {
+ public:
+  explicit DecompressionBufferPool(
+      ::arrow::MemoryPool* pool = ::arrow::default_memory_pool(),
+      int64_t max_retained_bytes = kDecompressionBufferPoolRetainedBytes);
+
+  // A buffer of size bytes, reusing the smallest released buffer that is
+  // large enough. The pool must be owned by a shared_ptr.
+  std::shared_ptr<ResizableBuffer> Lease(int64_t size);
+
+  // Capacity of the buffers released and kept for reuse
+  int64_t retained_bytes();
+
+ private:
+  void Release(PoolBuffer* buffer);
+
+  ::arrow::MemoryPool* pool_;
+  int64_t max_retained_bytes_;
+
+  std::mutex mutex_;
+  std::vector<std::unique_ptr<PoolBuffer>> buffers_;
+  int64_t retained_bytes_;
+};
+
+// An array of T in a padded buffer (see ResizePadded)
 template <class T>
 class PARQUET_EXPORT Vector {
  public:
@@ -132,9 +227,70 @@ class PARQUET_EXPORT Vector {
 /// The one remaining (empty) chunk is released:
 ///    delete p;
 
+static constexpr int64_t kDefaultChunkCacheCapacity = 64 * 1024 * 1024;
+
+// Free list of the chunks released by ChunkedAllocators, so that the
+// allocators of the following column chunks (a new one is created for every
+// row group) reuse them instead of allocating from the memory pool. A chunk is
+// reused for any request it can hold, the smallest such chunk first. At most
+// capacity bytes are kept, chunks beyond that are freed, and Trim frees the
+// chunks that the last row group did not need. Thread-safe.
+class PARQUET_EXPORT ChunkCache {
+ public:
+  explicit ChunkCache(::arrow::MemoryPool* pool,
+                      int64_t capacity = kDefaultChunkCacheCapacity);
+
+  // Frees the cached chunks
+  ~ChunkCache();
+
+  // Process-wide cache for the default memory pool. As it is never destroyed,
+  // only chunks of a pool that lives as long as the process may be cached.
+  static ChunkCache* Default();
+
+  // The cache used by the allocators of the pool: Default() for the default
+  // memory pool, nullptr for the others
+  static ChunkCache* ForPool(::arrow::MemoryPool* pool);
+
+  ::arrow::MemoryPool* pool() const { return pool_; }
+
+  // The smallest cached chunk of at least min_size bytes, or nullptr if there
+  // is none. Sets size to the size of the chunk.
+  uint8_t* Take(int64_t min_size, int64_t* size);
+
+  // Keep the chunk for reuse, or free it if the cache is full
+  void Put(uint8_t* data, int64_t size);
+
+  // Frees chunks until at most capacity bytes are cached
+  void set_capacity(int64_t capacity);
+
+  // Frees all cached chunks
+  void Clear() { set_capacity(0); }
+
+  // Frees as many bytes of chunks as stayed cached since the previous call,
+  // the largest chunks first. Called once a row group is written, so that
+  // the cache only keeps what the row groups reuse.
+  void Trim();
+
+  int64_t cached_bytes();
+
+ private:
+  ::arrow::MemoryPool* pool_;
+  int64_t capacity_;
+
+  std::mutex mutex_;
+  std::multimap<int64_t, uint8_t*> chunks_;
+  int64_t cached_bytes_;
+  // The fewest bytes cached since the previous Trim
+  int64_t min_cached_bytes_;
+};
+
 class PARQUET_EXPORT ChunkedAllocator {
  public:
-  explicit ChunkedAllocator(::arrow::MemoryPool* pool = ::arrow::default_memory_pool());
+  /// Chunks are taken from and returned to the chunk cache if one is given.
+  /// Allocators of the default memory pool use ChunkCache::Default() unless
+  /// another cache is given.
+  explicit ChunkedAllocator(::arrow::MemoryPool* pool = ::arrow::default_memory_pool(),
+                            ChunkCache* chunk_cache = nullptr);
 
   /// Frees all chunks of memory and subtracts the total allocated bytes
   /// from the registered limits.
@@ -214,6 +370,16 @@ class PARQUET_EXPORT ChunkedAllocator {
 
   ::arrow::MemoryPool* pool_;
 
+  /// Not owned, may be NULL
+  ChunkCache* chunk_cache_;
+
+  /// Allocate a chunk of at least size bytes, from the chunk cache if possible.
+  /// Sets size to the size of the chunk.
+  uint8_t* AllocateChunk(int64_t* size);
+
+  /// Return a chunk to the chunk cache, or to the mem pool if there is none
+  void FreeChunk(uint8_t* data, int64_t size);
+
   /// Find or allocated a chunk with at least min_size spare capacity and update
   /// current_chunk_idx_. Also updates chunks_, chunk_sizes_ and allocated_bytes_
   /// if a new chunk needs to be created.
@@ -245,6 +411,16 @@ class PARQUET_EXPORT FileInterface {
   virtual int64_t Tell() = 0;
 };
 
+// Access pattern hints for a byte range of a RandomAccessSource
+struct AccessHint {
+  enum type {
+    // The range is about to be read sequentially
+    WILL_NEED,
+    // The range was read and will not be needed again soon
+    DONT_NEED
+  };
+};
+
 /// It is the responsibility of implementations to mind threadsafety of shared
 /// resources
 class PARQUET_EXPORT RandomAccessSource : virtual public FileInterface {
@@ -262,6 +438,26 @@ class PARQUET_EXPORT RandomAccessSource : virtual public FileInterface {
 
   /// Returns bytes read
   virtual int64_t ReadAt(int64_t position, int64_t nbytes, uint8_t* out) = 0;
+
+  /// Returns true if the buffers returned by ReadAt reference the source's
+  /// memory (e.g. a memory map) instead of a copy
+  virtual bool supports_zero_copy() const { return false; }
+
+  /// Start reading nbytes at position; get() on the result returns the
+  /// buffer, or rethrows the exception raised by the read. Must be safe to
+  /// call concurrently with ReadAt.
+  ///
+  /// By default the blocking ReadAt runs on ThreadPool::DefaultIO(), or
+  /// inline for zero-copy sources. Sources backed by remote storage may
+  /// override this to keep many requests in flight without blocking a
+  /// thread for each of them.
+  virtual std::future<std::shared_ptr<Buffer>> ReadAtAsync(int64_t position,
+                                                           int64_t nbytes);
+
+  /// Pass an access pattern hint for nbytes at position to the OS, so that it
+  /// reads them ahead or evicts them from its page cache. Only a hint, which
+  /// is ignored by default.
+  virtual void Advise(int64_t position, int64_t nbytes, AccessHint::type hint) {}
 };
 
 class PARQUET_EXPORT OutputStream : virtual public FileInterface {
@@ -270,6 +466,17 @@ class PARQUET_EXPORT OutputStream : virtual public FileInterface {
 
   // Copy bytes into the output stream
   virtual void Write(const uint8_t* data, int64_t length) = 0;
+
+  // Write the buffers one after the other. Streams supporting vectored writes
+  // may write them at once.
+  virtual void WriteBuffers(const std::vector<std::shared_ptr<Buffer>>& buffers) {
+    for (const auto& buffer : buffers) {
+      Write(buffer->data(), buffer->size());
+    }
+  }
+
+  // Write the bytes held by the stream, if any, to the underlying sink
+  virtual void Flush() {}
 };
 
 class PARQUET_EXPORT ArrowFileMethods : virtual public FileInterface {
@@ -301,6 +508,12 @@ class PARQUET_EXPORT ArrowInputFile : public ArrowFileMethods, public RandomAcce
   /// Returns bytes read
   int64_t ReadAt(int64_t position, int64_t nbytes, uint8_t* out) override;
 
+  bool supports_zero_copy() const override;
+
+  // posix_fadvise for local files, madvise for memory maps. Other files, and
+  // platforms without these calls, ignore the hints.
+  void Advise(int64_t position, int64_t nbytes, AccessHint::type hint) override;
+
   std::shared_ptr<::arrow::io::ReadableFileInterface> file() const { return file_; }
 
   // Diamond inheritance
@@ -365,6 +578,83 @@ class PARQUET_EXPORT InMemoryOutputStream : public OutputStream {
   DISALLOW_COPY_AND_ASSIGN(InMemoryOutputStream);
 };
 
+static constexpr int64_t kChunkedOutputStreamMaxBlockSize = 1024 * 1024;
+
+// An in-memory output stream that appends blocks instead of growing one
+// buffer, so that the bytes written so far are never copied while writing.
+// Block sizes double from initial_block_size up to max_block_size.
+class PARQUET_EXPORT ChunkedOutputStream : public OutputStream {
+ public:
+  explicit ChunkedOutputStream(
+      ::arrow::MemoryPool* pool = ::arrow::default_memory_pool(),
+      int64_t initial_block_size = kInMemoryDefaultCapacity,
+      int64_t max_block_size = kChunkedOutputStreamMaxBlockSize);
+
+  // Close is a no-op with the in-memory stream
+  void Close() override {}
+
+  int64_t Tell() override { return size_; }
+
+  void Write(const uint8_t* data, int64_t length) override;
+
+  // Clears the stream and releases the blocks
+  void Clear();
+
+  // Return the blocks, each sliced to the bytes written to it, and clear the
+  // stream
+  std::vector<std::shared_ptr<Buffer>> GetBuffers();
+
+  // Return complete stream as Buffer and clear the stream. The blocks are
+  // concatenated, unless there is only one.
+  std::shared_ptr<Buffer> GetBuffer();
+
+  // Write all bytes written so far to the sink, block by block
+  void WriteTo(OutputStream* sink) const;
+
+ private:
+  ::arrow::MemoryPool* pool_;
+  int64_t initial_block_size_;
+  int64_t max_block_size_;
+
+  std::vector<std::shared_ptr<PoolBuffer>> blocks_;
+  // Bytes written to the last block
+  int64_t block_size_;
+  int64_t size_;
+
+  DISALLOW_COPY_AND_ASSIGN(ChunkedOutputStream);
+};
+
+// Combines the writes smaller than buffer_size into writes of about
+// buffer_size bytes to the sink. Larger writes go straight to the sink, after
+// the buffered bytes. Tell does not query the sink.
+class PARQUET_EXPORT BufferedOutputStream : public OutputStream {
+ public:
+  BufferedOutputStream(const std::shared_ptr<OutputStream>& sink, int64_t buffer_size,
+                       ::arrow::MemoryPool* pool = ::arrow::default_memory_pool());
+
+  // Flushes the buffered bytes, errors are ignored
+  ~BufferedOutputStream() override;
+
+  // Flushes the buffered bytes and closes the sink
+  void Close() override;
+
+  int64_t Tell() override { return position_; }
+
+  void Write(const uint8_t* data, int64_t length) override;
+
+  void Flush() override;
+
+ private:
+  std::shared_ptr<OutputStream> sink_;
+  std::shared_ptr<PoolBuffer> buffer_;
+  int64_t buffer_size_;
+  // Number of bytes in buffer_
+  int64_t buffered_size_;
+  int64_t position_;
+
+  DISALLOW_COPY_AND_ASSIGN(BufferedOutputStream);
+};
+
 // ----------------------------------------------------------------------
 // Streaming input interfaces
 
@@ -388,6 +678,11 @@ class InputStream {
   // Advance the stream without reading
   virtual void Advance(int64_t num_bytes) = 0;
 
+  // Identical to Read(), except that the returned buffer shares ownership of
+  // the stream's memory and stays valid after subsequent reads. Returns nullptr
+  // without advancing the stream if this is not supported.
+  virtual std::shared_ptr<Buffer> ReadSlice(int64_t num_to_read) { return nullptr; }
+
   virtual ~InputStream() {}
 
  protected:
@@ -404,6 +699,8 @@ class PARQUET_EXPORT InMemoryInputStream : public InputStream {
 
   virtual void Advance(int64_t num_bytes);
 
+  virtual std::shared_ptr<Buffer> ReadSlice(int64_t num_to_read);
+
  private:
   std::shared_ptr<Buffer> buffer_;
   int64_t len_;
@@ -429,12 +726,77 @@ class PARQUET_EXPORT BufferedInputStream : public InputStream {
   int64_t buffer_size_;
 };
 
+// A buffered input stream that reads the next window of the source on the
+// default IO ThreadPool once half of the current window is consumed. The
+// window starts at buffer_size bytes and doubles with every refill, up to
+// kMaxWindowMultiple times buffer_size. The source must support concurrent
+// ReadAt calls.
+class PARQUET_EXPORT ReadAheadInputStream : public InputStream {
+ public:
+  static constexpr int64_t kMaxWindowMultiple = 8;
+
+  ReadAheadInputStream(::arrow::MemoryPool* pool, int64_t buffer_size,
+                       RandomAccessSource* source, int64_t start, int64_t num_bytes);
+
+  // Waits for the pending read, if any
+  ~ReadAheadInputStream() override;
+
+  const uint8_t* Peek(int64_t num_to_peek, int64_t* num_bytes) override;
+  const uint8_t* Read(int64_t num_to_read, int64_t* num_bytes) override;
+
+  void Advance(int64_t num_bytes) override;
+
+ private:
+  // Make the num_bytes bytes at stream_offset_ available in the window
+  void Refill(int64_t num_bytes);
+
+  // Read the window from the source synchronously
+  void ReadWindow(int64_t start, int64_t length);
+
+  // Start reading the bytes following the window, once half of it is consumed
+  void MaybeReadAhead();
+
+  // Returns a buffer of at least size bytes, reusing the spare one if possible
+  std::shared_ptr<PoolBuffer> GetBuffer(int64_t size);
+
+  ::arrow::MemoryPool* pool_;
+  RandomAccessSource* source_;
+  int64_t stream_offset_;
+  int64_t stream_end_;
+  // Length of the next window, at most max_window_size_
+  int64_t window_size_;
+  int64_t max_window_size_;
+
+  // The bytes [window_start_, window_end_) of the source are at window_data_
+  std::shared_ptr<PoolBuffer> window_buffer_;
+  const uint8_t* window_data_;
+  int64_t window_start_;
+  int64_t window_end_;
+
+  // The bytes [window_end_, window_end_ + next_size_) are read into
+  // next_buffer_ after next_headroom_ bytes, leaving room to move the
+  // unconsumed end of the window in front of them
+  std::shared_ptr<PoolBuffer> next_buffer_;
+  int64_t next_headroom_;
+  int64_t next_size_;
+  std::future<int64_t> next_read_;
+
+  // The buffer of the previous window
+  std::shared_ptr<PoolBuffer> spare_buffer_;
+};
+
 std::shared_ptr<PoolBuffer> PARQUET_EXPORT AllocateBuffer(::arrow::MemoryPool* pool,
                                                           int64_t size = 0);
 
 std::unique_ptr<PoolBuffer> PARQUET_EXPORT AllocateUniqueBuffer(::arrow::MemoryPool* pool,
                                                                 int64_t size = 0);
 
+// Returns the buffer if there is only one, otherwise copies the buffers one
+// after the other into scratch, which is resized to hold them
+std::shared_ptr<Buffer> PARQUET_EXPORT
+GatherBuffers(const std::vector<std::shared_ptr<Buffer>>& buffers,
+              const std::shared_ptr<ResizableBuffer>& scratch);
+
 }  // namespace parquet
 
 #endif  // PARQUET_UTIL_MEMORY_H
@@ -23,6 +23,8 @@
 #include <sys/time.h>
 #endif
 
+#include <atomic>
+#include <cstdint>
 #include <ctime>
 #include <iostream>
 
@@ -40,13 +42,34 @@ class StopWatch {
     gettimeofday(&t_time, 0);
 
     return (1000L * 1000L * 1000L * (t_time.tv_sec - start_time.tv_sec) +
-            (t_time.tv_usec - start_time.tv_usec));
+            1000L * (t_time.tv_usec - start_time.tv_usec));
   }
 
  private:
   struct timeval start_time;
 };
 
+// Adds the nanoseconds elapsed during its lifetime to the counter. Does
+// nothing if the counter is nullptr, e.g. when statistics are not collected.
+class ScopedStopWatch {
+ public:
+  explicit ScopedStopWatch(std::atomic<int64_t>* counter) : counter_(counter) {
+    if (counter_ != nullptr) {
+      watch_.Start();
+    }
+  }
+
+  ~ScopedStopWatch() {
+    if (counter_ != nullptr) {
+      counter_->fetch_add(static_cast<int64_t>(watch_.Stop()), std::memory_order_relaxed);
+    }
+  }
+
+ private:
+  std::atomic<int64_t>* counter_;
+  StopWatch watch_;
+};
+
 }  // namespace parquet
 
 #endif
@@ -0,0 +1,66 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "parquet/util/thread-pool.h"
+
+namespace parquet {
+
+TEST(TestThreadPool, RunsAllTasks) {
+  const int num_tasks = 1000;
+  std::atomic<int> counter(0);
+  {
+    ThreadPool pool(4);
+    ASSERT_EQ(4, pool.num_threads());
+    for (int i = 0; i < num_tasks; ++i) {
+      pool.Submit([&counter]() { counter.fetch_add(1); });
+    }
+    // The destructor completes the queued tasks
+  }
+  ASSERT_EQ(num_tasks, counter.load());
+}
+
+TEST(TestThreadPool, ReusesWorkers) {
+  std::mutex mtx;
+  std::set<std::thread::id> thread_ids;
+  {
+    ThreadPool pool(2);
+    for (int i = 0; i < 100; ++i) {
+      pool.Submit([&mtx, &thread_ids]() {
+        std::lock_guard<std::mutex> lock(mtx);
+        thread_ids.insert(std::this_thread::get_id());
+      });
+    }
+  }
+  ASSERT_GE(2, static_cast<int>(thread_ids.size()));
+  ASSERT_EQ(0, thread_ids.count(std::this_thread::get_id()));
+}
+
+TEST(TestThreadPool, Default) {
+  std::shared_ptr<ThreadPool> pool = ThreadPool::Default();
+  ASSERT_NE(nullptr, pool);
+  ASSERT_LE(1, pool->num_threads());
+  ASSERT_EQ(pool, ThreadPool::Default());
+}
+
+}  // namespace parquet
@@ -0,0 +1,142 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef PARQUET_UTIL_THREAD_POOL_H
+#define PARQUET_UTIL_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "arrow/status.h"
+
+#include "parquet/exception.h"
+#include "parquet/util/macros.h"
+#include "parquet/util/visibility.h"
+
+namespace parquet {
+
+// A fixed set of long-lived worker threads running the submitted tasks in
+// submission order. Tasks must not throw.
+class PARQUET_EXPORT ThreadPool {
+ public:
+  explicit ThreadPool(int num_threads);
+
+  // Runs the tasks still queued, then joins the workers
+  ~ThreadPool();
+
+  int num_threads() const { return static_cast<int>(workers_.size()); }
+
+  void Submit(std::function<void()> task);
+
+  // The process-wide pool, with one thread per hardware thread. Created on
+  // first use.
+  static std::shared_ptr<ThreadPool> Default();
+
+  // The process-wide pool running blocking reads on behalf of
+  // RandomAccessSource::ReadAtAsync, with kDefaultIOThreads threads. Kept
+  // apart from Default() so that tasks of the latter waiting for reads
+  // cannot starve them. Created on first use.
+  static std::shared_ptr<ThreadPool> DefaultIO();
+
+  static constexpr int kDefaultIOThreads = 8;
+
+ private:
+  void WorkerLoop();
+
+  std::vector<std::thread> workers_;
+  std::deque<std::function<void()>> tasks_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool shutdown_;
+
+  DISALLOW_COPY_AND_ASSIGN(ThreadPool);
+};
+
+// Runs func(0), ..., func(num_tasks - 1) on the calling thread and on up to
+// nthreads - 1 threads of the pool. Tasks are claimed one at a time, so that a
+// slow task does not hold back the others. Once a task fails, the tasks that
+// did not start are skipped and the first error is returned.
+template <class FUNCTION>
+::arrow::Status ParallelFor(ThreadPool* pool, int nthreads, int num_tasks,
+                            FUNCTION&& func) {
+  struct State {
+    std::atomic<int> task_counter;
+    std::mutex mtx;
+    std::condition_variable cv;
+    int tasks_finished;
+    bool error_occurred;
+    ::arrow::Status error;
+  };
+  // The helpers may only start once all tasks were run, after this function
+  // returned, so they share the ownership of the state
+  auto state = std::make_shared<State>();
+  state->task_counter = 0;
+  state->tasks_finished = 0;
+  state->error_occurred = false;
+  auto* task_func = &func;
+
+  auto RunTasks = [state, task_func, num_tasks]() {
+    while (true) {
+      int task_id = state->task_counter.fetch_add(1);
+      if (task_id >= num_tasks) {
+        break;
+      }
+      bool skip;
+      {
+        std::lock_guard<std::mutex> lock(state->mtx);
+        skip = state->error_occurred;
+      }
+      ::arrow::Status s;
+      if (!skip) {
+        try {
+          s = (*task_func)(task_id);
+        } catch (const ::parquet::ParquetException& e) {
+          s = ::arrow::Status::IOError(e.what());
+        }
+      }
+      std::lock_guard<std::mutex> lock(state->mtx);
+      if (!s.ok() && !state->error_occurred) {
+        state->error_occurred = true;
+        state->error = s;
+      }
+      if (++state->tasks_finished == num_tasks) {
+        state->cv.notify_all();
+      }
+    }
+  };
+
+  for (int i = 1; i < nthreads; ++i) {
+    pool->Submit(RunTasks);
+  }
+  RunTasks();
+
+  std::unique_lock<std::mutex> lock(state->mtx);
+  state->cv.wait(lock, [&state, num_tasks]() {
+    return state->tasks_finished == num_tasks;
+  });
+  return state->error_occurred ? state->error : ::arrow::Status::OK();
+}
+
+}  // namespace parquet
+
+#endif  // PARQUET_UTIL_THREAD_POOL_H
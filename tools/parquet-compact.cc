@@ -0,0 +1,69 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "arrow/io/file.h"
+
+#include "parquet/api/reader.h"
+#include "parquet/api/writer.h"
+
+int main(int argc, char** argv) {
+  if (argc < 3) {
+    std::cerr << "Usage: parquet-compact [--page-index] <output> <input>..."
+              << std::endl;
+    std::cerr << "Copies the row groups of the input files, which must have the same "
+                 "schema, to the output file without decoding them"
+              << std::endl;
+    return -1;
+  }
+
+  int arg = 1;
+  parquet::WriterProperties::Builder builder;
+  if (std::string(argv[arg]) == "--page-index") {
+    builder.enable_page_index();
+    ++arg;
+  }
+  std::string output_path = argv[arg++];
+
+  try {
+    std::vector<std::unique_ptr<parquet::ParquetFileReader>> readers;
+    std::vector<parquet::ParquetFileReader*> inputs;
+    for (; arg < argc; ++arg) {
+      readers.push_back(parquet::ParquetFileReader::OpenFile(argv[arg]));
+      inputs.push_back(readers.back().get());
+    }
+
+    std::shared_ptr<::arrow::io::FileOutputStream> output_file;
+    PARQUET_THROW_NOT_OK(::arrow::io::FileOutputStream::Open(output_path, &output_file));
+    auto sink = std::make_shared<parquet::ArrowOutputStream>(output_file);
+
+    std::shared_ptr<parquet::FileMetaData> metadata =
+        parquet::CompactFiles(inputs, sink, builder.build());
+    std::cout << "Wrote " << metadata->num_rows() << " rows in "
+              << metadata->num_row_groups() << " row groups to " << output_path
+              << std::endl;
+  } catch (const std::exception& e) {
+    std::cerr << "Parquet error: " << e.what() << std::endl;
+    return -1;
+  }
+
+  return 0;
+}
@@ -15,16 +15,21 @@
 // specific language governing permissions and limitations
 // under the License.
 
-#include <ctime>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
 #include <iostream>
-#include <list>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "parquet/api/reader.h"
 
 int main(int argc, char** argv) {
-  if (argc > 4 || argc < 1) {
-    std::cerr << "Usage: parquet-scan [--batch-size=] [--columns=...] <file>"
+  if (argc > 5 || argc < 2) {
+    std::cerr << "Usage: parquet-scan [--batch-size=] [--columns=...] [--threads=] <file>"
               << std::endl;
     return -1;
   }
@@ -33,10 +38,11 @@ int main(int argc, char** argv) {
 
   // Read command-line options
   int batch_size = 256;
+  int num_threads = 1;
   const std::string COLUMNS_PREFIX = "--columns=";
   const std::string BATCH_SIZE_PREFIX = "--batch-size=";
+  const std::string THREADS_PREFIX = "--threads=";
   std::vector<int> columns;
-  int num_columns = 0;
 
   char *param, *value;
   for (int i = 1; i < argc; i++) {
@@ -45,29 +51,60 @@ int main(int argc, char** argv) {
       while (value) {
         columns.push_back(std::atoi(value));
         value = std::strtok(nullptr, ",");
-        num_columns++;
       }
     } else if ((param = std::strstr(argv[i], BATCH_SIZE_PREFIX.c_str()))) {
       value = std::strtok(param + BATCH_SIZE_PREFIX.length(), " ");
       if (value) {
         batch_size = std::atoi(value);
       }
+    } else if ((param = std::strstr(argv[i], THREADS_PREFIX.c_str()))) {
+      value = std::strtok(param + THREADS_PREFIX.length(), " ");
+      if (value) {
+        num_threads = std::max(std::atoi(value), 1);
+      }
     } else {
       filename = argv[i];
     }
   }
 
   try {
-    double total_time;
-    std::clock_t start_time = std::clock();
+    auto start_time = std::chrono::steady_clock::now();
     std::unique_ptr<parquet::ParquetFileReader> reader =
         parquet::ParquetFileReader::OpenFile(filename);
 
-    int64_t total_rows = parquet::ScanFileContents(columns, batch_size, reader.get());
+    std::vector<parquet::ColumnScanStats> stats;
+    int64_t total_rows = parquet::ScanFileContents(columns, batch_size, reader.get(),
+                                                   num_threads, &stats);
 
-    total_time = (std::clock() - start_time) / static_cast<double>(CLOCKS_PER_SEC);
-    std::cout << total_rows << " rows scanned in " << total_time << " seconds."
-              << std::endl;
+    double total_time = std::chrono::duration<double>(
+                            std::chrono::steady_clock::now() - start_time)
+                            .count();
+    if (columns.empty()) {
+      for (int i = 0; i < reader->metadata()->num_columns(); i++) {
+        columns.push_back(i);
+      }
+    }
+
+    // The phases are summed over the threads
+    std::cout << std::left << std::setw(32) << "column" << std::right << std::setw(14)
+              << "bytes read" << std::setw(14) << "decompressed" << std::setw(10)
+              << "io (s)" << std::setw(12) << "decomp (s)" << std::setw(12)
+              << "decode (s)" << std::endl;
+    int64_t total_bytes_read = 0;
+    for (size_t i = 0; i < columns.size(); i++) {
+      const parquet::ColumnScanStats& column = stats[i];
+      std::cout << std::left << std::setw(32)
+                << reader->metadata()->schema()->Column(columns[i])->path()->ToDotString()
+                << std::right << std::setw(14) << column.bytes_read << std::setw(14)
+                << column.decompressed_bytes << std::fixed << std::setprecision(4)
+                << std::setw(10) << column.io_seconds << std::setw(12)
+                << column.decompression_seconds << std::setw(12)
+                << column.decode_seconds << std::endl;
+      total_bytes_read += column.bytes_read;
+    }
+    std::cout << total_rows << " rows scanned in " << total_time << " seconds with "
+              << num_threads << " threads, "
+              << total_bytes_read / total_time / (1024 * 1024) << " MB/s." << std::endl;
   } catch (const std::exception& e) {
     std::cerr << "Parquet error: " << e.what() << std::endl;
     return -1;
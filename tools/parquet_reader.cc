@@ -15,16 +15,20 @@
 // specific language governing permissions and limitations
 // under the License.
 
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <limits>
 #include <list>
 #include <memory>
+#include <string>
 
 #include "parquet/api/reader.h"
 
 int main(int argc, char** argv) {
-  if (argc > 5 || argc < 2) {
-    std::cerr << "Usage: parquet_reader [--only-metadata] [--no-memory-map] [--json]"
-                 "[--columns=...] <file>"
+  if (argc < 2) {
+    std::cerr << "Usage: parquet_reader [--only-metadata] [--no-memory-map] [--json] "
+                 "[--columns=...] [--limit=<rows>] [--format=table|csv|json] <file>"
               << std::endl;
     return -1;
   }
@@ -33,9 +37,15 @@ int main(int argc, char** argv) {
   bool print_values = true;
   bool memory_map = true;
   bool format_json = false;
+  // Only print the values, in this format
+  bool values_only = false;
+  parquet::PrintFormat::type values_format = parquet::PrintFormat::TABLE;
+  int64_t max_rows = -1;
 
   // Read command-line options
   const std::string COLUMNS_PREFIX = "--columns=";
+  const std::string LIMIT_PREFIX = "--limit=";
+  const std::string FORMAT_PREFIX = "--format=";
   std::list<int> columns;
 
   char *param, *value;
@@ -49,22 +59,56 @@ int main(int argc, char** argv) {
     } else if ((param = std::strstr(argv[i], COLUMNS_PREFIX.c_str()))) {
       value = std::strtok(param + COLUMNS_PREFIX.length(), ",");
       while (value) {
-        columns.push_back(std::atoi(value));
+        char* end;
+        long column = std::strtol(value, &end, 10);
+        if (end == value || *end != '\0' || column < 0 ||
+            column > std::numeric_limits<int>::max()) {
+          std::cerr << "Invalid column index: " << value << std::endl;
+          return -1;
+        }
+        columns.push_back(static_cast<int>(column));
         value = std::strtok(nullptr, ",");
       }
+    } else if ((param = std::strstr(argv[i], LIMIT_PREFIX.c_str()))) {
+      max_rows = std::atoll(param + LIMIT_PREFIX.length());
+    } else if ((param = std::strstr(argv[i], FORMAT_PREFIX.c_str()))) {
+      const std::string format = param + FORMAT_PREFIX.length();
+      values_only = true;
+      if (format == "csv") {
+        values_format = parquet::PrintFormat::CSV;
+      } else if (format == "json") {
+        values_format = parquet::PrintFormat::JSON;
+      } else if (format != "table") {
+        std::cerr << "Unknown format: " << format << std::endl;
+        return -1;
+      }
     } else {
       filename = argv[i];
     }
   }
 
   try {
+    // Read the pages as they are needed rather than whole column chunks, so
+    // that a limit stops the reads early
+    parquet::ReaderProperties props = parquet::default_reader_properties();
+    props.enable_buffered_stream();
     std::unique_ptr<parquet::ParquetFileReader> reader =
-        parquet::ParquetFileReader::OpenFile(filename, memory_map);
+        parquet::ParquetFileReader::OpenFile(filename, memory_map, props);
+    const int num_columns = reader->metadata()->num_columns();
+    for (int column : columns) {
+      if (column >= num_columns) {
+        std::cerr << "Column index " << column << " is out of range, the file has "
+                  << num_columns << " columns" << std::endl;
+        return -1;
+      }
+    }
     parquet::ParquetFilePrinter printer(reader.get());
-    if (format_json) {
+    if (values_only) {
+      printer.PrintValues(std::cout, columns, max_rows, values_format);
+    } else if (format_json) {
       printer.JSONPrint(std::cout, columns, filename.c_str());
     } else {
-      printer.DebugPrint(std::cout, columns, print_values, filename.c_str());
+      printer.DebugPrint(std::cout, columns, print_values, filename.c_str(), max_rows);
     }
   } catch (const std::exception& e) {
     std::cerr << "Parquet error: " << e.what() << std::endl;